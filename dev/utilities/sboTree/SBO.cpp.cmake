@@ -7,6 +7,11 @@
  * This file is part of libSBML.  Please visit http://sbml.org for more
  * information about SBML, and the latest version of libSBML.
  *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
  * Copyright (C) 2019 jointly by the following organizations:
  *     1. California Institute of Technology, Pasadena, CA, USA
  *     2. University of Heidelberg, Heidelberg, Germany
@@ -37,6 +42,7 @@
 #include <iomanip>
 #include <sstream>
 #include <iterator>
+#include <vector>
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -57,7 +63,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 
 /** @cond doxygenLibsbmlInternal */
 /*
- * @return true if sboTerm is in the correct format (a zero-padded, seven
+ * @return @c true if sboTerm is in the correct format (a zero-padded, seven
  * digit string preceded by SBO:), false otherwise.
  */
 bool
@@ -84,7 +90,7 @@ SBO::checkTerm (const std::string& sboTerm)
 
 /** @cond doxygenLibsbmlInternal */
 /*
- * @return true if sboTerm is in the range [0 -- 9999999], false
+ * @return @c true if sboTerm is in the range [0 -- 9999999], false
  * otherwise.
  */
 bool
@@ -98,7 +104,7 @@ SBO::checkTerm (int sboTerm)
 /*
  * Reads (and checks) sboTerm from the given XMLAttributes set.
  *
- * @return the sboTerm as an integer or -1 if the sboTerm was not in the
+ * @return the sboTerm as an integer or @c -1 if the sboTerm was not in the
  * correct format or not found.
  */
 int
@@ -127,7 +133,7 @@ SBO::readTerm (const XMLAttributes& attributes, SBMLErrorLog* log,
  * Writes sboTerm as an XMLAttribute to the given XMLOutputStream.
  */
 void
-SBO::writeTerm (XMLOutputStream& stream, int sboTerm, const std::string& prefix)
+SBO::writeTerm (XMLOutputStream& stream, int sboTerm, const std::string prefix)
 {
   stream.writeAttribute( "sboTerm", prefix, intToString(sboTerm) );
 }
@@ -183,57 +189,6 @@ SBO::intToString (int sboTerm)
 }
 
 
-/**
-  * functions for checking the SBO term is from correct part of SBO
-  * Unary Functor returns the parent portion of a ParentMap pair.
-  */
-struct GetSecond
-{
-  int operator() (const pair<const int, int>& pair) { return pair.second; }
-};
-
-
-/** @cond doxygenLibsbmlInternal */
-/**
-  * functions for checking the SBO term is from correct part of SBO
-  * returns true if the term is-a parent, false otherwise
-  */
-bool
-SBO::isChildOf(unsigned int term, unsigned int parent)
-{
-  bool        result = false;
-  if (mParent.empty())
-  {
-    populateSBOTree();
-  }
-  ParentRange range  = mParent.equal_range((int)term);
-  deque<unsigned int>  nodes;
-
-
-  // Copy parents of term to nodes.
-  transform(range.first, range.second, back_inserter(nodes), GetSecond());
-
-  // Search nodes DFS for parent.
-  // (For BFS, change back() and pop_back() to front() and pop_front().)
-  while ( !nodes.empty() )
-  {
-    const unsigned int p = nodes.back();
-    nodes.pop_back();
-
-    if (p == parent)
-    {
-      result = true;
-      break;
-    }
-
-    // Copy parents of p to nodes and continue search.
-    range = mParent.equal_range((int)p);
-    transform(range.first, range.second, back_inserter(nodes), GetSecond());
-  }
-
-  return result;
-}
-/** @endcond */
 
 
 /**
@@ -430,7 +385,7 @@ SBO::isParticipant  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a Interaction, false otherwise
+ * @return @c true if the term is-a Interaction, false otherwise
  */
 bool
 SBO::isInteraction  (unsigned int sboTerm)
@@ -441,7 +396,7 @@ SBO::isInteraction  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a Entity, false otherwise
+ * @return @c true if the term is-a Entity, false otherwise
  */
 bool
 SBO::isEntity  (unsigned int sboTerm)
@@ -452,7 +407,7 @@ SBO::isEntity  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a FunctionalEntity, false otherwise
+ * @return @c true if the term is-a FunctionalEntity, false otherwise
  */
 bool
 SBO::isFunctionalEntity  (unsigned int sboTerm)
@@ -468,7 +423,7 @@ SBO::isFunctionalEntity  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a MaterialEntity, false otherwise
+ * @return @c true if the term is-a MaterialEntity, false otherwise
  */
 bool
 SBO::isMaterialEntity  (unsigned int sboTerm)
@@ -484,7 +439,7 @@ SBO::isMaterialEntity  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a ConservationLaw, false otherwise
+ * @return @c true if the term is-a ConservationLaw, false otherwise
  */
 bool
 SBO::isConservationLaw  (unsigned int sboTerm)
@@ -500,7 +455,7 @@ SBO::isConservationLaw  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a SteadyStateExpression, false otherwise
+ * @return @c true if the term is-a SteadyStateExpression, false otherwise
  */
 bool
 SBO::isSteadyStateExpression  (unsigned int sboTerm)
@@ -516,7 +471,7 @@ SBO::isSteadyStateExpression  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a FunctionalCompartment, false otherwise
+ * @return @c true if the term is-a FunctionalCompartment, false otherwise
  */
 bool
 SBO::isFunctionalCompartment  (unsigned int sboTerm)
@@ -532,7 +487,7 @@ SBO::isFunctionalCompartment  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a ContinuousFramework, false otherwise
+ * @return @c true if the term is-a ContinuousFramework, false otherwise
  */
 bool
 SBO::isContinuousFramework  (unsigned int sboTerm)
@@ -548,7 +503,7 @@ SBO::isContinuousFramework  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a DiscreteFramework, false otherwise
+ * @return @c true if the term is-a DiscreteFramework, false otherwise
  */
 bool
 SBO::isDiscreteFramework  (unsigned int sboTerm)
@@ -564,7 +519,7 @@ SBO::isDiscreteFramework  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a LogicalFramework, false otherwise
+ * @return @c true if the term is-a LogicalFramework, false otherwise
  */
 bool
 SBO::isLogicalFramework  (unsigned int sboTerm)
@@ -581,7 +536,7 @@ SBO::isLogicalFramework  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a MetadataRepresentation, false otherwise
+ * @return @c true if the term is-a MetadataRepresentation, false otherwise
  */
 bool
 SBO::isMetadataRepresentation  (unsigned int sboTerm)
@@ -598,7 +553,7 @@ SBO::isMetadataRepresentation  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a OccurringEntityRepresentation, false otherwise
+ * @return @c true if the term is-a OccurringEntityRepresentation, false otherwise
  */
 bool
 SBO::isOccurringEntityRepresentation  (unsigned int sboTerm)
@@ -615,7 +570,7 @@ SBO::isOccurringEntityRepresentation  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a PhysicalEntityRepresentation, false otherwise
+ * @return @c true if the term is-a PhysicalEntityRepresentation, false otherwise
  */
 bool
 SBO::isPhysicalEntityRepresentation  (unsigned int sboTerm)
@@ -632,7 +587,7 @@ SBO::isPhysicalEntityRepresentation  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is from correct part of SBO.
  *
- * @return true if the term is-a SystemsDescriptionParameter, false otherwise
+ * @return @c true if the term is-a SystemsDescriptionParameter, false otherwise
  */
 bool
 SBO::isSystemsDescriptionParameter  (unsigned int sboTerm)
@@ -660,7 +615,7 @@ SBO::isQuantitativeSystemsDescriptionParameter  (unsigned int sboTerm)
 /*
  * Function for checking the SBO term is Obselete
  *
- * @return true if the term is-a Obselete, false otherwise
+ * @return @c true if the term is-a Obselete, false otherwise
  */
 bool
 SBO::isObselete  (unsigned int sboTerm)
@@ -698,15 +653,161 @@ SBO::getParentBranch(unsigned int term)
 /** @endcond */
 
 /** @cond doxygenLibsbmlInternal */
+/*
+ * The is_a relations of SBO as (term, parent) pairs; obsolete terms have
+ * the parent 1000.  This table is generated by the update_sbo target (see
+ * dev/utilities/sboTree).
+ */
+static const unsigned int SBO_PARENTS[][2] =
+{
+  // generated from SBO on ${DATE}
+${NEW_TERMS}};
+
+
+/*
+ * The transitive closure of SBO_PARENTS: one row of bits per term, with a
+ * column for every term that is the parent of some term.  Built once, on
+ * first use, after which it is only read, so any number of threads can
+ * query it at the same time.
+ */
+class SBOAncestry
+{
+public:
+
+  SBOAncestry()
+    : mNumTerms(0)
+    , mNumWords(0)
+  {
+    const size_t numPairs = sizeof(SBO_PARENTS) / sizeof(SBO_PARENTS[0]);
+
+    unsigned int numColumns = 0;
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      unsigned int largest = max(SBO_PARENTS[i][0], SBO_PARENTS[i][1]);
+      if (largest >= mNumTerms)
+      {
+        mNumTerms = largest + 1;
+        mColumn.resize(mNumTerms, -1);
+      }
+      if (mColumn[SBO_PARENTS[i][1]] < 0)
+      {
+        mColumn[SBO_PARENTS[i][1]] = (int)numColumns++;
+      }
+    }
+
+    mNumWords = (numColumns + WORD_BITS - 1) / WORD_BITS;
+    mBits.resize((size_t)mNumTerms * mNumWords, 0);
+
+    // the parents of each term, in a compressed row layout
+    vector<size_t> first(mNumTerms + 1, 0);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      first[SBO_PARENTS[i][0] + 1]++;
+    }
+    for (unsigned int t = 0; t < mNumTerms; t++)
+    {
+      first[t + 1] += first[t];
+    }
+    vector<unsigned int> parents(numPairs);
+    vector<size_t> next(first.begin(), first.end() - 1);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      parents[next[SBO_PARENTS[i][0]]++] = SBO_PARENTS[i][1];
+    }
+
+    vector<char> state(mNumTerms, 0);
+    for (unsigned int t = 0; t < mNumTerms; t++)
+    {
+      addAncestors(t, first, parents, state);
+    }
+  }
+
+
+  bool isChildOf(unsigned int term, unsigned int parent) const
+  {
+    if (term >= mNumTerms || parent >= mNumTerms || mColumn[parent] < 0)
+    {
+      return false;
+    }
+
+    unsigned int column = (unsigned int)mColumn[parent];
+    return ((mBits[(size_t)term * mNumWords + column / WORD_BITS] 
+             >> (column % WORD_BITS)) & 1u) != 0;
+  }
+
+
+private:
+
+  enum { WORD_BITS = 32 };
+
+  /*
+   * Fills the row of term from the rows of its parents, filling those
+   * first.  The state of a term is 0 before, 1 during and 2 after this; a
+   * cycle (which SBO does not have) is cut where it is found.
+   */
+  void addAncestors(unsigned int term, const vector<size_t>& first,
+                    const vector<unsigned int>& parents, vector<char>& state)
+  {
+    if (state[term] != 0) return;
+    state[term] = 1;
+
+    unsigned int* row = &mBits[(size_t)term * mNumWords];
+    for (size_t i = first[term]; i < first[term + 1]; i++)
+    {
+      unsigned int parent = parents[i];
+      unsigned int column = (unsigned int)mColumn[parent];
+      row[column / WORD_BITS] |= 1u << (column % WORD_BITS);
+
+      addAncestors(parent, first, parents, state);
+      const unsigned int* parentRow = &mBits[(size_t)parent * mNumWords];
+      for (unsigned int w = 0; w < mNumWords; w++)
+      {
+        row[w] |= parentRow[w];
+      }
+    }
+
+    state[term] = 2;
+  }
+
+
+  unsigned int mNumTerms;
+  unsigned int mNumWords;
+  vector<int> mColumn;
+  vector<unsigned int> mBits;
+};
+
+
+/*
+ * Returns the ancestry of SBO terms, building it on the first call; the
+ * initialization of the local static is thread safe.
+ */
+static const SBOAncestry&
+getSBOAncestry()
+{
+  static const SBOAncestry ancestry;
+  return ancestry;
+}
+
+
+/**
+  * functions for checking the SBO term is from correct part of SBO
+  * returns true if the term is-a parent, false otherwise
+  */
+bool
+SBO::isChildOf(unsigned int term, unsigned int parent)
+{
+  return getSBOAncestry().isChildOf(term, parent);
+}
+
+
 /**
   * functions for checking the SBO term is from correct part of SBO
-  * populates the parent-child map
+  * builds the table of ancestors, if that has not been done yet
   */
 void
 SBO::populateSBOTree()
 {
-  // generated from SBO on ${DATE}
-${NEW_TERMS}
+  getSBOAncestry();
 }
 /** @endcond */
 
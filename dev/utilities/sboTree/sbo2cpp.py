@@ -14,10 +14,10 @@ def convertOboFile(oboFile, outputFile):
         term = int( line[8:15] )
       elif line.startswith("is_a:"):
         parent = int( line[10:17] )
-        output.write( "  mParent.insert( pair<const int, int>(%3d, %3d) );\n" % (term, parent))
+        output.write( "  { %3d, %4d },\n" % (term, parent))
       elif line.startswith("is_obsolete:"):
         parent = 1000
-        output.write( "  mParent.insert( pair<const int, int>(%3d, %4d) );\n" % (term, parent))
+        output.write( "  { %3d, %4d },\n" % (term, parent))
     except ValueError:
       pass
   
@@ -0,0 +1,149 @@
+/**
+ * @file    benchmarkBatchEvaluation.cpp
+ * @brief   Compares evaluating a rate law lane by lane and in batches
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/BatchEvaluator.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numLanes = 100000;
+  const char* formula = 
+    "piecewise(Vmax * S / (Km + S), S > 0, 0) * exp(-k * t) "
+    "+ kf * pow(S, 2) - kr * P";
+
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmarkBatchEvaluation [numLanes [formula]]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numLanes = (unsigned int)atoi(argv[1]);
+  }
+  if (argc > 2)
+  {
+    formula = argv[2];
+  }
+
+  ASTNode* math = SBML_parseL3Formula(formula);
+  if (math == NULL)
+  {
+    cout << "  could not parse '" << formula << "'" << endl;
+    return 1;
+  }
+
+  BatchEvaluator evaluator;
+  unsigned long long start = getCurrentMillis();
+  if (evaluator.compile(math) != LIBSBML_OPERATION_SUCCESS)
+  {
+    cout << "  could not compile '" << formula << "'" << endl;
+    delete math;
+    return 1;
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  unsigned int numVariables = evaluator.getNumVariables();
+
+  cout << endl << "Batch evaluation, " << numLanes << " lanes, "
+       << numVariables << " variables, " << evaluator.getNumOperations()
+       << " operations (compiled in " << (stop - start) << " ms):" << endl;
+
+  // one column of values per variable
+  vector< vector<double> > columns(numVariables, vector<double>(numLanes));
+  vector<const double*> variables(numVariables);
+  for (unsigned int v = 0; v < numVariables; v++)
+  {
+    for (unsigned int i = 0; i < numLanes; i++)
+    {
+      columns[v][i] = 0.5 + ((i * 7 + v * 13) % 100) / 50.0;
+    }
+    variables[v] = &columns[v][0];
+  }
+
+  double sum = 0;
+  start = getCurrentMillis();
+  map<string, double> values;
+  for (unsigned int i = 0; i < numLanes; i++)
+  {
+    for (unsigned int v = 0; v < numVariables; v++)
+    {
+      values[evaluator.getVariableId(v)] = columns[v][i];
+    }
+    sum += SBMLTransforms::evaluateASTNode(math, values);
+  }
+  stop = getCurrentMillis();
+
+  cout << "  evaluateASTNode: " << (stop - start) << " ms (sum " 
+       << sum << ")" << endl;
+
+  vector<double> results(numLanes);
+  start = getCurrentMillis();
+  evaluator.evaluate(numVariables > 0 ? &variables[0] : NULL, 
+                     &results[0], numLanes);
+  stop = getCurrentMillis();
+
+  sum = 0;
+  for (unsigned int i = 0; i < numLanes; i++)
+  {
+    sum += results[i];
+  }
+
+  cout << "  BatchEvaluator:  " << (stop - start) << " ms (sum " 
+       << sum << ")" << endl << endl;
+
+  delete math;
+  return 0;
+}
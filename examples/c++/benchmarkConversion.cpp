@@ -0,0 +1,164 @@
+/**
+ * @file    benchmarkConversion.cpp
+ * @brief   Measures the cost of applying one conversion to many documents
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include <sbml/conversion/SBMLConverterRegistry.h>
+#include <sbml/util/ParallelTask.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a small model with a few reactions, each with a local parameter.
+ */
+SBMLDocument*
+createDocument(unsigned int numReactions)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("small");
+
+  for (unsigned int i = 0; i < numReactions; i++)
+  {
+    ostringstream id;
+    id << "R" << i;
+    Reaction* r = model->createReaction();
+    r->setId(id.str());
+    r->setReversible(false);
+    r->setFast(false);
+
+    KineticLaw* kl = r->createKineticLaw();
+    LocalParameter* lp = kl->createLocalParameter();
+    lp->setId("k");
+    lp->setValue(1.0);
+    kl->setMath(SBML_parseL3Formula("k"));
+  }
+
+  return document;
+}
+
+
+void
+createDocuments(vector<SBMLDocument*>& documents, unsigned int numDocuments)
+{
+  for (unsigned int i = 0; i < numDocuments; i++)
+  {
+    documents.push_back(createDocument(10));
+  }
+}
+
+
+void
+deleteDocuments(vector<SBMLDocument*>& documents)
+{
+  for (size_t i = 0; i < documents.size(); i++)
+  {
+    delete documents[i];
+  }
+  documents.clear();
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numDocuments = 10000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmarkConversion [numDocuments]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numDocuments = (unsigned int)atoi(argv[1]);
+  }
+
+  cout << endl << "Promoting local parameters, " << numDocuments 
+       << " documents:" << endl;
+
+  ConversionProperties props;
+  props.addOption("promoteLocalParameters");
+
+  vector<SBMLDocument*> documents;
+  createDocuments(documents, numDocuments);
+
+  unsigned long long start = getCurrentMillis();
+  for (size_t i = 0; i < documents.size(); i++)
+  {
+    documents[i]->convert(props);
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  cout << "  SBMLDocument::convert: " << (stop - start) << " ms" << endl;
+  deleteDocuments(documents);
+
+  createDocuments(documents, numDocuments);
+
+  start = getCurrentMillis();
+  SBMLConverterRegistry::getInstance().convert(documents, props, NULL, 1);
+  stop = getCurrentMillis();
+
+  cout << "  batch, 1 thread: " << (stop - start) << " ms" << endl;
+  deleteDocuments(documents);
+
+  createDocuments(documents, numDocuments);
+
+  start = getCurrentMillis();
+  SBMLConverterRegistry::getInstance().convert(documents, props);
+  stop = getCurrentMillis();
+
+  cout << "  batch, " << ParallelTask::getMaxThreads() << " threads: " 
+       << (stop - start) << " ms" << endl << endl;
+  deleteDocuments(documents);
+
+  return 0;
+}
@@ -0,0 +1,136 @@
+/**
+ * @file    benchmarkErrorLogging.cpp
+ * @brief   Measures the cost of validating a model with many errors
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a model whose species all refer to a compartment that does not
+ * exist, so that every species is reported by the consistency checks.
+ */
+SBMLDocument*
+createModel(unsigned int numSpecies)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("broken");
+
+  for (unsigned int i = 0; i < numSpecies; i++)
+  {
+    ostringstream id;
+    id << "S" << i;
+    Species* s = model->createSpecies();
+    s->setId(id.str());
+    s->setCompartment("missing");
+    s->setInitialConcentration(1.0);
+    s->setBoundaryCondition(false);
+    s->setHasOnlySubstanceUnits(false);
+    s->setConstant(false);
+  }
+
+  return document;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numSpecies = 100000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmarkErrorLogging [numSpecies]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numSpecies = (unsigned int)atoi(argv[1]);
+  }
+
+  cout << endl << "Error logging, " << numSpecies << " species:" << endl;
+
+  SBMLDocument* document = createModel(numSpecies);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+
+  unsigned long long start = getCurrentMillis();
+  unsigned int numErrors = document->checkConsistency();
+  unsigned long long stop = getCurrentMillis();
+
+  cout << "  validation: " << numErrors << " errors in " 
+       << (stop - start) << " ms" << endl;
+
+  SBMLErrorLog log;
+  start = getCurrentMillis();
+  for (unsigned int i = 0; i < numSpecies; i++)
+  {
+    log.logError(InvalidSpeciesCompartmentRef, 3, 1, "details");
+  }
+  stop = getCurrentMillis();
+
+  cout << "  logError: " << log.getNumErrors() << " errors in " 
+       << (stop - start) << " ms" << endl;
+
+  size_t length = 0;
+  start = getCurrentMillis();
+  for (unsigned int i = 0; i < document->getNumErrors(); i++)
+  {
+    length += document->getError(i)->getMessage().size();
+  }
+  stop = getCurrentMillis();
+
+  cout << "  reading all messages: " << (stop - start) << " ms ("
+       << length << " characters)" << endl << endl;
+
+  delete document;
+  return 0;
+}
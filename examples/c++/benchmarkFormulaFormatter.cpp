@@ -0,0 +1,218 @@
+/**
+ * @file    benchmarkFormulaFormatter.cpp
+ * @brief   Measures how fast large expression trees are written as infix text
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <clocale>
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Terms the generated formulas are made of; each '#' is replaced by a
+ * number so that the formulas contain many different names and numbers.
+ */
+static const char* TERMS[] =
+{
+  "Vmax_# * S_# / (Km_# + S_#)",
+  "#.25e-3 * A_# * B_#",
+  "-k_# * C_#^2",
+  "kcat * E_# * S / (0.#7 * (1 + I_# / Ki) + S)",
+  "piecewise(k_# * S, S > #.5, 0)",
+  "exp(-Ea_# / (8.314 * T)) * sqrt(S_#)",
+  NULL
+};
+
+
+/*
+ * Returns a sum of numTerms terms, numbered starting at first.
+ */
+string
+createFormula(unsigned int first, unsigned int numTerms)
+{
+  string formula;
+  for (unsigned int t = 0; t < numTerms; t++)
+  {
+    ostringstream number;
+    number << first + t;
+    string term = TERMS[(first + t) % 6];
+    string::size_type pos;
+    while ((pos = term.find('#')) != string::npos)
+    {
+      term.replace(pos, 1, number.str());
+    }
+    if (t > 0)
+    {
+      formula += " + ";
+    }
+    formula += term;
+  }
+  return formula;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numFormulas = 2000;
+  unsigned int numTerms = 50;
+  unsigned int repeats = 5;
+
+  if (argc > 4)
+  {
+    cout << endl 
+         << "Usage: benchmarkFormulaFormatter [numFormulas [numTerms [repeats]]]"
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numFormulas = (unsigned int)atoi(argv[1]);
+  }
+
+  if (argc > 2)
+  {
+    numTerms = (unsigned int)atoi(argv[2]);
+  }
+
+  if (argc > 3)
+  {
+    repeats = (unsigned int)atoi(argv[3]);
+  }
+
+  /*
+   * Use the locale of the environment, as most applications do; numbers
+   * must still be written with a '.' whatever the locale is.
+   */
+  setlocale(LC_ALL, "");
+
+  vector<ASTNode*> trees;
+  trees.reserve(numFormulas);
+  for (unsigned int i = 0; i < numFormulas; i++)
+  {
+    string formula = createFormula(i * numTerms, numTerms);
+    ASTNode* math = SBML_parseL3Formula(formula.c_str());
+    if (math == NULL)
+    {
+      cerr << "Could not parse '" << formula << "'" << endl;
+      return 1;
+    }
+    trees.push_back(math);
+  }
+
+  /* one char* per formula, as returned by SBML_formulaToL3String() */
+  vector<string> strings(numFormulas);
+  unsigned long long start = getCurrentMillis();
+  for (unsigned int r = 0; r < repeats; r++)
+  {
+    for (unsigned int i = 0; i < numFormulas; i++)
+    {
+      char* str = SBML_formulaToL3String(trees[i]);
+      if (r == 0)
+      {
+        strings[i] = str;
+      }
+      free(str);
+    }
+  }
+  unsigned long long charTime = getCurrentMillis() - start;
+
+  /* one std::string reused for all formulas */
+  unsigned int mismatches = 0;
+  size_t totalLength = 0;
+  string buffer;
+  start = getCurrentMillis();
+  for (unsigned int r = 0; r < repeats; r++)
+  {
+    for (unsigned int i = 0; i < numFormulas; i++)
+    {
+      buffer.clear();
+      SBML_appendFormulaToL3String(buffer, trees[i]);
+      if (r == 0)
+      {
+        totalLength += buffer.size();
+        if (buffer != strings[i])
+        {
+          mismatches++;
+        }
+      }
+    }
+  }
+  unsigned long long appendTime = getCurrentMillis() - start;
+
+  /* the Level 1 formatter, for comparison */
+  start = getCurrentMillis();
+  for (unsigned int r = 0; r < repeats; r++)
+  {
+    for (unsigned int i = 0; i < numFormulas; i++)
+    {
+      buffer.clear();
+      SBML_appendFormulaToString(buffer, trees[i]);
+    }
+  }
+  unsigned long long l1Time = getCurrentMillis() - start;
+
+  for (unsigned int i = 0; i < numFormulas; i++)
+  {
+    delete trees[i];
+  }
+
+  cout << endl
+       << "                     formulas: " << numFormulas << " x " 
+       << numTerms << " terms" << endl
+       << "     characters per iteration: " << totalLength << endl
+       << "                   iterations: " << repeats << endl
+       << "                       locale: " << setlocale(LC_NUMERIC, NULL) 
+       << endl
+       << "       SBML_formulaToL3String: " << charTime << " ms" << endl
+       << " SBML_appendFormulaToL3String: " << appendTime << " ms" << endl
+       << "   SBML_appendFormulaToString: " << l1Time << " ms" << endl
+       << "         results that differ: " << mismatches << endl << endl;
+
+  return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file    benchmarkIdentifiers.cpp
+ * @brief   Measures the identifier checks on a model with many ids
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include <sbml/util/IdList.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a model with one compartment and the given number of species
+ * and parameters, each with an id and a metaid.
+ */
+SBMLDocument*
+createModel(unsigned int numIds)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("ids");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setConstant(true);
+
+  for (unsigned int i = 0; i < numIds; i++)
+  {
+    ostringstream id, metaid;
+    id << "x" << i;
+    metaid << "m" << i;
+
+    if (i % 2 == 0)
+    {
+      Species* s = model->createSpecies();
+      s->setId(id.str());
+      s->setMetaId(metaid.str());
+      s->setCompartment("c");
+      s->setInitialConcentration(1.0);
+      s->setBoundaryCondition(false);
+      s->setHasOnlySubstanceUnits(false);
+      s->setConstant(false);
+    }
+    else
+    {
+      Parameter* p = model->createParameter();
+      p->setId(id.str());
+      p->setMetaId(metaid.str());
+      p->setValue(1.0);
+      p->setConstant(true);
+    }
+  }
+
+  return document;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numIds = 100000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmarkIdentifiers [numIds]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numIds = (unsigned int)atoi(argv[1]);
+  }
+
+  cout << endl << "Identifiers, " << numIds << " ids:" << endl;
+
+  IdList list;
+  unsigned long long start = getCurrentMillis();
+  for (unsigned int i = 0; i < numIds; i++)
+  {
+    ostringstream id;
+    id << "x" << i;
+    if (!list.contains(id.str()))
+    {
+      list.append(id.str());
+    }
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  cout << "  IdList contains/append: " << list.size() << " ids in " 
+       << (stop - start) << " ms" << endl;
+
+  SBMLDocument* document = createModel(numIds);
+  document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+
+  start = getCurrentMillis();
+  unsigned int numErrors = document->checkConsistency();
+  stop = getCurrentMillis();
+
+  cout << "  identifier validation: " << numErrors << " errors in " 
+       << (stop - start) << " ms" << endl << endl;
+
+  delete document;
+  return 0;
+}
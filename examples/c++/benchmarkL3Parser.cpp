@@ -0,0 +1,184 @@
+/**
+ * @file    benchmarkL3Parser.cpp
+ * @brief   Measures the throughput of the infix formula parser on several threads
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include <sbml/util/ParallelTask.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Templates for the generated formulas; each '#' is replaced by a number
+ * so that no two formulas are the same.
+ */
+static const char* TEMPLATES[] =
+{
+  "Vmax_# * S / (Km_# + S)",
+  "k1 * A_# * B - k2 * C_# + #.5e-3",
+  "kcat * E * S_# / (Km * (1 + I_# / Ki) + S_#)",
+  "piecewise(k_# * S, S > 0.#, 0)",
+  "exp(-Ea / (R * T_#)) * pow(S, 2) / (1 + sqrt(S_#))",
+  "(1/#) * rem(n_#, 2) + quotient(n, 3) * max(a, b_#, c)",
+  NULL
+};
+
+
+/*
+ * Parses every formula with the given index and stores the result as an
+ * infix string, so that the results of different runs can be compared.
+ */
+class ParseFormulas : public ParallelTask
+{
+public:
+  ParseFormulas(const vector<string>& formulas, vector<string>& results)
+    : mFormulas(formulas)
+    , mResults(results)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    ASTNode* math = SBML_parseL3Formula(mFormulas[index].c_str());
+    if (math == NULL)
+    {
+      char* error = SBML_getLastParseL3Error();
+      mResults[index] = error;
+      free(error);
+      return;
+    }
+    char* str = SBML_formulaToL3String(math);
+    mResults[index] = str;
+    free(str);
+    delete math;
+  }
+
+private:
+  const vector<string>& mFormulas;
+  vector<string>& mResults;
+};
+
+
+/*
+ * Parses all formulas using at most the given number of threads, and
+ * returns the time taken in milliseconds.
+ */
+unsigned long long
+timeParsing(const vector<string>& formulas, vector<string>& results,
+            unsigned int threads)
+{
+  results.assign(formulas.size(), "");
+  ParseFormulas task(formulas, results);
+  unsigned long long start = getCurrentMillis();
+  ParallelTask::execute(task, (unsigned int)formulas.size(), threads);
+  return getCurrentMillis() - start;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numFormulas = 200000;
+  unsigned int threads = ParallelTask::getMaxThreads();
+
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmarkL3Parser [numFormulas [numThreads]]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numFormulas = (unsigned int)atoi(argv[1]);
+  }
+
+  if (argc > 2)
+  {
+    threads = (unsigned int)atoi(argv[2]);
+  }
+
+  vector<string> formulas;
+  formulas.reserve(numFormulas);
+  for (unsigned int i = 0; i < numFormulas; i++)
+  {
+    ostringstream number;
+    number << i;
+    string formula = TEMPLATES[i % 6];
+    string::size_type pos;
+    while ((pos = formula.find('#')) != string::npos)
+    {
+      formula.replace(pos, 1, number.str());
+    }
+    formulas.push_back(formula);
+  }
+
+  vector<string> serial;
+  vector<string> parallel;
+  unsigned long long serialTime = timeParsing(formulas, serial, 1);
+  unsigned long long parallelTime = timeParsing(formulas, parallel, threads);
+
+  unsigned int mismatches = 0;
+  for (size_t i = 0; i < formulas.size(); i++)
+  {
+    if (serial[i] != parallel[i])
+    {
+      mismatches++;
+    }
+  }
+
+  cout << endl
+       << "                  formulas: " << numFormulas << endl
+       << "      thread support built: " 
+       << (ParallelTask::hasThreadSupport() ? "yes" : "no") << endl
+       << "     parse time (1 thread): " << serialTime << " ms" << endl
+       << "    parse time (" << threads << " threads): " << parallelTime 
+       << " ms" << endl
+       << "       results that differ: " << mismatches << endl << endl;
+
+  return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,234 @@
+/**
+ * @file    benchmarkMath.cpp
+ * @brief   Measures MathML parse time and the memory used by math trees
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include <new>
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Heap usage of the program, kept up to date by the replacement operator
+ * new and delete below.  Every block is prefixed by its size so that it
+ * can be subtracted again when it is freed.
+ */
+static unsigned long long liveBytes = 0;
+static unsigned long long numAllocations = 0;
+
+static const size_t HEADER_SIZE = 16;
+
+
+void*
+operator new (size_t size)
+{
+  char* block = static_cast<char*>(malloc(size + HEADER_SIZE));
+  if (block == NULL)
+  {
+    throw std::bad_alloc();
+  }
+  *reinterpret_cast<size_t*>(block) = size;
+  liveBytes += size;
+  numAllocations++;
+  return block + HEADER_SIZE;
+}
+
+
+void
+operator delete (void* p) throw()
+{
+  if (p == NULL) return;
+  char* block = static_cast<char*>(p) - HEADER_SIZE;
+  liveBytes -= *reinterpret_cast<size_t*>(block);
+  free(block);
+}
+
+
+/*
+ * Formulas used when no model is given.
+ */
+static const char* SAMPLE_FORMULAS[] =
+{
+  "Vmax * S / (Km + S)",
+  "k1 * A * B - k2 * C",
+  "kcat * E * S / (Km * (1 + I / Ki) + S)",
+  "piecewise(k * S, S > 0.5, 0)",
+  "exp(-Ea / (R * T)) * pow(S, 2) / (1 + sqrt(S))",
+  "rem(n, 2) + quotient(n, 3) * max(a, b, c)",
+  NULL
+};
+
+
+/*
+ * Adds the math of every element of the document to the list.
+ */
+void
+collectMath(SBMLDocument* document, vector<string>& mathml)
+{
+  List* elements = document->getAllElements();
+  for (unsigned int i = 0; i < elements->getSize(); i++)
+  {
+    const SBase* element = static_cast<const SBase*>(elements->get(i));
+    const ASTNode* math = element->getMath();
+    if (math != NULL)
+    {
+      char* str = writeMathMLToString(math);
+      mathml.push_back(str);
+      free(str);
+    }
+  }
+  delete elements;
+}
+
+
+/*
+ * Counts the nodes of a tree, and how many plugin objects they carry.
+ */
+void
+countNodes(const ASTNode* node, unsigned long& numNodes, unsigned long& numPlugins)
+{
+  numNodes++;
+  numPlugins += node->getNumPlugins();
+  for (unsigned int i = 0; i < node->getNumChildren(); i++)
+  {
+    countNodes(node->getChild(i), numNodes, numPlugins);
+  }
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int repeats = 100;
+  vector<string> mathml;
+
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmarkMath [filename [repeats]]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    SBMLDocument* document = readSBML(argv[1]);
+    if (document->getNumErrors(LIBSBML_SEV_ERROR) > 0 
+      || document->getNumErrors(LIBSBML_SEV_FATAL) > 0)
+    {
+      document->printErrors(cerr);
+      delete document;
+      return 1;
+    }
+    collectMath(document, mathml);
+    delete document;
+  }
+  else
+  {
+    for (unsigned int i = 0; SAMPLE_FORMULAS[i] != NULL; i++)
+    {
+      ASTNode* math = SBML_parseL3Formula(SAMPLE_FORMULAS[i]);
+      char* str = writeMathMLToString(math);
+      mathml.push_back(str);
+      free(str);
+      delete math;
+    }
+    repeats *= 100;
+  }
+
+  if (argc > 2)
+  {
+    repeats = (unsigned int)atoi(argv[2]);
+  }
+
+  unsigned long numNodes = 0;
+  unsigned long numPlugins = 0;
+
+  // memory held by one copy of every math element
+  vector<ASTNode*> trees;
+  trees.reserve(mathml.size());
+  unsigned long long bytesBefore = liveBytes;
+  unsigned long long allocationsBefore = numAllocations;
+  for (size_t i = 0; i < mathml.size(); i++)
+  {
+    trees.push_back(readMathMLFromString(mathml[i].c_str()));
+  }
+  unsigned long long treeBytes = liveBytes - bytesBefore;
+  unsigned long long treeAllocations = numAllocations - allocationsBefore;
+  for (size_t i = 0; i < trees.size(); i++)
+  {
+    delete trees[i];
+  }
+
+  unsigned long long start = getCurrentMillis();
+  for (unsigned int r = 0; r < repeats; r++)
+  {
+    for (size_t i = 0; i < mathml.size(); i++)
+    {
+      ASTNode* math = readMathMLFromString(mathml[i].c_str());
+      if (r == 0 && math != NULL)
+      {
+        countNodes(math, numNodes, numPlugins);
+      }
+      delete math;
+    }
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  cout << endl
+       << "             math elements: " << mathml.size() << endl
+       << "                     nodes: " << numNodes << endl
+       << "      plugins on the nodes: " << numPlugins << endl
+       << "           sizeof(ASTNode): " << sizeof(ASTNode) << " bytes" << endl
+       << "        heap used by trees: " << treeBytes << " bytes in "
+       << treeAllocations << " allocations" << endl
+       << "     heap per node (avg.): " 
+       << (numNodes > 0 ? treeBytes / numNodes : 0) << " bytes" << endl
+       << "   parse time (" << repeats << " passes): " << (stop - start) << " ms" 
+       << endl << endl;
+
+  return 0;
+}
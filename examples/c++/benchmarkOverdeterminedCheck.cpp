@@ -0,0 +1,204 @@
+/**
+ * @file    benchmarkOverdeterminedCheck.cpp
+ * @brief   Times the overdetermined model check on a large synthetic model
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a chain S0 -> S1 -> ... -> Sn of mass action reactions, plus an
+ * algebraic rule tying the parameter x to the first species.  If
+ * overdetermined is true, a second algebraic rule over the same species
+ * leaves one equation without a variable; an unused variable y keeps the
+ * counts equal, so that the matching itself has to find the problem.
+ */
+SBMLDocument*
+createModel(unsigned int numReactions, bool overdetermined)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("chain");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setSize(1);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+
+  Parameter* k = model->createParameter();
+  k->setId("k");
+  k->setValue(0.1);
+  k->setConstant(true);
+
+  Parameter* x = model->createParameter();
+  x->setId("x");
+  x->setConstant(false);
+
+  for (unsigned int i = 0; i <= numReactions; i++)
+  {
+    ostringstream id;
+    id << "S" << i;
+    Species* s = model->createSpecies();
+    s->setId(id.str());
+    s->setCompartment("c");
+    s->setInitialAmount(i == 0 ? 1.0 : 0.0);
+    s->setBoundaryCondition(false);
+    s->setHasOnlySubstanceUnits(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int i = 0; i < numReactions; i++)
+  {
+    ostringstream id, from, to;
+    id << "R" << i;
+    from << "S" << i;
+    to << "S" << i + 1;
+
+    Reaction* r = model->createReaction();
+    r->setId(id.str());
+    r->setReversible(false);
+    r->setFast(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(from.str());
+    sr->setStoichiometry(1);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(to.str());
+    sr->setStoichiometry(1);
+    sr->setConstant(true);
+
+    KineticLaw* kl = r->createKineticLaw();
+    ASTNode* math = SBML_parseL3Formula(("k * " + from.str()).c_str());
+    kl->setMath(math);
+    delete math;
+  }
+
+  AlgebraicRule* rule = model->createAlgebraicRule();
+  ASTNode* math = SBML_parseL3Formula("x - S0");
+  rule->setMath(math);
+  delete math;
+
+  if (overdetermined)
+  {
+    Parameter* y = model->createParameter();
+    y->setId("y");
+    y->setConstant(false);
+
+    rule = model->createAlgebraicRule();
+    math = SBML_parseL3Formula("S0 - 1");
+    rule->setMath(math);
+    delete math;
+  }
+
+  return document;
+}
+
+
+/*
+ * Runs only the overdetermined model check and reports how long it took.
+ */
+void
+timeCheck(unsigned int numReactions, bool overdetermined)
+{
+  SBMLDocument* document = createModel(numReactions, overdetermined);
+
+  document->setConsistencyChecks(LIBSBML_CAT_GENERAL_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_IDENTIFIER_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MATHML_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+  document->setConsistencyChecks(LIBSBML_CAT_OVERDETERMINED_MODEL, true);
+
+  unsigned long long start = getCurrentMillis();
+  unsigned int failures = document->checkConsistency();
+  unsigned long long stop = getCurrentMillis();
+
+  bool reported = false;
+  for (unsigned int i = 0; i < failures; i++)
+  {
+    if (document->getError(i)->getErrorId() == OverdeterminedSystem)
+      reported = true;
+  }
+
+  cout << "  " << (overdetermined ? "overdetermined" : "well determined")
+       << " model: " << (stop - start) << " ms, "
+       << (reported ? "reported as overdetermined" : "not reported") << endl;
+
+  delete document;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numReactions = 50000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmarkOverdeterminedCheck [numReactions]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc == 2)
+  {
+    numReactions = (unsigned int)atoi(argv[1]);
+  }
+
+  cout << endl << "Overdetermined model check, " << numReactions 
+       << " reactions:" << endl;
+
+  timeCheck(numReactions, false);
+  timeCheck(numReactions, true);
+
+  cout << endl;
+  return 0;
+}
@@ -0,0 +1,168 @@
+/**
+ * @file    benchmarkRuleOrdering.cpp
+ * @brief   Measures cycle detection and sorting of many assignment rules
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <sbml/SBMLTypes.h>
+#include <sbml/conversion/ConversionProperties.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a model with a chain of assignment rules listed in the reverse
+ * order of their dependencies: p0 = p1 + 1, p1 = p2 + 1, ... , pN = 1.
+ */
+SBMLDocument*
+createModel(unsigned int level, unsigned int version, unsigned int numRules)
+{
+  SBMLDocument* document = new SBMLDocument(level, version);
+  Model* model = document->createModel();
+  model->setId("chain");
+
+  for (unsigned int i = 0; i < numRules; i++)
+  {
+    ostringstream id;
+    id << "p" << i;
+    Parameter* p = model->createParameter();
+    p->setId(id.str());
+    p->setConstant(false);
+  }
+
+  for (unsigned int i = 0; i < numRules; i++)
+  {
+    ostringstream id, formula;
+    id << "p" << i;
+    if (i + 1 < numRules)
+    {
+      formula << "p" << (i + 1) << " + 1";
+    }
+    else
+    {
+      formula << "1";
+    }
+
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(id.str());
+    rule->setFormula(formula.str());
+  }
+
+  return document;
+}
+
+
+/*
+ * Restricts the consistency checks to the ones looking at the rules.
+ */
+void
+setChecks(SBMLDocument* document)
+{
+  document->setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  document->setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+  document->setConsistencyChecks(LIBSBML_CAT_SBO_CONSISTENCY, false);
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numRules = 50000;
+
+  if (argc > 2)
+  {
+    cout << endl << "Usage: benchmarkRuleOrdering [numRules]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numRules = (unsigned int)atoi(argv[1]);
+  }
+
+  cout << endl << "Rule ordering, " << numRules << " rules:" << endl;
+
+  // cycle detection, part of the general consistency checks
+  SBMLDocument* document = createModel(3, 1, numRules);
+  setChecks(document);
+
+  unsigned long long start = getCurrentMillis();
+  unsigned int numErrors = document->checkConsistency();
+  unsigned long long stop = getCurrentMillis();
+
+  cout << "  L3V1 validation: " << numErrors << " errors in " 
+       << (stop - start) << " ms" << endl;
+
+  // sorting the rules
+  ConversionProperties props;
+  props.addOption("sortRules", true);
+
+  start = getCurrentMillis();
+  int result = document->convert(props);
+  stop = getCurrentMillis();
+
+  cout << "  sortRules: " 
+       << (result == LIBSBML_OPERATION_SUCCESS ? "done" : "failed") 
+       << " in " << (stop - start) << " ms, first rule '" 
+       << document->getModel()->getRule(0)->getVariable() << "'" << endl;
+
+  delete document;
+
+  // L2V1 requires rules to be listed in order, so every rule but the
+  // last is reported
+  document = createModel(2, 1, numRules);
+  setChecks(document);
+
+  start = getCurrentMillis();
+  numErrors = document->checkConsistency();
+  stop = getCurrentMillis();
+
+  cout << "  L2V1 validation: " << numErrors << " errors in " 
+       << (stop - start) << " ms" << endl << endl;
+
+  delete document;
+  return 0;
+}
@@ -0,0 +1,241 @@
+/**
+ * @file    benchmarkSimplifyMath.cpp
+ * @brief   Measures the effect of the math simplification converter
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This sample program is distributed under a different license than the rest
+ * of libSBML.  This program uses the open-source MIT license, as follows:
+ *
+ * Copyright (c) 2013-2018 by the California Institute of Technology
+ * (California, USA), the European Bioinformatics Institute (EMBL-EBI, UK)
+ * and the University of Heidelberg (Germany), with support from the National
+ * Institutes of Health (USA) under grant R01GM070923.  All rights reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a
+ * copy of this software and associated documentation files (the "Software"),
+ * to deal in the Software without restriction, including without limitation
+ * the rights to use, copy, modify, merge, publish, distribute, sublicense,
+ * and/or sell copies of the Software, and to permit persons to whom the
+ * Software is furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL
+ * THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
+ * DEALINGS IN THE SOFTWARE.
+ *
+ * Neither the name of the California Institute of Technology (Caltech), nor
+ * of the European Bioinformatics Institute (EMBL-EBI), nor of the University
+ * of Heidelberg, nor the names of any contributors, may be used to endorse
+ * or promote products derived from this software without specific prior
+ * written permission.
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstdlib>
+#include <cstring>
+#include <sbml/SBMLTypes.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/conversion/ConversionProperties.h>
+#include "util.h"
+
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+
+/*
+ * Creates a model of numReactions mass action reactions whose rate laws
+ * call a function definition with a constant exponent, the way converted
+ * models often look.  Expanding the function definitions then leaves
+ * expressions such as k * (S^1 * 1) * (2 - 1) + 0 behind.
+ */
+SBMLDocument*
+createModel(unsigned int numReactions)
+{
+  SBMLDocument* document = new SBMLDocument(3, 1);
+  Model* model = document->createModel();
+  model->setId("expanded");
+
+  Compartment* c = model->createCompartment();
+  c->setId("c");
+  c->setSize(1);
+  c->setSpatialDimensions(3.0);
+  c->setConstant(true);
+
+  FunctionDefinition* fd = model->createFunctionDefinition();
+  fd->setId("massAction");
+  ASTNode* math = SBML_parseL3Formula("lambda(k, s, n, k * (s^n * 1))");
+  fd->setMath(math);
+  delete math;
+
+  for (unsigned int i = 0; i <= numReactions; i++)
+  {
+    ostringstream id;
+    id << "S" << i;
+    Species* s = model->createSpecies();
+    s->setId(id.str());
+    s->setCompartment("c");
+    s->setInitialConcentration(1.0 + i);
+    s->setBoundaryCondition(false);
+    s->setHasOnlySubstanceUnits(false);
+    s->setConstant(false);
+  }
+
+  for (unsigned int i = 0; i < numReactions; i++)
+  {
+    ostringstream id, k, from, to, formula;
+    id << "R" << i;
+    k << "k" << i;
+    from << "S" << i;
+    to << "S" << i + 1;
+
+    Parameter* p = model->createParameter();
+    p->setId(k.str());
+    p->setValue(0.1 * (i + 1));
+    p->setConstant(true);
+
+    Reaction* r = model->createReaction();
+    r->setId(id.str());
+    r->setReversible(false);
+    r->setFast(false);
+
+    SpeciesReference* sr = r->createReactant();
+    sr->setSpecies(from.str());
+    sr->setStoichiometry(1);
+    sr->setConstant(true);
+
+    sr = r->createProduct();
+    sr->setSpecies(to.str());
+    sr->setStoichiometry(1);
+    sr->setConstant(true);
+
+    formula << "c * massAction(" << k.str() << ", " << from.str() 
+            << ", 1) * (2 - 1) + 0";
+    KineticLaw* kl = r->createKineticLaw();
+    math = SBML_parseL3Formula(formula.str().c_str());
+    kl->setMath(math);
+    delete math;
+  }
+
+  ConversionProperties props;
+  props.addOption("expandFunctionDefinitions", true);
+  document->convert(props);
+
+  return document;
+}
+
+
+unsigned int
+countNodes(const ASTNode* node)
+{
+  unsigned int count = 1;
+  for (unsigned int i = 0; i < node->getNumChildren(); i++)
+  {
+    count += countNodes(node->getChild(i));
+  }
+  return count;
+}
+
+
+/*
+ * Prints the size of all math in the model and the time needed to
+ * evaluate every rate law numEvaluations times.
+ */
+void
+measure(const char* label, SBMLDocument* document, unsigned int numEvaluations)
+{
+  Model* model = document->getModel();
+
+  unsigned int numNodes = 0;
+  size_t mathmlSize = 0;
+  for (unsigned int i = 0; i < model->getNumReactions(); i++)
+  {
+    const ASTNode* math = model->getReaction(i)->getKineticLaw()->getMath();
+    numNodes += countNodes(math);
+    char* mathml = writeMathMLToString(math);
+    mathmlSize += strlen(mathml);
+    free(mathml);
+  }
+
+  SBMLTransforms::IdValueMap values;
+  SBMLTransforms::getComponentValuesForModel(model, values);
+
+  double sum = 0;
+  unsigned long long start = getCurrentMillis();
+  for (unsigned int n = 0; n < numEvaluations; n++)
+  {
+    for (unsigned int i = 0; i < model->getNumReactions(); i++)
+    {
+      sum += SBMLTransforms::evaluateASTNode(
+        model->getReaction(i)->getKineticLaw()->getMath(), values, model);
+    }
+  }
+  unsigned long long stop = getCurrentMillis();
+
+  cout << "  " << label << ": " << numNodes << " nodes, "
+       << mathmlSize << " bytes of MathML, evaluation " 
+       << (stop - start) << " ms (sum " << sum << ")" << endl;
+}
+
+
+int
+main (int argc, char *argv[])
+{
+  unsigned int numReactions = 1000;
+  unsigned int numEvaluations = 200;
+
+  if (argc > 3)
+  {
+    cout << endl << "Usage: benchmarkSimplifyMath [numReactions [numEvaluations]]" 
+         << endl << endl;
+    return 1;
+  }
+
+  if (argc > 1)
+  {
+    numReactions = (unsigned int)atoi(argv[1]);
+  }
+  if (argc > 2)
+  {
+    numEvaluations = (unsigned int)atoi(argv[2]);
+  }
+
+  cout << endl << "Math simplification, " << numReactions 
+       << " reactions, " << numEvaluations << " evaluations:" << endl;
+
+  SBMLDocument* document = createModel(numReactions);
+
+  measure("before", document, numEvaluations);
+
+  ConversionProperties props;
+  props.addOption("simplifyMath", true);
+
+  unsigned long long start = getCurrentMillis();
+  int result = document->convert(props);
+  unsigned long long stop = getCurrentMillis();
+
+  if (result != LIBSBML_OPERATION_SUCCESS)
+  {
+    cout << "  conversion failed" << endl;
+    delete document;
+    return 1;
+  }
+
+  cout << "  conversion: " << (stop - start) << " ms" << endl;
+  measure("after ", document, numEvaluations);
+
+  cout << endl;
+  delete document;
+  return 0;
+}
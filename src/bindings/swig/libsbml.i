@@ -207,11 +207,6 @@ LIBSBML_CPP_NAMESPACE_USE
 %ignore SBMLExternalValidator::getArguments;
 %ignore SBMLExternalValidator::setArguments;
 
-/**
- * Ignore 'static ParentMap mParent;' in SBO.h
- */
-%ignore mParent;
-
 /**
  * Ignore 'struct xmlErrorTableEntry' in XMLError.h.
  */
@@ -0,0 +1,828 @@
+/**
+ * @file    BatchEvaluator.cpp
+ * @brief   Evaluates a formula for many sets of values at once.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <sbml/BatchEvaluator.h>
+#include <sbml/Model.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/util/util.h>
+
+#include <cmath>
+#include <limits>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * The number of lanes evaluated together; the scratch space of a formula
+ * is this many values per operation, which keeps it in the first level
+ * cache for formulas of typical size.
+ */
+static const unsigned int BLOCK_SIZE = 64;
+
+enum BatchOperationCode
+{
+    BATCH_LOAD
+  , BATCH_NEGATE
+  , BATCH_PLUS
+  , BATCH_MINUS
+  , BATCH_TIMES
+  , BATCH_DIVIDE
+  , BATCH_POWER
+  , BATCH_ROOT
+  , BATCH_ABS
+  , BATCH_FLOOR
+  , BATCH_CEILING
+  , BATCH_FACTORIAL
+  , BATCH_REM
+  , BATCH_QUOTIENT
+  , BATCH_MIN
+  , BATCH_MAX
+  , BATCH_EQ
+  , BATCH_NEQ
+  , BATCH_LT
+  , BATCH_LEQ
+  , BATCH_GT
+  , BATCH_GEQ
+  , BATCH_AND
+  , BATCH_OR
+  , BATCH_XOR
+  , BATCH_IMPLIES
+  , BATCH_NOT
+  , BATCH_PIECE_START
+  , BATCH_PIECE
+  , BATCH_PIECE_OTHERWISE
+  , BATCH_FUNCTION
+};
+
+
+/*
+ * The functions below follow the formulas used by
+ * SBMLTransforms::evaluateASTNode(), so that both give the same results.
+ */
+static double arccosh(double x)
+{
+  return log(x + pow((x - 1), 0.5) * pow((x + 1), 0.5));
+}
+
+static double arccot(double x)  { return atan(1.0 / x); }
+
+static double arccoth(double x)
+{
+  return ((1.0 / 2.0) * log((x + 1.0) / (x - 1.0)));
+}
+
+static double arccsc(double x)  { return asin(1.0 / x); }
+
+static double arccsch(double x)
+{
+  return log((1.0 + pow(1.0 + pow(x, 2), 0.5)) / x);
+}
+
+static double arcsec(double x)  { return acos(1.0 / x); }
+
+static double arcsech(double x)
+{
+  return log((1.0 + pow((1.0 - pow(x, 2)), 0.5)) / x);
+}
+
+static double arcsinh(double x)
+{
+  return log(x + pow((1.0 + pow(x, 2)), 0.5));
+}
+
+static double arctanh(double x)
+{
+  return 0.5 * log((1.0 + x) / (1.0 - x));
+}
+
+static double cot(double x)  { return (1.0 / tan(x)); }
+static double coth(double x) { return cosh(x) / sinh(x); }
+static double csc(double x)  { return (1.0 / sin(x)); }
+static double csch(double x) { return (1.0 / sinh(x)); }
+static double sec(double x)  { return 1.0 / cos(x); }
+static double sech(double x) { return 1.0 / cosh(x); }
+
+static double acos_(double x)  { return acos(x); }
+static double asin_(double x)  { return asin(x); }
+static double atan_(double x)  { return atan(x); }
+static double cos_(double x)   { return cos(x); }
+static double cosh_(double x)  { return cosh(x); }
+static double exp_(double x)   { return exp(x); }
+static double log_(double x)   { return log(x); }
+static double log10_(double x) { return log10(x); }
+static double sin_(double x)   { return sin(x); }
+static double sinh_(double x)  { return sinh(x); }
+static double tan_(double x)   { return tan(x); }
+static double tanh_(double x)  { return tanh(x); }
+
+
+static double
+factorial(double x)
+{
+  if (util_isNaN(x)) return x;
+
+  double n = floor(x);
+  if (n > 170) return util_PosInf();
+
+  double result = 1;
+  for (int i = (int)n; i > 1; --i)
+  {
+    result *= i;
+  }
+  return result;
+}
+
+
+/*
+ * Returns the C function computing a node type of one argument, or NULL
+ * if the node type is handled differently.
+ */
+static double 
+(*getFunction(ASTNodeType_t type))(double)
+{
+  switch (type)
+  {
+  case AST_FUNCTION_ARCCOS:  return acos_;
+  case AST_FUNCTION_ARCCOSH: return arccosh;
+  case AST_FUNCTION_ARCCOT:  return arccot;
+  case AST_FUNCTION_ARCCOTH: return arccoth;
+  case AST_FUNCTION_ARCCSC:  return arccsc;
+  case AST_FUNCTION_ARCCSCH: return arccsch;
+  case AST_FUNCTION_ARCSEC:  return arcsec;
+  case AST_FUNCTION_ARCSECH: return arcsech;
+  case AST_FUNCTION_ARCSIN:  return asin_;
+  case AST_FUNCTION_ARCSINH: return arcsinh;
+  case AST_FUNCTION_ARCTAN:  return atan_;
+  case AST_FUNCTION_ARCTANH: return arctanh;
+  case AST_FUNCTION_COS:     return cos_;
+  case AST_FUNCTION_COSH:    return cosh_;
+  case AST_FUNCTION_COT:     return cot;
+  case AST_FUNCTION_COTH:    return coth;
+  case AST_FUNCTION_CSC:     return csc;
+  case AST_FUNCTION_CSCH:    return csch;
+  case AST_FUNCTION_EXP:     return exp_;
+  case AST_FUNCTION_FACTORIAL: return factorial;
+  case AST_FUNCTION_LN:      return log_;
+  case AST_FUNCTION_SEC:     return sec;
+  case AST_FUNCTION_SECH:    return sech;
+  case AST_FUNCTION_SIN:     return sin_;
+  case AST_FUNCTION_SINH:    return sinh_;
+  case AST_FUNCTION_TAN:     return tan_;
+  case AST_FUNCTION_TANH:    return tanh_;
+  default:                   return NULL;
+  }
+}
+
+/** @endcond */
+
+
+BatchEvaluator::BatchEvaluator()
+  : mNumSlots(0)
+  , mResultSlot(0)
+  , mCompiled(false)
+  , mFailed(false)
+{
+}
+
+
+BatchEvaluator::~BatchEvaluator()
+{
+}
+
+
+int
+BatchEvaluator::compile(const ASTNode* math, const Model* model,
+                        const std::map<std::string, double>* constants)
+{
+  clear();
+
+  if (math == NULL)
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  ASTNode* expanded = NULL;
+  if (model != NULL && model->getNumFunctionDefinitions() > 0)
+  {
+    expanded = math->deepCopy();
+    SBMLTransforms::replaceFD(expanded, model->getListOfFunctionDefinitions());
+    math = expanded;
+  }
+
+  mResultSlot = compileNode(math, constants);
+  delete expanded;
+
+  if (mFailed)
+  {
+    clear();
+    return LIBSBML_OPERATION_FAILED;
+  }
+
+  mCompiled = true;
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+bool
+BatchEvaluator::isCompiled() const
+{
+  return mCompiled;
+}
+
+
+unsigned int
+BatchEvaluator::getNumVariables() const
+{
+  return (unsigned int)mVariableIds.size();
+}
+
+
+const std::string&
+BatchEvaluator::getVariableId(unsigned int n) const
+{
+  static const std::string empty;
+  return (n < mVariableIds.size()) ? mVariableIds[n] : empty;
+}
+
+
+int
+BatchEvaluator::getVariableIndex(const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(id);
+  return (it == mVariableIndex.end()) ? -1 : (int)it->second;
+}
+
+
+unsigned int
+BatchEvaluator::getNumOperations() const
+{
+  return (unsigned int)mOperations.size();
+}
+
+
+void
+BatchEvaluator::clear()
+{
+  mVariableIds.clear();
+  mVariableIndex.clear();
+  mOperations.clear();
+  mConstantSlots.clear();
+  mConstantValues.clear();
+  mNumSlots = 0;
+  mResultSlot = 0;
+  mCompiled = false;
+  mFailed = false;
+}
+
+
+int
+BatchEvaluator::evaluate(const double* const* variables, double* results,
+                         unsigned int numLanes) const
+{
+  if (!mCompiled || results == NULL ||
+      (!mVariableIds.empty() && variables == NULL))
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  vector<double> scratch((size_t)mNumSlots * BLOCK_SIZE);
+  double* slots = &scratch[0];
+
+  // constants are the same in every block
+  for (size_t c = 0; c < mConstantSlots.size(); c++)
+  {
+    double* r = slots + (size_t)mConstantSlots[c] * BLOCK_SIZE;
+    for (unsigned int i = 0; i < BLOCK_SIZE; i++) r[i] = mConstantValues[c];
+  }
+
+  for (unsigned int start = 0; start < numLanes; start += BLOCK_SIZE)
+  {
+    unsigned int n = numLanes - start;
+    if (n > BLOCK_SIZE) n = BLOCK_SIZE;
+
+    for (size_t k = 0; k < mOperations.size(); k++)
+    {
+      const Operation& op = mOperations[k];
+      double* r = slots + (size_t)op.result * BLOCK_SIZE;
+      const double* a = slots + (size_t)op.first * BLOCK_SIZE;
+      const double* b = slots + (size_t)op.second * BLOCK_SIZE;
+      const double* c = slots + (size_t)op.third * BLOCK_SIZE;
+      unsigned int i;
+
+      switch (op.code)
+      {
+      case BATCH_LOAD:
+        a = variables[op.first] + start;
+        for (i = 0; i < n; i++) r[i] = a[i];
+        break;
+      case BATCH_NEGATE:
+        for (i = 0; i < n; i++) r[i] = -a[i];
+        break;
+      case BATCH_PLUS:
+        for (i = 0; i < n; i++) r[i] = a[i] + b[i];
+        break;
+      case BATCH_MINUS:
+        for (i = 0; i < n; i++) r[i] = a[i] - b[i];
+        break;
+      case BATCH_TIMES:
+        for (i = 0; i < n; i++) r[i] = a[i] * b[i];
+        break;
+      case BATCH_DIVIDE:
+        for (i = 0; i < n; i++) r[i] = a[i] / b[i];
+        break;
+      case BATCH_POWER:
+        for (i = 0; i < n; i++) r[i] = pow(a[i], b[i]);
+        break;
+      case BATCH_ROOT:
+        for (i = 0; i < n; i++) r[i] = pow(b[i], (1.0 / a[i]));
+        break;
+      case BATCH_ABS:
+        for (i = 0; i < n; i++) r[i] = fabs(a[i]);
+        break;
+      case BATCH_FLOOR:
+        for (i = 0; i < n; i++) r[i] = floor(a[i]);
+        break;
+      case BATCH_CEILING:
+        for (i = 0; i < n; i++) r[i] = ceil(a[i]);
+        break;
+      case BATCH_REM:
+        for (i = 0; i < n; i++) r[i] = a[i] - floor(a[i] / b[i]) * b[i];
+        break;
+      case BATCH_QUOTIENT:
+        for (i = 0; i < n; i++) r[i] = floor(a[i] / b[i]);
+        break;
+      case BATCH_MIN:
+        for (i = 0; i < n; i++) r[i] = (b[i] < a[i]) ? b[i] : a[i];
+        break;
+      case BATCH_MAX:
+        for (i = 0; i < n; i++) r[i] = (b[i] > a[i]) ? b[i] : a[i];
+        break;
+      case BATCH_EQ:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] == b[i]);
+        break;
+      case BATCH_NEQ:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] != b[i]);
+        break;
+      case BATCH_LT:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] < b[i]);
+        break;
+      case BATCH_LEQ:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] <= b[i]);
+        break;
+      case BATCH_GT:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] > b[i]);
+        break;
+      case BATCH_GEQ:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] >= b[i]);
+        break;
+      case BATCH_AND:
+        for (i = 0; i < n; i++) r[i] = (double)((a[i] != 0) & (b[i] != 0));
+        break;
+      case BATCH_OR:
+        for (i = 0; i < n; i++) r[i] = (double)((a[i] != 0) | (b[i] != 0));
+        break;
+      case BATCH_XOR:
+        for (i = 0; i < n; i++) r[i] = (double)((a[i] != 0) != (b[i] != 0));
+        break;
+      case BATCH_IMPLIES:
+        for (i = 0; i < n; i++) r[i] = (double)((a[i] == 0) | (b[i] != 0));
+        break;
+      case BATCH_NOT:
+        for (i = 0; i < n; i++) r[i] = (double)(a[i] == 0);
+        break;
+      case BATCH_PIECE_START:
+        // r holds the result, a (written here) whether a piece applied
+        for (i = 0; i < n; i++)
+        {
+          r[i] = numeric_limits<double>::quiet_NaN();
+          slots[(size_t)op.first * BLOCK_SIZE + i] = 0;
+        }
+        break;
+      case BATCH_PIECE:
+        // b is the value of the piece, c its condition; two pieces that
+        // apply with different values make the result undefined
+        for (i = 0; i < n; i++)
+        {
+          double* assigned = slots + (size_t)op.first * BLOCK_SIZE;
+          if (c[i] == 1.0)
+          {
+            r[i] = (assigned[i] == 0 || b[i] == r[i]) 
+                 ? b[i] : numeric_limits<double>::quiet_NaN();
+            assigned[i] = 1;
+          }
+        }
+        break;
+      case BATCH_PIECE_OTHERWISE:
+        for (i = 0; i < n; i++) r[i] = (a[i] == 0) ? b[i] : r[i];
+        break;
+      case BATCH_FUNCTION:
+        for (i = 0; i < n; i++) r[i] = op.function(a[i]);
+        break;
+      default:
+        break;
+      }
+    }
+
+    const double* r = slots + (size_t)mResultSlot * BLOCK_SIZE;
+    for (unsigned int i = 0; i < n; i++) results[start + i] = r[i];
+  }
+
+  return LIBSBML_OPERATION_SUCCESS;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+unsigned int
+BatchEvaluator::addOperation(int code, unsigned int first,
+                             unsigned int second, unsigned int third)
+{
+  Operation op;
+  op.code = code;
+  op.result = mNumSlots++;
+  op.first = first;
+  op.second = second;
+  op.third = third;
+  op.value = 0;
+  op.function = NULL;
+  mOperations.push_back(op);
+  return op.result;
+}
+
+
+unsigned int
+BatchEvaluator::addFunction(double (*function)(double), unsigned int argument)
+{
+  unsigned int slot = addOperation(BATCH_FUNCTION, argument);
+  mOperations.back().function = function;
+  return slot;
+}
+
+
+unsigned int
+BatchEvaluator::addConstant(double value)
+{
+  mConstantSlots.push_back(mNumSlots);
+  mConstantValues.push_back(value);
+  return mNumSlots++;
+}
+
+
+/*
+ * Compiles the n-th child of node; a missing child evaluates to NaN, as in
+ * SBMLTransforms::evaluateASTNode().
+ */
+unsigned int
+BatchEvaluator::compileChild(const ASTNode* node, unsigned int n,
+                             const std::map<std::string, double>* constants)
+{
+  if (n >= node->getNumChildren())
+  {
+    return addConstant(numeric_limits<double>::quiet_NaN());
+  }
+  return compileNode(node->getChild(n), constants);
+}
+
+
+/*
+ * Compiles an operator applied to the first two children of node.  The
+ * children are compiled in order, so that variables are numbered in the
+ * order in which they appear.
+ */
+unsigned int
+BatchEvaluator::compileBinary(const ASTNode* node, int code,
+                              const std::map<std::string, double>* constants)
+{
+  unsigned int first = compileChild(node, 0, constants);
+  unsigned int second = compileChild(node, 1, constants);
+  return addOperation(code, first, second);
+}
+
+
+/*
+ * Compiles an operator that combines its children from left to right,
+ * with the value for no children given by empty.
+ */
+unsigned int
+BatchEvaluator::compileFold(const ASTNode* node, int code, double empty,
+                            const std::map<std::string, double>* constants)
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren == 0)
+  {
+    return addConstant(empty);
+  }
+
+  unsigned int result = compileNode(node->getChild(0), constants);
+  for (unsigned int j = 1; j < numChildren; j++)
+  {
+    unsigned int next = compileNode(node->getChild(j), constants);
+    result = addOperation(code, result, next);
+  }
+  return result;
+}
+
+
+/*
+ * Compiles a relational operator, which holds if it holds for every pair
+ * of neighbouring children.
+ */
+unsigned int
+BatchEvaluator::compileRelational(const ASTNode* node, int code,
+                                  const std::map<std::string, double>* constants)
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren < 2)
+  {
+    return addConstant(0.0);
+  }
+
+  unsigned int left = compileNode(node->getChild(0), constants);
+  unsigned int result = 0;
+  for (unsigned int j = 1; j < numChildren; j++)
+  {
+    unsigned int right = compileNode(node->getChild(j), constants);
+    unsigned int holds = addOperation(code, left, right);
+    result = (j == 1) ? holds : addOperation(BATCH_TIMES, result, holds);
+    left = right;
+  }
+  return result;
+}
+
+
+unsigned int
+BatchEvaluator::compilePiecewise(const ASTNode* node,
+                                 const std::map<std::string, double>* constants)
+{
+  unsigned int numChildren = node->getNumChildren();
+  unsigned int numPieces = numChildren / 2;
+
+  // a slot recording whether a piece applied, set by BATCH_PIECE_START
+  unsigned int assigned = mNumSlots++;
+  unsigned int result = addOperation(BATCH_PIECE_START, assigned);
+
+  for (unsigned int j = 0; j < numPieces; j++)
+  {
+    unsigned int value = compileNode(node->getChild(2 * j), constants);
+    unsigned int condition = compileNode(node->getChild(2 * j + 1), constants);
+
+    Operation op;
+    op.code = BATCH_PIECE;
+    op.result = result;
+    op.first = assigned;
+    op.second = value;
+    op.third = condition;
+    op.value = 0;
+    op.function = NULL;
+    mOperations.push_back(op);
+  }
+
+  if (numChildren % 2 == 1)
+  {
+    unsigned int otherwise = 
+      compileNode(node->getChild(numChildren - 1), constants);
+
+    Operation op;
+    op.code = BATCH_PIECE_OTHERWISE;
+    op.result = result;
+    op.first = assigned;
+    op.second = otherwise;
+    op.third = 0;
+    op.value = 0;
+    op.function = NULL;
+    mOperations.push_back(op);
+  }
+
+  return result;
+}
+
+
+unsigned int
+BatchEvaluator::compileNode(const ASTNode* node,
+                            const std::map<std::string, double>* constants)
+{
+  const double NaN = numeric_limits<double>::quiet_NaN();
+  ASTNodeType_t type = node->getType();
+  unsigned int numChildren = node->getNumChildren();
+
+  switch (type)
+  {
+  case AST_INTEGER:
+    return addConstant((double)node->getInteger());
+
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+  case AST_NAME_AVOGADRO:
+    return addConstant(node->getReal());
+
+  case AST_NAME:
+    {
+      string name = (node->getName() != NULL) ? node->getName() : "";
+      if (constants != NULL)
+      {
+        map<string, double>::const_iterator it = constants->find(name);
+        if (it != constants->end())
+        {
+          return addConstant(it->second);
+        }
+      }
+
+      map<string, unsigned int>::iterator it = mVariableIndex.find(name);
+      unsigned int index;
+      if (it == mVariableIndex.end())
+      {
+        index = (unsigned int)mVariableIds.size();
+        mVariableIds.push_back(name);
+        mVariableIndex[name] = index;
+      }
+      else
+      {
+        index = it->second;
+      }
+      return addOperation(BATCH_LOAD, index);
+    }
+
+  case AST_NAME_TIME:
+    return addConstant(0.0);
+
+  case AST_CONSTANT_E:
+    return addConstant(exp(1.0));
+
+  case AST_CONSTANT_FALSE:
+    return addConstant(0.0);
+
+  case AST_CONSTANT_PI:
+    return addConstant(4.0*atan(1.0));
+
+  case AST_CONSTANT_TRUE:
+    return addConstant(1.0);
+
+  case AST_LAMBDA:
+  case AST_FUNCTION:
+  case AST_FUNCTION_DELAY:
+  case AST_FUNCTION_RATE_OF:
+    return addConstant(NaN);
+
+  case AST_PLUS:
+    return compileFold(node, BATCH_PLUS, 0.0, constants);
+
+  case AST_TIMES:
+    return compileFold(node, BATCH_TIMES, 1.0, constants);
+
+  case AST_MINUS:
+    if (numChildren == 1)
+    {
+      return addOperation(BATCH_NEGATE, compileChild(node, 0, constants));
+    }
+    return compileBinary(node, BATCH_MINUS, constants);
+
+  case AST_DIVIDE:
+    return compileBinary(node, BATCH_DIVIDE, constants);
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    return compileBinary(node, BATCH_POWER, constants);
+
+  case AST_FUNCTION_ROOT:
+    return compileBinary(node, BATCH_ROOT, constants);
+
+  case AST_FUNCTION_LOG:
+    // the base is not used, as in SBMLTransforms::evaluateASTNode()
+    return addFunction(log10_, compileChild(node, 1, constants));
+
+  case AST_FUNCTION_ABS:
+    return addOperation(BATCH_ABS, compileChild(node, 0, constants));
+
+  case AST_FUNCTION_FLOOR:
+    return addOperation(BATCH_FLOOR, compileChild(node, 0, constants));
+
+  case AST_FUNCTION_CEILING:
+    return addOperation(BATCH_CEILING, compileChild(node, 0, constants));
+
+  case AST_FUNCTION_PIECEWISE:
+    return compilePiecewise(node, constants);
+
+  case AST_FUNCTION_MAX:
+    return compileFold(node, BATCH_MAX, NaN, constants);
+
+  case AST_FUNCTION_MIN:
+    return compileFold(node, BATCH_MIN, NaN, constants);
+
+  case AST_FUNCTION_REM:
+  case AST_FUNCTION_QUOTIENT:
+    if (numChildren < 2)
+    {
+      return addConstant(0.0);
+    }
+    return compileBinary(node, 
+                         type == AST_FUNCTION_REM ? BATCH_REM : BATCH_QUOTIENT,
+                         constants);
+
+  case AST_LOGICAL_AND:
+  case AST_LOGICAL_OR:
+  case AST_LOGICAL_XOR:
+  case AST_LOGICAL_IMPLIES:
+    if (numChildren == 0)
+    {
+      return addConstant(type == AST_LOGICAL_AND ? 1.0 : 0.0);
+    }
+    else if (numChildren == 1)
+    {
+      return compileChild(node, 0, constants);
+    }
+    else
+    {
+      // only the first two children are used, as in 
+      // SBMLTransforms::evaluateASTNode()
+      int code = (type == AST_LOGICAL_AND) ? BATCH_AND
+               : (type == AST_LOGICAL_OR)  ? BATCH_OR
+               : (type == AST_LOGICAL_XOR) ? BATCH_XOR : BATCH_IMPLIES;
+      return compileBinary(node, code, constants);
+    }
+
+  case AST_LOGICAL_NOT:
+    return addOperation(BATCH_NOT, compileChild(node, 0, constants));
+
+  case AST_RELATIONAL_EQ:
+    return compileRelational(node, BATCH_EQ, constants);
+
+  case AST_RELATIONAL_NEQ:
+    return compileRelational(node, BATCH_NEQ, constants);
+
+  case AST_RELATIONAL_LT:
+    return compileRelational(node, BATCH_LT, constants);
+
+  case AST_RELATIONAL_LEQ:
+    return compileRelational(node, BATCH_LEQ, constants);
+
+  case AST_RELATIONAL_GT:
+    return compileRelational(node, BATCH_GT, constants);
+
+  case AST_RELATIONAL_GEQ:
+    return compileRelational(node, BATCH_GEQ, constants);
+
+  default:
+    {
+      double (*function)(double) = getFunction(type);
+      if (function != NULL)
+      {
+        return addFunction(function, compileChild(node, 0, constants));
+      }
+
+      // node types of other packages
+      mFailed = true;
+      return addConstant(NaN);
+    }
+  }
+}
+
+/** @endcond */
+
+
+LIBSBML_CPP_NAMESPACE_END
@@ -0,0 +1,255 @@
+/**
+ * @file    BatchEvaluator.h
+ * @brief   Evaluates a formula for many sets of values at once.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class BatchEvaluator
+ * @sbmlbrief{core} Evaluates a formula for many sets of values at once.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * SBMLTransforms::evaluateASTNode() walks a formula and looks up every
+ * identifier each time it is called, which dominates the cost when the same
+ * rate law has to be evaluated for thousands of parameter sets.  A
+ * BatchEvaluator translates a formula once into a flat list of operations
+ * and then evaluates it for a whole block of values ("lanes") at a time.
+ *
+ * The values are passed in structure-of-arrays form: one array per
+ * variable, holding the value of that variable in every lane.  Each
+ * operation is applied to all lanes of a block in a simple loop over
+ * contiguous arrays, which the compiler can turn into SIMD instructions for
+ * whatever instruction set libSBML is built for (SSE2, AVX2, AVX-512);
+ * operations calling the C math library run lane by lane.  Both branches
+ * of a @c piecewise are computed for every lane and the result is
+ * selected afterwards, so there is no branching between lanes.
+ *
+ * The results are the same as those of SBMLTransforms::evaluateASTNode()
+ * for every node type of SBML Level&nbsp;3 Version&nbsp;1 core.  The
+ * operators of the L3V2 extended math (@c max, @c min, @c rem, @c quotient
+ * and @c implies) are evaluated with the same formulas, using the values
+ * of the variables in each lane.  As there, the csymbol @c time evaluates to @c 0, and
+ * @c delay, @c rateOf and calls of undefined functions evaluate to NaN.
+ * Node types added by other packages are not supported.
+ *
+ * Every identifier in the formula becomes a variable, unless a value for
+ * it is given when the formula is compiled; such values are the same for
+ * all lanes and are folded into the compiled formula.
+ */
+
+#ifndef BatchEvaluator_h
+#define BatchEvaluator_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/sbmlfwd.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN BatchEvaluator
+{
+public:
+
+  /**
+   * Creates a new BatchEvaluator without a formula.
+   */
+  BatchEvaluator();
+
+
+  /**
+   * Destroys this BatchEvaluator.
+   */
+  ~BatchEvaluator();
+
+
+  /**
+   * Compiles a formula, replacing any formula compiled before.
+   *
+   * @param math the formula to compile.
+   * @param model an optional Model whose function definitions are expanded
+   * in @p math before it is compiled.
+   * @param constants optional values for identifiers that are the same in
+   * all lanes; the identifiers not listed here become variables.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}, if
+   * @p math is @c NULL.
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t},
+   * if @p math contains a node type that cannot be evaluated; this
+   * BatchEvaluator is then left without a formula.
+   */
+  int compile(const ASTNode* math, const Model* model = NULL,
+              const std::map<std::string, double>* constants = NULL);
+
+
+  /**
+   * Returns @c true if a formula has been compiled successfully.
+   *
+   * @return whether evaluate() can be used.
+   */
+  bool isCompiled() const;
+
+
+  /**
+   * Returns the number of variables of the compiled formula.
+   *
+   * @return the number of arrays evaluate() expects.
+   */
+  unsigned int getNumVariables() const;
+
+
+  /**
+   * Returns the identifier of a variable.
+   *
+   * @param n the index of the variable.
+   *
+   * @return the identifier, or an empty string if @p n is out of range.
+   */
+  const std::string& getVariableId(unsigned int n) const;
+
+
+  /**
+   * Returns the index of a variable.
+   *
+   * @param id the identifier of the variable.
+   *
+   * @return the index of the variable, or @c -1 if @p id is not a variable
+   * of the compiled formula.
+   */
+  int getVariableIndex(const std::string& id) const;
+
+
+  /**
+   * Returns the number of operations the formula was compiled into.
+   *
+   * @return the length of the compiled program.
+   */
+  unsigned int getNumOperations() const;
+
+
+  /**
+   * Evaluates the compiled formula for a number of lanes.
+   *
+   * This method does not modify the BatchEvaluator, so several threads may
+   * evaluate the same formula at the same time.
+   *
+   * @param variables an array of getNumVariables() pointers; the n-th
+   * points to @p numLanes values of the variable with index n.
+   * @param results an array receiving the @p numLanes results.
+   * @param numLanes the number of lanes to evaluate.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}, if
+   * no formula is compiled or @p results (or @p variables, when the
+   * formula has variables) is @c NULL.
+   */
+  int evaluate(const double* const* variables, double* results,
+               unsigned int numLanes) const;
+
+
+  /**
+   * Removes the compiled formula.
+   */
+  void clear();
+
+
+  /** @cond doxygenLibsbmlInternal */
+
+  struct Operation
+  {
+    int code;
+    unsigned int result;
+    unsigned int first;
+    unsigned int second;
+    unsigned int third;
+    double value;
+    double (*function)(double);
+  };
+
+protected:
+
+  unsigned int addOperation(int code, unsigned int first = 0,
+                            unsigned int second = 0, unsigned int third = 0);
+  unsigned int addFunction(double (*function)(double), unsigned int argument);
+  unsigned int addConstant(double value);
+  unsigned int compileNode(const ASTNode* node,
+                           const std::map<std::string, double>* constants);
+  unsigned int compileChild(const ASTNode* node, unsigned int n,
+                            const std::map<std::string, double>* constants);
+  unsigned int compileBinary(const ASTNode* node, int code,
+                             const std::map<std::string, double>* constants);
+  unsigned int compileFold(const ASTNode* node, int code, double empty,
+                           const std::map<std::string, double>* constants);
+  unsigned int compileRelational(const ASTNode* node, int code,
+                                 const std::map<std::string, double>* constants);
+  unsigned int compilePiecewise(const ASTNode* node,
+                                const std::map<std::string, double>* constants);
+
+  std::vector<std::string> mVariableIds;
+  std::map<std::string, unsigned int> mVariableIndex;
+
+  std::vector<Operation> mOperations;
+  std::vector<unsigned int> mConstantSlots;
+  std::vector<double> mConstantValues;
+  unsigned int mNumSlots;
+  unsigned int mResultSlot;
+  bool mCompiled;
+  bool mFailed;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+  BatchEvaluator(const BatchEvaluator&);
+  BatchEvaluator& operator=(const BatchEvaluator&);
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* BatchEvaluator_h */
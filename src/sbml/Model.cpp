@@ -48,6 +48,7 @@
 #include <sbml/math/ASTNode.h>
 
 #include <sbml/SBMLDocument.h>
+#include <sbml/SBMLTransforms.h>
 #include <sbml/SBO.h>
 #include <sbml/SBMLVisitor.h>
 #include <sbml/SBMLError.h>
@@ -104,6 +105,8 @@ Model::Model (unsigned int level, unsigned int version) :
  , mIdList (  )
  , mMetaidList ( )
  , mUnitsDataMap ()
+ , mUnitsEnvironmentSignature ()
+ , mReusableUnitsData ( NULL )
 {
   if (!hasValidLevelVersionNamespaceCombination())
     throw SBMLConstructorException();
@@ -137,6 +140,8 @@ Model::Model (SBMLNamespaces * sbmlns) :
  , mIdList (  )
  , mMetaidList ( )
  , mUnitsDataMap ()
+ , mUnitsEnvironmentSignature ()
+ , mReusableUnitsData ( NULL )
 {
   if (!hasValidLevelVersionNamespaceCombination())
   {
@@ -197,6 +202,8 @@ Model::Model(const Model& orig)
   , mIdList              (orig.mIdList)
   , mMetaidList          (orig.mMetaidList)
   , mUnitsDataMap        ()
+  , mUnitsEnvironmentSignature (orig.mUnitsEnvironmentSignature)
+  , mReusableUnitsData   (NULL)
 {
 
   if (orig.mFormulaUnitsData != NULL)
@@ -284,6 +291,7 @@ Model& Model::operator=(const Model& rhs)
 
   mIdList     = rhs.mIdList;
   mMetaidList = rhs.mMetaidList;
+  mUnitsEnvironmentSignature = rhs.mUnitsEnvironmentSignature;
 
   connectToChild();
 
@@ -5406,6 +5414,112 @@ void Model::populatePerTimeUnitDefinition(FormulaUnitsData *fud)
 }
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Helpers building the signatures used to decide whether previously
+ * computed units data can be reused.  A signature is a byte string holding
+ * all the inputs, so that signatures are compared exactly rather than
+ * through a hash.
+ */
+static void
+addBytesToSignature(std::string& signature, const void* data, size_t length)
+{
+  signature.append(static_cast<const char*>(data), length);
+}
+
+
+static void
+addStringToSignature(std::string& signature, const std::string& s)
+{
+  size_t length = s.size();
+  addBytesToSignature(signature, &length, sizeof(length));
+  signature.append(s);
+}
+
+
+static void
+addDoubleToSignature(std::string& signature, double value)
+{
+  addBytesToSignature(signature, &value, sizeof(value));
+}
+
+
+/*
+ * Adds what ASTNode::exactlyEqual() compares, so that two maths have the
+ * same signature exactly when they are identical.
+ */
+static void
+addMathToSignature(std::string& signature, const ASTNode* math)
+{
+  bool isSet = (math != NULL);
+  addBytesToSignature(signature, &isSet, sizeof(isSet));
+  if (math == NULL)
+  {
+    return;
+  }
+
+  int type = math->getType();
+  bool isBvar = math->isBvar();
+  long values[3] = { math->getNumerator(), math->getDenominator(),
+                     math->getExponent() };
+  addBytesToSignature(signature, &type, sizeof(type));
+  addBytesToSignature(signature, &isBvar, sizeof(isBvar));
+  addStringToSignature(signature,
+                       (math->getName() != NULL) ? math->getName() : "");
+  addBytesToSignature(signature, values, sizeof(values));
+  addDoubleToSignature(signature, math->getMantissa());
+  addStringToSignature(signature, math->getUnits());
+  addStringToSignature(signature, math->getDefinitionURLString());
+  addStringToSignature(signature, math->getId());
+  addStringToSignature(signature, math->getClass());
+  addStringToSignature(signature, math->getStyle());
+
+  unsigned int numChildren = math->getNumChildren();
+  addBytesToSignature(signature, &numChildren, sizeof(numChildren));
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    addMathToSignature(signature, math->getChild(i));
+  }
+}
+
+
+static void
+addUnitDefinitionToSignature(std::string& signature,
+                             const UnitDefinition* ud)
+{
+  unsigned int numUnits = (ud != NULL) ? ud->getNumUnits() : 0;
+  bool isSet = (ud != NULL);
+  addBytesToSignature(signature, &isSet, sizeof(isSet));
+  addBytesToSignature(signature, &numUnits, sizeof(numUnits));
+
+  for (unsigned int n = 0; n < numUnits; ++n)
+  {
+    const Unit* u = ud->getUnit(n);
+    int kind = u->getKind();
+    int scale = u->getScale();
+    addBytesToSignature(signature, &kind, sizeof(kind));
+    addBytesToSignature(signature, &scale, sizeof(scale));
+    addDoubleToSignature(signature, u->getExponentAsDouble());
+    addDoubleToSignature(signature, u->getMultiplier());
+    addDoubleToSignature(signature, u->getOffset());
+  }
+}
+
+
+/*
+ * Returns the signature of the given math on its own; it is never empty,
+ * as an empty signature marks data not derived from math.
+ */
+static std::string
+getMathSignature(const ASTNode* math)
+{
+  std::string signature;
+  addMathToSignature(signature, math);
+  return signature;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 void Model::createSpeciesReferenceUnitsData(SpeciesReference* sr,
                                   UnitFormulaFormatter* unitFormatter)
@@ -5414,11 +5528,19 @@ void Model::createSpeciesReferenceUnitsData(SpeciesReference* sr,
   
   if (sr->isSetStoichiometryMath())
   {
-    fud = createFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH);
     sr->getStoichiometryMath()->setInternalId(sr->getSpecies());
-    
-    createUnitsDataFromMath(unitFormatter, fud, 
-                            sr->getStoichiometryMath()->getMath());
+
+    const ASTNode* math = sr->getStoichiometryMath()->getMath();
+    std::string signature = getMathSignature(math);
+    if (reuseFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH,
+                              signature))
+    {
+      return;
+    }
+
+    fud = createFormulaUnitsData(sr->getSpecies(), SBML_STOICHIOMETRY_MATH);
+    fud->setInputSignature(signature);
+    createUnitsDataFromMath(unitFormatter, fud, math);
   }
   else if (sr->getLevel() > 2 && sr->isSetId())
   {
@@ -5456,7 +5578,12 @@ void Model::createSpeciesReferenceUnitsData(SpeciesReference* sr,
 void
 Model::populateListFormulaUnitsData()
 {
-  removeListFormulaUnitsData();
+  /* detach the previous list; the units data computed from math can be
+   * reused if neither the math nor anything it may refer to has changed
+   */
+  List* previous = mFormulaUnitsData;
+  mFormulaUnitsData = NULL;
+  mUnitsDataMap.clear();
 
   UnitFormulaFormatter *unitFormatter = new UnitFormulaFormatter(this);
 
@@ -5478,6 +5605,36 @@ Model::populateListFormulaUnitsData()
     createL3SpeciesUnitsData();
   }
 
+  /* the variables are cheap to recreate and tell us whether the
+   * environment the math is evaluated in has changed
+   */
+  std::string environment = getUnitsEnvironmentSignature();
+  UnitsValueMultiMap reusable;
+
+  if (previous != NULL)
+  {
+    bool sameEnvironment = (environment == mUnitsEnvironmentSignature);
+    unsigned int size = previous->getSize();
+    while (size--)
+    {
+      FormulaUnitsData* fud =
+                  static_cast<FormulaUnitsData*>(previous->remove(0));
+      if (sameEnvironment && !fud->getInputSignature().empty())
+      {
+        KeyValue key(fud->getUnitReferenceId(), fud->getComponentTypecode());
+        reusable.insert(make_pair(key, fud));
+      }
+      else
+      {
+        delete fud;
+      }
+    }
+    delete previous;
+  }
+
+  mUnitsEnvironmentSignature = environment;
+  mReusableUnitsData = &reusable;
+
   /* create the units data from math elements */
 
   // pass the unitFormatter as this will save data
@@ -5489,11 +5646,150 @@ Model::populateListFormulaUnitsData()
   createReactionUnitsData(unitFormatter);
   createEventUnitsData(unitFormatter);
 
+  mReusableUnitsData = NULL;
+  for (UnitsValueMultiMap::iterator it = reusable.begin();
+       it != reusable.end(); ++it)
+  {
+    delete it->second;
+  }
+
   delete unitFormatter;
 }
 /** @endcond */
 
 
+/** @cond doxygenLibsbmlInternal */
+std::string
+Model::getUnitsEnvironmentSignature()
+{
+  std::string signature;
+  unsigned int n, j;
+
+  unsigned int level = getLevel();
+  unsigned int version = getVersion();
+  addBytesToSignature(signature, &level, sizeof(level));
+  addBytesToSignature(signature, &version, sizeof(version));
+
+  addStringToSignature(signature, getSubstanceUnits());
+  addStringToSignature(signature, getTimeUnits());
+  addStringToSignature(signature, getVolumeUnits());
+  addStringToSignature(signature, getAreaUnits());
+  addStringToSignature(signature, getLengthUnits());
+  addStringToSignature(signature, getExtentUnits());
+  addStringToSignature(signature, getConversionFactor());
+
+  for (n = 0; n < getNumUnitDefinitions(); n++)
+  {
+    addStringToSignature(signature, getUnitDefinition(n)->getId());
+    addUnitDefinitionToSignature(signature, getUnitDefinition(n));
+  }
+
+  for (n = 0; n < getNumFunctionDefinitions(); n++)
+  {
+    const FunctionDefinition* fd = getFunctionDefinition(n);
+    addStringToSignature(signature, fd->getId());
+    addMathToSignature(signature, fd->isSetMath() ? fd->getMath() : NULL);
+  }
+
+  /* the units of the model and its variables as computed so far */
+  for (UnitsValueIter it = mUnitsDataMap.begin(); it != mUnitsDataMap.end();
+       ++it)
+  {
+    const FormulaUnitsData* fud = it->second;
+    int typecode = fud->getComponentTypecode();
+    bool flags[3] = { fud->getContainsUndeclaredUnits(),
+                      fud->getCanIgnoreUndeclaredUnits(),
+                      fud->getContainsInconsistency() };
+    addStringToSignature(signature, fud->getUnitReferenceId());
+    addBytesToSignature(signature, &typecode, sizeof(typecode));
+    addBytesToSignature(signature, flags, sizeof(flags));
+    addUnitDefinitionToSignature(signature, fud->getUnitDefinition());
+    addUnitDefinitionToSignature(signature, fud->getPerTimeUnitDefinition());
+    addUnitDefinitionToSignature(signature,
+                                 fud->getEventTimeUnitDefinition());
+    addUnitDefinitionToSignature(signature,
+                                 fud->getSpeciesExtentUnitDefinition());
+    addUnitDefinitionToSignature(signature,
+                                 fud->getSpeciesSubstanceUnitDefinition());
+  }
+
+  for (n = 0; n < getNumSpecies(); n++)
+  {
+    addStringToSignature(signature, getSpecies(n)->getConversionFactor());
+  }
+
+  /* reactions and species references may be referred to by id */
+  for (n = 0; n < getNumReactions(); n++)
+  {
+    const Reaction* r = getReaction(n);
+    addStringToSignature(signature, r->getId());
+    for (j = 0; j < r->getNumReactants(); j++)
+    {
+      addStringToSignature(signature, r->getReactant(j)->getId());
+      addStringToSignature(signature, r->getReactant(j)->getSpecies());
+    }
+    for (j = 0; j < r->getNumProducts(); j++)
+    {
+      addStringToSignature(signature, r->getProduct(j)->getId());
+      addStringToSignature(signature, r->getProduct(j)->getSpecies());
+    }
+  }
+
+  /* the values the unitFormatter uses for exponents and root degrees */
+  SBMLTransforms::IdValueMap values;
+  SBMLTransforms::getComponentValuesForModel(this, values);
+  for (SBMLTransforms::IdValueIter it = values.begin(); it != values.end();
+       ++it)
+  {
+    bool isSet = it->second.second;
+    addStringToSignature(signature, it->first);
+    addDoubleToSignature(signature, it->second.first);
+    addBytesToSignature(signature, &isSet, sizeof(isSet));
+  }
+
+  return signature;
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+bool
+Model::reuseFormulaUnitsData(const std::string& id, int typecode,
+                             const std::string& signature)
+{
+  if (mReusableUnitsData == NULL)
+  {
+    return false;
+  }
+
+  KeyValue key(id, typecode);
+  std::pair<UnitsValueMultiMap::iterator, UnitsValueMultiMap::iterator>
+                            range = mReusableUnitsData->equal_range(key);
+
+  for (UnitsValueMultiMap::iterator it = range.first; it != range.second;
+       ++it)
+  {
+    FormulaUnitsData* fud = it->second;
+    if (fud->getInputSignature() != signature)
+    {
+      continue;
+    }
+
+    mReusableUnitsData->erase(it);
+    if (mFormulaUnitsData == NULL)
+    {
+      mFormulaUnitsData = new List();
+    }
+    mFormulaUnitsData->add(fud);
+    mUnitsDataMap.insert(make_pair(key, fud));
+    return true;
+  }
+
+  return false;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 void
 Model::removeListFormulaUnitsData()
@@ -6426,7 +6722,15 @@ Model::createInitialAssignmentUnitsData(UnitFormulaFormatter * unitFormatter)
   for (unsigned int n=0; n < getNumInitialAssignments(); n++)
   {
     InitialAssignment* ia = getInitialAssignment(n);
+    std::string signature = getMathSignature(ia->getMath());
+    if (reuseFormulaUnitsData(ia->getSymbol(), SBML_INITIAL_ASSIGNMENT,
+                              signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(ia->getSymbol(), SBML_INITIAL_ASSIGNMENT);
+    fud->setInputSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, ia->getMath());
   }
 }
@@ -6448,7 +6752,14 @@ Model::createConstraintUnitsData(UnitFormulaFormatter * unitFormatter)
     newID.assign(newId);
     c->setInternalId(newID);
 
+    std::string signature = getMathSignature(c->getMath());
+    if (reuseFormulaUnitsData(newID, SBML_CONSTRAINT, signature))
+    {
+      continue;
+    }
+
     fud = createFormulaUnitsData(newID, SBML_CONSTRAINT);
+    fud->setInputSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, c->getMath());
   }
 }
@@ -6475,13 +6786,20 @@ Model::createRuleUnitsData(UnitFormulaFormatter * unitFormatter)
       r->setInternalId(newID);
       static_cast <AlgebraicRule *> (r)->setInternalIdOnly();
       countAlg++;
-
-      fud = createFormulaUnitsData(newID, r->getTypeCode());
     }
     else
     {
-      fud = createFormulaUnitsData(r->getVariable(), r->getTypeCode());
+      newID = r->getVariable();
     }
+
+    std::string signature = getMathSignature(r->getMath());
+    if (reuseFormulaUnitsData(newID, r->getTypeCode(), signature))
+    {
+      continue;
+    }
+
+    fud = createFormulaUnitsData(newID, r->getTypeCode());
+    fud->setInputSignature(signature);
     createUnitsDataFromMath(unitFormatter, fud, r->getMath());
   }
 }
@@ -6492,7 +6810,6 @@ Model::createRuleUnitsData(UnitFormulaFormatter * unitFormatter)
 void
 Model::createReactionUnitsData(UnitFormulaFormatter * unitFormatter)
 {
-  UnitDefinition *ud = NULL;
   FormulaUnitsData *fud = NULL;
   
   for (unsigned int n=0; n < getNumReactions(); n++)
@@ -6502,7 +6819,7 @@ Model::createReactionUnitsData(UnitFormulaFormatter * unitFormatter)
     /* get units returned by kineticLaw formula */
     if (react->isSetKineticLaw())
     {
-      fud = createFormulaUnitsData(react->getId(), SBML_KINETIC_LAW);
+      KineticLaw* kl = react->getKineticLaw();
 
       /* set the id of the kinetic law 
        * normally a kinetic law doesnt have an id
@@ -6510,24 +6827,44 @@ Model::createReactionUnitsData(UnitFormulaFormatter * unitFormatter)
        * so we set it to be the reaction id so 
        * that searching the listFormulaUnitsData can find it
        */
-      react->getKineticLaw()->setInternalId(react->getId());
+      kl->setInternalId(react->getId());
 
-      // have to use the old way for now as unitFormatter needs to know
-      // if we are in a reaction so it can access localParameters
-      unitFormatter->resetFlags();
-      if(react->getKineticLaw()->isSetMath())
+      /* the units also depend on the local parameters, which the
+       * unitFormatter finds through the index of the reaction
+       */
+      std::string signature;
+      addMathToSignature(signature, kl->isSetMath() ? kl->getMath() : NULL);
+      addBytesToSignature(signature, &n, sizeof(n));
+      for (unsigned int j = 0; j < kl->getNumParameters(); j++)
       {
-        ud = unitFormatter->getUnitDefinition
-                                  (react->getKineticLaw()->getMath(), true, (int)n);
-        fud->setContainsParametersWithUndeclaredUnits
+        addStringToSignature(signature, kl->getParameter(j)->getId());
+        addStringToSignature(signature, kl->getParameter(j)->getUnits());
+        addDoubleToSignature(signature, kl->getParameter(j)->getValue());
+      }
+
+      if (!reuseFormulaUnitsData(react->getId(), SBML_KINETIC_LAW,
+                                 signature))
+      {
+        UnitDefinition *ud = NULL;
+        fud = createFormulaUnitsData(react->getId(), SBML_KINETIC_LAW);
+        fud->setInputSignature(signature);
+
+        // have to use the old way for now as unitFormatter needs to know
+        // if we are in a reaction so it can access localParameters
+        unitFormatter->resetFlags();
+        if(kl->isSetMath())
+        {
+          ud = unitFormatter->getUnitDefinition(kl->getMath(), true, (int)n);
+          fud->setContainsParametersWithUndeclaredUnits
                                  (unitFormatter->getContainsUndeclaredUnits());
-        fud->setCanIgnoreUndeclaredUnits
+          fud->setCanIgnoreUndeclaredUnits
                                    (unitFormatter->canIgnoreUndeclaredUnits());
-      }
+        }
 
-      fud->setUnitDefinition(ud);
+        fud->setUnitDefinition(ud);
+      }
 
-      createLocalParameterUnitsData(react->getKineticLaw(), unitFormatter);
+      createLocalParameterUnitsData(kl, unitFormatter);
     }
 
     ///* get units returned by any stoichiometryMath set */
@@ -6690,11 +7027,23 @@ Model::createDelayUnitsData(UnitFormulaFormatter* unitFormatter, Event * e,
                             const std::string& eventId)
 {
   UnitDefinition *ud = NULL;
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_EVENT);
 
   Delay * d = e->getDelay();
   d->setInternalId(eventId);
 
+  /* the event time units come from the event or the model */
+  std::string signature;
+  addMathToSignature(signature, d->getMath());
+  addStringToSignature(signature, e->getTimeUnits());
+
+  if (reuseFormulaUnitsData(eventId, SBML_EVENT, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_EVENT);
+  fud->setInputSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, d->getMath());
 
   /* get event time definition */
@@ -6715,11 +7064,18 @@ void
 Model::createTriggerUnitsData(UnitFormulaFormatter* unitFormatter, Event * e,
   const std::string& eventId)
 {
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_TRIGGER);
-
   Trigger * d = e->getTrigger();
   d->setInternalId(eventId);
 
+  std::string signature = getMathSignature(d->getMath());
+  if (reuseFormulaUnitsData(eventId, SBML_TRIGGER, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_TRIGGER);
+  fud->setInputSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, d->getMath());
 
   fud->setEventTimeUnitDefinition(NULL);
@@ -6732,10 +7088,17 @@ void
 Model::createPriorityUnitsData(UnitFormulaFormatter* unitFormatter, 
                                Priority * p, const std::string& eventId)
 {
-  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_PRIORITY);
-
   p->setInternalId(eventId);
 
+  std::string signature = getMathSignature(p->getMath());
+  if (reuseFormulaUnitsData(eventId, SBML_PRIORITY, signature))
+  {
+    return;
+  }
+
+  FormulaUnitsData *fud = createFormulaUnitsData(eventId, SBML_PRIORITY);
+  fud->setInputSignature(signature);
+
   createUnitsDataFromMath(unitFormatter, fud, p->getMath());
 }
 /** @endcond */
@@ -6747,7 +7110,15 @@ Model::createEventAssignmentUnitsData(UnitFormulaFormatter* unitFormatter,
                             EventAssignment * ea, const std::string& eventId)
 {
   std::string eaId = ea->getVariable() + eventId;
+
+  std::string signature = getMathSignature(ea->getMath());
+  if (reuseFormulaUnitsData(eaId, SBML_EVENT_ASSIGNMENT, signature))
+  {
+    return;
+  }
+
   FormulaUnitsData *fud = createFormulaUnitsData(eaId, SBML_EVENT_ASSIGNMENT);
+  fud->setInputSignature(signature);
 
   createUnitsDataFromMath(unitFormatter, fud, ea->getMath());
 }
@@ -487,6 +487,7 @@ class LIBSBML_EXTERN Model : public SBase
   typedef std::pair<const std::string, int>   KeyValue;
   typedef std::map<KeyValue, FormulaUnitsData*> UnitsValueMap;
   typedef UnitsValueMap::const_iterator                  UnitsValueIter;
+  typedef std::multimap<KeyValue, FormulaUnitsData*> UnitsValueMultiMap;
 #endif
   friend class SBMLDocument; //So that SBMLDocument can change the element namespace if it needs to.
 public:
@@ -3458,6 +3459,11 @@ public:
    * inferred units without invoking full-blown model validation; this is a
    * scenario in which calling populateListFormulaUnitsData() may be useful.
    *
+   * When the list has been populated before, the data for each piece of
+   * math is only recomputed if the math, or the unit declarations and
+   * identifiers it may refer to, have changed since; otherwise the
+   * previously computed data is kept.
+   *
    * @warning Computing and inferring units is a time-consuming operation.
    * Callers may want to call isPopulatedListFormulaUnitsData() to determine
    * whether the units may already have been computed, to save themselves the
@@ -4213,6 +4219,14 @@ protected:
   IdList                     mMetaidList;
   UnitsValueMap              mUnitsDataMap;
 
+  /* signature of the unit declarations, identifiers and values the
+   * current mFormulaUnitsData was computed against; while the list is being
+   * repopulated, mReusableUnitsData holds the entries of the previous
+   * list that may be reused
+   */
+  std::string                mUnitsEnvironmentSignature;
+  UnitsValueMultiMap *       mReusableUnitsData;
+
 
   /* the validator classes need to be friends to access the 
    * protected constructor that takes no arguments
@@ -4254,6 +4268,20 @@ protected:
    */
   void removeListFormulaUnitsData();
 
+  /*
+   * Returns a signature of everything besides the math itself that the
+   * units of math in this Model can depend on.  Expects the model wide
+   * and variable units data to have been created.
+   */
+  std::string getUnitsEnvironmentSignature();
+
+  /*
+   * Moves the data of the previous population with the given key and
+   * input signature back into the list; returns false if there is none.
+   */
+  bool reuseFormulaUnitsData(const std::string& id, int typecode,
+                             const std::string& signature);
+
   
   /*
    * creates the substance units data item
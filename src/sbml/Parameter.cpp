@@ -541,6 +541,26 @@ Parameter::getDerivedUnitDefinition()
    */
   this->setCalculatingUnits(false);
 
+  return deriveUnitDefinition(calculate);
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Infers the units of this Parameter from the math of its model, without
+ * using the calculating-units flag; used by the units converter, which
+ * infers the units of several parameters at once.
+ */
+UnitDefinition *
+Parameter::inferUnitDefinition()
+{
+  return deriveUnitDefinition(true);
+}
+
+
+UnitDefinition *
+Parameter::deriveUnitDefinition(bool calculate)
+{
   UnitDefinition * derivedUD = NULL;
   /* if we have the whole model but it is not in a document
    * it is still possible to determine the units
@@ -624,6 +644,7 @@ Parameter::getDerivedUnitDefinition()
 
   return derivedUD;
 }
+/** @endcond */
 
 
 /*
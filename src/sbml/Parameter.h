@@ -712,6 +712,10 @@ public:
   /* set a flag to indicate that a parameter should 
    * calculate its units from math */
   virtual void setCalculatingUnits(bool calculatingUnits);
+
+  /* calculates the units of this parameter from math without setting
+   * the flag, so that several parameters can be inferred at once */
+  UnitDefinition * inferUnitDefinition();
   
   /** @endcond */
 
@@ -1030,6 +1034,8 @@ private:
   
   /** @cond doxygenLibsbmlInternal */
   
+  UnitDefinition * deriveUnitDefinition(bool calculate);
+
   UnitDefinition * inferUnits(Model* m, bool globalParameter);
 
   UnitDefinition * inferUnitsFromAssignments(UnitFormulaFormatter *uff, 
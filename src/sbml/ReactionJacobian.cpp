@@ -0,0 +1,463 @@
+/**
+ * @file    ReactionJacobian.cpp
+ * @brief   Symbolic partial derivatives of the reaction rates of a Model.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <sbml/ReactionJacobian.h>
+#include <sbml/Model.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/util/ParallelTask.h>
+
+#include <algorithm>
+#include <set>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+static void
+collectNames (const ASTNode* node, set<string>& names)
+{
+  if ((node->getType() == AST_NAME || node->getType() == AST_NAME_TIME) &&
+      node->getName() != NULL)
+  {
+    names.insert(node->getName());
+  }
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    collectNames(node->getChild(i), names);
+  }
+}
+
+
+/*
+ * Replaces the children of node that name a variable set by an assignment
+ * rule by a copy of the rule's formula.
+ *
+ * @return true if anything was replaced.
+ */
+static bool
+substitute (ASTNode* node, const map<string, const ASTNode*>& formulas,
+            const set<string>& hidden)
+{
+  bool replaced = false;
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    ASTNode* child = node->getChild(i);
+    if (child->getType() == AST_NAME && child->getName() != NULL &&
+        hidden.find(child->getName()) == hidden.end())
+    {
+      map<string, const ASTNode*>::const_iterator it = 
+        formulas.find(child->getName());
+      if (it != formulas.end())
+      {
+        node->replaceChild(i, it->second->deepCopy(), true);
+        replaced = true;
+        continue;
+      }
+    }
+    replaced = substitute(child, formulas, hidden) || replaced;
+  }
+  return replaced;
+}
+
+
+/*
+ * What is known about one reaction.  The Model is only read while these
+ * are set up; the tasks below just fill in columns and derivatives.
+ */
+struct JacobianRow
+{
+  const ASTNode* math;
+  set<string> localIds;
+  vector<unsigned int> columns;
+  vector<ASTNode*> derivatives;
+};
+
+
+/*
+ * Differentiates the kinetic law of each reaction.  Every index only
+ * writes to its own row.
+ */
+class DifferentiateReactions : public ParallelTask
+{
+public:
+  DifferentiateReactions(vector<JacobianRow>& rows,
+                         const map<string, const ASTNode*>& formulas,
+                         const ListOfFunctionDefinitions* functions,
+                         const vector<string>& variableIds,
+                         const map<string, unsigned int>& variableIndex)
+    : mRows(rows)
+    , mFormulas(formulas)
+    , mFunctions(functions)
+    , mVariableIds(variableIds)
+    , mVariableIndex(variableIndex)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    JacobianRow& row = mRows[index];
+    if (row.math == NULL)
+    {
+      return;
+    }
+
+    // the copy is held by a parent node, so that a kinetic law consisting
+    // of a single name can be substituted as well; as assignment rules
+    // cannot be cyclic, every pass goes one rule further down the chain
+    ASTNode root(AST_PLUS);
+    root.addChild(row.math->deepCopy());
+    for (size_t pass = 0; pass <= mFormulas.size(); ++pass)
+    {
+      if (!substitute(&root, mFormulas, row.localIds))
+      {
+        break;
+      }
+    }
+    if (mFunctions != NULL && mFunctions->size() > 0)
+    {
+      SBMLTransforms::replaceFD(&root, mFunctions);
+    }
+    const ASTNode* math = root.getChild(0);
+
+    set<string> names;
+    collectNames(math, names);
+    vector<unsigned int> columns;
+    for (set<string>::const_iterator it = names.begin(); 
+         it != names.end(); ++it)
+    {
+      map<string, unsigned int>::const_iterator var = mVariableIndex.find(*it);
+      if (var != mVariableIndex.end() && 
+          row.localIds.find(*it) == row.localIds.end())
+      {
+        columns.push_back(var->second);
+      }
+    }
+    sort(columns.begin(), columns.end());
+
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      ASTNode* derivative = math->derivative(mVariableIds[columns[i]]);
+      if (derivative != NULL && derivative->isNumber() && 
+          !derivative->isSetUnits() && derivative->getValue() == 0)
+      {
+        delete derivative;
+        continue;
+      }
+      row.columns.push_back(columns[i]);
+      row.derivatives.push_back(derivative);
+    }
+  }
+
+private:
+  vector<JacobianRow>& mRows;
+  const map<string, const ASTNode*>& mFormulas;
+  const ListOfFunctionDefinitions* mFunctions;
+  const vector<string>& mVariableIds;
+  const map<string, unsigned int>& mVariableIndex;
+};
+
+/** @endcond */
+
+
+ReactionJacobian::ReactionJacobian()
+  : mReactionIds()
+  , mVariableIds()
+  , mReactionIndex()
+  , mVariableIndex()
+  , mRowStart(1, 0)
+  , mColumns()
+  , mMath()
+{
+}
+
+
+ReactionJacobian::~ReactionJacobian()
+{
+  clear();
+}
+
+
+int
+ReactionJacobian::compute(const Model* model, unsigned int maxThreads)
+{
+  clear();
+  if (model == NULL)
+  {
+    return LIBSBML_INVALID_OBJECT;
+  }
+
+  map<string, const ASTNode*> formulas;
+  vector<string> rateVariables;
+  for (unsigned int i = 0; i < model->getNumRules(); ++i)
+  {
+    const Rule* rule = model->getRule(i);
+    if (!rule->isSetVariable() || !rule->isSetMath())
+    {
+      continue;
+    }
+    if (rule->isAssignment())
+    {
+      formulas[rule->getVariable()] = rule->getMath();
+    }
+    else if (rule->isRate())
+    {
+      rateVariables.push_back(rule->getVariable());
+    }
+  }
+
+  // the species that are reactants or products of some reaction
+  set<string> reacting;
+  for (unsigned int r = 0; r < model->getNumReactions(); ++r)
+  {
+    const Reaction* reaction = model->getReaction(r);
+    for (unsigned int n = 0; n < reaction->getNumReactants(); ++n)
+    {
+      reacting.insert(reaction->getReactant(n)->getSpecies());
+    }
+    for (unsigned int n = 0; n < reaction->getNumProducts(); ++n)
+    {
+      reacting.insert(reaction->getProduct(n)->getSpecies());
+    }
+  }
+
+  // the columns: species changed by reactions, then rate rule variables
+  set<string> rateSet(rateVariables.begin(), rateVariables.end());
+  for (unsigned int i = 0; i < model->getNumSpecies(); ++i)
+  {
+    const Species* species = model->getSpecies(i);
+    const string& id = species->getId();
+    if (id.empty() || formulas.find(id) != formulas.end())
+    {
+      continue;
+    }
+    if (rateSet.find(id) != rateSet.end() ||
+        (!species->getConstant() && !species->getBoundaryCondition() &&
+         reacting.find(id) != reacting.end()))
+    {
+      mVariableIndex[id] = (unsigned int)mVariableIds.size();
+      mVariableIds.push_back(id);
+    }
+  }
+  for (size_t i = 0; i < rateVariables.size(); ++i)
+  {
+    if (mVariableIndex.find(rateVariables[i]) == mVariableIndex.end())
+    {
+      mVariableIndex[rateVariables[i]] = (unsigned int)mVariableIds.size();
+      mVariableIds.push_back(rateVariables[i]);
+    }
+  }
+
+  vector<JacobianRow> rows(model->getNumReactions());
+  for (unsigned int r = 0; r < model->getNumReactions(); ++r)
+  {
+    const Reaction* reaction = model->getReaction(r);
+    mReactionIds.push_back(reaction->getId());
+    mReactionIndex[reaction->getId()] = r;
+
+    const KineticLaw* kl = reaction->getKineticLaw();
+    rows[r].math = (kl != NULL && kl->isSetMath()) ? kl->getMath() : NULL;
+    if (kl == NULL)
+    {
+      continue;
+    }
+    for (unsigned int p = 0; p < kl->getNumParameters(); ++p)
+    {
+      rows[r].localIds.insert(kl->getParameter(p)->getId());
+    }
+  }
+
+  DifferentiateReactions task(rows, formulas, 
+    model->getListOfFunctionDefinitions(), mVariableIds, mVariableIndex);
+  ParallelTask::execute(task, (unsigned int)rows.size(), maxThreads);
+
+  bool complete = true;
+  mRowStart.clear();
+  for (size_t r = 0; r < rows.size(); ++r)
+  {
+    mRowStart.push_back((unsigned int)mColumns.size());
+    for (size_t n = 0; n < rows[r].columns.size(); ++n)
+    {
+      mColumns.push_back(rows[r].columns[n]);
+      mMath.push_back(rows[r].derivatives[n]);
+      complete = complete && rows[r].derivatives[n] != NULL;
+    }
+  }
+  mRowStart.push_back((unsigned int)mColumns.size());
+
+  return complete ? LIBSBML_OPERATION_SUCCESS : LIBSBML_OPERATION_FAILED;
+}
+
+
+unsigned int
+ReactionJacobian::getNumReactions() const
+{
+  return (unsigned int)mReactionIds.size();
+}
+
+
+unsigned int
+ReactionJacobian::getNumVariables() const
+{
+  return (unsigned int)mVariableIds.size();
+}
+
+
+const string&
+ReactionJacobian::getReactionId(unsigned int row) const
+{
+  static const string empty;
+  return (row < mReactionIds.size()) ? mReactionIds[row] : empty;
+}
+
+
+const string&
+ReactionJacobian::getVariableId(unsigned int column) const
+{
+  static const string empty;
+  return (column < mVariableIds.size()) ? mVariableIds[column] : empty;
+}
+
+
+int
+ReactionJacobian::getReactionIndex(const string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mReactionIndex.find(id);
+  return (it == mReactionIndex.end()) ? -1 : (int)it->second;
+}
+
+
+int
+ReactionJacobian::getVariableIndex(const string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(id);
+  return (it == mVariableIndex.end()) ? -1 : (int)it->second;
+}
+
+
+unsigned int
+ReactionJacobian::getNumEntries() const
+{
+  return (unsigned int)mColumns.size();
+}
+
+
+unsigned int
+ReactionJacobian::getEntryRow(unsigned int n) const
+{
+  if (n >= mColumns.size())
+  {
+    return getNumReactions();
+  }
+  // the last row starting at or before n
+  vector<unsigned int>::const_iterator it = 
+    upper_bound(mRowStart.begin(), mRowStart.end(), n);
+  return (unsigned int)(it - mRowStart.begin()) - 1;
+}
+
+
+unsigned int
+ReactionJacobian::getEntryColumn(unsigned int n) const
+{
+  return (n < mColumns.size()) ? mColumns[n] : getNumVariables();
+}
+
+
+const ASTNode*
+ReactionJacobian::getEntryMath(unsigned int n) const
+{
+  return (n < mMath.size()) ? mMath[n] : NULL;
+}
+
+
+unsigned int
+ReactionJacobian::getRowStart(unsigned int row) const
+{
+  return (row < mRowStart.size()) ? mRowStart[row] : getNumEntries();
+}
+
+
+const ASTNode*
+ReactionJacobian::getDerivative(const string& reactionId,
+                                const string& variableId) const
+{
+  int row = getReactionIndex(reactionId);
+  int column = getVariableIndex(variableId);
+  if (row < 0 || column < 0)
+  {
+    return NULL;
+  }
+
+  vector<unsigned int>::const_iterator begin = mColumns.begin() + mRowStart[row];
+  vector<unsigned int>::const_iterator end = mColumns.begin() + mRowStart[row + 1];
+  vector<unsigned int>::const_iterator it = 
+    lower_bound(begin, end, (unsigned int)column);
+  if (it == end || *it != (unsigned int)column)
+  {
+    return NULL;
+  }
+  return mMath[it - mColumns.begin()];
+}
+
+
+void
+ReactionJacobian::clear()
+{
+  for (size_t n = 0; n < mMath.size(); ++n)
+  {
+    delete mMath[n];
+  }
+  mReactionIds.clear();
+  mVariableIds.clear();
+  mReactionIndex.clear();
+  mVariableIndex.clear();
+  mRowStart.assign(1, 0);
+  mColumns.clear();
+  mMath.clear();
+}
+
+
+LIBSBML_CPP_NAMESPACE_END
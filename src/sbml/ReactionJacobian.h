@@ -0,0 +1,284 @@
+/**
+ * @file    ReactionJacobian.h
+ * @brief   Symbolic partial derivatives of the reaction rates of a Model.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class ReactionJacobian
+ * @sbmlbrief{core} Symbolic partial derivatives of the reaction rates of a
+ * Model.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * A ReactionJacobian holds the sparse matrix of partial derivatives of the
+ * kinetic laws of a Model with respect to its state variables, as
+ * formulas.  Together with the stoichiometry of the reactions, this is what
+ * ODE solvers need to build an analytic Jacobian.
+ *
+ * The rows of the matrix are the reactions of the Model, in the order in
+ * which they appear in it.  The columns, or variables, are the species that
+ * the reactions change (those that are a reactant or product of some
+ * reaction, and are neither constant nor boundary species, nor set by an
+ * assignment rule), followed by the other compartments, species and
+ * parameters set by rate rules.  Species that only appear as modifiers,
+ * or in no reaction at all, are not variables.
+ *
+ * Before a kinetic law is differentiated, the variables set by assignment
+ * rules are replaced by their formulas, and calls to function definitions
+ * are expanded, so that indirect dependencies show up in the derivatives.
+ * Local parameters hide global variables of the same name.  The
+ * derivatives are computed with ASTNode::derivative(); only the non-zero
+ * ones are stored.  The derivatives of different reactions are computed in
+ * parallel, if libSBML was built with thread support.
+ *
+ * The derivatives are taken with respect to the values the identifiers
+ * stand for in the math, that is, species concentrations unless the species
+ * has only substance units.
+ */
+
+#ifndef ReactionJacobian_h
+#define ReactionJacobian_h
+
+
+#include <sbml/common/extern.h>
+#include <sbml/common/sbmlfwd.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN ReactionJacobian
+{
+public:
+
+  /**
+   * Creates a new, empty ReactionJacobian.
+   */
+  ReactionJacobian();
+
+
+  /**
+   * Destroys this ReactionJacobian and the derivatives it holds.
+   */
+  ~ReactionJacobian();
+
+
+  /**
+   * Computes the partial derivatives of the kinetic laws of a Model,
+   * replacing any previous content of this ReactionJacobian.
+   *
+   * @param model the Model to differentiate.
+   * @param maxThreads the maximum number of threads to use, or @c 0 for
+   * the default of ParallelTask.
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}, if
+   * @p model is @c NULL.
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t},
+   * if some derivatives could not be expressed.  Those entries are still
+   * present, with a @c NULL formula.
+   */
+  int compute(const Model* model, unsigned int maxThreads = 0);
+
+
+  /**
+   * Returns the number of rows, which is the number of reactions.
+   *
+   * @return the number of reactions of the Model last computed.
+   */
+  unsigned int getNumReactions() const;
+
+
+  /**
+   * Returns the number of columns, which is the number of variables.
+   *
+   * @return the number of variables the derivatives were taken for.
+   */
+  unsigned int getNumVariables() const;
+
+
+  /**
+   * Returns the identifier of the reaction of a row.
+   *
+   * @param row the index of the row.
+   *
+   * @return the reaction id, or an empty string if @p row is out of range.
+   */
+  const std::string& getReactionId(unsigned int row) const;
+
+
+  /**
+   * Returns the identifier of the variable of a column.
+   *
+   * @param column the index of the column.
+   *
+   * @return the variable id, or an empty string if @p column is out of
+   * range.
+   */
+  const std::string& getVariableId(unsigned int column) const;
+
+
+  /**
+   * Returns the row of a reaction.
+   *
+   * @param id the identifier of the reaction.
+   *
+   * @return the index of the row, or @c -1 if there is no such reaction.
+   */
+  int getReactionIndex(const std::string& id) const;
+
+
+  /**
+   * Returns the column of a variable.
+   *
+   * @param id the identifier of the variable.
+   *
+   * @return the index of the column, or @c -1 if there is no such
+   * variable.
+   */
+  int getVariableIndex(const std::string& id) const;
+
+
+  /**
+   * Returns the number of non-zero entries.
+   *
+   * The entries are ordered by row, and by column within each row.
+   *
+   * @return the number of entries.
+   */
+  unsigned int getNumEntries() const;
+
+
+  /**
+   * Returns the row of an entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the row of entry @p n, or getNumReactions() if @p n is out of
+   * range.
+   */
+  unsigned int getEntryRow(unsigned int n) const;
+
+
+  /**
+   * Returns the column of an entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the column of entry @p n, or getNumVariables() if @p n is out
+   * of range.
+   */
+  unsigned int getEntryColumn(unsigned int n) const;
+
+
+  /**
+   * Returns the derivative stored in an entry.
+   *
+   * @param n the index of the entry.
+   *
+   * @return the derivative, which remains owned by this ReactionJacobian,
+   * or @c NULL if it could not be expressed or @p n is out of range.
+   */
+  const ASTNode* getEntryMath(unsigned int n) const;
+
+
+  /**
+   * Returns the index of the first entry of a row; the entries of the row
+   * end where those of the next row start.
+   *
+   * @param row the index of the row, up to and including
+   * getNumReactions().
+   *
+   * @return the index of the first entry of @p row, or getNumEntries() if
+   * @p row is out of range.
+   */
+  unsigned int getRowStart(unsigned int row) const;
+
+
+  /**
+   * Returns the partial derivative of the rate of a reaction with respect
+   * to a variable.
+   *
+   * @param reactionId the identifier of the reaction.
+   * @param variableId the identifier of the variable.
+   *
+   * @return the derivative, which remains owned by this ReactionJacobian,
+   * or @c NULL if the derivative is zero, could not be expressed, or the
+   * reaction or variable is unknown.
+   */
+  const ASTNode* getDerivative(const std::string& reactionId,
+                               const std::string& variableId) const;
+
+
+  /**
+   * Removes all rows, columns and entries.
+   */
+  void clear();
+
+
+  /** @cond doxygenLibsbmlInternal */
+protected:
+
+  std::vector<std::string> mReactionIds;
+  std::vector<std::string> mVariableIds;
+  std::map<std::string, unsigned int> mReactionIndex;
+  std::map<std::string, unsigned int> mVariableIndex;
+
+  std::vector<unsigned int> mRowStart;
+  std::vector<unsigned int> mColumns;
+  std::vector<ASTNode*> mMath;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+  ReactionJacobian(const ReactionJacobian&);
+  ReactionJacobian& operator=(const ReactionJacobian&);
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ReactionJacobian_h */
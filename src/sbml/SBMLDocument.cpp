@@ -51,6 +51,7 @@
 #include <sbml/xml/XMLError.h>
 
 #include <sbml/validator/SBMLInternalValidator.h>
+#include <sbml/validator/IdCensus.h>
 #include <sbml/validator/StrictUnitConsistencyValidator.h>
 #include <sbml/validator/UnitConsistencyValidator.h>
 
@@ -125,6 +126,7 @@ SBMLDocument::SBMLDocument (unsigned int level, unsigned int version) :
  , mVersion ( version )
  , mModel   ( NULL       )
  , mLocationURI     ("")
+ , mIdCensus ( NULL )
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
 {
@@ -159,6 +161,7 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
    SBase  (sbmlns)
  , mModel ( NULL       )
  , mLocationURI ("")
+ , mIdCensus ( NULL )
  , mRequiredAttrOfUnknownPkg()
  , mRequiredAttrOfUnknownDisabledPkg()
 {
@@ -224,6 +227,25 @@ SBMLDocument::SBMLDocument (SBMLNamespaces* sbmlns) :
     }
     return NULL;
   }
+
+  bool SBMLDocument::startIdCensus() const
+  {
+    if (mIdCensus != NULL) return false;
+
+    mIdCensus = new IdCensus(mModel);
+    return true;
+  }
+
+  void SBMLDocument::endIdCensus() const
+  {
+    delete mIdCensus;
+    mIdCensus = NULL;
+  }
+
+  const IdCensus* SBMLDocument::getIdCensus() const
+  {
+    return mIdCensus;
+  }
 /** @endcond */
 
 
@@ -234,6 +256,7 @@ SBMLDocument::~SBMLDocument ()
 {
   if (mInternalValidator != NULL)
     delete mInternalValidator;
+  endIdCensus();
   if (mModel != NULL)
     delete mModel;
   clearValidators();
@@ -252,6 +275,7 @@ SBMLDocument::SBMLDocument (const SBMLDocument& orig)
  , mErrorLog()
  , mValidators ()
  , mInternalValidator(new SBMLInternalValidator())
+ , mIdCensus ( NULL )
  , mRequiredAttrOfUnknownPkg(orig.mRequiredAttrOfUnknownPkg)
  , mRequiredAttrOfUnknownDisabledPkg(orig.mRequiredAttrOfUnknownDisabledPkg)
  , mPkgUseDefaultNSMap()
@@ -294,6 +318,7 @@ SBMLDocument& SBMLDocument::operator=(const SBMLDocument& rhs)
     }
     mInternalValidator = (SBMLInternalValidator*)rhs.mInternalValidator->clone();
     mInternalValidator->setDocument(this);
+    endIdCensus();
     mRequiredAttrOfUnknownPkg = rhs.mRequiredAttrOfUnknownPkg;
     mRequiredAttrOfUnknownDisabledPkg = rhs.mRequiredAttrOfUnknownDisabledPkg;
 
@@ -700,6 +725,9 @@ SBMLDocument::checkConsistency ()
                                   getErrorLog()->getSeverityOverride();
   getErrorLog()->setSeverityOverride(LIBSBML_OVERRIDE_DISABLED);
 
+  // the internal and package validators share one census of the ids
+  bool ownCensus = startIdCensus();
+
   unsigned int numErrors = mInternalValidator->checkConsistency();
 
   for (unsigned int i = 0; i < getNumPlugins(); i++)
@@ -708,6 +736,8 @@ SBMLDocument::checkConsistency ()
                       (getPlugin(i))->checkConsistency();
   }
 
+  if (ownCensus) endIdCensus();
+
   list<SBMLValidator*>::iterator it;
   for (it = mValidators.begin(); it != mValidators.end(); it++)
   {
@@ -744,6 +774,8 @@ SBMLDocument::checkConsistencyWithStrictUnits ()
   // turn off the original units validator
   setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
 
+  bool ownCensus = startIdCensus();
+
   unsigned int numErrors = mInternalValidator->checkConsistency();
 
   for (unsigned int i = 0; i < getNumPlugins(); i++)
@@ -752,6 +784,8 @@ SBMLDocument::checkConsistencyWithStrictUnits ()
                       (getPlugin(i))->checkConsistency();
   }
 
+  if (ownCensus) endIdCensus();
+
   list<SBMLValidator*>::iterator it;
   for (it = mValidators.begin(); it != mValidators.end(); it++)
   {
@@ -1217,7 +1251,6 @@ int SBMLDocument::convert(const ConversionProperties& props)
   if (converter == NULL) return LIBSBML_CONV_CONVERSION_NOT_AVAILABLE;
 
   converter->setDocument(this);
-  converter->setProperties(&props);
   int result = converter->convert();
 
   delete converter;
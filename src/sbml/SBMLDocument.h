@@ -322,6 +322,7 @@ class XMLError;
 
 class SBMLValidator;
 class SBMLInternalValidator;
+class IdCensus;
 class SBMLLevelVersionConverter;
 
 /** @cond doxygenLibsbmlInternal */
@@ -1632,6 +1633,30 @@ public:
 
   /** @endcond */
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Starts an IdCensus of the model that the validators share until
+   * endIdCensus() is called.
+   *
+   * @return @c true if a new census was started, @c false if one is
+   * already in use (and the caller must not end it).
+   */
+  bool startIdCensus() const;
+
+
+  /**
+   * Discards the census started by startIdCensus().
+   */
+  void endIdCensus() const;
+
+
+  /**
+   * Returns the census in use, or @c NULL if there is none.
+   */
+  const IdCensus* getIdCensus() const;
+
+  /** @endcond */
+
 protected:
   /** @cond doxygenLibsbmlInternal */
   typedef std::map<std::string, bool>  PkgUseDefaultNSMap;
@@ -1702,6 +1727,7 @@ protected:
 
   std::list<SBMLValidator*> mValidators;
   SBMLInternalValidator *mInternalValidator;
+  mutable IdCensus*      mIdCensus;
 
   XMLAttributes            mRequiredAttrOfUnknownPkg;
   XMLAttributes            mRequiredAttrOfUnknownDisabledPkg;
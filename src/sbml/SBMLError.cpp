@@ -48,6 +48,7 @@
 #include <sbml/SBMLError.h>
 #include <sbml/SBMLErrorTable.h>
 #include <sbml/extension/SBMLExtensionRegistry.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 
 /** @cond doxygenIgnored */
@@ -205,6 +206,10 @@ SBMLError::SBMLError (  const unsigned int errorId
                       , const std::string package
                       , const unsigned int pkgVersion) :
     XMLError((int)errorId, details, line, column, severity, category)
+  , mLevel          ( level )
+  , mVersion        ( version )
+  , mPackageVersion ( pkgVersion )
+  , mErrorTableIndex( 0 )
 {
   // Check if the given @p id is one we have in our table of error codes.  If
   // it is, fill in the fields of the error object with the appropriate
@@ -219,17 +224,8 @@ SBMLError::SBMLError (  const unsigned int errorId
   else if ( mErrorId > XMLErrorCodesUpperBound
             && mErrorId < SBMLCodesUpperBound )
   {
-    unsigned int tableSize = sizeof(errorTable)/sizeof(errorTable[0]);
-    unsigned int index = 0;
-
-    for ( unsigned int i = 0; i < tableSize; i++ )
-    {
-      if ( mErrorId == errorTable[i].code )
-      {
-        index = i;
-        break;
-      }
-    }
+    static const ErrorTableIndex tableIndex(errorTable);
+    unsigned int index = tableIndex.find(mErrorId);
 
     if ( index == 0 && mErrorId != UnknownError )
     {
@@ -253,7 +249,6 @@ SBMLError::SBMLError (  const unsigned int errorId
       mErrorId = InconsistentArgUnits;
     }
 
-    ostringstream newMsg;
     mSeverity = getSeverityForEntry(index, level, version);
 
     if (mValidError == false)
@@ -274,7 +269,6 @@ SBMLError::SBMLError (  const unsigned int errorId
 
       mErrorId  = NotSchemaConformant;
       mSeverity = LIBSBML_SEV_ERROR;
-      newMsg << errorTable[3].message << " "; // FIXME
     }
     else if (mSeverity == LIBSBML_SEV_GENERAL_WARNING)
     {
@@ -285,81 +279,14 @@ SBMLError::SBMLError (  const unsigned int errorId
       // and then here we translate them into regular warnings.
 
       mSeverity = LIBSBML_SEV_WARNING;
-      newMsg << "[Although SBML Level " << level
-             << " Version " << version << " does not explicitly define the "
-             << "following as an error, other Levels and/or Versions "
-             << "of SBML do.] " << endl;
-    }
-
-    // Finish updating the (full) error message.
-
-    if (!((string)errorTable[index].message).empty()) {
-      newMsg << errorTable[index].message << endl;
     }
 
-    // look for individual references
-    // if the code for this error does not yet exist skip
+    // The full message is only assembled when it is first asked for, see
+    // formatMessage(); the XMLError constructor stored the details in it.
 
-    if (errorTable[index].reference.ref_l3v2 != NULL)
-    {
-
-      std::string ref;
-      switch(level)
-      {
-      case 1:
-        ref = errorTable[index].reference.ref_l1;
-        break;
-      case 2:
-        switch(version)
-        {
-        case 1:
-          ref = errorTable[index].reference.ref_l2v1;
-          break;
-        case 2:
-          ref = errorTable[index].reference.ref_l2v2;
-          break;
-        case 3:
-          ref = errorTable[index].reference.ref_l2v3;
-          break;
-        case 4:
-          ref = errorTable[index].reference.ref_l2v4;
-          break;
-        case 5:
-        default:
-          ref = errorTable[index].reference.ref_l2v5;
-          break;
-        }
-        break;
-      case 3:
-        switch(version)
-        {
-        case 1:
-          ref = errorTable[index].reference.ref_l3v1;
-          break;
-        case 2:
-        default:
-          ref = errorTable[index].reference.ref_l3v2;
-          break;
-        }
-        break;
-      default:
-        ref = errorTable[index].reference.ref_l3v2;
-        break;
-      }
-
-      if (!ref.empty())
-      {
-        newMsg << "Reference: " << ref << endl;
-      }
-    }
-    if (!details.empty())
-    {
-      newMsg << " " << details;
-      if (details[details.size()-1] != '\n') {
-        newMsg << endl;
-      }
-    }      
-    mMessage  = newMsg.str();
+    mErrorTableIndex = index;
+    mDetails.swap(mMessage);
+    mMessagePending = true;
 
     // We mucked around with the severity code and (maybe) category code
     // after creating the XMLError object, so we may have to update the
@@ -375,8 +302,8 @@ SBMLError::SBMLError (  const unsigned int errorId
   if (package.empty() == false && package != "core")
   {
     // we are logging an error from a package
-    SBMLExtension *sbext = 
-      SBMLExtensionRegistry::getInstance().getExtension(package);
+    const SBMLExtension *sbext = 
+      SBMLExtensionRegistry::getInstance().getExtensionInternal(package);
     if (sbext != NULL)
     {
       unsigned int index = sbext->getErrorTableIndex(mErrorId);
@@ -389,15 +316,17 @@ SBMLError::SBMLError (  const unsigned int errorId
           mSeverity = severity;
         }
         mCategory = sbext->getCategory(index, pkgVersion);
-        mMessage = sbext->getMessage(index, pkgVersion, details);
         mShortMessage = sbext->getShortMessage(index, pkgVersion);
         mPackage = package;
         mErrorIdOffset = sbext->getErrorIdOffset();
+
+        // the message is assembled by formatMessage()
+        mErrorTableIndex = index;
+        mDetails.swap(mMessage);
+        mMessagePending = true;
       }
       mSeverityString = stringForSeverity(mSeverity);
       mCategoryString = stringForCategory(mCategory);
-      
-      delete sbext;
 
       return;
     }
@@ -419,6 +348,157 @@ SBMLError::SBMLError (  const unsigned int errorId
 }
 
 
+/*
+ * Copy constructor; a message that has not been formatted yet stays so.
+ */
+SBMLError::SBMLError (const SBMLError& orig) :
+    XMLError(orig, KeepPendingMessage())
+  , mLevel          ( 0 )
+  , mVersion        ( 0 )
+  , mPackageVersion ( 0 )
+  , mErrorTableIndex( 0 )
+  , mDetails        ()
+{
+  // SBMLErrorLog also hands out the XMLErrors logged while parsing as
+  // SBMLErrors, so the members of this class are only read when a pending
+  // message needs them; only an actual SBMLError has one
+  if (orig.mMessagePending)
+  {
+    mLevel           = orig.mLevel;
+    mVersion         = orig.mVersion;
+    mPackageVersion  = orig.mPackageVersion;
+    mErrorTableIndex = orig.mErrorTableIndex;
+    mDetails         = orig.mDetails;
+  }
+}
+
+
+/*
+ * Assignment operator; the message of @p rhs is formatted and copied, so
+ * nothing else of @p rhs is needed.
+ */
+SBMLError&
+SBMLError::operator= (const SBMLError& rhs)
+{
+  if (&rhs != this)
+  {
+    XMLError::operator=(rhs);
+    mDetails.clear();
+  }
+
+  return *this;
+}
+
+
+/** @cond doxygenLibsbmlInternal **/
+/*
+ * Assembles the message of an error from the error table of the core or
+ * of its package.
+ */
+void
+SBMLError::formatMessage () const
+{
+  unsigned int index = mErrorTableIndex;
+
+  if (mPackage.empty() == false && mPackage != "core")
+  {
+    const SBMLExtension *sbext = 
+      SBMLExtensionRegistry::getInstance().getExtensionInternal(mPackage);
+
+    mMessage = (sbext != NULL) 
+             ? sbext->getMessage(index, mPackageVersion, mDetails) : mDetails;
+    return;
+  }
+
+  ostringstream newMsg;
+  unsigned int severity = (mValidError == false) ? LIBSBML_SEV_WARNING
+                        : getSeverityForEntry(index, mLevel, mVersion);
+
+  if (severity == LIBSBML_SEV_SCHEMA_ERROR)
+  {
+    newMsg << errorTable[3].message << " "; // FIXME
+  }
+  else if (severity == LIBSBML_SEV_GENERAL_WARNING)
+  {
+    newMsg << "[Although SBML Level " << mLevel
+           << " Version " << mVersion << " does not explicitly define the "
+           << "following as an error, other Levels and/or Versions "
+           << "of SBML do.] " << endl;
+  }
+
+  // Finish updating the (full) error message.
+
+  if (!((string)errorTable[index].message).empty()) {
+    newMsg << errorTable[index].message << endl;
+  }
+
+  // look for individual references
+  // if the code for this error does not yet exist skip
+
+  if (errorTable[index].reference.ref_l3v2 != NULL)
+  {
+
+    std::string ref;
+    switch(mLevel)
+    {
+    case 1:
+      ref = errorTable[index].reference.ref_l1;
+      break;
+    case 2:
+      switch(mVersion)
+      {
+      case 1:
+        ref = errorTable[index].reference.ref_l2v1;
+        break;
+      case 2:
+        ref = errorTable[index].reference.ref_l2v2;
+        break;
+      case 3:
+        ref = errorTable[index].reference.ref_l2v3;
+        break;
+      case 4:
+        ref = errorTable[index].reference.ref_l2v4;
+        break;
+      case 5:
+      default:
+        ref = errorTable[index].reference.ref_l2v5;
+        break;
+      }
+      break;
+    case 3:
+      switch(mVersion)
+      {
+      case 1:
+        ref = errorTable[index].reference.ref_l3v1;
+        break;
+      case 2:
+      default:
+        ref = errorTable[index].reference.ref_l3v2;
+        break;
+      }
+      break;
+    default:
+      ref = errorTable[index].reference.ref_l3v2;
+      break;
+    }
+
+    if (!ref.empty())
+    {
+      newMsg << "Reference: " << ref << endl;
+    }
+  }
+  if (!mDetails.empty())
+  {
+    newMsg << " " << mDetails;
+    if (mDetails[mDetails.size()-1] != '\n') {
+      newMsg << endl;
+    }
+  }      
+  mMessage = newMsg.str();
+}
+/** @endcond **/
+
+
 /** @cond doxygenLibsbmlInternal **/
 /*
  * clone function
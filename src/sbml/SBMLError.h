@@ -1220,6 +1220,23 @@ public:
   );
 
 
+  /**
+   * Copy constructor; creates a copy of this SBMLError.
+   *
+   * @param orig the instance to copy.
+   */
+  SBMLError(const SBMLError& orig);
+
+
+  /**
+   * Assignment operator for SBMLError.
+   *
+   * @param rhs the object whose values are used as the basis of the
+   * assignment.
+   */
+  SBMLError& operator=(const SBMLError& rhs);
+
+
 #ifndef SWIG
 
   /** @cond doxygenLibsbmlInternal **/
@@ -1251,8 +1268,17 @@ protected:
   virtual std::string stringForSeverity(unsigned int code) const;
   virtual std::string stringForCategory(unsigned int code) const;
 
+  virtual void formatMessage() const;
+
   void adjustErrorId(unsigned int offset);
 
+  /* what formatMessage() needs to assemble the message */
+  unsigned int mLevel;
+  unsigned int mVersion;
+  unsigned int mPackageVersion;
+  unsigned int mErrorTableIndex;
+  std::string  mDetails;
+
   /** @endcond **/
 };
 
@@ -253,6 +253,7 @@ SBMLErrorLog::remove (const unsigned int errorId)
   {
     // deletes (invoke delete operator for the matched item) and erases (removes
     // the pointer from mErrors) the matched item (if any)
+    uncountError(*delIter);
     delete *delIter;
     mErrors.erase(delIter);
   }
@@ -271,6 +272,7 @@ SBMLErrorLog::removeAll (const unsigned int errorId)
   {
     // deletes (invoke delete operator for the matched item) and erases (removes
     // the pointer from mErrors) the matched item (if any)
+    uncountError(*delIter);
     delete *delIter;
     mErrors.erase(delIter);
 
@@ -323,16 +325,7 @@ private:
 unsigned int 
 SBMLErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 {
-  unsigned int n = 0;
-
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (unsigned int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
-
-  return n;
+  return getCount(mSeverityCounts, severity);
 }
 
 /*
@@ -341,16 +334,17 @@ SBMLErrorLog::getNumFailsWithSeverity(unsigned int severity) const
 unsigned int
 SBMLErrorLog::getNumFailsWithSeverity(unsigned int severity)
 {
-  unsigned int n = 0;
+  return getCount(mSeverityCounts, severity);
+}
 
-#if defined(__SUNPRO_CC)
-  // Workaround for Sun cc which is missing:
-  count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity), n);
-#else
-  n = (unsigned int)count_if(mErrors.begin(), mErrors.end(), MatchSeverity(severity));
-#endif
 
-  return n;
+/*
+ * Returns number of errors that are logged with the given category
+ */
+unsigned int
+SBMLErrorLog::getNumFailsWithCategory(unsigned int category) const
+{
+  return getCount(mCategoryCounts, category);
 }
 
 
@@ -170,6 +170,9 @@ public:
    * Returns the number of errors that have been logged with the given
    * severity code.
    *
+   * The count includes errors that were not stored in this log (see
+   * XMLErrorLog::setMaxStoredErrors()).
+   *
    * @copydetails doc_errorlog_what_are_severities
    *
    * @if clike @param severity a value from
@@ -191,6 +194,9 @@ public:
    * Returns the number of errors that have been logged with the given
    * severity code.
    *
+   * The count includes errors that were not stored in this log (see
+   * XMLErrorLog::setMaxStoredErrors()).
+   *
    * @copydetails doc_errorlog_what_are_severities
    *
    * @if clike @param severity a value from
@@ -208,6 +214,25 @@ public:
   unsigned int getNumFailsWithSeverity(unsigned int severity) const;
 
 
+  /**
+   * Returns the number of errors that have been logged with the given
+   * category code.
+   *
+   * @if clike @param category a value from
+   * #SBMLErrorCategory_t @endif@if java @param category a
+   * value from the set of <code>LIBSBML_CAT_</code> constants defined by
+   * the interface class <code><a
+   * href="libsbmlConstants.html">libsbmlConstants</a></code> @endif@if python @param category a
+   * value from the set of <code>LIBSBML_CAT_</code> constants defined by
+   * the interface class @link libsbml libsbml@endlink. @endif@~
+   *
+   * @return a count of the number of errors with the given category code.
+   *
+   * @see getNumFailsWithSeverity(unsigned int severity)
+   */
+  unsigned int getNumFailsWithCategory(unsigned int category) const;
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Creates a new, empty SBMLErrorLog.
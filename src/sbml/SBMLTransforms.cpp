@@ -42,6 +42,7 @@
 #include <sbml/SBMLTransforms.h>
 #include <sbml/util/util.h>
 #include <sbml/Model.h>
+#include <sbml/extension/SBMLExtensionRegistry.h>
 
 #include <cstring>
 #include <math.h>
@@ -58,6 +59,17 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 /** @cond doxygenLibsbmlInternal */
 SBMLTransforms::IdValueMap SBMLTransforms::mValues;
 
+/*
+ * The values a plugin evaluating part of a formula should use.  Plugins
+ * evaluate the children of their nodes through evaluateASTNode(node, m),
+ * which would otherwise read the map shared by the whole process.
+ */
+#ifdef LIBSBML_USE_THREADS
+static thread_local const SBMLTransforms::IdValueMap* sPluginValues = NULL;
+#else
+static const SBMLTransforms::IdValueMap* sPluginValues = NULL;
+#endif
+
 void
 SBMLTransforms::replaceFD(ASTNode * node, const ListOfFunctionDefinitions *lofd, const IdList* idsToExclude /*= NULL*/)
 {
@@ -533,6 +545,11 @@ SBMLTransforms::clearComponentValues()
 double
 SBMLTransforms::evaluateASTNode(const ASTNode *node, const Model *m)
 {
+  if (sPluginValues != NULL)
+  {
+    return evaluateASTNode(node, *sPluginValues, m);
+  }
+
   if (mValues.size() == 0)
   {
     mapComponentValues(m);
@@ -1083,16 +1100,22 @@ SBMLTransforms::evaluateASTNode(const ASTNode * node, const IdValueMap& values,
     break;
 
   default:
-    if (node->getNumPlugins() == 0)
     {
-      ((ASTNode*)(node))->loadASTPlugins(NULL);
-    }
-    for (unsigned int p = 0; p < node->getNumPlugins(); p++)
-    {
-      const ASTBasePlugin* baseplugin = node->getPlugin(p);
-      if (baseplugin->defines(node->getType()))
+      // prefer the package enabled on the document of the model; math is
+      // also evaluated while it is converted to a level without it
+      SBMLExtensionRegistry& registry = SBMLExtensionRegistry::getInstance();
+      const ASTBasePlugin* baseplugin = registry.getASTPluginFor(
+        node->getType(), (m != NULL) ? m->getSBMLNamespaces() : NULL);
+      if (baseplugin == NULL)
+      {
+        baseplugin = registry.getASTPluginFor(node->getType());
+      }
+      if (baseplugin != NULL)
       {
+        const IdValueMap* outer = sPluginValues;
+        sPluginValues = &values;
         result = baseplugin->evaluateASTNode(node, m);
+        sPluginValues = outer;
       }
     }
   }
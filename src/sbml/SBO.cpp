@@ -42,6 +42,7 @@
 #include <iomanip>
 #include <sstream>
 #include <iterator>
+#include <vector>
 
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLOutputStream.h>
@@ -188,59 +189,6 @@ SBO::intToString (int sboTerm)
 }
 
 
-/**
-  * functions for checking the SBO term is from correct part of SBO
-  * Unary Functor returns the parent portion of a ParentMap pair.
-  */
-struct GetSecond 
-{
-  int operator() (const pair<const int, int>& pair) { return pair.second; }
-};
-
-
-/** @cond doxygenLibsbmlInternal */
-/**
-  * functions for checking the SBO term is from correct part of SBO
-  * returns true if the term is-a parent, false otherwise
-  */
-bool
-SBO::isChildOf(unsigned int term, unsigned int parent)
-{
-  bool        result = false;
-  if (mParent.empty())
-  {
-    populateSBOTree();
-  }
-  ParentRange range  = mParent.equal_range((int)term);
-  deque<unsigned int>  nodes;
-
-
-  // Copy parents of term to nodes.
-  transform(range.first, range.second, back_inserter(nodes), GetSecond());
-
-  // Search nodes DFS for parent.
-  // (For BFS, change back() and pop_back() to front() and pop_front().)
-  while ( !nodes.empty() )
-  {
-    const unsigned int p = nodes.back();
-    nodes.pop_back();
-
-    if (p == parent)
-    {
-      result = true;
-      break;
-    }
-
-    // Copy parents of p to nodes and continue search.
-    range = mParent.equal_range((int)p);
-    transform(range.first, range.second, back_inserter(nodes), GetSecond());
-  }
-
-  return result;
-}
-/** @endcond */
-
-
 /**
   * functions for checking the SBO term is from correct part of SBO
   * returns true if the term is-a QuantitativeParameter, false otherwise
@@ -703,737 +651,883 @@ SBO::getParentBranch(unsigned int term)
 /** @endcond */
 
 /** @cond doxygenLibsbmlInternal */
+/*
+ * The is_a relations of SBO as (term, parent) pairs; obsolete terms have
+ * the parent 1000.  This table is generated by the update_sbo target (see
+ * dev/utilities/sboTree).
+ */
+static const unsigned int SBO_PARENTS[][2] =
+{
+  // generated from SBO on 2020/11/14
+  {   1,   64 },
+  {   2,  545 },
+  {   3,    0 },
+  {   4,    0 },
+  {   5, 1000 },
+  {   6, 1000 },
+  {   7, 1000 },
+  {   8, 1000 },
+  {   9,    2 },
+  {  10,    3 },
+  {  11,    3 },
+  {  12,    1 },
+  {  13,  459 },
+  {  14,  241 },
+  {  15,   10 },
+  {  16,    9 },
+  {  17,    9 },
+  {  18,    9 },
+  {  19,    3 },
+  {  20,   19 },
+  {  21,  459 },
+  {  22,   16 },
+  {  22,  153 },
+  {  23,   17 },
+  {  23,  153 },
+  {  24,   18 },
+  {  24,  153 },
+  {  25,   35 },
+  {  26, 1000 },
+  {  27,  193 },
+  {  28,  150 },
+  {  28,  326 },
+  {  29,   28 },
+  {  30,   28 },
+  {  31,   28 },
+  {  32,   16 },
+  {  32,  156 },
+  {  33,   17 },
+  {  33,  156 },
+  {  34,   18 },
+  {  34,  156 },
+  {  35,   22 },
+  {  35,  154 },
+  {  36,   23 },
+  {  36,  154 },
+  {  37,   24 },
+  {  37,  154 },
+  {  38,   32 },
+  {  39,   33 },
+  {  40,   34 },
+  {  41,   12 },
+  {  42,   12 },
+  {  43,   41 },
+  {  44,   41 },
+  {  45,   41 },
+  {  46,    9 },
+  {  47,   43 },
+  {  47,  163 },
+  {  48,  154 },
+  {  48,  162 },
+  {  49,   44 },
+  {  49,  163 },
+  {  50,   45 },
+  {  51, 1000 },
+  {  52,   50 },
+  {  52,  163 },
+  {  53,   45 },
+  {  54,   53 },
+  {  54,  163 },
+  {  55,   41 },
+  {  56,   55 },
+  {  57,   56 },
+  {  57,  163 },
+  {  58,   55 },
+  {  59,   58 },
+  {  59,  163 },
+  {  60,   55 },
+  {  61,   60 },
+  {  61,  163 },
+  {  62,    4 },
+  {  63,    4 },
+  {  64,    0 },
+  {  65,  155 },
+  {  65,  162 },
+  {  66,   22 },
+  {  66,  155 },
+  {  67,   23 },
+  {  67,  155 },
+  {  68,   24 },
+  {  68,  155 },
+  {  69,   42 },
+  {  70,   69 },
+  {  71,   69 },
+  {  72,   71 },
+  {  73,   71 },
+  {  74,   69 },
+  {  75,   74 },
+  {  76,   74 },
+  {  77,   74 },
+  {  78,   42 },
+  {  79,   78 },
+  {  80,   78 },
+  {  81,   78 },
+  {  82,   81 },
+  {  83,   81 },
+  {  84,   78 },
+  {  85,   84 },
+  {  86,   84 },
+  {  87,   84 },
+  {  88,   42 },
+  {  89,   88 },
+  {  90,   89 },
+  {  91,   89 },
+  {  92,   89 },
+  {  93,   92 },
+  {  94,   92 },
+  {  95,   89 },
+  {  96,   95 },
+  {  97,   95 },
+  {  98,   95 },
+  {  99,   88 },
+  { 100,   99 },
+  { 101,   99 },
+  { 102,   99 },
+  { 103,  102 },
+  { 104,  102 },
+  { 105,   99 },
+  { 106,  105 },
+  { 107,  105 },
+  { 108,  105 },
+  { 109,   42 },
+  { 110,  109 },
+  { 111,  110 },
+  { 112,  110 },
+  { 113,  110 },
+  { 114,  113 },
+  { 115,  113 },
+  { 116,  110 },
+  { 117,  116 },
+  { 118,  116 },
+  { 119,  116 },
+  { 120,  109 },
+  { 121,  120 },
+  { 122,  120 },
+  { 123,  120 },
+  { 124,  123 },
+  { 125,  123 },
+  { 126,  120 },
+  { 127,  126 },
+  { 128,  126 },
+  { 129,  126 },
+  { 130,  109 },
+  { 131,  130 },
+  { 132,  130 },
+  { 133,  130 },
+  { 134,  133 },
+  { 135,  133 },
+  { 136,  130 },
+  { 137,  136 },
+  { 138,  136 },
+  { 139,  136 },
+  { 140,   43 },
+  { 140,  166 },
+  { 141,   44 },
+  { 141,  166 },
+  { 142,   50 },
+  { 142,  166 },
+  { 143,   53 },
+  { 143,  166 },
+  { 144,   56 },
+  { 144,  166 },
+  { 145,   58 },
+  { 145,  166 },
+  { 146,   60 },
+  { 146,  166 },
+  { 147,    2 },
+  { 148,    2 },
+  { 149,  157 },
+  { 150,  268 },
+  { 151,  150 },
+  { 152,  150 },
+  { 153,    9 },
+  { 154,  153 },
+  { 155,  153 },
+  { 156,    9 },
+  { 157,  188 },
+  { 158,  382 },
+  { 159,    9 },
+  { 160,  153 },
+  { 160,  159 },
+  { 161,  156 },
+  { 161,  159 },
+  { 162,   46 },
+  { 162,  153 },
+  { 163,   41 },
+  { 164, 1000 },
+  { 165, 1000 },
+  { 166,   41 },
+  { 167,  375 },
+  { 168,  374 },
+  { 169,  168 },
+  { 170,  168 },
+  { 171,  170 },
+  { 172,  170 },
+  { 173,  237 },
+  { 174,  237 },
+  { 175,  237 },
+  { 176,  167 },
+  { 177,  176 },
+  { 178,  182 },
+  { 179,  176 },
+  { 180,  176 },
+  { 181,  176 },
+  { 182,  176 },
+  { 183,  205 },
+  { 184,  205 },
+  { 185,  167 },
+  { 186,   46 },
+  { 187, 1000 },
+  { 188,    2 },
+  { 189,  188 },
+  { 190,  382 },
+  { 191,  193 },
+  { 192,    1 },
+  { 193,  308 },
+  { 194,  193 },
+  { 195,  192 },
+  { 196,  226 },
+  { 197,  196 },
+  { 198,  192 },
+  { 199,   28 },
+  { 200,  176 },
+  { 201,  200 },
+  { 202,  200 },
+  { 203, 1000 },
+  { 204,  205 },
+  { 205,  375 },
+  { 206,   20 },
+  { 207,   20 },
+  { 208,  176 },
+  { 209,  176 },
+  { 210,  182 },
+  { 211,  182 },
+  { 212,  208 },
+  { 212,  210 },
+  { 213,  208 },
+  { 213,  211 },
+  { 214,  210 },
+  { 215,  210 },
+  { 216,  210 },
+  { 217,  210 },
+  { 218,  210 },
+  { 219,  210 },
+  { 220,  210 },
+  { 221,  210 },
+  { 222,  221 },
+  { 223,  221 },
+  { 224,  210 },
+  { 225,  346 },
+  { 226,  360 },
+  { 227,  226 },
+  { 228,  227 },
+  { 229,  227 },
+  { 230,  227 },
+  { 231,    0 },
+  { 232, 1000 },
+  { 233,  210 },
+  { 234,    4 },
+  { 235, 1000 },
+  { 236,    0 },
+  { 237,  374 },
+  { 238,  237 },
+  { 239,  168 },
+  { 240,  236 },
+  { 241,  236 },
+  { 242,  241 },
+  { 243,  240 },
+  { 243,  404 },
+  { 244,  241 },
+  { 245,  240 },
+  { 246,  245 },
+  { 247,  240 },
+  { 248,  245 },
+  { 249,  248 },
+  { 250,  246 },
+  { 251,  246 },
+  { 252,  246 },
+  { 253,  240 },
+  { 254,    2 },
+  { 255, 1000 },
+  { 256, 1000 },
+  { 257,    2 },
+  { 258,    2 },
+  { 259,    2 },
+  { 260,  267 },
+  { 260,  270 },
+  { 261,  282 },
+  { 262,  458 },
+  { 263,  308 },
+  { 264,  263 },
+  { 265,  275 },
+  { 266,  442 },
+  { 267,  273 },
+  { 268,    1 },
+  { 269,  268 },
+  { 270,  430 },
+  { 271,  270 },
+  { 272,  188 },
+  { 273,  430 },
+  { 274,  273 },
+  { 274,  379 },
+  { 275,  430 },
+  { 276,  275 },
+  { 277,  276 },
+  { 278,  404 },
+  { 279,    2 },
+  { 280,  241 },
+  { 281,  193 },
+  { 282,  281 },
+  { 282,  309 },
+  { 283,  282 },
+  { 283,  310 },
+  { 284,  241 },
+  { 285,  240 },
+  { 286,  253 },
+  { 287,  193 },
+  { 288,  193 },
+  { 289,    3 },
+  { 290,  240 },
+  { 291,  240 },
+  { 292,   62 },
+  { 293,   62 },
+  { 294,   63 },
+  { 295,   63 },
+  { 296,  253 },
+  { 297,  296 },
+  { 298,  241 },
+  { 299,  241 },
+  { 300, 1000 },
+  { 301,   35 },
+  { 302,   36 },
+  { 303,  308 },
+  { 304,  303 },
+  { 305,  303 },
+  { 306,  303 },
+  { 306,  309 },
+  { 307,  306 },
+  { 307,  310 },
+  { 308,    2 },
+  { 309,  308 },
+  { 310,  309 },
+  { 311,  278 },
+  { 312,  278 },
+  { 313,  334 },
+  { 314,  334 },
+  { 315,  241 },
+  { 316,  334 },
+  { 317,  241 },
+  { 318,  334 },
+  { 319,  334 },
+  { 320,   25 },
+  { 321,   25 },
+  { 322,   27 },
+  { 323,   27 },
+  { 324,  186 },
+  { 324,  350 },
+  { 325,  186 },
+  { 325,  353 },
+  { 326,  269 },
+  { 327,  247 },
+  { 328,  247 },
+  { 329,  404 },
+  { 330,  211 },
+  { 331,    9 },
+  { 331,  346 },
+  { 332,  331 },
+  { 333,   49 },
+  { 334,  404 },
+  { 335,  354 },
+  { 336,   10 },
+  { 337,  281 },
+  { 338,   35 },
+  { 338,   38 },
+  { 339,   36 },
+  { 339,  341 },
+  { 340,   37 },
+  { 340,  341 },
+  { 341,  154 },
+  { 342,  375 },
+  { 343,  342 },
+  { 344,  342 },
+  { 345, 1000 },
+  { 346,    2 },
+  { 347,  346 },
+  { 348,    9 },
+  { 348,  346 },
+  { 349,   35 },
+  { 350,   48 },
+  { 352,   46 },
+  { 352,  156 },
+  { 353,  352 },
+  { 354,  240 },
+  { 355,   64 },
+  { 356,   35 },
+  { 357,  375 },
+  { 358,  375 },
+  { 359,  355 },
+  { 360,    2 },
+  { 361,  360 },
+  { 362,  359 },
+  { 363,  282 },
+  { 364,  188 },
+  { 365,  154 },
+  { 365,  160 },
+  { 366,  155 },
+  { 366,  160 },
+  { 367,  161 },
+  { 368,  161 },
+  { 369,  354 },
+  { 370,   27 },
+  { 371,  370 },
+  { 372,  370 },
+  { 373,   27 },
+  { 374,  231 },
+  { 375,  231 },
+  { 376,  178 },
+  { 377,  176 },
+  { 378,  270 },
+  { 379,  430 },
+  { 380,    2 },
+  { 381,  380 },
+  { 382,  380 },
+  { 383,  381 },
+  { 384,  381 },
+  { 385,  381 },
+  { 386,  378 },
+  { 387,  270 },
+  { 388,  378 },
+  { 389,    2 },
+  { 390,  389 },
+  { 391,   64 },
+  { 392,  374 },
+  { 393,  168 },
+  { 394,  168 },
+  { 395,  375 },
+  { 396,  375 },
+  { 397,  375 },
+  { 398,  374 },
+  { 399,  211 },
+  { 400,  211 },
+  { 401,  211 },
+  { 402,  182 },
+  { 403,  402 },
+  { 404,  241 },
+  { 405,  240 },
+  { 406,  240 },
+  { 407,  169 },
+  { 408, 1000 },
+  { 409,  236 },
+  { 410,  290 },
+  { 411,  170 },
+  { 412,  231 },
+  { 413,  374 },
+  { 414,  413 },
+  { 415,  413 },
+  { 416,  390 },
+  { 417,  390 },
+  { 418,  286 },
+  { 419,  286 },
+  { 420,  286 },
+  { 420,  296 },
+  { 421,  286 },
+  { 422,  261 },
+  { 423,  194 },
+  { 424,  194 },
+  { 425,  268 },
+  { 426,  425 },
+  { 427,  426 },
+  { 428,  426 },
+  { 429,  268 },
+  { 430,  269 },
+  { 431,  425 },
+  { 432,  429 },
+  { 433,  429 },
+  { 434,  429 },
+  { 435,  429 },
+  { 436,  429 },
+  { 437,  326 },
+  { 438,  326 },
+  { 439,  326 },
+  { 440,  430 },
+  { 441,  275 },
+  { 442,  265 },
+  { 443,  430 },
+  { 444,  443 },
+  { 445,  444 },
+  { 446,  444 },
+  { 447,  444 },
+  { 448,  444 },
+  { 449,  447 },
+  { 450,  448 },
+  { 451,  430 },
+  { 452,  451 },
+  { 453,  451 },
+  { 454,  430 },
+  { 455,  454 },
+  { 456,  430 },
+  { 457,  456 },
+  { 458,  430 },
+  { 459,   19 },
+  { 460,   13 },
+  { 461,  459 },
+  { 462,  459 },
+  { 463,  303 },
+  { 464,  375 },
+  { 465,    2 },
+  { 466,  465 },
+  { 467,  465 },
+  { 468,  465 },
+  { 469,  413 },
+  { 470,  540 },
+  { 471,  196 },
+  { 472,  196 },
+  { 473,  552 },
+  { 474,   64 },
+  { 475,  474 },
+  { 476,  347 },
+  { 477,  346 },
+  { 478,  193 },
+  { 479,  478 },
+  { 480,  478 },
+  { 481,  380 },
+  { 482,    9 },
+  { 483, 1000 },
+  { 484, 1000 },
+  { 485,   46 },
+  { 486,  381 },
+  { 487,  474 },
+  { 488,  487 },
+  { 489,  487 },
+  { 490,  188 },
+  { 491,    9 },
+  { 492,    2 },
+  { 493,  241 },
+  { 494,  493 },
+  { 495,  493 },
+  { 496,  493 },
+  { 497,  389 },
+  { 498,  381 },
+  { 499, 1000 },
+  { 500,  343 },
+  { 501,  343 },
+  { 502,  343 },
+  { 503,  361 },
+  { 504,  361 },
+  { 505,  518 },
+  { 506,  504 },
+  { 507,  517 },
+  { 508,  503 },
+  { 509,  196 },
+  { 510,  504 },
+  { 511,  503 },
+  { 512,  196 },
+  { 513,  504 },
+  { 514,  508 },
+  { 515,  509 },
+  { 516,  510 },
+  { 517,  503 },
+  { 518,  196 },
+  { 519,  504 },
+  { 520,  517 },
+  { 521,  518 },
+  { 522,  519 },
+  { 523,  517 },
+  { 524,  518 },
+  { 525,  519 },
+  { 526,  344 },
+  { 527,    1 },
+  { 528,  527 },
+  { 529,  527 },
+  { 530,  527 },
+  { 531,  527 },
+  { 532,  527 },
+  { 533,  461 },
+  { 534,  461 },
+  { 535,  461 },
+  { 536,  207 },
+  { 537,  207 },
+  { 538,    2 },
+  { 539,    2 },
+  { 540,  360 },
+  { 541,  540 },
+  { 542,    2 },
+  { 543,  296 },
+  { 544,    0 },
+  { 545,    0 },
+  { 546,  545 },
+  { 547,  234 },
+  { 548,  547 },
+  { 549,  547 },
+  { 550,  544 },
+  { 551,  555 },
+  { 552,  550 },
+  { 553,  552 },
+  { 554,  552 },
+  { 555,  557 },
+  { 556,  557 },
+  { 557,  550 },
+  { 558,    2 },
+  { 559,    2 },
+  { 560,  163 },
+  { 561,  166 },
+  { 562,   45 },
+  { 563,  562 },
+  { 564,  562 },
+  { 565,  545 },
+  { 566,  538 },
+  { 567,  565 },
+  { 568,  565 },
+  { 569,  391 },
+  { 570,  569 },
+  { 571,    2 },
+  { 572,  571 },
+  { 573,  572 },
+  { 574,  573 },
+  { 575,  573 },
+  { 576,  571 },
+  { 577,  576 },
+  { 578,  577 },
+  { 579,  577 },
+  { 580,  571 },
+  { 581,  580 },
+  { 582,  581 },
+  { 583,  581 },
+  { 584,  346 },
+  { 585,  347 },
+  { 586,  346 },
+  { 587,  185 },
+  { 588,  185 },
+  { 589,  205 },
+  { 590,  369 },
+  { 591,  464 },
+  { 592,  361 },
+  { 593,  592 },
+  { 594,    3 },
+  { 595,   19 },
+  { 596,   19 },
+  { 597,   20 },
+  { 598, 1000 },
+  { 599,  473 },
+  { 600,  599 },
+  { 601,  599 },
+  { 602,  546 },
+  { 603,   11 },
+  { 604,   15 },
+  { 605,  244 },
+  { 606,  244 },
+  { 607,  296 },
+  { 608,  607 },
+  { 609,  607 },
+  { 610,    2 },
+  { 611,    9 },
+  { 612,  613 },
+  { 613,    2 },
+  { 614,  612 },
+  { 615,  612 },
+  { 616,  613 },
+  { 617,  581 },
+  { 618,  581 },
+  { 619,  580 },
+  { 620,  619 },
+  { 621,  619 },
+  { 622,  619 },
+  { 623,    2 },
+  { 624,    4 },
+  { 625,  613 },
+  { 626,  625 },
+  { 627,  631 },
+  { 628,  631 },
+  { 629,  395 },
+  { 630,  395 },
+  { 631,  375 },
+  { 632,  631 },
+  { 633,  473 },
+  { 634,  354 },
+  { 635,  354 },
+  { 636,   21 },
+  { 637,   21 },
+  { 638,   20 },
+  { 639,   20 },
+  { 640,   20 },
+  { 641,  303 },
+  { 642,  644 },
+  { 643,  644 },
+  { 644,    3 },
+  { 645,    3 },
+  { 646,   42 },
+  { 647,    2 },
+  { 648,  647 },
+  { 649,  241 },
+  { 650,  375 },
+  { 651,  375 },
+  { 652,  182 },
+  { 653,  182 },
+  { 654,  655 },
+  { 655,  167 },
+  { 656,  182 },
+  { 657,  655 },
+  { 658,  655 },
+  { 659,  654 },
+  { 660,  654 },
+  { 661,    2 },
+  { 662,    2 },
+  { 663,  545 },
+  { 664,    3 },
+  { 665,  182 },
+  { 666,    2 },
+  { 667,  666 },
+  { 668,  241 },
+  { 669,  668 },
+  { 670,  668 },
+  { 671,   13 },
+};
+
+
+/*
+ * The transitive closure of SBO_PARENTS: one row of bits per term, with a
+ * column for every term that is the parent of some term.  Built once, on
+ * first use, after which it is only read, so any number of threads can
+ * query it at the same time.
+ */
+class SBOAncestry
+{
+public:
+
+  SBOAncestry()
+    : mNumTerms(0)
+    , mNumWords(0)
+  {
+    const size_t numPairs = sizeof(SBO_PARENTS) / sizeof(SBO_PARENTS[0]);
+
+    unsigned int numColumns = 0;
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      unsigned int largest = max(SBO_PARENTS[i][0], SBO_PARENTS[i][1]);
+      if (largest >= mNumTerms)
+      {
+        mNumTerms = largest + 1;
+        mColumn.resize(mNumTerms, -1);
+      }
+      if (mColumn[SBO_PARENTS[i][1]] < 0)
+      {
+        mColumn[SBO_PARENTS[i][1]] = (int)numColumns++;
+      }
+    }
+
+    mNumWords = (numColumns + WORD_BITS - 1) / WORD_BITS;
+    mBits.resize((size_t)mNumTerms * mNumWords, 0);
+
+    // the parents of each term, in a compressed row layout
+    vector<size_t> first(mNumTerms + 1, 0);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      first[SBO_PARENTS[i][0] + 1]++;
+    }
+    for (unsigned int t = 0; t < mNumTerms; t++)
+    {
+      first[t + 1] += first[t];
+    }
+    vector<unsigned int> parents(numPairs);
+    vector<size_t> next(first.begin(), first.end() - 1);
+    for (size_t i = 0; i < numPairs; i++)
+    {
+      parents[next[SBO_PARENTS[i][0]]++] = SBO_PARENTS[i][1];
+    }
+
+    vector<char> state(mNumTerms, 0);
+    for (unsigned int t = 0; t < mNumTerms; t++)
+    {
+      addAncestors(t, first, parents, state);
+    }
+  }
+
+
+  bool isChildOf(unsigned int term, unsigned int parent) const
+  {
+    if (term >= mNumTerms || parent >= mNumTerms || mColumn[parent] < 0)
+    {
+      return false;
+    }
+
+    unsigned int column = (unsigned int)mColumn[parent];
+    return ((mBits[(size_t)term * mNumWords + column / WORD_BITS] 
+             >> (column % WORD_BITS)) & 1u) != 0;
+  }
+
+
+private:
+
+  enum { WORD_BITS = 32 };
+
+  /*
+   * Fills the row of term from the rows of its parents, filling those
+   * first.  The state of a term is 0 before, 1 during and 2 after this; a
+   * cycle (which SBO does not have) is cut where it is found.
+   */
+  void addAncestors(unsigned int term, const vector<size_t>& first,
+                    const vector<unsigned int>& parents, vector<char>& state)
+  {
+    if (state[term] != 0) return;
+    state[term] = 1;
+
+    unsigned int* row = &mBits[(size_t)term * mNumWords];
+    for (size_t i = first[term]; i < first[term + 1]; i++)
+    {
+      unsigned int parent = parents[i];
+      unsigned int column = (unsigned int)mColumn[parent];
+      row[column / WORD_BITS] |= 1u << (column % WORD_BITS);
+
+      addAncestors(parent, first, parents, state);
+      const unsigned int* parentRow = &mBits[(size_t)parent * mNumWords];
+      for (unsigned int w = 0; w < mNumWords; w++)
+      {
+        row[w] |= parentRow[w];
+      }
+    }
+
+    state[term] = 2;
+  }
+
+
+  unsigned int mNumTerms;
+  unsigned int mNumWords;
+  vector<int> mColumn;
+  vector<unsigned int> mBits;
+};
+
+
+/*
+ * Returns the ancestry of SBO terms, building it on the first call; the
+ * initialization of the local static is thread safe.
+ */
+static const SBOAncestry&
+getSBOAncestry()
+{
+  static const SBOAncestry ancestry;
+  return ancestry;
+}
+
+
 /**
   * functions for checking the SBO term is from correct part of SBO
-  * populates the parent-child map
+  * returns true if the term is-a parent, false otherwise
+  */
+bool
+SBO::isChildOf(unsigned int term, unsigned int parent)
+{
+  return getSBOAncestry().isChildOf(term, parent);
+}
+
+
+/**
+  * functions for checking the SBO term is from correct part of SBO
+  * builds the table of ancestors, if that has not been done yet
   */
 void
 SBO::populateSBOTree()
 {
-  // generated from SBO on 2020/11/14
-	mParent.insert(pair<const int, int>(1, 64));
-	mParent.insert(pair<const int, int>(2, 545));
-	mParent.insert(pair<const int, int>(3, 0));
-	mParent.insert(pair<const int, int>(4, 0));
-	mParent.insert(pair<const int, int>(5, 1000));
-	mParent.insert(pair<const int, int>(6, 1000));
-	mParent.insert(pair<const int, int>(7, 1000));
-	mParent.insert(pair<const int, int>(8, 1000));
-	mParent.insert(pair<const int, int>(9, 2));
-	mParent.insert(pair<const int, int>(10, 3));
-	mParent.insert(pair<const int, int>(11, 3));
-	mParent.insert(pair<const int, int>(12, 1));
-	mParent.insert(pair<const int, int>(13, 459));
-	mParent.insert(pair<const int, int>(14, 241));
-	mParent.insert(pair<const int, int>(15, 10));
-	mParent.insert(pair<const int, int>(16, 9));
-	mParent.insert(pair<const int, int>(17, 9));
-	mParent.insert(pair<const int, int>(18, 9));
-	mParent.insert(pair<const int, int>(19, 3));
-	mParent.insert(pair<const int, int>(20, 19));
-	mParent.insert(pair<const int, int>(21, 459));
-	mParent.insert(pair<const int, int>(22, 16));
-	mParent.insert(pair<const int, int>(22, 153));
-	mParent.insert(pair<const int, int>(23, 17));
-	mParent.insert(pair<const int, int>(23, 153));
-	mParent.insert(pair<const int, int>(24, 18));
-	mParent.insert(pair<const int, int>(24, 153));
-	mParent.insert(pair<const int, int>(25, 35));
-	mParent.insert(pair<const int, int>(26, 1000));
-	mParent.insert(pair<const int, int>(27, 193));
-	mParent.insert(pair<const int, int>(28, 150));
-	mParent.insert(pair<const int, int>(28, 326));
-	mParent.insert(pair<const int, int>(29, 28));
-	mParent.insert(pair<const int, int>(30, 28));
-	mParent.insert(pair<const int, int>(31, 28));
-	mParent.insert(pair<const int, int>(32, 16));
-	mParent.insert(pair<const int, int>(32, 156));
-	mParent.insert(pair<const int, int>(33, 17));
-	mParent.insert(pair<const int, int>(33, 156));
-	mParent.insert(pair<const int, int>(34, 18));
-	mParent.insert(pair<const int, int>(34, 156));
-	mParent.insert(pair<const int, int>(35, 22));
-	mParent.insert(pair<const int, int>(35, 154));
-	mParent.insert(pair<const int, int>(36, 23));
-	mParent.insert(pair<const int, int>(36, 154));
-	mParent.insert(pair<const int, int>(37, 24));
-	mParent.insert(pair<const int, int>(37, 154));
-	mParent.insert(pair<const int, int>(38, 32));
-	mParent.insert(pair<const int, int>(39, 33));
-	mParent.insert(pair<const int, int>(40, 34));
-	mParent.insert(pair<const int, int>(41, 12));
-	mParent.insert(pair<const int, int>(42, 12));
-	mParent.insert(pair<const int, int>(43, 41));
-	mParent.insert(pair<const int, int>(44, 41));
-	mParent.insert(pair<const int, int>(45, 41));
-	mParent.insert(pair<const int, int>(46, 9));
-	mParent.insert(pair<const int, int>(47, 43));
-	mParent.insert(pair<const int, int>(47, 163));
-	mParent.insert(pair<const int, int>(48, 154));
-	mParent.insert(pair<const int, int>(48, 162));
-	mParent.insert(pair<const int, int>(49, 44));
-	mParent.insert(pair<const int, int>(49, 163));
-	mParent.insert(pair<const int, int>(50, 45));
-	mParent.insert(pair<const int, int>(51, 1000));
-	mParent.insert(pair<const int, int>(52, 50));
-	mParent.insert(pair<const int, int>(52, 163));
-	mParent.insert(pair<const int, int>(53, 45));
-	mParent.insert(pair<const int, int>(54, 53));
-	mParent.insert(pair<const int, int>(54, 163));
-	mParent.insert(pair<const int, int>(55, 41));
-	mParent.insert(pair<const int, int>(56, 55));
-	mParent.insert(pair<const int, int>(57, 56));
-	mParent.insert(pair<const int, int>(57, 163));
-	mParent.insert(pair<const int, int>(58, 55));
-	mParent.insert(pair<const int, int>(59, 58));
-	mParent.insert(pair<const int, int>(59, 163));
-	mParent.insert(pair<const int, int>(60, 55));
-	mParent.insert(pair<const int, int>(61, 60));
-	mParent.insert(pair<const int, int>(61, 163));
-	mParent.insert(pair<const int, int>(62, 4));
-	mParent.insert(pair<const int, int>(63, 4));
-	mParent.insert(pair<const int, int>(64, 0));
-	mParent.insert(pair<const int, int>(65, 155));
-	mParent.insert(pair<const int, int>(65, 162));
-	mParent.insert(pair<const int, int>(66, 22));
-	mParent.insert(pair<const int, int>(66, 155));
-	mParent.insert(pair<const int, int>(67, 23));
-	mParent.insert(pair<const int, int>(67, 155));
-	mParent.insert(pair<const int, int>(68, 24));
-	mParent.insert(pair<const int, int>(68, 155));
-	mParent.insert(pair<const int, int>(69, 42));
-	mParent.insert(pair<const int, int>(70, 69));
-	mParent.insert(pair<const int, int>(71, 69));
-	mParent.insert(pair<const int, int>(72, 71));
-	mParent.insert(pair<const int, int>(73, 71));
-	mParent.insert(pair<const int, int>(74, 69));
-	mParent.insert(pair<const int, int>(75, 74));
-	mParent.insert(pair<const int, int>(76, 74));
-	mParent.insert(pair<const int, int>(77, 74));
-	mParent.insert(pair<const int, int>(78, 42));
-	mParent.insert(pair<const int, int>(79, 78));
-	mParent.insert(pair<const int, int>(80, 78));
-	mParent.insert(pair<const int, int>(81, 78));
-	mParent.insert(pair<const int, int>(82, 81));
-	mParent.insert(pair<const int, int>(83, 81));
-	mParent.insert(pair<const int, int>(84, 78));
-	mParent.insert(pair<const int, int>(85, 84));
-	mParent.insert(pair<const int, int>(86, 84));
-	mParent.insert(pair<const int, int>(87, 84));
-	mParent.insert(pair<const int, int>(88, 42));
-	mParent.insert(pair<const int, int>(89, 88));
-	mParent.insert(pair<const int, int>(90, 89));
-	mParent.insert(pair<const int, int>(91, 89));
-	mParent.insert(pair<const int, int>(92, 89));
-	mParent.insert(pair<const int, int>(93, 92));
-	mParent.insert(pair<const int, int>(94, 92));
-	mParent.insert(pair<const int, int>(95, 89));
-	mParent.insert(pair<const int, int>(96, 95));
-	mParent.insert(pair<const int, int>(97, 95));
-	mParent.insert(pair<const int, int>(98, 95));
-	mParent.insert(pair<const int, int>(99, 88));
-	mParent.insert(pair<const int, int>(100, 99));
-	mParent.insert(pair<const int, int>(101, 99));
-	mParent.insert(pair<const int, int>(102, 99));
-	mParent.insert(pair<const int, int>(103, 102));
-	mParent.insert(pair<const int, int>(104, 102));
-	mParent.insert(pair<const int, int>(105, 99));
-	mParent.insert(pair<const int, int>(106, 105));
-	mParent.insert(pair<const int, int>(107, 105));
-	mParent.insert(pair<const int, int>(108, 105));
-	mParent.insert(pair<const int, int>(109, 42));
-	mParent.insert(pair<const int, int>(110, 109));
-	mParent.insert(pair<const int, int>(111, 110));
-	mParent.insert(pair<const int, int>(112, 110));
-	mParent.insert(pair<const int, int>(113, 110));
-	mParent.insert(pair<const int, int>(114, 113));
-	mParent.insert(pair<const int, int>(115, 113));
-	mParent.insert(pair<const int, int>(116, 110));
-	mParent.insert(pair<const int, int>(117, 116));
-	mParent.insert(pair<const int, int>(118, 116));
-	mParent.insert(pair<const int, int>(119, 116));
-	mParent.insert(pair<const int, int>(120, 109));
-	mParent.insert(pair<const int, int>(121, 120));
-	mParent.insert(pair<const int, int>(122, 120));
-	mParent.insert(pair<const int, int>(123, 120));
-	mParent.insert(pair<const int, int>(124, 123));
-	mParent.insert(pair<const int, int>(125, 123));
-	mParent.insert(pair<const int, int>(126, 120));
-	mParent.insert(pair<const int, int>(127, 126));
-	mParent.insert(pair<const int, int>(128, 126));
-	mParent.insert(pair<const int, int>(129, 126));
-	mParent.insert(pair<const int, int>(130, 109));
-	mParent.insert(pair<const int, int>(131, 130));
-	mParent.insert(pair<const int, int>(132, 130));
-	mParent.insert(pair<const int, int>(133, 130));
-	mParent.insert(pair<const int, int>(134, 133));
-	mParent.insert(pair<const int, int>(135, 133));
-	mParent.insert(pair<const int, int>(136, 130));
-	mParent.insert(pair<const int, int>(137, 136));
-	mParent.insert(pair<const int, int>(138, 136));
-	mParent.insert(pair<const int, int>(139, 136));
-	mParent.insert(pair<const int, int>(140, 43));
-	mParent.insert(pair<const int, int>(140, 166));
-	mParent.insert(pair<const int, int>(141, 44));
-	mParent.insert(pair<const int, int>(141, 166));
-	mParent.insert(pair<const int, int>(142, 50));
-	mParent.insert(pair<const int, int>(142, 166));
-	mParent.insert(pair<const int, int>(143, 53));
-	mParent.insert(pair<const int, int>(143, 166));
-	mParent.insert(pair<const int, int>(144, 56));
-	mParent.insert(pair<const int, int>(144, 166));
-	mParent.insert(pair<const int, int>(145, 58));
-	mParent.insert(pair<const int, int>(145, 166));
-	mParent.insert(pair<const int, int>(146, 60));
-	mParent.insert(pair<const int, int>(146, 166));
-	mParent.insert(pair<const int, int>(147, 2));
-	mParent.insert(pair<const int, int>(148, 2));
-	mParent.insert(pair<const int, int>(149, 157));
-	mParent.insert(pair<const int, int>(150, 268));
-	mParent.insert(pair<const int, int>(151, 150));
-	mParent.insert(pair<const int, int>(152, 150));
-	mParent.insert(pair<const int, int>(153, 9));
-	mParent.insert(pair<const int, int>(154, 153));
-	mParent.insert(pair<const int, int>(155, 153));
-	mParent.insert(pair<const int, int>(156, 9));
-	mParent.insert(pair<const int, int>(157, 188));
-	mParent.insert(pair<const int, int>(158, 382));
-	mParent.insert(pair<const int, int>(159, 9));
-	mParent.insert(pair<const int, int>(160, 153));
-	mParent.insert(pair<const int, int>(160, 159));
-	mParent.insert(pair<const int, int>(161, 156));
-	mParent.insert(pair<const int, int>(161, 159));
-	mParent.insert(pair<const int, int>(162, 46));
-	mParent.insert(pair<const int, int>(162, 153));
-	mParent.insert(pair<const int, int>(163, 41));
-	mParent.insert(pair<const int, int>(164, 1000));
-	mParent.insert(pair<const int, int>(165, 1000));
-	mParent.insert(pair<const int, int>(166, 41));
-	mParent.insert(pair<const int, int>(167, 375));
-	mParent.insert(pair<const int, int>(168, 374));
-	mParent.insert(pair<const int, int>(169, 168));
-	mParent.insert(pair<const int, int>(170, 168));
-	mParent.insert(pair<const int, int>(171, 170));
-	mParent.insert(pair<const int, int>(172, 170));
-	mParent.insert(pair<const int, int>(173, 237));
-	mParent.insert(pair<const int, int>(174, 237));
-	mParent.insert(pair<const int, int>(175, 237));
-	mParent.insert(pair<const int, int>(176, 167));
-	mParent.insert(pair<const int, int>(177, 176));
-	mParent.insert(pair<const int, int>(178, 182));
-	mParent.insert(pair<const int, int>(179, 176));
-	mParent.insert(pair<const int, int>(180, 176));
-	mParent.insert(pair<const int, int>(181, 176));
-	mParent.insert(pair<const int, int>(182, 176));
-	mParent.insert(pair<const int, int>(183, 205));
-	mParent.insert(pair<const int, int>(184, 205));
-	mParent.insert(pair<const int, int>(185, 167));
-	mParent.insert(pair<const int, int>(186, 46));
-	mParent.insert(pair<const int, int>(187, 1000));
-	mParent.insert(pair<const int, int>(188, 2));
-	mParent.insert(pair<const int, int>(189, 188));
-	mParent.insert(pair<const int, int>(190, 382));
-	mParent.insert(pair<const int, int>(191, 193));
-	mParent.insert(pair<const int, int>(192, 1));
-	mParent.insert(pair<const int, int>(193, 308));
-	mParent.insert(pair<const int, int>(194, 193));
-	mParent.insert(pair<const int, int>(195, 192));
-	mParent.insert(pair<const int, int>(196, 226));
-	mParent.insert(pair<const int, int>(197, 196));
-	mParent.insert(pair<const int, int>(198, 192));
-	mParent.insert(pair<const int, int>(199, 28));
-	mParent.insert(pair<const int, int>(200, 176));
-	mParent.insert(pair<const int, int>(201, 200));
-	mParent.insert(pair<const int, int>(202, 200));
-	mParent.insert(pair<const int, int>(203, 1000));
-	mParent.insert(pair<const int, int>(204, 205));
-	mParent.insert(pair<const int, int>(205, 375));
-	mParent.insert(pair<const int, int>(206, 20));
-	mParent.insert(pair<const int, int>(207, 20));
-	mParent.insert(pair<const int, int>(208, 176));
-	mParent.insert(pair<const int, int>(209, 176));
-	mParent.insert(pair<const int, int>(210, 182));
-	mParent.insert(pair<const int, int>(211, 182));
-	mParent.insert(pair<const int, int>(212, 208));
-	mParent.insert(pair<const int, int>(212, 210));
-	mParent.insert(pair<const int, int>(213, 208));
-	mParent.insert(pair<const int, int>(213, 211));
-	mParent.insert(pair<const int, int>(214, 210));
-	mParent.insert(pair<const int, int>(215, 210));
-	mParent.insert(pair<const int, int>(216, 210));
-	mParent.insert(pair<const int, int>(217, 210));
-	mParent.insert(pair<const int, int>(218, 210));
-	mParent.insert(pair<const int, int>(219, 210));
-	mParent.insert(pair<const int, int>(220, 210));
-	mParent.insert(pair<const int, int>(221, 210));
-	mParent.insert(pair<const int, int>(222, 221));
-	mParent.insert(pair<const int, int>(223, 221));
-	mParent.insert(pair<const int, int>(224, 210));
-	mParent.insert(pair<const int, int>(225, 346));
-	mParent.insert(pair<const int, int>(226, 360));
-	mParent.insert(pair<const int, int>(227, 226));
-	mParent.insert(pair<const int, int>(228, 227));
-	mParent.insert(pair<const int, int>(229, 227));
-	mParent.insert(pair<const int, int>(230, 227));
-	mParent.insert(pair<const int, int>(231, 0));
-	mParent.insert(pair<const int, int>(232, 1000));
-	mParent.insert(pair<const int, int>(233, 210));
-	mParent.insert(pair<const int, int>(234, 4));
-	mParent.insert(pair<const int, int>(235, 1000));
-	mParent.insert(pair<const int, int>(236, 0));
-	mParent.insert(pair<const int, int>(237, 374));
-	mParent.insert(pair<const int, int>(238, 237));
-	mParent.insert(pair<const int, int>(239, 168));
-	mParent.insert(pair<const int, int>(240, 236));
-	mParent.insert(pair<const int, int>(241, 236));
-	mParent.insert(pair<const int, int>(242, 241));
-	mParent.insert(pair<const int, int>(243, 240));
-	mParent.insert(pair<const int, int>(243, 404));
-	mParent.insert(pair<const int, int>(244, 241));
-	mParent.insert(pair<const int, int>(245, 240));
-	mParent.insert(pair<const int, int>(246, 245));
-	mParent.insert(pair<const int, int>(247, 240));
-	mParent.insert(pair<const int, int>(248, 245));
-	mParent.insert(pair<const int, int>(249, 248));
-	mParent.insert(pair<const int, int>(250, 246));
-	mParent.insert(pair<const int, int>(251, 246));
-	mParent.insert(pair<const int, int>(252, 246));
-	mParent.insert(pair<const int, int>(253, 240));
-	mParent.insert(pair<const int, int>(254, 2));
-	mParent.insert(pair<const int, int>(255, 1000));
-	mParent.insert(pair<const int, int>(256, 1000));
-	mParent.insert(pair<const int, int>(257, 2));
-	mParent.insert(pair<const int, int>(258, 2));
-	mParent.insert(pair<const int, int>(259, 2));
-	mParent.insert(pair<const int, int>(260, 267));
-	mParent.insert(pair<const int, int>(260, 270));
-	mParent.insert(pair<const int, int>(261, 282));
-	mParent.insert(pair<const int, int>(262, 458));
-	mParent.insert(pair<const int, int>(263, 308));
-	mParent.insert(pair<const int, int>(264, 263));
-	mParent.insert(pair<const int, int>(265, 275));
-	mParent.insert(pair<const int, int>(266, 442));
-	mParent.insert(pair<const int, int>(267, 273));
-	mParent.insert(pair<const int, int>(268, 1));
-	mParent.insert(pair<const int, int>(269, 268));
-	mParent.insert(pair<const int, int>(270, 430));
-	mParent.insert(pair<const int, int>(271, 270));
-	mParent.insert(pair<const int, int>(272, 188));
-	mParent.insert(pair<const int, int>(273, 430));
-	mParent.insert(pair<const int, int>(274, 273));
-	mParent.insert(pair<const int, int>(274, 379));
-	mParent.insert(pair<const int, int>(275, 430));
-	mParent.insert(pair<const int, int>(276, 275));
-	mParent.insert(pair<const int, int>(277, 276));
-	mParent.insert(pair<const int, int>(278, 404));
-	mParent.insert(pair<const int, int>(279, 2));
-	mParent.insert(pair<const int, int>(280, 241));
-	mParent.insert(pair<const int, int>(281, 193));
-	mParent.insert(pair<const int, int>(282, 281));
-	mParent.insert(pair<const int, int>(282, 309));
-	mParent.insert(pair<const int, int>(283, 282));
-	mParent.insert(pair<const int, int>(283, 310));
-	mParent.insert(pair<const int, int>(284, 241));
-	mParent.insert(pair<const int, int>(285, 240));
-	mParent.insert(pair<const int, int>(286, 253));
-	mParent.insert(pair<const int, int>(287, 193));
-	mParent.insert(pair<const int, int>(288, 193));
-	mParent.insert(pair<const int, int>(289, 3));
-	mParent.insert(pair<const int, int>(290, 240));
-	mParent.insert(pair<const int, int>(291, 240));
-	mParent.insert(pair<const int, int>(292, 62));
-	mParent.insert(pair<const int, int>(293, 62));
-	mParent.insert(pair<const int, int>(294, 63));
-	mParent.insert(pair<const int, int>(295, 63));
-	mParent.insert(pair<const int, int>(296, 253));
-	mParent.insert(pair<const int, int>(297, 296));
-	mParent.insert(pair<const int, int>(298, 241));
-	mParent.insert(pair<const int, int>(299, 241));
-	mParent.insert(pair<const int, int>(300, 1000));
-	mParent.insert(pair<const int, int>(301, 35));
-	mParent.insert(pair<const int, int>(302, 36));
-	mParent.insert(pair<const int, int>(303, 308));
-	mParent.insert(pair<const int, int>(304, 303));
-	mParent.insert(pair<const int, int>(305, 303));
-	mParent.insert(pair<const int, int>(306, 303));
-	mParent.insert(pair<const int, int>(306, 309));
-	mParent.insert(pair<const int, int>(307, 306));
-	mParent.insert(pair<const int, int>(307, 310));
-	mParent.insert(pair<const int, int>(308, 2));
-	mParent.insert(pair<const int, int>(309, 308));
-	mParent.insert(pair<const int, int>(310, 309));
-	mParent.insert(pair<const int, int>(311, 278));
-	mParent.insert(pair<const int, int>(312, 278));
-	mParent.insert(pair<const int, int>(313, 334));
-	mParent.insert(pair<const int, int>(314, 334));
-	mParent.insert(pair<const int, int>(315, 241));
-	mParent.insert(pair<const int, int>(316, 334));
-	mParent.insert(pair<const int, int>(317, 241));
-	mParent.insert(pair<const int, int>(318, 334));
-	mParent.insert(pair<const int, int>(319, 334));
-	mParent.insert(pair<const int, int>(320, 25));
-	mParent.insert(pair<const int, int>(321, 25));
-	mParent.insert(pair<const int, int>(322, 27));
-	mParent.insert(pair<const int, int>(323, 27));
-	mParent.insert(pair<const int, int>(324, 186));
-	mParent.insert(pair<const int, int>(324, 350));
-	mParent.insert(pair<const int, int>(325, 186));
-	mParent.insert(pair<const int, int>(325, 353));
-	mParent.insert(pair<const int, int>(326, 269));
-	mParent.insert(pair<const int, int>(327, 247));
-	mParent.insert(pair<const int, int>(328, 247));
-	mParent.insert(pair<const int, int>(329, 404));
-	mParent.insert(pair<const int, int>(330, 211));
-	mParent.insert(pair<const int, int>(331, 9));
-	mParent.insert(pair<const int, int>(331, 346));
-	mParent.insert(pair<const int, int>(332, 331));
-	mParent.insert(pair<const int, int>(333, 49));
-	mParent.insert(pair<const int, int>(334, 404));
-	mParent.insert(pair<const int, int>(335, 354));
-	mParent.insert(pair<const int, int>(336, 10));
-	mParent.insert(pair<const int, int>(337, 281));
-	mParent.insert(pair<const int, int>(338, 35));
-	mParent.insert(pair<const int, int>(338, 38));
-	mParent.insert(pair<const int, int>(339, 36));
-	mParent.insert(pair<const int, int>(339, 341));
-	mParent.insert(pair<const int, int>(340, 37));
-	mParent.insert(pair<const int, int>(340, 341));
-	mParent.insert(pair<const int, int>(341, 154));
-	mParent.insert(pair<const int, int>(342, 375));
-	mParent.insert(pair<const int, int>(343, 342));
-	mParent.insert(pair<const int, int>(344, 342));
-	mParent.insert(pair<const int, int>(345, 1000));
-	mParent.insert(pair<const int, int>(346, 2));
-	mParent.insert(pair<const int, int>(347, 346));
-	mParent.insert(pair<const int, int>(348, 9));
-	mParent.insert(pair<const int, int>(348, 346));
-	mParent.insert(pair<const int, int>(349, 35));
-	mParent.insert(pair<const int, int>(350, 48));
-	mParent.insert(pair<const int, int>(352, 46));
-	mParent.insert(pair<const int, int>(352, 156));
-	mParent.insert(pair<const int, int>(353, 352));
-	mParent.insert(pair<const int, int>(354, 240));
-	mParent.insert(pair<const int, int>(355, 64));
-	mParent.insert(pair<const int, int>(356, 35));
-	mParent.insert(pair<const int, int>(357, 375));
-	mParent.insert(pair<const int, int>(358, 375));
-	mParent.insert(pair<const int, int>(359, 355));
-	mParent.insert(pair<const int, int>(360, 2));
-	mParent.insert(pair<const int, int>(361, 360));
-	mParent.insert(pair<const int, int>(362, 359));
-	mParent.insert(pair<const int, int>(363, 282));
-	mParent.insert(pair<const int, int>(364, 188));
-	mParent.insert(pair<const int, int>(365, 154));
-	mParent.insert(pair<const int, int>(365, 160));
-	mParent.insert(pair<const int, int>(366, 155));
-	mParent.insert(pair<const int, int>(366, 160));
-	mParent.insert(pair<const int, int>(367, 161));
-	mParent.insert(pair<const int, int>(368, 161));
-	mParent.insert(pair<const int, int>(369, 354));
-	mParent.insert(pair<const int, int>(370, 27));
-	mParent.insert(pair<const int, int>(371, 370));
-	mParent.insert(pair<const int, int>(372, 370));
-	mParent.insert(pair<const int, int>(373, 27));
-	mParent.insert(pair<const int, int>(374, 231));
-	mParent.insert(pair<const int, int>(375, 231));
-	mParent.insert(pair<const int, int>(376, 178));
-	mParent.insert(pair<const int, int>(377, 176));
-	mParent.insert(pair<const int, int>(378, 270));
-	mParent.insert(pair<const int, int>(379, 430));
-	mParent.insert(pair<const int, int>(380, 2));
-	mParent.insert(pair<const int, int>(381, 380));
-	mParent.insert(pair<const int, int>(382, 380));
-	mParent.insert(pair<const int, int>(383, 381));
-	mParent.insert(pair<const int, int>(384, 381));
-	mParent.insert(pair<const int, int>(385, 381));
-	mParent.insert(pair<const int, int>(386, 378));
-	mParent.insert(pair<const int, int>(387, 270));
-	mParent.insert(pair<const int, int>(388, 378));
-	mParent.insert(pair<const int, int>(389, 2));
-	mParent.insert(pair<const int, int>(390, 389));
-	mParent.insert(pair<const int, int>(391, 64));
-	mParent.insert(pair<const int, int>(392, 374));
-	mParent.insert(pair<const int, int>(393, 168));
-	mParent.insert(pair<const int, int>(394, 168));
-	mParent.insert(pair<const int, int>(395, 375));
-	mParent.insert(pair<const int, int>(396, 375));
-	mParent.insert(pair<const int, int>(397, 375));
-	mParent.insert(pair<const int, int>(398, 374));
-	mParent.insert(pair<const int, int>(399, 211));
-	mParent.insert(pair<const int, int>(400, 211));
-	mParent.insert(pair<const int, int>(401, 211));
-	mParent.insert(pair<const int, int>(402, 182));
-	mParent.insert(pair<const int, int>(403, 402));
-	mParent.insert(pair<const int, int>(404, 241));
-	mParent.insert(pair<const int, int>(405, 240));
-	mParent.insert(pair<const int, int>(406, 240));
-	mParent.insert(pair<const int, int>(407, 169));
-	mParent.insert(pair<const int, int>(408, 1000));
-	mParent.insert(pair<const int, int>(409, 236));
-	mParent.insert(pair<const int, int>(410, 290));
-	mParent.insert(pair<const int, int>(411, 170));
-	mParent.insert(pair<const int, int>(412, 231));
-	mParent.insert(pair<const int, int>(413, 374));
-	mParent.insert(pair<const int, int>(414, 413));
-	mParent.insert(pair<const int, int>(415, 413));
-	mParent.insert(pair<const int, int>(416, 390));
-	mParent.insert(pair<const int, int>(417, 390));
-	mParent.insert(pair<const int, int>(418, 286));
-	mParent.insert(pair<const int, int>(419, 286));
-	mParent.insert(pair<const int, int>(420, 286));
-	mParent.insert(pair<const int, int>(420, 296));
-	mParent.insert(pair<const int, int>(421, 286));
-	mParent.insert(pair<const int, int>(422, 261));
-	mParent.insert(pair<const int, int>(423, 194));
-	mParent.insert(pair<const int, int>(424, 194));
-	mParent.insert(pair<const int, int>(425, 268));
-	mParent.insert(pair<const int, int>(426, 425));
-	mParent.insert(pair<const int, int>(427, 426));
-	mParent.insert(pair<const int, int>(428, 426));
-	mParent.insert(pair<const int, int>(429, 268));
-	mParent.insert(pair<const int, int>(430, 269));
-	mParent.insert(pair<const int, int>(431, 425));
-	mParent.insert(pair<const int, int>(432, 429));
-	mParent.insert(pair<const int, int>(433, 429));
-	mParent.insert(pair<const int, int>(434, 429));
-	mParent.insert(pair<const int, int>(435, 429));
-	mParent.insert(pair<const int, int>(436, 429));
-	mParent.insert(pair<const int, int>(437, 326));
-	mParent.insert(pair<const int, int>(438, 326));
-	mParent.insert(pair<const int, int>(439, 326));
-	mParent.insert(pair<const int, int>(440, 430));
-	mParent.insert(pair<const int, int>(441, 275));
-	mParent.insert(pair<const int, int>(442, 265));
-	mParent.insert(pair<const int, int>(443, 430));
-	mParent.insert(pair<const int, int>(444, 443));
-	mParent.insert(pair<const int, int>(445, 444));
-	mParent.insert(pair<const int, int>(446, 444));
-	mParent.insert(pair<const int, int>(447, 444));
-	mParent.insert(pair<const int, int>(448, 444));
-	mParent.insert(pair<const int, int>(449, 447));
-	mParent.insert(pair<const int, int>(450, 448));
-	mParent.insert(pair<const int, int>(451, 430));
-	mParent.insert(pair<const int, int>(452, 451));
-	mParent.insert(pair<const int, int>(453, 451));
-	mParent.insert(pair<const int, int>(454, 430));
-	mParent.insert(pair<const int, int>(455, 454));
-	mParent.insert(pair<const int, int>(456, 430));
-	mParent.insert(pair<const int, int>(457, 456));
-	mParent.insert(pair<const int, int>(458, 430));
-	mParent.insert(pair<const int, int>(459, 19));
-	mParent.insert(pair<const int, int>(460, 13));
-	mParent.insert(pair<const int, int>(461, 459));
-	mParent.insert(pair<const int, int>(462, 459));
-	mParent.insert(pair<const int, int>(463, 303));
-	mParent.insert(pair<const int, int>(464, 375));
-	mParent.insert(pair<const int, int>(465, 2));
-	mParent.insert(pair<const int, int>(466, 465));
-	mParent.insert(pair<const int, int>(467, 465));
-	mParent.insert(pair<const int, int>(468, 465));
-	mParent.insert(pair<const int, int>(469, 413));
-	mParent.insert(pair<const int, int>(470, 540));
-	mParent.insert(pair<const int, int>(471, 196));
-	mParent.insert(pair<const int, int>(472, 196));
-	mParent.insert(pair<const int, int>(473, 552));
-	mParent.insert(pair<const int, int>(474, 64));
-	mParent.insert(pair<const int, int>(475, 474));
-	mParent.insert(pair<const int, int>(476, 347));
-	mParent.insert(pair<const int, int>(477, 346));
-	mParent.insert(pair<const int, int>(478, 193));
-	mParent.insert(pair<const int, int>(479, 478));
-	mParent.insert(pair<const int, int>(480, 478));
-	mParent.insert(pair<const int, int>(481, 380));
-	mParent.insert(pair<const int, int>(482, 9));
-	mParent.insert(pair<const int, int>(483, 1000));
-	mParent.insert(pair<const int, int>(484, 1000));
-	mParent.insert(pair<const int, int>(485, 46));
-	mParent.insert(pair<const int, int>(486, 381));
-	mParent.insert(pair<const int, int>(487, 474));
-	mParent.insert(pair<const int, int>(488, 487));
-	mParent.insert(pair<const int, int>(489, 487));
-	mParent.insert(pair<const int, int>(490, 188));
-	mParent.insert(pair<const int, int>(491, 9));
-	mParent.insert(pair<const int, int>(492, 2));
-	mParent.insert(pair<const int, int>(493, 241));
-	mParent.insert(pair<const int, int>(494, 493));
-	mParent.insert(pair<const int, int>(495, 493));
-	mParent.insert(pair<const int, int>(496, 493));
-	mParent.insert(pair<const int, int>(497, 389));
-	mParent.insert(pair<const int, int>(498, 381));
-	mParent.insert(pair<const int, int>(499, 1000));
-	mParent.insert(pair<const int, int>(500, 343));
-	mParent.insert(pair<const int, int>(501, 343));
-	mParent.insert(pair<const int, int>(502, 343));
-	mParent.insert(pair<const int, int>(503, 361));
-	mParent.insert(pair<const int, int>(504, 361));
-	mParent.insert(pair<const int, int>(505, 518));
-	mParent.insert(pair<const int, int>(506, 504));
-	mParent.insert(pair<const int, int>(507, 517));
-	mParent.insert(pair<const int, int>(508, 503));
-	mParent.insert(pair<const int, int>(509, 196));
-	mParent.insert(pair<const int, int>(510, 504));
-	mParent.insert(pair<const int, int>(511, 503));
-	mParent.insert(pair<const int, int>(512, 196));
-	mParent.insert(pair<const int, int>(513, 504));
-	mParent.insert(pair<const int, int>(514, 508));
-	mParent.insert(pair<const int, int>(515, 509));
-	mParent.insert(pair<const int, int>(516, 510));
-	mParent.insert(pair<const int, int>(517, 503));
-	mParent.insert(pair<const int, int>(518, 196));
-	mParent.insert(pair<const int, int>(519, 504));
-	mParent.insert(pair<const int, int>(520, 517));
-	mParent.insert(pair<const int, int>(521, 518));
-	mParent.insert(pair<const int, int>(522, 519));
-	mParent.insert(pair<const int, int>(523, 517));
-	mParent.insert(pair<const int, int>(524, 518));
-	mParent.insert(pair<const int, int>(525, 519));
-	mParent.insert(pair<const int, int>(526, 344));
-	mParent.insert(pair<const int, int>(527, 1));
-	mParent.insert(pair<const int, int>(528, 527));
-	mParent.insert(pair<const int, int>(529, 527));
-	mParent.insert(pair<const int, int>(530, 527));
-	mParent.insert(pair<const int, int>(531, 527));
-	mParent.insert(pair<const int, int>(532, 527));
-	mParent.insert(pair<const int, int>(533, 461));
-	mParent.insert(pair<const int, int>(534, 461));
-	mParent.insert(pair<const int, int>(535, 461));
-	mParent.insert(pair<const int, int>(536, 207));
-	mParent.insert(pair<const int, int>(537, 207));
-	mParent.insert(pair<const int, int>(538, 2));
-	mParent.insert(pair<const int, int>(539, 2));
-	mParent.insert(pair<const int, int>(540, 360));
-	mParent.insert(pair<const int, int>(541, 540));
-	mParent.insert(pair<const int, int>(542, 2));
-	mParent.insert(pair<const int, int>(543, 296));
-	mParent.insert(pair<const int, int>(544, 0));
-	mParent.insert(pair<const int, int>(545, 0));
-	mParent.insert(pair<const int, int>(546, 545));
-	mParent.insert(pair<const int, int>(547, 234));
-	mParent.insert(pair<const int, int>(548, 547));
-	mParent.insert(pair<const int, int>(549, 547));
-	mParent.insert(pair<const int, int>(550, 544));
-	mParent.insert(pair<const int, int>(551, 555));
-	mParent.insert(pair<const int, int>(552, 550));
-	mParent.insert(pair<const int, int>(553, 552));
-	mParent.insert(pair<const int, int>(554, 552));
-	mParent.insert(pair<const int, int>(555, 557));
-	mParent.insert(pair<const int, int>(556, 557));
-	mParent.insert(pair<const int, int>(557, 550));
-	mParent.insert(pair<const int, int>(558, 2));
-	mParent.insert(pair<const int, int>(559, 2));
-	mParent.insert(pair<const int, int>(560, 163));
-	mParent.insert(pair<const int, int>(561, 166));
-	mParent.insert(pair<const int, int>(562, 45));
-	mParent.insert(pair<const int, int>(563, 562));
-	mParent.insert(pair<const int, int>(564, 562));
-	mParent.insert(pair<const int, int>(565, 545));
-	mParent.insert(pair<const int, int>(566, 538));
-	mParent.insert(pair<const int, int>(567, 565));
-	mParent.insert(pair<const int, int>(568, 565));
-	mParent.insert(pair<const int, int>(569, 391));
-	mParent.insert(pair<const int, int>(570, 569));
-	mParent.insert(pair<const int, int>(571, 2));
-	mParent.insert(pair<const int, int>(572, 571));
-	mParent.insert(pair<const int, int>(573, 572));
-	mParent.insert(pair<const int, int>(574, 573));
-	mParent.insert(pair<const int, int>(575, 573));
-	mParent.insert(pair<const int, int>(576, 571));
-	mParent.insert(pair<const int, int>(577, 576));
-	mParent.insert(pair<const int, int>(578, 577));
-	mParent.insert(pair<const int, int>(579, 577));
-	mParent.insert(pair<const int, int>(580, 571));
-	mParent.insert(pair<const int, int>(581, 580));
-	mParent.insert(pair<const int, int>(582, 581));
-	mParent.insert(pair<const int, int>(583, 581));
-	mParent.insert(pair<const int, int>(584, 346));
-	mParent.insert(pair<const int, int>(585, 347));
-	mParent.insert(pair<const int, int>(586, 346));
-	mParent.insert(pair<const int, int>(587, 185));
-	mParent.insert(pair<const int, int>(588, 185));
-	mParent.insert(pair<const int, int>(589, 205));
-	mParent.insert(pair<const int, int>(590, 369));
-	mParent.insert(pair<const int, int>(591, 464));
-	mParent.insert(pair<const int, int>(592, 361));
-	mParent.insert(pair<const int, int>(593, 592));
-	mParent.insert(pair<const int, int>(594, 3));
-	mParent.insert(pair<const int, int>(595, 19));
-	mParent.insert(pair<const int, int>(596, 19));
-	mParent.insert(pair<const int, int>(597, 20));
-	mParent.insert(pair<const int, int>(598, 1000));
-	mParent.insert(pair<const int, int>(599, 473));
-	mParent.insert(pair<const int, int>(600, 599));
-	mParent.insert(pair<const int, int>(601, 599));
-	mParent.insert(pair<const int, int>(602, 546));
-	mParent.insert(pair<const int, int>(603, 11));
-	mParent.insert(pair<const int, int>(604, 15));
-	mParent.insert(pair<const int, int>(605, 244));
-	mParent.insert(pair<const int, int>(606, 244));
-	mParent.insert(pair<const int, int>(607, 296));
-	mParent.insert(pair<const int, int>(608, 607));
-	mParent.insert(pair<const int, int>(609, 607));
-	mParent.insert(pair<const int, int>(610, 2));
-	mParent.insert(pair<const int, int>(611, 9));
-	mParent.insert(pair<const int, int>(612, 613));
-	mParent.insert(pair<const int, int>(613, 2));
-	mParent.insert(pair<const int, int>(614, 612));
-	mParent.insert(pair<const int, int>(615, 612));
-	mParent.insert(pair<const int, int>(616, 613));
-	mParent.insert(pair<const int, int>(617, 581));
-	mParent.insert(pair<const int, int>(618, 581));
-	mParent.insert(pair<const int, int>(619, 580));
-	mParent.insert(pair<const int, int>(620, 619));
-	mParent.insert(pair<const int, int>(621, 619));
-	mParent.insert(pair<const int, int>(622, 619));
-	mParent.insert(pair<const int, int>(623, 2));
-	mParent.insert(pair<const int, int>(624, 4));
-	mParent.insert(pair<const int, int>(625, 613));
-	mParent.insert(pair<const int, int>(626, 625));
-	mParent.insert(pair<const int, int>(627, 631));
-	mParent.insert(pair<const int, int>(628, 631));
-	mParent.insert(pair<const int, int>(629, 395));
-	mParent.insert(pair<const int, int>(630, 395));
-	mParent.insert(pair<const int, int>(631, 375));
-	mParent.insert(pair<const int, int>(632, 631));
-	mParent.insert(pair<const int, int>(633, 473));
-	mParent.insert(pair<const int, int>(634, 354));
-	mParent.insert(pair<const int, int>(635, 354));
-	mParent.insert(pair<const int, int>(636, 21));
-	mParent.insert(pair<const int, int>(637, 21));
-	mParent.insert(pair<const int, int>(638, 20));
-	mParent.insert(pair<const int, int>(639, 20));
-	mParent.insert(pair<const int, int>(640, 20));
-	mParent.insert(pair<const int, int>(641, 303));
-	mParent.insert(pair<const int, int>(642, 644));
-	mParent.insert(pair<const int, int>(643, 644));
-	mParent.insert(pair<const int, int>(644, 3));
-	mParent.insert(pair<const int, int>(645, 3));
-	mParent.insert(pair<const int, int>(646, 42));
-	mParent.insert(pair<const int, int>(647, 2));
-	mParent.insert(pair<const int, int>(648, 647));
-	mParent.insert(pair<const int, int>(649, 241));
-	mParent.insert(pair<const int, int>(650, 375));
-	mParent.insert(pair<const int, int>(651, 375));
-	mParent.insert(pair<const int, int>(652, 182));
-	mParent.insert(pair<const int, int>(653, 182));
-	mParent.insert(pair<const int, int>(654, 655));
-	mParent.insert(pair<const int, int>(655, 167));
-	mParent.insert(pair<const int, int>(656, 182));
-	mParent.insert(pair<const int, int>(657, 655));
-	mParent.insert(pair<const int, int>(658, 655));
-	mParent.insert(pair<const int, int>(659, 654));
-	mParent.insert(pair<const int, int>(660, 654));
-	mParent.insert(pair<const int, int>(661, 2));
-	mParent.insert(pair<const int, int>(662, 2));
-	mParent.insert(pair<const int, int>(663, 545));
-	mParent.insert(pair<const int, int>(664, 3));
-	mParent.insert(pair<const int, int>(665, 182));
-	mParent.insert(pair<const int, int>(666, 2));
-	mParent.insert(pair<const int, int>(667, 666));
-	mParent.insert(pair<const int, int>(668, 241));
-	mParent.insert(pair<const int, int>(669, 668));
-	mParent.insert(pair<const int, int>(670, 668));
-	mParent.insert(pair<const int, int>(671, 13));
-
+  getSBOAncestry();
 }
 /** @endcond */
 
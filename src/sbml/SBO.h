@@ -222,13 +222,14 @@ class XMLAttributes;
 class XMLOutputStream;
 class SBMLErrorLog;
 
-/* create a map of parent-child sbo terms */
+/*
+ * Types of the parent-child map of sbo terms that SBO used to keep.  SBO
+ * no longer uses them; they are kept for existing code and deprecated.
+ */
 typedef std::multimap<int, int>           ParentMap;
 typedef ParentMap::iterator               ParentIter;
 typedef std::pair<ParentIter, ParentIter> ParentRange;
 
-static ParentMap mParent;
-
 
 class LIBSBML_EXTERN SBO
 {
@@ -607,8 +608,8 @@ protected:
   static bool isChildOf(unsigned int term, unsigned int parent);
 
  /**
-   * Returns @c true if the given term identifier comes from the stated branch of %SBO.
-   * populates the parent-child map
+   * Builds the table of the ancestors of every %SBO term, which is
+   * otherwise built on the first call of isChildOf().
    */
   static void populateSBOTree();
 
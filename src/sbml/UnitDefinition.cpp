@@ -48,6 +48,7 @@
 #include <sbml/xml/XMLOutputStream.h>
 
 #include <sbml/units/UnitKindList.h>
+#include <sbml/units/DimensionVector.h>
 
 #include <sbml/SBO.h>
 #include <sbml/SBMLVisitor.h>
@@ -1267,6 +1268,13 @@ UnitDefinition::areEquivalent(const UnitDefinition * ud1, const UnitDefinition *
     return equivalent;
   }
 
+  // unless they contain units without an exact representation, compare
+  // the dimensions directly instead of converting copies to SI
+  if (DimensionVector::areEquivalent(ud1, ud2, equivalent))
+  {
+    return equivalent;
+  }
+
   unsigned int n;
 
   UnitDefinition * ud1Temp = UnitDefinition::convertToSI(ud1);
@@ -112,6 +112,9 @@
    application in case of an allocation / file system error. */
 #cmakedefine EXIT_ON_ERROR 1
 
+/* Define to 1 to allow libSBML to use threads for independent work. */
+#cmakedefine LIBSBML_USE_THREADS 1
+
 /* Define to specify that the legacy math implementation ought to be used. */
 /* This is no longer an option but in case other programs compiling against
    libsbml have used the flag it is always on */
@@ -182,6 +182,18 @@ SBMLConverter::convert()
 {
   return LIBSBML_OPERATION_FAILED;
 }
+
+void
+SBMLConverter::reset()
+{
+  mDocument = NULL;
+}
+
+bool
+SBMLConverter::isThreadSafe() const
+{
+  return false;
+}
   
 bool 
 SBMLConverter::matchesProperties(const ConversionProperties &) const
@@ -287,6 +287,38 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and any other state left by an earlier
+   * conversion.
+   *
+   * A converter may be applied to many documents in turn: call this
+   * method, then
+   * SBMLConverter::setDocument(@if java const SBMLDocument@endif) and
+   * SBMLConverter::convert() for each of them.  The properties of the
+   * converter are kept.
+   *
+   * Subclasses that keep information about the document they convert
+   * should override this method and call the implementation of their
+   * parent.
+   */
+  virtual void reset();
+
+
+  /**
+   * Predicate returning @c true if copies of this converter may convert
+   * different documents on several threads at the same time.
+   *
+   * When this returns @c false, SBMLConverterRegistry converts a batch of
+   * documents one after another.  Many conversions validate the document
+   * or evaluate math, which uses state shared by the whole process, so
+   * only subclasses that have been checked to change nothing but the
+   * document they convert should override this method to return @c true.
+   *
+   * @return @c false by default.
+   */
+  virtual bool isThreadSafe() const;
+
+
   /**
    * Returns the name of this converter.
    *
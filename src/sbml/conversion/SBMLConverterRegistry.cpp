@@ -47,17 +47,129 @@
 #include <string>
 #include <sstream>
 
+#include <sbml/common/libsbml-config.h>
 #include <sbml/conversion/ConversionProperties.h>
 #include <sbml/conversion/SBMLConverterRegistry.h>
 #include <sbml/conversion/SBMLConverter.h>
+#include <sbml/util/ParallelTask.h>
 #include <sbml/util/util.h>
 
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
 // for now convertes to be used have to be included once!
 #include <sbml/conversion/RegisterConverters.cpp>
 
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+/** @cond doxygenLibsbmlInternal */
+#ifdef LIBSBML_USE_THREADS
+static std::mutex sConverterIndexMutex;
+#endif
+
+/*
+ * Holds the lock of the index of matched converters for the lifetime of
+ * the object.
+ */
+class ConverterIndexLock
+{
+public:
+  ConverterIndexLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sConverterIndexMutex.lock();
+#endif
+  }
+
+  ~ConverterIndexLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sConverterIndexMutex.unlock();
+#endif
+  }
+};
+
+
+/*
+ * Returns the sorted keys of the options of the given properties; the
+ * converters match on the options present rather than on their values.
+ */
+static string
+getOptionKeys(const ConversionProperties& props)
+{
+  vector<string> keys;
+  for (int i = 0; i < props.getNumOptions(); i++)
+  {
+    keys.push_back(props.getOption(i)->getKey());
+  }
+  sort(keys.begin(), keys.end());
+
+  string result;
+  for (size_t i = 0; i < keys.size(); i++)
+  {
+    result += keys[i];
+    result += '\n';
+  }
+  return result;
+}
+
+
+/*
+ * Converts a consecutive range of documents with one copy of a converter
+ * for each range.  Every index only touches its own documents and results.
+ */
+class ConvertDocuments : public ParallelTask
+{
+public:
+  ConvertDocuments(const SBMLConverter& converter,
+                   const ConversionProperties& props,
+                   const vector<SBMLDocument*>& documents,
+                   vector<int>& results,
+                   unsigned int numRanges)
+    : mConverter(converter)
+    , mProps(props)
+    , mDocuments(documents)
+    , mResults(results)
+    , mNumRanges(numRanges)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    size_t first = mDocuments.size() * index / mNumRanges;
+    size_t last = mDocuments.size() * (index + 1) / mNumRanges;
+
+    SBMLConverter* converter = mConverter.clone();
+    converter->setProperties(&mProps);
+
+    for (size_t i = first; i < last; i++)
+    {
+      if (mDocuments[i] == NULL)
+      {
+        mResults[i] = LIBSBML_INVALID_OBJECT;
+        continue;
+      }
+
+      converter->reset();
+      converter->setDocument(mDocuments[i]);
+      mResults[i] = converter->convert();
+    }
+
+    delete converter;
+  }
+
+private:
+  const SBMLConverter& mConverter;
+  const ConversionProperties& mProps;
+  const vector<SBMLDocument*>& mDocuments;
+  vector<int>& mResults;
+  unsigned int mNumRanges;
+};
+/** @endcond */
+
+
 
 SBMLConverterRegistry& 
 SBMLConverterRegistry::getInstance()
@@ -79,17 +191,55 @@ SBMLConverterRegistry::addConverter (const SBMLConverter* converter)
 SBMLConverter* 
 SBMLConverterRegistry::getConverterFor(const ConversionProperties& props) const
 {
-  std::vector<const SBMLConverter*>::const_iterator it; 
-  for (it = mConverters.begin(); it != mConverters.end(); it++)
+  const SBMLConverter* match = findConverter(props);
+  if (match == NULL) return NULL;
+
+  SBMLConverter* converter = match->clone();
+  converter->setProperties(&props);
+  return converter;
+}
+
+int
+SBMLConverterRegistry::convert(const std::vector<SBMLDocument*>& documents,
+                               const ConversionProperties& props,
+                               std::vector<int>* results,
+                               unsigned int maxThreads) const
+{
+  const SBMLConverter* match = findConverter(props);
+  if (match == NULL) return LIBSBML_CONV_CONVERSION_NOT_AVAILABLE;
+
+  vector<int> converted(documents.size(), LIBSBML_OPERATION_SUCCESS);
+
+  if (!documents.empty())
   {
-    if ((*it)->matchesProperties(props))
+    unsigned int numRanges =
+      (maxThreads == 0) ? ParallelTask::getMaxThreads() : maxThreads;
+    if (numRanges > documents.size())
     {
-      SBMLConverter* converter = (*it)->clone();
-      converter->setProperties(&props);
-      return converter;
+      numRanges = (unsigned int)documents.size();
     }
+    if (!match->isThreadSafe())
+    {
+      numRanges = 1;
+    }
+
+    ConvertDocuments task(*match, props, documents, converted, numRanges);
+    ParallelTask::execute(task, numRanges, maxThreads);
   }
-  return NULL;
+
+  if (results != NULL)
+  {
+    *results = converted;
+  }
+
+  for (size_t i = 0; i < converted.size(); i++)
+  {
+    if (converted[i] != LIBSBML_OPERATION_SUCCESS)
+    {
+      return converted[i];
+    }
+  }
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 int 
@@ -107,6 +257,38 @@ SBMLConverterRegistry::getConverterByIndex(int index) const
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+const SBMLConverter*
+SBMLConverterRegistry::findConverter(const ConversionProperties& props) const
+{
+  string key = getOptionKeys(props);
+
+  {
+    ConverterIndexLock lock;
+    map<string, size_t>::const_iterator it = mConverterIndex.find(key);
+    if (it != mConverterIndex.end()
+      && mConverters[it->second]->matchesProperties(props))
+    {
+      return mConverters[it->second];
+    }
+  }
+
+  for (size_t i = 0; i < mConverters.size(); i++)
+  {
+    if (mConverters[i]->matchesProperties(props))
+    {
+      // converters are only ever appended, so the first one to match the
+      // same keys stays the first one
+      ConverterIndexLock lock;
+      mConverterIndex[key] = i;
+      return mConverters[i];
+    }
+  }
+  return NULL;
+}
+/** @endcond */
+
+
 /** @cond doxygenLibsbmlInternal */
 SBMLConverterRegistry::SBMLConverterRegistry()
 {
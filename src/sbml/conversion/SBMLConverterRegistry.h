@@ -70,6 +70,7 @@
 #include <sbml/conversion/SBMLConverter.h>
 #include <sbml/conversion/ConversionProperties.h>
 #include <map>
+#include <string>
 #include <vector>
 
 
@@ -143,6 +144,40 @@ public:
   SBMLConverter* getConverterFor(const ConversionProperties& props) const;
 
 
+#ifndef SWIG
+
+  /**
+   * Applies the conversion described by the given properties to each of
+   * the given documents.
+   *
+   * The converter is looked up once; every document is then converted by
+   * a copy of it of its own, so the documents may be converted on several
+   * threads at once.  The documents must therefore not share any objects
+   * with each other.  Converters for which SBMLConverter::isThreadSafe()
+   * returns @c false, as it does by default, convert the documents one
+   * after another.
+   *
+   * @param documents the documents to convert.
+   * @param props the properties of the conversion.
+   * @param results if not @c NULL, is filled with the value returned by
+   * SBMLConverter::convert() for each document, in order.
+   * @param maxThreads the maximum number of threads to use, or @c 0 to use
+   * ParallelTask::getMaxThreads().
+   *
+   * @return @sbmlconstant{LIBSBML_OPERATION_SUCCESS,
+   * OperationReturnValues_t} if every document was converted,
+   * @sbmlconstant{LIBSBML_CONV_CONVERSION_NOT_AVAILABLE,
+   * OperationReturnValues_t} if there is no converter for @p props, or
+   * else the value returned for the first document that failed.
+   */
+  int convert(const std::vector<SBMLDocument*>& documents,
+              const ConversionProperties& props,
+              std::vector<int>* results = NULL,
+              unsigned int maxThreads = 0) const;
+
+#endif // SWIG
+
+
   /**
    * Returns the number of converters known by the registry.
    *
@@ -169,7 +204,17 @@ protected:
 
 protected:
   /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * Returns the registered converter matching the given properties, or
+   * @c NULL.
+   */
+  const SBMLConverter* findConverter(const ConversionProperties& props) const;
+
   std::vector<const SBMLConverter*>  mConverters;
+
+  /* the converters matched before, by the keys of the options asked for */
+  mutable std::map<std::string, size_t> mConverterIndex;
   /** @endcond */
 };
 
@@ -59,6 +59,7 @@
 #include <sbml/conversion/SBMLRateOfConverter.h>
 #include <sbml/conversion/SBMLReactionConverter.h>
 #include <sbml/conversion/SBMLRuleConverter.h>
+#include <sbml/conversion/SBMLSimplifyMathConverter.h>
 #include <sbml/conversion/SBMLStripPackageConverter.h>
 #include <sbml/conversion/SBMLUnitsConverter.h>
 
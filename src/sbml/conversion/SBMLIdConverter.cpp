@@ -139,6 +139,13 @@ SBMLIdConverter::matchesProperties(const ConversionProperties &props) const
   return true;
 }
 
+bool
+SBMLIdConverter::isThreadSafe() const
+{
+  return true;
+}
+
+
 int 
 SBMLIdConverter::convert()
 {
@@ -166,6 +166,14 @@ public:
   virtual bool matchesProperties(const ConversionProperties &props) const;
 
 
+  /**
+   * Returns @c true: renaming identifiers only changes the document being
+   * converted, so a batch of documents may be converted on several
+   * threads.
+   */
+  virtual bool isThreadSafe() const;
+
+
   /**
    * Perform the conversion.
    *
@@ -47,15 +47,140 @@
 #include <sbml/SBMLReader.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/Model.h>
+#include <sbml/util/ParallelTask.h>
 
 #ifdef __cplusplus
 
 #include <algorithm>
+#include <map>
+#include <set>
 #include <string>
+#include <vector>
 
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+
+/** @cond doxygenLibsbmlInternal */
+
+static void
+collectNames (const ASTNode* node, set<string>& names)
+{
+  if (node == NULL)
+  {
+    return;
+  }
+  if (node->getType() == AST_NAME && node->getName() != NULL)
+  {
+    names.insert(node->getName());
+  }
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    collectNames(node->getChild(i), names);
+  }
+}
+
+
+/*
+ * Infers the units of each parameter from the model as it is before any
+ * units are set.  Every index only writes to its own result; the model
+ * and its parameters are only read.
+ */
+class InferParameterUnits : public ParallelTask
+{
+public:
+  InferParameterUnits(const vector<Parameter*>& parameters,
+                      vector<UnitDefinition*>& results)
+    : mParameters(parameters)
+    , mResults(results)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    mResults[index] = mParameters[index]->inferUnitDefinition();
+  }
+
+private:
+  const vector<Parameter*>& mParameters;
+  vector<UnitDefinition*>& mResults;
+};
+
+
+/*
+ * Lists, for each parameter in @p parameters, the pieces of math the
+ * units of a parameter can be inferred from that mention it.
+ *
+ * @return the number of pieces of math.
+ */
+static unsigned int
+findMathOfParameters (const Model& m, const vector<Parameter*>& parameters,
+                      vector< vector<unsigned int> >& mathOfParameter)
+{
+  vector<const ASTNode*> maths;
+  unsigned int n, j;
+
+  for (n = 0; n < m.getNumInitialAssignments(); n++)
+  {
+    maths.push_back(m.getInitialAssignment(n)->getMath());
+  }
+  for (n = 0; n < m.getNumRules(); n++)
+  {
+    maths.push_back(m.getRule(n)->getMath());
+  }
+  for (n = 0; n < m.getNumReactions(); n++)
+  {
+    if (m.getReaction(n)->isSetKineticLaw())
+    {
+      maths.push_back(m.getReaction(n)->getKineticLaw()->getMath());
+    }
+  }
+  for (n = 0; n < m.getNumEvents(); n++)
+  {
+    const Event* e = m.getEvent(n);
+    for (j = 0; j < e->getNumEventAssignments(); j++)
+    {
+      maths.push_back(e->getEventAssignment(j)->getMath());
+    }
+    if (e->isSetDelay())
+    {
+      maths.push_back(e->getDelay()->getMath());
+    }
+    if (e->isSetPriority())
+    {
+      maths.push_back(e->getPriority()->getMath());
+    }
+  }
+
+  map<string, unsigned int> position;
+  for (n = 0; n < parameters.size(); n++)
+  {
+    position[parameters[n]->getId()] = n;
+  }
+
+  mathOfParameter.assign(parameters.size(), vector<unsigned int>());
+
+  for (n = 0; n < maths.size(); n++)
+  {
+    set<string> names;
+    collectNames(maths[n], names);
+
+    for (set<string>::const_iterator it = names.begin(); 
+         it != names.end(); ++it)
+    {
+      map<string, unsigned int>::const_iterator found = position.find(*it);
+      if (found != position.end())
+      {
+        mathOfParameter[found->second].push_back(n);
+      }
+    }
+  }
+
+  return (unsigned int)maths.size();
+}
+
+/** @endcond */
+
   
 /** @cond doxygenLibsbmlInternal */
 void SBMLInferUnitsConverter::init()
@@ -178,74 +303,114 @@ SBMLInferUnitsConverter::convert()
 
   /* so we have a consistent model - we can try inferring units */
   // TO DO keep a copy of model so we can revert back to it if things go wrong
-  std::string newId;
-  char number[4];
+
+  /* the parameters are considered in order, and setting the units of one
+   * can change what is inferred for the parameters after it; but only for
+   * those that share a piece of math with it.  So the units of all of them
+   * are first inferred in parallel from the model as it is now, and while
+   * they are set in order, a parameter is inferred again if a parameter
+   * sharing math with it has been given units in the meantime.
+   */
+  vector<Parameter*> parameters;
   for (unsigned int i = 0; i < mModel->getNumParameters(); i++)
   {
     if (mModel->getParameter(i)->isSetUnits() == false)
     {
-      UnitDefinition * inferred = NULL;
-      mModel->getParameter(i)->setCalculatingUnits(true);
-      inferred = mModel->getParameter(i)->getDerivedUnitDefinition();
-      mModel->getParameter(i)->setCalculatingUnits(false);
+      parameters.push_back(mModel->getParameter(i));
+    }
+  }
+
+  if (!mModel->isPopulatedListFormulaUnitsData())
+  {
+    mModel->populateListFormulaUnitsData();
+  }
+
+  vector<UnitDefinition*> results(parameters.size(), NULL);
+  InferParameterUnits task(parameters, results);
+  ParallelTask::execute(task, (unsigned int)parameters.size());
+
+  vector< vector<unsigned int> > mathOfParameter;
+  unsigned int numMath = findMathOfParameters(*mModel, parameters, 
+                                              mathOfParameter);
+  vector<bool> mathChanged(numMath, false);
+
+  std::string newId;
+  char number[12];
+  for (unsigned int i = 0; i < parameters.size(); i++)
+  {
+    UnitDefinition * inferred = results[i];
+
+    bool stale = false;
+    for (unsigned int j = 0; j < mathOfParameter[i].size(); j++)
+    {
+      stale = stale || mathChanged[mathOfParameter[i][j]];
+    }
+    if (stale)
+    {
+      delete inferred;
+      inferred = parameters[i]->inferUnitDefinition();
+    }
+    
+    if (inferred != NULL && inferred->getNumUnits() != 0)
+    {
+      bool baseUnit = false;
+
+      newId = existsAlready(*(mModel), inferred);
       
-      if (inferred != NULL && inferred->getNumUnits() != 0)
+      if (newId.empty())
       {
-        bool baseUnit = false;
-
-        newId = existsAlready(*(mModel), inferred);
-        
-        if (newId.empty())
+        if (inferred->isVariantOfDimensionless())
         {
-          if (inferred->isVariantOfDimensionless())
+          newId = "dimensionless";
+          baseUnit = true;
+        }
+        else if (inferred->getNumUnits() == 1)
+        {
+          Unit * u = inferred->getUnit(0);
+          Unit * defaultU = new Unit(u->getSBMLNamespaces());
+          defaultU->initDefaults();
+          defaultU->setKind(u->getKind());
+          if (Unit::areIdentical(u, defaultU) == true)
           {
-            newId = "dimensionless";
+            newId = UnitKind_toString(u->getKind());
             baseUnit = true;
           }
-          else if (inferred->getNumUnits() == 1)
-          {
-            Unit * u = inferred->getUnit(0);
-            Unit * defaultU = new Unit(u->getSBMLNamespaces());
-            defaultU->initDefaults();
-            defaultU->setKind(u->getKind());
-            if (Unit::areIdentical(u, defaultU) == true)
-            {
-              newId = UnitKind_toString(u->getKind());
-              baseUnit = true;
-            }
-            delete defaultU;
-            defaultU = NULL;
-          }
+          delete defaultU;
+          defaultU = NULL;
         }
+      }
 
-        if (newId.empty())
+      if (newId.empty())
+      {
+        /* create an id for the unitDef */
+        sprintf(number, "%u", newIdCount);
+        newId = "unitSid_" + string(number);
+        newIdCount++;
+
+        /* double check that this id has not been used */
+        while (mModel->getUnitDefinition(newId) != NULL)
         {
-          /* create an id for the unitDef */
           sprintf(number, "%u", newIdCount);
           newId = "unitSid_" + string(number);
           newIdCount++;
-
-          /* double check that this id has not been used */
-          while (mModel->getUnitDefinition(newId) != NULL)
-          {
-            sprintf(number, "%u", newIdCount);
-            newId = "unitSid_" + string(number);
-            newIdCount++;
-          }
-        }
-      
-        if (baseUnit == false)
-        {
-          inferred->setId(newId);
-          mModel->addUnitDefinition(inferred);
         }
+      }
+    
+      if (baseUnit == false)
+      {
+        inferred->setId(newId);
+        mModel->addUnitDefinition(inferred);
+      }
 
-        mModel->getParameter(i)->setUnits(newId);
+      parameters[i]->setUnits(newId);
 
-        delete inferred;
-        inferred = NULL;
+      for (unsigned int j = 0; j < mathOfParameter[i].size(); j++)
+      {
+        mathChanged[mathOfParameter[i][j]] = true;
       }
     }
+
+    delete inferred;
   }
 
   return LIBSBML_OPERATION_SUCCESS;
@@ -222,6 +222,18 @@ SBMLLevelVersionConverter::getAddDefaultUnits()
 }
 
 
+void
+SBMLLevelVersionConverter::reset()
+{
+  delete mSRIds;
+  mSRIds = NULL;
+  delete mMathElements;
+  mMathElements = NULL;
+
+  SBMLConverter::reset();
+}
+
+
 int
 SBMLLevelVersionConverter::convert()
 {
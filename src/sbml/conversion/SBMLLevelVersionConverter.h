@@ -210,6 +210,13 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and the elements of it collected by this
+   * converter.
+   */
+  virtual void reset();
+
+
   /**
    * Returns the default properties of this converter.
    *
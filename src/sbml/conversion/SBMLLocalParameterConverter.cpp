@@ -160,6 +160,13 @@ std::string getNewId(Model* model, const std::string& reactionId, const std::str
 
 }
 
+bool
+SBMLLocalParameterConverter::isThreadSafe() const
+{
+  return true;
+}
+
+
 int 
 SBMLLocalParameterConverter::convert()
 {
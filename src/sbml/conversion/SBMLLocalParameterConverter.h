@@ -153,6 +153,14 @@ public:
   virtual bool matchesProperties(const ConversionProperties &props) const;
 
 
+  /**
+   * Returns @c true: promoting local parameters only changes the
+   * document being converted, so a batch of documents may be converted
+   * on several threads.
+   */
+  virtual bool isThreadSafe() const;
+
+
   /**
    * Perform the conversion.
    *
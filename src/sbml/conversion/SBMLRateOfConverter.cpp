@@ -79,8 +79,12 @@ SBMLRateOfConverter::SBMLRateOfConverter()
 
 SBMLRateOfConverter::SBMLRateOfConverter(const SBMLRateOfConverter& orig) 
   : SBMLConverter(orig)
-  , mOriginalModel     (orig.mOriginalModel)
+  , mOriginalModel     (NULL)
 {
+  if (orig.mOriginalModel != NULL)
+  {
+    mOriginalModel = orig.mOriginalModel->clone();
+  }
 }
 
 
@@ -152,6 +156,7 @@ SBMLRateOfConverter::setDocument(const SBMLDocument* doc)
   {
     if (mDocument != NULL)
     {
+      delete mOriginalModel;
       mOriginalModel = mDocument->getModel()->clone();
       return LIBSBML_OPERATION_SUCCESS;
     }
@@ -174,6 +179,7 @@ SBMLRateOfConverter::setDocument(SBMLDocument* doc)
   {
     if (mDocument != NULL)
     {
+      delete mOriginalModel;
       mOriginalModel = mDocument->getModel()->clone();
       return LIBSBML_OPERATION_SUCCESS;
     }
@@ -189,6 +195,17 @@ SBMLRateOfConverter::setDocument(SBMLDocument* doc)
 }
 
 
+void
+SBMLRateOfConverter::reset()
+{
+  delete mOriginalModel;
+  mOriginalModel = NULL;
+  mRateOfMath.clear();
+
+  SBMLConverter::reset();
+}
+
+
 bool 
 SBMLRateOfConverter::getToFunctionDefinition()
 {
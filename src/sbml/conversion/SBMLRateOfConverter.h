@@ -212,6 +212,12 @@ public:
    */
   virtual int setDocument(SBMLDocument* doc);
 
+
+  /**
+   * Forgets the document and the copy of its model kept by this converter.
+   */
+  virtual void reset();
+
   /**
    * Returns the direction of the conversion.
    *
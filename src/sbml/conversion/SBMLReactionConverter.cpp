@@ -78,8 +78,12 @@ SBMLReactionConverter::SBMLReactionConverter(const SBMLReactionConverter& orig)
   : SBMLConverter(orig)
   , mReactionsToRemove (orig.mReactionsToRemove)
   , mRateRulesMap      (orig.mRateRulesMap)
-  , mOriginalModel     (orig.mOriginalModel)
+  , mOriginalModel     (NULL)
 {
+  if (orig.mOriginalModel != NULL)
+  {
+    mOriginalModel = orig.mOriginalModel->clone();
+  }
 }
 
 
@@ -148,6 +152,7 @@ SBMLReactionConverter::setDocument(const SBMLDocument* doc)
   {
     if (mDocument != NULL)
     {
+      delete mOriginalModel;
       mOriginalModel = mDocument->getModel()->clone();
       return LIBSBML_OPERATION_SUCCESS;
     }
@@ -170,6 +175,7 @@ SBMLReactionConverter::setDocument(SBMLDocument* doc)
   {
     if (mDocument != NULL)
     {
+      delete mOriginalModel;
       mOriginalModel = mDocument->getModel()->clone();
       return LIBSBML_OPERATION_SUCCESS;
     }
@@ -185,6 +191,18 @@ SBMLReactionConverter::setDocument(SBMLDocument* doc)
 }
 
 
+void
+SBMLReactionConverter::reset()
+{
+  delete mOriginalModel;
+  mOriginalModel = NULL;
+  mReactionsToRemove.clear();
+  mRateRulesMap.clear();
+
+  SBMLConverter::reset();
+}
+
+
 int 
 SBMLReactionConverter::convert()
 {
@@ -215,6 +215,12 @@ public:
   virtual int setDocument(SBMLDocument* doc);
 
 
+  /**
+   * Forgets the document and the copy of its model kept by this converter.
+   */
+  virtual void reset();
+
+
 private:
 
   ASTNode * createRateRuleMathForSpecies(const std::string& spId,
@@ -46,6 +46,7 @@
 #include <sbml/conversion/SBMLConverterRegistry.h>
 #include <sbml/conversion/SBMLConverterRegister.h>
 #include <sbml/math/ASTNode.h>
+#include <sbml/util/DependencyGraph.h>
 #include <sbml/AlgebraicRule.h>
 #include <sbml/AssignmentRule.h>
 #include <sbml/RateRule.h>
@@ -58,7 +59,6 @@
 #include <algorithm>
 #include <string>
 #include <vector>
-#include <map>
 
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
@@ -138,211 +138,62 @@ bool
 }
 
 
-static void getSymbols(const ASTNode* node, vector<string>& list)
-{
-  if (node == NULL) return;
-  if (node->isName())
-  {
-    string name = node->getName();
-    vector<string>::iterator it = find(list.begin(), list.end(), name);
-    if (it == list.end())
-      list.push_back(name);
-  }
-
-  for (unsigned int i = 0; i < node->getNumChildren(); i++)
-  {
-    getSymbols(node->getChild(i), list);
-  }
-
-}
-
-static vector<string> getSymbols(const ASTNode* nodes)
-{
-  vector<string> result;
-  if (nodes == NULL) return result;
-
-  getSymbols(nodes, result);
-
-  return result;
-
-}
-
-
-static vector<AssignmentRule*> reorderRules(vector<AssignmentRule*>& assignmentRules)
+/*
+ * Returns the rules in an order where each rule comes after the rules
+ * whose variables it uses.  A rule is only moved ahead of the rules before
+ * it when one of them uses its variable, so rules that are already in such
+ * an order, and rules that do not depend on each other, keep their place.
+ */
+static vector<AssignmentRule*> reorderRules(DependencyGraph& graph,
+                                            vector<AssignmentRule*>& assignmentRules)
 {
   if (assignmentRules.size() < 2) return assignmentRules;
-  
-  map<int, vector<string> > allSymbols;
-  map<string, vector<string> > map;
-  vector<string> idList;
+
+  vector<unsigned int> nodes;
   vector<AssignmentRule*> result;
 
-  // read id list, initialize all symbols
   for (size_t index = 0; index < assignmentRules.size(); index++)
   {
-    AssignmentRule* rule = (AssignmentRule*)assignmentRules[index];
-    string variable = rule->getVariable();
-    if (!rule->isSetMath())
-      allSymbols[(int)index] = vector<string>();
-    else
-      allSymbols[(int)index] = getSymbols(rule->getMath());
-    idList.push_back(variable);
-    map[variable] = vector<string>();
-  }
-
-
-  // initialize order array
-  vector<int> order;
-  for (size_t i = 0; i < assignmentRules.size(); i++)
-  {
-    order.push_back((int)i);
-  }
-
-  // build dependency graph
-  for (size_t i = 0; i < idList.size(); i++)
-  {
-    string id = idList[i];
-    for (size_t index = 0; index < assignmentRules.size(); index++)
-    {
-      vector<string>::iterator it = ::find(allSymbols[(int)index].begin(), allSymbols[(int)index].end(), id);
-      if (it != allSymbols[(int)index].end())
-      {
-        map[(assignmentRules[index])->getVariable()].push_back(id);
-      }
-    }
+    nodes.push_back(graph.addNode(assignmentRules[index]->getVariable()));
   }
 
-
   // sort
-  bool changed = true;
-  while (changed)
-  {
-    changed = false;
-    for (size_t i = 0; i < order.size(); i++)
-    {
-
-      int first = order[i];
-      for (size_t j = i + 1; j < order.size(); j++)
-      {
-        int second = order[j];
-
-        string secondVar = assignmentRules[(size_t)second]->getVariable();
-        string firstVar = assignmentRules[(size_t)first]->getVariable();
-
-
-        vector<string>::iterator it = ::find(map[firstVar].begin(), map[firstVar].end(), secondVar);
-
-        if (it != map[firstVar].end())
-        {
-          // found dependency, swap and start over
-          order[i] = second;
-          order[j] = first;
-
-          changed = true;
-          break;
-        }
-      }
-
-      // if swapped start over
-      if (changed)
-        break;
-    }
-  }
-
+  vector<unsigned int> order;
+  graph.sortTopologically(nodes, order);
 
   // create new order
   for (size_t i = 0; i < order.size(); i++)
-    result.push_back(assignmentRules[(size_t)order[i]]);
-
+    result.push_back(assignmentRules[order[i]]);
 
   return result;
 }
 
 
-static vector<InitialAssignment*> reorderInitialAssignments(vector<InitialAssignment*>& intialAssignments)
+/*
+ * Returns the initial assignments in an order where each comes after the
+ * initial assignments whose symbols it uses, moving them as little as
+ * reorderRules() does.
+ */
+static vector<InitialAssignment*> reorderInitialAssignments(DependencyGraph& graph,
+                                    vector<InitialAssignment*>& intialAssignments)
 {
   if (intialAssignments.size() < 2) return intialAssignments;
 
-  map<int, vector<string> > allSymbols;
-  map<string, vector<string> > map;
-  vector<string> idList;
+  vector<unsigned int> nodes;
   vector<InitialAssignment*> result;
 
-  // read id list, initialize all symbols
   for (size_t index = 0; index < intialAssignments.size(); index++)
   {
-    InitialAssignment* ia = (InitialAssignment*)intialAssignments[index];
-    string variable = ia->getSymbol();
-    if (!ia->isSetMath())
-      allSymbols[(int)index] = vector<string>();
-    else
-      allSymbols[(int)index] = getSymbols(ia->getMath());
-    idList.push_back(variable);
-    map[variable] = vector<string>();
-  }
-
-  // initialize order array
-  vector<int> order;
-  for (size_t i = 0; i < intialAssignments.size(); i++)
-  {
-    order.push_back((int)i);
+    nodes.push_back(graph.addNode(intialAssignments[index]->getSymbol()));
   }
 
-  // build dependency graph
-  for (size_t i = 0; i < idList.size(); i++)
-  {
-    string id = idList[i];
-    for (size_t index = 0; index < intialAssignments.size(); index++)
-    {
-      vector<string>::iterator it = ::find(allSymbols[(int)index].begin(), allSymbols[(int)index].end(), id);
-      if (it != allSymbols[(int)index].end())
-      {
-        map[(intialAssignments[index])->getSymbol()].push_back(id);
-      }
-    }
-  }
-
-
   // sort
-  bool changed = true;
-  while (changed)
-  {
-    changed = false;
-    for (size_t i = 0; i < order.size(); i++)
-    {
-
-      int first = order[i];
-      for (size_t j = i + 1; j < order.size(); j++)
-      {
-        int second = order[j];
-
-        string secondVar = intialAssignments[(size_t)second]->getSymbol();
-        string firstVar = intialAssignments[(size_t)first]->getSymbol();
-
-
-        vector<string>::iterator it = ::find(map[firstVar].begin(), map[firstVar].end(), secondVar);
-
-        if (it != map[firstVar].end())
-        {
-          // found dependency, swap and start over
-          order[i] = second;
-          order[j] = first;
-
-          changed = true;
-          break;
-        }
-      }
-
-      // if swapped start over
-      if (changed)
-        break;
-    }
-  }
-
+  vector<unsigned int> order;
+  graph.sortTopologically(nodes, order);
 
   // create new order
   for (size_t i = 0; i < order.size(); i++)
-    result.push_back(intialAssignments[(size_t)order[i]]);
+    result.push_back(intialAssignments[order[i]]);
 
   return result;
 }
@@ -382,6 +233,10 @@ SBMLRuleConverter::convert()
   }
 
 
+  // build dependency graph
+  DependencyGraph graph;
+  graph.addModel(*mModel);
+
   vector<AssignmentRule*> assignmentRules;
   unsigned int numRules = mModel->getNumRules();
   // for any math in document replace each function def
@@ -395,7 +250,9 @@ SBMLRuleConverter::convert()
 
   }
 
-  assignmentRules = reorderRules(assignmentRules);
+  // the rules were removed from the back; sort them in document order
+  reverse(assignmentRules.begin(), assignmentRules.end());
+  assignmentRules = reorderRules(graph, assignmentRules);
 
   for (unsigned int i = 0; i < assignmentRules.size();i++)
     mModel->getListOfRules()->insertAndOwn((int)i,assignmentRules[i]);
@@ -408,7 +265,7 @@ SBMLRuleConverter::convert()
     initialAssignments.push_back(mModel->getListOfInitialAssignments()->remove(0));
   }
 
-  initialAssignments = reorderInitialAssignments(initialAssignments);
+  initialAssignments = reorderInitialAssignments(graph, initialAssignments);
 
   for (unsigned int i = 0; i < initialAssignments.size();i++)
     mModel->getListOfInitialAssignments()->appendAndOwn(initialAssignments[i]);
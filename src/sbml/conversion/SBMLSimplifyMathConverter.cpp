@@ -0,0 +1,687 @@
+/**
+ * @file    SBMLSimplifyMathConverter.cpp
+ * @brief   Implementation of SBMLSimplifyMathConverter, a converter simplifying the math of a model
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+
+#include <sbml/conversion/SBMLSimplifyMathConverter.h>
+#include <sbml/conversion/SBMLConverterRegistry.h>
+#include <sbml/conversion/SBMLConverterRegister.h>
+#include <sbml/math/ASTNodePool.h>
+#include <sbml/util/MathFilter.h>
+#include <sbml/util/List.h>
+#include <sbml/util/util.h>
+#include <sbml/SBMLDocument.h>
+#include <sbml/Model.h>
+
+#ifdef __cplusplus
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cmath>
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+
+/** @cond doxygenLibsbmlInternal */
+void SBMLSimplifyMathConverter::init()
+{
+  SBMLSimplifyMathConverter converter;
+  SBMLConverterRegistry::getInstance().addConverter(&converter);
+}
+/** @endcond */
+
+
+SBMLSimplifyMathConverter::SBMLSimplifyMathConverter() 
+  : SBMLConverter("SBML Simplify Math Converter")
+{
+
+}
+
+
+SBMLSimplifyMathConverter::SBMLSimplifyMathConverter(const SBMLSimplifyMathConverter& orig) :
+  SBMLConverter(orig)
+{
+}
+
+
+SBMLSimplifyMathConverter&
+SBMLSimplifyMathConverter::operator=(const SBMLSimplifyMathConverter& rhs)
+{
+  if (&rhs != this)
+  {
+    this->SBMLConverter::operator =(rhs);
+  }
+
+  return *this;
+}
+
+
+SBMLSimplifyMathConverter* 
+SBMLSimplifyMathConverter::clone() const
+{
+  return new SBMLSimplifyMathConverter(*this);
+}
+
+
+/*
+ * Destroy this object.
+ */
+SBMLSimplifyMathConverter::~SBMLSimplifyMathConverter ()
+{
+}
+
+
+ConversionProperties
+SBMLSimplifyMathConverter::getDefaultProperties() const
+{
+  static ConversionProperties prop;
+  static bool init = false;
+
+  if (init) 
+  {
+    return prop;
+  }
+  else
+  {
+    prop.addOption("simplifyMath", true,
+                   "Simplify all mathematical expressions in the model");
+    prop.addOption("sortOperands", true,
+                   "Sort the operands of sums and products into a canonical order");
+    init = true;
+    return prop;
+  }
+}
+
+
+bool 
+SBMLSimplifyMathConverter::matchesProperties(const ConversionProperties &props) const
+{
+  if (!props.hasOption("simplifyMath"))
+    return false;
+  return true;
+}
+
+
+bool
+SBMLSimplifyMathConverter::isThreadSafe() const
+{
+  return true;
+}
+
+
+int 
+SBMLSimplifyMathConverter::convert()
+{
+  if (mDocument == NULL) return LIBSBML_INVALID_OBJECT;
+  Model* mModel = mDocument->getModel();
+  if (mModel == NULL) return LIBSBML_INVALID_OBJECT;
+
+  bool sortOperands = getSortOperands();
+  bool success = true;
+
+  MathFilter filter;
+  List* elements = mDocument->getAllElements(&filter);
+
+  // identical math, as left in many places by expanding function
+  // definitions, is only simplified once
+  ASTNodePool pool;
+  map<const ASTNode*, ASTNode*> simplifiedMath;
+
+  for (unsigned int i = 0; i < elements->getSize(); i++)
+  {
+    SBase* element = static_cast<SBase*>(elements->get(i));
+    const ASTNode* math = element->getMath();
+    if (math == NULL) continue;
+
+    const ASTNode* shared = pool.add(math);
+    map<const ASTNode*, ASTNode*>::iterator it = simplifiedMath.find(shared);
+    if (it == simplifiedMath.end())
+    {
+      it = simplifiedMath.insert(
+        make_pair(shared, simplify(math, sortOperands))).first;
+    }
+    const ASTNode* simplified = it->second;
+
+    // only touch the elements whose math actually changed
+    if (!simplified->exactlyEqual(*math) &&
+        element->setMath(simplified) != LIBSBML_OPERATION_SUCCESS)
+    {
+      success = false;
+    }
+  }
+
+  for (map<const ASTNode*, ASTNode*>::iterator it = simplifiedMath.begin();
+       it != simplifiedMath.end(); ++it)
+  {
+    delete it->second;
+  }
+
+  delete elements;
+
+  if (success) return LIBSBML_OPERATION_SUCCESS;
+  return LIBSBML_OPERATION_FAILED;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+bool 
+SBMLSimplifyMathConverter::getSortOperands() const
+{
+  if (getProperties() == NULL)
+  {
+    return true;
+  }
+  else if (getProperties()->hasOption("sortOperands") == false)
+  {
+    return true;
+  }
+  else
+  {
+    return getProperties()->getBoolValue("sortOperands");
+  }
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * Nodes that carry more than their type, name, value and children are
+ * never rewritten, so that nothing a user attached to them gets lost.
+ */
+static bool
+isPlain(const ASTNode* node)
+{
+  return !node->isSetId() && !node->isSetClass() && !node->isSetStyle()
+    && !node->getSemanticsFlag() && node->getNumSemanticsAnnotations() == 0;
+}
+
+
+/*
+ * A number that may be folded: it has no units and nothing attached.
+ */
+static bool
+isFoldable(const ASTNode* node)
+{
+  return node->isNumber() && !node->isSetUnits() && isPlain(node);
+}
+
+
+static bool
+isFoldable(const ASTNode* node, double value)
+{
+  return isFoldable(node) && node->getValue() == value;
+}
+
+
+static bool
+isInteger(const ASTNode* node)
+{
+  return node->getType() == AST_INTEGER;
+}
+
+
+/*
+ * Creates a number node; integral results of integer arithmetic stay
+ * integers as long as they are representable as such everywhere.
+ */
+static ASTNode*
+newNumber(double value, bool integer)
+{
+  ASTNode* node = new ASTNode(AST_REAL);
+
+  if (integer && value == floor(value) && fabs(value) <= 2147483647.0)
+  {
+    node->setValue((long)value);
+  }
+  else
+  {
+    node->setValue(value);
+  }
+
+  return node;
+}
+
+
+/*
+ * Computes the value of a node of the given type applied to the given
+ * numbers.  Returns false if the operation is not one that is folded.
+ */
+static bool
+fold(ASTNodeType_t type, const vector<double>& args, double& result)
+{
+  size_t n = args.size();
+
+  switch (type)
+  {
+  case AST_PLUS:
+    result = 0;
+    for (size_t i = 0; i < n; i++) result += args[i];
+    return true;
+
+  case AST_TIMES:
+    result = 1;
+    for (size_t i = 0; i < n; i++) result *= args[i];
+    return true;
+
+  case AST_MINUS:
+    if (n == 1) result = -args[0];
+    else if (n == 2) result = args[0] - args[1];
+    else return false;
+    return true;
+
+  case AST_DIVIDE:
+    if (n != 2) return false;
+    result = args[0] / args[1];
+    return true;
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    if (n != 2) return false;
+    result = pow(args[0], args[1]);
+    return true;
+
+  case AST_FUNCTION_ROOT:
+    if (n == 1) result = sqrt(args[0]);
+    else if (n == 2) result = pow(args[1], 1.0 / args[0]);
+    else return false;
+    return true;
+
+  case AST_FUNCTION_LOG:
+    if (n == 1) result = log10(args[0]);
+    else if (n == 2) result = log(args[1]) / log(args[0]);
+    else return false;
+    return true;
+
+  case AST_FUNCTION_EXP:
+    if (n != 1) return false;
+    result = exp(args[0]);
+    return true;
+
+  case AST_FUNCTION_LN:
+    if (n != 1) return false;
+    result = log(args[0]);
+    return true;
+
+  case AST_FUNCTION_ABS:
+    if (n != 1) return false;
+    result = fabs(args[0]);
+    return true;
+
+  case AST_FUNCTION_FLOOR:
+    if (n != 1) return false;
+    result = floor(args[0]);
+    return true;
+
+  case AST_FUNCTION_CEILING:
+    if (n != 1) return false;
+    result = ceil(args[0]);
+    return true;
+
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * The result of folding keeps the integer type only for operations that
+ * map integers onto integers.
+ */
+static bool
+keepsIntegers(ASTNodeType_t type)
+{
+  switch (type)
+  {
+  case AST_PLUS:
+  case AST_TIMES:
+  case AST_MINUS:
+  case AST_FUNCTION_ABS:
+  case AST_FUNCTION_FLOOR:
+  case AST_FUNCTION_CEILING:
+    return true;
+  default:
+    return false;
+  }
+}
+
+
+/*
+ * The order used for the operands of sums and products: numbers, then
+ * constants and csymbols, then identifiers, then everything else.
+ */
+static int
+getOrderRank(const ASTNode* node)
+{
+  if (node->isNumber()) return 0;
+  if (node->isName()) return 2;
+  if (node->isConstant() || node->getType() == AST_NAME_TIME 
+    || node->getType() == AST_NAME_AVOGADRO) return 1;
+  return 3;
+}
+
+
+static int
+compareNodes(const ASTNode* a, const ASTNode* b)
+{
+  int ra = getOrderRank(a);
+  int rb = getOrderRank(b);
+  if (ra != rb) return ra < rb ? -1 : 1;
+
+  if (ra == 0)
+  {
+    double va = a->getValue();
+    double vb = b->getValue();
+    if (va < vb) return -1;
+    if (vb < va) return 1;
+  }
+
+  if (a->getType() != b->getType())
+  {
+    return a->getType() < b->getType() ? -1 : 1;
+  }
+
+  const char* na = a->getName();
+  const char* nb = b->getName();
+  if (na != NULL && nb != NULL)
+  {
+    int result = strcmp(na, nb);
+    if (result != 0) return result;
+  }
+
+  unsigned int ca = a->getNumChildren();
+  unsigned int cb = b->getNumChildren();
+  if (ca != cb) return ca < cb ? -1 : 1;
+
+  for (unsigned int i = 0; i < ca; i++)
+  {
+    int result = compareNodes(a->getChild(i), b->getChild(i));
+    if (result != 0) return result;
+  }
+
+  return 0;
+}
+
+
+static bool
+nodeLessThan(const ASTNode* a, const ASTNode* b)
+{
+  return compareNodes(a, b) < 0;
+}
+
+
+static void
+deleteAll(vector<ASTNode*>& nodes)
+{
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    delete nodes[i];
+  }
+  nodes.clear();
+}
+
+
+/*
+ * Simplifies the operands of a sum or product: merges nested operators of
+ * the same type, combines the numbers into one and drops it if it is the
+ * identity.  Returns the node replacing the operator, or NULL if the
+ * operator stays with the (updated) operands.
+ */
+static ASTNode*
+simplifyNary(ASTNodeType_t type, vector<ASTNode*>& kids, bool sortOperands)
+{
+  vector<ASTNode*> operands;
+  for (size_t i = 0; i < kids.size(); i++)
+  {
+    ASTNode* kid = kids[i];
+    if (kid->getType() == type && isPlain(kid))
+    {
+      for (unsigned int c = 0; c < kid->getNumChildren(); c++)
+      {
+        operands.push_back(kid->getChild(c));
+      }
+      // the grandchildren now belong to this operator
+      while (kid->getNumChildren() > 0)
+      {
+        kid->removeChild(kid->getNumChildren() - 1);
+      }
+      delete kid;
+    }
+    else
+    {
+      operands.push_back(kid);
+    }
+  }
+  kids.clear();
+
+  double identity = (type == AST_PLUS) ? 0 : 1;
+  double value = identity;
+  bool integer = true;
+  size_t numNumbers = 0;
+  size_t first = operands.size();
+
+  for (size_t i = 0; i < operands.size(); i++)
+  {
+    if (isFoldable(operands[i]))
+    {
+      value = (type == AST_PLUS) ? value + operands[i]->getValue() 
+                                 : value * operands[i]->getValue();
+      integer = integer && isInteger(operands[i]);
+      if (numNumbers == 0) first = i;
+      numNumbers++;
+    }
+  }
+
+  if (numNumbers > 0 && util_isFinite(value))
+  {
+    ASTNode* number = NULL;
+    if (value != identity && numNumbers > 1)
+    {
+      number = newNumber(value, integer);
+    }
+    else if (value != identity)
+    {
+      number = operands[first];
+      operands[first] = NULL;
+    }
+
+    for (size_t i = 0; i < operands.size(); i++)
+    {
+      if (i == first && number != NULL)
+      {
+        kids.push_back(number);
+      }
+
+      if (operands[i] == NULL) continue;
+
+      if (isFoldable(operands[i]))
+      {
+        delete operands[i];
+      }
+      else
+      {
+        kids.push_back(operands[i]);
+      }
+    }
+  }
+  else
+  {
+    kids = operands;
+  }
+
+  if (sortOperands)
+  {
+    stable_sort(kids.begin(), kids.end(), nodeLessThan);
+  }
+
+  if (kids.empty())
+  {
+    return newNumber(identity, integer);
+  }
+  else if (kids.size() == 1)
+  {
+    ASTNode* result = kids[0];
+    kids.clear();
+    return result;
+  }
+
+  return NULL;
+}
+
+
+/*
+ * Takes ownership of node and returns the simplified expression, which
+ * may be node itself, one of its (former) descendants or a new node.
+ */
+static ASTNode*
+simplifyNode(ASTNode* node, bool sortOperands)
+{
+  unsigned int numChildren = node->getNumChildren();
+  vector<ASTNode*> kids(numChildren);
+
+  for (unsigned int i = numChildren; i > 0; i--)
+  {
+    kids[i - 1] = node->getChild(i - 1);
+    node->removeChild(i - 1);
+  }
+
+  for (unsigned int i = 0; i < numChildren; i++)
+  {
+    kids[i] = simplifyNode(kids[i], sortOperands);
+  }
+
+  ASTNode* result = NULL;
+  ASTNodeType_t type = node->getType();
+
+  if (isPlain(node) && numChildren > 0)
+  {
+    bool allNumbers = true;
+    bool allIntegers = true;
+    vector<double> args;
+    for (unsigned int i = 0; i < numChildren; i++)
+    {
+      allNumbers = allNumbers && isFoldable(kids[i]);
+      allIntegers = allIntegers && isInteger(kids[i]);
+      args.push_back(kids[i]->getValue());
+    }
+
+    double value;
+    if (allNumbers && fold(type, args, value) && util_isFinite(value))
+    {
+      result = newNumber(value, allIntegers && keepsIntegers(type));
+      deleteAll(kids);
+    }
+    else if (type == AST_PLUS || type == AST_TIMES)
+    {
+      result = simplifyNary(type, kids, sortOperands);
+    }
+    else if (type == AST_MINUS && numChildren == 1)
+    {
+      // -(-x) is x
+      ASTNode* kid = kids[0];
+      if (kid->getType() == AST_MINUS && kid->getNumChildren() == 1 
+        && isPlain(kid))
+      {
+        result = kid->getChild(0);
+        kid->removeChild(0);
+        deleteAll(kids);
+      }
+    }
+    else if (numChildren == 2)
+    {
+      ASTNode* lhs = kids[0];
+      ASTNode* rhs = kids[1];
+
+      if ((type == AST_MINUS && isFoldable(rhs, 0)) ||
+          (type == AST_DIVIDE && isFoldable(rhs, 1)) ||
+          ((type == AST_POWER || type == AST_FUNCTION_POWER) 
+            && isFoldable(rhs, 1)))
+      {
+        result = lhs;
+        delete rhs;
+        kids.clear();
+      }
+      else if ((type == AST_POWER || type == AST_FUNCTION_POWER) 
+        && isFoldable(rhs, 0))
+      {
+        result = newNumber(1, true);
+        deleteAll(kids);
+      }
+    }
+  }
+
+  if (result != NULL)
+  {
+    deleteAll(kids);
+    delete node;
+    return result;
+  }
+
+  for (size_t i = 0; i < kids.size(); i++)
+  {
+    node->addChild(kids[i], true);
+  }
+
+  return node;
+}
+
+/** @endcond */
+
+
+ASTNode*
+SBMLSimplifyMathConverter::simplify(const ASTNode* math, bool sortOperands)
+{
+  if (math == NULL) return NULL;
+
+  return simplifyNode(math->deepCopy(), sortOperands);
+}
+
+
+/** @cond doxygenIgnored */
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
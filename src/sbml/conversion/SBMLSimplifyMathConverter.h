@@ -0,0 +1,256 @@
+/**
+ * @file    SBMLSimplifyMathConverter.h
+ * @brief   Definition of SBMLSimplifyMathConverter, a converter simplifying the math of a model
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class SBMLSimplifyMathConverter
+ * @sbmlbrief{core} Converter to simplify the mathematical expressions of a model.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * Models produced by other conversions (for example the expansion of
+ * function definitions, the promotion of local parameters or the
+ * flattening of hierarchical models) frequently contain expressions such
+ * as <code>1 * x</code>, <code>x^1</code>, <code>-(-x)</code> or whole
+ * sub-expressions made up of numbers only.  This converter rewrites every
+ * mathematical expression in the document into an equivalent, smaller one:
+ *
+ * @li sub-expressions whose operands are all numbers are replaced by their
+ * value (constant folding), as are the numeric operands of a sum or product;
+ * @li identities such as <code>x + 0</code>, <code>x - 0</code>,
+ * <code>x * 1</code>, <code>x / 1</code>, <code>x^1</code>,
+ * <code>x^0</code> and <code>-(-x)</code> are removed;
+ * @li sums nested in sums and products nested in products are merged into
+ * a single n-ary operator; and
+ * @li optionally, the operands of sums and products are sorted into a
+ * canonical order, so that equivalent expressions are written the same way.
+ *
+ * The rewriting is conservative: numbers carrying units, and nodes
+ * carrying an id, class, style or semantic annotation, are left as they
+ * are, and a result is only folded when it is a finite number.  Products
+ * with a zero factor are not collapsed, since <code>0 * x</code> is not
+ * zero when @c x is infinite or not a number.  (ASTNode::derivative()
+ * does drop such terms, and documents why.)
+ *
+ * Expressions occurring more than once in a model, as is common after the
+ * expansion of function definitions, are recognised with an ASTNodePool and
+ * simplified only once.
+ *
+ * @section usage Configuration and use of SBMLSimplifyMathConverter
+ *
+ * SBMLSimplifyMathConverter is enabled by creating a ConversionProperties
+ * object with the option @c "simplifyMath", and passing this properties
+ * object to SBMLDocument::convert(@if java ConversionProperties@endif).
+ * The converter accepts one option:
+ *
+ * @li @c "sortOperands": if @c true (the default), the operands of sums and
+ * products are sorted into a canonical order (numbers first, then
+ * constants, then identifiers in alphabetical order, then any other
+ * expressions).
+ *
+ * @copydetails doc_section_using_sbml_converters
+ */
+
+#ifndef SBMLSimplifyMathConverter_h
+#define SBMLSimplifyMathConverter_h
+
+#include <sbml/SBMLNamespaces.h>
+#include <sbml/conversion/SBMLConverter.h>
+#include <sbml/conversion/SBMLConverterRegister.h>
+
+
+#ifdef __cplusplus
+
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+
+class LIBSBML_EXTERN SBMLSimplifyMathConverter : public SBMLConverter
+{
+public:
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Register with the ConversionRegistry.
+   */
+  static void init();
+
+  /** @endcond */
+
+
+  /**
+   * Creates a new SBMLSimplifyMathConverter object.
+   */
+  SBMLSimplifyMathConverter();
+
+
+  /**
+   * Copy constructor; creates a copy of an SBMLSimplifyMathConverter
+   * object.
+   *
+   * @param obj the SBMLSimplifyMathConverter object to copy.
+   */
+  SBMLSimplifyMathConverter(const SBMLSimplifyMathConverter& obj);
+
+
+  /**
+   * Assignment operator for SBMLSimplifyMathConverter.
+   *
+   * @param rhs the object whose values are used as the basis of the
+   * assignment.
+   */
+  SBMLSimplifyMathConverter& operator=(const SBMLSimplifyMathConverter& rhs);
+
+
+  /**
+   * Creates and returns a deep copy of this SBMLSimplifyMathConverter
+   * object.
+   *
+   * @return a (deep) copy of this converter.
+   */
+  virtual SBMLSimplifyMathConverter* clone() const;
+
+
+  /**
+   * Destroy this SBMLSimplifyMathConverter object.
+   */
+  virtual ~SBMLSimplifyMathConverter ();
+
+
+  /**
+   * Returns @c true if this converter object's properties match the given
+   * properties.
+   *
+   * A typical use of this method involves creating a ConversionProperties
+   * object, setting the options desired, and then calling this method on
+   * an SBMLSimplifyMathConverter object to find out if the object's
+   * property values match the given ones.  This method is also used by
+   * SBMLConverterRegistry::getConverterFor(@if java ConversionProperties@endif)
+   * to search across all registered converters for one matching particular
+   * properties.
+   *
+   * @param props the properties to match.
+   *
+   * @return @c true if this converter's properties match, @c false
+   * otherwise.
+   */
+  virtual bool matchesProperties(const ConversionProperties &props) const;
+
+
+  /**
+   * Returns @c true: simplifying math only changes the document being
+   * converted, so a batch of documents may be converted on several
+   * threads.
+   */
+  virtual bool isThreadSafe() const;
+
+
+  /**
+   * Perform the conversion.
+   *
+   * This method causes the converter to do the actual conversion work,
+   * that is, to convert the SBMLDocument object set by
+   * SBMLConverter::setDocument(@if java SBMLDocument@endif) and
+   * with the configuration options set by
+   * SBMLConverter::setProperties(@if java ConversionProperties@endif).
+   *
+   * @copydetails doc_returns_success_code
+   * @li @sbmlconstant{LIBSBML_OPERATION_SUCCESS, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_OPERATION_FAILED, OperationReturnValues_t}
+   * @li @sbmlconstant{LIBSBML_INVALID_OBJECT, OperationReturnValues_t}
+   */
+  virtual int convert();
+
+
+  /**
+   * Returns the default properties of this converter.
+   *
+   * A given converter exposes one or more properties that can be adjusted
+   * in order to influence the behavior of the converter.  This method
+   * returns the @em default property settings for this converter.  It is
+   * meant to be called in order to discover all the settings for the
+   * converter object.
+   *
+   * @return the ConversionProperties object describing the default properties
+   * for this converter.
+   */
+  virtual ConversionProperties getDefaultProperties() const;
+
+
+  /**
+   * Returns a simplified copy of the given expression.
+   *
+   * This applies the same rewriting as convert() does to every expression
+   * of a model, and can be used on expressions that are not part of a
+   * document.  The caller owns the returned node.
+   *
+   * @param math the expression to simplify.
+   * @param sortOperands whether the operands of sums and products should be
+   * sorted into a canonical order.
+   *
+   * @return the simplified expression, or @c NULL if @p math is @c NULL.
+   */
+  static ASTNode* simplify(const ASTNode* math, bool sortOperands = true);
+
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+  bool getSortOperands() const;
+
+  /** @endcond */
+
+
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+
+
+#ifndef SWIG
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+BEGIN_C_DECLS
+
+
+END_C_DECLS
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* !SWIG */
+#endif  /* SBMLSimplifyMathConverter_h */
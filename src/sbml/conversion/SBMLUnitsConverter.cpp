@@ -144,6 +144,16 @@ SBMLUnitsConverter::matchesProperties(const ConversionProperties &props) const
 }
 
 
+void
+SBMLUnitsConverter::reset()
+{
+  mGlobalUnits.clear();
+  newIdCount = 0;
+
+  SBMLConverter::reset();
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 bool
 SBMLUnitsConverter::getRemoveUnusedUnitsFlag()
@@ -239,6 +249,7 @@ SBMLUnitsConverter::convert()
   }
 
   //create a copy of any global units
+  mGlobalUnits.clear();
   if (m->getLevel() > 2)
   {
     if (m->isSetSubstanceUnits() == true)
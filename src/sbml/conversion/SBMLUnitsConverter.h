@@ -182,6 +182,12 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and the model-wide units recorded from it.
+   */
+  virtual void reset();
+
+
   /**
    * Returns the default properties of this converter.
    *
@@ -46,6 +46,7 @@
 
 #include <sbml/conversion/SBMLInferUnitsConverter.h>
 #include <sbml/conversion/ConversionProperties.h>
+#include <sbml/util/ParallelTask.h>
 
 
 
@@ -392,6 +393,189 @@ START_TEST (test_infer_localParam_fromReaction)
 END_TEST
 
 
+/*
+ * b can only be inferred from y := a * b once a has been given the units
+ * inferred from k := a.
+ */
+static SBMLDocument*
+createChainedInferenceDocument()
+{
+  SBMLDocument* d = new SBMLDocument(2, 4);
+  Model* m = d->createModel();
+  m->setId("chain");
+
+  Parameter* p = m->createParameter();
+  p->setId("k");
+  p->setUnits("second");
+  p->setConstant(false);
+
+  p = m->createParameter();
+  p->setId("y");
+  p->setUnits("metre");
+  p->setConstant(false);
+
+  p = m->createParameter();
+  p->setId("a");
+  p->setValue(1);
+
+  p = m->createParameter();
+  p->setId("b");
+  p->setValue(1);
+
+  AssignmentRule* r = m->createAssignmentRule();
+  r->setVariable("k");
+  ASTNode* math = SBML_parseFormula("a");
+  r->setMath(math);
+  delete math;
+
+  r = m->createAssignmentRule();
+  r->setVariable("y");
+  math = SBML_parseFormula("a * b");
+  r->setMath(math);
+  delete math;
+
+  return d;
+}
+
+
+START_TEST (test_infer_chained)
+{
+  SBMLDocument* d = createChainedInferenceDocument();
+
+  SBMLInferUnitsConverter * units = new SBMLInferUnitsConverter();
+  units->setDocument(d);
+
+  fail_unless (units->convert() == LIBSBML_OPERATION_SUCCESS);
+
+  Model* m = d->getModel();
+  fail_unless(m->getParameter("a")->getUnits() == "second");
+  fail_unless(m->getParameter("b")->getUnits() == "unitSid_0");
+
+  UnitDefinition *ud = m->getUnitDefinition("unitSid_0");
+
+  fail_unless(ud != NULL);
+  fail_unless(ud->getNumUnits() == 2);
+  fail_unless(ud->getUnit(0)->getKind() == UNIT_KIND_METRE);
+  fail_unless(ud->getUnit(0)->getExponent() == 1);
+  fail_unless(ud->getUnit(1)->getKind() == UNIT_KIND_SECOND);
+  fail_unless(ud->getUnit(1)->getExponent() == -1);
+
+  delete units;
+  delete d;
+}
+END_TEST
+
+
+START_TEST (test_infer_sameForAnyNumberOfThreads)
+{
+  string filename(TestDataDirectory);
+  filename += "inferUnits-2.xml";
+
+  SBMLDocument* d1 = readSBMLFromFile(filename.c_str());
+  SBMLDocument* d2 = d1->clone();
+  SBMLDocument* d3 = createChainedInferenceDocument();
+  SBMLDocument* d4 = createChainedInferenceDocument();
+
+  // the ids of new unit definitions are numbered per converter
+  SBMLInferUnitsConverter units1;
+  SBMLInferUnitsConverter units2;
+  SBMLInferUnitsConverter units3;
+  SBMLInferUnitsConverter units4;
+
+  ParallelTask::setMaxThreads(1);
+  units1.setDocument(d1);
+  fail_unless (units1.convert() == LIBSBML_OPERATION_SUCCESS);
+  units3.setDocument(d3);
+  fail_unless (units3.convert() == LIBSBML_OPERATION_SUCCESS);
+
+  ParallelTask::setMaxThreads(4);
+  units2.setDocument(d2);
+  fail_unless (units2.convert() == LIBSBML_OPERATION_SUCCESS);
+  units4.setDocument(d4);
+  fail_unless (units4.convert() == LIBSBML_OPERATION_SUCCESS);
+
+  ParallelTask::setMaxThreads(0);
+
+  char* s1 = d1->toSBML();
+  char* s2 = d2->toSBML();
+  fail_unless(strcmp(s1, s2) == 0);
+  safe_free(s1);
+  safe_free(s2);
+
+  s1 = d3->toSBML();
+  s2 = d4->toSBML();
+  fail_unless(strcmp(s1, s2) == 0);
+  safe_free(s1);
+  safe_free(s2);
+
+  delete d1;
+  delete d2;
+  delete d3;
+  delete d4;
+}
+END_TEST
+
+
+/*
+ * Each a_i is inferred from y_i := a_i^n, which evaluates n; the
+ * parameters are inferred on several threads at once.
+ */
+START_TEST (test_infer_powers_inParallel)
+{
+  SBMLDocument* d = new SBMLDocument(2, 4);
+  Model* m = d->createModel();
+
+  UnitDefinition* ud = m->createUnitDefinition();
+  ud->setId("area_m2");
+  Unit* u = ud->createUnit();
+  u->setKind(UNIT_KIND_METRE);
+  u->setExponent(2);
+
+  Parameter* p = m->createParameter();
+  p->setId("n");
+  p->setUnits("dimensionless");
+  p->setValue(2);
+
+  char id[16];
+  for (int i = 0; i < 32; i++)
+  {
+    sprintf(id, "a_%d", i);
+    p = m->createParameter();
+    p->setId(id);
+    p->setValue(1);
+
+    sprintf(id, "y_%d", i);
+    p = m->createParameter();
+    p->setId(id);
+    p->setUnits("area_m2");
+    p->setConstant(false);
+
+    AssignmentRule* r = m->createAssignmentRule();
+    r->setVariable(id);
+    sprintf(id, "a_%d^n", i);
+    ASTNode* math = SBML_parseL3Formula(id);
+    r->setMath(math);
+    delete math;
+  }
+
+  SBMLInferUnitsConverter units;
+  units.setDocument(d);
+
+  ParallelTask::setMaxThreads(4);
+  fail_unless (units.convert() == LIBSBML_OPERATION_SUCCESS);
+  ParallelTask::setMaxThreads(0);
+
+  for (int i = 0; i < 32; i++)
+  {
+    sprintf(id, "a_%d", i);
+    fail_unless(m->getParameter(id)->getUnits() == "metre");
+  }
+
+  delete d;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestInferUnitsConverter (void)
 { 
@@ -409,6 +593,9 @@ create_suite_TestInferUnitsConverter (void)
   tcase_add_test(tcase, test_infer_baseUnit_fromMath);
   tcase_add_test(tcase, test_infer_fromReaction);
   tcase_add_test(tcase, test_infer_localParam_fromReaction);
+  tcase_add_test(tcase, test_infer_chained);
+  tcase_add_test(tcase, test_infer_sameForAnyNumberOfThreads);
+  tcase_add_test(tcase, test_infer_powers_inParallel);
 
   suite_add_tcase(suite, tcase);
 
@@ -73,6 +73,7 @@ Suite *create_suite_TestInferUnitsConverter (void);
 Suite *create_suite_TestStripPackageConverter (void);
 Suite *create_suite_TestLevelVersionConverter(void);
 Suite *create_suite_TestRateOfConverter(void);
+Suite *create_suite_TestSimplifyMathConverter(void);
 
 
 /**
@@ -129,6 +130,7 @@ main (void)
   srunner_add_suite( runner, create_suite_TestStripPackageConverter  () );
   srunner_add_suite( runner, create_suite_TestLevelVersionConverter  () );
   srunner_add_suite( runner, create_suite_TestRateOfConverter        () );
+  srunner_add_suite( runner, create_suite_TestSimplifyMathConverter  () );
 
   /* srunner_set_fork_status(runner, CK_NOFORK); */
 
@@ -50,6 +50,7 @@
 #include <sbml/SBMLTypes.h>
 
 #include <string>
+#include <vector>
 
 #include <check.h>
 
@@ -175,6 +176,194 @@ START_TEST (test_conversion_inline)
 }
 END_TEST
 
+static SBMLDocument*
+createDocumentWithLocalParameter(const std::string& id)
+{
+  SBMLDocument* doc = new SBMLDocument(3, 1);
+  Model* model = doc->createModel();
+  model->setId(id);
+
+  Reaction* r = model->createReaction();
+  r->setId("r");
+  r->setReversible(false);
+  r->setFast(false);
+
+  KineticLaw* kl = r->createKineticLaw();
+  LocalParameter* lp = kl->createLocalParameter();
+  lp->setId("k");
+  lp->setValue(1.0);
+  kl->setMath(SBML_parseL3Formula("k"));
+
+  return doc;
+}
+
+
+START_TEST (test_conversion_registry_getSameKeys)
+{
+  ConversionProperties props;
+  props.addOption("promoteLocalParameters");
+
+  SBMLConverter* first = SBMLConverterRegistry::getInstance().getConverterFor(props);
+  fail_unless(first != NULL);
+
+  // the values of the options do not change the converter found
+  ConversionProperties other;
+  other.addOption("promoteLocalParameters", false);
+
+  SBMLConverter* second = SBMLConverterRegistry::getInstance().getConverterFor(other);
+  fail_unless(second != NULL);
+  fail_unless(second->getName() == first->getName());
+  fail_unless(second->getProperties()->getBoolValue("promoteLocalParameters") == false);
+
+  delete first;
+  delete second;
+
+  ConversionProperties none;
+  none.addOption("no such conversion");
+  fail_unless(SBMLConverterRegistry::getInstance().getConverterFor(none) == NULL);
+  fail_unless(SBMLConverterRegistry::getInstance().getConverterFor(none) == NULL);
+}
+END_TEST
+
+
+START_TEST (test_conversion_registry_reuse)
+{
+  ConversionProperties props;
+  props.addOption("promoteLocalParameters");
+
+  SBMLConverter* converter = SBMLConverterRegistry::getInstance().getConverterFor(props);
+  fail_unless(converter != NULL);
+
+  for (int i = 0; i < 3; i++)
+  {
+    SBMLDocument* doc = createDocumentWithLocalParameter("m");
+
+    converter->reset();
+    fail_unless(converter->getDocument() == NULL);
+
+    converter->setDocument(doc);
+    fail_unless(converter->convert() == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(doc->getModel()->getNumParameters() == 1);
+    fail_unless(doc->getModel()->getReaction(0)->getKineticLaw()->getNumLocalParameters() == 0);
+
+    delete doc;
+  }
+
+  converter->reset();
+  delete converter;
+}
+END_TEST
+
+
+START_TEST (test_conversion_registry_batch)
+{
+  ConversionProperties props;
+  props.addOption("promoteLocalParameters");
+
+  std::vector<SBMLDocument*> docs;
+  for (int i = 0; i < 10; i++)
+  {
+    docs.push_back(createDocumentWithLocalParameter("m"));
+  }
+
+  std::vector<int> results;
+  int result = SBMLConverterRegistry::getInstance().convert(docs, props, &results, 4);
+
+  fail_unless(result == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(results.size() == docs.size());
+
+  for (size_t i = 0; i < docs.size(); i++)
+  {
+    fail_unless(results[i] == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(docs[i]->getModel()->getNumParameters() == 1);
+    fail_unless(docs[i]->getModel()->getParameter(0)->getId() == "r_k");
+    delete docs[i];
+  }
+
+  // a missing document fails on its own
+  docs.clear();
+  docs.push_back(createDocumentWithLocalParameter("m"));
+  docs.push_back(NULL);
+
+  result = SBMLConverterRegistry::getInstance().convert(docs, props, &results);
+
+  fail_unless(result == LIBSBML_INVALID_OBJECT);
+  fail_unless(results[0] == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(results[1] == LIBSBML_INVALID_OBJECT);
+  delete docs[0];
+
+  ConversionProperties none;
+  none.addOption("no such conversion");
+  fail_unless(SBMLConverterRegistry::getInstance().convert(docs, none)
+              == LIBSBML_CONV_CONVERSION_NOT_AVAILABLE);
+}
+END_TEST
+
+
+START_TEST (test_conversion_registry_batch_initialAssignments)
+{
+  ConversionProperties props;
+  props.addOption("expandInitialAssignments", true);
+
+  // expanding initial assignments validates the documents and evaluates
+  // math, which uses state shared by the whole process
+  SBMLConverter* converter = 
+    SBMLConverterRegistry::getInstance().getConverterFor(props);
+  fail_unless(converter != NULL);
+  fail_unless(converter->isThreadSafe() == false);
+  delete converter;
+
+  ConversionProperties promote;
+  promote.addOption("promoteLocalParameters", true);
+  converter = SBMLConverterRegistry::getInstance().getConverterFor(promote);
+  fail_unless(converter != NULL);
+  fail_unless(converter->isThreadSafe() == true);
+  delete converter;
+
+  std::vector<SBMLDocument*> docs;
+  for (int i = 0; i < 16; i++)
+  {
+    SBMLDocument* doc = new SBMLDocument(3, 1);
+    Model* model = doc->createModel();
+    model->setId("m");
+
+    Parameter* k = model->createParameter();
+    k->setId("k");
+    k->setValue(i);
+    k->setConstant(true);
+
+    Parameter* p = model->createParameter();
+    p->setId("p");
+    p->setConstant(true);
+
+    InitialAssignment* ia = model->createInitialAssignment();
+    ia->setSymbol("p");
+    ASTNode* math = SBML_parseL3Formula("2 * k + 1");
+    ia->setMath(math);
+    delete math;
+
+    docs.push_back(doc);
+  }
+
+  std::vector<int> results;
+  int result = 
+    SBMLConverterRegistry::getInstance().convert(docs, props, &results, 4);
+
+  fail_unless(result == LIBSBML_OPERATION_SUCCESS);
+
+  for (size_t i = 0; i < docs.size(); i++)
+  {
+    Model* model = docs[i]->getModel();
+    fail_unless(results[i] == LIBSBML_OPERATION_SUCCESS);
+    fail_unless(model->getNumInitialAssignments() == 0);
+    fail_unless(model->getParameter("p")->isSetValue());
+    fail_unless(model->getParameter("p")->getValue() == 2.0 * i + 1);
+    delete docs[i];
+  }
+}
+END_TEST
+
+
 Suite *
 create_suite_TestSBMLConverterRegistry (void)
 { 
@@ -184,6 +373,10 @@ create_suite_TestSBMLConverterRegistry (void)
   
   tcase_add_test(tcase, test_conversion_registry_get);
   tcase_add_test(tcase, test_conversion_registry_getByIndex);
+  tcase_add_test(tcase, test_conversion_registry_getSameKeys);
+  tcase_add_test(tcase, test_conversion_registry_reuse);
+  tcase_add_test(tcase, test_conversion_registry_batch);
+  tcase_add_test(tcase, test_conversion_registry_batch_initialAssignments);
 
   tcase_add_test(tcase, test_conversion_units);
   tcase_add_test(tcase, test_conversion_parameters);
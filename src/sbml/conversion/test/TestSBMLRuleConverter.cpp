@@ -109,6 +109,108 @@ START_TEST (test_conversion_ruleconverter_sort)
 END_TEST
 
 
+START_TEST (test_conversion_ruleconverter_sortChain)
+{
+  // rules listed in the reverse order of their dependencies
+
+  SBMLDocument doc; 
+
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* ids[] = { "a", "b", "c", "d" };
+  const char* formulas[] = { "b + 1", "c * c", "d + 1", "1" };
+  const char* metaIds[] = { "m1", "m2", "m3", "m4" };
+
+  for (unsigned int i = 0; i < 4; i++)
+  {
+    Parameter* parameter = model->createParameter();
+    parameter->setId(ids[i]);
+    parameter->setConstant(false);
+    parameter->setValue(0);
+  }
+
+  for (unsigned int i = 0; i < 4; i++)
+  {
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(ids[i]);
+    rule->setFormula(formulas[i]);
+    rule->setMetaId(metaIds[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("sortRules", true, "sort rules");
+
+  SBMLConverter* converter = new SBMLRuleConverter();
+  converter->setProperties(&props);
+  converter->setDocument(&doc);
+  
+  fail_unless (converter->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (model->getNumRules() == 4);
+  fail_unless (model->getRule(0)->getMetaId() == "m4");
+  fail_unless (model->getRule(1)->getMetaId() == "m3");
+  fail_unless (model->getRule(2)->getMetaId() == "m2");
+  fail_unless (model->getRule(3)->getMetaId() == "m1");
+
+  delete converter;
+}
+END_TEST
+
+
+START_TEST (test_conversion_ruleconverter_sortIndependent)
+{
+  // only a depends on another rule, so only c has to move ahead of it;
+  // b does not depend on either and stays after a
+
+  SBMLDocument doc; 
+
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* ids[] = { "a", "b", "c" };
+  const char* formulas[] = { "c + 1", "2", "3" };
+  const char* metaIds[] = { "m1", "m2", "m3" };
+
+  for (unsigned int i = 0; i < 3; i++)
+  {
+    Parameter* parameter = model->createParameter();
+    parameter->setId(ids[i]);
+    parameter->setConstant(false);
+    parameter->setValue(0);
+  }
+
+  for (unsigned int i = 0; i < 3; i++)
+  {
+    AssignmentRule* rule = model->createAssignmentRule();
+    rule->setVariable(ids[i]);
+    rule->setFormula(formulas[i]);
+    rule->setMetaId(metaIds[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("sortRules", true, "sort rules");
+
+  SBMLConverter* converter = new SBMLRuleConverter();
+  converter->setProperties(&props);
+  converter->setDocument(&doc);
+  
+  fail_unless (converter->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (model->getNumRules() == 3);
+  fail_unless (model->getRule(0)->getMetaId() == "m3");
+  fail_unless (model->getRule(1)->getMetaId() == "m1");
+  fail_unless (model->getRule(2)->getMetaId() == "m2");
+
+  // the rules are now in order, so converting again changes nothing
+  fail_unless (converter->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (model->getRule(0)->getMetaId() == "m3");
+  fail_unless (model->getRule(1)->getMetaId() == "m1");
+  fail_unless (model->getRule(2)->getMetaId() == "m2");
+
+  delete converter;
+}
+END_TEST
+
+
 START_TEST (test_conversion_ruleconverter_dontSort)
 {
 
@@ -382,6 +484,8 @@ create_suite_TestSBMLRuleConverter (void)
 
   tcase_add_test(tcase, test_conversion_ruleconverter_sort);
   tcase_add_test(tcase, test_conversion_ruleconverter_dontSort);
+  tcase_add_test(tcase, test_conversion_ruleconverter_sortChain);
+  tcase_add_test(tcase, test_conversion_ruleconverter_sortIndependent);
   tcase_add_test(tcase, test_conversion_ruleconverter_with_alg);
   tcase_add_test(tcase, test_conversion_ruleconverter_sortIA);
   tcase_add_test(tcase, test_conversion_ruleconverter_dontSortIA);
@@ -0,0 +1,325 @@
+/**
+ * @file    TestSimplifyMathConverter.cpp
+ * @brief   Tests for the math simplification converter
+ * @author  SBMLTeam
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+
+#include <sbml/SBase.h>
+#include <sbml/SBMLTypes.h>
+
+#include <sbml/conversion/SBMLConverter.h>
+#include <sbml/conversion/SBMLConverterRegistry.h>
+#include <sbml/conversion/SBMLSimplifyMathConverter.h>
+
+#include <sbml/math/FormulaParser.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/L3FormulaFormatter.h>
+
+#include <string>
+
+#include <check.h>
+
+using namespace std;
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+static string
+simplifyFormula(const char* formula, bool sortOperands = true)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  ASTNode* simplified = SBMLSimplifyMathConverter::simplify(math, sortOperands);
+  char* result = SBML_formulaToL3String(simplified);
+  string str(result);
+
+  safe_free(result);
+  delete simplified;
+  delete math;
+
+  return str;
+}
+
+
+static bool
+simplifiesTo(const char* formula, const char* expected, bool sortOperands = true)
+{
+  string actual = simplifyFormula(formula, sortOperands);
+  if (actual == expected) return true;
+
+  printf( "\nSimplifying [%s]:\n", formula );
+  printf( "Expected: [%s]\n", expected );
+  printf( "Actual:   [%s]\n", actual.c_str() );
+  return false;
+}
+
+
+static void
+setMath(SBase* element, const char* formula)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  element->setMath(math);
+  delete math;
+}
+
+
+START_TEST (test_conversion_simplifymath_identities)
+{
+  fail_unless( simplifiesTo("1 * x", "x") );
+  fail_unless( simplifiesTo("x * 1", "x") );
+  fail_unless( simplifiesTo("x + 0", "x") );
+  fail_unless( simplifiesTo("x - 0", "x") );
+  fail_unless( simplifiesTo("x / 1", "x") );
+  fail_unless( simplifiesTo("x^1", "x") );
+  fail_unless( simplifiesTo("pow(x, 1)", "x") );
+  fail_unless( simplifiesTo("x^0", "1") );
+  fail_unless( simplifiesTo("-(-x)", "x") );
+  fail_unless( simplifiesTo("-(-(-x))", "-x") );
+  fail_unless( simplifiesTo("k * 1 * (S^1)", "k * S", false) );
+
+  // zero is only absorbing for finite values
+  fail_unless( simplifiesTo("0 * x", "0 * x") );
+  fail_unless( simplifiesTo("x - x", "x - x") );
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_folding)
+{
+  fail_unless( simplifiesTo("2 * 3", "6") );
+  fail_unless( simplifiesTo("1 + 2 + 3", "6") );
+  fail_unless( simplifiesTo("2 * x * 3", "6 * x") );
+  fail_unless( simplifiesTo("2 * 0.5 * x", "x") );
+  fail_unless( simplifiesTo("x + 1 - 1", "1 + x - 1") );
+  fail_unless( simplifiesTo("2 / 4", "0.5") );
+  fail_unless( simplifiesTo("(1 + 1) * x", "2 * x") );
+  fail_unless( simplifiesTo("2^10 * x", "1024 * x") );
+  fail_unless( simplifiesTo("-(3) + x", "-3 + x") );
+  fail_unless( simplifiesTo("exp(0) * x", "x") );
+  fail_unless( simplifiesTo("sqrt(4) * x", "2 * x") );
+  fail_unless( simplifiesTo("abs(-2) * floor(2.5)", "4") );
+  fail_unless( simplifiesTo("log(100)", "2") );
+
+  // results that are not finite are left alone
+  fail_unless( simplifiesTo("1 / 0", "1 / 0") );
+  fail_unless( simplifiesTo("ln(-1)", "ln(-1)") );
+
+  // so are numbers with units and calls of unknown functions
+  fail_unless( simplifiesTo("2 mole * 3", "2 mole * 3") );
+  fail_unless( simplifiesTo("f(2 * 3)", "f(6)") );
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_flattening)
+{
+  // the L1 parser only creates binary operators
+  ASTNode* math = SBML_parseFormula("(a + b) + (c + (d + e))");
+  fail_unless( math->getNumChildren() == 2 );
+
+  ASTNode* simplified = SBMLSimplifyMathConverter::simplify(math);
+  fail_unless( simplified->getType() == AST_PLUS );
+  fail_unless( simplified->getNumChildren() == 5 );
+
+  delete simplified;
+  delete math;
+
+  fail_unless( simplifiesTo("(a * b) * (c * 2) * 3", "6 * a * b * c") );
+  fail_unless( simplifiesTo("a * (b + c)", "a * (b + c)") );
+  fail_unless( simplifiesTo("a - (b - c)", "a - (b - c)") );
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_ordering)
+{
+  fail_unless( simplifiesTo("b + a", "a + b") );
+  fail_unless( simplifiesTo("b + a", "b + a", false) );
+  fail_unless( simplifiesTo("S2 * k * S1", "S1 * S2 * k") );
+  fail_unless( simplifiesTo("sin(x) + y + 2 + pi", "2 + pi + y + sin(x)") );
+  fail_unless( simplifiesTo("x * 2", "2 * x") );
+  fail_unless( simplifiesTo("x * 2", "x * 2", false) );
+
+  // equivalent sums end up identical
+  ASTNode* a = SBML_parseL3Formula("k2 * S2 + k1 * S1");
+  ASTNode* b = SBML_parseL3Formula("(S1 * k1) + (1 * S2 * k2)");
+  ASTNode* sa = SBMLSimplifyMathConverter::simplify(a);
+  ASTNode* sb = SBMLSimplifyMathConverter::simplify(b);
+
+  fail_unless( sa->exactlyEqual(*sb) );
+
+  delete a;
+  delete b;
+  delete sa;
+  delete sb;
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_keepsAttributes)
+{
+  ASTNode* math = SBML_parseL3Formula("x * 1");
+  math->setId("product");
+
+  ASTNode* simplified = SBMLSimplifyMathConverter::simplify(math);
+  fail_unless( simplified->exactlyEqual(*math) );
+
+  delete simplified;
+  delete math;
+
+  fail_unless( SBMLSimplifyMathConverter::simplify(NULL) == NULL );
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_document)
+{
+  SBMLDocument doc(3, 1);
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  Parameter* p = model->createParameter();
+  p->setId("p");
+  p->setConstant(false);
+
+  Parameter* k = model->createParameter();
+  k->setId("k");
+  k->setConstant(true);
+
+  AssignmentRule* rule = model->createAssignmentRule();
+  rule->setVariable("p");
+  setMath(rule, "k^1 * (2 + 3)");
+
+  Reaction* r = model->createReaction();
+  r->setId("r");
+  KineticLaw* kl = r->createKineticLaw();
+  setMath(kl, "k * p");
+
+  FunctionDefinition* fd = model->createFunctionDefinition();
+  fd->setId("f");
+  setMath(fd, "lambda(x, y, 1 * y * x + 0)");
+
+  ConversionProperties props;
+  props.addOption("simplifyMath", true);
+
+  SBMLConverter* converter = 
+    SBMLConverterRegistry::getInstance().getConverterFor(props);
+  fail_unless( converter != NULL );
+  delete converter;
+
+  fail_unless( doc.convert(props) == LIBSBML_OPERATION_SUCCESS );
+
+  char* formula = SBML_formulaToL3String(rule->getMath());
+  fail_unless( !strcmp(formula, "5 * k") );
+  safe_free(formula);
+
+  formula = SBML_formulaToL3String(kl->getMath());
+  fail_unless( !strcmp(formula, "k * p") );
+  safe_free(formula);
+
+  formula = SBML_formulaToL3String(fd->getMath());
+  fail_unless( !strcmp(formula, "lambda(x, y, x * y)") );
+  safe_free(formula);
+
+  fail_unless( fd->getNumArguments() == 2 );
+  fail_unless( fd->getBody()->getType() == AST_TIMES );
+}
+END_TEST
+
+
+START_TEST (test_conversion_simplifymath_repeatedMath)
+{
+  SBMLDocument doc(3, 1);
+  Model* model = doc.createModel();
+  model->setId("m");
+
+  const char* formulas[] = { "1 * k * S", "k * S * 1", "1 * k * S", 
+                             "1 * k * S", "x + 0", NULL };
+  for (unsigned int i = 0; formulas[i] != NULL; i++)
+  {
+    Reaction* r = model->createReaction();
+    r->setId("r" + string(1, (char)('a' + i)));
+    setMath(r->createKineticLaw(), formulas[i]);
+  }
+
+  ConversionProperties props;
+  props.addOption("simplifyMath", true);
+  fail_unless( doc.convert(props) == LIBSBML_OPERATION_SUCCESS );
+
+  const char* expected[] = { "S * k", "S * k", "S * k", "S * k", "x" };
+  for (unsigned int i = 0; i < model->getNumReactions(); i++)
+  {
+    const ASTNode* math = model->getReaction(i)->getKineticLaw()->getMath();
+    char* formula = SBML_formulaToL3String(math);
+    fail_unless( !strcmp(formula, expected[i]) );
+    safe_free(formula);
+
+    /* every element gets a math object of its own */
+    for (unsigned int j = 0; j < i; j++)
+    {
+      fail_unless( math != model->getReaction(j)->getKineticLaw()->getMath() );
+    }
+  }
+}
+END_TEST
+
+
+Suite *
+create_suite_TestSimplifyMathConverter (void)
+{ 
+  Suite *suite = suite_create("SimplifyMathConverter");
+  TCase *tcase = tcase_create("SimplifyMathConverter");
+
+  tcase_add_test(tcase, test_conversion_simplifymath_identities);
+  tcase_add_test(tcase, test_conversion_simplifymath_folding);
+  tcase_add_test(tcase, test_conversion_simplifymath_flattening);
+  tcase_add_test(tcase, test_conversion_simplifymath_ordering);
+  tcase_add_test(tcase, test_conversion_simplifymath_keepsAttributes);
+  tcase_add_test(tcase, test_conversion_simplifymath_document);
+  tcase_add_test(tcase, test_conversion_simplifymath_repeatedMath);
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
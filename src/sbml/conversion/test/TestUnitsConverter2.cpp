@@ -1132,6 +1132,45 @@ START_TEST (test_convert_model_global1)
 END_TEST
 
 
+START_TEST (test_convert_model_global_reuse)
+{
+  SBMLUnitsConverter * units = new SBMLUnitsConverter();
+  SBMLDocument *d = new SBMLDocument(3, 1);
+  Model * m = d->createModel();
+  m->setVolumeUnits("litre");
+  m->setSubstanceUnits("gram");
+
+  units->setDocument(d);
+
+  fail_unless (units->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (d->getModel()->getVolumeUnits() == "unitSid_0");
+  fail_unless (d->getModel()->getSubstanceUnits() == "kilogram");
+
+  delete d;
+
+  // the units of the first model must not be used for the second one
+  d = new SBMLDocument(3, 1);
+  m = d->createModel();
+  m->setTimeUnits("second");
+  m->setSubstanceUnits("avogadro");
+
+  units->reset();
+  fail_unless (units->getDocument() == NULL);
+
+  units->setDocument(d);
+
+  fail_unless (units->convert() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless (d->getModel()->getNumUnitDefinitions() == 0);
+  fail_unless (d->getModel()->getTimeUnits() == "second");
+  fail_unless (d->getModel()->isSetVolumeUnits() == false);
+  fail_unless (d->getModel()->getSubstanceUnits() == "dimensionless");
+
+  delete units;
+  delete d;
+}
+END_TEST
+
+
 START_TEST (test_convert_global_time_extent)
 {
   string filename(TestDataDirectory);
@@ -2032,6 +2071,7 @@ create_suite_TestUnitsConverter2 (void)
   tcase_add_test(tcase, test_convert_model_substance5);
   tcase_add_test(tcase, test_convert_model_global);
   tcase_add_test(tcase, test_convert_model_global1);
+  tcase_add_test(tcase, test_convert_model_global_reuse);
   tcase_add_test(tcase, test_convert_global_time_extent);
   tcase_add_test(tcase, test_convertCompartment_noSize);
   tcase_add_test(tcase, test_convertSpecies_noInitialValue);
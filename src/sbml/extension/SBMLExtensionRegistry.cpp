@@ -46,6 +46,7 @@
 #include <sbml/SBMLDocument.h>
 #include <sbml/extension/SBasePlugin.h>
 #include <algorithm>
+#include <cctype>
 #include <iostream>
 #include <string>
 
@@ -212,6 +213,7 @@ SBMLExtensionRegistry::addExtension (const SBMLExtension* sbmlExt)
     astPlugin->setSBMLExtension(sbmlExtClone);
 
     mASTPluginsVector.push_back(astPlugin);
+    addToASTPluginTables(astPlugin);
   }
 
   return LIBSBML_OPERATION_SUCCESS;
@@ -608,6 +610,141 @@ SBMLExtensionRegistry::getASTPlugin(unsigned int i)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+static std::string
+toUpperASTName(const std::string& name)
+{
+  std::string result(name);
+  for (size_t i = 0; i < result.size(); ++i)
+  {
+    result[i] = (char)toupper(result[i]);
+  }
+  return result;
+}
+
+
+/*
+ * Adds a plugin to a list of the dispatch tables, unless it is there
+ * already because it defines the name twice.
+ */
+static void
+addToASTPluginList(std::vector<const ASTBasePlugin*>& plugins,
+                   const ASTBasePlugin* astPlugin)
+{
+  if (std::find(plugins.begin(), plugins.end(), astPlugin) == plugins.end())
+  {
+    plugins.push_back(astPlugin);
+  }
+}
+
+
+/*
+ * Returns the first plugin of the list that is enabled for the given
+ * namespaces, or the first one if no namespaces are given.
+ */
+static const ASTBasePlugin*
+selectASTPlugin(const std::vector<const ASTBasePlugin*>& plugins,
+                const SBMLNamespaces* sbmlns)
+{
+  for (size_t i = 0; i < plugins.size(); ++i)
+  {
+    if (sbmlns == NULL || 
+        plugins[i]->hasCorrectNamespace(const_cast<SBMLNamespaces*>(sbmlns)))
+    {
+      return plugins[i];
+    }
+  }
+  return NULL;
+}
+
+
+void
+SBMLExtensionRegistry::addToASTPluginTables(const ASTBasePlugin* astPlugin)
+{
+  // the lists keep the order of registration, so that without a document
+  // the package registered first wins, as it did when the plugins were
+  // searched in turn
+  unsigned int n = 0;
+  const ASTNodeValues_t* values = astPlugin->getASTNodeValue(n);
+  while (values != NULL)
+  {
+    size_t type = (size_t)(values->type);
+    if (type >= mASTPluginsByType.size())
+    {
+      mASTPluginsByType.resize(type + 1);
+    }
+    addToASTPluginList(mASTPluginsByType[type], astPlugin);
+
+    addToASTPluginList(mASTPluginsByName[values->name], astPlugin);
+    addToASTPluginList(mASTPluginsByUpperName[toUpperASTName(values->name)], 
+                       astPlugin);
+    addToASTPluginList(mASTPluginsByUpperURL[toUpperASTName(values->csymbolURL)], 
+                       astPlugin);
+
+    values = astPlugin->getASTNodeValue(++n);
+  }
+}
+
+
+const ASTBasePlugin *
+SBMLExtensionRegistry::getASTPluginFor(ASTNodeType_t type,
+                                       const SBMLNamespaces* sbmlns) const
+{
+  size_t index = (size_t)type;
+  if (index >= mASTPluginsByType.size())
+  {
+    return NULL;
+  }
+  return selectASTPlugin(mASTPluginsByType[index], sbmlns);
+}
+
+
+const ASTBasePlugin *
+SBMLExtensionRegistry::getASTPluginFor(const std::string& name, 
+                                       bool isCsymbol,
+                                       bool strCmpIsCaseSensitive,
+                                       const SBMLNamespaces* sbmlns) const
+{
+  const std::map<std::string, ASTPluginList>* table;
+  std::string key;
+  if (isCsymbol)
+  {
+    table = &mASTPluginsByUpperURL;
+    key = toUpperASTName(name);
+  }
+  else if (strCmpIsCaseSensitive)
+  {
+    table = &mASTPluginsByName;
+    key = name;
+  }
+  else
+  {
+    table = &mASTPluginsByUpperName;
+    key = toUpperASTName(name);
+  }
+
+  std::map<std::string, ASTPluginList>::const_iterator it = table->find(key);
+  if (it == table->end())
+  {
+    return NULL;
+  }
+  return selectASTPlugin(it->second, sbmlns);
+}
+
+
+const ASTBasePlugin *
+SBMLExtensionRegistry::getASTPluginForURI(const std::string& uri)
+{
+  const SBMLExtension* sbmlext = getExtensionInternal(uri);
+  if (sbmlext == NULL || !sbmlext->isEnabled())
+  {
+    return NULL;
+  }
+  return sbmlext->getASTBasePlugin();
+}
+/** @endcond */
+
+
 
 #endif /* __cplusplus */
 /** @cond doxygenIgnored */
@@ -390,8 +390,53 @@ public:
   unsigned int getNumASTPlugins();
   const ASTBasePlugin * getASTPlugin(unsigned int i);
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Returns the registered ASTBasePlugin that defines the given node type,
+   * or @c NULL if no package does.  When several packages define it, the
+   * one registered first is returned.
+   *
+   * If @p sbmlns is given, only the packages enabled on a document with
+   * these namespaces are considered, as told by
+   * ASTBasePlugin::hasCorrectNamespace().
+   */
+  const ASTBasePlugin * getASTPluginFor(ASTNodeType_t type,
+                                        const SBMLNamespaces* sbmlns = NULL) const;
+
+
+  /**
+   * Returns the registered ASTBasePlugin that defines the given element
+   * name (or csymbol definitionURL, if @p isCsymbol is @c true), or @c NULL
+   * if no package does.  Names are compared ignoring case unless
+   * @p strCmpIsCaseSensitive is @c true; URLs always ignore case.
+   *
+   * If @p sbmlns is given, only the packages enabled on a document with
+   * these namespaces are considered.
+   */
+  const ASTBasePlugin * getASTPluginFor(const std::string& name, 
+                                        bool isCsymbol = false,
+                                        bool strCmpIsCaseSensitive = false,
+                                        const SBMLNamespaces* sbmlns = NULL) const;
+
+
+  /**
+   * Returns the ASTBasePlugin of the enabled package with the given
+   * namespace URI, or @c NULL if there is none.
+   */
+  const ASTBasePlugin * getASTPluginForURI(const std::string& uri);
+  /** @endcond */
+
 private:
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Adds the node types, names and csymbol URLs of the given plugin to
+   * the dispatch tables used by getASTPluginFor().
+   */
+  void addToASTPluginTables(const ASTBasePlugin* astPlugin);
+  /** @endcond */
+
   //
   // Constructor and Copy constructor must not be overridden.
   //
@@ -408,6 +453,15 @@ private:
   SBasePluginMap    mSBasePluginMap;
   std::vector<ASTBasePlugin*>  mASTPluginsVector;
 
+  // dispatch tables from node type, element name and csymbol URL to the
+  // AST plugins defining them, in the order the packages registered; they
+  // only change when a package registers
+  typedef std::vector<const ASTBasePlugin*> ASTPluginList;
+  std::vector<ASTPluginList>  mASTPluginsByType;
+  std::map<std::string, ASTPluginList>  mASTPluginsByName;
+  std::map<std::string, ASTPluginList>  mASTPluginsByUpperName;
+  std::map<std::string, ASTPluginList>  mASTPluginsByUpperURL;
+
   static SBMLExtensionRegistry* mInstance;
 
   //
@@ -422,6 +476,7 @@ private:
   friend class ASTBase;
   friend class ASTNode;
   friend class L3ParserSettings;
+  friend class SBMLError;
   template <class SBMLExtensionType> friend class SBMLExtensionNamespaces;
   template<class SBasePluginType, class SBMLExtensionType> friend class SBasePluginCreator;
 
@@ -54,6 +54,8 @@
 #include <sbml/extension/SBMLExtensionRegistry.h>
 
 #include <sbml/SBMLTypes.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/L3Parser.h>
 
 #include "TestPackage.h"
 
@@ -191,6 +193,38 @@ START_TEST (test_SBMLExtensionRegistry_c_api)
 }
 END_TEST
 
+#ifdef USE_L3V2EXTENDEDMATH
+START_TEST (test_SBMLExtensionRegistry_astPluginFor)
+{
+  SBMLExtensionRegistry &instance = SBMLExtensionRegistry::getInstance();
+  SBMLNamespaces l3v1(3, 1);
+  SBMLNamespaces l3v2(3, 2);
+
+  const ASTBasePlugin* plugin = instance.getASTPluginFor(AST_FUNCTION_REM);
+  fail_unless(plugin != NULL);
+  fail_unless(plugin->getPackageName() == "l3v2extendedmath");
+  fail_unless(instance.getASTPluginFor(AST_PLUS) == NULL);
+
+  // only the packages enabled for the given namespaces are found
+  fail_unless(instance.getASTPluginFor(AST_FUNCTION_REM, &l3v2) == plugin);
+  fail_unless(instance.getASTPluginFor(AST_FUNCTION_REM, &l3v1) == NULL);
+  fail_unless(instance.getASTPluginFor("rem", false, true) == plugin);
+  fail_unless(instance.getASTPluginFor("rem", false, true, &l3v2) == plugin);
+  fail_unless(instance.getASTPluginFor("rem", false, true, &l3v1) == NULL);
+
+  // evaluation prefers the enabled package, but still evaluates math
+  // that is being converted away from it
+  Model m1(3, 1);
+  Model m2(3, 2);
+  ASTNode* math = SBML_parseL3Formula("rem(7, 4)");
+  fail_unless(SBMLTransforms::evaluateASTNode(math, &m2) == 3);
+  fail_unless(SBMLTransforms::evaluateASTNode(math, &m1) == 3);
+  delete math;
+}
+END_TEST
+#endif
+
+
 Suite *
 create_suite_SBMLExtensionRegistry (void)
 {
@@ -200,6 +234,9 @@ create_suite_SBMLExtensionRegistry (void)
   tcase_add_test( tcase, test_SBMLExtensionRegistry_addExtension );
   tcase_add_test( tcase, test_SBMLExtensionRegistry_getExtension );
   tcase_add_test( tcase, test_SBMLExtensionRegistry_c_api        );
+#ifdef USE_L3V2EXTENDEDMATH
+  tcase_add_test( tcase, test_SBMLExtensionRegistry_astPluginFor );
+#endif
   
   suite_add_tcase(suite, tcase);
 
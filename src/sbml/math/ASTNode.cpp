@@ -42,6 +42,8 @@
 #include <new>
 #include <stdlib.h>
 #include <limits.h>
+#include <math.h>
+#include <string.h>
 
 #include <sbml/common/common.h>
 #include <sbml/util/List.h>
@@ -52,6 +54,7 @@
 #include <sbml/Model.h>
 #include <sbml/util/IdList.h>
 #include <sbml/extension/SBMLExtensionRegistry.h>
+#include <sbml/SBMLTransforms.h>
 
 /** @cond doxygenIgnored */
 
@@ -234,6 +237,29 @@ static const char *AST_OPERATOR_STRINGS[] =
 
 #ifdef __cplusplus
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The attributes that only a few nodes carry; allocated on first use.
+ */
+struct ASTNode::Attributes
+{
+  std::string units;
+  std::string id;
+  std::string className;
+  std::string style;
+};
+
+
+/*
+ * Values of ASTNode::mValueKind, telling which member of mValue is in use.
+ */
+static const char AST_VALUE_NONE    = 0;
+static const char AST_VALUE_INTEGER = 1;
+static const char AST_VALUE_REAL    = 2;
+
+/** @endcond */
+
+
 /*
  * Creates a new ASTNode.
  *
@@ -244,19 +270,13 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (ASTNodeType_t type)
 {
   unsetSemanticsFlag();
-  mDefinitionURL = new XMLAttributes();
-  mReal          = 0;
-  mExponent      = 0;
+  mDefinitionURL = NULL;
   mType          = AST_UNKNOWN;
   mChar          = 0;
   mName          = NULL;
-  mInteger       = 0;
-  mDenominator   = 1;
+  clearValue();
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
+  mAttributes    = NULL;
   mIsBvar = false;
   mUserData      = NULL;
 
@@ -264,7 +284,7 @@ ASTNode::ASTNode (ASTNodeType_t type)
   //setType(type);
 
   mChildren             = new List;
-  mSemanticsAnnotations = new List;
+  mSemanticsAnnotations = NULL;
   // only load plugins when we need to
   //if (type > AST_END_OF_CORE && type < AST_UNKNOWN)
   //{
@@ -290,24 +310,18 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (Token_t* token)
 {
   unsetSemanticsFlag();
-  mDefinitionURL = new XMLAttributes();
-  mReal          = 0;
-  mExponent      = 0;
+  mDefinitionURL = NULL;
   mType          = AST_UNKNOWN;
   mChar          = 0;
   mName          = NULL;
-  mInteger       = 0;
-  mDenominator   = 1;
+  clearValue();
   mParentSBMLObject = NULL;
-  mUnits         = "";
-  mId			 = "";
-  mClass		 = "";
-  mStyle		 = "";
+  mAttributes    = NULL;
   mIsBvar = false;
   mUserData      = NULL;
 
   mChildren             = new List;
-  mSemanticsAnnotations = new List;
+  mSemanticsAnnotations = NULL;
 
   if (token != NULL)
   {
@@ -360,23 +374,28 @@ LIBSBML_EXTERN
 ASTNode::ASTNode (const ASTNode& orig) :
   mType                 ( orig.mType )
  ,mChar                 ( orig.mChar )
- ,mName                 ( NULL )
- ,mInteger              ( orig.mInteger )
- ,mReal                 ( orig.mReal )
- ,mDenominator          ( orig.mDenominator )
- ,mExponent             ( orig.mExponent )
- ,mDefinitionURL        ( orig.mDefinitionURL->clone() )	
+ ,mValueKind            ( orig.mValueKind )
  ,hasSemantics          ( orig.hasSemantics )
+ ,mIsBvar               ( orig.mIsBvar)
+ ,mName                 ( NULL )
+ ,mValue                ( orig.mValue )
+ ,mDefinitionURL        ( NULL )
  ,mChildren             ( new List() )
- ,mSemanticsAnnotations ( new List() )
+ ,mSemanticsAnnotations ( NULL )
  ,mParentSBMLObject     ( orig.mParentSBMLObject )
- ,mUnits                ( orig.mUnits)
- ,mId                   ( orig.mId)
- ,mClass                ( orig.mClass)
- ,mStyle                ( orig.mStyle)
- ,mIsBvar               ( orig.mIsBvar)
+ ,mAttributes           ( NULL )
  ,mUserData             ( orig.mUserData )
 {
+  if (orig.mDefinitionURL != NULL)
+  {
+    mDefinitionURL = orig.mDefinitionURL->clone();
+  }
+
+  if (orig.mAttributes != NULL)
+  {
+    mAttributes = new Attributes(*orig.mAttributes);
+  }
+
   if (orig.mName)
   {
     mName = safe_strdup(orig.mName);
@@ -412,16 +431,10 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
   {
     mType                 = rhs.mType;
     mChar                 = rhs.mChar;
-    mInteger              = rhs.mInteger;
-    mReal                 = rhs.mReal;
-    mDenominator          = rhs.mDenominator;
-    mExponent             = rhs.mExponent;
+    mValueKind            = rhs.mValueKind;
+    mValue                = rhs.mValue;
     hasSemantics          = rhs.hasSemantics;
     mParentSBMLObject     = rhs.mParentSBMLObject;
-    mUnits                = rhs.mUnits;
-    mId                   = rhs.mId;
-    mClass                = rhs.mClass;
-    mStyle                = rhs.mStyle;
     mIsBvar               = rhs.mIsBvar;
     mUserData             = rhs.mUserData;
     freeName();
@@ -444,10 +457,13 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
       addChild( rhs.getChild(c)->deepCopy() );
     }
 
-    size = mSemanticsAnnotations->getSize();
-    while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-    delete mSemanticsAnnotations;
-    mSemanticsAnnotations = new List();
+    if (mSemanticsAnnotations != NULL)
+    {
+      size = mSemanticsAnnotations->getSize();
+      while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
+      delete mSemanticsAnnotations;
+      mSemanticsAnnotations = NULL;
+    }
 
     for (unsigned int c = 0; c < rhs.getNumSemanticsAnnotations(); ++c)
     {
@@ -455,7 +471,18 @@ ASTNode& ASTNode::operator=(const ASTNode& rhs)
     }
     
     delete mDefinitionURL;
-    mDefinitionURL        = rhs.mDefinitionURL->clone();	
+    mDefinitionURL        = (rhs.mDefinitionURL == NULL) ? NULL
+                                               : rhs.mDefinitionURL->clone();
+
+    if (rhs.mAttributes != NULL)
+    {
+      getAttributes() = *rhs.mAttributes;
+    }
+    else
+    {
+      delete mAttributes;
+      mAttributes = NULL;
+    }
     clearPlugins();
     mPlugins.resize(rhs.mPlugins.size());
     transform(rhs.mPlugins.begin(), rhs.mPlugins.end(),
@@ -476,11 +503,15 @@ ASTNode::~ASTNode ()
   while (size--) delete static_cast<ASTNode*>( mChildren->remove(0) );
   delete mChildren;
 
-  size = mSemanticsAnnotations->getSize();
-  while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
-  delete mSemanticsAnnotations;
+  if (mSemanticsAnnotations != NULL)
+  {
+    size = mSemanticsAnnotations->getSize();
+    while (size--)  delete static_cast<XMLNode*>(mSemanticsAnnotations->remove(0) );
+    delete mSemanticsAnnotations;
+  }
 
   delete mDefinitionURL;
+  delete mAttributes;
   
   freeName();
   clearPlugins();
@@ -511,6 +542,47 @@ ASTNode::freeName ()
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Returns the optional attributes of this ASTNode, creating them if needed.
+ */
+ASTNode::Attributes&
+ASTNode::getAttributes ()
+{
+  if (mAttributes == NULL)
+  {
+    mAttributes = new Attributes();
+  }
+  return *mAttributes;
+}
+
+
+/*
+ * Resets the numeric value of this ASTNode to its defaults.
+ */
+void
+ASTNode::clearValue ()
+{
+  mValueKind = AST_VALUE_NONE;
+  mValue.integer.numerator   = 0;
+  mValue.integer.denominator = 1;
+}
+
+
+/*
+ * Empties the definitionURL attributes, if any have been created.
+ */
+void
+ASTNode::resetDefinitionURL ()
+{
+  if (mDefinitionURL != NULL)
+  {
+    mDefinitionURL->clear();
+  }
+}
+/** @endcond */
+
+
 /*
  * Attempts to convert this ASTNode to a canonical form and returns true if
  * the conversion succeeded, false otherwise.
@@ -1054,6 +1126,10 @@ ASTNode::addSemanticsAnnotation (XMLNode* sAnnotation)
   {
     return LIBSBML_OPERATION_FAILED;
   }
+  if (mSemanticsAnnotations == NULL)
+  {
+    mSemanticsAnnotations = new List;
+  }
   mSemanticsAnnotations->add(sAnnotation);
   return LIBSBML_OPERATION_SUCCESS;
 }
@@ -1066,7 +1142,7 @@ LIBSBML_EXTERN
 unsigned int 
 ASTNode::getNumSemanticsAnnotations () const
 {
-  return mSemanticsAnnotations->getSize();
+  return (mSemanticsAnnotations == NULL) ? 0 : mSemanticsAnnotations->getSize();
 }
 
 
@@ -1078,6 +1154,10 @@ LIBSBML_EXTERN
 XMLNode* 
 ASTNode::getSemanticsAnnotation (unsigned int n) const
 {
+  if (mSemanticsAnnotations == NULL)
+  {
+    return NULL;
+  }
   return static_cast<XMLNode*>( mSemanticsAnnotations->get(n) );
 }
 
@@ -1161,7 +1241,7 @@ LIBSBML_EXTERN
 long
 ASTNode::getInteger () const
 {
-  return mInteger;
+  return (mValueKind == AST_VALUE_INTEGER) ? mValue.integer.numerator : 0;
 }
 
 
@@ -1275,7 +1355,7 @@ LIBSBML_EXTERN
 long
 ASTNode::getNumerator () const
 {
-  return mInteger;
+  return (mValueKind == AST_VALUE_INTEGER) ? mValue.integer.numerator : 0;
 }
 
 
@@ -1287,7 +1367,7 @@ LIBSBML_EXTERN
 long
 ASTNode::getDenominator () const
 {
-  return mDenominator;
+  return (mValueKind == AST_VALUE_INTEGER) ? mValue.integer.denominator : 1;
 }
 
 
@@ -1303,16 +1383,16 @@ LIBSBML_EXTERN
 double
 ASTNode::getReal () const
 {
-  double result = mReal;
+  double result = getMantissa();
   
 
   if (mType == AST_REAL_E)
   {
-    result *= pow(10.0,  static_cast<double>(mExponent) );
+    result *= pow(10.0,  static_cast<double>(getExponent()) );
   }
   else if (mType == AST_RATIONAL)
   {
-    result = static_cast<double>(mInteger) / mDenominator;
+    result = static_cast<double>(getNumerator()) / getDenominator();
   }
 
   return result;
@@ -1328,7 +1408,7 @@ LIBSBML_EXTERN
 double
 ASTNode::getMantissa () const
 {
-  return mReal;
+  return (mValueKind == AST_VALUE_REAL) ? mValue.real.mantissa : 0;
 }
 
 
@@ -1340,7 +1420,7 @@ LIBSBML_EXTERN
 long
 ASTNode::getExponent () const
 {
-  return mExponent;
+  return (mValueKind == AST_VALUE_REAL) ? mValue.real.exponent : 0;
 }
 
 
@@ -1449,28 +1529,28 @@ LIBSBML_EXTERN
 std::string
 ASTNode::getId() const
 {
-  return mId;
+  return (mAttributes == NULL) ? std::string() : mAttributes->id;
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getClass() const
 {
-  return mClass;
+  return (mAttributes == NULL) ? std::string() : mAttributes->className;
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getStyle() const
 {
-  return mStyle;
+  return (mAttributes == NULL) ? std::string() : mAttributes->style;
 }
 
 LIBSBML_EXTERN
 std::string
 ASTNode::getUnits() const
 {
-  return mUnits;
+  return (mAttributes == NULL) ? std::string() : mAttributes->units;
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -1736,7 +1816,7 @@ ASTNode::isLog10 () const
     {
       c = getLeftChild();
 
-      if ((c->mType == AST_INTEGER) && (c->mInteger == 10))
+      if ((c->mType == AST_INTEGER) && (c->getInteger() == 10))
       {
         result = true;
       }
@@ -1910,7 +1990,7 @@ ASTNode::isSqrt () const
     {
       c = getLeftChild();
 
-      if ((c->mType == AST_INTEGER) && (c->mInteger == 2))
+      if ((c->mType == AST_INTEGER) && (c->getInteger() == 2))
       {
         result = true;
       }
@@ -1997,28 +2077,28 @@ LIBSBML_EXTERN
 bool 
 ASTNode::isSetId() const
 {
-  return (mId.empty() == false);
+  return (mAttributes != NULL && mAttributes->id.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetClass() const
 {
-  return (mClass.empty() == false);
+  return (mAttributes != NULL && mAttributes->className.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetStyle() const
 {
-  return (mStyle.empty() == false);
+  return (mAttributes != NULL && mAttributes->style.empty() == false);
 }
   
 LIBSBML_EXTERN
 bool 
 ASTNode::isSetUnits() const
 {
-  return (mUnits.empty() == false);
+  return (mAttributes != NULL && mAttributes->units.empty() == false);
 }
   
 
@@ -2092,7 +2172,9 @@ int
 ASTNode::setValue (int value)
 {
   setType(AST_INTEGER);
-  mInteger = value;
+  clearValue();
+  mValueKind = AST_VALUE_INTEGER;
+  mValue.integer.numerator = value;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2106,7 +2188,9 @@ int
 ASTNode::setValue (long value)
 {
   setType(AST_INTEGER);
-  mInteger = value;
+  clearValue();
+  mValueKind = AST_VALUE_INTEGER;
+  mValue.integer.numerator = value;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2121,8 +2205,9 @@ ASTNode::setValue (long numerator, long denominator)
 {
   setType(AST_RATIONAL);
 
-  mInteger     = numerator;
-  mDenominator = denominator;
+  mValueKind = AST_VALUE_INTEGER;
+  mValue.integer.numerator   = numerator;
+  mValue.integer.denominator = denominator;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2141,8 +2226,9 @@ ASTNode::setValue (double value)
 {
   setType(AST_REAL);
 
-  mReal     = value;
-  mExponent = 0;
+  mValueKind = AST_VALUE_REAL;
+  mValue.real.mantissa = value;
+  mValue.real.exponent = 0;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2157,8 +2243,9 @@ ASTNode::setValue (double mantissa, long exponent)
 {
   setType(AST_REAL_E);
 
-  mReal     = mantissa;
-  mExponent = exponent;
+  mValueKind = AST_VALUE_REAL;
+  mValue.real.mantissa = mantissa;
+  mValue.real.exponent = exponent;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2177,10 +2264,7 @@ ASTNode::setType (ASTNodeType_t type)
 
   if (isOperator() || isNumber())
   {
-    mReal     = 0;
-    mExponent = 0;
-    mDenominator = 1;
-    mInteger = 0;
+    clearValue();
   }
 
   /* if avogadro set value */
@@ -2197,23 +2281,19 @@ ASTNode::setType (ASTNodeType_t type)
     //}
     //else
     //{
-      mReal = 6.02214179e23;
+      mValueKind = AST_VALUE_REAL;
+      mValue.real.mantissa = 6.02214179e23;
+      mValue.real.exponent = 0;
     //}
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/avogadro");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/avogadro");
   }
   else if (type == AST_NAME_TIME)
   {
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/time");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/time");
   }
   else if (type == AST_FUNCTION_DELAY)
   {
-    mDefinitionURL->clear();
-    mDefinitionURL->add("definitionURL", 
-                        "http://www.sbml.org/sbml/symbols/delay");
+    setDefinitionURL("http://www.sbml.org/sbml/symbols/delay");
   }
 
   /*
@@ -2278,13 +2358,13 @@ ASTNode::setType (ASTNodeType_t type)
   {
     mType = AST_UNKNOWN;
     mChar = 0;
-    mDefinitionURL->clear();
+    resetDefinitionURL();
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
   }
 
   if (clearDefinitionURL == true && getSemanticsFlag() == false)
   {
-    mDefinitionURL->clear();
+    resetDefinitionURL();
   }
 
     
@@ -2296,7 +2376,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setId (const std::string& id)
 {
-  mId     = id;
+  getAttributes().id = id;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2304,7 +2384,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setClass (const std::string& className)
 {
-  mClass   = className;
+  getAttributes().className = className;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2312,7 +2392,7 @@ LIBSBML_EXTERN
 int
 ASTNode::setStyle (const std::string& style)
 {
-  mStyle     = style;
+  getAttributes().style = style;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2328,7 +2408,7 @@ ASTNode::setUnits (const std::string& units)
   if (!SyntaxChecker::isValidInternalUnitSId(units))
     return LIBSBML_INVALID_ATTRIBUTE_VALUE;
 
-  mUnits     = units;
+  getAttributes().units = units;
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -2419,16 +2499,12 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetId ()
 {
-  mId.erase();
-
-  if (mId.empty())
-  {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->id.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 
@@ -2436,32 +2512,24 @@ LIBSBML_EXTERN
 int
 ASTNode::unsetClass ()
 {
-  mClass.erase();
-
-  if (mClass.empty())
-  {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->className.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 LIBSBML_EXTERN
 int
 ASTNode::unsetStyle ()
 {
-  mStyle.erase();
-
-  if (mStyle.empty())
-  {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->style.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 LIBSBML_EXTERN
@@ -2471,16 +2539,12 @@ ASTNode::unsetUnits ()
   if (!isNumber())
     return LIBSBML_UNEXPECTED_ATTRIBUTE;
 
-  mUnits.erase();
-
-  if (mUnits.empty())
-  {
-    return LIBSBML_OPERATION_SUCCESS;
-  }
-  else
+  if (mAttributes != NULL)
   {
-    return LIBSBML_OPERATION_FAILED;
+    mAttributes->units.erase();
   }
+
+  return LIBSBML_OPERATION_SUCCESS;
 }
 
 
@@ -2549,6 +2613,10 @@ ASTNode::setDefinitionURL(XMLAttributes url)
 int 
 ASTNode::setDefinitionURL(const std::string& url)
 {
+  if (mDefinitionURL == NULL)
+  {
+    mDefinitionURL = new XMLAttributes();
+  }
   mDefinitionURL->clear();
   mDefinitionURL->add("definitionURL", url);
   return LIBSBML_OPERATION_SUCCESS;
@@ -2754,151 +2822,1075 @@ ASTNode::isWellFormedASTNode() const
 /** @endcond */
 
 
-LIBSBML_EXTERN
-void
-ASTNode::replaceArgument(const std::string& bvar, ASTNode * arg)
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Adds the given bytes to a 64-bit FNV-1a hash.
+ */
+static void
+hashBytes (unsigned long long& hash, const void* data, size_t length)
 {
-  if (arg == NULL)
-    return;
-  else if (getNumChildren() == 0)
-  {
-    if (this->isName() && this->getName() == bvar)
-    {
-      if (arg->isName())
-      {
-        this->setType(arg->getType());
-        this->setName(arg->getName());
-      }
-      else if (arg->isReal())
-      {
-        this->setValue(arg->getReal());
-        if (arg->isSetUnits())
-        {
-          this->setUnits(arg->getUnits());
-        }
-      }
-      else if (arg->isInteger())
-      {
-        this->setValue(arg->getInteger());
-        if (arg->isSetUnits())
-        {
-          this->setUnits(arg->getUnits());
-        }
-      }
-      else if (arg->isConstant())
-      {
-        this->setType(arg->getType());
-      }
-      else
-      {
-        this->setType(arg->getType());
-        this->setName(arg->getName());
-        for (unsigned int c = 0; c < arg->getNumChildren(); c++)
-        {
-          this->addChild(arg->getChild(c)->deepCopy());
-        }
-      }
-    }
-  }
-  for (unsigned int i = 0; i < getNumChildren(); i++)
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < length; ++i)
   {
-    if (getChild(i)->isName())
-    {
-      if (getChild(i)->getName() == bvar)
-      {
-        if (arg->isName())
-        {
-          getChild(i)->setType(arg->getType());
-          getChild(i)->setName(arg->getName());
-        }
-        else if (arg->isReal())
-        {
-          getChild(i)->setValue(arg->getReal());
-          if (arg->isSetUnits())
-          {
-            getChild(i)->setUnits(arg->getUnits());
-          }
-        }
-        else if (arg->isInteger())
-        {
-          getChild(i)->setValue(arg->getInteger());
-          if (arg->isSetUnits())
-          {
-            getChild(i)->setUnits(arg->getUnits());
-          }
-        }
-        else if (arg->isConstant())
-        {
-          getChild(i)->setType(arg->getType());
-        }
-        else
-        {
-          getChild(i)->setType(arg->getType());
-          getChild(i)->setName(arg->getName());
-          for (unsigned int c = 0; c < arg->getNumChildren(); c++)
-          {
-            getChild(i)->addChild(arg->getChild(c)->deepCopy());
-          }
-        }
-      }
-    }
-    else
-    {
-      getChild(i)->replaceArgument(bvar, arg);
-    }
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
   }
 }
 
-LIBSBML_EXTERN
-void
-ASTNode::reduceToBinary()
-{
-  unsigned int numChildren = getNumChildren();
-  /* number of children should be greater than 2 */
-  if (numChildren < 3)
-    return;
 
-  ASTNode* op = new ASTNode( getType() );
-  ASTNode* op2 = new ASTNode( getType() );
+static void
+hashString (unsigned long long& hash, const char* s)
+{
+  if (s != NULL)
+  {
+    hashBytes(hash, s, strlen(s) + 1);
+  }
+  else
+  {
+    hashBytes(hash, "", 1);
+  }
+}
 
-  // add the first two children to the first node
-  op->addChild(getChild(0));
-  op->addChild(getChild(1));
 
-  op2->addChild(op);
-  for (unsigned int n = 2; n < numChildren; n++)
-    op2->addChild(getChild(n));
+/*
+ * Compares doubles bit by bit, so that NaN equals NaN but 0 differs from -0.
+ */
+static bool
+haveSameBits (double a, double b)
+{
+  return memcmp(&a, &b, sizeof(double)) == 0;
+}
+/** @endcond */
 
-  swapChildren(op2);
 
-  // need to clean up memory but the children of op2
-  // are now the children of this ASTNode
-  // so remove them from op2 before deleting it
-  // this is why removeChild does not delete the child
-  unsigned int num = op2->getNumChildren();
-  unsigned int i = 0;
-  while(i < num)
+LIBSBML_EXTERN
+unsigned long long
+ASTNode::getStructuralHash() const
+{
+  unsigned int numChildren = getNumChildren();
+  if (numChildren == 0)
   {
-    op2->removeChild(0);
-    i++;
+    return getStructuralHash(NULL);
   }
-  delete op2;
 
-  reduceToBinary();
+  std::vector<unsigned long long> childHashes(numChildren);
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    childHashes[i] = getChild(i)->getStructuralHash();
+  }
+  return getStructuralHash(&childHashes[0]);
 }
 
 
 /** @cond doxygenLibsbmlInternal */
 LIBSBML_EXTERN
-void 
-ASTNode::setParentSBMLObject(SBase * sb)
+unsigned long long
+ASTNode::getStructuralHash(const unsigned long long* childHashes) const
 {
-  mParentSBMLObject = sb;
-}
+  unsigned long long hash = 14695981039346656037ULL;
 
-LIBSBML_EXTERN
-int 
-ASTNode::unsetParentSBMLObject()
+  int type = mType;
+  hashBytes(hash, &type, sizeof(type));
+  hashBytes(hash, &mIsBvar, sizeof(mIsBvar));
+  hashString(hash, mName);
+
+  // the unused part of mValue is not kept cleared, so only hash the
+  // members the value kind says are in use
+  hashBytes(hash, &mValueKind, sizeof(mValueKind));
+  if (mValueKind == AST_VALUE_INTEGER)
+  {
+    hashBytes(hash, &mValue.integer.numerator, sizeof(long));
+    hashBytes(hash, &mValue.integer.denominator, sizeof(long));
+  }
+  else if (mValueKind == AST_VALUE_REAL)
+  {
+    hashBytes(hash, &mValue.real.mantissa, sizeof(double));
+    hashBytes(hash, &mValue.real.exponent, sizeof(long));
+  }
+
+  // hash what exactlyEqual() compares, whether or not the optional
+  // members happen to be allocated
+  hashString(hash, getUnits().c_str());
+  hashString(hash, getDefinitionURLString().c_str());
+
+  unsigned int numChildren = getNumChildren();
+  hashBytes(hash, &numChildren, sizeof(numChildren));
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    hashBytes(hash, &childHashes[i], sizeof(unsigned long long));
+  }
+
+  return hash;
+}
+/** @endcond */
+
+
+LIBSBML_EXTERN
+bool
+ASTNode::exactlyEqual(const ASTNode& rhs) const
+{
+  if (&rhs == this)
+  {
+    return true;
+  }
+
+  unsigned int numChildren = getNumChildren();
+  if (mType != rhs.mType || mIsBvar != rhs.mIsBvar ||
+      numChildren != rhs.getNumChildren())
+  {
+    return false;
+  }
+
+  if ((mName == NULL) != (rhs.mName == NULL) ||
+      (mName != NULL && strcmp(mName, rhs.mName) != 0))
+  {
+    return false;
+  }
+
+  if (mValueKind != rhs.mValueKind)
+  {
+    return false;
+  }
+  if (mValueKind == AST_VALUE_INTEGER &&
+      (mValue.integer.numerator != rhs.mValue.integer.numerator ||
+       mValue.integer.denominator != rhs.mValue.integer.denominator))
+  {
+    return false;
+  }
+  if (mValueKind == AST_VALUE_REAL &&
+      (!haveSameBits(mValue.real.mantissa, rhs.mValue.real.mantissa) ||
+       mValue.real.exponent != rhs.mValue.real.exponent))
+  {
+    return false;
+  }
+
+  if (getUnits() != rhs.getUnits() || getId() != rhs.getId() ||
+      getClass() != rhs.getClass() || getStyle() != rhs.getStyle() ||
+      getDefinitionURLString() != rhs.getDefinitionURLString())
+  {
+    return false;
+  }
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    if (!getChild(i)->exactlyEqual(*rhs.getChild(i)))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Helpers for ASTNode::derivative().  The functions building nodes take
+ * ownership of their arguments and simplify the result where that is
+ * trivially possible, so that derivatives of large expressions do not fill
+ * up with terms like 0 * x or x^1.
+ */
+static ASTNode*
+newNumber (double value)
+{
+  ASTNode* node = new ASTNode(AST_INTEGER);
+  if (value == floor(value) && fabs(value) < (double)LONG_MAX)
+  {
+    node->setValue((long)value);
+  }
+  else
+  {
+    node->setValue(value);
+  }
+  return node;
+}
+
+
+static ASTNode*
+newFunction (ASTNodeType_t type, ASTNode* arg)
+{
+  ASTNode* node = new ASTNode(type);
+  node->addChild(arg);
+  return node;
+}
+
+
+static ASTNode*
+newFunction (ASTNodeType_t type, ASTNode* left, ASTNode* right)
+{
+  ASTNode* node = new ASTNode(type);
+  node->addChild(left);
+  node->addChild(right);
+  return node;
+}
+
+
+/*
+ * @return true if the node is a plain number, setting value to it.
+ */
+static bool
+isConstant (const ASTNode* node, double& value)
+{
+  if (!node->isNumber() || node->isSetUnits())
+  {
+    return false;
+  }
+  value = node->getValue();
+  return !util_isNaN(value);
+}
+
+
+static bool
+isNumberValue (const ASTNode* node, double expected)
+{
+  double value;
+  return isConstant(node, value) && value == expected;
+}
+
+
+static ASTNode*
+simplifiedNegate (ASTNode* a)
+{
+  double value;
+  if (isConstant(a, value))
+  {
+    delete a;
+    return newNumber(-value);
+  }
+  if (a->getType() == AST_MINUS && a->getNumChildren() == 1)
+  {
+    ASTNode* child = a->getChild(0);
+    a->removeChild(0);
+    delete a;
+    return child;
+  }
+  return newFunction(AST_MINUS, a);
+}
+
+
+static ASTNode*
+simplifiedPlus (ASTNode* a, ASTNode* b)
+{
+  double x, y;
+  bool isA = isConstant(a, x);
+  bool isB = isConstant(b, y);
+  if (isA && isB)
+  {
+    delete a;
+    delete b;
+    return newNumber(x + y);
+  }
+  if (isA && x == 0)
+  {
+    delete a;
+    return b;
+  }
+  if (isB && y == 0)
+  {
+    delete b;
+    return a;
+  }
+  return newFunction(AST_PLUS, a, b);
+}
+
+
+static ASTNode*
+simplifiedMinus (ASTNode* a, ASTNode* b)
+{
+  double x, y;
+  bool isA = isConstant(a, x);
+  bool isB = isConstant(b, y);
+  if (isA && isB)
+  {
+    delete a;
+    delete b;
+    return newNumber(x - y);
+  }
+  if (isA && x == 0)
+  {
+    delete a;
+    return simplifiedNegate(b);
+  }
+  if (isB && y == 0)
+  {
+    delete b;
+    return a;
+  }
+  return newFunction(AST_MINUS, a, b);
+}
+
+
+static ASTNode*
+simplifiedTimes (ASTNode* a, ASTNode* b)
+{
+  double x, y;
+  bool isA = isConstant(a, x);
+  bool isB = isConstant(b, y);
+  if (isA && isB)
+  {
+    delete a;
+    delete b;
+    return newNumber(x * y);
+  }
+  if ((isA && x == 0) || (isB && y == 0))
+  {
+    delete a;
+    delete b;
+    return newNumber(0);
+  }
+  if (isA && (x == 1 || x == -1))
+  {
+    delete a;
+    return (x == 1) ? b : simplifiedNegate(b);
+  }
+  if (isB && (y == 1 || y == -1))
+  {
+    delete b;
+    return (y == 1) ? a : simplifiedNegate(a);
+  }
+  return newFunction(AST_TIMES, a, b);
+}
+
+
+static ASTNode*
+simplifiedDivide (ASTNode* a, ASTNode* b)
+{
+  double y;
+  if (isNumberValue(a, 0.0))
+  {
+    delete a;
+    delete b;
+    return newNumber(0);
+  }
+  if (isConstant(b, y) && (y == 1 || y == -1))
+  {
+    delete b;
+    return (y == 1) ? a : simplifiedNegate(a);
+  }
+  return newFunction(AST_DIVIDE, a, b);
+}
+
+
+static ASTNode*
+simplifiedPower (ASTNode* a, ASTNode* b)
+{
+  double y;
+  if (isConstant(b, y) && (y == 0 || y == 1))
+  {
+    delete b;
+    if (y == 1)
+    {
+      return a;
+    }
+    delete a;
+    return newNumber(1);
+  }
+  return newFunction(AST_POWER, a, b);
+}
+
+
+static ASTNode*
+newSqrt (ASTNode* arg)
+{
+  return newFunction(AST_FUNCTION_ROOT, newNumber(2), arg);
+}
+
+
+static ASTNode*
+newSquare (const ASTNode* arg)
+{
+  return newFunction(AST_POWER, arg->deepCopy(), newNumber(2));
+}
+
+
+/*
+ * @return true if the node or any of its descendants refers to variable.
+ */
+static bool
+dependsOn (const ASTNode* node, const std::string& variable)
+{
+  ASTNodeType_t type = node->getType();
+  if ((type == AST_NAME || type == AST_NAME_TIME) &&
+      node->getName() != NULL && variable == node->getName())
+  {
+    return true;
+  }
+
+  for (unsigned int i = 0; i < node->getNumChildren(); ++i)
+  {
+    if (dependsOn(node->getChild(i), variable))
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+static ASTNode* differentiate(const ASTNode* node, const std::string& variable);
+
+
+/*
+ * Differentiates the product of all children of node.
+ */
+static ASTNode*
+differentiateProduct (const ASTNode* node, const std::string& variable)
+{
+  unsigned int numChildren = node->getNumChildren();
+  ASTNode* result = newNumber(0);
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    ASTNode* term = differentiate(node->getChild(i), variable);
+    if (term == NULL)
+    {
+      delete result;
+      return NULL;
+    }
+    if (isNumberValue(term, 0.0))
+    {
+      delete term;
+      continue;
+    }
+
+    for (unsigned int j = 0; j < numChildren; ++j)
+    {
+      if (j != i)
+      {
+        term = simplifiedTimes(term, node->getChild(j)->deepCopy());
+      }
+    }
+    result = simplifiedPlus(result, term);
+  }
+  return result;
+}
+
+
+/*
+ * Differentiates piecewise by differentiating each piece; the conditions
+ * are kept as they are.
+ */
+static ASTNode*
+differentiatePiecewise (const ASTNode* node, const std::string& variable)
+{
+  unsigned int numChildren = node->getNumChildren();
+  ASTNode* result = new ASTNode(AST_FUNCTION_PIECEWISE);
+  bool allZero = true;
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    const ASTNode* child = node->getChild(i);
+    if (i % 2 == 1)
+    {
+      result->addChild(child->deepCopy());
+      continue;
+    }
+
+    ASTNode* piece = differentiate(child, variable);
+    if (piece == NULL)
+    {
+      delete result;
+      return NULL;
+    }
+    allZero = allZero && isNumberValue(piece, 0.0);
+    result->addChild(piece);
+  }
+
+  if (allZero)
+  {
+    delete result;
+    return newNumber(0);
+  }
+  return result;
+}
+
+
+/*
+ * Differentiates max or min, choosing the derivative of the argument that
+ * is selected.
+ */
+static ASTNode*
+differentiateExtremum (const ASTNode* node, const std::string& variable)
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren == 0)
+  {
+    return NULL;
+  }
+
+  ASTNodeType_t compare = (node->getType() == AST_FUNCTION_MAX) 
+                        ? AST_RELATIONAL_GEQ : AST_RELATIONAL_LEQ;
+  ASTNode* result = new ASTNode(AST_FUNCTION_PIECEWISE);
+  bool allZero = true;
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    ASTNode* piece = differentiate(node->getChild(i), variable);
+    if (piece == NULL)
+    {
+      delete result;
+      return NULL;
+    }
+    allZero = allZero && isNumberValue(piece, 0.0);
+    result->addChild(piece);
+
+    if (i + 1 == numChildren)
+    {
+      break;
+    }
+
+    ASTNode* condition = new ASTNode(AST_LOGICAL_AND);
+    for (unsigned int j = 0; j < numChildren; ++j)
+    {
+      if (j != i)
+      {
+        condition->addChild(newFunction(compare, 
+          node->getChild(i)->deepCopy(), node->getChild(j)->deepCopy()));
+      }
+    }
+    if (condition->getNumChildren() == 1)
+    {
+      ASTNode* single = condition->getChild(0);
+      condition->removeChild(0);
+      delete condition;
+      condition = single;
+    }
+    result->addChild(condition);
+  }
+
+  if (allZero || numChildren == 1)
+  {
+    ASTNode* only = NULL;
+    if (!allZero)
+    {
+      only = result->getChild(0);
+      result->removeChild(0);
+    }
+    delete result;
+    return allZero ? newNumber(0) : only;
+  }
+  return result;
+}
+
+
+/*
+ * Differentiates a function of a single argument u, given the derivative
+ * du of u, which is taken over.
+ */
+static ASTNode*
+differentiateFunction (const ASTNode* node, const ASTNode* u, ASTNode* du)
+{
+  ASTNode* outer = NULL;
+  bool negate = false;
+
+  switch (node->getType())
+  {
+  case AST_FUNCTION_EXP:
+    outer = node->deepCopy();
+    break;
+  case AST_FUNCTION_LN:
+    return simplifiedDivide(du, u->deepCopy());
+  case AST_FUNCTION_ABS:
+    {
+      ASTNode* result = new ASTNode(AST_FUNCTION_PIECEWISE);
+      result->addChild(simplifiedNegate(du->deepCopy()));
+      result->addChild(newFunction(AST_RELATIONAL_LT, u->deepCopy(), 
+                                   newNumber(0)));
+      result->addChild(du);
+      return result;
+    }
+
+  case AST_FUNCTION_SIN:
+    outer = newFunction(AST_FUNCTION_COS, u->deepCopy());
+    break;
+  case AST_FUNCTION_COS:
+    outer = newFunction(AST_FUNCTION_SIN, u->deepCopy());
+    negate = true;
+    break;
+  case AST_FUNCTION_TAN:
+    outer = newFunction(AST_POWER, 
+      newFunction(AST_FUNCTION_SEC, u->deepCopy()), newNumber(2));
+    break;
+  case AST_FUNCTION_SEC:
+    outer = newFunction(AST_TIMES, node->deepCopy(), 
+      newFunction(AST_FUNCTION_TAN, u->deepCopy()));
+    break;
+  case AST_FUNCTION_CSC:
+    outer = newFunction(AST_TIMES, node->deepCopy(), 
+      newFunction(AST_FUNCTION_COT, u->deepCopy()));
+    negate = true;
+    break;
+  case AST_FUNCTION_COT:
+    outer = newFunction(AST_POWER, 
+      newFunction(AST_FUNCTION_CSC, u->deepCopy()), newNumber(2));
+    negate = true;
+    break;
+
+  case AST_FUNCTION_SINH:
+    outer = newFunction(AST_FUNCTION_COSH, u->deepCopy());
+    break;
+  case AST_FUNCTION_COSH:
+    outer = newFunction(AST_FUNCTION_SINH, u->deepCopy());
+    break;
+  case AST_FUNCTION_TANH:
+    outer = newFunction(AST_POWER, 
+      newFunction(AST_FUNCTION_SECH, u->deepCopy()), newNumber(2));
+    break;
+  case AST_FUNCTION_SECH:
+    outer = newFunction(AST_TIMES, node->deepCopy(), 
+      newFunction(AST_FUNCTION_TANH, u->deepCopy()));
+    negate = true;
+    break;
+  case AST_FUNCTION_CSCH:
+    outer = newFunction(AST_TIMES, node->deepCopy(), 
+      newFunction(AST_FUNCTION_COTH, u->deepCopy()));
+    negate = true;
+    break;
+  case AST_FUNCTION_COTH:
+    outer = newFunction(AST_POWER, 
+      newFunction(AST_FUNCTION_CSCH, u->deepCopy()), newNumber(2));
+    negate = true;
+    break;
+
+  // the inverse functions divide du by their derivative's denominator
+  case AST_FUNCTION_ARCSIN:
+  case AST_FUNCTION_ARCCOS:
+    outer = newSqrt(newFunction(AST_MINUS, newNumber(1), newSquare(u)));
+    negate = (node->getType() == AST_FUNCTION_ARCCOS);
+    break;
+  case AST_FUNCTION_ARCTAN:
+  case AST_FUNCTION_ARCCOT:
+    outer = newFunction(AST_PLUS, newNumber(1), newSquare(u));
+    negate = (node->getType() == AST_FUNCTION_ARCCOT);
+    break;
+  case AST_FUNCTION_ARCSEC:
+  case AST_FUNCTION_ARCCSC:
+    outer = newFunction(AST_TIMES, 
+      newFunction(AST_FUNCTION_ABS, u->deepCopy()),
+      newSqrt(newFunction(AST_MINUS, newSquare(u), newNumber(1))));
+    negate = (node->getType() == AST_FUNCTION_ARCCSC);
+    break;
+  case AST_FUNCTION_ARCSINH:
+    outer = newSqrt(newFunction(AST_PLUS, newSquare(u), newNumber(1)));
+    break;
+  case AST_FUNCTION_ARCCOSH:
+    outer = newSqrt(newFunction(AST_MINUS, newSquare(u), newNumber(1)));
+    break;
+  case AST_FUNCTION_ARCTANH:
+  case AST_FUNCTION_ARCCOTH:
+    outer = newFunction(AST_MINUS, newNumber(1), newSquare(u));
+    break;
+  case AST_FUNCTION_ARCSECH:
+    outer = newFunction(AST_TIMES, u->deepCopy(),
+      newSqrt(newFunction(AST_MINUS, newNumber(1), newSquare(u))));
+    negate = true;
+    break;
+  case AST_FUNCTION_ARCCSCH:
+    outer = newFunction(AST_TIMES, 
+      newFunction(AST_FUNCTION_ABS, u->deepCopy()),
+      newSqrt(newFunction(AST_PLUS, newNumber(1), newSquare(u))));
+    negate = true;
+    break;
+
+  default:
+    delete du;
+    return NULL;
+  }
+
+  ASTNode* result;
+  switch (node->getType())
+  {
+  case AST_FUNCTION_ARCSIN:
+  case AST_FUNCTION_ARCCOS:
+  case AST_FUNCTION_ARCTAN:
+  case AST_FUNCTION_ARCCOT:
+  case AST_FUNCTION_ARCSEC:
+  case AST_FUNCTION_ARCCSC:
+  case AST_FUNCTION_ARCSINH:
+  case AST_FUNCTION_ARCCOSH:
+  case AST_FUNCTION_ARCTANH:
+  case AST_FUNCTION_ARCCOTH:
+  case AST_FUNCTION_ARCSECH:
+  case AST_FUNCTION_ARCCSCH:
+    result = simplifiedDivide(du, outer);
+    break;
+  default:
+    result = simplifiedTimes(outer, du);
+    break;
+  }
+  return negate ? simplifiedNegate(result) : result;
+}
+
+
+/*
+ * Differentiates u^v, given the derivatives du and dv, which are taken
+ * over.
+ */
+static ASTNode*
+differentiatePower (const ASTNode* u, const ASTNode* v, 
+                    ASTNode* du, ASTNode* dv)
+{
+  if (isNumberValue(dv, 0.0))
+  {
+    // v * u^(v - 1) * du
+    delete dv;
+    ASTNode* power = simplifiedPower(u->deepCopy(), 
+      simplifiedMinus(v->deepCopy(), newNumber(1)));
+    return simplifiedTimes(simplifiedTimes(v->deepCopy(), power), du);
+  }
+
+  ASTNode* power = newFunction(AST_POWER, u->deepCopy(), v->deepCopy());
+  ASTNode* ln = newFunction(AST_FUNCTION_LN, u->deepCopy());
+  if (isNumberValue(du, 0.0))
+  {
+    // u^v * ln(u) * dv
+    delete du;
+    return simplifiedTimes(simplifiedTimes(power, ln), dv);
+  }
+
+  // u^v * (dv * ln(u) + v * du / u)
+  ASTNode* sum = simplifiedPlus(simplifiedTimes(dv, ln),
+    simplifiedDivide(simplifiedTimes(v->deepCopy(), du), u->deepCopy()));
+  return simplifiedTimes(power, sum);
+}
+
+
+/*
+ * @return a new node holding the derivative of node with respect to
+ * variable, or NULL if it cannot be expressed.
+ */
+static ASTNode*
+differentiate (const ASTNode* node, const std::string& variable)
+{
+  ASTNodeType_t type = node->getType();
+  unsigned int numChildren = node->getNumChildren();
+
+  switch (type)
+  {
+  case AST_INTEGER:
+  case AST_REAL:
+  case AST_REAL_E:
+  case AST_RATIONAL:
+  case AST_NAME_AVOGADRO:
+  case AST_CONSTANT_E:
+  case AST_CONSTANT_FALSE:
+  case AST_CONSTANT_PI:
+  case AST_CONSTANT_TRUE:
+    return newNumber(0);
+
+  case AST_NAME:
+  case AST_NAME_TIME:
+    return newNumber(dependsOn(node, variable) ? 1 : 0);
+
+  // piecewise constant functions
+  case AST_FUNCTION_FLOOR:
+  case AST_FUNCTION_CEILING:
+  case AST_FUNCTION_QUOTIENT:
+    return newNumber(0);
+
+  case AST_PLUS:
+    {
+      ASTNode* result = newNumber(0);
+      for (unsigned int i = 0; i < numChildren; ++i)
+      {
+        ASTNode* term = differentiate(node->getChild(i), variable);
+        if (term == NULL)
+        {
+          delete result;
+          return NULL;
+        }
+        result = simplifiedPlus(result, term);
+      }
+      return result;
+    }
+
+  case AST_TIMES:
+    return differentiateProduct(node, variable);
+
+  case AST_FUNCTION_PIECEWISE:
+    return differentiatePiecewise(node, variable);
+
+  case AST_FUNCTION_MAX:
+  case AST_FUNCTION_MIN:
+    return differentiateExtremum(node, variable);
+
+  case AST_FUNCTION_ROOT:
+  case AST_FUNCTION_LOG:
+    if (numChildren == 1 || numChildren == 2)
+    {
+      // root(n, x) is x^(1/n) and log(b, x) is ln(x) / ln(b); a single
+      // child is the radicand of a square root, or the argument of log10
+      const ASTNode* arg = node->getChild(numChildren - 1);
+      ASTNode* rewritten;
+      if (type == AST_FUNCTION_ROOT)
+      {
+        ASTNode* degree = (numChildren == 2) ? node->getChild(0)->deepCopy() 
+                                             : newNumber(2);
+        rewritten = newFunction(AST_POWER, arg->deepCopy(), 
+          newFunction(AST_DIVIDE, newNumber(1), degree));
+      }
+      else
+      {
+        ASTNode* base = (numChildren == 2) ? node->getChild(0)->deepCopy() 
+                                           : newNumber(10);
+        rewritten = newFunction(AST_DIVIDE,
+          newFunction(AST_FUNCTION_LN, arg->deepCopy()),
+          newFunction(AST_FUNCTION_LN, base));
+      }
+      ASTNode* result = differentiate(rewritten, variable);
+      delete rewritten;
+      return result;
+    }
+    break;
+
+  default:
+    break;
+  }
+
+  // the remaining operators have a fixed number of arguments
+  ASTNode* d[2] = { NULL, NULL };
+  if (numChildren == 0 || numChildren > 2)
+  {
+    return dependsOn(node, variable) ? NULL : newNumber(0);
+  }
+
+  switch (type)
+  {
+  case AST_MINUS:
+  case AST_DIVIDE:
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+  case AST_FUNCTION_REM:
+    break;
+  default:
+    // the single argument functions differentiateFunction() knows
+    if (numChildren != 1 || type == AST_FUNCTION_FACTORIAL ||
+        (type != AST_FUNCTION_EXP && type != AST_FUNCTION_LN &&
+         type != AST_FUNCTION_ABS &&
+         (type < AST_FUNCTION_ARCCOS || type > AST_FUNCTION_TANH)))
+    {
+      return dependsOn(node, variable) ? NULL : newNumber(0);
+    }
+    break;
+  }
+
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    d[i] = differentiate(node->getChild(i), variable);
+    if (d[i] == NULL)
+    {
+      delete d[0];
+      return NULL;
+    }
+  }
+
+  const ASTNode* u = node->getChild(0);
+  const ASTNode* v = (numChildren == 2) ? node->getChild(1) : NULL;
+
+  switch (type)
+  {
+  case AST_MINUS:
+    return (v == NULL) ? simplifiedNegate(d[0]) : simplifiedMinus(d[0], d[1]);
+
+  case AST_DIVIDE:
+    if (v == NULL) break;
+    if (isNumberValue(d[1], 0.0))
+    {
+      delete d[1];
+      return simplifiedDivide(d[0], v->deepCopy());
+    }
+    // (du * v - u * dv) / v^2
+    return simplifiedDivide(
+      simplifiedMinus(simplifiedTimes(d[0], v->deepCopy()),
+                      simplifiedTimes(u->deepCopy(), d[1])),
+      newSquare(v));
+
+  case AST_POWER:
+  case AST_FUNCTION_POWER:
+    if (v == NULL) break;
+    return differentiatePower(u, v, d[0], d[1]);
+
+  case AST_FUNCTION_REM:
+    if (v == NULL) break;
+    {
+      // rem(u, v) = u - v * quotient(u, v)
+      ASTNode* quotient = newFunction(AST_FUNCTION_QUOTIENT, 
+        u->deepCopy(), v->deepCopy());
+      return simplifiedMinus(d[0], simplifiedTimes(d[1], quotient));
+    }
+
+  default:
+    return differentiateFunction(node, u, d[0]);
+  }
+
+  delete d[0];
+  delete d[1];
+  return dependsOn(node, variable) ? NULL : newNumber(0);
+}
+/** @endcond */
+
+
+LIBSBML_EXTERN
+ASTNode*
+ASTNode::derivative(const std::string& variable, const Model* model) const
+{
+  if (model == NULL || model->getNumFunctionDefinitions() == 0)
+  {
+    return differentiate(this, variable);
+  }
+
+  ASTNode* expanded = deepCopy();
+  SBMLTransforms::replaceFD(expanded, model->getListOfFunctionDefinitions());
+  ASTNode* result = differentiate(expanded, variable);
+  delete expanded;
+  return result;
+}
+
+
+LIBSBML_EXTERN
+void
+ASTNode::replaceArgument(const std::string& bvar, ASTNode * arg)
+{
+  if (arg == NULL)
+    return;
+  else if (getNumChildren() == 0)
+  {
+    if (this->isName() && this->getName() == bvar)
+    {
+      if (arg->isName())
+      {
+        this->setType(arg->getType());
+        this->setName(arg->getName());
+      }
+      else if (arg->isReal())
+      {
+        this->setValue(arg->getReal());
+        if (arg->isSetUnits())
+        {
+          this->setUnits(arg->getUnits());
+        }
+      }
+      else if (arg->isInteger())
+      {
+        this->setValue(arg->getInteger());
+        if (arg->isSetUnits())
+        {
+          this->setUnits(arg->getUnits());
+        }
+      }
+      else if (arg->isConstant())
+      {
+        this->setType(arg->getType());
+      }
+      else
+      {
+        this->setType(arg->getType());
+        this->setName(arg->getName());
+        for (unsigned int c = 0; c < arg->getNumChildren(); c++)
+        {
+          this->addChild(arg->getChild(c)->deepCopy());
+        }
+      }
+    }
+  }
+  for (unsigned int i = 0; i < getNumChildren(); i++)
+  {
+    if (getChild(i)->isName())
+    {
+      if (getChild(i)->getName() == bvar)
+      {
+        if (arg->isName())
+        {
+          getChild(i)->setType(arg->getType());
+          getChild(i)->setName(arg->getName());
+        }
+        else if (arg->isReal())
+        {
+          getChild(i)->setValue(arg->getReal());
+          if (arg->isSetUnits())
+          {
+            getChild(i)->setUnits(arg->getUnits());
+          }
+        }
+        else if (arg->isInteger())
+        {
+          getChild(i)->setValue(arg->getInteger());
+          if (arg->isSetUnits())
+          {
+            getChild(i)->setUnits(arg->getUnits());
+          }
+        }
+        else if (arg->isConstant())
+        {
+          getChild(i)->setType(arg->getType());
+        }
+        else
+        {
+          getChild(i)->setType(arg->getType());
+          getChild(i)->setName(arg->getName());
+          for (unsigned int c = 0; c < arg->getNumChildren(); c++)
+          {
+            getChild(i)->addChild(arg->getChild(c)->deepCopy());
+          }
+        }
+      }
+    }
+    else
+    {
+      getChild(i)->replaceArgument(bvar, arg);
+    }
+  }
+}
+
+LIBSBML_EXTERN
+void
+ASTNode::reduceToBinary()
+{
+  unsigned int numChildren = getNumChildren();
+  /* number of children should be greater than 2 */
+  if (numChildren < 3)
+    return;
+
+  ASTNode* op = new ASTNode( getType() );
+  ASTNode* op2 = new ASTNode( getType() );
+
+  // add the first two children to the first node
+  op->addChild(getChild(0));
+  op->addChild(getChild(1));
+
+  op2->addChild(op);
+  for (unsigned int n = 2; n < numChildren; n++)
+    op2->addChild(getChild(n));
+
+  swapChildren(op2);
+
+  // need to clean up memory but the children of op2
+  // are now the children of this ASTNode
+  // so remove them from op2 before deleting it
+  // this is why removeChild does not delete the child
+  unsigned int num = op2->getNumChildren();
+  unsigned int i = 0;
+  while(i < num)
+  {
+    op2->removeChild(0);
+    i++;
+  }
+  delete op2;
+
+  reduceToBinary();
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+LIBSBML_EXTERN
+void 
+ASTNode::setParentSBMLObject(SBase * sb)
+{
+  mParentSBMLObject = sb;
+}
+
+LIBSBML_EXTERN
+int 
+ASTNode::unsetParentSBMLObject()
 {
   mParentSBMLObject = NULL;
   return LIBSBML_OPERATION_SUCCESS;
@@ -2925,10 +3917,32 @@ ASTNode::getParentSBMLObject() const
 /*
   * gets the definitionURL attributes
   */
+LIBSBML_EXTERN
+XMLAttributes*
+ASTNode::getDefinitionURL()
+{
+  // the attributes are created on demand, but callers expect to be able
+  // to modify what is returned here
+  if (mDefinitionURL == NULL)
+  {
+    mDefinitionURL = new XMLAttributes();
+  }
+  return mDefinitionURL;
+}
+
+
 LIBSBML_EXTERN
 XMLAttributes*
 ASTNode::getDefinitionURL() const
 {
+  // nodes without a definitionURL share one empty set of attributes,
+  // so that reading a tree does not allocate
+  static XMLAttributes empty;
+
+  if (mDefinitionURL == NULL)
+  {
+    return &empty;
+  }
   return mDefinitionURL;
 }
 
@@ -3202,44 +4216,17 @@ LIBSBML_EXTERN
 ASTBasePlugin * 
 ASTNode::getASTPlugin(ASTNodeType_t type)
 {
-  unsigned int numPkgs = SBMLExtensionRegistry::getInstance().getNumASTPlugins();
-
-  for (unsigned int i = 0; i < numPkgs; i++)
-  {
-    const ASTBasePlugin* baseplugin = SBMLExtensionRegistry::getInstance().getASTPlugin(i);
-    if (baseplugin->defines(type))
-    {
-      return const_cast<ASTBasePlugin*>(baseplugin);
-    }
-  }
-  return NULL;
+  return const_cast<ASTBasePlugin*>(
+    SBMLExtensionRegistry::getInstance().getASTPluginFor(type));
 }
 
 LIBSBML_EXTERN
 ASTBasePlugin * 
 ASTNode::getASTPlugin(const std::string& name, bool isCsymbol, bool strCmpIsCaseSensitive)
 {
-  unsigned int numPkgs = SBMLExtensionRegistry::getInstance().getNumASTPlugins();
-
-  for (unsigned int i = 0; i < numPkgs; i++)
-  {
-    const ASTBasePlugin* baseplugin = SBMLExtensionRegistry::getInstance().getASTPlugin(i);
-    if (isCsymbol)
-    {
-      if (baseplugin->getASTNodeTypeForCSymbolURL(name) != AST_UNKNOWN)
-      {
-        return const_cast<ASTBasePlugin*>(baseplugin);
-      }
-    }
-    else
-    {
-      if (baseplugin->defines(name, strCmpIsCaseSensitive))
-      {
-        return const_cast<ASTBasePlugin*>(baseplugin);
-      }
-    }
-  }
-  return NULL;
+  return const_cast<ASTBasePlugin*>(
+    SBMLExtensionRegistry::getInstance().getASTPluginFor(name, isCsymbol, 
+                                                         strCmpIsCaseSensitive));
 }
 
 
@@ -3277,44 +4264,15 @@ LIBSBML_EXTERN
 const ASTBasePlugin * 
 ASTNode::getASTPlugin(ASTNodeType_t type) const
 {
-  unsigned int numPkgs = SBMLExtensionRegistry::getInstance().getNumASTPlugins();
-
-  for (unsigned int i = 0; i < numPkgs; i++)
-  {
-    const ASTBasePlugin* baseplugin = SBMLExtensionRegistry::getInstance().getASTPlugin(i);
-    if (baseplugin->defines(type))
-    {
-      return baseplugin;
-    }
-  }
-  return NULL;
+  return SBMLExtensionRegistry::getInstance().getASTPluginFor(type);
 }
 
 LIBSBML_EXTERN
 const ASTBasePlugin * 
 ASTNode::getASTPlugin(const std::string& name, bool isCsymbol, bool strCmpIsCaseSensitive) const
 {
-  unsigned int numPkgs = SBMLExtensionRegistry::getInstance().getNumASTPlugins();
-
-  for (unsigned int i = 0; i < numPkgs; i++)
-  {
-    const ASTBasePlugin* baseplugin = SBMLExtensionRegistry::getInstance().getASTPlugin(i);
-    if (isCsymbol)
-    {
-      if (baseplugin->getASTNodeTypeForCSymbolURL(name) != AST_UNKNOWN)
-      {
-        return baseplugin;
-      }
-    }
-    else
-    {
-      if (baseplugin->defines(name, strCmpIsCaseSensitive))
-      {
-        return const_cast<ASTBasePlugin*>(baseplugin);
-      }
-    }
-  }
-  return NULL;
+  return SBMLExtensionRegistry::getInstance().getASTPluginFor(name, isCsymbol, 
+                                                              strCmpIsCaseSensitive);
 }
 
 
@@ -4372,6 +5330,25 @@ ASTNode_isWellFormedASTNode(ASTNode_t* node)
 }
 
 
+LIBSBML_EXTERN
+int
+ASTNode_exactlyEqual(const ASTNode_t* node, const ASTNode_t* other)
+{
+  if (node == NULL || other == NULL) return (int) false;
+  return static_cast <int> (node->exactlyEqual(*other));
+}
+
+
+LIBSBML_EXTERN
+ASTNode_t*
+ASTNode_derivative(const ASTNode_t* node, const char* variable,
+                   const Model_t* model)
+{
+  if (node == NULL || variable == NULL) return NULL;
+  return node->derivative(variable, model);
+}
+
+
 LIBSBML_EXTERN
 XMLAttributes_t * 
 ASTNode_getDefinitionURL(ASTNode_t* node)
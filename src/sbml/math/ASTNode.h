@@ -1779,6 +1779,9 @@ setValue(value, 0);
   /**
    * Returns the MathML @c definitionURL attribute value.
    *
+   * The attributes are created on demand, so the object returned by this
+   * method is never @c NULL and may be modified.
+   *
    * @return the value of the @c definitionURL attribute, in the form of
    * a libSBML XMLAttributes object.
    *
@@ -1787,6 +1790,25 @@ setValue(value, 0);
    * @see getDefinitionURLString()
    */
   LIBSBML_EXTERN
+  XMLAttributes* getDefinitionURL();
+
+
+  /**
+   * Returns the MathML @c definitionURL attribute value.
+   *
+   * Unlike the non-const version of this method, nothing is created here,
+   * so reading a tree never allocates and is safe from several threads.
+   * Nodes without a @c definitionURL return a shared empty XMLAttributes
+   * object, which must not be modified.
+   *
+   * @return the value of the @c definitionURL attribute, in the form of
+   * a libSBML XMLAttributes object; this is never @c NULL.
+   *
+   * @see setDefinitionURL(XMLAttributes url)
+   * @see setDefinitionURL(const std::string& url)
+   * @see getDefinitionURLString()
+   */
+  LIBSBML_EXTERN
   XMLAttributes* getDefinitionURL() const;
 
 
@@ -1986,6 +2008,100 @@ setValue(value, 0);
   LIBSBML_EXTERN
   bool hasCorrectNumberArguments() const;
 
+
+  /**
+   * Returns a hash of the structure of this ASTNode and all its children.
+   *
+   * Two trees for which exactlyEqual() returns @c true always have the same
+   * hash, so the hash can be used to find candidates for identical math
+   * quickly, for example when looking for duplicate rules or kinetic laws.
+   * The hash covers the type, name, value, units and definitionURL of each
+   * node in the tree.
+   *
+   * The hash is not cached; every call walks the whole tree.  Callers that
+   * need the hashes of many subtrees should keep them themselves.
+   *
+   * @return the structural hash of this ASTNode.
+   *
+   * @see exactlyEqual(const ASTNode& rhs)
+   */
+  LIBSBML_EXTERN
+  unsigned long long getStructuralHash() const;
+
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Returns the structural hash of this ASTNode, given the structural
+   * hashes of its children in order, so that callers keeping the hashes of
+   * subtrees do not walk them again.
+   *
+   * @param childHashes the hashes of the children of this node; there must
+   * be one for each child.
+   *
+   * @return the hash getStructuralHash() would return.
+   */
+  LIBSBML_EXTERN
+  unsigned long long
+  getStructuralHash(const unsigned long long* childHashes) const;
+
+  /** @endcond */
+
+
+  /**
+   * Returns @c true if this ASTNode and the given one represent exactly the
+   * same math.
+   *
+   * The nodes must have the same type, name, value, units, definitionURL,
+   * id, class and style, and their children must be exactly equal in turn.
+   * Semantics annotations, user data and the parent SBML object are not
+   * compared.  The walk stops at the first node that differs.
+   *
+   * @param rhs the ASTNode to compare with this one.
+   *
+   * @return @c true if both trees are identical, @c false otherwise.
+   *
+   * @see getStructuralHash()
+   */
+  LIBSBML_EXTERN
+  bool exactlyEqual(const ASTNode& rhs) const;
+
+
+  /**
+   * Returns the partial derivative of this ASTNode with respect to the
+   * given variable.
+   *
+   * All core functions are supported, as are @c piecewise, @c max, @c min,
+   * @c quotient and @c rem.  Functions that are piecewise constant (@c
+   * floor, @c ceiling, @c quotient) are treated as having a zero
+   * derivative; the derivative of @c abs, @c max and @c min is expressed
+   * with @c piecewise.  Calls to function definitions are expanded first
+   * if @p model is given.  The result is simplified as it is built, so
+   * that terms multiplied by zero are dropped and numbers are folded.
+   * Unlike SBMLSimplifyMathConverter, which keeps <code>0 * x</code>
+   * because it is not zero when @c x is infinite or not a number, this
+   * treats <code>0 * x</code> and <code>0 / x</code> as zero: most of
+   * these terms are the zero derivatives of constant factors, and keeping
+   * them would make derivatives grow with every application of the
+   * product rule.  The derivative is thus only valid where the
+   * subexpressions of this ASTNode are finite.
+   *
+   * Subexpressions that do not mention @p variable may contain anything;
+   * their derivative is zero.  Where the derivative cannot be expressed,
+   * for example for @c delay, @c rateOf, @c factorial, logical or
+   * relational operators, lambda expressions or calls to function
+   * definitions that could not be expanded, @c NULL is returned.
+   *
+   * @param variable the identifier to differentiate with respect to.
+   * @param model the Model whose function definitions may be called, or
+   * @c NULL.
+   *
+   * @return a new ASTNode holding the derivative, which the caller owns,
+   * or @c NULL if it cannot be determined.
+   */
+  LIBSBML_EXTERN
+  ASTNode* derivative(const std::string& variable,
+                      const Model* model = NULL) const;
+
   /**
    * Returns the MathML @c definitionURL attribute value as a string.
    *
@@ -2285,17 +2401,38 @@ protected:
   bool canonicalizeRelational ();
 
 
+  /*
+   * The members are ordered so that the small ones share a word.  Numbers
+   * keep their value in a union tagged by mValueKind; attributes that few
+   * nodes carry live in mAttributes, and mDefinitionURL and
+   * mSemanticsAnnotations are only allocated once something is stored in
+   * them.
+   */
   ASTNodeType_t mType;
 
   char   mChar;
+  char   mValueKind;
+  bool   hasSemantics;
+  bool   mIsBvar;
+
   char*  mName;
-  long   mInteger;
-  double mReal;
-  long mDenominator;
-  long mExponent;
+
+  union
+  {
+    struct
+    {
+      long numerator;
+      long denominator;
+    } integer;
+
+    struct
+    {
+      double mantissa;
+      long   exponent;
+    } real;
+  } mValue;
 
   XMLAttributes* mDefinitionURL;
-  bool hasSemantics;
 
   List *mChildren;
 
@@ -2303,16 +2440,15 @@ protected:
 
   SBase *mParentSBMLObject;
 
-  std::string mUnits;
-
-  // additional MathML attributes
-  std::string mId;
-  std::string mClass;
-  std::string mStyle;
+  // units and the additional MathML attributes (id, class, style)
+  struct Attributes;
+  Attributes* mAttributes;
 
-  bool mIsBvar;
   void *mUserData;
-  std::string mPackageName;
+
+  Attributes& getAttributes();
+  void clearValue();
+  void resetDefinitionURL();
   
   friend class MathMLFormatter;
   friend class MathMLHandler;
@@ -4241,6 +4377,47 @@ int
 ASTNode_isWellFormedASTNode(ASTNode_t* node);
 
 
+/**
+ * Returns @c 1 (true) if the two given nodes represent exactly the same
+ * math.
+ *
+ * @param node the first node to compare.
+ * @param other the second node to compare.
+ *
+ * @return @c 1 (true) if @p node and @p other are identical trees, @c 0
+ * (false) otherwise or if either of them is @c NULL.
+ *
+ * @see ASTNode::exactlyEqual(const ASTNode& rhs)
+ *
+ * @memberof ASTNode_t
+ */
+LIBSBML_EXTERN
+int
+ASTNode_exactlyEqual(const ASTNode_t* node, const ASTNode_t* other);
+
+
+/**
+ * Returns the partial derivative of the given node with respect to the
+ * given variable.
+ *
+ * @param node the node to differentiate.
+ * @param variable the identifier to differentiate with respect to.
+ * @param model the Model_t whose function definitions may be called, or
+ * @c NULL.
+ *
+ * @return a new ASTNode_t holding the derivative, which the caller owns,
+ * or @c NULL if it cannot be determined or any argument is @c NULL.
+ *
+ * @see ASTNode::derivative(const std::string& variable, const Model* model)
+ *
+ * @memberof ASTNode_t
+ */
+LIBSBML_EXTERN
+ASTNode_t*
+ASTNode_derivative(const ASTNode_t* node, const char* variable,
+                   const Model_t* model);
+
+
 /**
  * Returns the MathML @c definitionURL attribute value of the given node.
  *
@@ -0,0 +1,288 @@
+/**
+ * @file    ASTNodePool.cpp
+ * @brief   Implementation of ASTNodePool, which hash-conses AST subtrees.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ */
+
+#include <sbml/math/ASTNodePool.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * Semantics annotations and user data are not compared, so nodes carrying
+ * them are kept apart.
+ */
+static bool
+isShareable (const ASTNode* node)
+{
+  return node->getNumSemanticsAnnotations() == 0 
+      && node->getUserData() == NULL;
+}
+
+/** @endcond */
+
+
+ASTNodePool::ASTNodePool()
+  : mEntries()
+  , mHashIndex()
+  , mNodeIndex()
+  , mNumNodes(0)
+{
+}
+
+
+ASTNodePool::~ASTNodePool()
+{
+  clear();
+}
+
+
+const ASTNode*
+ASTNodePool::add(const ASTNode* tree)
+{
+  if (tree == NULL) return NULL;
+
+  ASTNode* copy = tree->deepCopy();
+  const ASTNode* shared = addOwned(copy);
+  if (shared != copy)
+  {
+    release(copy);
+  }
+  return shared;
+}
+
+
+unsigned int
+ASTNodePool::getNumUniqueNodes() const
+{
+  return (unsigned int)mEntries.size();
+}
+
+
+unsigned int
+ASTNodePool::getNumNodes() const
+{
+  return mNumNodes;
+}
+
+
+unsigned int
+ASTNodePool::getNumOccurrences(const ASTNode* node) const
+{
+  map<const ASTNode*, size_t>::const_iterator it = mNodeIndex.find(node);
+  if (it == mNodeIndex.end())
+  {
+    return 0;
+  }
+  return mEntries[it->second].occurrences;
+}
+
+
+vector<const ASTNode*>
+ASTNodePool::getCommonSubexpressions(unsigned int minOccurrences) const
+{
+  vector<const ASTNode*> result;
+  for (size_t i = 0; i < mEntries.size(); ++i)
+  {
+    if (mEntries[i].occurrences >= minOccurrences &&
+        mEntries[i].node->getNumChildren() > 0)
+    {
+      result.push_back(mEntries[i].node);
+    }
+  }
+  return result;
+}
+
+
+void
+ASTNodePool::clear()
+{
+  // children are pool nodes themselves, so detach them before deleting
+  for (size_t i = 0; i < mEntries.size(); ++i)
+  {
+    release(mEntries[i].node);
+  }
+  mEntries.clear();
+  mHashIndex.clear();
+  mNodeIndex.clear();
+  mNumNodes = 0;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * Adds a node this pool may take over, after replacing its children by
+ * their shared nodes.  If an identical node is already present, that node
+ * is returned and the caller must release the given one.
+ */
+const ASTNode*
+ASTNodePool::addOwned(ASTNode* node)
+{
+  unsigned int numChildren = node->getNumChildren();
+  mNumNodes++;
+
+  if (numChildren > 0)
+  {
+    vector<ASTNode*> children;
+    children.reserve(numChildren);
+    while (node->getNumChildren() > 0)
+    {
+      children.push_back(node->getChild(0));
+      node->removeChild(0);
+    }
+
+    for (unsigned int i = 0; i < numChildren; ++i)
+    {
+      const ASTNode* shared = addOwned(children[i]);
+      if (shared != children[i])
+      {
+        release(children[i]);
+      }
+      // re-add as read from a file, so that lambda children are not
+      // marked as bvars again
+      node->addChild(const_cast<ASTNode*>(shared), true);
+    }
+  }
+
+  unsigned long long hash = computeHash(node);
+  if (isShareable(node))
+  {
+    const ASTNode* existing = find(node, hash);
+    if (existing != NULL)
+    {
+      mEntries[mNodeIndex[existing]].occurrences++;
+      return existing;
+    }
+  }
+
+  Entry entry;
+  entry.node = node;
+  entry.hash = hash;
+  entry.occurrences = 1;
+  mHashIndex.insert(make_pair(hash, mEntries.size()));
+  mNodeIndex[node] = mEntries.size();
+  mEntries.push_back(entry);
+  return node;
+}
+
+
+/*
+ * Returns the structural hash of the node, from the hashes already kept for
+ * its children, which are shared.
+ */
+unsigned long long
+ASTNodePool::computeHash(const ASTNode* node) const
+{
+  unsigned int numChildren = node->getNumChildren();
+  if (numChildren == 0)
+  {
+    return node->getStructuralHash(NULL);
+  }
+
+  vector<unsigned long long> childHashes(numChildren);
+  for (unsigned int i = 0; i < numChildren; ++i)
+  {
+    size_t index = mNodeIndex.find(node->getChild(i))->second;
+    childHashes[i] = mEntries[index].hash;
+  }
+  return node->getStructuralHash(&childHashes[0]);
+}
+
+
+/*
+ * Returns the node of this pool identical to the given one, or NULL.
+ */
+const ASTNode*
+ASTNodePool::find(const ASTNode* node, unsigned long long hash) const
+{
+  pair<multimap<unsigned long long, size_t>::const_iterator, 
+       multimap<unsigned long long, size_t>::const_iterator> range = 
+    mHashIndex.equal_range(hash);
+
+  unsigned int numChildren = node->getNumChildren();
+  for (multimap<unsigned long long, size_t>::const_iterator it = range.first;
+       it != range.second; ++it)
+  {
+    const ASTNode* candidate = mEntries[it->second].node;
+    if (!isShareable(candidate) ||
+        candidate->getNumChildren() != numChildren)
+    {
+      continue;
+    }
+
+    // the children must be the same shared nodes, since exactlyEqual()
+    // ignores what keeps nodes from being shared; exactlyEqual() then
+    // only compares the data of the two nodes
+    bool same = true;
+    for (unsigned int i = 0; same && i < numChildren; ++i)
+    {
+      same = (candidate->getChild(i) == node->getChild(i));
+    }
+    if (same && candidate->exactlyEqual(*node))
+    {
+      return candidate;
+    }
+  }
+  return NULL;
+}
+
+
+/*
+ * Deletes a node without deleting its children, which belong to the pool.
+ */
+void
+ASTNodePool::release(ASTNode* node)
+{
+  while (node->getNumChildren() > 0)
+  {
+    node->removeChild(0);
+  }
+  delete node;
+}
+
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_END
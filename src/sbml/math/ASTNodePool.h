@@ -0,0 +1,207 @@
+/**
+ * @file    ASTNodePool.h
+ * @brief   Stores structurally identical AST subtrees only once.
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ------------------------------------------------------------------------ -->
+ *
+ * @class ASTNodePool
+ * @sbmlbrief{core} Stores structurally identical AST subtrees only once.
+ *
+ * @htmlinclude libsbml-facility-only-warning.html
+ *
+ * Models often contain the same subexpression many times; for instance
+ * <code>compartment * k * S</code> in hundreds of reactions, or the body
+ * of a function definition that has been inlined by the
+ * SBMLFunctionDefinitionConverter.  An ASTNodePool hash-conses the trees
+ * added to it: every subtree is looked up by its structure, and all
+ * occurrences of identical subtrees are represented by one shared node
+ * owned by the pool.  The memory used by the pool, and the work needed to
+ * evaluate or analyse the trees it holds (when results are cached per
+ * node), therefore grows with the number of distinct subexpressions rather
+ * than with the textual size of the math.
+ *
+ * Two trees are considered identical when ASTNode::exactlyEqual() says
+ * so, and they are looked up by ASTNode::getStructuralHash(); the pool
+ * keeps the hash of every subtree, so adding a tree only hashes each node
+ * once.  Nodes carrying semantics annotations or user data are never
+ * shared.
+ *
+ * The nodes returned by the pool are shared between the trees that contain
+ * them: they must not be modified or deleted, and are only valid until the
+ * pool is cleared or destroyed.  Use ASTNode::deepCopy() to obtain an
+ * independent tree.  The pool also counts how often each distinct subtree
+ * occurred; getCommonSubexpressions() uses these counts to report the
+ * candidates for common subexpression elimination.
+ *
+ * An ASTNodePool is not thread-safe: a pool must not be modified while
+ * other threads use it.
+ */
+
+#ifndef ASTNodePool_h
+#define ASTNodePool_h
+
+
+#include <sbml/common/extern.h>
+
+
+#ifdef __cplusplus
+
+#include <map>
+#include <vector>
+
+#include <sbml/math/ASTNode.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN ASTNodePool
+{
+public:
+
+  /**
+   * Creates a new, empty ASTNodePool.
+   */
+  ASTNodePool();
+
+
+  /**
+   * Destroys this ASTNodePool and all the nodes it owns.
+   */
+  ~ASTNodePool();
+
+
+  /**
+   * Adds a tree to this pool.
+   *
+   * The tree itself is not modified and remains owned by the caller.
+   *
+   * @param tree the tree to add.
+   *
+   * @return the shared node representing @p tree, or @c NULL if @p tree is
+   * @c NULL.  Adding a structurally identical tree again returns the same
+   * node.
+   */
+  const ASTNode* add(const ASTNode* tree);
+
+
+  /**
+   * Returns the number of distinct nodes stored in this pool.
+   *
+   * @return the number of nodes owned by this pool.
+   */
+  unsigned int getNumUniqueNodes() const;
+
+
+  /**
+   * Returns the total number of nodes in all the trees added to this pool.
+   *
+   * @return the number of nodes the added trees would use without sharing.
+   */
+  unsigned int getNumNodes() const;
+
+
+  /**
+   * Returns how often a node of this pool occurred in the trees added to
+   * it, counting occurrences inside larger shared subtrees.
+   *
+   * @param node a node returned by this pool.
+   *
+   * @return the number of occurrences of @p node, or @c 0 if @p node does
+   * not belong to this pool.
+   */
+  unsigned int getNumOccurrences(const ASTNode* node) const;
+
+
+  /**
+   * Returns the subexpressions that occurred at least @p minOccurrences
+   * times.
+   *
+   * Only nodes with children are reported, since names and numbers are
+   * not worth eliminating.  The nodes are returned in the order they were
+   * first added to the pool, so that every subexpression comes after the
+   * subexpressions it contains.
+   *
+   * @param minOccurrences the minimum number of occurrences.
+   *
+   * @return the common subexpressions, as nodes owned by this pool.
+   */
+  std::vector<const ASTNode*> 
+  getCommonSubexpressions(unsigned int minOccurrences = 2) const;
+
+
+  /**
+   * Removes all the nodes from this pool, deleting them.
+   */
+  void clear();
+
+
+  /** @cond doxygenLibsbmlInternal */
+protected:
+
+  struct Entry
+  {
+    ASTNode*      node;
+    unsigned long long hash;
+    unsigned int  occurrences;
+  };
+
+  const ASTNode* addOwned(ASTNode* node);
+
+  unsigned long long computeHash(const ASTNode* node) const;
+
+  const ASTNode* find(const ASTNode* node, unsigned long long hash) const;
+
+  void release(ASTNode* node);
+
+  std::vector<Entry> mEntries;
+  std::multimap<unsigned long long, size_t> mHashIndex;
+  std::map<const ASTNode*, size_t> mNodeIndex;
+  unsigned int mNumNodes;
+
+  /** @endcond */
+
+private:
+  /** @cond doxygenLibsbmlInternal */
+  ASTNodePool(const ASTNodePool&);
+  ASTNodePool& operator=(const ASTNodePool&);
+  /** @endcond */
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ASTNodePool_h */
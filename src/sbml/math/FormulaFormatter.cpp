@@ -44,6 +44,12 @@
 #include <sbml/math/ASTNodeType.h>
 
 #include <sbml/util/util.h>
+#include <locale.h>
+
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#  define snprintf _snprintf
+#endif
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 /**
@@ -63,22 +69,161 @@ SBML_formulaToString (const ASTNode_t *tree)
   }
   else
   {
-    StringBuffer_t *sb = StringBuffer_create(128);
+    std::string formula;
+    formula.reserve(128);
 
-    FormulaFormatter_visit(NULL, tree, sb);
-    s = StringBuffer_getBuffer(sb);
-    safe_free(sb);
+    FormulaFormatter_visit(NULL, tree, formula);
+    s = (char *) safe_malloc(formula.size() + 1);
+    memcpy(s, formula.c_str(), formula.size() + 1);
   }
   return s;
 }
 
 
+LIBSBML_EXTERN
+void
+SBML_appendFormulaToString (std::string& formula, const ASTNode_t *tree)
+{
+  if (tree == NULL) return;
+
+  FormulaFormatter_visit(NULL, tree, formula);
+}
+
+
 /**
  * @cond doxygenLibsbmlInternal
  * The rest of this file is internal code.
  */
 
 
+/*
+ * Appends the formatted text to the given StringBuffer; used by the
+ * StringBuffer_t versions of the functions below.
+ */
+static void
+appendToStringBuffer (StringBuffer_t *sb, const std::string& s)
+{
+  StringBuffer_appendWithLength(sb, s.c_str(), (unsigned long)s.size());
+}
+
+
+/*
+ * Appends the digits of the given magnitude, preceded by a '-' if negative
+ * is true.
+ */
+static void
+appendDigits (std::string& s, unsigned long long magnitude, bool negative)
+{
+  char  digits[24];
+  char *end   = digits + sizeof(digits);
+  char *start = end;
+
+  do
+  {
+    *--start   = (char)('0' + magnitude % 10);
+    magnitude /= 10;
+  }
+  while (magnitude != 0);
+
+  if (negative)
+  {
+    *--start = '-';
+  }
+
+  s.append(start, end);
+}
+
+
+void
+FormulaFormatter_appendInt (std::string& s, long i)
+{
+  if (i < 0)
+  {
+    /* negate in unsigned arithmetic, so that LONG_MIN works too */
+    appendDigits(s, 0ULL - (unsigned long long) i, true);
+  }
+  else
+  {
+    appendDigits(s, (unsigned long long) i, false);
+  }
+}
+
+
+void
+FormulaFormatter_appendReal (std::string& s, double r)
+{
+  char        buffer[32];
+  const char *point;
+  char       *found;
+  size_t      pointLength;
+  int         length;
+
+  /*
+   * Whole numbers below 10^15 have at most 15 significant digits, so
+   * LIBSBML_FLOAT_FORMAT prints them as plain integers.  They are by far the
+   * most common numbers in models, and are written without printf.
+   */
+  if (r > -1e15 && r < 1e15 && r == floor(r))
+  {
+    if (r == 0)
+    {
+      s.append(util_isNegZero(r) ? "-0" : "0");
+    }
+    else if (r < 0)
+    {
+      appendDigits(s, (unsigned long long) -r, true);
+    }
+    else
+    {
+      appendDigits(s, (unsigned long long) r, false);
+    }
+    return;
+  }
+
+  length = snprintf(buffer, sizeof(buffer), LIBSBML_FLOAT_FORMAT, r);
+  if (length < 0 || length >= (int) sizeof(buffer))
+  {
+    length = (int) strlen(buffer);
+  }
+
+  /*
+   * Rather than switching the process to the "C" locale for every number
+   * (which is slow and affects other threads), replace the decimal point of
+   * the current locale afterwards.
+   */
+  point = localeconv()->decimal_point;
+  if (point != NULL && point[0] != '\0' && strcmp(point, ".") != 0)
+  {
+    found = strstr(buffer, point);
+    if (found != NULL)
+    {
+      pointLength = strlen(point);
+      *found = '.';
+      memmove(found + 1, found + pointLength,
+              (size_t) length - (size_t)(found - buffer) - pointLength + 1);
+      length -= (int) pointLength - 1;
+    }
+  }
+
+  s.append(buffer, (size_t) length);
+}
+
+
+void
+FormulaFormatter_appendFullExp (std::string& s, double mantissa, long exponent,
+                                double value)
+{
+  if (mantissa >= 1e14 || mantissa <= -1e14 || (mantissa < 1e-4 && mantissa > -1e-4)) 
+  {
+    FormulaFormatter_appendReal(s, value);
+    return;
+  }
+  FormulaFormatter_appendReal(s, mantissa);
+  s.append(1, 'e');
+  FormulaFormatter_appendInt(s, exponent);
+}
+
+
 /**
  * @return true (nonzero) if the given ASTNode is to formatted as a
  * function.
@@ -152,45 +297,59 @@ FormulaFormatter_isGrouped (const ASTNode_t *parent, const ASTNode_t *child)
 
 /**
  * Formats the given ASTNode as an SBML L1 token and appends the result to
- * the given StringBuffer.
+ * the given string.
  */
 void
-FormulaFormatter_format (StringBuffer_t *sb, const ASTNode_t *node)
+FormulaFormatter_format (std::string& s, const ASTNode_t *node)
 {
-  if (sb == NULL) return;
   if (ASTNode_isOperator(node))
   {
-    FormulaFormatter_formatOperator(sb, node);
+    FormulaFormatter_formatOperator(s, node);
   }
   else if (ASTNode_isFunction(node))
   {
-    FormulaFormatter_formatFunction(sb, node);
+    FormulaFormatter_formatFunction(s, node);
   }
   else if (ASTNode_isInteger(node))
   {
-    StringBuffer_appendInt(sb, ASTNode_getInteger(node));
+    FormulaFormatter_appendInt(s, ASTNode_getInteger(node));
   }
   else if (ASTNode_isRational(node))
   {
-    FormulaFormatter_formatRational(sb, node);
+    FormulaFormatter_formatRational(s, node);
   }
   else if (ASTNode_isReal(node))
   {
-    FormulaFormatter_formatReal(sb, node);
+    FormulaFormatter_formatReal(s, node);
   }
   else if ( !ASTNode_isUnknown(node) )
   {
-    StringBuffer_append(sb, ASTNode_getName(node));
+    const char* name = ASTNode_getName(node);
+    if (name != NULL)
+    {
+      s.append(name);
+    }
   }
 }
 
 
+void
+FormulaFormatter_format (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  if (sb == NULL) return;
+
+  std::string s;
+  FormulaFormatter_format(s, node);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as an SBML L1 function name and appends the
- * result to the given StringBuffer.
+ * result to the given string.
  */
 void
-FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node)
+FormulaFormatter_formatFunction (std::string& s, const ASTNode_t *node)
 {
   ASTNodeType_t type = ASTNode_getType(node);
 
@@ -198,83 +357,116 @@ FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node)
   switch (type)
   {
     case AST_FUNCTION_ARCCOS:
-      StringBuffer_append(sb, "acos");
+      s.append("acos");
       break;
 
     case AST_FUNCTION_ARCSIN:
-      StringBuffer_append(sb, "asin");
+      s.append("asin");
       break;
 
     case AST_FUNCTION_ARCTAN:
-      StringBuffer_append(sb, "atan");
+      s.append("atan");
       break;
 
     case AST_FUNCTION_CEILING:
-      StringBuffer_append(sb, "ceil");
+      s.append("ceil");
       break;
 
     case AST_FUNCTION_LN:
-      StringBuffer_append(sb, "log");
+      s.append("log");
       break;
 
     case AST_FUNCTION_POWER:
-      StringBuffer_append(sb, "pow");
+      s.append("pow");
       break;
 
     default:
-      StringBuffer_append(sb, ASTNode_getName(node));
+    {
+      const char* name = ASTNode_getName(node);
+      if (name != NULL)
+      {
+        s.append(name);
+      }
       break;
+    }
   }
 }
 
 
+void
+FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  std::string s;
+  FormulaFormatter_formatFunction(s, node);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as an SBML L1 operator and appends the result
- * to the given StringBuffer.
+ * to the given string.
  */
 void
-FormulaFormatter_formatOperator (StringBuffer_t *sb, const ASTNode_t *node)
+FormulaFormatter_formatOperator (std::string& s, const ASTNode_t *node)
 {
   ASTNodeType_t type = ASTNode_getType(node);
 
 
   if (type != AST_POWER)
   {
-    StringBuffer_appendChar(sb, ' ');
+    s.append(1, ' ');
   }
 
-  StringBuffer_appendChar(sb, ASTNode_getCharacter(node));
+  s.append(1, ASTNode_getCharacter(node));
 
   if (type != AST_POWER)
   {
-    StringBuffer_appendChar(sb, ' ');
+    s.append(1, ' ');
   }
 }
 
 
+void
+FormulaFormatter_formatOperator (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  std::string s;
+  FormulaFormatter_formatOperator(s, node);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as a rational number and appends the result to
- * the given StringBuffer.  For SBML L1 this amounts to:
+ * the given string.  For SBML L1 this amounts to:
  *
  *   "(numerator/denominator)"
  */
+void
+FormulaFormatter_formatRational (std::string& s, const ASTNode_t *node)
+{
+  s.append(1, '(');
+  FormulaFormatter_appendInt(s, ASTNode_getNumerator(node));
+  s.append(1, '/');
+  FormulaFormatter_appendInt(s, ASTNode_getDenominator(node));
+  s.append(1, ')');
+}
+
+
 void
 FormulaFormatter_formatRational (StringBuffer_t *sb, const ASTNode_t *node)
 {
-  StringBuffer_appendChar( sb, '(');
-  StringBuffer_appendInt ( sb, ASTNode_getNumerator(node)   );
-  StringBuffer_appendChar( sb, '/');
-  StringBuffer_appendInt ( sb, ASTNode_getDenominator(node) );
-  StringBuffer_appendChar( sb, ')');
+  std::string s;
+  FormulaFormatter_formatRational(s, node);
+  appendToStringBuffer(sb, s);
 }
 
 
 /**
  * Formats the given ASTNode as a real number and appends the result to
- * the given StringBuffer.
+ * the given string.
  */
 void
-FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node)
+FormulaFormatter_formatReal (std::string& s, const ASTNode_t *node)
 {
   double value = ASTNode_getReal(node);
   int    sign;
@@ -282,34 +474,44 @@ FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node)
 
   if (util_isNaN(value))
   {
-    StringBuffer_append(sb, "NaN");
+    s.append("NaN");
   }
   else if ((sign = util_isInf(value)) != 0)
   {
     if (sign == -1)
     {
-      StringBuffer_appendChar(sb, '-');
+      s.append(1, '-');
     }
 
-    StringBuffer_append(sb, "INF");
+    s.append("INF");
   }
   else if (util_isNegZero(value))
   {
-    StringBuffer_append(sb, "-0");
+    s.append("-0");
   }
   else
   {
     if (ASTNode_getType(node) == AST_REAL_E)
     {
-      StringBuffer_appendFullExp(sb, ASTNode_getMantissa(node), ASTNode_getExponent(node), value);
+      FormulaFormatter_appendFullExp(s, ASTNode_getMantissa(node), ASTNode_getExponent(node), value);
     }
     else
     {
-      StringBuffer_appendReal(sb, value);
+      FormulaFormatter_appendReal(s, value);
     }
   }
 }
 
+
+void
+FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  std::string s;
+  FormulaFormatter_formatReal(s, node);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode node.  This function is really just a
  * dispatcher to either SBML_formulaToString_visitFunction() or
@@ -318,44 +520,55 @@ FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node)
 void
 FormulaFormatter_visit ( const ASTNode_t *parent,
                          const ASTNode_t *node,
-                         StringBuffer_t  *sb )
+                         std::string&     s )
 {
 
   if (ASTNode_isLog10(node))
   {
-    FormulaFormatter_visitLog10(parent, node, sb);
+    FormulaFormatter_visitLog10(parent, node, s);
   }
   else if (ASTNode_isSqrt(node))
   {
-    FormulaFormatter_visitSqrt(parent, node, sb);
+    FormulaFormatter_visitSqrt(parent, node, s);
   }
   else if (FormulaFormatter_isFunction(node))
   {
-    FormulaFormatter_visitFunction(parent, node, sb);
+    FormulaFormatter_visitFunction(parent, node, s);
   }
   else if (ASTNode_hasTypeAndNumChildren(node, AST_MINUS, 1))
   {
-    FormulaFormatter_visitUMinus(parent, node, sb);
+    FormulaFormatter_visitUMinus(parent, node, s);
   }
   else if (ASTNode_hasTypeAndNumChildren(node, AST_PLUS, 1) || ASTNode_hasTypeAndNumChildren(node, AST_TIMES, 1))
   {
-    FormulaFormatter_visit(node, ASTNode_getChild(node, 0), sb);
+    FormulaFormatter_visit(node, ASTNode_getChild(node, 0), s);
   }
   else if (ASTNode_hasTypeAndNumChildren(node, AST_PLUS, 0))
   {
-    StringBuffer_appendInt(sb, 0);
+    s.append(1, '0');
   }
   else if (ASTNode_hasTypeAndNumChildren(node, AST_TIMES, 0))
   {
-    StringBuffer_appendInt(sb, 1);
+    s.append(1, '1');
   }
   else
   {
-    FormulaFormatter_visitOther(parent, node, sb);
+    FormulaFormatter_visitOther(parent, node, s);
   }
 }
 
 
+void
+FormulaFormatter_visit ( const ASTNode_t *parent,
+                         const ASTNode_t *node,
+                         StringBuffer_t  *sb )
+{
+  std::string s;
+  FormulaFormatter_visit(parent, node, s);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode as a function.  For this node only the
  * traversal is preorder.
@@ -363,28 +576,38 @@ FormulaFormatter_visit ( const ASTNode_t *parent,
 void
 FormulaFormatter_visitFunction ( const ASTNode_t *parent,
                                  const ASTNode_t *node,
-                                 StringBuffer_t  *sb )
+                                 std::string&     s )
 {
   unsigned int numChildren = ASTNode_getNumChildren(node);
   unsigned int n;
 
 
-  FormulaFormatter_format(sb, node);
-  StringBuffer_appendChar(sb, '(');
+  FormulaFormatter_format(s, node);
+  s.append(1, '(');
 
   if (numChildren > 0)
   {
-    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb );
+    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s );
   }
 
   for (n = 1; n < numChildren; n++)
   {
-    StringBuffer_appendChar(sb, ',');
-    StringBuffer_appendChar(sb, ' ');
-    FormulaFormatter_visit( node, ASTNode_getChild(node, n), sb );
+    s.append(", ");
+    FormulaFormatter_visit( node, ASTNode_getChild(node, n), s );
   }
 
-  StringBuffer_appendChar(sb, ')');
+  s.append(1, ')');
+}
+
+
+void
+FormulaFormatter_visitFunction ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 StringBuffer_t  *sb )
+{
+  std::string s;
+  FormulaFormatter_visitFunction(parent, node, s);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -392,14 +615,25 @@ FormulaFormatter_visitFunction ( const ASTNode_t *parent,
  * Visits the given ASTNode as the function "log(10, x)" and in doing so,
  * formats it as "log10(x)" (where x is any subexpression).
  */
+void
+FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
+                              const ASTNode_t *node,
+                              std::string&     s )
+{
+  s.append("log10(");
+  FormulaFormatter_visit(node, ASTNode_getChild(node, 1), s);
+  s.append(1, ')');
+}
+
+
 void
 FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
                               const ASTNode_t *node,
                               StringBuffer_t  *sb )
 {
-  StringBuffer_append(sb, "log10(");
-  FormulaFormatter_visit(node, ASTNode_getChild(node, 1), sb);
-  StringBuffer_appendChar(sb, ')');
+  std::string s;
+  FormulaFormatter_visitLog10(parent, node, s);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -407,14 +641,25 @@ FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
  * Visits the given ASTNode as the function "root(2, x)" and in doing so,
  * formats it as "sqrt(x)" (where x is any subexpression).
  */
+void
+FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
+                             const ASTNode_t *node,
+                             std::string&     s )
+{
+  s.append("sqrt(");
+  FormulaFormatter_visit(node, ASTNode_getChild(node, 1), s);
+  s.append(1, ')');
+}
+
+
 void
 FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
                              const ASTNode_t *node,
                              StringBuffer_t  *sb )
 {
-  StringBuffer_append(sb, "sqrt(");
-  FormulaFormatter_visit(node, ASTNode_getChild(node, 1), sb);
-  StringBuffer_appendChar(sb, ')');
+  std::string s;
+  FormulaFormatter_visitSqrt(parent, node, s);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -422,13 +667,24 @@ FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
  * Visits the given ASTNode as a unary minus.  For this node only the
  * traversal is preorder.
  */
+void
+FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               std::string&     s )
+{
+  s.append(1, '-');
+  FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), s );
+}
+
+
 void
 FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
                                const ASTNode_t *node,
                                StringBuffer_t  *sb )
 {
-  StringBuffer_appendChar(sb, '-');
-  FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), sb );
+  std::string s;
+  FormulaFormatter_visitUMinus(parent, node, s);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -438,7 +694,7 @@ FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
 void
 FormulaFormatter_visitOther ( const ASTNode_t *parent,
                               const ASTNode_t *node,
-                              StringBuffer_t  *sb )
+                              std::string&     s )
 {
   unsigned int numChildren = ASTNode_getNumChildren(node);
   int group       = FormulaFormatter_isGrouped(parent, node);
@@ -447,11 +703,11 @@ FormulaFormatter_visitOther ( const ASTNode_t *parent,
 
   if (group)
   {
-    StringBuffer_appendChar(sb, '(');
+    s.append(1, '(');
   }
 
   if (numChildren == 0) {
-    FormulaFormatter_format(sb, node);
+    FormulaFormatter_format(s, node);
   }
 
   else if (numChildren == 1)
@@ -459,28 +715,38 @@ FormulaFormatter_visitOther ( const ASTNode_t *parent,
     //I believe this would only be called for invalid ASTNode setups,
     // but this could in theory occur.  This is the safest 
     // behavior I can think of.
-    FormulaFormatter_format(sb, node);
-    StringBuffer_appendChar(sb, '(');
-    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb );
-    StringBuffer_appendChar(sb, ')');
+    FormulaFormatter_format(s, node);
+    s.append(1, '(');
+    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s );
+    s.append(1, ')');
   }
 
   else {
-    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb );
+    FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s );
 
     for (n = 1; n < numChildren; n++)
     {
-      FormulaFormatter_format(sb, node);
-      FormulaFormatter_visit( node, ASTNode_getChild(node, n), sb );
+      FormulaFormatter_format(s, node);
+      FormulaFormatter_visit( node, ASTNode_getChild(node, n), s );
     }
   }
 
   if (group)
   {
-    StringBuffer_appendChar(sb, ')');
+    s.append(1, ')');
   }
 }
+
+
+void
+FormulaFormatter_visitOther ( const ASTNode_t *parent,
+                              const ASTNode_t *node,
+                              StringBuffer_t  *sb )
+{
+  std::string s;
+  FormulaFormatter_visitOther(parent, node, s);
+  appendToStringBuffer(sb, s);
+}
 /** @endcond */
 
 LIBSBML_CPP_NAMESPACE_END
-
@@ -48,6 +48,10 @@
 
 #include <sbml/math/ASTNode.h>
 
+#ifdef __cplusplus
+#  include <string>
+#endif
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 BEGIN_C_DECLS
 
@@ -217,9 +221,125 @@ FormulaFormatter_visitOther ( const ASTNode_t *parent,
 
 #endif  /* !SWIG */
 
+/** @endcond */
+
 END_C_DECLS
-LIBSBML_CPP_NAMESPACE_END
+
+
+#if defined(__cplusplus) && !defined(SWIG)
+
+/**
+ * Appends the SBML Level&nbsp;1 text-string form of an AST to a string.
+ *
+ * This produces exactly the text returned by SBML_formulaToString(), but
+ * writes it straight into @p formula.  Callers converting many formulas can
+ * reuse one string (clearing it in between) so that, once it has grown to
+ * the size of the longest formula, no further memory is allocated.
+ *
+ * @param formula the string to which the formula is appended.
+ * @param tree the AST to be converted; if @c NULL nothing is appended.
+ *
+ * @see SBML_appendFormulaToL3String()
+ */
+LIBSBML_EXTERN
+void
+SBML_appendFormulaToString (std::string& formula, const ASTNode_t *tree);
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * The functions below are the std::string based counterparts of the
+ * StringBuffer_t functions declared above, which are implemented in terms of
+ * them.
+ */
+
+/**
+ * Appends the given integer, in decimal, to the given string.
+ */
+void
+FormulaFormatter_appendInt (std::string& s, long i);
+
+
+/**
+ * Appends the given real number to the given string, formatted like
+ * LIBSBML_FLOAT_FORMAT in the "C" locale, but without changing the locale
+ * of the process.
+ */
+void
+FormulaFormatter_appendReal (std::string& s, double r);
+
+
+/**
+ * Appends a number stored as mantissa and exponent to the given string, as
+ * "mantissa" "e" "exponent"; if the mantissa is too small or too large to be
+ * written that way, @p value is appended instead.
+ */
+void
+FormulaFormatter_appendFullExp (std::string& s, double mantissa, long exponent,
+                                double value);
+
+
+void
+FormulaFormatter_format (std::string& s, const ASTNode_t *node);
+
+
+void
+FormulaFormatter_formatFunction (std::string& s, const ASTNode_t *node);
+
+
+void
+FormulaFormatter_formatOperator (std::string& s, const ASTNode_t *node);
+
+
+void
+FormulaFormatter_formatRational (std::string& s, const ASTNode_t *node);
+
+
+void
+FormulaFormatter_formatReal (std::string& s, const ASTNode_t *node);
+
+
+void
+FormulaFormatter_visit ( const ASTNode_t *parent,
+                         const ASTNode_t *node,
+                         std::string&     s );
+
+
+void
+FormulaFormatter_visitFunction ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 std::string&     s );
+
+
+void
+FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
+                              const ASTNode_t *node,
+                              std::string&     s );
+
+
+void
+FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
+                             const ASTNode_t *node,
+                             std::string&     s );
+
+
+void
+FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               std::string&     s );
+
+
+void
+FormulaFormatter_visitOther ( const ASTNode_t *parent,
+                              const ASTNode_t *node,
+                              std::string&     s );
+
 /** @endcond */
 
+#endif  /* __cplusplus && !SWIG */
+
+LIBSBML_CPP_NAMESPACE_END
+
 #endif  /* FormulaFormatter_h */
 
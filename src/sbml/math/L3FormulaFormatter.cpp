@@ -86,10 +86,8 @@ LIBSBML_EXTERN
 char *
 SBML_formulaToL3String (const ASTNode_t *tree)
 {
-  L3ParserSettings_t* l3ps = L3ParserSettings_create();
-  char* ret = SBML_formulaToL3StringWithSettings(tree, l3ps);
-  L3ParserSettings_free(l3ps);
-  return ret;
+  L3ParserSettings defaults;
+  return SBML_formulaToL3StringWithSettings(tree, &defaults);
 }
 
 
@@ -97,20 +95,39 @@ LIBSBML_EXTERN
 char *
 SBML_formulaToL3StringWithSettings (const ASTNode_t *tree, const L3ParserSettings_t *settings)
 {
-  char           *s;
-  StringBuffer_t *sb;
+  char        *s;
+  std::string  formula;
 
   if (tree == NULL)
   {
     return NULL;
   }
 
-  sb = StringBuffer_create(128);
-  L3FormulaFormatter_visit(NULL, tree, sb, settings);
-  s = StringBuffer_getBuffer(sb);
-  safe_free(sb);
+  formula.reserve(128);
+  L3FormulaFormatter_visit(NULL, tree, formula, settings);
+  s = (char *) safe_malloc(formula.size() + 1);
+  memcpy(s, formula.c_str(), formula.size() + 1);
   return s;
 }
+
+
+LIBSBML_EXTERN
+void
+SBML_appendFormulaToL3String (std::string& formula, const ASTNode_t *tree,
+                              const L3ParserSettings_t *settings)
+{
+  if (tree == NULL) return;
+
+  if (settings == NULL)
+  {
+    L3ParserSettings defaults;
+    L3FormulaFormatter_visit(NULL, tree, formula, &defaults);
+  }
+  else
+  {
+    L3FormulaFormatter_visit(NULL, tree, formula, settings);
+  }
+}
 /** @endcond */
 
 
@@ -119,18 +136,25 @@ SBML_formulaToL3StringWithSettings (const ASTNode_t *tree, const L3ParserSetting
  * The rest of this file is internal code.
  */
 
+/*
+ * Appends the formatted text to the given StringBuffer; used by the
+ * StringBuffer_t versions of the functions below.
+ */
+static void
+appendToStringBuffer (StringBuffer_t *sb, const std::string& s)
+{
+  if (sb == NULL) return;
+  StringBuffer_appendWithLength(sb, s.c_str(), (unsigned long)s.size());
+}
+
+
 /* function used by the isTranslatedModulo function to compare 
  * children of the piecewise that can be used to construct
  * the modulo function
  */
 int equals(const ASTNode_t* a, const ASTNode_t* b)
 {
-  char* ach = SBML_formulaToL3String(a);
-  char* bch = SBML_formulaToL3String(b);
-  int ret = !strcmp (ach, bch);
-  free(ach);
-  free(bch);
-  return ret;
+  return ASTNode_exactlyEqual(a, b);
 }
 
 /* Used by getL3Precedence and other functions below.
@@ -437,81 +461,93 @@ L3FormulaFormatter_isGrouped (const ASTNode_t *parent, const ASTNode_t *child, c
 
 /**
  * Formats the given ASTNode as an SBML L3 token and appends the result to
- * the given StringBuffer.
+ * the given string.
  */
 void
-L3FormulaFormatter_format (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+L3FormulaFormatter_format (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings)
 {
-  if (sb == NULL) return;
   if (L3FormulaFormatter_isFunction(node, settings))
   {
-    L3FormulaFormatter_formatFunction(sb, node, settings);
+    L3FormulaFormatter_formatFunction(s, node, settings);
   }
   else if (ASTNode_isOperator(node) || ASTNode_getType(node) == AST_FUNCTION_POWER)
   {
-    L3FormulaFormatter_formatOperator(sb, node);
+    L3FormulaFormatter_formatOperator(s, node);
   }
   else if (ASTNode_isLogical(node) || ASTNode_isRelational(node))
   {
-    L3FormulaFormatter_formatLogicalRelational(sb, node);
+    L3FormulaFormatter_formatLogicalRelational(s, node);
   }
   else if (ASTNode_isRational(node))
   {
-    L3FormulaFormatter_formatRational(sb, node, settings);
+    L3FormulaFormatter_formatRational(s, node, settings);
   }
   else if (ASTNode_isInteger(node))
   {
-    L3FormulaFormatter_formatReal(sb, node, settings);
+    L3FormulaFormatter_formatReal(s, node, settings);
   }
   else if (ASTNode_isReal(node))
   {
-    L3FormulaFormatter_formatReal(sb, node, settings);
+    L3FormulaFormatter_formatReal(s, node, settings);
   }
   else if (ASTNode_isAvogadro(node))
   {
-    StringBuffer_append(sb, "avogadro");
+    s.append("avogadro");
   }
   else if (ASTNode_getType(node) == AST_NAME_TIME)
   {
-    StringBuffer_append(sb, "time");
+    s.append("time");
   }
   else if ( !ASTNode_isUnknown(node) )
   {
-    StringBuffer_append(sb, ASTNode_getName(node));
+    const char* name = ASTNode_getName(node);
+    if (name != NULL)
+    {
+      s.append(name);
+    }
   }
 }
 
 
+void
+L3FormulaFormatter_format (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+{
+  std::string s;
+  L3FormulaFormatter_format(s, node, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as an SBML L3 function name and appends the
- * result to the given StringBuffer.
+ * result to the given string.
  */
 void
-L3FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+L3FormulaFormatter_formatFunction (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings)
 {
   ASTNodeType_t type = ASTNode_getType(node);
   switch (type)
   {
   case AST_PLUS:
-    StringBuffer_append(sb, "plus");
+    s.append("plus");
     break;
   case AST_TIMES:
-    StringBuffer_append(sb, "times");
+    s.append("times");
     break;
   case AST_MINUS:
-    StringBuffer_append(sb, "minus");
+    s.append("minus");
     break;
   case AST_DIVIDE:
-    StringBuffer_append(sb, "divide");
+    s.append("divide");
     break;
   case AST_POWER:
-    StringBuffer_append(sb, "pow");
+    s.append("pow");
     break;
   case AST_FUNCTION_LN:
-    StringBuffer_append(sb, "ln");
+    s.append("ln");
     break;
   case AST_FUNCTION_DELAY:
-    StringBuffer_append(sb, "delay");
+    s.append("delay");
     break;
   default:
   {
@@ -524,13 +560,17 @@ L3FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node, co
         if (baseplugin->getConstCharCsymbolURLFor(type) != NULL)
         {
           foundInPlugin = true;
-          StringBuffer_append(sb, baseplugin->getConstCharFor(type));
+          const char* name = baseplugin->getConstCharFor(type);
+          if (name != NULL)
+          {
+            s.append(name);
+          }
         }
       }
     }
     if (!foundInPlugin)
     {
-      FormulaFormatter_formatFunction(sb, node);
+      FormulaFormatter_formatFunction(s, node);
     }
   }
     break;
@@ -538,65 +578,88 @@ L3FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node, co
 }
 
 
+void
+L3FormulaFormatter_formatFunction (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+{
+  std::string s;
+  L3FormulaFormatter_formatFunction(s, node, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as an SBML L1 operator and appends the result
- * to the given StringBuffer.
+ * to the given string.
  */
 void
-L3FormulaFormatter_formatOperator (StringBuffer_t *sb, const ASTNode_t *node)
+L3FormulaFormatter_formatOperator (std::string& s, const ASTNode_t *node)
 {
   ASTNodeType_t type = ASTNode_getType(node);
 
   if (type == AST_FUNCTION_POWER ||
       type == AST_POWER) {
-    StringBuffer_appendChar(sb, '^');
+    s.append(1, '^');
   }
   else 
   {
-    StringBuffer_appendChar(sb, ' ');
-    StringBuffer_appendChar(sb, ASTNode_getCharacter(node));
-    StringBuffer_appendChar(sb, ' ');
+    s.append(1, ' ');
+    s.append(1, ASTNode_getCharacter(node));
+    s.append(1, ' ');
   }
 }
 
 
+void
+L3FormulaFormatter_formatOperator (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  std::string s;
+  L3FormulaFormatter_formatOperator(s, node);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as a rational number and appends the result to
- * the given StringBuffer.  For SBML L1 this amounts to:
+ * the given string.  For SBML L1 this amounts to:
  *
  *   "(numerator/denominator)"
  */
 void
-L3FormulaFormatter_formatRational (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+L3FormulaFormatter_formatRational (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings)
 {
-  char * units;
-  StringBuffer_appendChar( sb, '(');
-  StringBuffer_appendInt ( sb, ASTNode_getNumerator(node)   );
-  StringBuffer_appendChar( sb, '/');
-  StringBuffer_appendInt ( sb, ASTNode_getDenominator(node) );
-  StringBuffer_appendChar( sb, ')');
+  s.append(1, '(');
+  FormulaFormatter_appendInt(s, ASTNode_getNumerator(node));
+  s.append(1, '/');
+  FormulaFormatter_appendInt(s, ASTNode_getDenominator(node));
+  s.append(1, ')');
 
   if (L3ParserSettings_getParseUnits(settings)) {
     if (ASTNode_hasUnits(node)) {
-      StringBuffer_appendChar( sb, ' ');
-      units = ASTNode_getUnits(node);
-      StringBuffer_append( sb, units);
-      safe_free(units);
+      s.append(1, ' ');
+      s.append(node->getUnits());
     }
   }
 }
 
 
+void
+L3FormulaFormatter_formatRational (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+{
+  std::string s;
+  L3FormulaFormatter_formatRational(s, node, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Formats the given ASTNode as a real number and appends the result to
- * the given StringBuffer.
+ * the given string.
  */
 void
-L3FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+L3FormulaFormatter_formatReal (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings)
 {
   double value = ASTNode_getReal(node);
   int    sign;
-  char * units;
 
   if (ASTNode_isInteger(node)) {
     value = ASTNode_getInteger(node);
@@ -604,77 +667,84 @@ L3FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node, const
 
   if (util_isNaN(value))
   {
-    StringBuffer_append(sb, "NaN");
+    s.append("NaN");
   }
   else if ((sign = util_isInf(value)) != 0)
   {
     if (sign == -1)
     {
-      StringBuffer_appendChar(sb, '-');
+      s.append(1, '-');
     }
 
-    StringBuffer_append(sb, "INF");
+    s.append("INF");
   }
   else if (util_isNegZero(value))
   {
-    StringBuffer_append(sb, "-0");
+    s.append("-0");
   }
   else
   {
     if (ASTNode_getType(node) == AST_REAL_E)
     {
-      StringBuffer_appendFullExp(sb, ASTNode_getMantissa(node), ASTNode_getExponent(node), value);
+      FormulaFormatter_appendFullExp(s, ASTNode_getMantissa(node), ASTNode_getExponent(node), value);
     }
     else
     {
-      StringBuffer_appendReal(sb, value);
+      FormulaFormatter_appendReal(s, value);
     }
   }
   if (L3ParserSettings_getParseUnits(settings)) {
     if (ASTNode_hasUnits(node)) {
-      StringBuffer_appendChar( sb, ' ');
-      units = ASTNode_getUnits(node);
-      StringBuffer_append( sb, units);
-      safe_free(units);
+      s.append(1, ' ');
+      s.append(node->getUnits());
     }
   }
 }
 
+
+void
+L3FormulaFormatter_formatReal (StringBuffer_t *sb, const ASTNode_t *node, const L3ParserSettings_t *settings)
+{
+  std::string s;
+  L3FormulaFormatter_formatReal(s, node, settings);
+  appendToStringBuffer(sb, s);
+}
+
 /**
  * Formats the given ASTNode as an SBML L1 operator and appends the result
- * to the given StringBuffer.
+ * to the given string.
  */
 void
-L3FormulaFormatter_formatLogicalRelational (StringBuffer_t *sb, const ASTNode_t *node)
+L3FormulaFormatter_formatLogicalRelational (std::string& s, const ASTNode_t *node)
 {
   ASTNodeType_t type = ASTNode_getType(node);
 
-  StringBuffer_appendChar(sb, ' ');
+  s.append(1, ' ');
   switch(type)
   {
   case AST_LOGICAL_AND:
-    StringBuffer_append(sb, "&&");
+    s.append("&&");
     break;
   case AST_LOGICAL_OR:
-    StringBuffer_append(sb, "||");
+    s.append("||");
     break;
   case AST_RELATIONAL_EQ:
-    StringBuffer_append(sb, "==");
+    s.append("==");
     break;
   case AST_RELATIONAL_GEQ:
-    StringBuffer_append(sb, ">=");
+    s.append(">=");
     break;
   case AST_RELATIONAL_GT:
-    StringBuffer_append(sb, ">");
+    s.append(">");
     break;
   case AST_RELATIONAL_LEQ:
-    StringBuffer_append(sb, "<=");
+    s.append("<=");
     break;
   case AST_RELATIONAL_LT:
-    StringBuffer_append(sb, "<");
+    s.append("<");
     break;
   case AST_RELATIONAL_NEQ:
-    StringBuffer_append(sb, "!=");
+    s.append("!=");
     break;
   case AST_LOGICAL_NOT:
   case AST_LOGICAL_XOR:
@@ -683,10 +753,19 @@ L3FormulaFormatter_formatLogicalRelational (StringBuffer_t *sb, const ASTNode_t
     // handled by checking unary not earlier; xor always
     // claims that it's a function, and is caught with 'isFunction'
     assert(0); 
-    StringBuffer_append(sb, "!!");
+    s.append("!!");
     break;
   }
-  StringBuffer_appendChar(sb, ' ');
+  s.append(1, ' ');
+}
+
+
+void
+L3FormulaFormatter_formatLogicalRelational (StringBuffer_t *sb, const ASTNode_t *node)
+{
+  std::string s;
+  L3FormulaFormatter_formatLogicalRelational(s, node);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -698,33 +777,33 @@ L3FormulaFormatter_formatLogicalRelational (StringBuffer_t *sb, const ASTNode_t
 void
 L3FormulaFormatter_visit ( const ASTNode_t *parent,
                            const ASTNode_t *node,
-                           StringBuffer_t  *sb, 
+                           std::string&     s, 
                            const L3ParserSettings_t *settings )
 {
 
   if (ASTNode_isLog10(node))
   {
-    L3FormulaFormatter_visitLog10(parent, node, sb, settings);
+    L3FormulaFormatter_visitLog10(parent, node, s, settings);
   }
   else if (ASTNode_isSqrt(node))
   {
-    L3FormulaFormatter_visitSqrt(parent, node, sb, settings);
+    L3FormulaFormatter_visitSqrt(parent, node, s, settings);
   }
   else if (isTranslatedModulo(node))
   {
-    L3FormulaFormatter_visitModulo(parent, node, sb, settings);
+    L3FormulaFormatter_visitModulo(parent, node, s, settings);
   }
   else if (L3FormulaFormatter_isFunction(node, settings))
   {
-    L3FormulaFormatter_visitFunction(parent, node, sb, settings);
+    L3FormulaFormatter_visitFunction(parent, node, s, settings);
   }
   else if (ASTNode_isUMinus(node))
   {
-    L3FormulaFormatter_visitUMinus(parent, node, sb, settings);
+    L3FormulaFormatter_visitUMinus(parent, node, s, settings);
   }
   else if (ASTNode_hasTypeAndNumChildren(node, AST_LOGICAL_NOT, 1))
   {
-    L3FormulaFormatter_visitUNot(parent, node, sb, settings);
+    L3FormulaFormatter_visitUNot(parent, node, s, settings);
   }
   else
   {
@@ -740,7 +819,11 @@ L3FormulaFormatter_visit ( const ASTNode_t *parent,
         plugin->connectToParent((ASTNode*)(node));
         if (plugin->hasPackageOnlyInfixSyntax())
         {
+          // packages write their syntax to a StringBuffer_t
+          StringBuffer_t *sb = StringBuffer_create(64);
           L3ParserSettings_visitPackageInfixSyntax(parent, node, sb, settings);
+          s.append(StringBuffer_getBuffer(sb), StringBuffer_length(sb));
+          StringBuffer_free(sb);
           foundInPackage = true;
         }
         delete plugin;
@@ -748,12 +831,24 @@ L3FormulaFormatter_visit ( const ASTNode_t *parent,
     }
     if (!foundInPackage)
     {
-      L3FormulaFormatter_visitOther(parent, node, sb, settings);
+      L3FormulaFormatter_visitOther(parent, node, s, settings);
     }
   }
 }
 
 
+void
+L3FormulaFormatter_visit ( const ASTNode_t *parent,
+                           const ASTNode_t *node,
+                           StringBuffer_t  *sb, 
+                           const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visit(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode as a function.  For this node only the
  * traversal is preorder.
@@ -761,29 +856,41 @@ L3FormulaFormatter_visit ( const ASTNode_t *parent,
 void
 L3FormulaFormatter_visitFunction ( const ASTNode_t *parent,
                                    const ASTNode_t *node,
-                                   StringBuffer_t  *sb, 
+                                   std::string&     s, 
                                    const L3ParserSettings_t *settings )
 {
   unsigned int numChildren = ASTNode_getNumChildren(node);
   unsigned int n;
 
 
-  L3FormulaFormatter_format(sb, node, settings);
-  StringBuffer_appendChar(sb, '(');
+  L3FormulaFormatter_format(s, node, settings);
+  s.append(1, '(');
 
   if (numChildren > 0)
   {
-    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb, settings);
+    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s, settings);
   }
 
   for (n = 1; n < numChildren; n++)
   {
-    StringBuffer_appendChar(sb, ',');
-    StringBuffer_appendChar(sb, ' ');
-    L3FormulaFormatter_visit( node, ASTNode_getChild(node, n), sb, settings);
+    s.append(1, ',');
+    s.append(1, ' ');
+    L3FormulaFormatter_visit( node, ASTNode_getChild(node, n), s, settings);
   }
 
-  StringBuffer_appendChar(sb, ')');
+  s.append(1, ')');
+}
+
+
+void
+L3FormulaFormatter_visitFunction ( const ASTNode_t *parent,
+                                   const ASTNode_t *node,
+                                   StringBuffer_t  *sb, 
+                                   const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visitFunction(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -791,15 +898,27 @@ L3FormulaFormatter_visitFunction ( const ASTNode_t *parent,
  * Visits the given ASTNode as the function "log(10, x)" and in doing so,
  * formats it as "log10(x)" (where x is any subexpression).
  */
+void
+L3FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
+                                const ASTNode_t *node,
+                                std::string&     s, 
+                                const L3ParserSettings_t *settings )
+{
+  s.append("log10(");
+  L3FormulaFormatter_visit(node, ASTNode_getChild(node, 1), s, settings);
+  s.append(1, ')');
+}
+
+
 void
 L3FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
                                 const ASTNode_t *node,
                                 StringBuffer_t  *sb, 
                                 const L3ParserSettings_t *settings )
 {
-  StringBuffer_append(sb, "log10(");
-  L3FormulaFormatter_visit(node, ASTNode_getChild(node, 1), sb, settings);
-  StringBuffer_appendChar(sb, ')');
+  std::string s;
+  L3FormulaFormatter_visitLog10(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -807,15 +926,27 @@ L3FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
  * Visits the given ASTNode as the function "root(2, x)" and in doing so,
  * formats it as "sqrt(x)" (where x is any subexpression).
  */
+void
+L3FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               std::string&     s, 
+                               const L3ParserSettings_t *settings )
+{
+  s.append("sqrt(");
+  L3FormulaFormatter_visit(node, ASTNode_getChild(node, 1), s, settings);
+  s.append(1, ')');
+}
+
+
 void
 L3FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
                                const ASTNode_t *node,
                                StringBuffer_t  *sb, 
                                const L3ParserSettings_t *settings )
 {
-  StringBuffer_append(sb, "sqrt(");
-  L3FormulaFormatter_visit(node, ASTNode_getChild(node, 1), sb, settings);
-  StringBuffer_appendChar(sb, ')');
+  std::string s;
+  L3FormulaFormatter_visitSqrt(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
 }
 
 
@@ -826,7 +957,7 @@ L3FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
 void
 L3FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
                                  const ASTNode_t *node,
-                                 StringBuffer_t  *sb, 
+                                 std::string&     s, 
                                  const L3ParserSettings_t *settings )
 {
   //Unary minus is *not* the highest precedence, since it is superceded by 'power'
@@ -836,7 +967,7 @@ L3FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
   if (L3ParserSettings_getParseCollapseMinus(settings)) {
     if (ASTNode_getNumChildren(node) == 1 &&
         ASTNode_isUMinus(ASTNode_getLeftChild(node))) {
-      L3FormulaFormatter_visit(parent, ASTNode_getLeftChild(ASTNode_getLeftChild(node)), sb, settings);
+      L3FormulaFormatter_visit(parent, ASTNode_getLeftChild(ASTNode_getLeftChild(node)), s, settings);
       return;
     }
   }
@@ -845,24 +976,36 @@ L3FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
 
   if (group)
   {
-    StringBuffer_appendChar(sb, '(');
+    s.append(1, '(');
   }
-  StringBuffer_appendChar(sb, '-');
-  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), sb, settings);
+  s.append(1, '-');
+  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), s, settings);
   if (group)
   {
-    StringBuffer_appendChar(sb, ')');
+    s.append(1, ')');
   }
 }
 
 
+void
+L3FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 StringBuffer_t  *sb, 
+                                 const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visitUMinus(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode as a unary not.
  */
 void
 L3FormulaFormatter_visitUNot ( const ASTNode_t *parent,
                                const ASTNode_t *node,
-                               StringBuffer_t  *sb, 
+                               std::string&     s, 
                                const L3ParserSettings_t *settings )
 {
   //Unary not is also not the highest precedence, since it is superceded by 'power'
@@ -870,17 +1013,29 @@ L3FormulaFormatter_visitUNot ( const ASTNode_t *parent,
 
   if (group)
   {
-    StringBuffer_appendChar(sb, '(');
+    s.append(1, '(');
   }
-  StringBuffer_appendChar(sb, '!');
-  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), sb, settings);
+  s.append(1, '!');
+  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(node), s, settings);
   if (group)
   {
-    StringBuffer_appendChar(sb, ')');
+    s.append(1, ')');
   }
 }
 
 
+void
+L3FormulaFormatter_visitUNot ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               StringBuffer_t  *sb, 
+                               const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visitUNot(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode, translating the piecewise function
  * to the much simpler 'x % y' format.
@@ -888,40 +1043,52 @@ L3FormulaFormatter_visitUNot ( const ASTNode_t *parent,
 void
 L3FormulaFormatter_visitModulo ( const ASTNode_t *parent,
                                  const ASTNode_t *node,
-                                 StringBuffer_t  *sb, 
+                                 std::string&     s, 
                                  const L3ParserSettings_t *settings )
 {
   unsigned int group       = L3FormulaFormatter_isGrouped(parent, node, settings);
   const ASTNode_t* subnode = ASTNode_getLeftChild(node);
   if (group)
   {
-    StringBuffer_appendChar(sb, '(');
+    s.append(1, '(');
   }
 
   //Get x and y from the first child of the piecewise function, 
   // then the first child of that (times), and the first child
   // of that (minus).
-  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(subnode), sb, settings);
-  StringBuffer_appendChar(sb, ' ');
-  StringBuffer_appendChar(sb, '%');
-  StringBuffer_appendChar(sb, ' ');
+  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(subnode), s, settings);
+  s.append(1, ' ');
+  s.append(1, '%');
+  s.append(1, ' ');
   subnode = ASTNode_getRightChild(subnode);
-  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(subnode), sb, settings);
+  L3FormulaFormatter_visit ( node, ASTNode_getLeftChild(subnode), s, settings);
 
   if (group)
   {
-    StringBuffer_appendChar(sb, ')');
+    s.append(1, ')');
   }
 }
 
 
+void
+L3FormulaFormatter_visitModulo ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 StringBuffer_t  *sb, 
+                                 const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visitModulo(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 /**
  * Visits the given ASTNode and continues the inorder traversal.
  */
 void
 L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
                                 const ASTNode_t *node,
-                                StringBuffer_t  *sb, 
+                                std::string&     s, 
                                 const L3ParserSettings_t *settings )
 {
   unsigned int numChildren = ASTNode_getNumChildren(node);
@@ -931,11 +1098,11 @@ L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
 
   if (group)
   {
-    StringBuffer_appendChar(sb, '(');
+    s.append(1, '(');
   }
 
   if (numChildren == 0) {
-    L3FormulaFormatter_format(sb, node, settings);
+    L3FormulaFormatter_format(s, node, settings);
   }
 
   else if (numChildren == 1)
@@ -943,29 +1110,41 @@ L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
     //I believe this would only be called for invalid ASTNode setups,
     // but this could in theory occur.  This is the safest 
     // behavior I can think of.
-    L3FormulaFormatter_format(sb, node, settings);
-    StringBuffer_appendChar(sb, '(');
-    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb, settings);
-    StringBuffer_appendChar(sb, ')');
+    L3FormulaFormatter_format(s, node, settings);
+    s.append(1, '(');
+    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s, settings);
+    s.append(1, ')');
   }
 
   else {
-    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), sb, settings);
+    L3FormulaFormatter_visit( node, ASTNode_getChild(node, 0), s, settings);
 
     for (n = 1; n < numChildren; n++)
     {
-      L3FormulaFormatter_format(sb, node, settings);
-      L3FormulaFormatter_visit( node, ASTNode_getChild(node, n), sb, settings);
+      L3FormulaFormatter_format(s, node, settings);
+      L3FormulaFormatter_visit( node, ASTNode_getChild(node, n), s, settings);
     }
   }
 
   if (group)
   {
-    StringBuffer_appendChar(sb, ')');
+    s.append(1, ')');
   }
 }
 
 
+void
+L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
+                                const ASTNode_t *node,
+                                StringBuffer_t  *sb, 
+                                const L3ParserSettings_t *settings )
+{
+  std::string s;
+  L3FormulaFormatter_visitOther(parent, node, s, settings);
+  appendToStringBuffer(sb, s);
+}
+
+
 
 //This function determines if the node in question has unambiguous grammar; that
 // is, if it needs to worry about any of its components having parentheses.
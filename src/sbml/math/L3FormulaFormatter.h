@@ -53,6 +53,10 @@
 
 #include <sbml/math/ASTNode.h>
 
+#ifdef __cplusplus
+#  include <string>
+#endif
+
 LIBSBML_CPP_NAMESPACE_BEGIN
 BEGIN_C_DECLS
 
@@ -324,9 +328,130 @@ L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
 
 #endif  /* !SWIG */
 
+/** @endcond */
+
 END_C_DECLS
-LIBSBML_CPP_NAMESPACE_END
+
+
+#if defined(__cplusplus) && !defined(SWIG)
+
+/**
+ * Appends the SBML Level&nbsp;3 text-string form of an AST to a string.
+ *
+ * This produces exactly the text returned by
+ * SBML_formulaToL3StringWithSettings(), but writes it straight into
+ * @p formula.  Callers converting many formulas (for instance all the
+ * kinetic laws of a model) can reuse one string, clearing it in between,
+ * so that once it has grown to the size of the longest formula no further
+ * memory is allocated.
+ *
+ * @param formula the string to which the formula is appended.
+ * @param tree the AST to be converted; if @c NULL nothing is appended.
+ * @param settings the L3ParserSettings_t object used to modify the
+ * output; if @c NULL, the default settings are used, as in
+ * SBML_formulaToL3String().
+ *
+ * @see SBML_appendFormulaToString()
+ */
+LIBSBML_EXTERN
+void
+SBML_appendFormulaToL3String (std::string& formula, const ASTNode_t *tree,
+                              const L3ParserSettings_t *settings = NULL);
+
+
+/** @cond doxygenLibsbmlInternal */
+
+/*
+ * The functions below are the std::string based counterparts of the
+ * StringBuffer_t functions declared above, which are implemented in terms of
+ * them.
+ */
+
+
+void
+L3FormulaFormatter_format (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings);
+
+
+void
+L3FormulaFormatter_formatFunction (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings);
+
+
+void
+L3FormulaFormatter_formatOperator (std::string& s, const ASTNode_t *node);
+
+
+void
+L3FormulaFormatter_formatRational (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings);
+
+
+void
+L3FormulaFormatter_formatReal (std::string& s, const ASTNode_t *node, const L3ParserSettings_t *settings);
+
+
+void
+L3FormulaFormatter_formatLogicalRelational(std::string& s, const ASTNode_t *node);
+
+
+void
+L3FormulaFormatter_visit ( const ASTNode_t *parent,
+                           const ASTNode_t *node,
+                           std::string&     s,
+                           const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitFunction ( const ASTNode_t *parent,
+                                   const ASTNode_t *node,
+                                   std::string&     s,
+                                   const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitLog10 ( const ASTNode_t *parent,
+                                const ASTNode_t *node,
+                                std::string&     s,
+                                const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitSqrt ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               std::string&     s,
+                               const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitUMinus ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 std::string&     s,
+                                 const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitUNot ( const ASTNode_t *parent,
+                               const ASTNode_t *node,
+                               std::string&     s,
+                               const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitModulo ( const ASTNode_t *parent,
+                                 const ASTNode_t *node,
+                                 std::string&     s,
+                                 const L3ParserSettings_t *settings );
+
+
+void
+L3FormulaFormatter_visitOther ( const ASTNode_t *parent,
+                                const ASTNode_t *node,
+                                std::string&     s,
+                                const L3ParserSettings_t *settings );
+
 /** @endcond */
 
+#endif  /* __cplusplus && !SWIG */
+
+LIBSBML_CPP_NAMESPACE_END
+
 #endif  /* L3FormulaFormatter_h */
 
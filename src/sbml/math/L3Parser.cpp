@@ -1,8 +1,8 @@
-/* A Bison parser, made by GNU Bison 3.5.1.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2020 Free Software Foundation,
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
    Inc.
 
    This program is free software: you can redistribute it and/or modify
@@ -16,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -34,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -41,20 +45,17 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Undocumented macros, especially those whose name start with YY_,
-   are private implementation details.  Do not rely on them.  */
-
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.5.1"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
 
 /* Pure parsers.  */
-#define YYPURE 0
+#define YYPURE 2
 
 /* Push parsers.  */
 #define YYPUSH 0
@@ -68,7 +69,7 @@
 
  /** @cond doxygenLibsbmlInternal */
 
-#line 72 "L3Parser.cpp"
+#line 73 "L3Parser.cpp"
 /* Substitute the type names.  */
 #define YYSTYPE         SBML_YYSTYPE
 /* Substitute the variable and function names.  */
@@ -77,8 +78,6 @@
 #define yyerror         sbml_yyerror
 #define yydebug         sbml_yydebug
 #define yynerrs         sbml_yynerrs
-#define yylval          sbml_yylval
-#define yychar          sbml_yychar
 
 /* First part of user prologue.  */
 #line 66 "L3Parser.ypp"
@@ -106,8 +105,18 @@
 #include <sbml/math/L3Parser.h>
 #include <sbml/math/L3ParserSettings.h>
 #include <sbml/extension/ASTBasePlugin.h>
+#include <sbml/extension/SBMLExtensionRegistry.h>
+#include <sbml/util/ParallelTask.h>
 #include <sbml/util/util.h>
 
+#include <sbml/common/libsbml-config.h>
+
+#include <cerrno>
+#include <climits>
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
 #include <sstream>
 #include <set>
 
@@ -117,21 +126,54 @@ class SBMLVisitor;
 class FormulaUnitsData;
 
 #ifndef SWIG //Hide the entire class from SWIG
+/**
+ * @class L3ParserSymbolTable
+ * @ingroup core
+ * @brief The ids of a Model that matter to the parser.
+ *
+ * The parser needs to know whether a name is already used by the model,
+ * since a model element called (say) 'pi' must not be read as the constant.
+ * When many formulas are parsed in the context of the same model, these
+ * ids are collected once into an L3ParserSymbolTable, instead of the model
+ * being searched again for every name in every formula.
+ * @internal
+ */
+struct L3ParserSymbolTable
+{
+  /**
+   * Collects the ids of the given model.
+   */
+  L3ParserSymbolTable(const Model* model);
+
+  /**
+   * The ids of the species, compartments, reactions, parameters and 
+   * species references of the model (species references being known by
+   * both their own id and that of their species).
+   */
+  std::set<std::string> variables;
+
+  /**
+   * The ids of the function definitions of the model.
+   */
+  std::set<std::string> functions;
+};
+
 /**
  * @class L3Parser
  * @ingroup core
  * @brief Class providing functionality for the bison-generated parser.
  *
  * The L3Parser class is an internal class designed to hold the guts of the bison parser, plus
- * the lexer.  It is designed to be a global singleton object, because that's the cleanest way
- * I could find to incorporate functions into the bison framework.
+ * the lexer.  A new L3Parser object is created for every string that is parsed, and passed
+ * to the (pure) bison parser and lexer, so that any number of strings may be parsed at the
+ * same time from different threads.
  *
  * The functions declared in this file are defined in the file L3Parser.ypp, which
  * must be compiled by bison to create L3Parser.cpp, the file included in
  * libsbml.  For more details, see the L3Parser.ypp file.
  *
- * Within the various 'sbml_yylex*' functions that bison creates, functions
- * from the global 'l3p' object (of the L3Parser class) are used to calculate
+ * Within the various 'sbml_yy*' functions that bison creates, functions
+ * from the 'l3p' parameter (of the L3Parser class) are used to calculate
  * necessary information for the parsing of the string, and to determine appropriate
  * error messages when things go wrong.
  * @internal
@@ -140,7 +182,9 @@ class LIBSBML_EXTERN L3Parser
 {
 public:
 
-  std::stringstream input;
+  const char* input;
+  const char* inputEnd;
+  const char* current;
   ASTNode* outputNode;
   std::string error;
   std::map<std::string, std::string*> words;
@@ -157,6 +201,7 @@ public:
   const L3ParserSettings* currentSettings;
   bool strCmpIsCaseSensitive;
   bool modulol3v2;
+  const L3ParserSymbolTable* symbols;
 
   L3Parser();
   virtual ~L3Parser();
@@ -220,16 +265,57 @@ public:
    * 'getFunctionFor' functions.
    */
   bool l3StrCmp(const std::string& lhs, const std::string& rhs) const;
+  /**
+   * Returns 'true' if 'name' is the id of a species, compartment, reaction,
+   * parameter or species reference in the model (if any) that this
+   * formula is parsed for.  The 'symbols' table is used if it is set.
+   */
+  bool isModelSymbol(const std::string& name) const;
+  /**
+   * Returns 'true' if 'name' is the id of a function definition in the 
+   * model (if any) that this formula is parsed for.
+   */
+  bool isModelFunction(const std::string& name) const;
   /**
    * Sets the member variable 'modulol3v2' to the provided boolean value.  Used in parsing
    * the '%' symbol.
    */
   void setModuloL3v2(bool ml3v2);
   /**
-   * Sets the member variable 'l3v2functions' to the provided boolean value.  Used in parsing
-   * the functions added to the SBML spec in l3v2.
+   * Sets the string to be parsed.  The string is not copied, and must stay
+   * unchanged until parsing is finished.
    */
   void setInput(const char* c);
+  /**
+   * Sets the characters in the range [begin, end) as the string to be parsed.
+   */
+  void setInput(const char* begin, const char* end);
+  /**
+   * Copies all parser settings from the given L3ParserSettings object.
+   */
+  void setSettings(const L3ParserSettings* settings);
+  /**
+   * Returns the next input character (as an unsigned char) and moves past
+   * it, or returns EOF if the whole input has been read.
+   */
+  int get()
+  {
+    return (current < inputEnd) ? static_cast<unsigned char>(*current++) : EOF;
+  }
+  /**
+   * Returns the next input character without moving past it, or EOF.
+   */
+  int peek() const
+  {
+    return (current < inputEnd) ? static_cast<unsigned char>(*current) : EOF;
+  }
+  /**
+   * Moves back over the character most recently returned by 'get'.
+   */
+  void unget()
+  {
+    --current;
+  }
   /**
    * Sets the error string so that it can be retrieved by the function 
    * 'SBML_getLastParseL3Error'.
@@ -320,13 +406,16 @@ public:
 
 
   /**
-   * If the either versions of the function @see SBML_parseL3Formula() returns NULL, an error 
-   * is set internally which is accessible via this function.  The returned error will 
-   * report the string it was trying to parse, which character it had parsed when it 
-   * encountered the error, and what the error was.
-   * 
+   * Parses the characters in the range [begin, end) using the given settings,
+   * and returns the resulting ASTNode, or NULL if parsing failed.  All state
+   * used while parsing is kept in a local L3Parser object, so this function
+   * may be called from several threads at once.  The error message (if any)
+   * is stored for the calling thread, and may be retrieved with
+   * 'SBML_getLastParseL3Error'.
    */
-  static char* getLastParseL3Error();
+  static ASTNode* parse(const char* begin, const char* end,
+                        const L3ParserSettings* settings,
+                        const L3ParserSymbolTable* symbols = NULL);
 };
 #endif //The entire class should be invisible to SWIG, too.
 
@@ -334,32 +423,14 @@ LIBSBML_CPP_NAMESPACE_END
 
   using namespace std;
 
-  int sbml_yylex(void);
-  L3Parser* l3p = NULL;
-
-
-LIBSBML_CPP_NAMESPACE_BEGIN
-L3Parser* L3Parser_getInstance()
-{
-  if (l3p == NULL)
-  {
-    l3p = new L3Parser();
-    std::atexit(SBML_deleteL3Parser);
-  }
-  return l3p;
-}
-LIBSBML_CPP_NAMESPACE_END
-
-  void sbml_yyerror(char const *);
-  int sbml_yylloc_first_position = 1;
-  int sbml_yylloc_last_position = 1;
+  void sbml_yyerror(L3Parser* l3p, char const *);
 
 #ifdef __BORLANDC__
 #undef DOUBLE
 #endif
 
 
-#line 363 "L3Parser.cpp"
+#line 434 "L3Parser.cpp"
 
 # ifndef YY_CAST
 #  ifdef __cplusplus
@@ -382,14 +453,6 @@ LIBSBML_CPP_NAMESPACE_END
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
 
 /* Debug traces.  */
 #ifndef SBML_YYDEBUG
@@ -407,28 +470,32 @@ LIBSBML_CPP_NAMESPACE_END
 extern int sbml_yydebug;
 #endif
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef SBML_YYTOKENTYPE
 # define SBML_YYTOKENTYPE
   enum sbml_yytokentype
   {
-    YYEOF = 0,
-    NOT = 258,
-    NEG = 259,
-    UPLUS = 260,
-    DOUBLE = 261,
-    INTEGER = 262,
-    E_NOTATION = 263,
-    RATIONAL = 264,
-    SYMBOL = 265
+    SBML_YYEMPTY = -2,
+    SBML_YYEOF = 0,                /* "end of string"  */
+    SBML_YYerror = 256,            /* error  */
+    SBML_YYUNDEF = 257,            /* "invalid token"  */
+    NOT = 258,                     /* NOT  */
+    NEG = 259,                     /* NEG  */
+    UPLUS = 260,                   /* UPLUS  */
+    DOUBLE = 261,                  /* "number"  */
+    INTEGER = 262,                 /* "integer"  */
+    E_NOTATION = 263,              /* "number in e-notation form"  */
+    RATIONAL = 264,                /* "number in rational notation"  */
+    SYMBOL = 265                   /* "element name"  */
   };
+  typedef enum sbml_yytokentype sbml_yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined SBML_YYSTYPE && ! defined SBML_YYSTYPE_IS_DECLARED
 union SBML_YYSTYPE
 {
-#line 345 "L3Parser.ypp"
+#line 417 "L3Parser.ypp"
 
   ASTNode* astnode;
   char character;
@@ -438,7 +505,7 @@ union SBML_YYSTYPE
   double mantissa;
   long   rational;
 
-#line 442 "L3Parser.cpp"
+#line 509 "L3Parser.cpp"
 
 };
 typedef union SBML_YYSTYPE SBML_YYSTYPE;
@@ -447,10 +514,61 @@ typedef union SBML_YYSTYPE SBML_YYSTYPE;
 #endif
 
 
-extern SBML_YYSTYPE sbml_yylval;
 
-int sbml_yyparse (void);
 
+int sbml_yyparse (L3Parser* l3p);
+
+/* "%code provides" blocks.  */
+#line 451 "L3Parser.ypp"
+
+  int sbml_yylex(SBML_YYSTYPE* lval, L3Parser* l3p);
+
+#line 527 "L3Parser.cpp"
+
+
+/* Symbol kind.  */
+enum yysymbol_kind_t
+{
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of string"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_3_ = 3,                         /* '&'  */
+  YYSYMBOL_4_ = 4,                         /* '|'  */
+  YYSYMBOL_5_ = 5,                         /* '<'  */
+  YYSYMBOL_6_ = 6,                         /* '>'  */
+  YYSYMBOL_7_ = 7,                         /* '='  */
+  YYSYMBOL_8_ = 8,                         /* '!'  */
+  YYSYMBOL_9_ = 9,                         /* '-'  */
+  YYSYMBOL_10_ = 10,                       /* '+'  */
+  YYSYMBOL_11_ = 11,                       /* '*'  */
+  YYSYMBOL_12_ = 12,                       /* '/'  */
+  YYSYMBOL_13_ = 13,                       /* '%'  */
+  YYSYMBOL_NOT = 14,                       /* NOT  */
+  YYSYMBOL_NEG = 15,                       /* NEG  */
+  YYSYMBOL_UPLUS = 16,                     /* UPLUS  */
+  YYSYMBOL_17_ = 17,                       /* '^'  */
+  YYSYMBOL_18_ = 18,                       /* '['  */
+  YYSYMBOL_DOUBLE = 19,                    /* "number"  */
+  YYSYMBOL_INTEGER = 20,                   /* "integer"  */
+  YYSYMBOL_E_NOTATION = 21,                /* "number in e-notation form"  */
+  YYSYMBOL_RATIONAL = 22,                  /* "number in rational notation"  */
+  YYSYMBOL_SYMBOL = 23,                    /* "element name"  */
+  YYSYMBOL_24_ = 24,                       /* '('  */
+  YYSYMBOL_25_ = 25,                       /* ')'  */
+  YYSYMBOL_26_ = 26,                       /* ']'  */
+  YYSYMBOL_27_ = 27,                       /* '{'  */
+  YYSYMBOL_28_ = 28,                       /* '}'  */
+  YYSYMBOL_29_ = 29,                       /* ','  */
+  YYSYMBOL_30_ = 30,                       /* ';'  */
+  YYSYMBOL_YYACCEPT = 31,                  /* $accept  */
+  YYSYMBOL_input = 32,                     /* input  */
+  YYSYMBOL_node = 33,                      /* node  */
+  YYSYMBOL_number = 34,                    /* number  */
+  YYSYMBOL_nodelist = 35,                  /* nodelist  */
+  YYSYMBOL_nodesemicolonlist = 36          /* nodesemicolonlist  */
+};
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
 
 
@@ -492,6 +610,18 @@ typedef int_least16_t yytype_int16;
 typedef short yytype_int16;
 #endif
 
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
+#endif
+
 #if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
 typedef __UINT_LEAST8_TYPE__ yytype_uint8;
 #elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
@@ -551,6 +681,7 @@ typedef int yytype_uint16;
 
 #define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
 
+
 /* Stored state numbers (used for stacks). */
 typedef yytype_int8 yy_state_t;
 
@@ -569,6 +700,7 @@ typedef int yy_state_fast_t;
 # endif
 #endif
 
+
 #ifndef YY_ATTRIBUTE_PURE
 # if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
 #  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
@@ -587,17 +719,23 @@ typedef int yy_state_fast_t;
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && ! defined __ICC && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                            \
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
     _Pragma ("GCC diagnostic push")                                     \
     _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+# endif
 # define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
@@ -626,7 +764,7 @@ typedef int yy_state_fast_t;
 
 #define YY_ASSERT(E) ((void) (0 && (E)))
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -691,8 +829,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -768,14 +905,16 @@ union yyalloc
 /* YYNSTATES -- Number of states.  */
 #define YYNSTATES  79
 
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   265
 
 
 /* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex, with out-of-bounds checking.  */
-#define YYTRANSLATE(YYX)                                                \
-  (0 <= (YYX) && (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
    as returned by yylex.  */
@@ -811,42 +950,43 @@ static const yytype_int8 yytranslate[] =
 };
 
 #if SBML_YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
 static const yytype_int16 yyrline[] =
 {
-       0,   384,   384,   385,   386,   387,   390,   391,   417,   418,
-     419,   430,   441,   442,   443,   453,   454,   487,   488,   489,
-     490,   491,   492,   493,   494,   495,   506,   517,   518,   530,
-     587,   600,   611,   622,   633,   643,   650,   657,   664,   671,
-     687,   688,   691,   692
+       0,   463,   463,   464,   465,   466,   469,   470,   491,   492,
+     493,   504,   515,   516,   517,   527,   528,   561,   562,   563,
+     564,   565,   566,   567,   568,   569,   580,   591,   592,   604,
+     661,   674,   685,   696,   707,   717,   724,   731,   738,   745,
+     761,   762,   765,   766
 };
 #endif
 
-#if SBML_YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of string\"", "error", "$undefined", "'&'", "'|'", "'<'", "'>'",
-  "'='", "'!'", "'-'", "'+'", "'*'", "'/'", "'%'", "NOT", "NEG", "UPLUS",
-  "'^'", "'['", "\"number\"", "\"integer\"",
+  "\"end of string\"", "error", "\"invalid token\"", "'&'", "'|'", "'<'",
+  "'>'", "'='", "'!'", "'-'", "'+'", "'*'", "'/'", "'%'", "NOT", "NEG",
+  "UPLUS", "'^'", "'['", "\"number\"", "\"integer\"",
   "\"number in e-notation form\"", "\"number in rational notation\"",
   "\"element name\"", "'('", "')'", "']'", "'{'", "'}'", "','", "';'",
   "$accept", "input", "node", "number", "nodelist", "nodesemicolonlist", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_int16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,    38,   124,    60,    62,    61,    33,    45,
-      43,    42,    47,    37,   258,   259,   260,    94,    91,   261,
-     262,   263,   264,   265,    40,    41,    93,   123,   125,    44,
-      59
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
 #define YYPACT_NINF (-24)
 
@@ -858,8 +998,8 @@ static const yytype_int16 yytoknum[] =
 #define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
       58,   -24,   178,   178,   178,   -24,   -24,   -24,   -24,   -23,
@@ -872,9 +1012,9 @@ static const yytype_int16 yypact[] =
      233,   233,    52,    52,    52,    52,    52,    52,   -24
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_int8 yydefact[] =
 {
        0,     4,     0,     0,     0,    35,    37,    36,    38,     7,
@@ -887,21 +1027,21 @@ static const yytype_int8 yydefact[] =
       25,    26,    23,    20,    24,    19,    21,    22,    30
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int8 yypgoto[] =
 {
      -24,   -24,     0,   -24,    -7,   -24
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
+/* YYDEFGOTO[NTERM-NUM].  */
 static const yytype_int8 yydefgoto[] =
 {
-      -1,    12,    21,    14,    22,    23
+       0,    12,    21,    14,    22,    23
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int8 yytable[] =
 {
       13,    18,    15,    16,    17,    50,    51,     2,     3,     4,
@@ -962,8 +1102,8 @@ static const yytype_int8 yycheck[] =
       17,    18,    -1,    17,    18
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
 static const yytype_int8 yystos[] =
 {
        0,     1,     8,     9,    10,    19,    20,    21,    22,    23,
@@ -976,7 +1116,7 @@ static const yytype_int8 yystos[] =
       33,    33,    33,    33,    33,    33,    33,    33,    26
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr1[] =
 {
        0,    31,    32,    32,    32,    32,    33,    33,    33,    33,
@@ -986,7 +1126,7 @@ static const yytype_int8 yyr1[] =
       35,    35,    36,    36
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
 static const yytype_int8 yyr2[] =
 {
        0,     2,     0,     1,     1,     2,     1,     1,     3,     3,
@@ -997,21 +1137,22 @@ static const yytype_int8 yyr2[] =
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
-#define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
+#define yyclearin       (yychar = SBML_YYEMPTY)
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
 #define YYBACKUP(Token, Value)                                    \
   do                                                              \
-    if (yychar == YYEMPTY)                                        \
+    if (yychar == SBML_YYEMPTY)                                        \
       {                                                           \
         yychar = (Token);                                         \
         yylval = (Value);                                         \
@@ -1021,15 +1162,14 @@ static const yytype_int8 yyr2[] =
       }                                                           \
     else                                                          \
       {                                                           \
-        yyerror (YY_("syntax error: cannot back up")); \
+        yyerror (l3p, YY_("syntax error: cannot back up")); \
         YYERROR;                                                  \
       }                                                           \
   while (0)
 
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+/* Backward compatibility with an undocumented macro.
+   Use SBML_YYerror or SBML_YYUNDEF. */
+#define YYERRCODE SBML_YYUNDEF
 
 
 /* Enable debugging if requested.  */
@@ -1046,19 +1186,16 @@ do {                                            \
     YYFPRINTF Args;                             \
 } while (0)
 
-/* This macro is provided for backward compatibility. */
-#ifndef YY_LOCATION_PRINT
-# define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-#endif
 
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value); \
+                  Kind, Value, l3p); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
@@ -1069,18 +1206,16 @@ do {                                                                      \
 `-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, L3Parser* l3p)
 {
   FILE *yyoutput = yyo;
-  YYUSE (yyoutput);
+  YY_USE (yyoutput);
+  YY_USE (l3p);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyo, yytoknum[yytype], *yyvaluep);
-# endif
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  YYUSE (yytype);
+  YY_USE (yykind);
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
@@ -1090,12 +1225,13 @@ yy_symbol_value_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
 `---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyo, int yytype, YYSTYPE const * const yyvaluep)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, L3Parser* l3p)
 {
   YYFPRINTF (yyo, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  yy_symbol_value_print (yyo, yytype, yyvaluep);
+  yy_symbol_value_print (yyo, yykind, yyvaluep, l3p);
   YYFPRINTF (yyo, ")");
 }
 
@@ -1128,7 +1264,8 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp,
+                 int yyrule, L3Parser* l3p)
 {
   int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
@@ -1140,9 +1277,8 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[+yyssp[yyi + 1 - yynrhs]],
-                       &yyvsp[(yyi + 1) - (yynrhs)]
-                                              );
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)], l3p);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1150,15 +1286,15 @@ yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, int yyrule)
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, Rule); \
+    yy_reduce_print (yyssp, yyvsp, Rule, l3p); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !SBML_YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !SBML_YYDEBUG */
@@ -1181,12 +1317,60 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
-#  else
+
+
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
 static YYPTRDIFF_T
 yystrlen (const char *yystr)
@@ -1196,13 +1380,13 @@ yystrlen (const char *yystr)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1216,10 +1400,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1234,7 +1418,6 @@ yytnamerr (char *yyres, const char *yystr)
     {
       YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1268,31 +1451,15 @@ yytnamerr (char *yyres, const char *yystr)
   else
     return yystrlen (yystr);
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
-                yy_state_t *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat: reported tokens (one for the "unexpected",
-     one per "expected"). */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
   /* Actual size of YYARG. */
   int yycount = 0;
-  /* Cumulated lengths of YYARG.  */
-  YYPTRDIFF_T yysize = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1316,52 +1483,54 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[+*yyssp];
-      YYPTRDIFF_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-      yysize = yysize0;
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYPTRDIFF_T yysize1
-                    = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-                    yysize = yysize1;
-                  else
-                    return 2;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
     default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
@@ -1369,17 +1538,23 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    /* Don't count the "%s"s in the final size, but reserve room for
-       the terminator.  */
-    YYPTRDIFF_T yysize1 = yysize + (yystrlen (yyformat) - 2 * yycount) + 1;
-    if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
-      yysize = yysize1;
-    else
-      return 2;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1388,7 +1563,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1400,7 +1575,7 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
@@ -1411,45 +1586,47 @@ yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, L3Parser* l3p)
 {
-  YYUSE (yyvaluep);
+  YY_USE (yyvaluep);
+  YY_USE (l3p);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  switch (yytype)
+  switch (yykind)
     {
-    case 33: /* node  */
-#line 359 "L3Parser.ypp"
+    case YYSYMBOL_node: /* node  */
+#line 431 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1435 "L3Parser.cpp"
+#line 1612 "L3Parser.cpp"
         break;
 
-    case 34: /* number  */
-#line 362 "L3Parser.ypp"
+    case YYSYMBOL_number: /* number  */
+#line 434 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1441 "L3Parser.cpp"
+#line 1618 "L3Parser.cpp"
         break;
 
-    case 35: /* nodelist  */
-#line 360 "L3Parser.ypp"
+    case YYSYMBOL_nodelist: /* nodelist  */
+#line 432 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1447 "L3Parser.cpp"
+#line 1624 "L3Parser.cpp"
         break;
 
-    case 36: /* nodesemicolonlist  */
-#line 361 "L3Parser.ypp"
+    case YYSYMBOL_nodesemicolonlist: /* nodesemicolonlist  */
+#line 433 "L3Parser.ypp"
             { delete(((*yyvaluep).astnode)); }
-#line 1453 "L3Parser.cpp"
+#line 1630 "L3Parser.cpp"
         break;
 
       default:
@@ -1461,13 +1638,6 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep)
 
 
 
-/* The lookahead symbol.  */
-int yychar;
-
-/* The semantic value of the lookahead symbol.  */
-YYSTYPE yylval;
-/* Number of syntax errors so far.  */
-int yynerrs;
 
 
 /*----------.
@@ -1475,45 +1645,54 @@ int yynerrs;
 `----------*/
 
 int
-yyparse (void)
+yyparse (L3Parser* l3p)
 {
-    yy_state_fast_t yystate;
-    /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
+/* Lookahead token kind.  */
+int yychar;
 
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+/* The semantic value of the lookahead symbol.  */
+/* Default value used for initialization, for pacifying older GCCs
+   or non-GCC compilers.  */
+YY_INITIAL_VALUE (static YYSTYPE yyval_default;)
+YYSTYPE yylval YY_INITIAL_VALUE (= yyval_default);
+
+    /* Number of syntax errors so far.  */
+    int yynerrs = 0;
+
+    yy_state_fast_t yystate = 0;
+    /* Number of tokens to shift before error messages enabled.  */
+    int yyerrstatus = 0;
+
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
+
+    /* The state stack: array, bottom, top.  */
     yy_state_t yyssa[YYINITDEPTH];
-    yy_state_t *yyss;
-    yy_state_t *yyssp;
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
 
-    /* The semantic value stack.  */
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
-
-    YYPTRDIFF_T yystacksize;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
 
-#if YYERROR_VERBOSE
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
   YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
-#endif
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N))
 
@@ -1521,16 +1700,10 @@ yyparse (void)
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
-  yychar = YYEMPTY; /* Cause a token to be read.  */
+  yychar = SBML_YYEMPTY; /* Cause a token to be read.  */
+
   goto yysetstate;
 
 
@@ -1552,10 +1725,11 @@ yysetstate:
   YY_IGNORE_USELESS_CAST_BEGIN
   *yyssp = YY_CAST (yy_state_t, yystate);
   YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
 #if !defined yyoverflow && !defined YYSTACK_RELOCATE
-    goto yyexhaustedlab;
+    YYNOMEM;
 #else
     {
       /* Get the current used size of the three stacks, in elements.  */
@@ -1583,7 +1757,7 @@ yysetstate:
 # else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
@@ -1594,10 +1768,10 @@ yysetstate:
           YY_CAST (union yyalloc *,
                    YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
-# undef YYSTACK_RELOCATE
+#  undef YYSTACK_RELOCATE
         if (yyss1 != yyssa)
           YYSTACK_FREE (yyss1);
       }
@@ -1616,6 +1790,7 @@ yysetstate:
     }
 #endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
+
   if (yystate == YYFINAL)
     YYACCEPT;
 
@@ -1636,18 +1811,29 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
-  if (yychar == YYEMPTY)
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
+  if (yychar == SBML_YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
-      yychar = yylex ();
+      YYDPRINTF ((stderr, "Reading a token\n"));
+      yychar = yylex (&yylval, l3p);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= SBML_YYEOF)
     {
-      yychar = yytoken = YYEOF;
+      yychar = SBML_YYEOF;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == SBML_YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = SBML_YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1681,7 +1867,7 @@ yybackup:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   /* Discard the shifted token.  */
-  yychar = YYEMPTY;
+  yychar = SBML_YYEMPTY;
   goto yynewstate;
 
 
@@ -1716,42 +1902,37 @@ yyreduce:
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-  case 3:
-#line 385 "L3Parser.ypp"
+  case 3: /* input: node  */
+#line 464 "L3Parser.ypp"
                      {l3p->outputNode = (yyvsp[0].astnode);}
-#line 1723 "L3Parser.cpp"
+#line 1909 "L3Parser.cpp"
     break;
 
-  case 4:
-#line 386 "L3Parser.ypp"
+  case 4: /* input: error  */
+#line 465 "L3Parser.ypp"
                       {}
-#line 1729 "L3Parser.cpp"
+#line 1915 "L3Parser.cpp"
     break;
 
-  case 5:
-#line 387 "L3Parser.ypp"
+  case 5: /* input: node error  */
+#line 466 "L3Parser.ypp"
                            {delete (yyvsp[-1].astnode);}
-#line 1735 "L3Parser.cpp"
+#line 1921 "L3Parser.cpp"
     break;
 
-  case 6:
-#line 390 "L3Parser.ypp"
+  case 6: /* node: number  */
+#line 469 "L3Parser.ypp"
                        {(yyval.astnode) = (yyvsp[0].astnode);}
-#line 1741 "L3Parser.cpp"
+#line 1927 "L3Parser.cpp"
     break;
 
-  case 7:
-#line 391 "L3Parser.ypp"
+  case 7: /* node: "element name"  */
+#line 470 "L3Parser.ypp"
                        {
                    (yyval.astnode) = new ASTNode();
                    string name(*(yyvsp[0].word));
                    (yyval.astnode)->setName(name.c_str());
-                   if (l3p->model == NULL ||
-                       (l3p->model->getSpecies(name) == NULL
-                        && l3p->model->getCompartment(name) == NULL
-                        && l3p->model->getReaction(name) == NULL
-                        && l3p->model->getParameter(name) == NULL
-                        && l3p->model->getSpeciesReference(name) == NULL)) {
+                   if (!l3p->isModelSymbol(name)) {
                      //The symbol is not used in any other mathematical context in the SBML model, so we can see if it matches a list of pre-defined names
                      ASTNodeType_t type = l3p->getSymbolFor(name);
                      if (type != AST_UNKNOWN) (yyval.astnode)->setType(type);
@@ -1768,23 +1949,23 @@ yyreduce:
                      }
                    }
         }
-#line 1772 "L3Parser.cpp"
+#line 1953 "L3Parser.cpp"
     break;
 
-  case 8:
-#line 417 "L3Parser.ypp"
+  case 8: /* node: '(' node ')'  */
+#line 491 "L3Parser.ypp"
                               {(yyval.astnode) = (yyvsp[-1].astnode);}
-#line 1778 "L3Parser.cpp"
+#line 1959 "L3Parser.cpp"
     break;
 
-  case 9:
-#line 418 "L3Parser.ypp"
+  case 9: /* node: node '^' node  */
+#line 492 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_POWER); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1784 "L3Parser.cpp"
+#line 1965 "L3Parser.cpp"
     break;
 
-  case 10:
-#line 419 "L3Parser.ypp"
+  case 10: /* node: node '*' node  */
+#line 493 "L3Parser.ypp"
                               {
                   if ((yyvsp[-2].astnode)->getType()==AST_TIMES) {
                     (yyval.astnode) = (yyvsp[-2].astnode);
@@ -1796,11 +1977,11 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1800 "L3Parser.cpp"
+#line 1981 "L3Parser.cpp"
     break;
 
-  case 11:
-#line 430 "L3Parser.ypp"
+  case 11: /* node: node '+' node  */
+#line 504 "L3Parser.ypp"
                               {
                   if ((yyvsp[-2].astnode)->getType()==AST_PLUS) {
                     (yyval.astnode) = (yyvsp[-2].astnode);
@@ -1812,23 +1993,23 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1816 "L3Parser.cpp"
+#line 1997 "L3Parser.cpp"
     break;
 
-  case 12:
-#line 441 "L3Parser.ypp"
+  case 12: /* node: node '/' node  */
+#line 515 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_DIVIDE); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1822 "L3Parser.cpp"
+#line 2003 "L3Parser.cpp"
     break;
 
-  case 13:
-#line 442 "L3Parser.ypp"
+  case 13: /* node: node '-' node  */
+#line 516 "L3Parser.ypp"
                               {(yyval.astnode) = new ASTNode(AST_MINUS); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1828 "L3Parser.cpp"
+#line 2009 "L3Parser.cpp"
     break;
 
-  case 14:
-#line 443 "L3Parser.ypp"
+  case 14: /* node: node '%' node  */
+#line 517 "L3Parser.ypp"
                               {
                   if (l3p->modulol3v2) {
                     (yyval.astnode) = new ASTNode(AST_FUNCTION_REM);
@@ -1839,17 +2020,17 @@ yyreduce:
                     (yyval.astnode) = l3p->createModuloTree((yyvsp[-2].astnode), (yyvsp[0].astnode));
                   }
                 }
-#line 1843 "L3Parser.cpp"
+#line 2024 "L3Parser.cpp"
     break;
 
-  case 15:
-#line 453 "L3Parser.ypp"
+  case 15: /* node: '+' node  */
+#line 527 "L3Parser.ypp"
                                      {(yyval.astnode) = (yyvsp[0].astnode);}
-#line 1849 "L3Parser.cpp"
+#line 2030 "L3Parser.cpp"
     break;
 
-  case 16:
-#line 454 "L3Parser.ypp"
+  case 16: /* node: '-' node  */
+#line 528 "L3Parser.ypp"
                                    {
                   if (l3p->collapseminus) {
                     if ((yyvsp[0].astnode)->getType()==AST_REAL) {
@@ -1883,59 +2064,59 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1887 "L3Parser.cpp"
+#line 2068 "L3Parser.cpp"
     break;
 
-  case 17:
-#line 487 "L3Parser.ypp"
+  case 17: /* node: node '>' node  */
+#line 561 "L3Parser.ypp"
                               {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-2].astnode), (yyvsp[0].astnode), AST_RELATIONAL_GT);}
-#line 1893 "L3Parser.cpp"
+#line 2074 "L3Parser.cpp"
     break;
 
-  case 18:
-#line 488 "L3Parser.ypp"
+  case 18: /* node: node '<' node  */
+#line 562 "L3Parser.ypp"
                               {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-2].astnode), (yyvsp[0].astnode), AST_RELATIONAL_LT);}
-#line 1899 "L3Parser.cpp"
+#line 2080 "L3Parser.cpp"
     break;
 
-  case 19:
-#line 489 "L3Parser.ypp"
+  case 19: /* node: node '>' '=' node  */
+#line 563 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_GEQ);}
-#line 1905 "L3Parser.cpp"
+#line 2086 "L3Parser.cpp"
     break;
 
-  case 20:
-#line 490 "L3Parser.ypp"
+  case 20: /* node: node '<' '=' node  */
+#line 564 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_LEQ);}
-#line 1911 "L3Parser.cpp"
+#line 2092 "L3Parser.cpp"
     break;
 
-  case 21:
-#line 491 "L3Parser.ypp"
+  case 21: /* node: node '=' '=' node  */
+#line 565 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_EQ);}
-#line 1917 "L3Parser.cpp"
+#line 2098 "L3Parser.cpp"
     break;
 
-  case 22:
-#line 492 "L3Parser.ypp"
+  case 22: /* node: node '!' '=' node  */
+#line 566 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1923 "L3Parser.cpp"
+#line 2104 "L3Parser.cpp"
     break;
 
-  case 23:
-#line 493 "L3Parser.ypp"
+  case 23: /* node: node '<' '>' node  */
+#line 567 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1929 "L3Parser.cpp"
+#line 2110 "L3Parser.cpp"
     break;
 
-  case 24:
-#line 494 "L3Parser.ypp"
+  case 24: /* node: node '>' '<' node  */
+#line 568 "L3Parser.ypp"
                                   {(yyval.astnode) = l3p->combineRelationalElements((yyvsp[-3].astnode), (yyvsp[0].astnode), AST_RELATIONAL_NEQ);}
-#line 1935 "L3Parser.cpp"
+#line 2116 "L3Parser.cpp"
     break;
 
-  case 25:
-#line 495 "L3Parser.ypp"
+  case 25: /* node: node '&' '&' node  */
+#line 569 "L3Parser.ypp"
                                   {
                   if ((yyvsp[-3].astnode)->getType()==AST_LOGICAL_AND) {
                     (yyval.astnode) = (yyvsp[-3].astnode);
@@ -1947,11 +2128,11 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1951 "L3Parser.cpp"
+#line 2132 "L3Parser.cpp"
     break;
 
-  case 26:
-#line 506 "L3Parser.ypp"
+  case 26: /* node: node '|' '|' node  */
+#line 580 "L3Parser.ypp"
                                   {
                   if ((yyvsp[-3].astnode)->getType()==AST_LOGICAL_OR) {
                     (yyval.astnode) = (yyvsp[-3].astnode);
@@ -1963,22 +2144,22 @@ yyreduce:
                     (yyval.astnode)->addChild((yyvsp[0].astnode));
                   }
                 }
-#line 1967 "L3Parser.cpp"
+#line 2148 "L3Parser.cpp"
     break;
 
-  case 27:
-#line 517 "L3Parser.ypp"
+  case 27: /* node: '!' node  */
+#line 591 "L3Parser.ypp"
                                    {(yyval.astnode) = new ASTNode(AST_LOGICAL_NOT); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 1973 "L3Parser.cpp"
+#line 2154 "L3Parser.cpp"
     break;
 
-  case 28:
-#line 518 "L3Parser.ypp"
+  case 28: /* node: "element name" '(' ')'  */
+#line 592 "L3Parser.ypp"
                                {
                    (yyval.astnode) = new ASTNode(AST_FUNCTION);
                    string name(*(yyvsp[-2].word));
                    (yyval.astnode)->setName((yyvsp[-2].word)->c_str());
-                   if (l3p->model == NULL || l3p->model->getFunctionDefinition(name) == NULL) {
+                   if (!l3p->isModelFunction(name)) {
                      //The symbol is not used in any other mathematical context in the SBML model, so we can see if it matches a list of pre-defined names
                      ASTNodeType_t type = l3p->getFunctionFor(name);
                      if (type != AST_UNKNOWN) (yyval.astnode)->setType(type);
@@ -1986,18 +2167,18 @@ yyreduce:
                      if (l3p->checkNumArguments((yyval.astnode))) YYABORT;
                    }
         }
-#line 1990 "L3Parser.cpp"
+#line 2171 "L3Parser.cpp"
     break;
 
-  case 29:
-#line 530 "L3Parser.ypp"
+  case 29: /* node: "element name" '(' nodelist ')'  */
+#line 604 "L3Parser.ypp"
                                         {
                    (yyval.astnode) = (yyvsp[-1].astnode);
                    string name(*(yyvsp[-3].word));
                    (yyval.astnode)->setName((yyvsp[-3].word)->c_str());
                    (yyval.astnode)->setType(AST_FUNCTION);
                    ASTNodeType_t type = l3p->getFunctionFor(name);
-                   if (l3p->model == NULL || l3p->model->getFunctionDefinition(name) == NULL) {
+                   if (!l3p->isModelFunction(name)) {
                      //The symbol is not used in any other mathematical context in the SBML model, so we can see if it matches a list of pre-defined names
                      if (type != AST_UNKNOWN) (yyval.astnode)->setType(type);
                      if (type==AST_FUNCTION_ROOT && l3p->l3StrCmp(name, "sqrt")) {
@@ -2048,11 +2229,11 @@ yyreduce:
                    if (type == AST_LAMBDA) l3p->fixLambdaArguments((yyval.astnode));
                    if (l3p->checkNumArguments((yyval.astnode))) YYABORT;
         }
-#line 2052 "L3Parser.cpp"
+#line 2233 "L3Parser.cpp"
     break;
 
-  case 30:
-#line 587 "L3Parser.ypp"
+  case 30: /* node: node '[' nodelist ']'  */
+#line 661 "L3Parser.ypp"
                                       {
                   vector<ASTNode*> allnodes;
                   allnodes.push_back((yyvsp[-3].astnode));
@@ -2066,11 +2247,11 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2070 "L3Parser.cpp"
+#line 2251 "L3Parser.cpp"
     break;
 
-  case 31:
-#line 600 "L3Parser.ypp"
+  case 31: /* node: node '[' ']'  */
+#line 674 "L3Parser.ypp"
                              {
                   vector<ASTNode*> allnodes;
                   allnodes.push_back((yyvsp[-2].astnode));
@@ -2082,11 +2263,11 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2086 "L3Parser.cpp"
+#line 2267 "L3Parser.cpp"
     break;
 
-  case 32:
-#line 611 "L3Parser.ypp"
+  case 32: /* node: '{' nodelist '}'  */
+#line 685 "L3Parser.ypp"
                                   {
                   vector<ASTNode*> allnodes;
                   allnodes.push_back((yyvsp[-1].astnode));
@@ -2098,11 +2279,11 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2102 "L3Parser.cpp"
+#line 2283 "L3Parser.cpp"
     break;
 
-  case 33:
-#line 622 "L3Parser.ypp"
+  case 33: /* node: '{' nodesemicolonlist '}'  */
+#line 696 "L3Parser.ypp"
                                            {
                   vector<ASTNode*> allnodes;
                   allnodes.push_back((yyvsp[-1].astnode));
@@ -2114,11 +2295,11 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2118 "L3Parser.cpp"
+#line 2299 "L3Parser.cpp"
     break;
 
-  case 34:
-#line 633 "L3Parser.ypp"
+  case 34: /* node: '{' '}'  */
+#line 707 "L3Parser.ypp"
                          {
                   (yyval.astnode) = l3p->parsePackageInfix(INFIX_SYNTAX_CURLY_BRACES);
                   if ((yyval.astnode) == NULL) {
@@ -2127,11 +2308,11 @@ yyreduce:
                   }
                   if (l3p->checkNumArgumentsForPackage((yyval.astnode))) YYABORT;
                 }
-#line 2131 "L3Parser.cpp"
+#line 2312 "L3Parser.cpp"
     break;
 
-  case 35:
-#line 643 "L3Parser.ypp"
+  case 35: /* number: "number"  */
+#line 717 "L3Parser.ypp"
                        {
                   (yyval.astnode) = new ASTNode(); 
                   (yyval.astnode)->setValue((yyvsp[0].numdouble)); 
@@ -2139,11 +2320,11 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2143 "L3Parser.cpp"
+#line 2324 "L3Parser.cpp"
     break;
 
-  case 36:
-#line 650 "L3Parser.ypp"
+  case 36: /* number: "number in e-notation form"  */
+#line 724 "L3Parser.ypp"
                            {
                   (yyval.astnode) = new ASTNode();
                   (yyval.astnode)->setValue((yyvsp[0].mantissa), l3p->exponent); 
@@ -2151,11 +2332,11 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2155 "L3Parser.cpp"
+#line 2336 "L3Parser.cpp"
     break;
 
-  case 37:
-#line 657 "L3Parser.ypp"
+  case 37: /* number: "integer"  */
+#line 731 "L3Parser.ypp"
                         {
                   (yyval.astnode) = new ASTNode(); 
                   (yyval.astnode)->setValue((yyvsp[0].numlong)); 
@@ -2163,11 +2344,11 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2167 "L3Parser.cpp"
+#line 2348 "L3Parser.cpp"
     break;
 
-  case 38:
-#line 664 "L3Parser.ypp"
+  case 38: /* number: "number in rational notation"  */
+#line 738 "L3Parser.ypp"
                          {
                   (yyval.astnode) = new ASTNode(); 
                   (yyval.astnode)->setValue((yyvsp[0].rational), l3p->denominator);
@@ -2175,11 +2356,11 @@ yyreduce:
 //                    $$->setUnits("dimensionless");
 //                  }
                 }
-#line 2179 "L3Parser.cpp"
+#line 2360 "L3Parser.cpp"
     break;
 
-  case 39:
-#line 671 "L3Parser.ypp"
+  case 39: /* number: number "element name"  */
+#line 745 "L3Parser.ypp"
                               {
                   (yyval.astnode) = (yyvsp[-1].astnode);
                   if ((yyval.astnode)->getUnits() != "") {
@@ -2194,35 +2375,35 @@ yyreduce:
                   }
                   (yyval.astnode)->setUnits(*(yyvsp[0].word));
                }
-#line 2198 "L3Parser.cpp"
+#line 2379 "L3Parser.cpp"
     break;
 
-  case 40:
-#line 687 "L3Parser.ypp"
+  case 40: /* nodelist: node  */
+#line 761 "L3Parser.ypp"
                      {(yyval.astnode) = new ASTNode(AST_FUNCTION); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2204 "L3Parser.cpp"
+#line 2385 "L3Parser.cpp"
     break;
 
-  case 41:
-#line 688 "L3Parser.ypp"
+  case 41: /* nodelist: nodelist ',' node  */
+#line 762 "L3Parser.ypp"
                                   {(yyval.astnode) = (yyvsp[-2].astnode);  (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2210 "L3Parser.cpp"
+#line 2391 "L3Parser.cpp"
     break;
 
-  case 42:
-#line 691 "L3Parser.ypp"
+  case 42: /* nodesemicolonlist: nodelist ';' nodelist  */
+#line 765 "L3Parser.ypp"
                                          {(yyval.astnode) = new ASTNode(AST_FUNCTION); (yyval.astnode)->addChild((yyvsp[-2].astnode)); (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2216 "L3Parser.cpp"
+#line 2397 "L3Parser.cpp"
     break;
 
-  case 43:
-#line 692 "L3Parser.ypp"
+  case 43: /* nodesemicolonlist: nodesemicolonlist ';' nodelist  */
+#line 766 "L3Parser.ypp"
                                                {(yyval.astnode) = (yyvsp[-2].astnode);  (yyval.astnode)->addChild((yyvsp[0].astnode));}
-#line 2222 "L3Parser.cpp"
+#line 2403 "L3Parser.cpp"
     break;
 
 
-#line 2226 "L3Parser.cpp"
+#line 2407 "L3Parser.cpp"
 
       default: break;
     }
@@ -2237,11 +2418,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
 
@@ -2265,66 +2445,60 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == SBML_YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = YY_CAST (char *, YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (l3p, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
-
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= SBML_YYEOF)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == SBML_YYEOF)
             YYABORT;
         }
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval);
-          yychar = YYEMPTY;
+                      yytoken, &yylval, l3p);
+          yychar = SBML_YYEMPTY;
         }
     }
 
@@ -2341,6 +2515,7 @@ yyerrorlab:
      label yyerrorlab therefore never appears in user code.  */
   if (0)
     YYERROR;
+  ++yynerrs;
 
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
@@ -2357,13 +2532,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2377,7 +2553,7 @@ yyerrlab1:
 
 
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, l3p);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2389,7 +2565,7 @@ yyerrlab1:
 
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2400,7 +2576,7 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
 /*-----------------------------------.
@@ -2408,31 +2584,29 @@ yyacceptlab:
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (YY_("memory exhausted"));
+  yyerror (l3p, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
 
-/*-----------------------------------------------------.
-| yyreturn -- parsing is finished, return the result.  |
-`-----------------------------------------------------*/
-yyreturn:
-  if (yychar != YYEMPTY)
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
+  if (yychar != SBML_YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval);
+                  yytoken, &yylval, l3p);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -2441,201 +2615,248 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[+*yyssp], yyvsp);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, l3p);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
-#line 695 "L3Parser.ypp"
 
+#line 769 "L3Parser.ypp"
 
 
-void sbml_yyerror(char const *s)
+
+void sbml_yyerror(L3Parser* l3p, char const *s)
 {
-  l3p->setError(s);
+  // Bison 3.6 renamed the token for unknown characters from '$undefined'
+  // to 'invalid token'; keep the message the parser has always given.
+  string message(s);
+  string::size_type undefined = message.find("invalid token");
+  if (undefined != string::npos) {
+    message.replace(undefined, 13, "$undefined");
+  }
+  l3p->setError(message);
 }
 
-int sbml_yylex(void)
+/*
+ * Converts the characters in [begin, end), which must form a decimal number,
+ * to a double, always using '.' as the decimal point.  Returns false if the
+ * number is too large to be represented.
+ */
+static bool l3ReadDouble(const char* begin, const char* end, double& value)
 {
-  char cc = 0;
-  l3p->input.get(cc);
-
-  //If we're done with the input:
-  if (l3p->input.eof()) {
-    return 0;
-  }
-  //If something else went wrong:
-  if (!l3p->input.good()) {
-    l3p->setError("The input is no longer good, for an unknown reason.");
-    return -1;
+  string number(begin, end);
+  const char* point = localeconv()->decimal_point;
+  if (point != NULL && point[0] != '.' && point[0] != '\0') {
+    string::size_type decimal = number.find('.');
+    if (decimal != string::npos) {
+      number[decimal] = point[0];
+    }
   }
+  errno = 0;
+  value = strtod(number.c_str(), NULL);
+  return !(errno == ERANGE && (value == HUGE_VAL || value == -HUGE_VAL));
+}
 
-  // Skip white space.
-  while ((cc == ' ' || cc == '\t' || cc == '\n' || cc == '\r')
-         && !l3p->input.eof()) {
-    l3p->input.get(cc);
+/*
+ * Reads an integer (optionally preceded by '-') starting at 'p', and moves
+ * 'p' past it.  Returns false if there is no integer at 'p', or if it does
+ * not fit in a long, in which case 'value' is set to LONG_MAX or LONG_MIN.
+ */
+static bool l3ReadLong(const char*& p, const char* end, long& value)
+{
+  bool negative = false;
+  if (p < end && *p == '-') {
+    negative = true;
+    ++p;
   }
-  if (l3p->input.eof()) return 0;
-
-  // Parse words
-  if (isalpha(cc) || cc == '_') {
-    string word;
-    while ((isalpha(cc) || isdigit(cc) || cc == '_') && !l3p->input.eof()) {
-      word += cc;
-      l3p->input.get(cc);
+  if (p == end || !isdigit(static_cast<unsigned char>(*p))) {
+    value = 0;
+    return false;
+  }
+  unsigned long limit = negative ? static_cast<unsigned long>(LONG_MAX) + 1 
+                                 : static_cast<unsigned long>(LONG_MAX);
+  unsigned long magnitude = 0;
+  bool overflow = false;
+  while (p < end && isdigit(static_cast<unsigned char>(*p))) {
+    unsigned long digit = static_cast<unsigned long>(*p - '0');
+    if (magnitude > (limit - digit) / 10) {
+      overflow = true;
     }
-    if (!l3p->input.eof()) {
-      l3p->input.unget();
+    else {
+      magnitude = magnitude * 10 + digit;
     }
-    sbml_yylval.word = l3p->addWord(word);
-    //cout << "\tRead word '" << word << "'." << endl;
-    return SYMBOL;
+    ++p;
+  }
+  if (overflow) {
+    value = negative ? LONG_MIN : LONG_MAX;
+    return false;
   }
+  value = negative ? -static_cast<long>(magnitude - 1) - 1 
+                   : static_cast<long>(magnitude);
+  return true;
+}
 
-  // Parse numbers
-  if (isdigit(cc) || (cc=='.' && isdigit(l3p->input.peek()))) {
-    double number;
-    long numlong;
-    l3p->input.unget();
-    streampos numbegin = l3p->input.tellg();
-    l3p->input >> numlong;
-    l3p->input.clear();
-    l3p->input.seekg(numbegin);
-    l3p->input >> number;
-    if (l3p->input.fail()) {
-      //The only reason I know of for this to happen is that there was a number followed by an 'e'.
-      l3p->input.clear(); //clear the error.
-      l3p->input.seekg(numbegin);
-      string failnum = "";
-      cc = l3p->input.get();
-      while (l3p->input.good() && (isdigit(cc) || cc=='.')) {
-        failnum += cc;
-        cc = l3p->input.get();
-      }
-      if (cc=='e' || cc=='E') {
-        l3p->input.unget();
-        //We're going to call yylex recursively here, so we need to swap out l3p->input
-        streampos numend = l3p->input.tellg();
-        string tempinput = l3p->input.str();
-        l3p->input.str(failnum);
-        int ret = sbml_yylex();
-        l3p->input.str(tempinput);
-        l3p->input.clear();
-        l3p->input.seekg(numend);
-        return ret;
-      }
-      //Something weird went wrong; give up.
-      return -1;
+/*
+ * Reads the number that starts at the current input position (with a digit,
+ * or a '.' followed by a digit), looking no further than 'end', and returns
+ * its token type.
+ */
+static int l3LexNumber(SBML_YYSTYPE* lval, L3Parser* l3p, const char* end)
+{
+  const char* numbegin = l3p->current;
+  const char* numend = numbegin;
+  bool decimal = false;
+  bool e = false;
+  bool good = true;
+
+  while (numend < end && isdigit(static_cast<unsigned char>(*numend))) {
+    ++numend;
+  }
+  if (numend < end && *numend == '.') {
+    decimal = true;
+    ++numend;
+    while (numend < end && isdigit(static_cast<unsigned char>(*numend))) {
+      ++numend;
     }
-    streampos numend = l3p->input.tellg();
-    l3p->input.clear();
-    l3p->input.seekg(numbegin);
-    bool decimal = false;
-    bool e = false;
-    bool last_e = false;
-    while (l3p->input.tellg() != numend) {
-      cc = l3p->input.get();
-      if (cc=='.') {
-        decimal = true;
-      }
-      if (cc=='e' || cc=='E') {
-        e = true;
-        last_e = true;
-      }
-      else {
-        last_e = false;
-      }
+  }
+  const char* mantissaend = numend;
+  if (numend < end && (*numend == 'e' || *numend == 'E')) {
+    const char* exponent = numend + 1;
+    if (exponent < end && (*exponent == '+' || *exponent == '-')) {
+      ++exponent;
     }
-    if (last_e) {
-       e = false;
-       l3p->input.unget();
+    if (exponent < end && isdigit(static_cast<unsigned char>(*exponent))) {
+      while (exponent < end && isdigit(static_cast<unsigned char>(*exponent))) {
+        ++exponent;
+      }
+      numend = exponent;
+      e = true;
     }
-    if (!decimal && !e && number == static_cast<double>(numlong) && numlong <= SBML_INT_MAX) {
-      sbml_yylval.numlong = numlong;
-      return INTEGER;
+    else {
+      //A number followed by an 'e' that does not start an exponent.
+      good = false;
     }
-    if (!e) {
-      sbml_yylval.numdouble = number;
-      return DOUBLE;
+  }
+
+  double number = 0;
+  if (good) {
+    good = l3ReadDouble(numbegin, numend, number);
+  }
+  if (!good) {
+    const char* failend = numbegin;
+    while (failend < end && (isdigit(static_cast<unsigned char>(*failend)) || *failend == '.')) {
+      ++failend;
     }
-    l3p->input.clear();
-    l3p->input.seekg(numbegin);
-    cc = l3p->input.get();
-    string mantissa = "";
-    while (l3p->input.tellg() != numend && (isdigit(cc) || cc=='.')) {
-      mantissa += cc;
-      cc = l3p->input.get();
+    if (failend < end && (*failend == 'e' || *failend == 'E')) {
+      //Read the part before the 'e' on its own, and leave the 'e' to be read next.
+      int ret = l3LexNumber(lval, l3p, failend);
+      l3p->current = failend;
+      return ret;
     }
-    if (cc=='e' || cc=='E') {
-      if (l3p->input.peek()=='+') {
-        cc = l3p->input.get();
-      }
-      bool isneg = false;
-      if (l3p->input.peek()=='-') {
-        cc = l3p->input.get();
-        isneg = true;
-      }
-      l3p->input >> numlong;
-      if (isneg) {
-        numlong = -numlong;
-      }
-      stringstream mantissastr;
-      mantissastr.str(mantissa);
-      mantissastr >> number;
-      l3p->exponent = numlong;
-      sbml_yylval.mantissa = number;
-      return E_NOTATION;
+    //Something weird went wrong; give up.
+    l3p->current = (failend < end) ? failend + 1 : failend;
+    return -1;
+  }
+
+  l3p->current = numend;
+  if (!decimal && !e) {
+    const char* digits = numbegin;
+    long numlong;
+    if (l3ReadLong(digits, numend, numlong) 
+      && number == static_cast<double>(numlong) && numlong <= SBML_INT_MAX) {
+      lval->numlong = numlong;
+      return INTEGER;
     }
-    else {
-      assert(false); //How did this happen?
-      //This is an error condition, but parsing the value as a double should be sufficient.
-      sbml_yylval.numdouble = number;
-      return DOUBLE;
+  }
+  if (!e) {
+    lval->numdouble = number;
+    return DOUBLE;
+  }
+
+  double mantissa = 0;
+  l3ReadDouble(numbegin, mantissaend, mantissa);
+  const char* exponent = mantissaend + 1;
+  bool isneg = false;
+  if (*exponent == '+') {
+    ++exponent;
+  }
+  else if (*exponent == '-') {
+    isneg = true;
+    ++exponent;
+  }
+  long numlong;
+  l3ReadLong(exponent, numend, numlong);
+  if (isneg) {
+    numlong = -numlong;
+  }
+  l3p->exponent = numlong;
+  lval->mantissa = mantissa;
+  return E_NOTATION;
+}
+
+int sbml_yylex(SBML_YYSTYPE* lval, L3Parser* l3p)
+{
+  int cc = l3p->get();
+
+  // Skip white space.
+  while (cc == ' ' || cc == '\t' || cc == '\n' || cc == '\r') {
+    cc = l3p->get();
+  }
+
+  //If we're done with the input:
+  if (cc == EOF) {
+    return 0;
+  }
+
+  // Parse words
+  if (isalpha(cc) || cc == '_') {
+    const char* word = l3p->current - 1;
+    while (isalnum(l3p->peek()) || l3p->peek() == '_') {
+      l3p->get();
     }
+    lval->word = l3p->addWord(string(word, l3p->current));
+    return SYMBOL;
+  }
+
+  // Parse numbers
+  if (isdigit(cc) || (cc=='.' && isdigit(l3p->peek()))) {
+    l3p->unget();
+    return l3LexNumber(lval, l3p, l3p->inputEnd);
   }
   else if (cc=='(') {
-    streampos rationalbegin = l3p->input.tellg();
-    cc = l3p->input.get();
-    if ((cc== '-' && isdigit(l3p->input.peek())) || isdigit(cc)) {
-      l3p->input.unget();
-      long numerator;
-      l3p->input >> numerator;
-      cc = l3p->input.get();
-      if (cc=='/') {
-        cc = l3p->input.get();
-        if ((cc== '-' && isdigit(l3p->input.peek())) || isdigit(cc)) {
-          l3p->input.unget();
-          long denominator;
-          l3p->input >> denominator; 
-          cc = l3p->input.get();
-          if (cc==')') {
-            //Actually a rational number!
-            sbml_yylval.rational = numerator;
-            l3p->denominator = denominator;
-            return RATIONAL;
-          }
-        }
+    const char* rational = l3p->current;
+    long numerator;
+    long denominator;
+    if (l3ReadLong(rational, l3p->inputEnd, numerator)
+      && rational < l3p->inputEnd && *rational == '/') {
+      ++rational;
+      if (l3ReadLong(rational, l3p->inputEnd, denominator)
+        && rational < l3p->inputEnd && *rational == ')') {
+        //Actually a rational number!
+        l3p->current = rational + 1;
+        lval->rational = numerator;
+        l3p->denominator = denominator;
+        return RATIONAL;
       }
     }
-    l3p->input.clear();
-    l3p->input.seekg(rationalbegin, ios::beg); // Not actually a rational number.
+    // Not actually a rational number.
     return '(';
   }
 
   //Otherwise, return the character we are looking at (like '*', '+', etc.
-  return cc;
+  return static_cast<char>(cc);
 }
 
 L3Parser::L3Parser()
-  : input()
+  : input(NULL)
+  , inputEnd(NULL)
+  , current(NULL)
   , outputNode(NULL)
   , error()
   , words()
@@ -2649,6 +2870,7 @@ L3Parser::L3Parser()
   , avocsymbol(L3P_AVOGADRO_IS_CSYMBOL)
   , strCmpIsCaseSensitive(L3P_COMPARE_BUILTINS_CASE_SENSITIVE)
   , modulol3v2(L3P_MODULO_IS_PIECEWISE)
+  , symbols(NULL)
 {
 }
 
@@ -2850,6 +3072,27 @@ void L3Parser::setModuloL3v2(bool ml3v2)
   modulol3v2 = ml3v2;
 }
 
+bool L3Parser::isModelSymbol(const string& name) const
+{
+  if (symbols != NULL) {
+    return symbols->variables.find(name) != symbols->variables.end();
+  }
+  return model != NULL &&
+         (model->getSpecies(name) != NULL
+          || model->getCompartment(name) != NULL
+          || model->getReaction(name) != NULL
+          || model->getParameter(name) != NULL
+          || model->getSpeciesReference(name) != NULL);
+}
+
+bool L3Parser::isModelFunction(const string& name) const
+{
+  if (symbols != NULL) {
+    return symbols->functions.find(name) != symbols->functions.end();
+  }
+  return model != NULL && model->getFunctionDefinition(name) != NULL;
+}
+
 bool L3Parser::l3StrCmp(const string& lhs, const string& rhs) const
 {
   if (strCmpIsCaseSensitive) {
@@ -2866,13 +3109,32 @@ bool L3Parser::l3StrCmp(const string& lhs, const string& rhs) const
 
 void L3Parser::setInput(const char* c)
 {
-  input.clear();
   if (c == NULL) 
   {
+    setInput(NULL, NULL);
     setError("NULL input.");
     return;
   }
-  input.str(c);
+  setInput(c, c + strlen(c));
+}
+
+void L3Parser::setInput(const char* begin, const char* end)
+{
+  input = begin;
+  inputEnd = end;
+  current = begin;
+}
+
+void L3Parser::setSettings(const L3ParserSettings* settings)
+{
+  model = settings->getModel();
+  parselog = settings->getParseLog();
+  collapseminus = settings->getParseCollapseMinus();
+  parseunits = settings->getParseUnits();
+  avocsymbol = settings->getParseAvogadroCsymbol();
+  currentSettings = settings;
+  strCmpIsCaseSensitive = settings->getComparisonCaseSensitivity();
+  modulol3v2 = settings->getParseModuloL3v2();
 }
 
 void L3Parser::setError(const char* c)
@@ -2885,18 +3147,17 @@ void L3Parser::setError(const char* c)
 void L3Parser::setError(const string& c)
 {
   stringstream err;
-  streampos position = input.tellg();
-  if (position== (streampos)-1) {
-    position = input.str().size();
+  err << "Error when parsing input '";
+  if (input != NULL) {
+    err.write(input, inputEnd - input);
   }
-  err << "Error when parsing input '" << input.str() << "' at position " << position << ":  " << c;
+  err << "' at position " << (current - input) << ":  " << c;
   error = err.str();
 }
 
 void L3Parser::clear()
 {
-  input.clear();
-  input.str("");
+  setInput(NULL, NULL);
   outputNode = NULL;
   error = "";
   model = defaultL3ParserSettings.getModel();
@@ -2977,7 +3238,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
 
     if (children != 1) {
       error << "exactly one argument, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -2991,7 +3252,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
 
     if (children != 2) {
       error << "exactly two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3004,7 +3265,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_RELATIONAL_LT:
     if (children <= 1) {
       error << "at least two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3014,7 +3275,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_LAMBDA:
     if (children == 0) {
       error << "at least one argument, but none were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3024,7 +3285,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
   case AST_MINUS:
     if (children < 1 || children > 2) {
       error << "exactly one or two arguments, but " << children << " were found.";
-      l3p->setError(error.str());
+      setError(error.str());
       delete function;
       return true;
     }
@@ -3042,7 +3303,7 @@ bool L3Parser::checkNumArguments(const ASTNode* function)
       bool ret = currentSettings->checkNumArgumentsForPackage(function, error);
       if (ret)
       {
-        l3p->setError(error.str());
+        setError(error.str());
         delete function;
       }
       return ret;
@@ -3133,7 +3394,7 @@ bool L3Parser::checkNumArgumentsForPackage(const ASTNode* function)
   stringstream error;
   bool ret = currentSettings->checkNumArgumentsForPackage(function, error);
   if (ret) {
-    l3p->setError(error.str());
+    setError(error.str());
     delete function;
   }
   return ret;
@@ -3211,6 +3472,109 @@ L3ParserSettings L3Parser::getDefaultL3ParserSettings()
   return defaultL3ParserSettings;
 }
 
+/*
+ * The error from the most recent parse.  Each thread has its own, so that
+ * 'SBML_getLastParseL3Error' reports the error of the string that the
+ * calling thread parsed.
+ */
+#ifdef LIBSBML_USE_THREADS
+static thread_local string lastParseL3Error;
+#else
+static string lastParseL3Error;
+#endif
+
+ASTNode* L3Parser::parse(const char* begin, const char* end,
+                         const L3ParserSettings* settings,
+                         const L3ParserSymbolTable* symbols)
+{
+  L3Parser parser;
+  parser.clear();
+  if (begin == NULL) {
+    parser.setInput(NULL);
+  }
+  else {
+    parser.setInput(begin, end);
+  }
+  parser.setSettings(settings);
+  parser.symbols = symbols;
+  sbml_yyparse(&parser);
+  lastParseL3Error = parser.getError();
+  return parser.outputNode;
+}
+
+L3ParserSymbolTable::L3ParserSymbolTable(const Model* model)
+  : variables()
+  , functions()
+{
+  if (model == NULL) return;
+
+  for (unsigned int n = 0; n < model->getNumSpecies(); n++) {
+    variables.insert(model->getSpecies(n)->getId());
+  }
+  for (unsigned int n = 0; n < model->getNumCompartments(); n++) {
+    variables.insert(model->getCompartment(n)->getId());
+  }
+  for (unsigned int n = 0; n < model->getNumParameters(); n++) {
+    variables.insert(model->getParameter(n)->getId());
+  }
+  for (unsigned int n = 0; n < model->getNumReactions(); n++) {
+    const Reaction* reaction = model->getReaction(n);
+    variables.insert(reaction->getId());
+    for (unsigned int sr = 0; sr < reaction->getNumReactants(); sr++) {
+      variables.insert(reaction->getReactant(sr)->getSpecies());
+      variables.insert(reaction->getReactant(sr)->getId());
+    }
+    for (unsigned int sr = 0; sr < reaction->getNumProducts(); sr++) {
+      variables.insert(reaction->getProduct(sr)->getSpecies());
+      variables.insert(reaction->getProduct(sr)->getId());
+    }
+  }
+  // Unset ids and species must not match anything.
+  variables.erase("");
+
+  for (unsigned int n = 0; n < model->getNumFunctionDefinitions(); n++) {
+    functions.insert(model->getFunctionDefinition(n)->getId());
+  }
+  functions.erase("");
+}
+
+/*
+ * Parses one formula of a batch per work item; all items share the same
+ * settings and symbol table, which are only read.
+ */
+class L3ParseBatchTask : public ParallelTask
+{
+public:
+  L3ParseBatchTask(const char** formulas, const L3ParserSettings* settings,
+                   const L3ParserSymbolTable* symbols, ASTNode** results,
+                   char** errors)
+    : mFormulas(formulas)
+    , mSettings(settings)
+    , mSymbols(symbols)
+    , mResults(results)
+    , mErrors(errors)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    const char* formula = mFormulas[index];
+    const char* end = (formula == NULL) ? NULL : formula + strlen(formula);
+    mResults[index] = L3Parser::parse(formula, end, mSettings, mSymbols);
+    if (mErrors != NULL) {
+      mErrors[index] = (mResults[index] == NULL) 
+                     ? safe_strdup(lastParseL3Error.c_str()) : NULL;
+    }
+  }
+
+private:
+  const char** mFormulas;
+  const L3ParserSettings* mSettings;
+  const L3ParserSymbolTable* mSymbols;
+  ASTNode** mResults;
+  char** mErrors;
+};
+
 /** Everything above this point is internal. */
 /** @endcond */
 
@@ -3229,7 +3593,7 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3Formula (const char *formula)
 {
-  L3ParserSettings l3ps = L3Parser_getInstance()->getDefaultL3ParserSettings();
+  L3ParserSettings l3ps;
   return SBML_parseL3FormulaWithSettings(formula, &l3ps);
 }
 
@@ -3243,7 +3607,7 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3FormulaWithModel (const char *formula, const Model_t * model)
 {
-  L3ParserSettings l3ps = L3Parser_getInstance()->getDefaultL3ParserSettings();
+  L3ParserSettings l3ps;
   l3ps.setModel(model);
   return SBML_parseL3FormulaWithSettings(formula, &l3ps);
 }
@@ -3258,23 +3622,49 @@ LIBSBML_EXTERN
 ASTNode_t *
 SBML_parseL3FormulaWithSettings (const char *formula, const L3ParserSettings_t * settings)
 {
-  l3p = L3Parser_getInstance();
   if (settings == NULL) {
-    L3ParserSettings l3ps = l3p->getDefaultL3ParserSettings();
+    L3ParserSettings l3ps;
     return SBML_parseL3FormulaWithSettings(formula, &l3ps);
   }
-  l3p->clear();
-  l3p->setInput(formula);
-  l3p->model = settings->getModel();
-  l3p->parselog = settings->getParseLog();
-  l3p->collapseminus = settings->getParseCollapseMinus();
-  l3p->parseunits = settings->getParseUnits();
-  l3p->avocsymbol = settings->getParseAvogadroCsymbol();
-  l3p->currentSettings = settings;
-  l3p->strCmpIsCaseSensitive = settings->getComparisonCaseSensitivity();
-  l3p->modulol3v2 = settings->getParseModuloL3v2();
-  sbml_yyparse();
-  return l3p->outputNode;
+  const char* end = (formula == NULL) ? NULL : formula + strlen(formula);
+  return L3Parser::parse(formula, end, settings);
+}
+
+
+/**
+ * @if conly
+ * @memberof ASTNode_t
+ * @endif
+ */
+LIBSBML_EXTERN
+unsigned int
+SBML_parseL3FormulasWithSettings (const char **formulas, 
+                                  unsigned int numFormulas,
+                                  const L3ParserSettings_t *settings,
+                                  ASTNode_t **results,
+                                  char **errors)
+{
+  if (formulas == NULL || results == NULL) return 0;
+
+  L3ParserSettings defaults;
+  if (settings == NULL) {
+    settings = &defaults;
+  }
+
+  // make sure the packages are registered before the threads start
+  SBMLExtensionRegistry::getInstance();
+
+  L3ParserSymbolTable symbols(settings->getModel());
+  L3ParseBatchTask task(formulas, settings, &symbols, results, errors);
+  ParallelTask::execute(task, numFormulas);
+
+  unsigned int numParsed = 0;
+  for (unsigned int n = 0; n < numFormulas; n++) {
+    if (results[n] != NULL) {
+      numParsed++;
+    }
+  }
+  return numParsed;
 }
 
 
@@ -3287,7 +3677,7 @@ LIBSBML_EXTERN
 L3ParserSettings_t* 
 SBML_getDefaultL3ParserSettings ()
 {
-  return new L3ParserSettings(L3Parser_getInstance()->getDefaultL3ParserSettings());
+  return new L3ParserSettings();
 }
 
 /**
@@ -3299,7 +3689,7 @@ LIBSBML_EXTERN
 char*
 SBML_getLastParseL3Error()
 {
-  return safe_strdup(L3Parser_getInstance()->getError().c_str());
+  return safe_strdup(lastParseL3Error.c_str());
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -3308,11 +3698,8 @@ LIBSBML_EXTERN
 void
 SBML_deleteL3Parser()
 {
-  if (l3p!=NULL) 
-  {
-    delete l3p;
-    l3p = NULL;
-  }
+  // Parser objects are now created for each call, so there is no longer
+  // anything to delete; this is kept for existing callers.
 }
 
 /** @endcond */
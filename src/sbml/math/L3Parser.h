@@ -158,6 +158,59 @@ ASTNode_t *
 SBML_parseL3FormulaWithSettings (const char *formula, const L3ParserSettings_t *settings);
 
 
+#ifndef SWIG
+
+/**
+ * Parses a number of text strings as mathematical formulas, all with the
+ * same parser settings, and stores an AST representation of each result.
+ *
+ * This gives the same results as calling
+ * @sbmlfunction{parseL3FormulaWithSettings, String\, L3ParserSettings}
+ * on each formula in turn, but is faster for large numbers of formulas.
+ * The settings are only examined once.  If they refer to a Model, the ids
+ * of the model elements are collected once into a table, so the model is
+ * not searched again for every name in every formula.  When libSBML is
+ * built with thread support, the formulas are parsed on several threads.
+ * The Model must therefore not be changed while this function runs.
+ *
+ * @param formulas an array of @p numFormulas mathematical formula
+ * expressions to be parsed.
+ *
+ * @param numFormulas the number of formulas.
+ *
+ * @param settings the settings to be used for all formulas, or @c NULL to
+ * use the default settings.
+ *
+ * @param results an array of @p numFormulas entries.  On return, the nth
+ * entry holds the root node of the AST for the nth formula, or @c NULL if an
+ * error occurred while parsing it.  The caller owns the returned trees.
+ *
+ * @param errors either @c NULL, or an array of @p numFormulas entries.  On
+ * return, the nth entry holds a description of the error that occurred
+ * while parsing the nth formula (in the form returned by
+ * @sbmlfunction{getLastParseL3Error,}), or @c NULL if it was parsed
+ * successfully.  The caller owns the returned strings.
+ *
+ * @return the number of formulas that were parsed successfully.
+ *
+ * @see @sbmlfunction{parseL3FormulaWithSettings, String\, L3ParserSettings}
+ * @see L3ParserSettings
+ *
+ * @if conly
+ * @memberof ASTNode_t
+ * @endif
+ */
+LIBSBML_EXTERN
+unsigned int
+SBML_parseL3FormulasWithSettings (const char **formulas, 
+                                  unsigned int numFormulas,
+                                  const L3ParserSettings_t *settings,
+                                  ASTNode_t **results,
+                                  char **errors);
+
+#endif  /* !SWIG */
+
+
 /**
  * Returns a copy of the default Level&nbsp;3 ("L3") formula parser settings.
  *
@@ -192,6 +245,11 @@ SBML_getDefaultL3ParserSettings ();
  * String\, Model} return @c NULL, an error is set internally.
  * This function allows callers to retrieve information about the error.
  *
+ * The parser functions may be called from several threads at once.  When
+ * libSBML is built with thread support, each thread has its own last
+ * error, so this function reports the error of the most recent formula
+ * parsed by the calling thread.
+ *
  * @return a string describing the error that occurred.  This will contain
  * the input string the parser was trying to parse, the character it had
  * parsed when it encountered the error, and a description of the error.
@@ -213,21 +213,17 @@ ASTNode* L3ParserSettings::parsePackageInfix(L3ParserGrammarLineType_t type,
     vector<ASTNode*> *nodeList, vector<std::string*> *stringList,
     vector<double> *doubleList) const
 {
-  ASTNode * temp = new ASTNode();
-  // note loading a plugin attaches it to the temp node
-  temp->loadASTPlugin(GRAMMAR_PACKAGE[type]);
-  const ASTBasePlugin * baseplugin = temp->getPlugin(0);
-  if (baseplugin != NULL)
+  // the registered plugin is stateless for parsing, so it is used directly
+  SBMLExtensionRegistry& registry = SBMLExtensionRegistry::getInstance();
+  for (unsigned int i = 0; i < registry.getNumASTPlugins(); i++)
   {
-    ASTNode* ret = baseplugin->parsePackageInfix(
-                        type, nodeList, stringList, doubleList);
-    if (ret != NULL)
+    const ASTBasePlugin * baseplugin = registry.getASTPlugin(i);
+    if (baseplugin->getPackageName() == GRAMMAR_PACKAGE[type])
     {
-      delete temp;
-      return ret;
+      return baseplugin->parsePackageInfix(
+                        type, nodeList, stringList, doubleList);
     }
   }
-  delete temp;
   return NULL;
 }
 /** @endcond */
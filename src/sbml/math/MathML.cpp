@@ -53,6 +53,7 @@
 #include <sbml/math/ASTNode.h>
 #include <sbml/math/MathML.h>
 #include <sbml/math/DefinitionURLRegistry.h>
+#include <sbml/extension/SBMLExtensionRegistry.h>
 
 #include <algorithm>
 
@@ -805,16 +806,12 @@ isMathMLNodeTag(const string& name)
   }
   else
   {
-    ASTNode astn;
-    //astn.loadASTPlugins(NULL);
-    //for (unsigned int p = 0; p < astn.getNumPlugins(); p++)
-    //{
-    //  const ASTBasePlugin* plugin = astn.getPlugin(p);
-      if (astn.getASTPlugin(name, false, true) != NULL && astn.getASTPlugin(name, false, true)->isMathMLNodeTag(name))
-      {
-        return true;
-      }
-    //}
+    const ASTBasePlugin* plugin = 
+      SBMLExtensionRegistry::getInstance().getASTPluginFor(name, false, true);
+    if (plugin != NULL && plugin->isMathMLNodeTag(name))
+    {
+      return true;
+    }
   }
 
   return false;
@@ -878,14 +875,16 @@ readMathML (ASTNode& node, XMLInputStream& stream, std::string reqd_prefix,
     // are we using L3 - so we might have an extension
     if (level > 2)
     {
-      thisPlugin = node.getASTPlugin(name, false, false);
-      if (thisPlugin != NULL)
+      // only the packages enabled on the document being read count; the
+      // element of a package that is not is still read as such, after
+      // the error below
+      SBMLExtensionRegistry& registry = SBMLExtensionRegistry::getInstance();
+      thisPlugin = registry.getASTPluginFor(name, false, false, 
+                                            stream.getSBMLNamespaces());
+      found = (thisPlugin != NULL);
+      if (!found)
       {
-        SBMLNamespaces* ns = stream.getSBMLNamespaces();
-        if (ns == NULL || thisPlugin->hasCorrectNamespace(ns))
-        {
-          found = true;
-        }
+        thisPlugin = registry.getASTPluginFor(name, false, false);
       }
     }
     //  if (node.getNumPlugins() == 0)
@@ -1313,6 +1312,7 @@ readMathML (ASTNode& node, XMLInputStream& stream, std::string reqd_prefix,
 /* ---------------------------------------------------------------------- */
 
 static void writeAttributes(const ASTNode&, XMLOutputStream&);
+static void writeDefinitionURL(const ASTNode&, XMLOutputStream&);
 static void writeNode      (const ASTNode&, XMLOutputStream&, SBMLNamespaces* sbmlns=NULL);
 static void writeCSymbol   (const ASTNode&, XMLOutputStream&, SBMLNamespaces *sbmlns=NULL);
 static void writeDouble    (const double& , XMLOutputStream&);
@@ -1347,6 +1347,23 @@ writeAttributes(const ASTNode& node, XMLOutputStream& stream)
 }
 /** @endcond */
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Writes the definitionURL attribute (the first stored attribute value,
+ * whatever name it was added under) if one is set.  The const accessor
+ * used here does not create attributes for nodes that have none.
+ */
+static void
+writeDefinitionURL(const ASTNode& node, XMLOutputStream& stream)
+{
+  const XMLAttributes* url = node.getDefinitionURL();
+  if (url != NULL && url->getLength() > 0)
+  {
+    stream.writeAttribute("definitionURL", url->getValue(0));
+  }
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Writes the given ASTNode as a <ci> or <csymbol> element as appropriate.
@@ -1376,11 +1393,7 @@ writeCI (const ASTNode& node, XMLOutputStream& stream, SBMLNamespaces *sbmlns)
     }
 
 #endif
-    if (node.getDefinitionURL() != NULL)
-    {
-      stream.writeAttribute("definitionURL", 
-                            node.getDefinitionURL()->getValue(0));
-    }
+    writeDefinitionURL(node, stream);
 
     if (node.getName() != NULL)
     {
@@ -1974,9 +1987,7 @@ writeSemantics(const ASTNode& node, XMLOutputStream& stream, bool &inSemantics,
   inSemantics = true;
   stream.startElement("semantics");
   writeAttributes(node, stream);
-  if (node.getDefinitionURL())
-    stream.writeAttribute("definitionURL", 
-                            node.getDefinitionURL()->getValue(0));
+  writeDefinitionURL(node, stream);
   writeNode(node, stream, sbmlns);
 
   for (unsigned int n = 0; n < node.getNumSemanticsAnnotations(); n++)
@@ -2061,13 +2072,20 @@ setSBMLDefinitionURLs(XMLInputStream& stream)
   {
     DefinitionURLRegistry::addSBMLDefinitions();
   }
-  ASTNode*      temp = new ASTNode;
-  temp->loadASTPlugins(stream.getSBMLNamespaces());
-  for (unsigned int n = 0; n < temp->getNumPlugins(); ++n)
+  const SBMLNamespaces* sbmlns = stream.getSBMLNamespaces();
+  const XMLNamespaces* xmlns = (sbmlns != NULL) ? sbmlns->getNamespaces() : NULL;
+  if (xmlns == NULL)
+  {
+    return;
+  }
+
+  // the registered plugins are used directly; nothing is stored in them
+  for (int n = 0; n < xmlns->getLength(); ++n)
   {
-    ASTBasePlugin * astPlug = temp->getPlugin(n);
+    const ASTBasePlugin * astPlug = 
+      SBMLExtensionRegistry::getInstance().getASTPluginForURI(xmlns->getURI(n));
     // already added as this can be a core package
-    if (astPlug->getPackageName() == "l3v2extendedmath")
+    if (astPlug == NULL || astPlug->getPackageName() == "l3v2extendedmath")
       continue;
 
     unsigned int i = 0;
@@ -2082,7 +2100,6 @@ setSBMLDefinitionURLs(XMLInputStream& stream)
       values = astPlug->getASTNodeValue(i);
     }
   }
-  delete temp;
 }
 
 
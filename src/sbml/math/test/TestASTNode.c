@@ -1112,6 +1112,85 @@ START_TEST (test_ASTNode_deepCopy_5)
 END_TEST
 
 
+START_TEST (test_ASTNode_deepCopy_6)
+{
+  ASTNode_t *node = ASTNode_createWithType(AST_REAL_E);
+  ASTNode_t *copy;
+  char *str;
+
+  ASTNode_setRealWithExponent(node, 2.5, 3);
+  ASTNode_setId(node, "i");
+  ASTNode_setClass(node, "c");
+  ASTNode_setUnits(node, "mole");
+
+  /** deepCopy() **/
+  copy = ASTNode_deepCopy(node);
+
+  fail_unless( ASTNode_getType(copy) == AST_REAL_E );
+  fail_unless( ASTNode_getMantissa(copy) == 2.5 );
+  fail_unless( ASTNode_getExponent(copy) == 3 );
+  fail_unless( ASTNode_getReal(copy) == 2500 );
+
+  str = ASTNode_getId(copy);
+  fail_unless( !strcmp(str, "i") );
+  safe_free(str);
+  str = ASTNode_getClass(copy);
+  fail_unless( !strcmp(str, "c") );
+  safe_free(str);
+  str = ASTNode_getUnits(copy);
+  fail_unless( !strcmp(str, "mole") );
+  safe_free(str);
+  fail_unless( ASTNode_isSetStyle(copy) == 0 );
+
+  ASTNode_free(node);
+
+  /** the copy does not share its attributes with the original **/
+  ASTNode_unsetId(copy);
+  fail_unless( ASTNode_isSetId(copy) == 0 );
+  fail_unless( ASTNode_isSetClass(copy) == 1 );
+
+  ASTNode_free(copy);
+}
+END_TEST
+
+
+START_TEST (test_ASTNode_valueDefaults)
+{
+  ASTNode_t *node = ASTNode_create();
+
+  fail_unless( ASTNode_getInteger    (node) == 0 );
+  fail_unless( ASTNode_getDenominator(node) == 1 );
+  fail_unless( ASTNode_getMantissa   (node) == 0 );
+  fail_unless( ASTNode_getExponent   (node) == 0 );
+  fail_unless( ASTNode_getDefinitionURL(node) != NULL );
+  fail_unless( ASTNode_getNumSemanticsAnnotations(node) == 0 );
+  fail_unless( ASTNode_getSemanticsAnnotation(node, 0) == NULL );
+
+  ASTNode_setRational(node, 3, 4);
+  fail_unless( ASTNode_getNumerator  (node) == 3 );
+  fail_unless( ASTNode_getDenominator(node) == 4 );
+  fail_unless( ASTNode_getMantissa   (node) == 0 );
+  fail_unless( ASTNode_getReal       (node) == 0.75 );
+
+  ASTNode_setReal(node, 1.5);
+  fail_unless( ASTNode_getInteger    (node) == 0 );
+  fail_unless( ASTNode_getDenominator(node) == 1 );
+  fail_unless( ASTNode_getMantissa   (node) == 1.5 );
+  fail_unless( ASTNode_getExponent   (node) == 0 );
+
+  ASTNode_setInteger(node, 7);
+  fail_unless( ASTNode_getInteger    (node) == 7 );
+  fail_unless( ASTNode_getDenominator(node) == 1 );
+  fail_unless( ASTNode_getMantissa   (node) == 0 );
+
+  ASTNode_setType(node, AST_PLUS);
+  fail_unless( ASTNode_getInteger    (node) == 0 );
+
+  ASTNode_free(node);
+}
+END_TEST
+
+
 START_TEST (test_ASTNode_getName)
 {
   ASTNode_t *n = ASTNode_create();
@@ -5317,6 +5396,85 @@ START_TEST (test_ASTNode_userData_1)
 END_TEST
 
 
+START_TEST (test_ASTNode_exactlyEqual)
+{
+  ASTNode_t *a = SBML_parseL3Formula("k * S1 / (Km + pow(S1, 2.5))");
+  ASTNode_t *b = SBML_parseL3Formula("k * S1 / (Km + pow(S1, 2.5))");
+  ASTNode_t *c = SBML_parseL3Formula("k * S1 / (Km + pow(S1, 2))");
+
+  fail_unless( ASTNode_exactlyEqual(a, a) == 1 );
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+  fail_unless( ASTNode_exactlyEqual(b, a) == 1 );
+  fail_unless( ASTNode_exactlyEqual(a, c) == 0 );
+  fail_unless( ASTNode_exactlyEqual(a, NULL) == 0 );
+  fail_unless( ASTNode_exactlyEqual(NULL, a) == 0 );
+
+  /* changing a grandchild must be noticed by the root */
+  ASTNode_t *S1 = ASTNode_getChild(ASTNode_getChild(b, 0), 1);
+  fail_unless( !strcmp(ASTNode_getName(S1), "S1") );
+  ASTNode_setName(S1, "S2");
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+  ASTNode_setName(S1, "S1");
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+
+  ASTNode_t *two = ASTNode_getChild(ASTNode_getChild(ASTNode_getChild(c, 1), 1), 1);
+  ASTNode_setReal(two, 2.5);
+  fail_unless( ASTNode_exactlyEqual(a, c) == 1 );
+
+  ASTNode_setUnits(two, "second");
+  fail_unless( ASTNode_exactlyEqual(a, c) == 0 );
+
+  ASTNode_free(a);
+  ASTNode_free(b);
+  ASTNode_free(c);
+}
+END_TEST
+
+
+START_TEST (test_ASTNode_exactlyEqual_values)
+{
+  ASTNode_t *a = ASTNode_create();
+  ASTNode_t *b = ASTNode_create();
+
+  ASTNode_setInteger(a, 2);
+  ASTNode_setReal(b, 2.0);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+
+  ASTNode_setInteger(b, 2);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+
+  ASTNode_setRational(a, 1, 2);
+  ASTNode_setRational(b, 1, 3);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+
+  ASTNode_setRational(b, 1, 2);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+
+  ASTNode_setRealWithExponent(a, 1.5, 3);
+  ASTNode_setRealWithExponent(b, 1.5, 2);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+
+  ASTNode_setRealWithExponent(b, 1.5, 3);
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+
+  ASTNode_setType(a, AST_NAME_TIME);
+  ASTNode_setType(b, AST_NAME_TIME);
+  ASTNode_setName(a, "t");
+  ASTNode_setName(b, "time");
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+
+  ASTNode_setName(b, "t");
+  fail_unless( ASTNode_exactlyEqual(a, b) == 1 );
+
+  ASTNode_setId(a, "time1");
+  fail_unless( ASTNode_exactlyEqual(a, b) == 0 );
+
+  ASTNode_free(a);
+  ASTNode_free(b);
+}
+END_TEST
+
+
 Suite *
 create_suite_ASTNode (void) 
 { 
@@ -5337,6 +5495,8 @@ create_suite_ASTNode (void)
   tcase_add_test( tcase, test_ASTNode_deepCopy_3              );
   tcase_add_test( tcase, test_ASTNode_deepCopy_4              );
   tcase_add_test( tcase, test_ASTNode_deepCopy_5              );
+  tcase_add_test( tcase, test_ASTNode_deepCopy_6              );
+  tcase_add_test( tcase, test_ASTNode_valueDefaults           );
   tcase_add_test( tcase, test_ASTNode_getName                 );
   tcase_add_test( tcase, test_ASTNode_getReal                 );
   tcase_add_test( tcase, test_ASTNode_getPrecedence           );
@@ -5421,6 +5581,8 @@ create_suite_ASTNode (void)
   tcase_add_test( tcase, test_ASTNode_hasUnits   );
   tcase_add_test( tcase, test_ASTNode_reduceToBinary   );
   tcase_add_test( tcase, test_ASTNode_userData_1   );
+  tcase_add_test( tcase, test_ASTNode_exactlyEqual   );
+  tcase_add_test( tcase, test_ASTNode_exactlyEqual_values   );
 
   suite_add_tcase(suite, tcase);
 
@@ -0,0 +1,249 @@
+/**
+ * \file    TestASTNodePool.cpp
+ * \brief   ASTNodePool unit tests
+ * \author  SBMLTeam
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+#include <vector>
+
+#include <sbml/common/common.h>
+#include <sbml/math/ASTNodePool.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/L3FormulaFormatter.h>
+#include <sbml/xml/XMLNode.h>
+
+#include <check.h>
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+CK_CPPSTART
+
+
+static string
+toString (const ASTNode* node)
+{
+  string formula;
+  SBML_appendFormulaToL3String(formula, node);
+  return formula;
+}
+
+
+START_TEST (test_ASTNodePool_share)
+{
+  ASTNodePool pool;
+  ASTNode *math = SBML_parseL3Formula("a * b + a * b");
+
+  const ASTNode *shared = pool.add(math);
+  fail_unless( shared != math );
+  fail_unless( toString(shared) == "a * b + a * b" );
+  fail_unless( shared->getChild(0) == shared->getChild(1) );
+  fail_unless( pool.getNumNodes() == 7 );
+  fail_unless( pool.getNumUniqueNodes() == 4 );
+
+  /* the tree that was added is left alone */
+  fail_unless( math->getChild(0) != math->getChild(1) );
+  fail_unless( toString(math) == "a * b + a * b" );
+
+  fail_unless( pool.add(math) == shared );
+  fail_unless( pool.getNumNodes() == 14 );
+  fail_unless( pool.getNumUniqueNodes() == 4 );
+  fail_unless( pool.getNumOccurrences(shared) == 2 );
+  fail_unless( pool.getNumOccurrences(shared->getChild(0)) == 4 );
+  fail_unless( pool.getNumOccurrences(math) == 0 );
+
+  fail_unless( pool.add(NULL) == NULL );
+
+  pool.clear();
+  fail_unless( pool.getNumNodes() == 0 );
+  fail_unless( pool.getNumUniqueNodes() == 0 );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_ASTNodePool_distinct)
+{
+  ASTNodePool pool;
+  const char* formulas[] = { "1", "1.0", "1 mole", "1 litre", "(1/2)", 
+                             "1e0", "a", "a(1)", "b", "0", "-0", 
+                             "a - 1", "1 - a", "ln(a)", "log10(a)", NULL };
+  vector<const ASTNode*> nodes;
+
+  for (unsigned int i = 0; formulas[i] != NULL; i++)
+  {
+    ASTNode *math = SBML_parseL3Formula(formulas[i]);
+    nodes.push_back(pool.add(math));
+    delete math;
+  }
+
+  for (size_t i = 0; i < nodes.size(); i++)
+  {
+    for (size_t j = i + 1; j < nodes.size(); j++)
+    {
+      fail_unless( nodes[i] != nodes[j] );
+    }
+  }
+}
+END_TEST
+
+
+START_TEST (test_ASTNodePool_commonSubexpressions)
+{
+  ASTNodePool pool;
+  ASTNode *math1 = SBML_parseL3Formula("c * k * S + 1");
+  ASTNode *math2 = SBML_parseL3Formula("2 * (c * k * S)");
+  ASTNode *math3 = SBML_parseL3Formula("sin(c * k * S) + 1");
+
+  pool.add(math1);
+  pool.add(math2);
+  pool.add(math3);
+
+  vector<const ASTNode*> common = pool.getCommonSubexpressions();
+  fail_unless( common.size() == 1 );
+  fail_unless( toString(common[0]) == "c * k * S" );
+  fail_unless( pool.getNumOccurrences(common[0]) == 3 );
+
+  /* the number 1 is used twice, but is not a subexpression */
+  fail_unless( pool.getCommonSubexpressions(1).size() == 5 );
+  fail_unless( pool.getCommonSubexpressions(4).empty() );
+
+  pool.add(math3);
+  common = pool.getCommonSubexpressions();
+  fail_unless( common.size() == 3 );
+  fail_unless( toString(common[0]) == "c * k * S" );
+  fail_unless( toString(common[1]) == "sin(c * k * S)" );
+  fail_unless( toString(common[2]) == "sin(c * k * S) + 1" );
+
+  delete math1;
+  delete math2;
+  delete math3;
+}
+END_TEST
+
+
+START_TEST (test_ASTNodePool_lambda)
+{
+  ASTNodePool pool;
+  ASTNode *math = SBML_parseL3Formula("lambda(x, y, x + y)");
+
+  const ASTNode *shared = pool.add(math);
+  fail_unless( pool.add(math) == shared );
+  fail_unless( shared->getChild(0)->isBvar() );
+  fail_unless( shared->getChild(1)->isBvar() );
+  fail_unless( !shared->getChild(2)->isBvar() );
+
+  /* the bvar x is not the same node as the x in the body */
+  fail_unless( shared->getChild(0) != shared->getChild(2)->getChild(0) );
+
+  ASTNode *copy = shared->deepCopy();
+  fail_unless( toString(copy) == "lambda(x, y, x + y)" );
+  delete copy;
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_ASTNodePool_semantics)
+{
+  ASTNodePool pool;
+  ASTNode *math = SBML_parseL3Formula("x * x");
+
+  math->getChild(0)->addSemanticsAnnotation(
+    XMLNode::convertStringToXMLNode("<annotation> a </annotation>"));
+
+  const ASTNode *shared = pool.add(math);
+  fail_unless( shared->getChild(0) != shared->getChild(1) );
+  fail_unless( shared->getChild(0)->getNumSemanticsAnnotations() == 1 );
+  fail_unless( pool.add(math) != shared );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_ASTNodePool_structuralHash)
+{
+  ASTNode *a = SBML_parseL3Formula("x + 1");
+  ASTNode *b = SBML_parseL3Formula("x + 1");
+
+  /* allocate empty optional attributes on b only */
+  b->getChild(0)->setStyle("");
+  b->getChild(0)->getDefinitionURL();
+  b->getChild(1)->setClass("");
+
+  fail_unless( a->exactlyEqual(*b) );
+  fail_unless( a->getStructuralHash() == b->getStructuralHash() );
+
+  b->getChild(1)->setUnits("mole");
+  fail_unless( !a->exactlyEqual(*b) );
+  fail_unless( a->getStructuralHash() != b->getStructuralHash() );
+
+  delete a;
+  delete b;
+}
+END_TEST
+
+
+Suite *
+create_suite_ASTNodePool ()
+{
+  Suite *suite = suite_create("ASTNodePool");
+  TCase *tcase = tcase_create("ASTNodePool");
+
+  tcase_add_test( tcase, test_ASTNodePool_share               );
+  tcase_add_test( tcase, test_ASTNodePool_distinct            );
+  tcase_add_test( tcase, test_ASTNodePool_commonSubexpressions );
+  tcase_add_test( tcase, test_ASTNodePool_lambda              );
+  tcase_add_test( tcase, test_ASTNodePool_semantics           );
+  tcase_add_test( tcase, test_ASTNodePool_structuralHash      );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+CK_CPPEND
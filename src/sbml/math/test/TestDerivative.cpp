@@ -0,0 +1,257 @@
+/**
+ * @file    TestDerivative.cpp
+ * @brief   Tests for ASTNode::derivative
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include <sbml/common/common.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/L3FormulaFormatter.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/SBMLTypes.h>
+
+#include <check.h>
+
+/** @cond doxygenIgnored */
+
+using namespace std;
+LIBSBML_CPP_NAMESPACE_USE
+
+/** @endcond */
+
+CK_CPPSTART
+
+
+static string
+derivativeOf (const char* formula, const char* variable, 
+              const Model* model = NULL)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  ASTNode* derivative = math->derivative(variable, model);
+  string result = (derivative == NULL) ? "NULL" : "";
+  SBML_appendFormulaToL3String(result, derivative);
+  delete math;
+  delete derivative;
+  return result;
+}
+
+
+/*
+ * Compares the symbolic derivative with respect to x with a central
+ * difference, at the given values of x and y.
+ */
+static bool
+matchesDifference (const char* formula, double x, double y)
+{
+  ASTNode* math = SBML_parseL3Formula(formula);
+  ASTNode* derivative = math->derivative("x");
+  if (derivative == NULL)
+  {
+    delete math;
+    return false;
+  }
+
+  map<string, double> values;
+  values["y"] = y;
+  double h = 1e-6 * (fabs(x) + 1);
+  values["x"] = x + h;
+  double above = SBMLTransforms::evaluateASTNode(math, values);
+  values["x"] = x - h;
+  double below = SBMLTransforms::evaluateASTNode(math, values);
+  values["x"] = x;
+  double exact = SBMLTransforms::evaluateASTNode(derivative, values);
+  double estimate = (above - below) / (2 * h);
+
+  delete math;
+  delete derivative;
+  return fabs(exact - estimate) <= 1e-5 * (fabs(estimate) + 1);
+}
+
+
+START_TEST (test_derivative_simplified)
+{
+  fail_unless( derivativeOf("x", "x") == "1" );
+  fail_unless( derivativeOf("y", "x") == "0" );
+  fail_unless( derivativeOf("3.5", "x") == "0" );
+  fail_unless( derivativeOf("2 * x + y", "x") == "2" );
+  fail_unless( derivativeOf("k * x * y", "x") == "k * y" );
+  fail_unless( derivativeOf("x - y", "y") == "-1" );
+  fail_unless( derivativeOf("x^3", "x") == "3 * x^2" );
+  fail_unless( derivativeOf("x^2", "x") == "2 * x" );
+  fail_unless( derivativeOf("x / y", "x") == "1 / y" );
+  fail_unless( derivativeOf("exp(k * x)", "x") == "exp(k * x) * k" );
+  fail_unless( derivativeOf("sin(x)", "x") == "cos(x)" );
+  fail_unless( derivativeOf("cos(x)", "x") == "-sin(x)" );
+  fail_unless( derivativeOf("ln(x)", "x") == "1 / x" );
+  fail_unless( derivativeOf("floor(x) + 1", "x") == "0" );
+}
+END_TEST
+
+
+/*
+ * The evaluator does not know these functions, or ignores the base of
+ * log, so they are checked by their form.
+ */
+START_TEST (test_derivative_noEvaluation)
+{
+  fail_unless( derivativeOf("log(y, x)", "x") == "1 / x / ln(y)" );
+  fail_unless( derivativeOf("log(x, 8)", "x") 
+               == "-(ln(8) * (1 / x)) / ln(x)^2" );
+  fail_unless( derivativeOf("min(x, y)", "x") == "piecewise(1, x <= y, 0)" );
+  fail_unless( derivativeOf("max(x, 2)", "x") == "piecewise(1, x >= 2, 0)" );
+  fail_unless( derivativeOf("max(x, y, 2 * x)", "x") 
+    == "piecewise(1, (x >= y) && (x >= (2 * x)), 0, "
+       "(y >= x) && (y >= (2 * x)), 2)" );
+  fail_unless( derivativeOf("rem(7 * x, y)", "x") == "7" );
+  fail_unless( derivativeOf("rem(x, y)", "y") == "-quotient(x, y)" );
+  fail_unless( derivativeOf("quotient(x, y) + x", "x") == "1" );
+}
+END_TEST
+
+
+START_TEST (test_derivative_numeric)
+{
+  const char* formulas[] = {
+    "x * y * x + 3 * x - y / x",
+    "(x + y) / (x * y)",
+    "x^y",
+    "y^x",
+    "x^x",
+    "pow(x, 2.5)",
+    "sqrt(x * y)",
+    "root(3, x)",
+    "root(x, y)",
+    "exp(-x) * y",
+    "ln(x^2)",
+    "log(x)",
+    "abs(x - 1)",
+    "sin(x)", "cos(x)", "tan(x)", "sec(x)", "csc(x)", "cot(x)",
+    "sinh(x)", "cosh(x)", "tanh(x)", "sech(x)", "csch(x)", "coth(x)",
+    "arcsin(x / 2)", "arccos(x / 2)", "arctan(x)", "arccot(x)",
+    "arcsec(x + 2)", "arccsc(x + 2)",
+    "arcsinh(x)", "arccosh(x + 2)", "arctanh(x / 2)", "arccoth(x + 2)",
+    "arcsech(x / 2)", "arccsch(x)",
+    "piecewise(x^2, x < 1, 3 * x)",
+    "-(x * y)",
+    "x * x * x * x",
+  };
+
+  for (size_t i = 0; i < sizeof(formulas) / sizeof(formulas[0]); ++i)
+  {
+    fail_unless( matchesDifference(formulas[i], 0.7, 1.9), formulas[i] );
+    fail_unless( matchesDifference(formulas[i], 0.4, 0.3), formulas[i] );
+  }
+}
+END_TEST
+
+
+START_TEST (test_derivative_unsupported)
+{
+  fail_unless( derivativeOf("delay(x, 1)", "x") == "NULL" );
+  fail_unless( derivativeOf("delay(y, 1) * x", "x") == "delay(y, 1)" );
+  fail_unless( derivativeOf("factorial(x)", "x") == "NULL" );
+  fail_unless( derivativeOf("factorial(y) * x", "x") == "factorial(y)" );
+  fail_unless( derivativeOf("f(x)", "x") == "NULL" );
+  fail_unless( derivativeOf("f(y)", "x") == "0" );
+  fail_unless( derivativeOf("rateOf(x)", "x") == "NULL" );
+  fail_unless( derivativeOf("x < 1", "x") == "NULL" );
+  fail_unless( derivativeOf("piecewise(1, x < 1, 2)", "x") == "0" );
+}
+END_TEST
+
+
+START_TEST (test_derivative_functionDefinition)
+{
+  SBMLDocument doc(3, 1);
+  Model* model = doc.createModel();
+  FunctionDefinition* fd = model->createFunctionDefinition();
+  fd->setId("mm");
+  ASTNode* lambda = SBML_parseL3Formula("lambda(s, vm, km, vm * s / (km + s))");
+  fd->setMath(lambda);
+  delete lambda;
+
+  fail_unless( derivativeOf("mm(x, V, K)", "x") == "NULL" );
+  fail_unless( derivativeOf("mm(x, V, K)", "x", model) 
+               == "(V * (K + x) - V * x) / (K + x)^2" );
+  fail_unless( derivativeOf("mm(x, V, K)", "V", model) == "x / (K + x)" );
+}
+END_TEST
+
+
+START_TEST (test_derivative_C)
+{
+  ASTNode_t* math = SBML_parseL3Formula("x * y");
+  ASTNode_t* derivative = ASTNode_derivative(math, "y", NULL);
+
+  fail_unless( derivative != NULL );
+  fail_unless( ASTNode_getType(derivative) == AST_NAME );
+  fail_unless( !strcmp(ASTNode_getName(derivative), "x") );
+  fail_unless( ASTNode_derivative(NULL, "y", NULL) == NULL );
+  fail_unless( ASTNode_derivative(math, NULL, NULL) == NULL );
+
+  ASTNode_free(math);
+  ASTNode_free(derivative);
+}
+END_TEST
+
+
+Suite *
+create_suite_Derivative ()
+{
+  Suite *suite = suite_create("Derivative");
+  TCase *tcase = tcase_create("Derivative");
+
+  tcase_add_test( tcase, test_derivative_simplified         );
+  tcase_add_test( tcase, test_derivative_noEvaluation       );
+  tcase_add_test( tcase, test_derivative_numeric            );
+  tcase_add_test( tcase, test_derivative_unsupported        );
+  tcase_add_test( tcase, test_derivative_functionDefinition );
+  tcase_add_test( tcase, test_derivative_C                  );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+CK_CPPEND
@@ -51,6 +51,7 @@
 //extern int getL3Precedence(const ASTNode_t* node);
 
 #include <check.h>
+#include <locale.h>
 
 #if defined(__cplusplus)
 LIBSBML_CPP_NAMESPACE_USE
@@ -1073,6 +1074,92 @@ START_TEST (test_L3FormulaFormatter_semantics)
 }
 END_TEST
 
+
+START_TEST (test_L3FormulaFormatter_numbers)
+{
+  char           *s;
+  ASTNode_t      *n  = ASTNode_create();
+  const double values[] = { 2, -7, 0.1, -0.25, 1.0/3, 1.5e-7, 
+                            123456789012345.0, 1e15, 6.02214179e23 };
+  const char *expected[] = { "2", "-7", "0.1", "-0.25", "0.333333333333333", 
+                             "1.5e-07", "123456789012345", "1e+15", 
+                             "6.02214179e+23" };
+  unsigned int i;
+
+  for (i = 0; i < 9; i++)
+  {
+    ASTNode_setReal(n, values[i]);
+    s = SBML_formulaToL3String(n);
+    fail_unless( !strcmp(s, expected[i]), NULL );
+    safe_free(s);
+  }
+
+  ASTNode_setInteger(n, -2147483647L - 1);
+  s = SBML_formulaToL3String(n);
+  fail_unless( !strcmp(s, "-2147483648"), NULL );
+  safe_free(s);
+
+  ASTNode_setRealWithExponent(n, 1.2, -8);
+  s = SBML_formulaToL3String(n);
+  fail_unless( !strcmp(s, "1.2e-8"), NULL );
+  safe_free(s);
+
+  ASTNode_setRational(n, -3, 4);
+  s = SBML_formulaToL3String(n);
+  fail_unless( !strcmp(s, "(-3/4)"), NULL );
+  safe_free(s);
+
+  /* numbers are always written with a '.', whatever the locale */
+  if (setlocale(LC_NUMERIC, "de_DE") != NULL)
+  {
+    ASTNode_setReal(n, 2.5);
+    s = SBML_formulaToL3String(n);
+    fail_unless( !strcmp(s, "2.5"), NULL );
+    safe_free(s);
+  }
+  setlocale(LC_NUMERIC, "C");
+
+  ASTNode_free(n);
+}
+END_TEST
+
+
+START_TEST (test_L3FormulaFormatter_appendToString)
+{
+  const char *formulas[] = { "x + y * 2", "sqrt(-a) % 1.5e3", "piecewise(1, b >= 3, 0)", 
+                             "log10(x)^-2", "avogadro * 0.5 mole" };
+  L3ParserSettings_t *settings = L3ParserSettings_create();
+  std::string formula;
+  unsigned int i;
+
+  L3ParserSettings_setParseCollapseMinus(settings, 1);
+
+  SBML_appendFormulaToL3String(formula, NULL);
+  fail_unless( formula.empty(), NULL );
+
+  for (i = 0; i < 5; i++)
+  {
+    ASTNode_t *n = SBML_parseL3Formula(formulas[i]);
+    char      *s = SBML_formulaToL3String(n);
+
+    formula = "f = ";
+    SBML_appendFormulaToL3String(formula, n);
+    fail_unless( formula == std::string("f = ") + s, NULL );
+    safe_free(s);
+
+    s = SBML_formulaToL3StringWithSettings(n, settings);
+    formula.clear();
+    SBML_appendFormulaToL3String(formula, n, settings);
+    fail_unless( formula == s, NULL );
+    safe_free(s);
+
+    ASTNode_free(n);
+  }
+
+  L3ParserSettings_free(settings);
+}
+END_TEST
+
 Suite *
 create_suite_L3FormulaFormatter (void) 
 { 
@@ -1098,6 +1185,8 @@ create_suite_L3FormulaFormatter (void)
   tcase_add_test( tcase, test_L3FormulaFormatter_multiAnd       );
   tcase_add_test( tcase, test_L3FormulaFormatter_multiOr        );
   tcase_add_test( tcase, test_L3FormulaFormatter_semantics      );
+  tcase_add_test( tcase, test_L3FormulaFormatter_numbers        );
+  tcase_add_test( tcase, test_L3FormulaFormatter_appendToString );
   // SBML_deleteL3Parser();
 
   suite_add_tcase(suite, tcase);
@@ -3758,6 +3758,75 @@ START_TEST(test_SBML_parseL3Formula_named_lambda_arguments7)
 END_TEST
 
 
+START_TEST(test_SBML_parseL3Formulas_batch)
+{
+  Model_t *model = Model_create(3,1);
+  Species_setId(Model_createSpecies(model), "pi");
+  Reaction_t *rxn = Model_createReaction(model);
+  Reaction_setId(rxn, "r");
+  SpeciesReference_t *sr = Reaction_createReactant(rxn);
+  SpeciesReference_setSpecies(sr, "s");
+  SpeciesReference_setId(sr, "true");
+  FunctionDefinition_setId(Model_createFunctionDefinition(model), "sin");
+
+  L3ParserSettings_t *settings = L3ParserSettings_create();
+  L3ParserSettings_setModel(settings, model);
+
+  const char *formulas[] = { "pi + exponentiale", "true", "sin(x, y)", 
+                             "1 +", NULL };
+  ASTNode_t *results[5];
+  char *errors[5];
+
+  unsigned int numParsed = SBML_parseL3FormulasWithSettings(formulas, 5, 
+                                                 settings, results, errors);
+  fail_unless( numParsed == 3 );
+
+  fail_unless( ASTNode_getType(results[0]) == AST_PLUS );
+  fail_unless( ASTNode_getType(ASTNode_getChild(results[0], 0)) == AST_NAME );
+  fail_unless( ASTNode_getType(ASTNode_getChild(results[0], 1)) == AST_CONSTANT_E );
+  fail_unless( errors[0] == NULL );
+
+  fail_unless( ASTNode_getType(results[1]) == AST_NAME );
+  fail_unless( !strcmp(ASTNode_getName(results[1]), "true") );
+
+  fail_unless( ASTNode_getType(results[2]) == AST_FUNCTION );
+  fail_unless( ASTNode_getNumChildren(results[2]) == 2 );
+
+  fail_unless( results[3] == NULL );
+  fail_unless( !strcmp(errors[3], "Error when parsing input '1 +' at position 3:  syntax error, unexpected end of string") );
+
+  fail_unless( results[4] == NULL );
+  fail_unless( !strcmp(errors[4], "Error when parsing input '' at position 0:  NULL input.") );
+
+  /* the same formulas parsed one at a time */
+  for (unsigned int n = 0; n < 5; n++)
+  {
+    ASTNode_t *single = SBML_parseL3FormulaWithSettings(formulas[n], settings);
+    if (single == NULL)
+    {
+      char *error = SBML_getLastParseL3Error();
+      fail_unless( !strcmp(error, errors[n]) );
+      safe_free(error);
+    }
+    else
+    {
+      char *batch = SBML_formulaToL3String(results[n]);
+      char *one = SBML_formulaToL3String(single);
+      fail_unless( !strcmp(batch, one) );
+      safe_free(batch);
+      safe_free(one);
+    }
+    ASTNode_free(single);
+    ASTNode_free(results[n]);
+    safe_free(errors[n]);
+  }
+
+  L3ParserSettings_free(settings);
+  Model_free(model);
+}
+END_TEST
+
+
 Suite *
 create_suite_L3FormulaParser (void) 
 { 
@@ -3888,6 +3957,7 @@ create_suite_L3FormulaParser (void)
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments5);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments6);
   tcase_add_test(tcase, test_SBML_parseL3Formula_named_lambda_arguments7);
+  tcase_add_test(tcase, test_SBML_parseL3Formulas_batch);
 
 
   suite_add_tcase(suite, tcase);
@@ -63,6 +63,8 @@ CK_CPPSTART
 #endif
 
 Suite *create_suite_ASTNode          (void);
+Suite *create_suite_ASTNodePool      (void);
+Suite *create_suite_Derivative       (void);
 Suite *create_suite_FormulaFormatter (void);
 Suite *create_suite_FormulaParser    (void);
 Suite *create_suite_L3FormulaFormatter(void);
@@ -129,6 +131,8 @@ main (void)
 
   SRunner *runner = srunner_create( create_suite_ASTNode() );
 
+  srunner_add_suite( runner, create_suite_ASTNodePool         () );
+  srunner_add_suite( runner, create_suite_Derivative          () );
   srunner_add_suite( runner, create_suite_FormulaFormatter     () );
   srunner_add_suite( runner, create_suite_FormulaParser        () );
   srunner_add_suite( runner, create_suite_L3FormulaFormatter   () );
@@ -312,6 +312,31 @@ START_TEST (test_MathMLFormatter_ci)
 END_TEST
 
 
+START_TEST (test_MathMLFormatter_ci_noDefinitionURL)
+{
+  N = SBML_parseFormula("foo");
+  S = writeMathMLToString(N);
+
+  const ASTNode* node = N;
+  const XMLAttributes* shared = node->getDefinitionURL();
+  fail_unless( shared != NULL );
+  fail_unless( shared->getLength() == 0 );
+
+  ASTNode* other = SBML_parseFormula("bar");
+  fail_unless( static_cast<const ASTNode*>(other)->getDefinitionURL()
+               == shared );
+
+  fail_unless( N->getDefinitionURL() != NULL );
+  fail_unless( N->getDefinitionURL() != shared );
+  fail_unless( node->getDefinitionURL() == N->getDefinitionURL() );
+  fail_unless( other->getDefinitionURL() != shared );
+  fail_unless( shared->getLength() == 0 );
+
+  delete other;
+}
+END_TEST
+
+
 START_TEST (test_MathMLFormatter_csymbol_delay)
 {
   const char* expected = wrapMathML
@@ -1187,6 +1212,7 @@ create_suite_WriteMathML ()
 
   tcase_add_test( tcase, test_MathMLFormatter_csymbol_avogadro         );
   tcase_add_test( tcase, test_MathMLFormatter_ci_definitionURL         );
+  tcase_add_test( tcase, test_MathMLFormatter_ci_noDefinitionURL       );
   tcase_add_test( tcase, test_MathMLFormatter_ci_id                    );
   tcase_add_test( tcase, test_MathMLFormatter_ci_class                 );
   tcase_add_test( tcase, test_MathMLFormatter_ci_style                 );
@@ -48,6 +48,7 @@
 #include <sbml/packages/arrays/extension/ArraysASTPlugin.h>
 #include <sbml/packages/arrays/extension/ArraysSBMLDocumentPlugin.h>
 #include <sbml/packages/arrays/validator/ArraysSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/arrays/extension/ArraysSBasePlugin.h>
 
 #include <sbml/packages/arrays/util/ArraysFlatteningConverter.h>
@@ -334,20 +335,8 @@ ArraysExtension::getErrorTable(unsigned int index) const
 unsigned int
 ArraysExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(arraysErrorTable)/sizeof(arraysErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == arraysErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(arraysErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
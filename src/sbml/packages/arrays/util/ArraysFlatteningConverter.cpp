@@ -200,6 +200,21 @@ ArraysFlatteningConverter::convert()
 
 }
 
+
+void
+ArraysFlatteningConverter::reset()
+{
+  mArraySize.clear();
+  mArrayEntry.clear();
+  mDimensionIndex.clear();
+  mNoDimensions = 0;
+  mCurrentDimension = 0;
+  clearValueMap();
+  mValuesSize = 0;
+
+  SBMLConverter::reset();
+}
+
 /** @cond doxygenLibsbmlInternal */
 int 
 ArraysFlatteningConverter::performConversion()
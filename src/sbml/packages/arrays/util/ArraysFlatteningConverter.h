@@ -199,6 +199,12 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and the array dimensions and values taken from it.
+   */
+  virtual void reset();
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Performs the conversion.
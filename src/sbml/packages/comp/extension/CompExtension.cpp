@@ -44,6 +44,7 @@
 #include <sbml/packages/comp/extension/CompModelPlugin.h>
 #include <sbml/packages/comp/extension/CompSBMLDocumentPlugin.h>
 #include <sbml/packages/comp/validator/CompSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 
 #include <sbml/packages/comp/util//CompFlatteningConverter.h>
@@ -452,19 +453,8 @@ CompExtension::getErrorTable(unsigned int index) const
 unsigned int 
 CompExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(compErrorTable)/sizeof(compErrorTable[0]);
-  unsigned int index = 0;
-
-  for ( unsigned int i = 0; i < tableSize; i++ )
-  {
-    if ( errorId == compErrorTable[i].code )
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(compErrorTable);
+  return index.find(errorId);
 }
 /** @endcond */
 
@@ -730,9 +730,18 @@ CompModelPlugin::instantiateSubmodels()
 
   // First we instantiate all the submodels.  
   // This acts recursively downward through the stack.
+  // The copies of the referenced models are independent of each
+  // other, so they are made up front (in parallel if possible).
+  vector<Submodel*> submodels;
   for (unsigned int sub=0; sub<mListOfSubmodels.size(); sub++) 
   {
-    Submodel* submodel = mListOfSubmodels.get(sub);
+    submodels.push_back(mListOfSubmodels.get(sub));
+  }
+  Submodel::prepareInstantiations(submodels, true);
+
+  for (unsigned int sub=0; sub<submodels.size(); sub++) 
+  {
+    Submodel* submodel = submodels[sub];
     // Instead of 'instantiate', since we might have already 
     // been instantiated ourselves from above.
     Model* submodinst = submodel->getInstantiation(); 
@@ -69,6 +69,8 @@ CompSBMLDocumentPlugin::CompSBMLDocumentPlugin (const string &uri, const string
   , mCheckingDummyDoc (false)
   , mFlattenAndCheck (true)
   , mOverrideCompFlattening (false)
+  , mStoredURIDocumentHits (0)
+  , mStoredURIDocumentMisses (0)
 {
   connectToChild();
 }
@@ -82,6 +84,8 @@ CompSBMLDocumentPlugin::CompSBMLDocumentPlugin(const CompSBMLDocumentPlugin& ori
   , mCheckingDummyDoc (orig.mCheckingDummyDoc)
   , mFlattenAndCheck (orig.mFlattenAndCheck)
   , mOverrideCompFlattening (orig.mOverrideCompFlattening)
+  , mStoredURIDocumentHits (0)
+  , mStoredURIDocumentMisses (0)
 {
   connectToChild();
 }
@@ -96,6 +100,8 @@ CompSBMLDocumentPlugin::operator=(const CompSBMLDocumentPlugin& orig)
     mListOfModelDefinitions = orig.mListOfModelDefinitions;
     mListOfExternalModelDefinitions = orig.mListOfExternalModelDefinitions;
     mURIToDocumentMap.clear(); //Don't copy the pointers to this object, as they are owning pointers
+    mStoredURIDocumentHits = 0;
+    mStoredURIDocumentMisses = 0;
 
     mCheckingDummyDoc = orig.mCheckingDummyDoc;
     mFlattenAndCheck = orig.mFlattenAndCheck;
@@ -694,9 +700,11 @@ CompSBMLDocumentPlugin::getSBMLDocumentFromURI(const std::string& uri)
 
     mURIToDocumentMap.insert(make_pair(resolvedURI, doc));
     doc->setLocationURI(resolvedURI);
+    mStoredURIDocumentMisses++;
 
     return doc;
   }
+  mStoredURIDocumentHits++;
   return stored->second;
 }
 /** @endcond */
@@ -723,6 +731,8 @@ CompSBMLDocumentPlugin::clearStoredURIDocuments()
     delete mi->second;
   }
   mURIToDocumentMap.clear();
+  mStoredURIDocumentHits = 0;
+  mStoredURIDocumentMisses = 0;
 }
 
 /** @cond doxygenLibsbmlInternal */
@@ -1084,6 +1094,20 @@ CompSBMLDocumentPlugin::accept(SBMLVisitor& v) const
 /** @endcond */
 
 
+unsigned int
+CompSBMLDocumentPlugin::getNumStoredURIDocumentHits() const
+{
+  return mStoredURIDocumentHits;
+}
+
+
+unsigned int
+CompSBMLDocumentPlugin::getNumStoredURIDocumentMisses() const
+{
+  return mStoredURIDocumentMisses;
+}
+
+
 /** @cond doxygenLibsbmlInternal */
 bool
 CompSBMLDocumentPlugin::getOverrideCompFlattening() const
@@ -576,6 +576,34 @@ public:
   ExternalModelDefinition* removeExternalModelDefinition(std::string id);
 
 
+  /**
+   * Returns the number of times an external SBML document was requested
+   * (for example, to instantiate a Submodel whose model is defined by an
+   * ExternalModelDefinition) and was found among the documents already
+   * resolved and stored by this plugin, since those were last cleared.
+   *
+   * Every Submodel still receives its own copy of the referenced model,
+   * but only the first request for a given URI reads the document.
+   *
+   * @return the number of requests served by a stored document.
+   *
+   * @see getNumStoredURIDocumentMisses()
+   */
+  unsigned int getNumStoredURIDocumentHits() const;
+
+
+  /**
+   * Returns the number of times an external SBML document was requested
+   * and had to be resolved and read, since the stored documents were last
+   * cleared.
+   *
+   * @return the number of requests that read a new document.
+   *
+   * @see getNumStoredURIDocumentHits()
+   */
+  unsigned int getNumStoredURIDocumentMisses() const;
+
+
   // ---------------------------------------------------------
   //
   // virtual functions (internal implementation) which should
@@ -704,6 +732,9 @@ private:
   bool mFlattenAndCheck;
   bool mOverrideCompFlattening;
 
+  unsigned int mStoredURIDocumentHits;
+  unsigned int mStoredURIDocumentMisses;
+
   /** @endcond */
 };
 
@@ -52,6 +52,7 @@
 #include <sbml/packages/comp/validator/CompSBMLError.h>
 
 #include <sbml/util/ElementFilter.h>
+#include <sbml/util/ParallelTask.h>
 
 using namespace std;
 
@@ -73,6 +74,8 @@ Submodel::Submodel (unsigned int level, unsigned int version, unsigned int pkgVe
   , mListOfDeletions()
   , mInstantiatedModel(NULL)
   , mInstantiationOriginalURI("")
+  , mPreparedModel(NULL)
+  , mPreparedModelSource(NULL)
 {
   mListOfDeletions.connectToParent(this);
 }
@@ -88,6 +91,8 @@ Submodel::Submodel(CompPkgNamespaces* compns)
   , mListOfDeletions()
   , mInstantiatedModel(NULL)
   , mInstantiationOriginalURI("")
+  , mPreparedModel(NULL)
+  , mPreparedModelSource(NULL)
 {
   loadPlugins(compns);
   mListOfDeletions.connectToParent(this);
@@ -104,6 +109,8 @@ Submodel::Submodel(const Submodel& source)
   , mListOfDeletions(source.mListOfDeletions)
   , mInstantiatedModel(NULL) //Must call 'instantiate()' again if you want a copy.
   , mInstantiationOriginalURI("")
+  , mPreparedModel(NULL)
+  , mPreparedModelSource(NULL)
 {
   mListOfDeletions.connectToParent(this);
 }
@@ -121,6 +128,7 @@ Submodel& Submodel::operator=(const Submodel& source)
     mListOfDeletions = source.mListOfDeletions;
     mInstantiatedModel = NULL; //Must call 'instantiate()' again if you want a copy.
     mInstantiationOriginalURI = "";
+    clearPreparedModel();
   }
 
   return *this;
@@ -135,6 +143,7 @@ Submodel::clone() const
 Submodel::~Submodel ()
 {
   if (mInstantiatedModel != NULL) delete mInstantiatedModel;
+  clearPreparedModel();
 }
 
 
@@ -854,7 +863,17 @@ Submodel::instantiate()
   case SBML_MODEL:
   case SBML_COMP_MODELDEFINITION:
     origdoc = origmodel->getSBMLDocument();
-    mInstantiatedModel = static_cast<Model*>(origmodel)->clone();
+    if (mPreparedModel != NULL && mPreparedModelSource == origmodel)
+    {
+      // prepareInstantiations() already made the copy for us.
+      mInstantiatedModel = mPreparedModel;
+      mPreparedModel = NULL;
+      mPreparedModelSource = NULL;
+    }
+    else
+    {
+      mInstantiatedModel = static_cast<Model*>(origmodel)->clone();
+    }
     if (uniqueModels.insert(newmodel).second == false) {
       //Can't instantiate this model, because we are already a child of it.
       string error = "Error in Submodel::instantiate:  cannot instantiate submodel '" + getId() + "' in model '" + parentmodelname + "' because it references the model '" + getModelRef() + "', which is already an ancestor of the submodel.";
@@ -902,6 +921,7 @@ Submodel::instantiate()
     mInstantiationOriginalURI = "";
     return LIBSBML_OPERATION_FAILED;
   }
+  clearPreparedModel();
   
   if (mInstantiatedModel==NULL) 
   {
@@ -951,9 +971,16 @@ Submodel::instantiate()
   }
 
   
+  vector<Submodel*> instsubs;
   for (unsigned int sub=0; sub<instmodplug->getNumSubmodels(); sub++) 
   {
-    Submodel* instsub = instmodplug->getSubmodel(sub);
+    instsubs.push_back(instmodplug->getSubmodel(sub));
+  }
+  prepareInstantiations(instsubs, false);
+
+  for (unsigned int sub=0; sub<instsubs.size(); sub++) 
+  {
+    Submodel* instsub = instsubs[sub];
     int ret = instsub->instantiate();
     if (ret != LIBSBML_OPERATION_SUCCESS) {
       //'instantiate' already sets its own error messages.
@@ -967,6 +994,109 @@ Submodel::instantiate()
   return LIBSBML_OPERATION_SUCCESS;
 }
 
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Copies the models referenced by a set of sibling Submodel objects.  Each
+ * index only reads its own source model and writes its own slot, so the
+ * copies can safely be made concurrently.
+ */
+class CloneReferencedModels : public ParallelTask
+{
+public:
+  CloneReferencedModels(const vector<const Model*>& sources)
+    : mSources(sources)
+    , mClones(sources.size(), (Model*)NULL)
+  {
+  }
+
+  virtual void run(unsigned int index)
+  {
+    mClones[index] = mSources[index]->clone();
+  }
+
+  vector<const Model*> mSources;
+  vector<Model*> mClones;
+};
+/** @endcond */
+
+
+void
+Submodel::prepareInstantiations(const vector<Submodel*>& submodels, 
+                                bool onlyIfNeeded)
+{
+  // Models from external documents are left to 'instantiate', since
+  // resolving them reads files and updates the document's cache.
+  vector<Submodel*> toPrepare;
+  vector<const Model*> sources;
+  for (size_t sub = 0; sub < submodels.size(); ++sub)
+  {
+    Submodel* submodel = submodels[sub];
+    if (submodel == NULL || (onlyIfNeeded && submodel->mInstantiatedModel != NULL))
+    {
+      continue;
+    }
+    submodel->clearPreparedModel();
+    SBase* origmodel = submodel->getReferencedModelDefinition();
+    if (origmodel != NULL && (origmodel->getTypeCode() == SBML_MODEL ||
+      origmodel->getTypeCode() == SBML_COMP_MODELDEFINITION))
+    {
+      toPrepare.push_back(submodel);
+      sources.push_back(static_cast<const Model*>(origmodel));
+    }
+  }
+
+  // with a single copy to make there is nothing to be gained
+  if (toPrepare.size() < 2 || ParallelTask::getMaxThreads() < 2)
+  {
+    return;
+  }
+
+  CloneReferencedModels task(sources);
+  ParallelTask::execute(task, (unsigned int)sources.size());
+  for (size_t sub = 0; sub < toPrepare.size(); ++sub)
+  {
+    toPrepare[sub]->mPreparedModel = task.mClones[sub];
+    toPrepare[sub]->mPreparedModelSource = sources[sub];
+  }
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+SBase*
+Submodel::getReferencedModelDefinition()
+{
+  SBMLDocument* doc = getSBMLDocument();
+  if (doc == NULL)
+  {
+    return NULL;
+  }
+
+  CompSBMLDocumentPlugin* docplugin = 
+    static_cast<CompSBMLDocumentPlugin*>(doc->getPlugin(getPrefix()));
+  if (docplugin == NULL)
+  {
+    return NULL;
+  }
+
+  return docplugin->getModel(getModelRef());
+}
+/** @endcond */
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+Submodel::clearPreparedModel()
+{
+  if (mPreparedModel != NULL)
+  {
+    delete mPreparedModel;
+  }
+  mPreparedModel = NULL;
+  mPreparedModelSource = NULL;
+}
+/** @endcond */
+
 int Submodel::performDeletions()
 {
   if (mInstantiatedModel == NULL) return LIBSBML_INVALID_OBJECT;
@@ -1040,6 +1170,7 @@ Submodel::clearInstantiation()
     delete mInstantiatedModel;
   }
   mInstantiatedModel = NULL;
+  clearPreparedModel();
 }
   
 List* 
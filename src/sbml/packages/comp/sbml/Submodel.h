@@ -165,6 +165,8 @@ protected:
   ListOfDeletions  mListOfDeletions;
   Model*        mInstantiatedModel;
   std::string   mInstantiationOriginalURI;
+  Model*        mPreparedModel;
+  const SBase*  mPreparedModelSource;
 
   /** @endcond */
 
@@ -738,6 +740,25 @@ public:
   virtual int instantiate();
 
 
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Makes the copies of the Model or ModelDefinition objects that the given
+   * sibling Submodel objects reference from their own document, concurrently
+   * where possible (see ParallelTask).  A subsequent call to instantiate() on
+   * each Submodel uses the prepared copy instead of cloning the model itself;
+   * everything else about instantiation, including the resolution of
+   * external models and all error reporting, still happens in instantiate(),
+   * so the result is the same either way.
+   *
+   * @param submodels the Submodel objects about to be instantiated.
+   * @param onlyIfNeeded if @c true, Submodel objects that already have an
+   * instantiated Model are skipped, as getInstantiation() would.
+   */
+  static void prepareInstantiations(const std::vector<Submodel*>& submodels,
+                                    bool onlyIfNeeded);
+  /** @endcond */
+
+
   /**
    * Delete elements in the instantiated submodel, based on any Deletions
    * from this Submodel's listOfDeletions.
@@ -892,6 +913,18 @@ protected:
   /** @endcond */
 
 private:
+  /**
+   * Internal function that returns the Model, ModelDefinition or
+   * ExternalModelDefinition this Submodel refers to, or NULL.
+   */
+  SBase* getReferencedModelDefinition();
+
+  /**
+   * Internal function to discard a copy made by prepareInstantiations()
+   * that was not used by instantiate().
+   */
+  void clearPreparedModel();
+
   /**
    * Internal function to convert time and extent with the given ASTNodes.
    */
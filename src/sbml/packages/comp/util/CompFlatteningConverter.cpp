@@ -35,6 +35,7 @@
 
 
 
+#include <sbml/common/libsbml-config.h>
 #include <sbml/packages/comp/util/CompFlatteningConverter.h>
 #include <sbml/packages/comp/util/SBMLFileResolver.h>
 #include <sbml/packages/comp/util/SBMLResolverRegistry.h>
@@ -56,9 +57,44 @@
 #include <algorithm>
 #include <string>
 
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+/** @cond doxygenLibsbmlInternal */
+#ifdef LIBSBML_USE_THREADS
+static std::recursive_mutex sFlatteningMutex;
+#endif
+
+/*
+ * Holds the flattening lock for the lifetime of the object.  Flattening
+ * adds and removes entries of the process-wide lists of submodel
+ * processing callbacks and resolvers, so only one document is flattened
+ * at a time.  The lock is recursive since validating a document during
+ * flattening flattens a copy of it again.
+ */
+class FlatteningLock
+{
+public:
+  FlatteningLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sFlatteningMutex.lock();
+#endif
+  }
+
+  ~FlatteningLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sFlatteningMutex.unlock();
+#endif
+  }
+};
+/** @endcond */
+
 
 /** @cond doxygenLibsbmlInternal */
 /*
@@ -86,8 +122,12 @@ CompFlatteningConverter::CompFlatteningConverter
                          (const CompFlatteningConverter& orig) :
 SBMLConverter(orig)
   , mDisabledPackages(orig.mDisabledPackages)
-  , mPkgsToStrip (orig.mPkgsToStrip)
+  , mPkgsToStrip (NULL)
 {
+  if (orig.mPkgsToStrip != NULL)
+  {
+    mPkgsToStrip = new IdList(*orig.mPkgsToStrip);
+  }
 }
 
 CompFlatteningConverter* 
@@ -148,6 +188,8 @@ CompFlatteningConverter::matchesProperties
 int 
 CompFlatteningConverter::convert()
 {  
+  FlatteningLock lock;
+
    // need to keep track so we can delete it later;
   int basePathResolverIndex = -1;
 
@@ -197,6 +239,30 @@ CompFlatteningConverter::convert()
 
 }
 
+
+bool
+CompFlatteningConverter::isThreadSafe() const
+{
+  return false;
+}
+
+
+void
+CompFlatteningConverter::reset()
+{
+  mDisabledPackages.clear();
+  mPackageValues.clear();
+
+  if (mPkgsToStrip != NULL)
+  {
+    mPkgsToStrip->clear();
+    delete mPkgsToStrip;
+    mPkgsToStrip = NULL;
+  }
+
+  SBMLConverter::reset();
+}
+
 struct disable_info {
   SBMLDocument * doc;
   IdList strippedPkgs;
@@ -576,6 +576,20 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and the packages disabled in it.
+   */
+  virtual void reset();
+
+
+  /**
+   * Returns @c false: flattening changes the lists of submodel processing
+   * callbacks and resolvers shared by the whole process, so documents are
+   * flattened one at a time.
+   */
+  virtual bool isThreadSafe() const;
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Performs the conversion.
@@ -40,16 +40,79 @@
 #include <string>
 #include <sstream>
 #include <cstdlib>
+#include <sys/stat.h>
+#include <sys/types.h>
 
+#include <sbml/common/libsbml-config.h>
 #include <sbml/SBMLDocument.h>
 #include <sbml/packages/comp/util/SBMLResolverRegistry.h>
 #include <sbml/packages/comp/util/SBMLResolver.h>
 #include <sbml/packages/comp/util/SBMLFileResolver.h>
+#include <sbml/packages/comp/util/SBMLUri.h>
 #include <sbml/util/util.h>
 
+#ifdef LIBSBML_USE_THREADS
+#include <mutex>
+#endif
+
+#ifdef _MSC_VER
+#  define stat _stat
+#endif
+
 using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+/** @cond doxygenLibsbmlInternal */
+#ifdef LIBSBML_USE_THREADS
+static std::mutex sDocumentCacheMutex;
+#endif
+
+/*
+ * Holds the document cache lock for the lifetime of the object.
+ */
+class DocumentCacheLock
+{
+public:
+  DocumentCacheLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sDocumentCacheMutex.lock();
+#endif
+  }
+
+  ~DocumentCacheLock()
+  {
+#ifdef LIBSBML_USE_THREADS
+    sDocumentCacheMutex.unlock();
+#endif
+  }
+};
+
+
+/*
+ * Sets @p path to the absolute path of the given existing file, with
+ * symbolic links and '.' and '..' components resolved where the platform
+ * allows it.
+ */
+static bool
+getAbsolutePath(const string& fileName, string& path)
+{
+#ifdef _WIN32
+  char buffer[_MAX_PATH];
+  if (_fullpath(buffer, fileName.c_str(), _MAX_PATH) == NULL)
+    return false;
+  path = buffer;
+#else
+  char* resolved = realpath(fileName.c_str(), NULL);
+  if (resolved == NULL)
+    return false;
+  path = resolved;
+  free(resolved);
+#endif
+  return true;
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /** @cond doxygenLibsbmlInternal */
 SBMLResolverRegistry* SBMLResolverRegistry::mInstance = NULL;
@@ -80,6 +143,9 @@ SBMLResolverRegistry::addResolver (const SBMLResolver* resolver)
 
   mResolvers.push_back(resolver->clone());
 
+  // documents may now resolve differently
+  clearDocumentCache();
+
   return LIBSBML_OPERATION_SUCCESS;
 }
 
@@ -104,6 +170,9 @@ SBMLResolverRegistry::removeResolver(int index)
     delete current;
   
   mResolvers.erase(mResolvers.begin() + index);
+
+  // documents may now resolve differently
+  clearDocumentCache();
   
   return LIBSBML_OPERATION_SUCCESS;
 }
@@ -126,6 +195,7 @@ SBMLResolverRegistry::getResolverByIndex(int index) const
 
 /** @cond doxygenLibsbmlInternal */
 SBMLResolverRegistry::SBMLResolverRegistry()
+  : mMaxCachedDocuments(0)
 {
   // for now ensure that we always have a file resolver in there
   // 
@@ -149,6 +219,8 @@ SBMLResolverRegistry::~SBMLResolverRegistry()
   }
   mResolvers.clear();
 
+  clearDocumentCache();
+
   while(mOwnedDocuments.size())
   {
     const SBMLDocument* doc = *(mOwnedDocuments.begin());
@@ -159,6 +231,66 @@ SBMLResolverRegistry::~SBMLResolverRegistry()
 
 SBMLDocument*
 SBMLResolverRegistry::resolve(const std::string &uri, const std::string baseUri/*=""*/) const
+{
+  if (getMaxCachedDocuments() == 0)
+    return resolveWithResolvers(uri, baseUri);
+
+  string key;
+  time_t modified;
+  if (!getCacheKey(uri, baseUri, key, modified))
+    return resolveWithResolvers(uri, baseUri);
+
+  {
+    DocumentCacheLock lock;
+    std::map<std::string, CachedDocument>::iterator it = mDocumentCache.find(key);
+    if (it != mDocumentCache.end())
+    {
+      if (it->second.modified == modified)
+      {
+        mDocumentCacheOrder.splice(mDocumentCacheOrder.begin(), 
+                                   mDocumentCacheOrder, it->second.position);
+        return it->second.document->clone();
+      }
+
+      // the file changed since it was read
+      delete it->second.document;
+      mDocumentCacheOrder.erase(it->second.position);
+      mDocumentCache.erase(it);
+    }
+  }
+
+  // read outside the lock, so that other documents can be resolved
+  // meanwhile; if two threads read the same file, the second one to
+  // finish replaces the entry of the first
+  SBMLDocument* result = resolveWithResolvers(uri, baseUri);
+  if (result == NULL)
+    return NULL;
+
+  DocumentCacheLock lock;
+  if (mMaxCachedDocuments == 0)
+    return result;
+
+  std::map<std::string, CachedDocument>::iterator it = mDocumentCache.find(key);
+  if (it != mDocumentCache.end())
+  {
+    delete it->second.document;
+    mDocumentCacheOrder.erase(it->second.position);
+    mDocumentCache.erase(it);
+  }
+
+  mDocumentCacheOrder.push_front(key);
+  CachedDocument& entry = mDocumentCache[key];
+  entry.document = result->clone();
+  entry.modified = modified;
+  entry.position = mDocumentCacheOrder.begin();
+
+  trimDocumentCache(mMaxCachedDocuments);
+
+  return result;
+}
+
+SBMLDocument*
+SBMLResolverRegistry::resolveWithResolvers(const std::string &uri, const std::string& baseUri) const
 {
   SBMLDocument* result = NULL;
   std::vector<const SBMLResolver*>::const_iterator it = mResolvers.begin();
@@ -172,6 +304,46 @@ SBMLResolverRegistry::resolve(const std::string &uri, const std::string baseUri/
   return result;
 }
 
+bool
+SBMLResolverRegistry::getCacheKey(const std::string &uri, const std::string& baseUri,
+                                  std::string& key, time_t& modified) const
+{
+  SBMLUri* resolved = resolveUri(uri, baseUri);
+  if (resolved == NULL)
+    return false;
+
+  const string fileName = resolved->getPath();
+  delete resolved;
+
+  struct stat buf;
+  if (fileName.empty() || stat(fileName.c_str(), &buf) != 0)
+    return false;
+
+  // key the cache by the absolute path of the file, so that relative
+  // and absolute references to the same file share one entry
+  if (!getAbsolutePath(fileName, key))
+    return false;
+
+  modified = buf.st_mtime;
+  return true;
+}
+
+void
+SBMLResolverRegistry::trimDocumentCache(unsigned int maxDocuments) const
+{
+  while (mDocumentCacheOrder.size() > maxDocuments)
+  {
+    std::map<std::string, CachedDocument>::iterator it = 
+      mDocumentCache.find(mDocumentCacheOrder.back());
+    if (it != mDocumentCache.end())
+    {
+      delete it->second.document;
+      mDocumentCache.erase(it);
+    }
+    mDocumentCacheOrder.pop_back();
+  }
+}
+
 SBMLUri* 
 SBMLResolverRegistry::resolveUri(const std::string &uri, const std::string baseUri/*=""*/) const
 {
@@ -189,6 +361,59 @@ SBMLResolverRegistry::resolveUri(const std::string &uri, const std::string baseU
 /** @endcond */
 
 
+void
+SBMLResolverRegistry::setMaxCachedDocuments(unsigned int maxDocuments)
+{
+  DocumentCacheLock lock;
+  mMaxCachedDocuments = maxDocuments;
+  trimDocumentCache(maxDocuments);
+}
+
+
+unsigned int
+SBMLResolverRegistry::getMaxCachedDocuments() const
+{
+  DocumentCacheLock lock;
+  return mMaxCachedDocuments;
+}
+
+
+unsigned int
+SBMLResolverRegistry::getNumCachedDocuments() const
+{
+  DocumentCacheLock lock;
+  return (unsigned int)mDocumentCache.size();
+}
+
+
+void
+SBMLResolverRegistry::clearDocumentCache()
+{
+  DocumentCacheLock lock;
+  trimDocumentCache(0);
+}
+
+
+bool
+SBMLResolverRegistry::invalidateCachedDocument(const std::string &uri, const std::string baseUri/*=""*/)
+{
+  string key;
+  time_t modified;
+  if (!getCacheKey(uri, baseUri, key, modified))
+    return false;
+
+  DocumentCacheLock lock;
+  std::map<std::string, CachedDocument>::iterator it = mDocumentCache.find(key);
+  if (it == mDocumentCache.end())
+    return false;
+
+  delete it->second.document;
+  mDocumentCacheOrder.erase(it->second.position);
+  mDocumentCache.erase(it);
+  return true;
+}
+
+
 LIBSBML_CPP_NAMESPACE_END
 
 #endif  /* __cplusplus */
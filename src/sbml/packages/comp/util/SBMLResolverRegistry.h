@@ -48,6 +48,16 @@
  * registered, then use SBMLResolverRegistry::getResolverByIndex(@if java
  * int@endif) to iterate over each one;
  *
+ * The registry can also keep a process-wide cache of the documents it has
+ * resolved, so that a file referenced by many external model definitions
+ * (or by many documents) is only read and parsed once.  The cache is off by
+ * default; it is switched on by giving it a size with
+ * SBMLResolverRegistry::setMaxCachedDocuments(@if java long@endif).  Only
+ * URIs that resolve to local files take part: an entry is keyed by the
+ * resolved URI together with the modification time of the file, so an
+ * edited file is read again.  Callers always receive their own copy of the
+ * cached document, and the cache may be used from several threads at once.
+ *
  * @see SBMLFileResolver
  */
 
@@ -61,6 +71,8 @@
 
 #ifdef __cplusplus
 
+#include <ctime>
+#include <list>
 #include <map>
 #include <vector>
 #include <string>
@@ -179,6 +191,52 @@ public:
    */
   virtual SBMLUri* resolveUri(const std::string &uri, const std::string baseUri="") const;
 
+  /**
+   * Sets the maximum number of parsed documents kept in the document cache.
+   *
+   * When the cache is full, the least recently used document is dropped.
+   * A value of @c 0 (the default) disables the cache and empties it.
+   *
+   * @param maxDocuments the maximum number of documents to keep.
+   */
+  void setMaxCachedDocuments(unsigned int maxDocuments);
+
+
+  /**
+   * Returns the maximum number of parsed documents kept in the document
+   * cache.
+   *
+   * @return the size of the cache, or @c 0 if caching is disabled.
+   */
+  unsigned int getMaxCachedDocuments() const;
+
+
+  /**
+   * Returns the number of documents currently held in the document cache.
+   *
+   * @return the number of cached documents.
+   */
+  unsigned int getNumCachedDocuments() const;
+
+
+  /**
+   * Removes all documents from the document cache.
+   */
+  void clearDocumentCache();
+
+
+  /**
+   * Removes the document for the given URI from the document cache, so that
+   * the next call to resolve() reads it again.
+   *
+   * @param uri the URI to the target document.
+   * @param baseUri base URI, in case the URI is a relative one.
+   *
+   * @return @c true if a cached document was removed, @c false otherwise.
+   */
+  bool invalidateCachedDocument(const std::string &uri, const std::string baseUri="");
+
+
   /**
    * deletes the static resolver registry instance
    */
@@ -191,6 +249,35 @@ protected:
    * protected constructor, use the getInstance() method to access the registry.
    */
   SBMLResolverRegistry();
+
+
+  /**
+   * Asks each resolver in turn for the document, bypassing the cache.
+   */
+  SBMLDocument* resolveWithResolvers(const std::string &uri, const std::string& baseUri) const;
+
+
+  /**
+   * Returns the key under which the document for the given URI is cached,
+   * together with the modification time of its file.  Returns false if the
+   * URI does not resolve to a local file.
+   */
+  bool getCacheKey(const std::string &uri, const std::string& baseUri,
+                   std::string& key, time_t& modified) const;
+
+
+  /**
+   * Drops the least recently used documents until at most @p maxDocuments
+   * remain.  The caller must hold the cache lock.
+   */
+  void trimDocumentCache(unsigned int maxDocuments) const;
+
+  struct CachedDocument
+  {
+    SBMLDocument* document;
+    time_t modified;
+    std::list<std::string>::iterator position;
+  };
   /** @endcond */
 
 
@@ -198,6 +285,9 @@ protected:
   /** @cond doxygenLibsbmlInternal */
   std::vector<const SBMLResolver*>  mResolvers;
   std::set<const SBMLDocument*>  mOwnedDocuments;
+  unsigned int mMaxCachedDocuments;
+  mutable std::map<std::string, CachedDocument> mDocumentCache;
+  mutable std::list<std::string> mDocumentCacheOrder;
   static SBMLResolverRegistry* mInstance;
   /** @endcond */
 };
@@ -37,10 +37,13 @@
 #include <sbml/packages/comp/common/CompExtensionTypes.h>
 
 #include <sbml/conversion/SBMLConverterRegistry.h>
+#include <sbml/packages/comp/util/SBMLResolverRegistry.h>
 #include <sbml/SBMLReader.h>
 #include <sbml/SBMLTypes.h>
+#include <sbml/util/ParallelTask.h>
 
 #include <string>
+#include <vector>
 
 #include <check.h>
 
@@ -53,6 +56,23 @@ BEGIN_C_DECLS
 
 extern char *TestDataDirectory;
 
+/* some tests change the number of threads; restore it even if they fail */
+static unsigned int MaxThreads;
+
+void
+FlatteningConverterTest_setup (void)
+{
+  MaxThreads = ParallelTask::getMaxThreads();
+}
+
+
+void
+FlatteningConverterTest_teardown (void)
+{
+  ParallelTask::setMaxThreads(MaxThreads);
+}
+
+
 START_TEST (test_comp_get_flattening_converter)
 {
   ConversionProperties props;
@@ -2126,12 +2146,116 @@ START_TEST(test_comp_flatten_conversion_factor3)
 END_TEST
 
 
+START_TEST(test_comp_flatten_parallel_instantiation)
+{
+  // the flattened result must not depend on how many threads are used
+  // to copy sibling submodels
+  ParallelTask::setMaxThreads(4);
+
+  TestFlattenedPair("aggregate.xml", "aggregate_flat.xml");
+  TestFlattenedPair("complexified.xml", "complexified_flat.xml");
+  TestFlattenedPair("eg-import-external.xml", "eg-import-external_flat.xml");
+  TestFlattenedPair("CompTest.xml", "CompTest_flat.xml");
+  TestFlattenedPair("test28.xml", "test28_flat.xml");
+}
+END_TEST
+
+
+START_TEST(test_comp_flatten_batch)
+{
+  string filename(TestDataDirectory);
+
+  const char* files[] = { "aggregate.xml", "complexified.xml",
+    "eg-import-external.xml", "CompTest.xml", "test28.xml", "aggregate.xml" };
+  const char* flatFiles[] = { "aggregate_flat.xml", "complexified_flat.xml",
+    "eg-import-external_flat.xml", "CompTest_flat.xml", "test28_flat.xml",
+    "aggregate_flat.xml" };
+  const size_t numFiles = sizeof(files) / sizeof(files[0]);
+
+  ConversionProperties props;
+  props.addOption("flatten comp");
+  props.addOption("basePath", filename);
+  props.addOption("performValidation", true);
+
+  SBMLConverter* converter = SBMLConverterRegistry::getInstance().getConverterFor(props);
+  fail_unless(converter != NULL);
+  fail_unless(converter->isThreadSafe() == false);
+  delete converter;
+
+  vector<SBMLDocument*> docs;
+  for (size_t i = 0; i < numFiles; i++)
+  {
+    docs.push_back(readSBMLFromFile((filename + files[i]).c_str()));
+  }
+
+  // the documents are flattened one after another whatever the number
+  // of threads, and the callbacks and resolvers added for one document
+  // are gone before the next one is flattened
+  int numCallbacks = Submodel::getNumProcessingCallbacks();
+  int numResolvers = SBMLResolverRegistry::getInstance().getNumResolvers();
+
+  vector<int> results;
+  fail_unless(SBMLConverterRegistry::getInstance().convert(docs, props, &results, 4)
+              == LIBSBML_OPERATION_SUCCESS);
+
+  fail_unless(Submodel::getNumProcessingCallbacks() == numCallbacks);
+  fail_unless(SBMLResolverRegistry::getInstance().getNumResolvers() == numResolvers);
+
+  for (size_t i = 0; i < numFiles; i++)
+  {
+    fail_unless(results[i] == LIBSBML_OPERATION_SUCCESS);
+
+    SBMLDocument* fdoc = readSBMLFromFile((filename + flatFiles[i]).c_str());
+    fail_unless(writeSBMLToStdString(docs[i]) == writeSBMLToStdString(fdoc));
+
+    delete fdoc;
+    delete docs[i];
+  }
+}
+END_TEST
+
+
+START_TEST(test_comp_flatten_stored_uri_documents)
+{
+  string filename(TestDataDirectory);
+  filename += "eg-import-external.xml";
+  SBMLDocument* doc = readSBMLFromFile(filename.c_str());
+  fail_unless(doc->getModel() != NULL);
+
+  CompSBMLDocumentPlugin* docplug = 
+    static_cast<CompSBMLDocumentPlugin*>(doc->getPlugin("comp"));
+  CompModelPlugin* modplug = 
+    static_cast<CompModelPlugin*>(doc->getModel()->getPlugin("comp"));
+  fail_unless(docplug->getNumStoredURIDocumentMisses() == 0);
+  fail_unless(docplug->getNumStoredURIDocumentHits() == 0);
+
+  // both submodels use the same external model definition, so
+  // only the first one has to read the external document
+  fail_unless(modplug->getSubmodel(0)->instantiate() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(modplug->getSubmodel(1)->instantiate() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(modplug->getSubmodel(0)->instantiate() == LIBSBML_OPERATION_SUCCESS);
+  fail_unless(docplug->getNumStoredURIDocumentMisses() == 1);
+  fail_unless(docplug->getNumStoredURIDocumentHits() == 2);
+  fail_unless(modplug->getSubmodel(0)->getInstantiation() != 
+              modplug->getSubmodel(1)->getInstantiation());
+  fail_unless(modplug->getSubmodel(0)->getInstantiation()->getNumSpecies() ==
+              modplug->getSubmodel(1)->getInstantiation()->getNumSpecies());
+
+  delete doc;
+}
+END_TEST
+
+
 Suite *
 create_suite_TestFlatteningConverter (void)
 { 
   TCase *tcase = tcase_create("SBMLCompFlatteningConverter");
   Suite *suite = suite_create("SBMLCompFlatteningConverter");
 
+  tcase_add_checked_fixture(tcase,
+                            FlatteningConverterTest_setup,
+                            FlatteningConverterTest_teardown);
+
   tcase_add_test(tcase, test_invalid_layout_disabled);
   tcase_add_test(tcase, test_comp_flatten_double_ext2);
   tcase_add_test(tcase, test_comp_get_flattening_converter);
@@ -2279,6 +2403,9 @@ create_suite_TestFlatteningConverter (void)
   tcase_add_test(tcase, test_comp_flatten_conversion_factor);
   tcase_add_test(tcase, test_comp_flatten_conversion_factor2);
   tcase_add_test(tcase, test_comp_flatten_conversion_factor3);
+  tcase_add_test(tcase, test_comp_flatten_parallel_instantiation);
+  tcase_add_test(tcase, test_comp_flatten_batch);
+  tcase_add_test(tcase, test_comp_flatten_stored_uri_documents);
 
   suite_add_tcase(suite, tcase);
 
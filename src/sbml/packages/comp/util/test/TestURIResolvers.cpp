@@ -312,6 +312,83 @@ START_TEST (test_comp_resolverregistry_2)
 END_TEST
   
   
+START_TEST (test_comp_resolverregistry_cache)
+{ 
+  SBMLResolverRegistry &registry = SBMLResolverRegistry::getInstance();
+  fail_unless(registry.getMaxCachedDocuments() == 0);
+  string base("file:");
+  base += TestDataDirectory;
+  base += "complexified.xml";
+
+  // nothing is kept while the cache is disabled
+  SBMLDocument* doc = registry.resolve("enzyme_model.xml", base);
+  fail_unless(doc != NULL);
+  fail_unless(registry.getNumCachedDocuments() == 0);
+  delete doc;
+
+  registry.setMaxCachedDocuments(2);
+  doc = registry.resolve("enzyme_model.xml", base);
+  SBMLDocument* doc2 = registry.resolve("enzyme_model.xml", base);
+  fail_unless(registry.getNumCachedDocuments() == 1);
+  fail_unless(doc != NULL);
+  fail_unless(doc2 != NULL);
+  fail_unless(doc != doc2);
+  fail_unless(doc2->getModel() != NULL);
+  fail_unless(doc2->getModel()->getId() == doc->getModel()->getId());
+  delete doc;
+  delete doc2;
+
+  fail_unless(registry.invalidateCachedDocument("enzyme_model.xml", base) == true);
+  fail_unless(registry.invalidateCachedDocument("enzyme_model.xml", base) == false);
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  // unresolvable documents are not cached
+  doc = registry.resolve("non-existent-file.really", base);
+  fail_unless(doc == NULL);
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  // the least recently used document is dropped
+  delete registry.resolve("enzyme_model.xml", base);
+  delete registry.resolve("aggregate.xml", base);
+  delete registry.resolve("complexified.xml", base);
+  fail_unless(registry.getNumCachedDocuments() == 2);
+  fail_unless(registry.invalidateCachedDocument("enzyme_model.xml", base) == false);
+  fail_unless(registry.invalidateCachedDocument("aggregate.xml", base) == true);
+
+  registry.clearDocumentCache();
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  registry.setMaxCachedDocuments(0);
+  fail_unless(registry.getMaxCachedDocuments() == 0);
+}
+END_TEST
+
+
+START_TEST (test_comp_resolverregistry_cache_sameFile)
+{
+  SBMLResolverRegistry &registry = SBMLResolverRegistry::getInstance();
+  string base("file:");
+  base += TestDataDirectory;
+  base += "complexified.xml";
+  string absolute("file:");
+  absolute += TestDataDirectory;
+  absolute += "enzyme_model.xml";
+
+  // different spellings of the same file share one cache entry
+  registry.setMaxCachedDocuments(4);
+  delete registry.resolve("enzyme_model.xml", base);
+  delete registry.resolve("./enzyme_model.xml", base);
+  delete registry.resolve(absolute);
+  fail_unless(registry.getNumCachedDocuments() == 1);
+
+  fail_unless(registry.invalidateCachedDocument(absolute) == true);
+  fail_unless(registry.getNumCachedDocuments() == 0);
+
+  registry.setMaxCachedDocuments(0);
+}
+END_TEST
+
+  
 Suite *
 create_suite_TestURIResolvers (void)
 { 
@@ -328,6 +405,8 @@ create_suite_TestURIResolvers (void)
   tcase_add_test(tcase, test_comp_fileresolver_resolve_6);
   tcase_add_test(tcase, test_comp_resolverregistry_1);
   tcase_add_test(tcase, test_comp_resolverregistry_2);
+  tcase_add_test(tcase, test_comp_resolverregistry_cache);
+  tcase_add_test(tcase, test_comp_resolverregistry_cache_sameFile);
   suite_add_tcase(suite, tcase);
 
   return suite;
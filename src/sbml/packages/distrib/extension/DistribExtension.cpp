@@ -47,6 +47,7 @@
 #include <sbml/packages/distrib/extension/DistribExtension.h>
 #include <sbml/packages/distrib/extension/DistribSBMLDocumentPlugin.h>
 #include <sbml/packages/distrib/validator/DistribSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/distrib/extension/DistribSBasePlugin.h>
 #include <sbml/packages/distrib/extension/DistribASTPlugin.h>
 #include <sbml/packages/distrib/util/AnnotationToDistribConverter.h>
@@ -334,20 +335,8 @@ DistribExtension::getErrorTable(unsigned int index) const
 unsigned int
 DistribExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(distribErrorTable)/sizeof(distribErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == distribErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(distribErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
@@ -121,6 +121,15 @@ AnnotationToDistribConverter::convert()
 
 }
 
+
+void
+AnnotationToDistribConverter::reset()
+{
+  mKeepFunctions.clear();
+
+  SBMLConverter::reset();
+}
+
 /** @cond doxygenLibsbmlInternal */
 int 
 AnnotationToDistribConverter::performConversion()
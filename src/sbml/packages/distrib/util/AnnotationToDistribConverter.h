@@ -131,6 +131,12 @@ public:
   virtual int convert();
 
 
+  /**
+   * Forgets the document and the function definitions kept in it.
+   */
+  virtual void reset();
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Performs the conversion.
@@ -124,6 +124,15 @@ DistribToAnnotationConverter::convert()
 
 }
 
+
+void
+DistribToAnnotationConverter::reset()
+{
+  mCreatedFunctions.clear();
+
+  SBMLConverter::reset();
+}
+
 bool
 DistribToAnnotationConverter::getWriteMeans()
 {
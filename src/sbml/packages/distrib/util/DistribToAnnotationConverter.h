@@ -131,6 +131,12 @@ public:
    */
   virtual int convert();
 
+
+  /**
+   * Forgets the document and the function definitions created in it.
+   */
+  virtual void reset();
+
   bool getWriteMeans();
 
 
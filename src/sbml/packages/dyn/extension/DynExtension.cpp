@@ -53,6 +53,7 @@
 #include <sbml/packages/dyn/extension/DynSBasePlugin.h>
 #include <sbml/packages/dyn/extension/DynSBMLDocumentPlugin.h>
 #include <sbml/packages/dyn/validator/DynSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 
 #ifdef __cplusplus
@@ -461,20 +462,8 @@ DynExtension::getErrorTable(unsigned int index) const
 unsigned int
 DynExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(dynErrorTable)/sizeof(dynErrorTable[0]);
-  unsigned int index = 0;
-
-  for(unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == dynErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-
-  }
-
-  return index;
+  static const ErrorTableIndex index(dynErrorTable);
+  return index.find(errorId);
 }
 
   /** @endcond doxygenLibsbmlInternal */
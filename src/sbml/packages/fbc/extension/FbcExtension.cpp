@@ -42,6 +42,7 @@
 #include <sbml/packages/fbc/extension/FbcExtension.h>
 #include <sbml/packages/fbc/extension/FbcSBMLDocumentPlugin.h>
 #include <sbml/packages/fbc/validator/FbcSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/conversion/SBMLConverterRegistry.h>
 
 #include <sbml/packages/fbc/util/CobraToFbcConverter.h>
@@ -433,19 +434,8 @@ FbcExtension::getErrorTableV3(unsigned int index) const
 unsigned int
 FbcExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(fbcErrorTableV3)/sizeof(fbcErrorTableV3[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == fbcErrorTableV3[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(fbcErrorTableV3);
+  return index.find(errorId);
 }
 
 /** @endcond */
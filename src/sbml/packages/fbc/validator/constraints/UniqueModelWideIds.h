@@ -46,6 +46,7 @@
 #include <map>
 
 #include <sbml/validator/VConstraint.h>
+#include <sbml/validator/IdCensus.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -118,16 +119,6 @@ protected:
    */
   void doCheckId (const std::string& id, const SBase& object);
 
-  /**
-   * Checks that the id associated with the given object adheres to this
-   * constraint.  If it does not, logFailure is called.
-   */
-  void logId (const SBase& object);
-
-  /**
-   * Called by check().  Override this method to define your own subset.
-   */
-  void createExistingMap (const Model& m);
 
   /**
    * Returns the error message to use when logging constraint violations.
@@ -182,6 +173,9 @@ protected:
 
   typedef std::map<std::string, const SBase*> IdObjectMap;
   IdObjectMap mIdMap;
+
+  /* the ids of the core elements, see IdCensus::getShared() */
+  const IdCensus* mCensus;
 };
 
 LIBSBML_CPP_NAMESPACE_END
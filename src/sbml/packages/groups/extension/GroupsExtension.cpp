@@ -47,6 +47,7 @@
 #include <sbml/packages/groups/extension/GroupsExtension.h>
 #include <sbml/packages/groups/extension/GroupsSBMLDocumentPlugin.h>
 #include <sbml/packages/groups/validator/GroupsSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/groups/extension/GroupsModelPlugin.h>
 
 
@@ -331,20 +332,8 @@ GroupsExtension::getErrorTable(unsigned int index) const
 unsigned int
 GroupsExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(groupsErrorTable)/sizeof(groupsErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == groupsErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(groupsErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
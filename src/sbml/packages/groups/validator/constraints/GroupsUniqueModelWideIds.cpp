@@ -54,7 +54,7 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 /*
  * Creates a new GroupsUniqueModelWideIds with the given constraint id.
  */
-GroupsUniqueModelWideIds::GroupsUniqueModelWideIds (unsigned int id, Validator& v) : TConstraint<Model>(id, v)
+GroupsUniqueModelWideIds::GroupsUniqueModelWideIds (unsigned int id, Validator& v) : TConstraint<Model>(id, v), mCensus(NULL)
 {
 }
 
@@ -106,6 +106,7 @@ void
 GroupsUniqueModelWideIds::reset ()
 {
   mIdMap.clear();
+  mCensus = NULL;
 }
 
 
@@ -119,23 +120,17 @@ GroupsUniqueModelWideIds::doCheckId (const SBase& object)
   if (object.isSetId())
   {
     const string& id = object.getId();
+    const SBase* previous = mCensus->getFirstOwner(IdCensus::MODEL_IDS, id);
 
-    if (mIdMap.insert( make_pair(id, &object) ).second == false)
+    if (previous != NULL)
+    {
+      mIdMap.insert( make_pair(id, previous) );
+      logIdConflict(id, object);
+    }
+    else if (mIdMap.insert( make_pair(id, &object) ).second == false)
     {
       logIdConflict(id, object);
     }
-  }
-}
-
-
-void
-GroupsUniqueModelWideIds::logId (const SBase& object)
-{ 
-  if (object.isSetId())
-  {
-    const string& id = object.getId();
-
-    mIdMap.insert( make_pair(id, &object) );
   }
 }
 
@@ -197,7 +192,13 @@ GroupsUniqueModelWideIds::getMessage (const string& id, const SBase& object)
 void
 GroupsUniqueModelWideIds::doCheck (const Model& m)
 {
-  createExistingMap(m);
+  // the core ids come from the census shared by the validators
+  IdCensus local(&m);
+  mCensus = IdCensus::getShared(m);
+  if (mCensus == NULL)
+  {
+    mCensus = &local;
+  }
 
   unsigned int size = 0;
 
@@ -220,64 +221,5 @@ GroupsUniqueModelWideIds::doCheck (const Model& m)
   reset();
 }
 
-/*
- * Checks that all ids on the following Model objects are unique:
- * FunctionDefinitions, Species, Compartments, global Parameters,
- * Reactions, and Events.
- */
-void
-GroupsUniqueModelWideIds::createExistingMap (const Model& m)
-{
-  unsigned int n, size, sr, sr_size;
-
-  logId( m );
-
-  size = m.getNumFunctionDefinitions();
-  for (n = 0; n < size; ++n) logId( *m.getFunctionDefinition(n) );
-
-  size = m.getNumCompartments();
-  for (n = 0; n < size; ++n) logId( *m.getCompartment(n) );
-
-  size = m.getNumSpecies();
-  for (n = 0; n < size; ++n) logId( *m.getSpecies(n) );
-
-  size = m.getNumParameters();
-  for (n = 0; n < size; ++n) logId( *m.getParameter(n) );
-
-  size = m.getNumReactions();
-  for (n = 0; n < size; ++n) 
-  {
-    logId( *m.getReaction(n) );
-
-    sr_size = m.getReaction(n)->getNumReactants();
-    for (sr = 0; sr < sr_size; sr++)
-    {
-      logId(*m.getReaction(n)->getReactant(sr));
-    }
-
-    sr_size = m.getReaction(n)->getNumProducts();
-    for (sr = 0; sr < sr_size; sr++)
-    {
-      logId(*m.getReaction(n)->getProduct(sr));
-    }
-
-    sr_size = m.getReaction(n)->getNumModifiers();
-    for (sr = 0; sr < sr_size; sr++)
-    {
-      logId((SBase&)(*m.getReaction(n)->getModifier(sr)));
-    }
-
-  }
-
-  size = m.getNumEvents();
-  for (n = 0; n < size; ++n) logId( *m.getEvent(n) );
-
-  size = m.getNumCompartmentTypes();
-  for (n = 0; n < size; ++n) logId( *m.getCompartmentType(n) );
-
-  size = m.getNumSpeciesTypes();
-  for (n = 0; n < size; ++n) logId( *m.getSpeciesType(n) );
-}
-
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
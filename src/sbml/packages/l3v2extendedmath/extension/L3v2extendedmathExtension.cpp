@@ -47,6 +47,7 @@
 #include <sbml/packages/l3v2extendedmath/extension/L3v2extendedmathExtension.h>
 #include <sbml/packages/l3v2extendedmath/extension/L3v2extendedmathSBMLDocumentPlugin.h>
 #include <sbml/packages/l3v2extendedmath/validator/L3v2extendedmathSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/l3v2extendedmath/extension/L3v2extendedmathASTPlugin.h>
 
 
@@ -355,20 +356,8 @@ L3v2extendedmathExtension::getErrorTable(unsigned int index) const
 unsigned int
 L3v2extendedmathExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(l3v2extendedmathErrorTable)/sizeof(l3v2extendedmathErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == l3v2extendedmathErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(l3v2extendedmathErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
@@ -51,6 +51,7 @@
 #include <sbml/packages/layout/extension/LayoutSpeciesReferencePlugin.h>
 #include <sbml/packages/layout/extension/LayoutSBMLDocumentPlugin.h>
 #include <sbml/packages/layout/validator/LayoutSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 
 #ifdef __cplusplus
@@ -523,20 +524,8 @@ LayoutExtension::getErrorTable(unsigned int index) const
 unsigned int
 LayoutExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(layoutErrorTable)/sizeof(layoutErrorTable[0]);
-  unsigned int index = 0;
-
-  for(unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == layoutErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-
-  }
-
-  return index;
+  static const ErrorTableIndex index(layoutErrorTable);
+  return index.find(errorId);
 }
 /** @endcond */
 
@@ -46,6 +46,7 @@
 #include <sbml/packages/multi/extension/MultiSpeciesReferencePlugin.h>
 #include <sbml/packages/multi/extension/MultiSBMLDocumentPlugin.h>
 #include <sbml/packages/multi/validator/MultiSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/multi/extension/MultiASTPlugin.h>
 #include <sbml/packages/multi/extension/MultiListOfReactionsPlugin.h>
 
@@ -424,20 +425,8 @@ MultiExtension::getErrorTable(unsigned int index) const
 unsigned int
 MultiExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(multiErrorTable)/sizeof(multiErrorTable[0]);
-  unsigned int index = 0;
-
-  for(unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == multiErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-
-  }
-
-  return index;
+  static const ErrorTableIndex index(multiErrorTable);
+  return index.find(errorId);
 }
 /** @endcond */
 
@@ -49,6 +49,7 @@
 #include <sbml/packages/qual/extension/QualModelPlugin.h>
 #include <sbml/packages/qual/extension/QualSBMLDocumentPlugin.h>
 #include <sbml/packages/qual/validator/QualSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 #ifdef __cplusplus
 
@@ -420,19 +421,8 @@ QualExtension::getErrorTable(unsigned int index) const
 unsigned int 
 QualExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(qualErrorTable)/sizeof(qualErrorTable[0]);
-  unsigned int index = 0;
-
-  for ( unsigned int i = 0; i < tableSize; i++ )
-  {
-    if ( errorId == qualErrorTable[i].code )
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(qualErrorTable);
+  return index.find(errorId);
 }
 /** @endcond */
 
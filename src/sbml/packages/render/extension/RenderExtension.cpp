@@ -42,6 +42,7 @@
 #include <sbml/packages/layout/extension/LayoutModelPlugin.h>
 #include <sbml/packages/render/extension/RenderListOfLayoutsPlugin.h>
 #include <sbml/packages/render/validator/RenderSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/render/extension/RenderGraphicalObjectPlugin.h>
 #include <sbml/packages/render/extension/RenderSBMLDocumentPlugin.h>
 #include <sbml/SBMLDocument.h>
@@ -390,20 +391,8 @@ RenderExtension::getErrorTable(unsigned int index) const
 unsigned int
 RenderExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(renderErrorTable)/sizeof(renderErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == renderErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(renderErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
@@ -51,6 +51,7 @@
 #include <sbml/packages/req/extension/ReqSBasePlugin.h>
 #include <sbml/packages/req/extension/ReqSBMLDocumentPlugin.h>
 #include <sbml/packages/req/validator/ReqSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 
 
 #ifdef __cplusplus
@@ -398,20 +399,8 @@ ReqExtension::getErrorTable(unsigned int index) const
 unsigned int
 ReqExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize = sizeof(reqErrorTable)/sizeof(reqErrorTable[0]);
-  unsigned int index = 0;
-
-  for(unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == reqErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-
-  }
-
-  return index;
+  static const ErrorTableIndex index(reqErrorTable);
+  return index.find(errorId);
 }
 
   /** @endcond doxygenLibsbmlInternal */
@@ -47,6 +47,7 @@
 #include <sbml/packages/spatial/extension/SpatialExtension.h>
 #include <sbml/packages/spatial/extension/SpatialSBMLDocumentPlugin.h>
 #include <sbml/packages/spatial/validator/SpatialSBMLErrorTable.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/packages/spatial/extension/SpatialModelPlugin.h>
 #include <sbml/packages/spatial/extension/SpatialCompartmentPlugin.h>
 #include <sbml/packages/spatial/extension/SpatialSpeciesPlugin.h>
@@ -367,20 +368,8 @@ SpatialExtension::getErrorTable(unsigned int index) const
 unsigned int
 SpatialExtension::getErrorTableIndex(unsigned int errorId) const
 {
-  unsigned int tableSize =
-    sizeof(spatialErrorTable)/sizeof(spatialErrorTable[0]);
-  unsigned int index = 0;
-
-  for (unsigned int i = 0; i < tableSize; i++)
-  {
-    if (errorId == spatialErrorTable[i].code)
-    {
-      index = i;
-      break;
-    }
-  }
-
-  return index;
+  static const ErrorTableIndex index(spatialErrorTable);
+  return index.find(errorId);
 }
 
 /** @endcond */
@@ -0,0 +1,310 @@
+/**
+ * @file    TestBatchEvaluator.cpp
+ * @brief   BatchEvaluator unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/BatchEvaluator.h>
+#include <sbml/SBMLTransforms.h>
+#include <sbml/math/L3Parser.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+static bool
+equalOrNaN (double a, double b)
+{
+  if (util_isNaN(a) || util_isNaN(b))
+  {
+    return util_isNaN(a) && util_isNaN(b);
+  }
+  return a == b || fabs(a - b) <= 1e-12 * (fabs(a) + fabs(b));
+}
+
+
+/*
+ * Evaluates the formula over a number of lanes, both with a BatchEvaluator
+ * and lane by lane with SBMLTransforms::evaluateASTNode(), and returns
+ * whether the results agree.
+ */
+static bool
+agreesWithTransforms (const char* formula, const Model* model = NULL)
+{
+  const unsigned int numLanes = 100;
+  ASTNode* math = SBML_parseL3Formula(formula);
+  if (math == NULL) return false;
+
+  BatchEvaluator evaluator;
+  if (evaluator.compile(math, model) != LIBSBML_OPERATION_SUCCESS)
+  {
+    delete math;
+    return false;
+  }
+
+  std::vector< std::vector<double> > columns(evaluator.getNumVariables());
+  std::vector<const double*> variables(evaluator.getNumVariables());
+  for (unsigned int v = 0; v < evaluator.getNumVariables(); v++)
+  {
+    columns[v].resize(numLanes);
+    for (unsigned int i = 0; i < numLanes; i++)
+    {
+      // a mix of negative, zero, fractional and integer values
+      columns[v][i] = ((int)((i * (v + 3) + 7 * v) % 21) - 10) / 4.0;
+    }
+    variables[v] = &columns[v][0];
+  }
+
+  std::vector<double> results(numLanes);
+  fail_unless( evaluator.evaluate(variables.empty() ? NULL : &variables[0],
+                                  &results[0], numLanes)
+               == LIBSBML_OPERATION_SUCCESS );
+
+  bool agree = true;
+  for (unsigned int i = 0; i < numLanes; i++)
+  {
+    std::map<std::string, double> values;
+    for (unsigned int v = 0; v < evaluator.getNumVariables(); v++)
+    {
+      values[evaluator.getVariableId(v)] = columns[v][i];
+    }
+    double expected = SBMLTransforms::evaluateASTNode(math, values, model);
+    if (!equalOrNaN(results[i], expected))
+    {
+      agree = false;
+    }
+  }
+
+  delete math;
+  return agree;
+}
+
+
+START_TEST (test_BatchEvaluator_operators)
+{
+  const char* formulas[] =
+  {
+    "x + y * z - 2.5",
+    "-x / y",
+    "x^2 + pow(y, 3)",
+    "sqrt(abs(x)) + root(3, y)",
+    "exp(x) + ln(abs(y) + 1) + log(10, abs(z) + 1)",
+    "floor(x) + ceil(y) + factorial(abs(z))",
+    "sin(x) + cos(y) + tan(z) + sinh(x) + cosh(y) + tanh(z)",
+    "sec(x) + csc(y) + cot(z) + sech(x) + csch(y) + coth(z)",
+    "arcsin(x / 3) + arccos(y / 3) + arctan(z)",
+    "arcsinh(x) + arccosh(abs(y) + 1) + arctanh(z / 3)",
+    "arcsec(x) + arccsc(y) + arccot(z)",
+    "arcsech(x / 3) + arccsch(y) + arccoth(z)",
+    "(x < y) + (x <= y) + (x > y) + (x >= y) + (x == y) + (x != y)",
+    "lt(x, y, z) + eq(x, x, y)",
+    "(x < y && y < z) + (x < y || y < z) + xor(x < y, y < z) + !(x < y)",
+    "piecewise(x, x < y, y, y < z, z)",
+    "piecewise(1, x < 0, 2, x <= 0)",
+    "piecewise(x, x > 0, y, x > -1)",
+    "pi * x + exponentiale + avogadro * 0 + true + false + time",
+    "x * x * x * x * x + y",
+    NULL
+  };
+
+  for (unsigned int n = 0; formulas[n] != NULL; n++)
+  {
+    fail_unless( agreesWithTransforms(formulas[n]), formulas[n] );
+  }
+}
+END_TEST
+
+
+/*
+ * The operators of the l3v2extendedmath package are checked against known
+ * values, as SBMLTransforms::evaluateASTNode() evaluates their arguments
+ * without the values of variables.
+ */
+START_TEST (test_BatchEvaluator_extendedMath)
+{
+  ASTNode* math = SBML_parseL3Formula(
+    "rem(x, y) + 10 * quotient(x, y) + 100 * max(x, y, 1) "
+    "+ 1000 * min(x, y, 1) + 10000 * implies(x < y, y < 3)");
+
+  BatchEvaluator evaluator;
+  fail_unless( evaluator.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( evaluator.getNumVariables() == 2 );
+
+  double x[] = { 7, -7, 2 };
+  double y[] = { 3,  2, 4 };
+  const double* variables[] = { x, y };
+  double results[3];
+
+  fail_unless( evaluator.evaluate(variables, results, 3)
+               == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( results[0] ==  1 + 10 *  2 + 100 * 7 + 1000 *  1 + 10000 );
+  fail_unless( results[1] ==  1 + 10 * -4 + 100 * 2 + 1000 * -7 + 10000 );
+  fail_unless( results[2] ==  2 + 10 *  0 + 100 * 4 + 1000 *  1 );
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_BatchEvaluator_variables)
+{
+  ASTNode* math = SBML_parseL3Formula("k * S1 - k2 * S2 + k * S1");
+  std::map<std::string, double> constants;
+  constants["k2"] = 0.5;
+
+  BatchEvaluator evaluator;
+  fail_unless( !evaluator.isCompiled() );
+  fail_unless( evaluator.compile(math, NULL, &constants)
+               == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( evaluator.isCompiled() );
+
+  // each variable is listed once, in order of appearance
+  fail_unless( evaluator.getNumVariables() == 3 );
+  fail_unless( evaluator.getVariableId(0) == "k" );
+  fail_unless( evaluator.getVariableId(1) == "S1" );
+  fail_unless( evaluator.getVariableId(2) == "S2" );
+  fail_unless( evaluator.getVariableId(3).empty() );
+  fail_unless( evaluator.getVariableIndex("S2") == 2 );
+  fail_unless( evaluator.getVariableIndex("k2") == -1 );
+
+  // more lanes than fit in one block
+  const unsigned int numLanes = 150;
+  std::vector<double> k(numLanes), s1(numLanes), s2(numLanes);
+  std::vector<double> results(numLanes);
+  for (unsigned int i = 0; i < numLanes; i++)
+  {
+    k[i] = i;
+    s1[i] = 2;
+    s2[i] = i + 1.0;
+  }
+  const double* variables[] = { &k[0], &s1[0], &s2[0] };
+
+  fail_unless( evaluator.evaluate(variables, &results[0], numLanes)
+               == LIBSBML_OPERATION_SUCCESS );
+  for (unsigned int i = 0; i < numLanes; i++)
+  {
+    fail_unless( results[i] == 4.0 * i - 0.5 * (i + 1.0) );
+  }
+
+  delete math;
+}
+END_TEST
+
+
+START_TEST (test_BatchEvaluator_functionDefinitions)
+{
+  SBMLDocument* doc = new SBMLDocument(3, 2);
+  Model* m = doc->createModel();
+  FunctionDefinition* fd = m->createFunctionDefinition();
+  fd->setId("mm");
+  ASTNode* lambda = SBML_parseL3Formula("lambda(v, km, s, v * s / (km + s))");
+  fd->setMath(lambda);
+  delete lambda;
+
+  fail_unless( agreesWithTransforms("mm(x, 2, y) + z", m) );
+
+  // without the model the function is undefined
+  ASTNode* math = SBML_parseL3Formula("mm(x, 2, y)");
+  BatchEvaluator evaluator;
+  fail_unless( evaluator.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  double result = 0;
+  fail_unless( evaluator.evaluate(NULL, &result, 1)
+               == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( util_isNaN(result) );
+
+  fail_unless( evaluator.compile(math, m) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( evaluator.getNumVariables() == 2 );
+
+  delete math;
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_BatchEvaluator_failures)
+{
+  BatchEvaluator evaluator;
+  double result = 0;
+
+  fail_unless( evaluator.compile(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( evaluator.evaluate(NULL, &result, 1)
+               == LIBSBML_INVALID_OBJECT );
+
+  ASTNode* math = SBML_parseL3Formula("x + 1");
+  fail_unless( evaluator.compile(math) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( evaluator.evaluate(NULL, &result, 1)
+               == LIBSBML_INVALID_OBJECT );
+
+  evaluator.clear();
+  fail_unless( !evaluator.isCompiled() );
+  fail_unless( evaluator.getNumVariables() == 0 );
+  fail_unless( evaluator.getNumOperations() == 0 );
+
+  delete math;
+}
+END_TEST
+
+
+Suite *
+create_suite_BatchEvaluator (void)
+{
+  Suite *suite = suite_create("BatchEvaluator");
+  TCase *tcase = tcase_create("BatchEvaluator");
+
+  tcase_add_test( tcase, test_BatchEvaluator_operators           );
+  tcase_add_test( tcase, test_BatchEvaluator_extendedMath        );
+  tcase_add_test( tcase, test_BatchEvaluator_variables           );
+  tcase_add_test( tcase, test_BatchEvaluator_functionDefinitions );
+  tcase_add_test( tcase, test_BatchEvaluator_failures            );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -0,0 +1,334 @@
+/**
+ * @file    TestDependencyGraph.cpp
+ * @brief   DependencyGraph unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/util/DependencyGraph.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+START_TEST (test_DependencyGraph_nodes)
+{
+  DependencyGraph graph;
+
+  fail_unless( graph.getNumNodes() == 0 );
+  fail_unless( graph.addNode("b") == 0 );
+  fail_unless( graph.addNode("a") == 1 );
+  fail_unless( graph.addNode("b") == 0 );
+  fail_unless( graph.getNumNodes() == 2 );
+
+  fail_unless( graph.getNodeIndex("a") == 1 );
+  fail_unless( graph.getNodeIndex("c") == -1 );
+  fail_unless( graph.getNodeId(0) == "b" );
+
+  // edges keep the order they were added in, repeats included
+  graph.addEdge(1, 0);
+  graph.addEdge(0, 1);
+  graph.addEdge(1, 1);
+  graph.addEdge(1, 0);
+
+  fail_unless( graph.getNumEdges(0) == 1 );
+  fail_unless( graph.getNumEdges(1) == 3 );
+  fail_unless( graph.getEdge(1, 0) == 0 );
+  fail_unless( graph.getEdge(1, 1) == 1 );
+  fail_unless( graph.getEdge(1, 2) == 0 );
+
+  // adding after a query rebuilds the adjacency
+  graph.addEdge(graph.addNode("c"), 0);
+  fail_unless( graph.getNumEdges(2) == 1 );
+  fail_unless( graph.getNumEdges(1) == 3 );
+}
+END_TEST
+
+
+START_TEST (test_DependencyGraph_cycles)
+{
+  DependencyGraph graph;
+
+  // a -> b -> c -> a, c -> d, d -> d, e -> a
+  for (unsigned int i = 0; i < 5; i++)
+  {
+    graph.addNode(std::string(1, (char)('a' + i)));
+  }
+  graph.addEdge(0, 1);
+  graph.addEdge(1, 2);
+  graph.addEdge(2, 0);
+  graph.addEdge(2, 3);
+  graph.addEdge(3, 3);
+  graph.addEdge(4, 0);
+
+  std::vector<unsigned int> component;
+  fail_unless( graph.getStronglyConnectedComponents(component) == 3 );
+  fail_unless( component[0] == component[1] );
+  fail_unless( component[1] == component[2] );
+  fail_unless( component[3] < component[0] );
+  fail_unless( component[0] < component[4] );
+
+  std::vector<bool> inCycle;
+  fail_unless( graph.getNodesInCycles(inCycle) == 4 );
+  fail_unless( inCycle[0] && inCycle[1] && inCycle[2] && inCycle[3] );
+  fail_unless( !inCycle[4] );
+}
+END_TEST
+
+
+START_TEST (test_DependencyGraph_longChain)
+{
+  DependencyGraph graph;
+  const unsigned int length = 100000;
+
+  // a chain this long would overflow a recursive search
+  for (unsigned int i = 0; i < length; i++)
+  {
+    std::ostringstream id;
+    id << "x" << i;
+    graph.addNode(id.str());
+  }
+  for (unsigned int i = 0; i + 1 < length; i++)
+  {
+    graph.addEdge(i, i + 1);
+  }
+
+  std::vector<bool> inCycle;
+  fail_unless( graph.getNodesInCycles(inCycle) == 0 );
+
+  graph.addEdge(length - 1, 0);
+  fail_unless( graph.getNodesInCycles(inCycle) == length );
+}
+END_TEST
+
+
+START_TEST (test_DependencyGraph_sort)
+{
+  DependencyGraph graph;
+
+  // a depends on c, b on nothing, c on d (not sorted), d on itself
+  unsigned int a = graph.addNode("a");
+  unsigned int b = graph.addNode("b");
+  unsigned int c = graph.addNode("c");
+  unsigned int d = graph.addNode("d");
+  graph.addEdge(a, c);
+  graph.addEdge(c, d);
+  graph.addEdge(c, c);
+
+  std::vector<unsigned int> nodes;
+  nodes.push_back(a);
+  nodes.push_back(b);
+  nodes.push_back(c);
+
+  std::vector<unsigned int> order;
+  fail_unless( graph.sortTopologically(nodes, order) == true );
+  fail_unless( order.size() == 3 );
+  fail_unless( order[0] == 2 );
+  fail_unless( order[1] == 0 );
+  fail_unless( order[2] == 1 );
+
+  // a list that is already sorted stays as it is
+  nodes.clear();
+  nodes.push_back(b);
+  nodes.push_back(c);
+  nodes.push_back(a);
+  fail_unless( graph.sortTopologically(nodes, order) == true );
+  fail_unless( order[0] == 0 );
+  fail_unless( order[1] == 1 );
+  fail_unless( order[2] == 2 );
+
+  // with a cycle the unsortable nodes come last, in their original order
+  graph.addEdge(c, a);
+  nodes.clear();
+  nodes.push_back(a);
+  nodes.push_back(b);
+  nodes.push_back(c);
+  fail_unless( graph.sortTopologically(nodes, order) == false );
+  fail_unless( order.size() == 3 );
+  fail_unless( order[0] == 1 );
+  fail_unless( order[1] == 0 );
+  fail_unless( order[2] == 2 );
+}
+END_TEST
+
+
+START_TEST (test_DependencyGraph_math)
+{
+  DependencyGraph graph;
+  unsigned int y = graph.addNode("y");
+  unsigned int f = graph.addNode("f");
+
+  ASTNode* math = SBML_parseFormula("f(z) + z");
+  graph.addMath(y, math);
+  delete math;
+
+  // the argument of the function is local to it
+  std::set<std::string> arguments;
+  arguments.insert("x");
+  math = SBML_parseFormula("lambda(x, x * k)");
+  graph.addMath(f, math, &arguments);
+  delete math;
+
+  int z = graph.getNodeIndex("z");
+  int k = graph.getNodeIndex("k");
+  fail_unless( z >= 0 && k >= 0 );
+  fail_unless( graph.getNodeIndex("x") == -1 );
+
+  fail_unless( graph.getNumEdges(y) == 3 );
+  fail_unless( graph.getEdge(y, 0) == f );
+  fail_unless( graph.getEdge(y, 1) == (unsigned int)z );
+  fail_unless( graph.getEdge(y, 2) == (unsigned int)z );
+  fail_unless( graph.getNumEdges(f) == 1 );
+  fail_unless( graph.getEdge(f, 0) == (unsigned int)k );
+  fail_unless( graph.getNumEdges((unsigned int)z) == 0 );
+
+  std::vector<bool> inCycle;
+  fail_unless( graph.getNodesInCycles(inCycle) == 0 );
+
+  // k -> y closes the cycles y -> f -> k -> y
+  graph.addEdge((unsigned int)k, y);
+  fail_unless( graph.getNodesInCycles(inCycle) == 3 );
+  fail_unless( inCycle[y] && inCycle[f] && inCycle[(unsigned int)k] );
+  fail_unless( !inCycle[(unsigned int)z] );
+}
+END_TEST
+
+
+START_TEST (test_DependencyGraph_model)
+{
+  SBMLDocument doc(3, 1);
+  Model* model = doc.createModel();
+
+  AssignmentRule* rule = model->createAssignmentRule();
+  rule->setVariable("y");
+  ASTNode* math = SBML_parseFormula("z + k");
+  rule->setMath(math);
+  delete math;
+
+  // only the first rule for w counts
+  RateRule* rateRule = model->createRateRule();
+  rateRule->setVariable("w");
+  math = SBML_parseFormula("1");
+  rateRule->setMath(math);
+  delete math;
+
+  rule = model->createAssignmentRule();
+  rule->setVariable("w");
+  math = SBML_parseFormula("y");
+  rule->setMath(math);
+  delete math;
+
+  InitialAssignment* ia = model->createInitialAssignment();
+  ia->setSymbol("z");
+  math = SBML_parseFormula("k");
+  ia->setMath(math);
+  delete math;
+
+  // event assignments are not part of the graph
+  EventAssignment* ea = model->createEvent()->createEventAssignment();
+  ea->setVariable("k");
+  math = SBML_parseFormula("y");
+  ea->setMath(math);
+  delete math;
+
+  Reaction* reaction = model->createReaction();
+  reaction->setId("r");
+  KineticLaw* kl = reaction->createKineticLaw();
+  kl->createLocalParameter()->setId("p");
+  math = SBML_parseFormula("p * y");
+  kl->setMath(math);
+  delete math;
+
+  DependencyGraph graph;
+  graph.addModel(*model);
+
+  int y = graph.getNodeIndex("y");
+  int z = graph.getNodeIndex("z");
+  int k = graph.getNodeIndex("k");
+  int r = graph.getNodeIndex("r");
+  fail_unless( y >= 0 && z >= 0 && k >= 0 && r >= 0 );
+
+  fail_unless( graph.getNumEdges((unsigned int)y) == 2 );
+  fail_unless( graph.getEdge((unsigned int)y, 0) == (unsigned int)z );
+  fail_unless( graph.getEdge((unsigned int)y, 1) == (unsigned int)k );
+  fail_unless( graph.getNumEdges((unsigned int)z) == 1 );
+  fail_unless( graph.getEdge((unsigned int)z, 0) == (unsigned int)k );
+  fail_unless( graph.getNumEdges((unsigned int)k) == 0 );
+
+  // the local parameter is not part of the graph
+  fail_unless( graph.getNodeIndex("p") == -1 );
+  fail_unless( graph.getNumEdges((unsigned int)r) == 1 );
+  fail_unless( graph.getEdge((unsigned int)r, 0) == (unsigned int)y );
+
+  fail_unless( graph.getNodeIndex("w") == -1 );
+
+  std::vector<bool> inCycle;
+  fail_unless( graph.getNodesInCycles(inCycle) == 0 );
+}
+END_TEST
+
+
+Suite *
+create_suite_DependencyGraph (void)
+{
+  Suite *suite = suite_create("DependencyGraph");
+  TCase *tcase = tcase_create("DependencyGraph");
+
+  tcase_add_test( tcase, test_DependencyGraph_nodes     );
+  tcase_add_test( tcase, test_DependencyGraph_cycles    );
+  tcase_add_test( tcase, test_DependencyGraph_longChain );
+  tcase_add_test( tcase, test_DependencyGraph_sort      );
+  tcase_add_test( tcase, test_DependencyGraph_math      );
+  tcase_add_test( tcase, test_DependencyGraph_model     );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
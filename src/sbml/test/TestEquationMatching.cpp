@@ -0,0 +1,168 @@
+/**
+ * @file    TestEquationMatching.cpp
+ * @brief   EquationMatching (OverDeterminedCheck) unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/constraints/OverDeterminedCheck.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+static Model*
+createModel (SBMLDocument& doc, const char** ids, unsigned int numIds,
+             const char** rules, unsigned int numRules)
+{
+  Model* m = doc.createModel();
+  m->setId("m");
+
+  for (unsigned int n = 0; n < numIds; ++n)
+  {
+    Parameter* p = m->createParameter();
+    p->setId(ids[n]);
+    p->setValue(1.0);
+    p->setConstant(false);
+  }
+
+  for (unsigned int n = 0; n < numRules; ++n)
+  {
+    ASTNode* math = SBML_parseL3Formula(rules[n]);
+    m->createAlgebraicRule()->setMath(math);
+    delete math;
+  }
+
+  return m;
+}
+
+
+START_TEST (test_EquationMatching_repeatedVariable)
+{
+  /* 
+   * p0 occurs twice in the first rule; the previous search took this for
+   * a 'flip flopping' match and reported rule_1 as unmatched, although
+   * rule_0 can be matched to p1
+   */
+  const char* ids[] = { "p0", "p1" };
+  const char* rules[] = { "p0 * p0 - p1", "p0 - 2" };
+
+  SBMLDocument doc(2, 4);
+  Model* m = createModel(doc, ids, 2, rules, 2);
+
+  EquationMatching matching;
+  matching.createGraph(*m);
+
+  fail_unless( matching.getNumEquations() == 2 );
+  fail_unless( matching.getNumVariables() == 2 );
+  fail_unless( matching.findMatching().size() == 0 );
+  fail_unless( matching.match_dependency("p1", "rule_0") );
+  fail_unless( matching.match_dependency("p0", "rule_1") );
+}
+END_TEST
+
+
+START_TEST (test_EquationMatching_overdetermined)
+{
+  /* 
+   * x appears alone in two rules, so one of them cannot be matched; the
+   * greedy matching gives x to rule_0 and no augmenting path reaches
+   * rule_1, which is the equation reported
+   */
+  const char* ids[] = { "x", "y", "w" };
+  const char* rules[] = { "x - 1", "x - 2", "y" };
+
+  SBMLDocument doc(2, 4);
+  Model* m = createModel(doc, ids, 3, rules, 3);
+
+  EquationMatching matching;
+  matching.createGraph(*m);
+
+  IdList unmatched = matching.findMatching();
+
+  fail_unless( unmatched.size() == 1 );
+  fail_unless( unmatched.at(0) == "rule_1" );
+  fail_unless( matching.match_dependency("x", "rule_0") );
+  fail_unless( matching.match_dependency("y", "rule_2") );
+}
+END_TEST
+
+
+START_TEST (test_EquationMatching_augmentingPath)
+{
+  /* 
+   * the greedy matching gives x to rule_0 and leaves rule_1 unmatched;
+   * the augmenting path rule_1 - x - rule_0 - y moves rule_0 to y
+   */
+  const char* ids[] = { "x", "y" };
+  const char* rules[] = { "x + y", "x - 1" };
+
+  SBMLDocument doc(2, 4);
+  Model* m = createModel(doc, ids, 2, rules, 2);
+
+  EquationMatching matching;
+  matching.createGraph(*m);
+
+  fail_unless( matching.findMatching().size() == 0 );
+  fail_unless( matching.match_dependency("y", "rule_0") );
+  fail_unless( matching.match_dependency("x", "rule_1") );
+}
+END_TEST
+
+
+Suite *
+create_suite_EquationMatching (void)
+{
+  Suite *suite = suite_create("EquationMatching");
+  TCase *tcase = tcase_create("EquationMatching");
+
+  tcase_add_test( tcase, test_EquationMatching_repeatedVariable );
+  tcase_add_test( tcase, test_EquationMatching_overdetermined   );
+  tcase_add_test( tcase, test_EquationMatching_augmentingPath   );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -0,0 +1,210 @@
+/**
+ * @file    TestIdCensus.cpp
+ * @brief   IdCensus unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+#include <vector>
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/validator/IdCensus.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+START_TEST (test_IdCensus_modelIds)
+{
+  SBMLDocument doc(2, 4);
+  Model* m = doc.createModel();
+  m->setId("m");
+
+  Compartment* c = m->createCompartment();
+  c->setId("c");
+  Species* s = m->createSpecies();
+  s->setId("s");
+  s->setCompartment("c");
+  Parameter* p = m->createParameter();
+  p->setId("c");
+  Reaction* r = m->createReaction();
+  r->setId("r");
+  SpeciesReference* sr = r->createReactant();
+  sr->setId("s");
+  sr->setSpecies("s");
+
+  IdCensus census(m);
+
+  fail_unless( census.getNumEntries(IdCensus::MODEL_IDS) == 6 );
+  fail_unless( census.getId(IdCensus::MODEL_IDS, 0) == "m" );
+  fail_unless( census.getObject(IdCensus::MODEL_IDS, 3) == p );
+  fail_unless( census.getObject(IdCensus::MODEL_IDS, 5) == sr );
+
+  fail_unless( census.getPreviousOwner(IdCensus::MODEL_IDS, 1) == NULL );
+  fail_unless( census.getPreviousOwner(IdCensus::MODEL_IDS, 3) == c );
+  fail_unless( census.getPreviousOwner(IdCensus::MODEL_IDS, 4) == NULL );
+  fail_unless( census.getPreviousOwner(IdCensus::MODEL_IDS, 5) == s );
+
+  fail_unless( census.getFirstOwner(IdCensus::MODEL_IDS, "c") == c );
+  fail_unless( census.getFirstOwner(IdCensus::MODEL_IDS, "x") == NULL );
+
+  std::vector<const SBase*> owners;
+  census.getOwners(IdCensus::MODEL_IDS, "c", owners);
+  fail_unless( owners.size() == 2 );
+  fail_unless( owners[0] == c );
+  fail_unless( owners[1] == p );
+
+  fail_unless( census.getNumEntries(IdCensus::UNIT_IDS) == 0 );
+}
+END_TEST
+
+
+START_TEST (test_IdCensus_localIds)
+{
+  SBMLDocument doc(2, 4);
+  Model* m = doc.createModel();
+
+  KineticLaw* kl1 = m->createReaction()->createKineticLaw();
+  Parameter* k1 = kl1->createParameter();
+  k1->setId("k");
+  kl1->createParameter()->setId("k");
+
+  KineticLaw* kl2 = m->createReaction()->createKineticLaw();
+  kl2->createParameter()->setId("k");
+
+  IdCensus census(m);
+
+  fail_unless( census.getNumEntries(IdCensus::LOCAL_IDS) == 3 );
+  fail_unless( census.getPreviousOwner(IdCensus::LOCAL_IDS, 0) == NULL );
+  fail_unless( census.getPreviousOwner(IdCensus::LOCAL_IDS, 1) == k1 );
+
+  // every kinetic law is a scope of its own
+  fail_unless( census.getPreviousOwner(IdCensus::LOCAL_IDS, 2) == NULL );
+}
+END_TEST
+
+
+START_TEST (test_IdCensus_metaIds)
+{
+  SBMLDocument doc(2, 4);
+  doc.setMetaId("x");
+  Model* m = doc.createModel();
+  m->setMetaId("y");
+  Species* s = m->createSpecies();
+  s->setMetaId("x");
+
+  IdCensus census(m);
+
+  fail_unless( census.getNumEntries(IdCensus::META_IDS) == 3 );
+  fail_unless( census.getObject(IdCensus::META_IDS, 0) == &doc );
+  fail_unless( census.getPreviousOwner(IdCensus::META_IDS, 1) == NULL );
+  fail_unless( census.getPreviousOwner(IdCensus::META_IDS, 2) == &doc );
+}
+END_TEST
+
+
+START_TEST (test_IdCensus_shared)
+{
+  SBMLDocument doc(2, 4);
+  Model* m = doc.createModel();
+
+  fail_unless( IdCensus::getShared(*m) == NULL );
+
+  fail_unless( doc.startIdCensus() == true );
+  fail_unless( IdCensus::getShared(*m) == doc.getIdCensus() );
+  fail_unless( doc.startIdCensus() == false );
+
+  doc.endIdCensus();
+  fail_unless( IdCensus::getShared(*m) == NULL );
+
+  Model lone(2, 4);
+  fail_unless( IdCensus::getShared(lone) == NULL );
+}
+END_TEST
+
+
+START_TEST (test_IdCensus_checkConsistency)
+{
+  SBMLDocument doc(2, 4);
+  Model* m = doc.createModel();
+  m->setId("m");
+
+  Compartment* c = m->createCompartment();
+  c->setId("c");
+  c->setSize(1.0);
+  Parameter* p = m->createParameter();
+  p->setId("c");
+  p->setValue(1.0);
+
+  doc.setConsistencyChecks(LIBSBML_CAT_UNITS_CONSISTENCY, false);
+  doc.setConsistencyChecks(LIBSBML_CAT_MODELING_PRACTICE, false);
+
+  fail_unless( doc.checkConsistency() == 1 );
+  fail_unless( doc.getError(0)->getErrorId() == DuplicateComponentId );
+  fail_unless( doc.getError(0)->getMessage().find(
+               "conflicts with the previously defined <compartment>") 
+               != std::string::npos );
+
+  fail_unless( doc.getIdCensus() == NULL );
+}
+END_TEST
+
+
+Suite *
+create_suite_IdCensus (void)
+{
+  Suite *suite = suite_create("IdCensus");
+  TCase *tcase = tcase_create("IdCensus");
+
+  tcase_add_test( tcase, test_IdCensus_modelIds         );
+  tcase_add_test( tcase, test_IdCensus_localIds         );
+  tcase_add_test( tcase, test_IdCensus_metaIds          );
+  tcase_add_test( tcase, test_IdCensus_shared           );
+  tcase_add_test( tcase, test_IdCensus_checkConsistency );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -0,0 +1,172 @@
+/**
+ * @file    TestIdList.cpp
+ * @brief   IdList unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <vector>
+
+#include <sstream>
+#include <string>
+
+#include <sbml/common/common.h>
+#include <sbml/util/IdList.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+static std::string
+makeId (unsigned int n)
+{
+  std::ostringstream id;
+  id << "id" << n;
+  return id.str();
+}
+
+
+START_TEST (test_IdList_contains)
+{
+  IdList list;
+
+  fail_unless( list.empty() );
+  fail_unless( !list.contains("id0") );
+
+  // grows well past the point where the ids are hashed
+  for (unsigned int i = 0; i < 1000; i++)
+  {
+    list.append(makeId(i));
+    fail_unless( list.contains(makeId(i)) );
+    fail_unless( !list.contains(makeId(i + 1)) );
+  }
+
+  fail_unless( list.size() == 1000 );
+  for (unsigned int i = 0; i < 1000; i++)
+  {
+    fail_unless( list.contains(makeId(i)) );
+  }
+  fail_unless( !list.contains("") );
+  fail_unless( !list.contains("id1000") );
+
+  // the order is kept, repeated ids included
+  list.append("id5");
+  fail_unless( list.size() == 1001 );
+  fail_unless( list.at(5) == "id5" );
+  fail_unless( list.at(1000) == "id5" );
+
+  list.clear();
+  fail_unless( list.empty() );
+  fail_unless( !list.contains("id5") );
+
+  list.append("id5");
+  fail_unless( list.contains("id5") );
+}
+END_TEST
+
+
+START_TEST (test_IdList_removeIdsBefore)
+{
+  IdList list;
+
+  for (unsigned int i = 0; i < 100; i++)
+  {
+    list.append(makeId(i));
+  }
+
+  list.removeIdsBefore("id40");
+  fail_unless( list.size() == 60 );
+  fail_unless( list.at(0) == "id40" );
+  fail_unless( !list.contains("id39") );
+  fail_unless( list.contains("id40") );
+  fail_unless( list.contains("id99") );
+
+  list.removeIdsBefore("id90");
+  fail_unless( list.size() == 10 );
+  fail_unless( !list.contains("id89") );
+  fail_unless( list.contains("id95") );
+
+  for (unsigned int i = 100; i < 120; i++)
+  {
+    list.append(makeId(i));
+  }
+  fail_unless( list.size() == 30 );
+  fail_unless( list.contains("id90") );
+  fail_unless( list.contains("id119") );
+  fail_unless( !list.contains("id0") );
+}
+END_TEST
+
+
+START_TEST (test_IdList_commaSeparated)
+{
+  IdList list("a, b;c\td,,a");
+
+  fail_unless( list.size() == 5 );
+  fail_unless( list.at(0) == "a" );
+  fail_unless( list.at(3) == "d" );
+  fail_unless( list.at(4) == "a" );
+  fail_unless( list.contains("c") );
+  fail_unless( !list.contains("e") );
+
+  IdList copy(list);
+  fail_unless( copy.size() == 5 );
+  fail_unless( copy.contains("d") );
+}
+END_TEST
+
+
+Suite *
+create_suite_IdList (void)
+{
+  Suite *suite = suite_create("IdList");
+  TCase *tcase = tcase_create("IdList");
+
+  tcase_add_test( tcase, test_IdList_contains         );
+  tcase_add_test( tcase, test_IdList_removeIdsBefore  );
+  tcase_add_test( tcase, test_IdList_commaSeparated   );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
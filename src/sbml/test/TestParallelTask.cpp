@@ -0,0 +1,174 @@
+/**
+ * @file    TestParallelTask.cpp
+ * @brief   ParallelTask unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+#include <sbml/util/ParallelTask.h>
+
+#include <vector>
+
+#include <check.h>
+
+#ifdef LIBSBML_USE_THREADS
+#include <thread>
+#endif
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+/*
+ * Counts how often every index is run.
+ */
+class CountTask : public ParallelTask
+{
+public:
+  CountTask(unsigned int numItems) : counts(numItems, 0) {}
+
+  virtual void run(unsigned int index)
+  {
+    counts[index]++;
+  }
+
+  std::vector<unsigned int> counts;
+};
+
+
+#ifdef LIBSBML_USE_THREADS
+
+/*
+ * Records the thread each index runs on.
+ */
+class ThreadTask : public ParallelTask
+{
+public:
+  ThreadTask(unsigned int numItems) : threads(numItems) {}
+
+  virtual void run(unsigned int index)
+  {
+    threads[index] = std::this_thread::get_id();
+  }
+
+  std::vector<std::thread::id> threads;
+};
+
+
+/*
+ * Runs a ThreadTask from every index and records whether all of its items
+ * ran on the thread that started it.
+ */
+class NestedTask : public ParallelTask
+{
+public:
+  NestedTask(unsigned int numItems) : sameThread(numItems, false) {}
+
+  virtual void run(unsigned int index)
+  {
+    ThreadTask inner(8);
+    ParallelTask::execute(inner, 8, 4);
+
+    bool same = true;
+    for (unsigned int n = 0; n < inner.threads.size(); n++)
+    {
+      same = same && inner.threads[n] == std::this_thread::get_id();
+    }
+    sameThread[index] = same;
+  }
+
+  std::vector<bool> sameThread;
+};
+
+#endif
+
+
+START_TEST (test_ParallelTask_execute)
+{
+  CountTask task(100);
+  ParallelTask::execute(task, 100, 4);
+
+  for (unsigned int index = 0; index < 100; index++)
+  {
+    fail_unless( task.counts[index] == 1 );
+  }
+
+  CountTask serial(10);
+  ParallelTask::execute(serial, 10, 1);
+
+  for (unsigned int index = 0; index < 10; index++)
+  {
+    fail_unless( serial.counts[index] == 1 );
+  }
+}
+END_TEST
+
+
+START_TEST (test_ParallelTask_nested)
+{
+#ifdef LIBSBML_USE_THREADS
+  // a task started from a worker is not spread over more threads
+  NestedTask task(4);
+  ParallelTask::execute(task, 4, 4);
+
+  for (unsigned int index = 0; index < 4; index++)
+  {
+    fail_unless( task.sameThread[index] );
+  }
+#endif
+}
+END_TEST
+
+
+Suite *
+create_suite_ParallelTask (void)
+{
+  Suite *suite = suite_create("ParallelTask");
+  TCase *tcase = tcase_create("ParallelTask");
+
+  tcase_add_test( tcase, test_ParallelTask_execute );
+  tcase_add_test( tcase, test_ParallelTask_nested  );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
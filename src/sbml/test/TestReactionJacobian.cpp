@@ -0,0 +1,320 @@
+/**
+ * @file    TestReactionJacobian.cpp
+ * @brief   ReactionJacobian unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <string>
+
+#include <sbml/common/common.h>
+#include <sbml/SBMLTypes.h>
+#include <sbml/ReactionJacobian.h>
+#include <sbml/math/L3Parser.h>
+#include <sbml/math/L3FormulaFormatter.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+static std::string
+toString (const ASTNode* node)
+{
+  std::string formula;
+  SBML_appendFormulaToL3String(formula, node);
+  return formula;
+}
+
+
+static void
+addSpecies (Model* m, const char* id, bool boundary)
+{
+  Species* s = m->createSpecies();
+  s->setId(id);
+  s->setCompartment("C");
+  s->setConstant(false);
+  s->setBoundaryCondition(boundary);
+  s->setHasOnlySubstanceUnits(false);
+}
+
+
+static void
+addParameter (Model* m, const char* id, bool constant)
+{
+  Parameter* p = m->createParameter();
+  p->setId(id);
+  p->setConstant(constant);
+}
+
+
+static Reaction*
+addReaction (Model* m, const char* id, const char* formula)
+{
+  Reaction* r = m->createReaction();
+  r->setId(id);
+  r->setReversible(false);
+  r->setFast(false);
+  if (formula != NULL)
+  {
+    ASTNode* math = SBML_parseL3Formula(formula);
+    r->createKineticLaw()->setMath(math);
+    delete math;
+  }
+  return r;
+}
+
+
+static void
+addSpeciesReference (SpeciesReference* sr, const char* species)
+{
+  sr->setSpecies(species);
+  sr->setStoichiometry(1);
+  sr->setConstant(true);
+}
+
+
+static SBMLDocument*
+createDocument ()
+{
+  SBMLDocument* doc = new SBMLDocument(3, 1);
+  Model* m = doc->createModel();
+
+  Compartment* c = m->createCompartment();
+  c->setId("C");
+  c->setConstant(true);
+
+  addSpecies(m, "S1", false);
+  addSpecies(m, "S2", false);
+  addSpecies(m, "E", true);
+  addParameter(m, "k", true);
+  addParameter(m, "V", true);
+  addParameter(m, "p", false);
+  addParameter(m, "a", false);
+
+  FunctionDefinition* fd = m->createFunctionDefinition();
+  fd->setId("mm");
+  ASTNode* math = SBML_parseL3Formula("lambda(s, vm, km, vm * s / (km + s))");
+  fd->setMath(math);
+  delete math;
+
+  RateRule* rr = m->createRateRule();
+  rr->setVariable("p");
+  math = SBML_parseL3Formula("1");
+  rr->setMath(math);
+  delete math;
+
+  AssignmentRule* ar = m->createAssignmentRule();
+  ar->setVariable("a");
+  math = SBML_parseL3Formula("2 * S2");
+  ar->setMath(math);
+  delete math;
+
+  addSpecies(m, "M", false);
+  addSpecies(m, "X", false);
+
+  Reaction* r = addReaction(m, "R1", "C * k * S1 * E");
+  addSpeciesReference(r->createReactant(), "S1");
+  addSpeciesReference(r->createProduct(), "S2");
+  r->createModifier()->setSpecies("M");
+  r = addReaction(m, "R2", "mm(S2, V, Km)");
+  addSpeciesReference(r->createReactant(), "S2");
+  LocalParameter* lp = r->getKineticLaw()->createLocalParameter();
+  lp->setId("Km");
+  addReaction(m, "R3", "a * p");
+  r = addReaction(m, "R4", "S1 * S2");
+  lp = r->getKineticLaw()->createLocalParameter();
+  lp->setId("S1");
+  addReaction(m, "R5", NULL);
+
+  return doc;
+}
+
+
+START_TEST (test_ReactionJacobian_compute)
+{
+  SBMLDocument* doc = createDocument();
+  ReactionJacobian jacobian;
+
+  fail_unless( jacobian.compute(doc->getModel()) == LIBSBML_OPERATION_SUCCESS );
+
+  fail_unless( jacobian.getNumReactions() == 5 );
+  fail_unless( jacobian.getReactionId(2) == "R3" );
+  fail_unless( jacobian.getReactionIndex("R5") == 4 );
+  fail_unless( jacobian.getReactionIndex("R6") == -1 );
+
+  // E is a boundary species, a is set by an assignment rule, M is only a
+  // modifier and X is in no reaction
+  fail_unless( jacobian.getNumVariables() == 3 );
+  fail_unless( jacobian.getVariableId(0) == "S1" );
+  fail_unless( jacobian.getVariableId(1) == "S2" );
+  fail_unless( jacobian.getVariableId(2) == "p" );
+  fail_unless( jacobian.getVariableIndex("E") == -1 );
+  fail_unless( jacobian.getVariableIndex("a") == -1 );
+  fail_unless( jacobian.getVariableIndex("M") == -1 );
+  fail_unless( jacobian.getVariableIndex("X") == -1 );
+
+  fail_unless( jacobian.getNumEntries() == 5 );
+  fail_unless( toString(jacobian.getDerivative("R1", "S1")) == "C * k * E" );
+  fail_unless( toString(jacobian.getDerivative("R2", "S2")) 
+               == "(V * (Km + S2) - V * S2) / (Km + S2)^2" );
+  fail_unless( toString(jacobian.getDerivative("R3", "S2")) == "2 * p" );
+  fail_unless( toString(jacobian.getDerivative("R3", "p")) == "2 * S2" );
+  fail_unless( toString(jacobian.getDerivative("R4", "S2")) == "S1" );
+
+  // the local parameter S1 hides the species
+  fail_unless( jacobian.getDerivative("R4", "S1") == NULL );
+  fail_unless( jacobian.getDerivative("R1", "S2") == NULL );
+  fail_unless( jacobian.getDerivative("R1", "E") == NULL );
+
+  fail_unless( jacobian.getRowStart(0) == 0 );
+  fail_unless( jacobian.getRowStart(2) == 2 );
+  fail_unless( jacobian.getRowStart(3) == 4 );
+  fail_unless( jacobian.getRowStart(4) == 5 );
+  fail_unless( jacobian.getRowStart(5) == 5 );
+  fail_unless( jacobian.getEntryRow(3) == 2 );
+  fail_unless( jacobian.getEntryColumn(3) == 2 );
+  fail_unless( toString(jacobian.getEntryMath(3)) == "2 * S2" );
+  fail_unless( jacobian.getEntryRow(5) == 5 );
+  fail_unless( jacobian.getEntryMath(5) == NULL );
+
+  jacobian.clear();
+  fail_unless( jacobian.getNumReactions() == 0 );
+  fail_unless( jacobian.getNumEntries() == 0 );
+
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_ReactionJacobian_threads)
+{
+  SBMLDocument* doc = createDocument();
+  Model* m = doc->getModel();
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    std::string id = "X" + std::string(1, (char)('a' + i % 26)) 
+                   + std::string(1, (char)('a' + i / 26));
+    addReaction(m, id.c_str(), "k * S1^2 / (1 + S2 / a) + sin(p)");
+  }
+
+  ReactionJacobian serial;
+  ReactionJacobian parallel;
+  fail_unless( serial.compute(m, 1) == LIBSBML_OPERATION_SUCCESS );
+  fail_unless( parallel.compute(m, 4) == LIBSBML_OPERATION_SUCCESS );
+
+  fail_unless( serial.getNumEntries() == 5 + 50 * 3 );
+  fail_unless( parallel.getNumEntries() == serial.getNumEntries() );
+  for (unsigned int n = 0; n < serial.getNumEntries(); ++n)
+  {
+    fail_unless( parallel.getEntryRow(n) == serial.getEntryRow(n) );
+    fail_unless( parallel.getEntryColumn(n) == serial.getEntryColumn(n) );
+    fail_unless( parallel.getEntryMath(n)->exactlyEqual(*serial.getEntryMath(n)) );
+  }
+
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_ReactionJacobian_failures)
+{
+  SBMLDocument* doc = createDocument();
+  addReaction(doc->getModel(), "R6", "delay(S1, 1) + S2");
+  ReactionJacobian jacobian;
+
+  fail_unless( jacobian.compute(NULL) == LIBSBML_INVALID_OBJECT );
+  fail_unless( jacobian.compute(doc->getModel()) == LIBSBML_OPERATION_FAILED );
+
+  // the entry that cannot be expressed is kept
+  fail_unless( jacobian.getNumEntries() == 7 );
+  fail_unless( jacobian.getRowStart(5) == 5 );
+  fail_unless( jacobian.getEntryColumn(5) == 0 );
+  fail_unless( jacobian.getEntryMath(5) == NULL );
+  fail_unless( toString(jacobian.getDerivative("R6", "S2")) == "1" );
+
+  delete doc;
+}
+END_TEST
+
+
+START_TEST (test_ReactionJacobian_localShadowsSpecies)
+{
+  SBMLDocument* doc = createDocument();
+  Model* m = doc->getModel();
+
+  // S2 is a reactant of R7, but the S2 of its kinetic law is a local
+  // parameter; the species is still a variable for the other reactions
+  Reaction* r = addReaction(m, "R7", "k * S2 * S1");
+  addSpeciesReference(r->createReactant(), "S2");
+  LocalParameter* lp = r->getKineticLaw()->createLocalParameter();
+  lp->setId("S2");
+
+  ReactionJacobian jacobian;
+  fail_unless( jacobian.compute(m) == LIBSBML_OPERATION_SUCCESS );
+
+  fail_unless( jacobian.getVariableIndex("S2") == 1 );
+  fail_unless( jacobian.getDerivative("R7", "S2") == NULL );
+  fail_unless( toString(jacobian.getDerivative("R7", "S1")) == "k * S2" );
+  fail_unless( jacobian.getRowStart(6) - jacobian.getRowStart(5) == 1 );
+  fail_unless( toString(jacobian.getDerivative("R3", "S2")) == "2 * p" );
+
+  delete doc;
+}
+END_TEST
+
+
+Suite *
+create_suite_ReactionJacobian (void)
+{
+  Suite *suite = suite_create("ReactionJacobian");
+  TCase *tcase = tcase_create("ReactionJacobian");
+
+  tcase_add_test( tcase, test_ReactionJacobian_compute  );
+  tcase_add_test( tcase, test_ReactionJacobian_threads  );
+  tcase_add_test( tcase, test_ReactionJacobian_failures );
+  tcase_add_test( tcase, test_ReactionJacobian_localShadowsSpecies );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -80,6 +80,8 @@ Suite *create_suite_Constraint                    (void);
 Suite *create_suite_Constraint_newSetters         (void);
 Suite *create_suite_CompartmentVolumeRule         (void);
 Suite *create_suite_Delay                         (void);
+Suite *create_suite_DependencyGraph               (void);
+Suite *create_suite_EquationMatching              (void);
 Suite *create_suite_Event                         (void);
 Suite *create_suite_L3_Event                      (void);
 Suite *create_suite_Event_newSetters              (void);
@@ -87,6 +89,8 @@ Suite *create_suite_EventAssignment               (void);
 Suite *create_suite_EventAssignment_newSetters    (void);
 Suite *create_suite_FunctionDefinition            (void);
 Suite *create_suite_FunctionDefinition_newSetters (void);
+Suite *create_suite_IdList                       (void);
+Suite *create_suite_IdCensus                     (void);
 Suite *create_suite_InitialAssignment             (void);
 Suite *create_suite_InitialAssignment_newSetters  (void);
 Suite *create_suite_KineticLaw                    (void);
@@ -101,6 +105,7 @@ Suite *create_suite_Parameter                     (void);
 Suite *create_suite_L3_Parameter                  (void);
 Suite *create_suite_L3_LocalParameter             (void);
 Suite *create_suite_Parameter_newSetters          (void);
+Suite *create_suite_ParallelTask                  (void);
 Suite *create_suite_ParameterRule                 (void);
 Suite *create_suite_Priority                      (void);
 Suite *create_suite_RateRule                      (void);
@@ -174,6 +179,9 @@ Suite *create_suite_GetMultipleObjects            (void);
 Suite *create_suite_RemoveFromParent              (void);
 Suite *create_suite_RenameIDs                     (void);
 Suite *create_suite_SBMLTransforms                (void);
+Suite *create_suite_ReactionJacobian              (void);
+Suite *create_suite_BatchEvaluator                (void);
+Suite *create_suite_SBO                           (void);
 
 Suite *create_suite_LevelCompatibility                (void);
 
@@ -243,6 +251,8 @@ main (int argc, char* argv[])
   srunner_add_suite( runner, create_suite_Constraint                    () );
   srunner_add_suite( runner, create_suite_Constraint_newSetters         () );
   srunner_add_suite( runner, create_suite_Delay                         () );
+  srunner_add_suite( runner, create_suite_DependencyGraph               () );
+  srunner_add_suite( runner, create_suite_EquationMatching              () );
   srunner_add_suite( runner, create_suite_Event                         () );
   srunner_add_suite( runner, create_suite_L3_Event                      () );
   srunner_add_suite( runner, create_suite_Event_newSetters              () );
@@ -250,6 +260,8 @@ main (int argc, char* argv[])
   srunner_add_suite( runner, create_suite_EventAssignment_newSetters    () );
   srunner_add_suite( runner, create_suite_FunctionDefinition            () );
   srunner_add_suite( runner, create_suite_FunctionDefinition_newSetters () );
+  srunner_add_suite( runner, create_suite_IdList                       () );
+  srunner_add_suite( runner, create_suite_IdCensus                     () );
   srunner_add_suite( runner, create_suite_InitialAssignment             () );
   srunner_add_suite( runner, create_suite_InitialAssignment_newSetters  () );
   srunner_add_suite( runner, create_suite_KineticLaw                    () );
@@ -264,6 +276,7 @@ main (int argc, char* argv[])
   srunner_add_suite( runner, create_suite_L3_Parameter                  () );
   srunner_add_suite( runner, create_suite_L3_LocalParameter             () );
   srunner_add_suite( runner, create_suite_Parameter_newSetters          () );
+  srunner_add_suite( runner, create_suite_ParallelTask                  () );
   srunner_add_suite( runner, create_suite_ParameterRule                 () );
   srunner_add_suite( runner, create_suite_Priority                      () );
   srunner_add_suite( runner, create_suite_RateRule                      () );
@@ -325,6 +338,9 @@ main (int argc, char* argv[])
   srunner_add_suite( runner, create_suite_SyntaxChecker                 () );
   srunner_add_suite( runner, create_suite_SBMLConstructorException      () );
   srunner_add_suite( runner, create_suite_SBMLTransforms                () );
+  srunner_add_suite( runner, create_suite_ReactionJacobian              () );
+  srunner_add_suite( runner, create_suite_BatchEvaluator                () );
+  srunner_add_suite( runner, create_suite_SBO                           () );
   srunner_add_suite( runner, create_suite_GetMultipleObjects            () );
   srunner_add_suite( runner, create_suite_LevelCompatibility            () );
   srunner_add_suite( runner, create_suite_SBase_IdName                   () );
@@ -153,6 +153,47 @@ START_TEST (test_SBMLError_create)
 }
 END_TEST
 
+START_TEST (test_SBMLError_message)
+{
+  const string text = "The arguments of the MathML logical operators <and>, "
+    "<or>, <xor>, and <not> must have Boolean values.\n";
+
+  SBMLError error(BooleanOpsNeedBooleanArgs, 2, 3, "some details");
+  fail_unless( error.getSeverity() == LIBSBML_SEV_ERROR );
+  fail_unless( error.getMessage() == 
+               text + "Reference: L2V3 Section 3.4.9\n some details\n" );
+
+  SBMLError warning(BooleanOpsNeedBooleanArgs, 2, 1);
+  fail_unless( warning.getSeverity() == LIBSBML_SEV_WARNING );
+  fail_unless( warning.getMessage() == 
+               "[Although SBML Level 2 Version 1 does not explicitly define "
+               "the following as an error, other Levels and/or Versions of "
+               "SBML do.] \n" + text );
+
+  // the message of a copy is the same, whether or not the original was
+  // already formatted, and also when the copy is only an XMLError
+  SBMLError original(BooleanOpsNeedBooleanArgs, 2, 3, "some details");
+  SBMLError copy(original);
+  XMLError sliced(original);
+  SBMLError assigned;
+  assigned = original;
+  SBMLError* clone = original.clone();
+
+  fail_unless( copy.getMessage() == error.getMessage() );
+  fail_unless( sliced.getMessage() == error.getMessage() );
+  fail_unless( assigned.getMessage() == error.getMessage() );
+  fail_unless( clone->getMessage() == error.getMessage() );
+  fail_unless( original.getMessage() == error.getMessage() );
+  delete clone;
+
+  // errors outside the tables keep their details as the message
+  SBMLError other(9999999, 2, 4, "as is", 0, 0, LIBSBML_SEV_INFO, 
+                  LIBSBML_CAT_SBML, "unknownPackage");
+  fail_unless( other.getMessage() == "as is" );
+}
+END_TEST
+
+
 START_TEST(test_SBMLErrorLog_removeAll)
 {
   SBMLErrorLog log;
@@ -173,6 +214,123 @@ START_TEST(test_SBMLErrorLog_removeAll)
 }
 END_TEST
 
+START_TEST(test_SBMLErrorLog_counts)
+{
+  SBMLErrorLog log;
+  SBMLError warning(9999999, 3, 1, "", 0, 0, LIBSBML_SEV_WARNING,
+                    LIBSBML_CAT_UNITS_CONSISTENCY, "unknownPackage");
+  SBMLError error(9999998, 3, 1, "", 0, 0, LIBSBML_SEV_ERROR,
+                  LIBSBML_CAT_SBML, "unknownPackage");
+
+  log.add(warning);
+  log.add(error);
+  log.add(error);
+
+  fail_unless( log.getNumErrors() == 3 );
+  fail_unless( log.getNumLoggedErrors() == 3 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_WARNING) == 1 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) == 0 );
+  fail_unless( log.getNumFailsWithCategory(LIBSBML_CAT_UNITS_CONSISTENCY) == 1 );
+  fail_unless( log.getNumFailsWithCategory(LIBSBML_CAT_SBML) == 2 );
+
+  log.changeErrorSeverity(LIBSBML_SEV_ERROR, LIBSBML_SEV_FATAL);
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 0 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) == 2 );
+
+  log.remove(9999998);
+  fail_unless( log.getNumLoggedErrors() == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) == 1 );
+  fail_unless( log.getNumFailsWithCategory(LIBSBML_CAT_SBML) == 1 );
+
+  SBMLErrorLog copy(log);
+  fail_unless( copy.getNumErrors() == 2 );
+  fail_unless( copy.getNumFailsWithSeverity(LIBSBML_SEV_WARNING) == 1 );
+  fail_unless( copy.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) == 1 );
+
+  log.clearLog();
+  fail_unless( log.getNumLoggedErrors() == 0 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_WARNING) == 0 );
+  fail_unless( log.getNumFailsWithCategory(LIBSBML_CAT_UNITS_CONSISTENCY) == 0 );
+
+  copy = log;
+  fail_unless( copy.getNumErrors() == 0 );
+  fail_unless( copy.getNumFailsWithSeverity(LIBSBML_SEV_FATAL) == 0 );
+}
+END_TEST
+
+
+START_TEST(test_SBMLErrorLog_maxStoredErrors)
+{
+  SBMLErrorLog log;
+  SBMLError error(9999998, 3, 1, "", 0, 0, LIBSBML_SEV_ERROR,
+                  LIBSBML_CAT_SBML, "unknownPackage");
+
+  fail_unless( log.getMaxStoredErrors() == 0 );
+  log.setMaxStoredErrors(2);
+  fail_unless( log.getMaxStoredErrors() == 2 );
+
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    log.add(error);
+  }
+
+  fail_unless( log.getNumErrors() == 2 );
+  fail_unless( log.getNumLoggedErrors() == 5 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 5 );
+  fail_unless( log.getNumFailsWithCategory(LIBSBML_CAT_SBML) == 5 );
+
+  SBMLErrorLog copy(log);
+  fail_unless( copy.getMaxStoredErrors() == 2 );
+  fail_unless( copy.getNumErrors() == 2 );
+  fail_unless( copy.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 5 );
+
+  log.setMaxStoredErrors(0);
+  log.add(error);
+  fail_unless( log.getNumErrors() == 3 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 6 );
+}
+END_TEST
+
+
+static void
+collectErrorIds (const XMLError* error, void* userdata)
+{
+  static_cast<std::vector<unsigned int>*>(userdata)->push_back(
+    error->getErrorId());
+}
+
+
+START_TEST(test_SBMLErrorLog_callback)
+{
+  SBMLErrorLog log;
+  std::vector<unsigned int> ids;
+  SBMLError error(9999998, 3, 1, "", 0, 0, LIBSBML_SEV_ERROR,
+                  LIBSBML_CAT_SBML, "unknownPackage");
+  SBMLError warning(9999999, 3, 1, "", 0, 0, LIBSBML_SEV_WARNING,
+                    LIBSBML_CAT_SBML, "unknownPackage");
+
+  log.setErrorCallback(collectErrorIds, &ids);
+  log.add(error);
+  log.add(warning);
+
+  fail_unless( ids.size() == 2 );
+  fail_unless( ids[0] == 9999998 );
+  fail_unless( ids[1] == 9999999 );
+  fail_unless( log.getNumErrors() == 0 );
+  fail_unless( log.getNumLoggedErrors() == 2 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_ERROR) == 1 );
+  fail_unless( log.getNumFailsWithSeverity(LIBSBML_SEV_WARNING) == 1 );
+
+  log.setErrorCallback(NULL);
+  log.add(error);
+  fail_unless( ids.size() == 2 );
+  fail_unless( log.getNumErrors() == 1 );
+  fail_unless( log.getNumLoggedErrors() == 3 );
+}
+END_TEST
+
+
 Suite *
 create_suite_SBMLError (void)
 {
@@ -180,7 +338,11 @@ create_suite_SBMLError (void)
   TCase *tcase = tcase_create("SBMLError");
 
   tcase_add_test( tcase, test_SBMLError_create  );
+  tcase_add_test( tcase, test_SBMLError_message  );
   tcase_add_test( tcase, test_SBMLErrorLog_removeAll  );
+  tcase_add_test( tcase, test_SBMLErrorLog_counts  );
+  tcase_add_test( tcase, test_SBMLErrorLog_maxStoredErrors  );
+  tcase_add_test( tcase, test_SBMLErrorLog_callback  );
   suite_add_tcase(suite, tcase);
 
   return suite;
@@ -0,0 +1,155 @@
+/**
+ * @file    TestSBO.cpp
+ * @brief   SBO unit tests
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <vector>
+
+#include <sbml/common/common.h>
+#include <sbml/SBO.h>
+#include <sbml/util/ParallelTask.h>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+BEGIN_C_DECLS
+
+
+START_TEST (test_SBO_branches)
+{
+  // direct and indirect parents
+  fail_unless(  SBO::isQuantitativeParameter(9)   );
+  fail_unless(  SBO::isQuantitativeParameter(16)  );
+  fail_unless(  SBO::isKineticConstant(16)        );
+  fail_unless(  SBO::isKineticConstant(186)       );
+  fail_unless( !SBO::isKineticConstant(2)         );
+
+  // a term with two parents
+  fail_unless(  SBO::isQuantitativeParameter(27) );
+  fail_unless( !SBO::isKineticConstant(27)       );
+
+  fail_unless(  SBO::isParticipantRole(671)      );
+  fail_unless(  SBO::isModifier(671)             );
+  fail_unless( !SBO::isReactant(671)             );
+
+  fail_unless(  SBO::isMaterialEntity(247)       );
+  fail_unless(  SBO::isPhysicalParticipant(285)  );
+  fail_unless(  SBO::isEvent(630)                );
+  fail_unless( !SBO::isEvent(9)                  );
+
+  fail_unless(  SBO::isObselete(5)               );
+  fail_unless( !SBO::isObselete(9)               );
+
+  // a term is not its own child, but the helpers accept the branch itself
+  fail_unless(  SBO::isMathematicalExpression(64) );
+  fail_unless(  SBO::isModellingFramework(4)      );
+
+  // terms that are not in the table
+  fail_unless( !SBO::isQuantitativeParameter(0)       );
+  fail_unless( !SBO::isQuantitativeParameter(9999999) );
+  fail_unless( !SBO::isQuantitativeParameter(1000)    );
+
+  fail_unless( SBO::getParentBranch(16)  == 545 );
+  fail_unless( SBO::getParentBranch(671) == 3   );
+  fail_unless( SBO::getParentBranch(5)   == 1000 );
+}
+END_TEST
+
+
+/*
+ * Queries the ancestry from several threads at once.
+ */
+class SBOQueryTask : public ParallelTask
+{
+public:
+  SBOQueryTask(unsigned int numItems) : results(numItems, 0) {}
+
+  virtual void run(unsigned int index)
+  {
+    unsigned int count = 0;
+    for (unsigned int term = 0; term < 700; term++)
+    {
+      if (SBO::isQuantitativeParameter(term)) count++;
+      if (SBO::isParticipantRole(term)) count += 1000;
+    }
+    results[index] = count;
+  }
+
+  std::vector<unsigned int> results;
+};
+
+
+START_TEST (test_SBO_threads)
+{
+  SBOQueryTask task(16);
+  ParallelTask::execute(task, 16, 4);
+
+  unsigned int count = 0;
+  for (unsigned int term = 0; term < 700; term++)
+  {
+    if (SBO::isQuantitativeParameter(term)) count++;
+    if (SBO::isParticipantRole(term)) count += 1000;
+  }
+
+  fail_unless( count > 1000 );
+  for (unsigned int i = 0; i < 16; i++)
+  {
+    fail_unless( task.results[i] == count );
+  }
+}
+END_TEST
+
+
+Suite *
+create_suite_SBO (void)
+{
+  Suite *suite = suite_create("SBO");
+  TCase *tcase = tcase_create("SBO");
+
+  tcase_add_test( tcase, test_SBO_branches );
+  tcase_add_test( tcase, test_SBO_threads  );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
@@ -0,0 +1,348 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DimensionVector.cpp
+ * @brief   Compact representation of the dimensions of a unit
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ */
+
+#include <cmath>
+
+#include <sbml/units/DimensionVector.h>
+#include <sbml/Unit.h>
+#include <sbml/UnitDefinition.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+#ifdef __cplusplus
+
+DimensionVector::DimensionVector ()
+  : mEmpty(true)
+{
+  for (unsigned int i = 0; i < NUM_BASE_UNITS; ++i)
+  {
+    mExponents[i] = 0;
+  }
+}
+
+
+bool
+DimensionVector::setUnitDefinition (const UnitDefinition* ud)
+{
+  *this = DimensionVector();
+
+  if (ud == NULL) return false;
+
+  for (unsigned int n = 0; n < ud->getNumUnits(); ++n)
+  {
+    if (!addUnit(ud->getUnit(n))) return false;
+  }
+
+  return true;
+}
+
+
+/*
+ * The decompositions below must match those of Unit::convertToSI().
+ */
+bool
+DimensionVector::addUnit (UnitKind_t kind, int e)
+{
+  mEmpty = false;
+
+  switch (kind)
+  {
+  case UNIT_KIND_AVOGADRO:
+  case UNIT_KIND_DIMENSIONLESS:
+  case UNIT_KIND_RADIAN:
+  case UNIT_KIND_STERADIAN:
+    break;
+
+  case UNIT_KIND_AMPERE:
+    mExponents[AMPERE] += e;
+    break;
+
+  case UNIT_KIND_BECQUEREL:
+  case UNIT_KIND_HERTZ:
+    mExponents[SECOND] -= e;
+    break;
+
+  case UNIT_KIND_CANDELA:
+  case UNIT_KIND_LUMEN:
+    mExponents[CANDELA] += e;
+    break;
+
+  case UNIT_KIND_COULOMB:
+    mExponents[AMPERE] += e;
+    mExponents[SECOND] += e;
+    break;
+
+  case UNIT_KIND_FARAD:
+    mExponents[AMPERE] += 2 * e;
+    mExponents[KILOGRAM] -= e;
+    mExponents[METRE] -= 2 * e;
+    mExponents[SECOND] += 4 * e;
+    break;
+
+  case UNIT_KIND_GRAM:
+  case UNIT_KIND_KILOGRAM:
+    mExponents[KILOGRAM] += e;
+    break;
+
+  case UNIT_KIND_GRAY:
+  case UNIT_KIND_SIEVERT:
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_HENRY:
+    mExponents[AMPERE] -= 2 * e;
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_ITEM:
+    mExponents[ITEM] += e;
+    break;
+
+  case UNIT_KIND_JOULE:
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_KATAL:
+    mExponents[MOLE] += e;
+    mExponents[SECOND] -= e;
+    break;
+
+  case UNIT_KIND_KELVIN:
+    mExponents[KELVIN] += e;
+    break;
+
+  case UNIT_KIND_LITER:
+  case UNIT_KIND_LITRE:
+    mExponents[METRE] += 3 * e;
+    break;
+
+  case UNIT_KIND_LUX:
+    mExponents[CANDELA] += e;
+    mExponents[METRE] -= 2 * e;
+    break;
+
+  case UNIT_KIND_METER:
+  case UNIT_KIND_METRE:
+    mExponents[METRE] += e;
+    break;
+
+  case UNIT_KIND_MOLE:
+    mExponents[MOLE] += e;
+    break;
+
+  case UNIT_KIND_NEWTON:
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_OHM:
+    mExponents[AMPERE] -= 2 * e;
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 3 * e;
+    break;
+
+  case UNIT_KIND_PASCAL:
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] -= e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_SECOND:
+    mExponents[SECOND] += e;
+    break;
+
+  case UNIT_KIND_SIEMENS:
+    mExponents[AMPERE] += 2 * e;
+    mExponents[KILOGRAM] -= e;
+    mExponents[METRE] -= 2 * e;
+    mExponents[SECOND] += 3 * e;
+    break;
+
+  case UNIT_KIND_TESLA:
+    mExponents[AMPERE] -= e;
+    mExponents[KILOGRAM] += e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  case UNIT_KIND_VOLT:
+    mExponents[AMPERE] -= e;
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 3 * e;
+    break;
+
+  case UNIT_KIND_WATT:
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 3 * e;
+    break;
+
+  case UNIT_KIND_WEBER:
+    mExponents[AMPERE] -= e;
+    mExponents[KILOGRAM] += e;
+    mExponents[METRE] += 2 * e;
+    mExponents[SECOND] -= 2 * e;
+    break;
+
+  // celsius converts to kelvin with an offset, which changes how
+  // UnitDefinition::simplify() and Unit::areEquivalent() treat it
+  case UNIT_KIND_CELSIUS:
+  case UNIT_KIND_INVALID:
+  default:
+    return false;
+  }
+
+  return true;
+}
+
+
+bool
+DimensionVector::addUnit (const Unit* unit)
+{
+  if (unit == NULL) return false;
+
+  double exponent;
+
+  if (unit->isUnitChecking())
+  {
+    exponent = unit->getExponentUnitChecking();
+  }
+  else
+  {
+    // getExponent() is what Unit::convertToSI() uses; it only agrees
+    // with the actual value for integers
+    exponent = unit->getExponentAsDouble();
+    if (exponent != unit->getExponent()) return false;
+  }
+
+  if (floor(exponent) != exponent || fabs(exponent) > 1e6) return false;
+
+  return addUnit(unit->getKind(), static_cast<int>(exponent));
+}
+
+
+int
+DimensionVector::getExponent (UnitKind_t kind) const
+{
+  switch (kind)
+  {
+  case UNIT_KIND_AMPERE:   return mExponents[AMPERE];
+  case UNIT_KIND_CANDELA:  return mExponents[CANDELA];
+  case UNIT_KIND_ITEM:     return mExponents[ITEM];
+  case UNIT_KIND_KELVIN:   return mExponents[KELVIN];
+  case UNIT_KIND_KILOGRAM: return mExponents[KILOGRAM];
+  case UNIT_KIND_METRE:    return mExponents[METRE];
+  case UNIT_KIND_MOLE:     return mExponents[MOLE];
+  case UNIT_KIND_SECOND:   return mExponents[SECOND];
+  default:                 return 0;
+  }
+}
+
+
+bool
+DimensionVector::isEmpty () const
+{
+  return mEmpty;
+}
+
+
+bool
+DimensionVector::isDimensionless () const
+{
+  for (unsigned int i = 0; i < NUM_BASE_UNITS; ++i)
+  {
+    if (mExponents[i] != 0) return false;
+  }
+
+  return true;
+}
+
+
+/*
+ * UnitDefinition::convertToSI() leaves a definition without units empty,
+ * and turns any other definition whose units cancel into a single
+ * dimensionless unit; so only two empty vectors, or two non-empty vectors
+ * with the same exponents, are equivalent.
+ */
+bool
+DimensionVector::isEquivalentTo (const DimensionVector& other) const
+{
+  if (mEmpty || other.mEmpty) return mEmpty == other.mEmpty;
+
+  for (unsigned int i = 0; i < NUM_BASE_UNITS; ++i)
+  {
+    if (mExponents[i] != other.mExponents[i]) return false;
+  }
+
+  return true;
+}
+
+
+bool
+DimensionVector::areEquivalent (const UnitDefinition* ud1,
+                                const UnitDefinition* ud2, bool& equivalent)
+{
+  DimensionVector v1, v2;
+
+  if (!v1.setUnitDefinition(ud1) || !v2.setUnitDefinition(ud2))
+  {
+    return false;
+  }
+
+  equivalent = v1.isEquivalentTo(v2);
+  return true;
+}
+
+#endif  /* __cplusplus */
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
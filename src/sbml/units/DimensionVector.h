@@ -0,0 +1,173 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DimensionVector.h
+ * @brief   Compact representation of the dimensions of a unit
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class DimensionVector
+ * @sbmlbrief{core} The dimensions of a unit as a vector of exponents.
+ *
+ * A DimensionVector records, for each of the base units that
+ * UnitDefinition::convertToSI() reduces units to (ampere, candela, item,
+ * kelvin, kilogram, metre, mole and second), the exponent with which it
+ * occurs.  Two UnitDefinition objects are equivalent exactly when their
+ * vectors are equal, so equivalence can be decided without creating,
+ * converting, simplifying and reordering copies of the definitions.
+ *
+ * Only units that have an exact integer representation are supported:
+ * setUnitDefinition() fails for definitions that contain Celsius (whose
+ * conversion introduces an offset), invalid kinds or non-integer
+ * exponents, and callers must then fall back to the UnitDefinition
+ * methods.
+ */
+
+#ifndef DimensionVector_h
+#define DimensionVector_h
+
+
+#ifdef __cplusplus
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+#include <sbml/UnitKind.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class Unit;
+class UnitDefinition;
+
+class LIBSBML_EXTERN DimensionVector
+{
+public:
+
+  /**
+   * Creates a DimensionVector for a UnitDefinition without any units.
+   */
+  DimensionVector ();
+
+
+  /**
+   * Sets this vector to the dimensions of the given UnitDefinition.
+   *
+   * @return @c true on success, @c false if @p ud is @c NULL or contains a
+   * unit that cannot be represented (in which case the contents of this
+   * vector are unspecified).
+   */
+  bool setUnitDefinition (const UnitDefinition* ud);
+
+
+  /**
+   * Multiplies this vector by @p kind raised to @p exponent.
+   *
+   * @return @c true on success, @c false if @p kind cannot be represented.
+   */
+  bool addUnit (UnitKind_t kind, int exponent);
+
+
+  /**
+   * Multiplies this vector by the given Unit.
+   *
+   * @return @c true on success, @c false if @p unit cannot be represented.
+   */
+  bool addUnit (const Unit* unit);
+
+
+  /**
+   * Returns the exponent of the given base unit kind (one of ampere,
+   * candela, item, kelvin, kilogram, metre, mole or second), or 0 for any
+   * other kind.
+   */
+  int getExponent (UnitKind_t kind) const;
+
+
+  /**
+   * Returns @c true if no units have been added to this vector.
+   */
+  bool isEmpty () const;
+
+
+  /**
+   * Returns @c true if all exponents of this vector are zero, that is,
+   * the units it was built from reduce to dimensionless.
+   */
+  bool isDimensionless () const;
+
+
+  /**
+   * Returns @c true if this vector and @p other describe equivalent units,
+   * with the same meaning as UnitDefinition::areEquivalent().
+   */
+  bool isEquivalentTo (const DimensionVector& other) const;
+
+
+  /**
+   * Returns @c true if both UnitDefinition objects can be represented and
+   * sets @p equivalent to the result of UnitDefinition::areEquivalent()
+   * for them.  Returns @c false, leaving @p equivalent unchanged, if
+   * either of them cannot be represented.
+   */
+  static bool areEquivalent (const UnitDefinition* ud1,
+                             const UnitDefinition* ud2, bool& equivalent);
+
+
+private:
+
+  enum BaseUnit
+  {
+    AMPERE
+  , CANDELA
+  , ITEM
+  , KELVIN
+  , KILOGRAM
+  , METRE
+  , MOLE
+  , SECOND
+  , NUM_BASE_UNITS
+  };
+
+  int  mExponents[NUM_BASE_UNITS];
+  bool mEmpty;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* DimensionVector_h */
+/** @endcond */
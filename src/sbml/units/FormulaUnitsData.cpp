@@ -60,6 +60,7 @@ FormulaUnitsData::FormulaUnitsData()
   mCanIgnoreUndeclaredUnits = true;
   mContainsInconsistency = false;
   mTypeOfElement = SBML_UNKNOWN;
+  mInputSignature = "";
   mUnitDefinition = 
     new UnitDefinition(SBMLDocument::getDefaultLevel(), 
                        SBMLDocument::getDefaultVersion());
@@ -88,6 +89,7 @@ FormulaUnitsData::FormulaUnitsData(const FormulaUnitsData& orig)
   , mEventTimeUnitDefinition ( NULL )
   , mSpeciesExtentUnitDefinition ( NULL )
   , mSpeciesSubstanceUnitDefinition ( NULL )
+  , mInputSignature ( orig.mInputSignature )
 {
   if (orig.mUnitDefinition) 
   {
@@ -133,6 +135,7 @@ FormulaUnitsData& FormulaUnitsData::operator=(const FormulaUnitsData& rhs)
     mCanIgnoreUndeclaredUnits = rhs.mCanIgnoreUndeclaredUnits;
     mContainsInconsistency = rhs.mContainsInconsistency;
     mTypeOfElement = rhs.mTypeOfElement;
+    mInputSignature = rhs.mInputSignature;
 
     delete mUnitDefinition;
     if (rhs.mUnitDefinition) 
@@ -550,6 +553,22 @@ FormulaUnitsData::setSpeciesSubstanceUnitDefinition(UnitDefinition * ud)
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+const std::string&
+FormulaUnitsData::getInputSignature() const
+{
+  return mInputSignature;
+}
+
+
+void
+FormulaUnitsData::setInputSignature(const std::string& signature)
+{
+  mInputSignature = signature;
+}
+/** @endcond */
+
+
 /* NOT YET NECESSARY
 
 LIBSBML_EXTERN
@@ -415,6 +415,26 @@ public:
   void setSpeciesExtentUnitDefinition(UnitDefinition * ud);
   void setSpeciesSubstanceUnitDefinition(UnitDefinition * ud);
 
+
+  /** @cond doxygenLibsbmlInternal */
+  /**
+   * Get the signature of the inputs this FormulaUnitsData was computed
+   * from; empty if it was not derived from math.
+   *
+   * Model::populateListFormulaUnitsData() compares the signature with that
+   * of the current inputs to decide whether the data can be reused rather
+   * than recomputed.
+   */
+  const std::string& getInputSignature() const;
+
+
+  /**
+   * Set the signature of the inputs this FormulaUnitsData was computed
+   * from.
+   */
+  void setInputSignature(const std::string& signature);
+  /** @endcond */
+
 protected:
   /** @cond doxygenLibsbmlInternal */
     std::string mUnitReferenceId;
@@ -431,6 +451,8 @@ protected:
     UnitDefinition * mSpeciesExtentUnitDefinition;
     UnitDefinition * mSpeciesSubstanceUnitDefinition;
 
+    std::string mInputSignature;
+
   /** @endcond */
 };
 
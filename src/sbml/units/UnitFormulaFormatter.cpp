@@ -44,6 +44,7 @@
 #include <sbml/units/UnitFormulaFormatter.h>
 #include <sbml/SBMLTransforms.h>
 #include <sbml/SBMLDocument.h>
+#include <sbml/extension/SBMLExtensionRegistry.h>
 #include <sbml/util/util.h>
 #include <sbml/util/IdList.h>
 
@@ -251,18 +252,18 @@ UnitFormulaFormatter::getUnitDefinition(const ASTNode * node,
     case AST_UNKNOWN:
     default:
       bool found = false;
-      if (node->getNumPlugins() == 0)
+      // prefer the package enabled on the document of the model
+      SBMLExtensionRegistry& registry = SBMLExtensionRegistry::getInstance();
+      const ASTBasePlugin* baseplugin = registry.getASTPluginFor(
+        node->getType(), (model != NULL) ? model->getSBMLNamespaces() : NULL);
+      if (baseplugin == NULL)
       {
-        ((ASTNode*)(node))->loadASTPlugins(NULL);
+        baseplugin = registry.getASTPluginFor(node->getType());
       }
-      for (unsigned int p = 0; p < node->getNumPlugins(); p++)
+      if (baseplugin != NULL)
       {
-        const ASTBasePlugin* baseplugin = node->getPlugin(p);
-        if (baseplugin->defines(node->getType()))
-        {
-          found = true;
-          ud = baseplugin->getUnitDefinitionFromPackage(this, node, inKL, reactNo);
-        }
+        found = true;
+        ud = baseplugin->getUnitDefinitionFromPackage(this, node, inKL, reactNo);
       }
       if (!found)
       {
@@ -592,9 +593,10 @@ UnitFormulaFormatter::getUnitDefinitionFromPower(const ASTNode * node,
     exponentNode->isReal() == true ||
     exponentUD->isVariantOfDimensionless())
   {
-    SBMLTransforms::mapComponentValues(model);
-    exponentValue = SBMLTransforms::evaluateASTNode(node->getRightChild(), model);
-    SBMLTransforms::clearComponentValues();
+    SBMLTransforms::IdValueMap values;
+    SBMLTransforms::getComponentValuesForModel(model, values);
+    exponentValue = SBMLTransforms::evaluateASTNode(node->getRightChild(), 
+                                                    values, model);
 
     for (unsigned int n = 0; n < variableUD->getNumUnits(); n++)
     {
@@ -749,9 +751,9 @@ UnitFormulaFormatter::getUnitDefinitionFromRoot(const ASTNode * node,
 
           if (tempUD2->isVariantOfDimensionless())
           {
-            SBMLTransforms::mapComponentValues(model);
-            double value = SBMLTransforms::evaluateASTNode(child);
-            SBMLTransforms::clearComponentValues();
+            SBMLTransforms::IdValueMap values;
+            SBMLTransforms::getComponentValuesForModel(model, values);
+            double value = SBMLTransforms::evaluateASTNode(child, values);
             if (!util_isNaN(value))
             {
               double doubleExponent =
@@ -2716,8 +2718,10 @@ UnitFormulaFormatter::inverseFunctionOnUnits(UnitDefinition* expectedUD,
       if (mathUD == NULL || mathUD->getNumUnits() == 0 
         || mathUD->isVariantOfDimensionless() == true)
       {
-        SBMLTransforms::mapComponentValues(this->model);
-        double exp = 1.0/(SBMLTransforms::evaluateASTNode(math, this->model));
+        SBMLTransforms::IdValueMap values;
+        SBMLTransforms::getComponentValuesForModel(this->model, values);
+        double exp = 1.0/(SBMLTransforms::evaluateASTNode(math, values, 
+                                                          this->model));
         resolvedUD = new UnitDefinition(*expectedUD);
         for (unsigned int i = 0; i < resolvedUD->getNumUnits(); i++)
         {
@@ -0,0 +1,343 @@
+/**
+ * \file    TestDimensionVector.cpp
+ * \brief   DimensionVector unit tests
+ * \author  SBMLTeam
+ * 
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/common.h>
+
+#include <sbml/SBMLTypes.h>
+#include <sbml/units/DimensionVector.h>
+#include <sbml/units/UnitFormulaFormatter.h>
+
+#include <vector>
+
+#include <check.h>
+
+LIBSBML_CPP_NAMESPACE_USE
+
+extern char *TestDataDirectory;
+
+BEGIN_C_DECLS
+
+/*
+ * UnitDefinition::areEquivalent() as it was before it used DimensionVector.
+ */
+static bool
+referenceAreEquivalent (const UnitDefinition* ud1, const UnitDefinition* ud2)
+{
+  UnitDefinition* si1 = UnitDefinition::convertToSI(ud1);
+  UnitDefinition* si2 = UnitDefinition::convertToSI(ud2);
+  bool equivalent = false;
+
+  if (si1->getNumUnits() == si2->getNumUnits())
+  {
+    UnitDefinition::reorder(si1);
+    UnitDefinition::reorder(si2);
+
+    unsigned int n = 0;
+    while (n < si1->getNumUnits() 
+      && Unit::areEquivalent(si1->getUnit(n), si2->getUnit(n)))
+    {
+      ++n;
+    }
+    equivalent = (n == si1->getNumUnits());
+  }
+
+  delete si1;
+  delete si2;
+  return equivalent;
+}
+
+
+/*
+ * Creates a UnitDefinition with the given units, at the first of
+ * L3V2, L2V4 and L1V2 that accepts all the kinds.
+ */
+static UnitDefinition*
+createUnitDefinition (UnitKind_t kind1, int exp1, 
+                      UnitKind_t kind2 = UNIT_KIND_INVALID, int exp2 = 1)
+{
+  static const unsigned int levels[3][2] = { {3, 2}, {2, 4}, {1, 2} };
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    UnitDefinition* ud = new UnitDefinition(levels[i][0], levels[i][1]);
+    Unit* u = ud->createUnit();
+    u->initDefaults();
+    bool ok = (u->setKind(kind1) == LIBSBML_OPERATION_SUCCESS);
+    u->setExponent(exp1);
+
+    if (ok && kind2 != UNIT_KIND_INVALID)
+    {
+      u = ud->createUnit();
+      u->initDefaults();
+      ok = (u->setKind(kind2) == LIBSBML_OPERATION_SUCCESS);
+      u->setExponent(exp2);
+    }
+
+    if (ok) return ud;
+    delete ud;
+  }
+
+  return NULL;
+}
+
+
+START_TEST(test_DimensionVector_create)
+{
+  DimensionVector v;
+
+  fail_unless( v.isEmpty() );
+  fail_unless( v.isDimensionless() );
+  fail_unless( v.getExponent(UNIT_KIND_METRE) == 0 );
+
+  fail_unless( v.addUnit(UNIT_KIND_NEWTON, 2) );
+  fail_unless( !v.isEmpty() );
+  fail_unless( !v.isDimensionless() );
+  fail_unless( v.getExponent(UNIT_KIND_KILOGRAM) == 2 );
+  fail_unless( v.getExponent(UNIT_KIND_METRE) == 2 );
+  fail_unless( v.getExponent(UNIT_KIND_SECOND) == -4 );
+  fail_unless( v.getExponent(UNIT_KIND_NEWTON) == 0 );
+
+  fail_unless( v.addUnit(UNIT_KIND_LITRE, 1) );
+  fail_unless( v.getExponent(UNIT_KIND_METRE) == 5 );
+
+  fail_unless( !v.addUnit(UNIT_KIND_CELSIUS, 1) );
+  fail_unless( !v.addUnit(UNIT_KIND_INVALID, 1) );
+
+  DimensionVector w;
+  fail_unless( w.addUnit(UNIT_KIND_DIMENSIONLESS, 1) );
+  fail_unless( !w.isEmpty() );
+  fail_unless( w.isDimensionless() );
+  fail_unless( !w.isEquivalentTo(DimensionVector()) );
+  fail_unless( DimensionVector().isEquivalentTo(DimensionVector()) );
+}
+END_TEST
+
+
+START_TEST(test_DimensionVector_unsupported)
+{
+  bool equivalent = true;
+  UnitDefinition* celsius = createUnitDefinition(UNIT_KIND_CELSIUS, 1);
+  UnitDefinition* kelvin = createUnitDefinition(UNIT_KIND_KELVIN, 1);
+
+  fail_unless( celsius != NULL );
+  fail_unless( !DimensionVector::areEquivalent(celsius, kelvin, equivalent) );
+  fail_unless( equivalent == true );
+  fail_unless( UnitDefinition::areEquivalent(celsius, kelvin) 
+               == referenceAreEquivalent(celsius, kelvin) );
+
+  UnitDefinition* root = new UnitDefinition(3, 2);
+  Unit* u = root->createUnit();
+  u->initDefaults();
+  u->setKind(UNIT_KIND_METRE);
+  u->setExponentUnitChecking(0.5);
+
+  UnitDefinition* metre = createUnitDefinition(UNIT_KIND_METRE, 1);
+  fail_unless( !DimensionVector::areEquivalent(root, metre, equivalent) );
+  fail_unless( !UnitDefinition::areEquivalent(root, metre) );
+  fail_unless( UnitDefinition::areEquivalent(root, root) );
+
+  u->setExponentUnitChecking(2.0);
+  fail_unless( DimensionVector::areEquivalent(root, metre, equivalent) );
+  fail_unless( equivalent == false );
+
+  fail_unless( !DimensionVector::areEquivalent(NULL, metre, equivalent) );
+
+  delete celsius;
+  delete kelvin;
+  delete root;
+  delete metre;
+}
+END_TEST
+
+
+START_TEST(test_DimensionVector_matchesConvertToSI)
+{
+  static const int exponents[] = { -2, 0, 1, 3 };
+  std::vector<UnitDefinition*> defs;
+
+  defs.push_back(new UnitDefinition(3, 2));
+
+  for (int k = 0; k < UNIT_KIND_INVALID; ++k)
+  {
+    if (k == UNIT_KIND_CELSIUS) continue;
+
+    for (unsigned int e = 0; e < 4; ++e)
+    {
+      UnitDefinition* ud = createUnitDefinition((UnitKind_t)k, exponents[e]);
+      if (ud != NULL) defs.push_back(ud);
+    }
+  }
+
+  // a few combinations that cancel or build up derived units
+  defs.push_back(createUnitDefinition(UNIT_KIND_METRE, 1, UNIT_KIND_METRE, -1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_METRE, 2, UNIT_KIND_DIMENSIONLESS, 1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_HERTZ, 1, UNIT_KIND_SECOND, 1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_JOULE, 1, UNIT_KIND_SECOND, -1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_MOLE, 1, UNIT_KIND_LITRE, -1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_AMPERE, 1, UNIT_KIND_SECOND, 1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_RADIAN, 1, UNIT_KIND_STERADIAN, -1));
+  defs.push_back(createUnitDefinition(UNIT_KIND_ITEM, 1, UNIT_KIND_MOLE, -1));
+
+  for (unsigned int i = 0; i < defs.size(); ++i)
+  {
+    fail_unless( defs[i] != NULL );
+
+    for (unsigned int j = 0; j < defs.size(); ++j)
+    {
+      bool equivalent = false;
+      fail_unless( DimensionVector::areEquivalent(defs[i], defs[j], equivalent) );
+      fail_unless( equivalent == referenceAreEquivalent(defs[i], defs[j]) );
+    }
+  }
+
+  for (unsigned int i = 0; i < defs.size(); ++i)
+  {
+    delete defs[i];
+  }
+}
+END_TEST
+
+
+/*
+ * Adds the units the formatter derives for node and all its descendants.
+ */
+static void
+addFormulaUnits (UnitFormulaFormatter& uff, const ASTNode* node, bool inKL,
+                 int reactNo, std::vector<UnitDefinition*>& defs)
+{
+  if (node == NULL) return;
+
+  uff.resetFlags();
+  UnitDefinition* ud = uff.getUnitDefinition(node, inKL, reactNo);
+  if (ud != NULL) defs.push_back(ud);
+
+  for (unsigned int n = 0; n < node->getNumChildren(); ++n)
+  {
+    addFormulaUnits(uff, node->getChild(n), inKL, reactNo, defs);
+  }
+}
+
+
+START_TEST(test_DimensionVector_formulaUnits)
+{
+  static const char* files[] = { "calculateUnits.xml", "components.xml",
+    "formula.xml", "L3components.xml", "rules.xml", "unitsTest.xml" };
+
+  for (unsigned int f = 0; f < 6; ++f)
+  {
+    char *filename = safe_strcat(TestDataDirectory, files[f]);
+    SBMLDocument* d = readSBML(filename);
+    safe_free(filename);
+
+    const Model* m = d->getModel();
+    fail_unless( m != NULL );
+
+    UnitFormulaFormatter uff(m);
+    std::vector<UnitDefinition*> defs;
+
+    for (unsigned int n = 0; n < m->getNumRules(); ++n)
+    {
+      addFormulaUnits(uff, m->getRule(n)->getMath(), false, -1, defs);
+    }
+    for (unsigned int n = 0; n < m->getNumInitialAssignments(); ++n)
+    {
+      addFormulaUnits(uff, m->getInitialAssignment(n)->getMath(), 
+                      false, -1, defs);
+    }
+    for (unsigned int n = 0; n < m->getNumReactions(); ++n)
+    {
+      const Reaction* r = m->getReaction(n);
+      if (r->isSetKineticLaw())
+      {
+        addFormulaUnits(uff, r->getKineticLaw()->getMath(), true, (int)n, defs);
+      }
+    }
+    for (unsigned int n = 0; n < m->getNumEvents(); ++n)
+    {
+      const Event* e = m->getEvent(n);
+      for (unsigned int i = 0; i < e->getNumEventAssignments(); ++i)
+      {
+        addFormulaUnits(uff, e->getEventAssignment(i)->getMath(), 
+                        false, -1, defs);
+      }
+    }
+
+    fail_unless( defs.size() > 0 );
+
+    // the derived units include unit-checking and non-integer exponents,
+    // multipliers and scales; areEquivalent() must agree with convertToSI
+    for (unsigned int i = 0; i < defs.size(); ++i)
+    {
+      for (unsigned int j = 0; j < defs.size(); ++j)
+      {
+        fail_unless( UnitDefinition::areEquivalent(defs[i], defs[j]) 
+                     == referenceAreEquivalent(defs[i], defs[j]) );
+      }
+    }
+
+    for (unsigned int i = 0; i < defs.size(); ++i)
+    {
+      delete defs[i];
+    }
+    delete d;
+  }
+}
+END_TEST
+
+
+Suite *
+create_suite_DimensionVector (void)
+{
+  Suite *suite = suite_create("DimensionVector");
+  TCase *tcase = tcase_create("DimensionVector");
+
+  tcase_add_test( tcase, test_DimensionVector_create );
+  tcase_add_test( tcase, test_DimensionVector_unsupported );
+  tcase_add_test( tcase, test_DimensionVector_matchesConvertToSI );
+  tcase_add_test( tcase, test_DimensionVector_formulaUnits );
+
+  suite_add_tcase(suite, tcase);
+
+  return suite;
+}
+
+
+END_C_DECLS
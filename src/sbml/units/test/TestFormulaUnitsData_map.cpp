@@ -748,6 +748,121 @@ END_TEST
 
 
 
+START_TEST (test_FormulaUnitsDataMap_repopulate_unchanged)
+{
+  unsigned int num = m->getNumFormulaUnitsData();
+  FormulaUnitsData *ia = m->getFormulaUnitsData("z2", SBML_INITIAL_ASSIGNMENT);
+  FormulaUnitsData *rule = m->getFormulaUnitsData("x", SBML_ASSIGNMENT_RULE);
+  FormulaUnitsData *kl = m->getFormulaUnitsData("R", SBML_KINETIC_LAW);
+  FormulaUnitsData *delay = m->getFormulaUnitsData("event_0", SBML_EVENT);
+
+  m->populateListFormulaUnitsData();
+
+  fail_unless(m->getNumFormulaUnitsData() == num);
+
+  /* nothing changed, so the data computed from math is kept */
+  fail_unless(m->getFormulaUnitsData("z2", SBML_INITIAL_ASSIGNMENT) == ia);
+  fail_unless(m->getFormulaUnitsData("x", SBML_ASSIGNMENT_RULE) == rule);
+  fail_unless(m->getFormulaUnitsData("R", SBML_KINETIC_LAW) == kl);
+  fail_unless(m->getFormulaUnitsData("event_0", SBML_EVENT) == delay);
+
+  fail_unless(ia->getUnitDefinition()->getNumUnits() == 1);
+  fail_unless(ia->getUnitDefinition()->getUnit(0)->getKind() == UNIT_KIND_MOLE);
+  fail_unless(ia->getUnitDefinition()->getUnit(0)->getScale() == -2);
+  fail_unless(delay->getEventTimeUnitDefinition()->getNumUnits() == 1);
+}
+END_TEST
+
+
+START_TEST (test_FormulaUnitsDataMap_repopulate_mathChanged)
+{
+  FormulaUnitsData *rule = m->getFormulaUnitsData("x", SBML_ASSIGNMENT_RULE);
+
+  ASTNode *math = SBML_parseFormula("k1");
+  m->getInitialAssignment("z2")->setMath(math);
+  delete math;
+
+  m->populateListFormulaUnitsData();
+
+  const FormulaUnitsData *fud =
+                   m->getFormulaUnitsData("z2", SBML_INITIAL_ASSIGNMENT);
+
+  fail_unless(fud->getUnitDefinition()->getNumUnits() == 2);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getKind() == UNIT_KIND_METRE);
+  fail_unless(fud->getUnitDefinition()->getUnit(1)->getKind() == UNIT_KIND_SECOND);
+  fail_unless(fud->getUnitDefinition()->getUnit(1)->getExponent() == -1);
+
+  fail_unless(m->getFormulaUnitsData("x", SBML_ASSIGNMENT_RULE) == rule);
+}
+END_TEST
+
+
+START_TEST (test_FormulaUnitsDataMap_repopulate_unitsChanged)
+{
+  const FormulaUnitsData *fud =
+               m->getFormulaUnitsData("k2event_0", SBML_EVENT_ASSIGNMENT);
+
+  fail_unless(fud->getUnitDefinition()->getNumUnits() == 2);
+
+  m->getParameter("k1")->setUnits("second");
+
+  m->populateListFormulaUnitsData();
+
+  /* the math did not change but the units of k1 it refers to did */
+  fud = m->getFormulaUnitsData("k2event_0", SBML_EVENT_ASSIGNMENT);
+
+  fail_unless(fud->getUnitDefinition()->getNumUnits() == 1);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getKind() == UNIT_KIND_SECOND);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getExponent() == 1);
+}
+END_TEST
+
+
+START_TEST (test_FormulaUnitsDataMap_repopulate_valueChanged)
+{
+  SBMLDocument doc(2, 4);
+  Model *model = doc.createModel();
+
+  Parameter *p = model->createParameter();
+  p->setId("x");
+  p->setUnits("metre");
+  p->setValue(1.0);
+  p = model->createParameter();
+  p->setId("n");
+  p->setUnits("dimensionless");
+  p->setValue(2.0);
+  p = model->createParameter();
+  p->setId("y");
+  p->setConstant(false);
+
+  AssignmentRule *ar = model->createAssignmentRule();
+  ar->setVariable("y");
+  ASTNode *math = SBML_parseFormula("pow(x, n)");
+  ar->setMath(math);
+  delete math;
+
+  model->populateListFormulaUnitsData();
+
+  const FormulaUnitsData *fud =
+                  model->getFormulaUnitsData("y", SBML_ASSIGNMENT_RULE);
+  fail_unless(fud->getUnitDefinition()->getNumUnits() == 1);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getKind() == UNIT_KIND_METRE);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getExponentUnitChecking() == 2);
+
+  /* the math and the units did not change, but the exponent did */
+  model->getParameter("n")->setValue(3.0);
+
+  model->populateListFormulaUnitsData();
+
+  fud = model->getFormulaUnitsData("y", SBML_ASSIGNMENT_RULE);
+  fail_unless(fud->getUnitDefinition()->getNumUnits() == 1);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getKind() == UNIT_KIND_METRE);
+  fail_unless(fud->getUnitDefinition()->getUnit(0)->getExponentUnitChecking() == 3);
+}
+END_TEST
+
+
+
 Suite *
 create_suite_FormulaUnitsDataMap (void)
 {
@@ -769,6 +884,10 @@ create_suite_FormulaUnitsDataMap (void)
   tcase_add_test(tcase, test_FormulaUnitsDataMap_getevent );
   tcase_add_test(tcase, test_FormulaUnitsDataMap_getById );
   tcase_add_test(tcase, test_FormulaUnitsDataMap_setters );
+  tcase_add_test(tcase, test_FormulaUnitsDataMap_repopulate_unchanged );
+  tcase_add_test(tcase, test_FormulaUnitsDataMap_repopulate_mathChanged );
+  tcase_add_test(tcase, test_FormulaUnitsDataMap_repopulate_unitsChanged );
+  tcase_add_test(tcase, test_FormulaUnitsDataMap_repopulate_valueChanged );
   suite_add_tcase(suite, tcase);
 
   return suite;
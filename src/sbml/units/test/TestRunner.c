@@ -72,6 +72,7 @@ Suite *create_suite_FormulaUnitsDataMap(void);
 Suite *create_suite_DerivedUnitDefinition (void);
 Suite *create_suite_CalcUnitDefinition (void);
 Suite *create_suite_DerivedUnitDefinitionUndefined (void);
+Suite *create_suite_DimensionVector (void);
 
 END_C_DECLS
 /**
@@ -131,6 +132,7 @@ main (void)
   srunner_add_suite( runner, create_suite_CalcUnitDefinition() );
   srunner_add_suite( runner, create_suite_UnitFormulaFormatter3() );
   srunner_add_suite( runner, create_suite_DerivedUnitDefinitionUndefined() );
+  srunner_add_suite( runner, create_suite_DimensionVector() );
   
 
 
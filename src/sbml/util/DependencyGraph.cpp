@@ -0,0 +1,446 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DependencyGraph.cpp
+ * @brief   Graph of the ids of a model and the ids their math refers to
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/util/DependencyGraph.h>
+#include <sbml/math/ASTNode.h>
+#include <sbml/Model.h>
+
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+static const unsigned int UNVISITED = (unsigned int)(-1);
+
+
+DependencyGraph::DependencyGraph()
+  : mAdjacencyValid(false)
+{
+}
+
+
+unsigned int
+DependencyGraph::addNode(const std::string& id)
+{
+  map<string, unsigned int>::iterator it = mIndex.find(id);
+  if (it != mIndex.end())
+  {
+    return it->second;
+  }
+
+  unsigned int node = (unsigned int)mIds.size();
+  mIndex.insert(make_pair(id, node));
+  mIds.push_back(id);
+  mAdjacencyValid = false;
+  return node;
+}
+
+
+int
+DependencyGraph::getNodeIndex(const std::string& id) const
+{
+  map<string, unsigned int>::const_iterator it = mIndex.find(id);
+  return (it == mIndex.end()) ? -1 : (int)it->second;
+}
+
+
+const std::string&
+DependencyGraph::getNodeId(unsigned int node) const
+{
+  return mIds[node];
+}
+
+
+unsigned int
+DependencyGraph::getNumNodes() const
+{
+  return (unsigned int)mIds.size();
+}
+
+
+void
+DependencyGraph::addEdge(unsigned int from, unsigned int to)
+{
+  mEdgeSources.push_back(from);
+  mEdgeTargets.push_back(to);
+  mAdjacencyValid = false;
+}
+
+
+void
+DependencyGraph::addMath(unsigned int from, const ASTNode* math,
+                         const std::set<std::string>* ignore)
+{
+  if (math == NULL) return;
+
+  if ((math->isName() || math->getType() == AST_FUNCTION)
+    && math->getName() != NULL)
+  {
+    string name = math->getName();
+    if (ignore == NULL || ignore->find(name) == ignore->end())
+    {
+      addEdge(from, addNode(name));
+    }
+  }
+
+  for (unsigned int i = 0; i < math->getNumChildren(); i++)
+  {
+    addMath(from, math->getChild(i), ignore);
+  }
+}
+
+
+void
+DependencyGraph::addModel(const Model& model)
+{
+  unsigned int n, i;
+
+  // whether the first rule for each variable is an assignment rule
+  map<string, bool> firstIsAssignment;
+  for (n = 0; n < model.getNumRules(); n++)
+  {
+    const Rule* rule = model.getRule(n);
+    firstIsAssignment.insert(make_pair(rule->getVariable(), rule->isAssignment()));
+  }
+
+  for (n = 0; n < model.getNumRules(); n++)
+  {
+    const Rule* rule = model.getRule(n);
+    if (rule->isAssignment() && rule->isSetMath()
+      && firstIsAssignment[rule->getVariable()])
+    {
+      addMath(addNode(rule->getVariable()), rule->getMath());
+    }
+  }
+
+  for (n = 0; n < model.getNumInitialAssignments(); n++)
+  {
+    const InitialAssignment* ia = model.getInitialAssignment(n);
+    if (ia->isSetMath())
+    {
+      addMath(addNode(ia->getSymbol()), ia->getMath());
+    }
+  }
+
+  for (n = 0; n < model.getNumReactions(); n++)
+  {
+    const Reaction* reaction = model.getReaction(n);
+    const KineticLaw* kl = reaction->getKineticLaw();
+    if (kl == NULL || !kl->isSetMath()) continue;
+
+    // the local parameters shadow the ids of the model
+    set<string> parameters;
+    for (i = 0; i < kl->getNumParameters(); i++)
+    {
+      parameters.insert(kl->getParameter(i)->getId());
+    }
+
+    addMath(addNode(reaction->getId()), kl->getMath(), &parameters);
+  }
+}
+
+
+unsigned int
+DependencyGraph::getNumEdges(unsigned int node) const
+{
+  buildAdjacency();
+  return mOffsets[node + 1] - mOffsets[node];
+}
+
+
+unsigned int
+DependencyGraph::getEdge(unsigned int node, unsigned int n) const
+{
+  buildAdjacency();
+  return mTargets[mOffsets[node] + n];
+}
+
+
+/*
+ * Tarjan's algorithm, with an explicit stack instead of recursion so that
+ * long chains of rules cannot overflow the call stack.
+ */
+unsigned int
+DependencyGraph::getStronglyConnectedComponents(
+                                    std::vector<unsigned int>& component) const
+{
+  buildAdjacency();
+
+  const unsigned int numNodes = getNumNodes();
+  vector<unsigned int> index(numNodes, UNVISITED);
+  vector<unsigned int> lowlink(numNodes, 0);
+  vector<bool> onStack(numNodes, false);
+  vector<unsigned int> stack;
+  // the nodes being visited, with the position of their next edge
+  vector< pair<unsigned int, unsigned int> > visiting;
+
+  unsigned int nextIndex = 0;
+  unsigned int numComponents = 0;
+  component.assign(numNodes, 0);
+
+  for (unsigned int root = 0; root < numNodes; root++)
+  {
+    if (index[root] != UNVISITED) continue;
+
+    index[root] = lowlink[root] = nextIndex++;
+    stack.push_back(root);
+    onStack[root] = true;
+    visiting.push_back(make_pair(root, mOffsets[root]));
+
+    while (!visiting.empty())
+    {
+      unsigned int node = visiting.back().first;
+      unsigned int edge = visiting.back().second;
+
+      if (edge < mOffsets[node + 1])
+      {
+        visiting.back().second++;
+        unsigned int target = mTargets[edge];
+        if (index[target] == UNVISITED)
+        {
+          index[target] = lowlink[target] = nextIndex++;
+          stack.push_back(target);
+          onStack[target] = true;
+          visiting.push_back(make_pair(target, mOffsets[target]));
+        }
+        else if (onStack[target] && index[target] < lowlink[node])
+        {
+          lowlink[node] = index[target];
+        }
+        continue;
+      }
+
+      visiting.pop_back();
+      if (!visiting.empty())
+      {
+        unsigned int parent = visiting.back().first;
+        if (lowlink[node] < lowlink[parent])
+        {
+          lowlink[parent] = lowlink[node];
+        }
+      }
+
+      if (lowlink[node] == index[node])
+      {
+        unsigned int member;
+        do
+        {
+          member = stack.back();
+          stack.pop_back();
+          onStack[member] = false;
+          component[member] = numComponents;
+        }
+        while (member != node);
+        numComponents++;
+      }
+    }
+  }
+
+  return numComponents;
+}
+
+
+unsigned int
+DependencyGraph::getNodesInCycles(std::vector<bool>& inCycle) const
+{
+  vector<unsigned int> component;
+  unsigned int numComponents = getStronglyConnectedComponents(component);
+
+  const unsigned int numNodes = getNumNodes();
+  vector<unsigned int> size(numComponents, 0);
+  unsigned int node;
+  for (node = 0; node < numNodes; node++)
+  {
+    size[component[node]]++;
+  }
+
+  unsigned int numInCycles = 0;
+  inCycle.assign(numNodes, false);
+  for (node = 0; node < numNodes; node++)
+  {
+    bool cyclic = size[component[node]] > 1;
+    for (unsigned int e = mOffsets[node]; !cyclic && e < mOffsets[node + 1]; e++)
+    {
+      cyclic = (mTargets[e] == node);
+    }
+
+    if (cyclic)
+    {
+      inCycle[node] = true;
+      numInCycles++;
+    }
+  }
+
+  return numInCycles;
+}
+
+
+/*
+ * Depth-first search from the nodes in list order, placing every node
+ * after the nodes it depends on; nodes are placed when their search
+ * finishes, so unrelated nodes keep their relative order.
+ */
+bool
+DependencyGraph::sortTopologically(const std::vector<unsigned int>& nodes,
+                                   std::vector<unsigned int>& order) const
+{
+  buildAdjacency();
+
+  const unsigned int numNodes = getNumNodes();
+  const unsigned int size = (unsigned int)nodes.size();
+  unsigned int p;
+
+  vector<unsigned int> position(numNodes, UNVISITED);
+  for (p = 0; p < size; p++)
+  {
+    position[nodes[p]] = p;
+  }
+
+  // 0: not yet searched, 1: being searched, 2: done
+  vector<unsigned char> state(size, 0);
+  // the positions that are part of or depend on a cycle
+  vector<bool> blocked(size, false);
+  // the positions being searched, with the next edge to follow
+  vector< pair<unsigned int, unsigned int> > visiting;
+
+  order.clear();
+  order.reserve(size);
+  for (unsigned int root = 0; root < size; root++)
+  {
+    if (state[root] != 0) continue;
+
+    state[root] = 1;
+    visiting.push_back(make_pair(root, mOffsets[nodes[root]]));
+
+    while (!visiting.empty())
+    {
+      p = visiting.back().first;
+      unsigned int edge = visiting.back().second;
+
+      if (edge < mOffsets[nodes[p] + 1])
+      {
+        visiting.back().second++;
+        unsigned int q = position[mTargets[edge]];
+        if (q == UNVISITED || q == p) continue;
+
+        if (state[q] == 0)
+        {
+          state[q] = 1;
+          visiting.push_back(make_pair(q, mOffsets[nodes[q]]));
+        }
+        else if (state[q] == 1 || blocked[q])
+        {
+          blocked[p] = true;
+        }
+        continue;
+      }
+
+      visiting.pop_back();
+      state[p] = 2;
+      if (!blocked[p])
+      {
+        order.push_back(p);
+      }
+      else if (!visiting.empty())
+      {
+        blocked[visiting.back().first] = true;
+      }
+    }
+  }
+
+  if (order.size() == size)
+  {
+    return true;
+  }
+
+  for (p = 0; p < size; p++)
+  {
+    if (blocked[p])
+    {
+      order.push_back(p);
+    }
+  }
+
+  return false;
+}
+
+
+/*
+ * Sorts the edges by their source with a counting sort, which keeps the
+ * edges of every node in the order they were added.
+ */
+void
+DependencyGraph::buildAdjacency() const
+{
+  if (mAdjacencyValid) return;
+
+  const unsigned int numNodes = getNumNodes();
+  const size_t numEdges = mEdgeSources.size();
+  size_t e;
+
+  mOffsets.assign(numNodes + 1, 0);
+  for (e = 0; e < numEdges; e++)
+  {
+    mOffsets[mEdgeSources[e] + 1]++;
+  }
+
+  for (unsigned int node = 0; node < numNodes; node++)
+  {
+    mOffsets[node + 1] += mOffsets[node];
+  }
+
+  mTargets.resize(numEdges);
+  vector<unsigned int> fill(mOffsets.begin(), mOffsets.end() - 1);
+  for (e = 0; e < numEdges; e++)
+  {
+    mTargets[fill[mEdgeSources[e]]++] = mEdgeTargets[e];
+  }
+
+  mAdjacencyValid = true;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,218 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    DependencyGraph.h
+ * @brief   Graph of the ids of a model and the ids their math refers to
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class DependencyGraph
+ * @sbmlbrief{core} Dependencies between the ids of a model.
+ *
+ * Every id added to a DependencyGraph is mapped to a dense node index
+ * (0, 1, 2, ...), in the order the ids are first seen.  An edge from node
+ * @c a to node @c b records that the value of @c a depends on @c b, for
+ * example because an AssignmentRule for @c a mentions @c b in its math.
+ * The edges of a node keep the order in which they were added, including
+ * repeated edges, so that clients can report problems in document order.
+ *
+ * Once all edges have been added the graph is queried through its
+ * compressed (CSR) adjacency: the strongly connected components are found
+ * with Tarjan's algorithm and nodes are sorted by a depth-first search, both
+ * in time linear in the size of the graph.  Adding further edges after a
+ * query is allowed; the adjacency is then rebuilt on the next query.
+ */
+
+#ifndef DependencyGraph_h
+#define DependencyGraph_h
+
+
+#ifdef __cplusplus
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+
+#include <cstddef>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class ASTNode;
+class Model;
+
+class LIBSBML_EXTERN DependencyGraph
+{
+public:
+
+  /**
+   * Creates a new, empty DependencyGraph.
+   */
+  DependencyGraph();
+
+
+  /**
+   * Adds the given id to this graph, unless it is already there, and
+   * returns the index of its node.
+   */
+  unsigned int addNode(const std::string& id);
+
+
+  /**
+   * Returns the index of the node of the given id, or -1 if the id is not
+   * part of this graph.
+   */
+  int getNodeIndex(const std::string& id) const;
+
+
+  /**
+   * Returns the id of the node with the given index.
+   */
+  const std::string& getNodeId(unsigned int node) const;
+
+
+  /**
+   * Returns the number of nodes of this graph.
+   */
+  unsigned int getNumNodes() const;
+
+
+  /**
+   * Adds an edge recording that node @p from depends on node @p to.
+   */
+  void addEdge(unsigned int from, unsigned int to);
+
+
+  /**
+   * Adds an edge from node @p from to the node of every name and every
+   * called function in @p math, in document order.  Names listed in
+   * @p ignore (such as the arguments of a FunctionDefinition) are skipped.
+   */
+  void addMath(unsigned int from, const ASTNode* math,
+               const std::set<std::string>* ignore = NULL);
+
+
+  /**
+   * Adds the dependencies of the given model: the variable of every
+   * AssignmentRule, the symbol of every InitialAssignment and the id of
+   * every Reaction with a KineticLaw depend on the names in their math.
+   * The names of local parameters are skipped in kinetic laws.  Rules are
+   * only added for variables whose first rule, the one returned by
+   * Model::getRule(variable), is an AssignmentRule.  Event assignments are
+   * not added, as they are not evaluated along with the other math and
+   * would make up cycles that are not there.
+   */
+  void addModel(const Model& model);
+
+
+  /**
+   * Returns the number of edges leaving the given node.
+   */
+  unsigned int getNumEdges(unsigned int node) const;
+
+
+  /**
+   * Returns the target of the nth edge leaving the given node.
+   */
+  unsigned int getEdge(unsigned int node, unsigned int n) const;
+
+
+  /**
+   * Computes the strongly connected components of this graph.  On return
+   * @p component holds the component of every node; components are
+   * numbered so that a component only depends on components with a
+   * smaller number.
+   *
+   * @return the number of components.
+   */
+  unsigned int getStronglyConnectedComponents(
+                                   std::vector<unsigned int>& component) const;
+
+
+  /**
+   * Marks the nodes that are part of a cycle, that is, nodes that can reach
+   * themselves by following one or more edges.
+   *
+   * @return the number of such nodes.
+   */
+  unsigned int getNodesInCycles(std::vector<bool>& inCycle) const;
+
+
+  /**
+   * Sorts the given nodes so that every node comes after the nodes of the
+   * list it depends on.  Edges to nodes outside the list and edges of a
+   * node to itself are ignored.  Nodes are taken in the order of @p nodes
+   * and the nodes each one depends on are placed just before it, so a node
+   * is only moved ahead when a node before it depends on it, and a list
+   * that is already sorted is left unchanged.
+   *
+   * On return @p order holds positions into @p nodes.  If the dependencies
+   * form a cycle the nodes that cannot be sorted are appended in their
+   * original order.
+   *
+   * @return @c true if all nodes could be sorted, @c false if there is a
+   * cycle.
+   */
+  bool sortTopologically(const std::vector<unsigned int>& nodes,
+                         std::vector<unsigned int>& order) const;
+
+
+private:
+
+  void buildAdjacency() const;
+
+  std::map<std::string, unsigned int> mIndex;
+  std::vector<std::string> mIds;
+
+  std::vector<unsigned int> mEdgeSources;
+  std::vector<unsigned int> mEdgeTargets;
+
+  // compressed adjacency: the edges of node n are
+  // mTargets[mOffsets[n]] .. mTargets[mOffsets[n + 1] - 1]
+  mutable std::vector<unsigned int> mOffsets;
+  mutable std::vector<unsigned int> mTargets;
+  mutable bool mAdjacencyValid;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* DependencyGraph_h */
+/** @endcond */
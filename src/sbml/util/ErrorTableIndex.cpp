@@ -0,0 +1,64 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ErrorTableIndex.cpp
+ * @brief   Finds the entry of an error code in a table of errors
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/util/ErrorTableIndex.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+unsigned int
+ErrorTableIndex::find(unsigned int code, unsigned int notFound) const
+{
+  std::vector< std::pair<unsigned int, unsigned int> >::const_iterator it =
+    std::lower_bound(mCodes.begin(), mCodes.end(), 
+                     std::make_pair(code, 0u), lessCode);
+
+  if (it == mCodes.end() || it->first != code)
+  {
+    return notFound;
+  }
+  return it->second;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
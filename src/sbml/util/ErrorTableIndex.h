@@ -0,0 +1,120 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ErrorTableIndex.h
+ * @brief   Finds the entry of an error code in a table of errors
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ErrorTableIndex
+ * @sbmlbrief{core} Index of the codes in a table of error descriptions.
+ *
+ * The tables describing the errors of libSBML (errorTable in
+ * SBMLErrorTable.h and the error tables of the packages) are arrays of
+ * entries with a field <code>code</code>, mostly but not always in
+ * ascending order.  An ErrorTableIndex keeps the pairs (code, position)
+ * sorted by code, so that the position of an error code is found by a
+ * binary search instead of a scan of the whole table.
+ *
+ * An index is meant to be a function-local static that is built on first
+ * use; after that it is only read, so it can be used from several threads
+ * at once.
+ */
+
+#ifndef ErrorTableIndex_h
+#define ErrorTableIndex_h
+
+
+#ifdef __cplusplus
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN ErrorTableIndex
+{
+public:
+
+  /**
+   * Creates the index of the given table.
+   */
+  template <typename Entry, size_t N>
+  explicit ErrorTableIndex(const Entry (&table)[N])
+  {
+    mCodes.reserve(N);
+    for (size_t i = 0; i < N; i++)
+    {
+      mCodes.push_back(std::make_pair((unsigned int)table[i].code,
+                                      (unsigned int)i));
+    }
+
+    // a stable sort keeps the first of several entries with the same code
+    // first, which is the one a scan of the table would find
+    std::stable_sort(mCodes.begin(), mCodes.end(), lessCode);
+  }
+
+
+  /**
+   * Returns the position of the first entry of the table with the given
+   * code, or @p notFound if there is none.
+   */
+  unsigned int find(unsigned int code, unsigned int notFound = 0) const;
+
+
+private:
+
+  static bool lessCode(const std::pair<unsigned int, unsigned int>& a,
+                       const std::pair<unsigned int, unsigned int>& b)
+  {
+    return a.first < b.first;
+  }
+
+  std::vector< std::pair<unsigned int, unsigned int> > mCodes;
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ErrorTableIndex_h */
+/** @endcond */
@@ -50,6 +50,29 @@ using namespace std;
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
+/*
+ * Lists shorter than this are searched by a scan, which is faster than
+ * hashing for a handful of ids.
+ */
+static const size_t INDEX_THRESHOLD = 16;
+
+
+/*
+ * FNV-1a hash of the characters of an id.
+ */
+static size_t
+hashId (const std::string& id)
+{
+  unsigned int hash = 2166136261u;
+  for (size_t i = 0; i < id.size(); i++)
+  {
+    hash ^= (unsigned char)id[i];
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+
 IdList::IdList()
 {
 }
@@ -94,6 +117,21 @@ void
 IdList::append (const std::string& id) 
 { 
   mIds.push_back(id); 
+
+  if (mIds.size() < INDEX_THRESHOLD)
+  {
+    return;
+  }
+
+  // keep the table at most half full
+  if (mIds.size() * 2 > mIndex.size())
+  {
+    rebuildIndex(mIndex.empty() ? 4 * INDEX_THRESHOLD : 2 * mIndex.size());
+  }
+  else
+  {
+    addToIndex((unsigned int)(mIds.size() - 1));
+  }
 }
 
 
@@ -108,7 +146,7 @@ void
 IdList::clear() 
 { 
   mIds.clear(); 
-
+  mIndex.clear();
 }
 
 
@@ -147,9 +185,24 @@ IdList::empty() const
 bool
 IdList::contains (const std::string& id) const
 {
-  IdList::const_iterator end = mIds.end();
+  if (mIndex.empty())
+  {
+    IdList::const_iterator end = mIds.end();
   
-  return std::find(mIds.begin(), end, id) != end;
+    return std::find(mIds.begin(), end, id) != end;
+  }
+
+  size_t mask = mIndex.size() - 1;
+  for (size_t slot = hashId(id) & mask; mIndex[slot] != 0; 
+       slot = (slot + 1) & mask)
+  {
+    if (mIds[mIndex[slot] - 1] == id)
+    {
+      return true;
+    }
+  }
+
+  return false;
 }
 
 
@@ -163,7 +216,58 @@ IdList::removeIdsBefore (const std::string& id)
   IdList::iterator pos = std::find(mIds.begin(), end, id);
 
 
-  if (pos != end) mIds.erase(mIds.begin(), pos);
+  if (pos != end) 
+  {
+    mIds.erase(mIds.begin(), pos);
+
+    // the positions have changed
+    mIndex.clear();
+    if (mIds.size() >= INDEX_THRESHOLD)
+    {
+      size_t numSlots = 4 * INDEX_THRESHOLD;
+      while (numSlots < 2 * mIds.size()) numSlots *= 2;
+      rebuildIndex(numSlots);
+    }
+  }
+}
+
+
+/*
+ * Recreates the hash table with the given number of slots, which must be
+ * a power of two.
+ */
+void
+IdList::rebuildIndex (size_t numSlots)
+{
+  mIndex.assign(numSlots, 0);
+  for (unsigned int i = 0; i < mIds.size(); i++)
+  {
+    addToIndex(i);
+  }
+}
+
+
+/*
+ * Adds the id at the given position to the hash table, unless the same id
+ * is already there.
+ */
+void
+IdList::addToIndex (unsigned int position)
+{
+  const std::string& id = mIds[position];
+  size_t mask = mIndex.size() - 1;
+  size_t slot = hashId(id) & mask;
+
+  while (mIndex[slot] != 0)
+  {
+    if (mIds[mIndex[slot] - 1] == id)
+    {
+      return;
+    }
+    slot = (slot + 1) & mask;
+  }
+
+  mIndex[slot] = position + 1;
 }
 
 LIBSBML_CPP_NAMESPACE_END
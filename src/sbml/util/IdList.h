@@ -43,6 +43,10 @@
  *
  * @class IdList
  * @sbmlbrief{core} Maintains a list of SIds.
+ *
+ * The ids are kept in the order they were appended.  Once the list holds
+ * more than a few ids it also keeps a hash table of their positions, so
+ * that contains() does not have to compare the id against every entry.
  */
 
 #ifndef IdList_h
@@ -124,7 +128,15 @@ public:
 
 private:
 
+  void rebuildIndex(size_t numSlots);
+
+  void addToIndex(unsigned int position);
+
   std::vector<std::string> mIds;
+
+  // open addressing hash table holding (position in mIds + 1) of every
+  // distinct id, or 0 for an empty slot; only used for longer lists
+  std::vector<unsigned int> mIndex;
 };
 
 LIBSBML_CPP_NAMESPACE_END
@@ -0,0 +1,206 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ParallelTask.cpp
+ * @brief   Runs a number of independent work items, using threads if available
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *  
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA 
+ *  
+ * Copyright (C) 2002-2005 jointly by the following organizations: 
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ * 
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/common/libsbml-config.h>
+#include <sbml/util/ParallelTask.h>
+
+#ifdef LIBSBML_USE_THREADS
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+#endif
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+/*
+ * The default set with setMaxThreads(); 0 means use the hardware threads.
+ * It may be changed while other threads are running tasks.
+ */
+#ifdef LIBSBML_USE_THREADS
+static std::atomic<unsigned int> sMaxThreads(0);
+#else
+static unsigned int sMaxThreads = 0;
+#endif
+
+#ifdef LIBSBML_USE_THREADS
+
+/*
+ * Whether this thread is running items of a task spread over several
+ * threads; tasks started from there are not spread again.
+ */
+static thread_local bool sInParallelTask = false;
+
+/*
+ * Hands out the indices of a ParallelTask to the worker threads one at a
+ * time, so that items of uneven cost are balanced automatically.
+ */
+static void
+runWorker(ParallelTask* task, std::atomic<unsigned int>* next,
+          unsigned int numItems, std::exception_ptr* error)
+{
+  bool inParallelTask = sInParallelTask;
+  sInParallelTask = true;
+
+  try
+  {
+    for (unsigned int index = (*next)++; index < numItems; index = (*next)++)
+    {
+      task->run(index);
+    }
+  }
+  catch (...)
+  {
+    *error = std::current_exception();
+    // make the other workers run out of items
+    *next = numItems;
+  }
+
+  sInParallelTask = inParallelTask;
+}
+
+#endif
+
+
+ParallelTask::~ParallelTask()
+{
+}
+
+
+void
+ParallelTask::execute(ParallelTask& task, unsigned int numItems,
+                      unsigned int maxThreads)
+{
+  if (maxThreads == 0)
+  {
+    maxThreads = getMaxThreads();
+  }
+
+  if (maxThreads > numItems)
+  {
+    maxThreads = numItems;
+  }
+
+#ifdef LIBSBML_USE_THREADS
+  // each thread of an outer task would otherwise start threads of its own
+  if (sInParallelTask)
+  {
+    maxThreads = 1;
+  }
+
+  if (maxThreads > 1)
+  {
+    std::atomic<unsigned int> next(0);
+    std::vector<std::exception_ptr> errors(maxThreads);
+    std::vector<std::thread> workers;
+    workers.reserve(maxThreads - 1);
+
+    for (unsigned int n = 1; n < maxThreads; ++n)
+    {
+      workers.push_back(std::thread(runWorker, &task, &next, numItems, &errors[n]));
+    }
+
+    // the calling thread does its share of the work as well
+    runWorker(&task, &next, numItems, &errors[0]);
+
+    for (size_t n = 0; n < workers.size(); ++n)
+    {
+      workers[n].join();
+    }
+
+    for (size_t n = 0; n < errors.size(); ++n)
+    {
+      if (errors[n])
+      {
+        std::rethrow_exception(errors[n]);
+      }
+    }
+    return;
+  }
+#endif
+
+  for (unsigned int index = 0; index < numItems; ++index)
+  {
+    task.run(index);
+  }
+}
+
+
+unsigned int
+ParallelTask::getMaxThreads()
+{
+  unsigned int maxThreads = sMaxThreads;
+  if (maxThreads != 0)
+  {
+    return maxThreads;
+  }
+
+#ifdef LIBSBML_USE_THREADS
+  unsigned int hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? hardware : 1;
+#else
+  return 1;
+#endif
+}
+
+
+void
+ParallelTask::setMaxThreads(unsigned int maxThreads)
+{
+  sMaxThreads = maxThreads;
+}
+
+
+bool
+ParallelTask::hasThreadSupport()
+{
+#ifdef LIBSBML_USE_THREADS
+  return true;
+#else
+  return false;
+#endif
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
@@ -0,0 +1,121 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    ParallelTask.h
+ * @brief   Runs a number of independent work items, using threads if available
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class ParallelTask
+ * @sbmlbrief{core} Base class for work that can be split into independent items.
+ *
+ * Subclasses implement run(), which is called once for every index in
+ * <code>[0, numItems)</code>.  The calls may happen concurrently and in any
+ * order, so run() must only touch data belonging to its own index (reading
+ * shared, unchanging data is fine).  Results should be stored per index and
+ * consumed by the caller once execute() has returned; this keeps the
+ * outcome independent of the number of threads used.
+ *
+ * When libSBML was built without thread support (the CMake option
+ * <code>WITH_THREADS</code>), or when only one thread is allowed, the items
+ * are simply run one after another in index order.
+ */
+
+#ifndef ParallelTask_h
+#define ParallelTask_h
+
+
+#ifdef __cplusplus
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class LIBSBML_EXTERN ParallelTask
+{
+public:
+
+  virtual ~ParallelTask();
+
+
+  /**
+   * Processes the work item with the given index.
+   */
+  virtual void run(unsigned int index) = 0;
+
+
+  /**
+   * Calls task.run(i) for every i in <code>[0, numItems)</code>, spreading
+   * the calls over at most @p maxThreads threads (or getMaxThreads() if
+   * @p maxThreads is 0), and returns once all of them have completed.
+   *
+   * When called from the run() method of a task that is itself spread over
+   * several threads, the items are run one after another on the calling
+   * thread, so that nested tasks do not multiply the number of threads.
+   */
+  static void execute(ParallelTask& task, unsigned int numItems,
+                      unsigned int maxThreads = 0);
+
+
+  /**
+   * Returns the number of threads execute() will use by default.  Unless
+   * changed with setMaxThreads(), this is the number of hardware threads,
+   * or 1 if libSBML was built without thread support.
+   */
+  static unsigned int getMaxThreads();
+
+
+  /**
+   * Sets the number of threads execute() will use by default.  A value of
+   * 1 disables parallel execution; a value of 0 restores the default.
+   */
+  static void setMaxThreads(unsigned int maxThreads);
+
+
+  /**
+   * Returns @c true if libSBML was built with thread support.
+   */
+  static bool hasThreadSupport();
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* ParallelTask_h */
+/** @endcond */
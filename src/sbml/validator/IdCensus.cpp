@@ -0,0 +1,459 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    IdCensus.cpp
+ * @brief   Records the ids of a model once for all uniqueness constraints
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->*/
+
+#include <sbml/validator/IdCensus.h>
+#include <sbml/SBMLDocument.h>
+#include <sbml/Model.h>
+#include <sbml/util/MetaIdFilter.h>
+
+/** @cond doxygenIgnored */
+using namespace std;
+/** @endcond */
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+static const unsigned int NO_ENTRY = (unsigned int)(-1);
+
+
+IdCensus::IdCensus(const Model* model)
+  : mModel(model)
+{
+  for (unsigned int ns = 0; ns < NUM_ID_NAMESPACES; ns++)
+  {
+    mTaken[ns] = false;
+  }
+}
+
+
+unsigned int
+IdCensus::getNumEntries(IdNamespace ns) const
+{
+  take(ns);
+  return (unsigned int)mEntries[ns].size();
+}
+
+
+const std::string&
+IdCensus::getId(IdNamespace ns, unsigned int n) const
+{
+  take(ns);
+  return mEntries[ns][n].id;
+}
+
+
+const SBase*
+IdCensus::getObject(IdNamespace ns, unsigned int n) const
+{
+  take(ns);
+  return mEntries[ns][n].object;
+}
+
+
+const SBase*
+IdCensus::getPreviousOwner(IdNamespace ns, unsigned int n) const
+{
+  take(ns);
+  const Entry& entry = mEntries[ns][n];
+  return (entry.first == n) ? NULL : mEntries[ns][entry.first].object;
+}
+
+
+const SBase*
+IdCensus::getFirstOwner(IdNamespace ns, const std::string& id) const
+{
+  take(ns);
+  map<string, unsigned int>::const_iterator it = mFirst[ns].find(id);
+  return (it == mFirst[ns].end()) ? NULL : mEntries[ns][it->second].object;
+}
+
+
+void
+IdCensus::getOwners(IdNamespace ns, const std::string& id,
+                    std::vector<const SBase*>& owners) const
+{
+  owners.clear();
+
+  take(ns);
+  map<string, unsigned int>::const_iterator it = mFirst[ns].find(id);
+  if (it == mFirst[ns].end()) return;
+
+  for (unsigned int n = it->second; n != NO_ENTRY; n = mEntries[ns][n].next)
+  {
+    owners.push_back(mEntries[ns][n].object);
+  }
+}
+
+
+const IdCensus*
+IdCensus::getShared(const Model& model)
+{
+  const SBMLDocument* doc = model.getSBMLDocument();
+  return (doc == NULL) ? NULL : doc->getIdCensus();
+}
+
+
+void
+IdCensus::take(IdNamespace ns) const
+{
+  if (mTaken[ns]) return;
+  mTaken[ns] = true;
+
+  if (mModel == NULL) return;
+
+  unsigned int n, size;
+
+  switch (ns)
+  {
+  case MODEL_IDS:
+    takeModelIds();
+    break;
+  case ALL_IDS:
+    takeAllIds();
+    break;
+  case UNIT_IDS:
+    size = mModel->getNumUnitDefinitions();
+    for (n = 0; n < size; ++n) addId(ns, *mModel->getUnitDefinition(n));
+    break;
+  case LOCAL_IDS:
+    takeLocalIds();
+    break;
+  case META_IDS:
+    takeMetaIds();
+    break;
+  default:
+    break;
+  }
+}
+
+
+/*
+ * Records an id; if an earlier element has the same id the new entry is
+ * appended to the chain of its owners.
+ */
+void
+IdCensus::add(IdNamespace ns, const std::string& id, const SBase& object) const
+{
+  vector<Entry>& entries = mEntries[ns];
+  unsigned int index = (unsigned int)entries.size();
+
+  Entry entry;
+  entry.id = id;
+  entry.object = &object;
+  entry.first = index;
+  entry.next = NO_ENTRY;
+
+  pair<map<string, unsigned int>::iterator, bool> inserted =
+    mFirst[ns].insert(make_pair(id, index));
+  if (!inserted.second)
+  {
+    entry.first = inserted.first->second;
+
+    unsigned int last = entry.first;
+    while (entries[last].next != NO_ENTRY)
+    {
+      last = entries[last].next;
+    }
+    entries[last].next = index;
+  }
+
+  entries.push_back(entry);
+}
+
+
+void
+IdCensus::addId(IdNamespace ns, const SBase& object) const
+{
+  if (object.isSetId())
+  {
+    add(ns, object.getId(), object);
+  }
+}
+
+
+void
+IdCensus::addIdAttribute(IdNamespace ns, const SBase& object) const
+{
+  if (object.isSetIdAttribute())
+  {
+    add(ns, object.getIdAttribute(), object);
+  }
+}
+
+
+void
+IdCensus::takeModelIds() const
+{
+  const Model& m = *mModel;
+  unsigned int n, size, sr, sr_size;
+
+  addId(MODEL_IDS, m);
+
+  size = m.getNumFunctionDefinitions();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getFunctionDefinition(n));
+
+  size = m.getNumCompartments();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getCompartment(n));
+
+  size = m.getNumSpecies();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getSpecies(n));
+
+  size = m.getNumParameters();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getParameter(n));
+
+  size = m.getNumReactions();
+  for (n = 0; n < size; ++n) 
+  {
+    const Reaction* r = m.getReaction(n);
+    addId(MODEL_IDS, *r);
+
+    sr_size = r->getNumReactants();
+    for (sr = 0; sr < sr_size; sr++)
+    {
+      addId(MODEL_IDS, *r->getReactant(sr));
+    }
+
+    sr_size = r->getNumProducts();
+    for (sr = 0; sr < sr_size; sr++)
+    {
+      addId(MODEL_IDS, *r->getProduct(sr));
+    }
+
+    sr_size = r->getNumModifiers();
+    for (sr = 0; sr < sr_size; sr++)
+    {
+      addId(MODEL_IDS, *r->getModifier(sr));
+    }
+  }
+
+  size = m.getNumEvents();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getEvent(n));
+
+  size = m.getNumCompartmentTypes();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getCompartmentType(n));
+
+  size = m.getNumSpeciesTypes();
+  for (n = 0; n < size; ++n) addId(MODEL_IDS, *m.getSpeciesType(n));
+}
+
+
+/*
+ * From L3V2 every element may have an id; the ids of unit definitions and
+ * local parameters are in namespaces of their own.
+ */
+void
+IdCensus::takeAllIds() const
+{
+  const Model& m = *mModel;
+  unsigned int n, size, j, num;
+
+  /* any id on the sbml container */
+  if (m.getSBMLDocument() != NULL)
+  {
+    addIdAttribute(ALL_IDS, *m.getSBMLDocument());
+  }
+
+  addIdAttribute(ALL_IDS, m);
+
+  size = m.getNumFunctionDefinitions();
+  addIdAttribute(ALL_IDS, *m.getListOfFunctionDefinitions());
+  for (n = 0; n < size; ++n) 
+    addIdAttribute(ALL_IDS, *m.getFunctionDefinition(n));
+
+  size = m.getNumUnitDefinitions();
+  addIdAttribute(ALL_IDS, *m.getListOfUnitDefinitions());
+  for (n = 0; n < size; ++n) 
+  {
+    const UnitDefinition *ud = m.getUnitDefinition(n);
+    num = ud->getNumUnits();
+    addIdAttribute(ALL_IDS, *ud->getListOfUnits());
+    for (j = 0; j < num; j++)
+    {
+      addIdAttribute(ALL_IDS, *ud->getUnit(j));
+    }
+  }
+
+  size = m.getNumCompartments();
+  addIdAttribute(ALL_IDS, *m.getListOfCompartments());
+  for (n = 0; n < size; ++n) addIdAttribute(ALL_IDS, *m.getCompartment(n));
+
+  size = m.getNumSpecies();
+  addIdAttribute(ALL_IDS, *m.getListOfSpecies());
+  for (n = 0; n < size; ++n) addIdAttribute(ALL_IDS, *m.getSpecies(n));
+
+  size = m.getNumParameters();
+  addIdAttribute(ALL_IDS, *m.getListOfParameters()); 
+  for (n = 0; n < size; ++n) addIdAttribute(ALL_IDS, *m.getParameter(n));
+
+  size = m.getNumInitialAssignments();
+  addIdAttribute(ALL_IDS, *m.getListOfInitialAssignments()); 
+  for (n = 0; n < size; ++n) 
+    addIdAttribute(ALL_IDS, *m.getInitialAssignment(n));
+
+  size = m.getNumRules();
+  addIdAttribute(ALL_IDS, *m.getListOfRules()); 
+  for (n = 0; n < size; ++n) addIdAttribute(ALL_IDS, *m.getRule(n));
+
+  size = m.getNumConstraints();
+  addIdAttribute(ALL_IDS, *m.getListOfConstraints()); 
+  for (n = 0; n < size; ++n) addIdAttribute(ALL_IDS, *m.getConstraint(n));
+
+  size = m.getNumReactions();
+  addIdAttribute(ALL_IDS, *m.getListOfReactions()); 
+  for (n = 0; n < size; ++n) 
+  {
+    const Reaction *r = m.getReaction(n);
+    addIdAttribute(ALL_IDS, *r);
+
+    if (r->isSetKineticLaw())
+    {
+      // the local parameters themselves have their own namespace
+      addIdAttribute(ALL_IDS, *r->getKineticLaw());
+      addIdAttribute(ALL_IDS, *r->getKineticLaw()->getListOfParameters());
+    }
+
+    num = r->getNumReactants();
+    addIdAttribute(ALL_IDS, *r->getListOfReactants());
+    for (j = 0; j < num; j++)
+    {
+      addIdAttribute(ALL_IDS, *r->getReactant(j));
+    }
+
+    num = r->getNumProducts();
+    addIdAttribute(ALL_IDS, *r->getListOfProducts());
+    for (j = 0; j < num; j++)
+    {
+      addIdAttribute(ALL_IDS, *r->getProduct(j));
+    }
+
+    num = r->getNumModifiers();
+    addIdAttribute(ALL_IDS, *r->getListOfModifiers());
+    for (j = 0; j < num; j++)
+    {
+      addIdAttribute(ALL_IDS, *r->getModifier(j));
+    }
+  }
+
+  size = m.getNumEvents();
+  addIdAttribute(ALL_IDS, *m.getListOfEvents()); 
+  for (n = 0; n < size; ++n) 
+  {
+    const Event *e = m.getEvent(n);
+    addIdAttribute(ALL_IDS, *e);
+ 
+    if (e->isSetTrigger())
+    {
+      addIdAttribute(ALL_IDS, *e->getTrigger());
+    }
+
+    if (e->isSetDelay())
+    {
+      addIdAttribute(ALL_IDS, *e->getDelay());
+    }
+
+    if (e->isSetPriority())
+    {
+      addIdAttribute(ALL_IDS, *e->getPriority());
+    }
+
+    num = e->getNumEventAssignments();
+    addIdAttribute(ALL_IDS, *e->getListOfEventAssignments());
+    for (j = 0; j < num; j++)
+    {
+      addIdAttribute(ALL_IDS, *e->getEventAssignment(j));
+    }
+  }
+}
+
+
+void
+IdCensus::takeLocalIds() const
+{
+  for (unsigned int r = 0; r < mModel->getNumReactions(); ++r)
+  {
+    const KineticLaw* kl = mModel->getReaction(r)->getKineticLaw();
+    if (kl == NULL) continue;
+
+    for (unsigned int p = 0; p < kl->getNumParameters(); ++p)
+    {
+      addId(LOCAL_IDS, *kl->getParameter(p));
+    }
+
+    // the next kinetic law starts a new scope
+    mFirst[LOCAL_IDS].clear();
+  }
+}
+
+
+void
+IdCensus::takeMetaIds() const
+{
+  SBase* root = const_cast<SBMLDocument*>(mModel->getSBMLDocument());
+  if (root == NULL)
+  {
+    root = const_cast<Model*>(mModel);
+  }
+
+  if (root->isSetMetaId())
+  {
+    add(META_IDS, root->getMetaId(), *root);
+  }
+
+  MetaIdFilter filter;
+  List* allElements = root->getAllElements(&filter);
+
+  for (ListIterator iter = allElements->begin(); iter != allElements->end(); 
+       ++iter)
+  {
+    const SBase* object = static_cast<SBase*>(*iter);
+    if (object->isSetMetaId())
+    {
+      add(META_IDS, object->getMetaId(), *object);
+    }
+  }
+
+  delete allElements;
+}
+
+LIBSBML_CPP_NAMESPACE_END
+
+/** @endcond */
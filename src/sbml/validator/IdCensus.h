@@ -0,0 +1,199 @@
+/**
+ * @cond doxygenLibsbmlInternal
+ *
+ * @file    IdCensus.h
+ * @brief   Records the ids of a model once for all uniqueness constraints
+ * @author  SBMLTeam
+ *
+ * <!--------------------------------------------------------------------------
+ * This file is part of libSBML.  Please visit http://sbml.org for more
+ * information about SBML, and the latest version of libSBML.
+ *
+ * Copyright (C) 2020 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *     3. University College London, London, UK
+ *
+ * Copyright (C) 2019 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2013-2018 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *     3. University of Heidelberg, Heidelberg, Germany
+ *
+ * Copyright (C) 2009-2013 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. EMBL European Bioinformatics Institute (EMBL-EBI), Hinxton, UK
+ *
+ * Copyright (C) 2006-2008 by the California Institute of Technology,
+ *     Pasadena, CA, USA
+ *
+ * Copyright (C) 2002-2005 jointly by the following organizations:
+ *     1. California Institute of Technology, Pasadena, CA, USA
+ *     2. Japan Science and Technology Agency, Japan
+ *
+ * This library is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation.  A copy of the license agreement is provided
+ * in the file named "LICENSE.txt" included with this software distribution
+ * and also available online as http://sbml.org/software/libsbml/license.html
+ * ---------------------------------------------------------------------- -->
+ *
+ * @class IdCensus
+ * @sbmlbrief{core} The ids of a model, grouped by the namespace they share.
+ *
+ * The constraints that check that ids are unique (the core ones as well
+ * as those of the packages) all need to know which elements carry which
+ * id.  Instead of each of them walking the model and filling its own map,
+ * an IdCensus walks the model once per namespace and records every id
+ * with the element carrying it, in document order.  For every entry it
+ * also records the first element with the same id, so a conflict is found
+ * without another lookup.
+ *
+ * While SBMLDocument::checkConsistency() runs, one census is shared by all
+ * validators of the document; see getShared().  The namespaces are only
+ * walked when first asked for.
+ */
+
+#ifndef IdCensus_h
+#define IdCensus_h
+
+
+#ifdef __cplusplus
+
+#include <sbml/common/extern.h>
+#include <sbml/common/libsbml-namespace.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+LIBSBML_CPP_NAMESPACE_BEGIN
+
+class Model;
+class SBase;
+
+class LIBSBML_EXTERN IdCensus
+{
+public:
+
+  enum IdNamespace
+  {
+    /** ids of the model-wide components of a model before L3V2: the
+     *  model, function definitions, compartments, species, parameters,
+     *  reactions and their species references, events, compartment types
+     *  and species types */
+    MODEL_IDS,
+
+    /** ids of every element of a Level&nbsp;3 Version&nbsp;2 model, apart
+     *  from unit definitions and local parameters */
+    ALL_IDS,
+
+    /** ids of unit definitions */
+    UNIT_IDS,
+
+    /** ids of the parameters of kinetic laws; every kinetic law is a
+     *  separate scope */
+    LOCAL_IDS,
+
+    /** metaids of every element of the document */
+    META_IDS,
+
+    NUM_ID_NAMESPACES
+  };
+
+
+  /**
+   * Creates a census of the given model, which may be @c NULL.
+   */
+  explicit IdCensus(const Model* model);
+
+
+  /**
+   * Returns the number of ids recorded in the given namespace.
+   */
+  unsigned int getNumEntries(IdNamespace ns) const;
+
+
+  /**
+   * Returns the nth id recorded in the given namespace.
+   */
+  const std::string& getId(IdNamespace ns, unsigned int n) const;
+
+
+  /**
+   * Returns the element carrying the nth id of the given namespace.
+   */
+  const SBase* getObject(IdNamespace ns, unsigned int n) const;
+
+
+  /**
+   * Returns the first element with the same id as the nth entry of the
+   * given namespace, in the same scope, or @c NULL if the nth entry is the
+   * first one.
+   */
+  const SBase* getPreviousOwner(IdNamespace ns, unsigned int n) const;
+
+
+  /**
+   * Returns the first element with the given id in the given namespace, or
+   * @c NULL if there is none.  Not available for LOCAL_IDS.
+   */
+  const SBase* getFirstOwner(IdNamespace ns, const std::string& id) const;
+
+
+  /**
+   * Fills @p owners with all elements with the given id in the given
+   * namespace, in document order.  Not available for LOCAL_IDS.
+   */
+  void getOwners(IdNamespace ns, const std::string& id,
+                 std::vector<const SBase*>& owners) const;
+
+
+  /**
+   * Returns the census shared by the validators currently checking the
+   * document of the given model, or @c NULL if there is none.
+   */
+  static const IdCensus* getShared(const Model& model);
+
+
+private:
+
+  struct Entry
+  {
+    std::string id;
+    const SBase* object;
+    unsigned int first;
+    unsigned int next;
+  };
+
+  void take(IdNamespace ns) const;
+
+  void add(IdNamespace ns, const std::string& id, const SBase& object) const;
+
+  void addId(IdNamespace ns, const SBase& object) const;
+
+  void addIdAttribute(IdNamespace ns, const SBase& object) const;
+
+  void takeModelIds() const;
+
+  void takeAllIds() const;
+
+  void takeLocalIds() const;
+
+  void takeMetaIds() const;
+
+  const Model* mModel;
+
+  mutable bool mTaken[NUM_ID_NAMESPACES];
+  mutable std::vector<Entry> mEntries[NUM_ID_NAMESPACES];
+  mutable std::map<std::string, unsigned int> mFirst[NUM_ID_NAMESPACES];
+};
+
+LIBSBML_CPP_NAMESPACE_END
+
+#endif  /* __cplusplus */
+#endif  /* IdCensus_h */
+/** @endcond */
@@ -872,8 +872,13 @@ Validator::validate (const SBMLDocument& d)
         m->populateListFormulaUnitsData();
       }
     }
+    // the constraints checking unique ids share one census of the model
+    bool ownCensus = d.startIdCensus();
+
     ValidatingVisitor vv(*this, *m);
     d.accept(vv);
+
+    if (ownCensus) d.endIdCensus();
   }
 
   if (this->getCategory() == LIBSBML_CAT_SBO_CONSISTENCY
@@ -42,6 +42,10 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <cstring>
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
 
 #include <sbml/Model.h>
 #include <sbml/Rule.h>
@@ -60,6 +64,20 @@ using namespace std;
 LIBSBML_CPP_NAMESPACE_BEGIN
 #ifdef __cplusplus
 
+/*
+ * Orders node indices by their ids, which is the order the ids were
+ * reported in when the dependencies were kept in a map keyed by id.
+ */
+struct LessNodeId
+{
+  const DependencyGraph& mGraph;
+
+  LessNodeId (const DependencyGraph& graph) : mGraph(graph) { }
+  bool operator() (unsigned int a, unsigned int b) const
+       { return mGraph.getNodeId(a) < mGraph.getNodeId(b); }
+};
+
+
 /*
  * Creates a new Constraint with the given constraint id.
  */
@@ -91,261 +109,102 @@ AssignmentCycles::check_ (const Model& m, const Model& object)
 
   unsigned int n;
 
-  mIdMap.clear();
+  mGraph = DependencyGraph();
 
-  /* create map of id mapped to id that it refers to that is
-   * also the id of a Reaction, AssignmentRule or InitialAssignment
+  /* create a graph of the ids of the Reactions, AssignmentRules and 
+   * InitialAssignments and the ids they refer to; only those ids have
+   * dependencies of their own, so any cycle is made up of them
    */
-  for (n = 0; n < m.getNumInitialAssignments(); ++n)
-  { 
-    if (m.getInitialAssignment(n)->isSetMath())
-    {
-      addInitialAssignmentDependencies(m, *m.getInitialAssignment(n));
-    }
-  }
-  
-  for (n = 0; n < m.getNumReactions(); ++n)
-  { 
-    if (m.getReaction(n)->isSetKineticLaw()){
-      if (m.getReaction(n)->getKineticLaw()->isSetMath())
-      {
-        addReactionDependencies(m, *m.getReaction(n));
-      }
-    }
-  }
-  
-  for (n = 0; n < m.getNumRules(); ++n)
-  { 
-    if (m.getRule(n)->isAssignment() && m.getRule(n)->isSetMath())
-    {
-      addRuleDependencies(m, *m.getRule(n));
-    }
+  mGraph.addModel(m);
+
+  /* report in the order of the ids */
+  vector<unsigned int> nodes;
+  for (n = 0; n < mGraph.getNumNodes(); ++n)
+  {
+    nodes.push_back(n);
   }
+  sort(nodes.begin(), nodes.end(), LessNodeId(mGraph));
 
   // check for self assignment
-  checkForSelfAssignment(m);
+  checkForSelfAssignment(m, nodes);
 
-  determineAllDependencies();
-  determineCycles(m);
+  determineCycles(m, nodes);
 
   checkForImplicitCompartmentReference(m);
 }
- 
-void 
-AssignmentCycles::addInitialAssignmentDependencies(const Model& m, 
-                                         const InitialAssignment& object)
-{
-  unsigned int ns;
-  std::string thisId = object.getSymbol();
-
-  /* loop thru the list of names in the Math
-    * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
-    */
-  List* variables = object.getMath()->getListOfNodes( ASTNode_isName );
-  for (ns = 0; ns < variables->getSize(); ns++)
-  {
-    ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
-    string   name = node->getName() ? node->getName() : "";
-
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-  }
-
-  delete variables;
-}
 
 
 void 
-AssignmentCycles::addReactionDependencies(const Model& m, const Reaction& object)
+AssignmentCycles::checkForSelfAssignment(const Model& m,
+                                       const std::vector<unsigned int>& nodes)
 {
-  unsigned int ns;
-  std::string thisId = object.getId();
-
-  /* loop thru the list of names in the Math
-    * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
-    */
-  List* variables = object.getKineticLaw()->getMath()
-                                      ->getListOfNodes( ASTNode_isName );
-  const KineticLaw* kl = object.getKineticLaw();
-  for (ns = 0; ns < variables->getSize(); ns++)
+  for (unsigned int n = 0; n < nodes.size(); n++)
   {
-    ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
-    string   name = node->getName() ? node->getName() : "";
-    if (kl->getParameter(name) != NULL)
+    unsigned int node = nodes[n];
+    for (unsigned int e = 0; e < mGraph.getNumEdges(node); e++)
     {
-      continue;
-    }
-
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
+      if (mGraph.getEdge(node, e) == node)
+      {
+        logMathRefersToSelf(m, mGraph.getNodeId(node));
+      }
     }
   }
-
-  delete variables;
 }
 
 
 void 
-AssignmentCycles::addRuleDependencies(const Model& m, const Rule& object)
+AssignmentCycles::determineCycles(const Model& m,
+                                  const std::vector<unsigned int>& nodes)
 {
-  unsigned int ns;
-  std::string thisId = object.getVariable();
-
-  /* loop thru the list of names in the Math
-    * if they refer to a Reaction, an Assignment Rule
-    * or an Initial Assignment add to the map
-    * with the variable as key
-    */
-  List* variables = object.getMath()->getListOfNodes( ASTNode_isName );
-  for (ns = 0; ns < variables->getSize(); ns++)
+  /* find the ids that depend on themselves */
+  vector<bool> inCycle;
+  if (mGraph.getNodesInCycles(inCycle) == 0)
   {
-    ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
-    string   name = node->getName() ? node->getName() : "";
-
-    if (m.getReaction(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getRule(name) && m.getRule(name)->isAssignment())
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
-    else if (m.getInitialAssignment(name))
-    {
-      mIdMap.insert(pair<const std::string, std::string>(thisId, name));
-    }
+    return;
   }
 
-  delete variables;
-}
-
-
-void 
-AssignmentCycles::determineAllDependencies()
-{
-  IdIter iterator;
-  IdIter inner_it;
-  IdRange range;
-
-  /* for each pair in the map (x, y)
-   * retrieve all other pairs where y is first (e.g. (y, s))
-   * and create pairs showing that x depends on these e.g. (x, s)
-   * check whether the pair already exists in the map
-   * and add it if not
+  /* for each of these, report the others it depends on, directly or
+   * indirectly; keep a record of logged pairs to avoid logging twice
    */
-  for (iterator = mIdMap.begin(); iterator != mIdMap.end(); iterator++)
-  {
-    range = mIdMap.equal_range((*iterator).second);
-    for (inner_it = range.first; inner_it != range.second; inner_it++)
-    {
-      const pair<const std::string, std::string> &depend = 
-            pair<const std::string, std::string>((*iterator).first, (*inner_it).second);
-      if (!alreadyExistsInMap(mIdMap, depend))
-        mIdMap.insert(depend);
-    }
-  }
-}
-
-
-bool 
-AssignmentCycles::alreadyExistsInMap(IdMap map, 
-                                     pair<const std::string, std::string> dependency)
-{
-  bool exists = false;
+  const unsigned int numNodes = mGraph.getNumNodes();
+  vector<unsigned int> visitedFrom(numNodes, numNodes);
+  set< pair<unsigned int, unsigned int> > logged;
+  vector<unsigned int> reached;
 
-  IdIter it;
-  
-  for (it = map.begin(); it != map.end(); it++)
+  for (unsigned int n = 0; n < nodes.size(); n++)
   {
-    if (((*it).first == dependency.first)
-      && ((*it).second == dependency.second))
-      exists = true;
-  }
+    unsigned int node = nodes[n];
+    if (!inCycle[node]) continue;
 
-  return exists;
-}
-
-  
-void 
-AssignmentCycles::checkForSelfAssignment(const Model& m)
-{
-  IdIter the_iterator;
-
-  for (the_iterator = mIdMap.begin();
-    the_iterator != mIdMap.end(); the_iterator++)
-  {
-    if ((*the_iterator).first == (*the_iterator).second)
+    reached.clear();
+    visitedFrom[node] = numNodes;
+    for (unsigned int e = 0; e < mGraph.getNumEdges(node); e++)
     {
-      logMathRefersToSelf(m, (*the_iterator).first);
+      unsigned int target = mGraph.getEdge(node, e);
+      if (visitedFrom[target] != node)
+      {
+        visitedFrom[target] = node;
+        reached.push_back(target);
+      }
     }
-  }
-}
-
-
-void 
-AssignmentCycles::determineCycles(const Model& m)
-{
-  IdIter it;
-  IdRange range;
-  IdList variables;
-  IdMap logged;
-  std::string id;
-  variables.clear();
 
-  /* create a list of variables that are cycles ie (x, x) */
-  for (it = mIdMap.begin(); it != mIdMap.end(); it++)
-  {
-    if ((*it).first == (*it).second)
+    for (unsigned int r = 0; r < reached.size(); r++)
     {
-      id = (*it).first;
-      if (!variables.contains(id))
+      unsigned int other = reached[r];
+      if (other != node && inCycle[other]
+        && logged.insert(make_pair(min(node, other), max(node, other))).second)
       {
-        variables.append(id);
+        logCycle(m, mGraph.getNodeId(node), mGraph.getNodeId(other));
       }
-    }
-  }
 
-  /* loop thru other dependencies for each; if the dependent is also
-   * in the list then this is the cycle
-   * keep a record of logged dependencies to avoid logging twice
-   */
-   
-  for (unsigned int n = 0; n < variables.size(); n++)
-  {
-    id = variables.at((int)n);
-    range = mIdMap.equal_range(id);
-    for (it = range.first; it != range.second; it++)
-    {
-      if (((*it).second != id)
-        && (variables.contains((*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>(id, (*it).second))
-        && !alreadyExistsInMap(logged, pair<const std::string, std::string>((*it).second, id)))
+      for (unsigned int e = 0; e < mGraph.getNumEdges(other); e++)
       {
-        logCycle(m, id, (*it).second);
-        logged.insert(pair<const std::string, std::string>(id, (*it).second));
+        unsigned int target = mGraph.getEdge(other, e);
+        if (visitedFrom[target] != node)
+        {
+          visitedFrom[target] = node;
+          reached.push_back(target);
+        }
       }
     }
   }
@@ -355,7 +214,8 @@ AssignmentCycles::determineCycles(const Model& m)
 void 
 AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
 {
-  mIdMap.clear();
+  map<string, vector<string> > referenced;
+  set< pair<string, string> > added;
 
   unsigned int i, ns;
   std::string id;
@@ -374,8 +234,8 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
-            mIdMap.insert(pair<const std::string, std::string>(id, name));
+          if (!name.empty() && added.insert(make_pair(id, name)).second)
+            referenced[id].push_back(name);
         }
         delete variables;
       }
@@ -395,24 +255,25 @@ AssignmentCycles::checkForImplicitCompartmentReference(const Model& m)
         {
           ASTNode* node = static_cast<ASTNode*>( variables->get(ns) );
           string   name = node->getName() ? node->getName() : "";
-          if (!name.empty() && !alreadyExistsInMap(mIdMap, pair<const std::string, std::string>(id, name)))
-            mIdMap.insert(pair<const std::string, std::string>(id, name));
+          if (!name.empty() && added.insert(make_pair(id, name)).second)
+            referenced[id].push_back(name);
         }
         delete variables;
       }
     }
   }
 
-  IdIter it;
-  IdRange range;
+  map<string, vector<string> >::const_iterator it;
 
   for (i = 0; i < m.getNumCompartments(); i++)
   {
     std::string id1 = m.getCompartment(i)->getId();
-    range = mIdMap.equal_range(id1);
-    for (it = range.first; it != range.second; it++)
+    it = referenced.find(id1);
+    if (it == referenced.end()) continue;
+
+    for (ns = 0; ns < it->second.size(); ns++)
     {
-      const Species *s = m.getSpecies((*it).second);
+      const Species *s = m.getSpecies(it->second[ns]);
       if (s && s->getCompartment() == id1
         && s->getHasOnlySubstanceUnits() == false)
       {
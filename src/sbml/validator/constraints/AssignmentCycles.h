@@ -48,16 +48,14 @@
 #ifdef __cplusplus
 
 #include <string>
+#include <vector>
 #include <sbml/validator/VConstraint.h>
 
 #include <sbml/util/IdList.h>
+#include <sbml/util/DependencyGraph.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::multimap<const std::string, std::string> IdMap;
-typedef IdMap::iterator                               IdIter;
-typedef std::pair<IdIter, IdIter>                     IdRange;
-
 class AssignmentCycles: public TConstraint<Model>
 {
 public:
@@ -78,30 +76,13 @@ protected:
   virtual void check_ (const Model& m, const Model& object);
 
   
-  /* create pairs of ids that depend on each other */
-  void addInitialAssignmentDependencies(const Model &, 
-                                        const InitialAssignment &);
-  
-  void addReactionDependencies(const Model &, const Reaction &);
-  
-  
-  void addRuleDependencies(const Model &, const Rule &);
-
-  
-  void determineAllDependencies();
-
-
-  /* helper function to check if a pair already exists */
-  bool alreadyExistsInMap(IdMap map, 
-                          std::pair<const std::string, std::string> dependency);
-
-  
   /* check for explicit use of original variable */
-  void checkForSelfAssignment(const Model &);
+  void checkForSelfAssignment(const Model &,
+                              const std::vector<unsigned int>& nodes);
 
 
-  /* find cycles in the map of dependencies */
-  void determineCycles(const Model& m);
+  /* find cycles in the graph of dependencies */
+  void determineCycles(const Model& m, const std::vector<unsigned int>& nodes);
 
 
   /* if a rule for a compartment refers to a species
@@ -142,7 +123,7 @@ protected:
                              const Species* conflict);
 
   
-  IdMap mIdMap;
+  DependencyGraph mGraph;
 
 };
 
@@ -91,15 +91,22 @@ AssignmentRuleOrdering::check_ (const Model& m, const Model&)
 
   unsigned int n;
 
-  mVariableList.clear();
+  mRuleVariables = DependencyGraph();
+  mFirstPositions.clear();
 
-  // create a list of all assignment rule variables 
-  // in the order they appear
+  // number all assignment rule variables in the order they appear
+  // and record where each first appears
+  unsigned int position = 0;
   for (n = 0; n < m.getNumRules(); ++n)
   { 
     if (m.getRule(n)->isAssignment())
     {
-      mVariableList.append(m.getRule(n)->getId());
+      unsigned int node = mRuleVariables.addNode(m.getRule(n)->getId());
+      if (node == mFirstPositions.size())
+      {
+        mFirstPositions.push_back(position);
+      }
+      position++;
     }
   }
  
@@ -150,24 +157,17 @@ AssignmentRuleOrdering::checkRuleForLaterVariables(const Model&,
 
   if (variables != NULL)
   {
-    unsigned int index;
     for (unsigned int i = 0; i < variables->getSize(); i++)
     {
       ASTNode* node = static_cast<ASTNode*>( variables->get(i) );
       const char *   name = node->getName() ? node->getName() : "";
   
-      if (mVariableList.contains(name))
+      int index = mRuleVariables.getNodeIndex(name);
+      if (index >= 0)
       {
         // this <ci> is a variable
         // check that it occurs later
-        index = 0; 
-        while(index < mVariableList.size())
-        {
-          if (!strcmp(name, mVariableList.at((int)index).c_str()))
-            break;
-          index++;
-        }
-        if (index > n)
+        if (mFirstPositions[(unsigned int)index] > n)
           logForwardReference(*(object.getMath()), object, name);
       }
     }
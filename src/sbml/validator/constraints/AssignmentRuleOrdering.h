@@ -48,9 +48,11 @@
 #ifdef __cplusplus
 
 #include <string>
+#include <vector>
 #include <sbml/validator/VConstraint.h>
 
 #include <sbml/util/IdList.h>
+#include <sbml/util/DependencyGraph.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -90,7 +92,8 @@ void logForwardReference (const ASTNode & node,
 
   IdList mVariables;
   IdList mTempList;
-  IdList mVariableList;
+  DependencyGraph mRuleVariables;
+  std::vector<unsigned int> mFirstPositions;
 
 };
 
@@ -50,6 +50,7 @@
 
 #include <iostream>
 #include <cstring>
+#include <set>
 
 /** @cond doxygenIgnored */
 using namespace std;
@@ -153,24 +154,14 @@ OverDeterminedCheck::logOverDetermined (const Model& m)
   logFailure(m);
 }
 
+const unsigned int EquationMatching::NOT_MATCHED = (unsigned int)(-1);
+
 EquationMatching::EquationMatching()
 {
 }
 
 EquationMatching::~EquationMatching ()
 {
-  mEquations.clear(); // list of equation vertexes
-  mVariables.clear(); // list of variable vertexes
-  mGraph.clear();
-
-  /* these are to enable the bipartite matching without passing variables */
-  mMatching.clear();
-  mVarNeighInPrev.clear();
-  mEqnNeighInPrev.clear();
-
-  revisited.clear();
-  visited.clear();
-
 }
 
 
@@ -190,6 +181,7 @@ EquationMatching::writeEquationVertexes(const Model& m)
   const Species* s;
   string rule;
   string react;
+  set<string> speciesAdded;
 
   unsigned int n, sr;
 
@@ -206,9 +198,9 @@ EquationMatching::writeEquationVertexes(const Model& m)
       for (sr = 0; sr < r->getNumReactants(); sr++)
       {
         s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
+        if (s != NULL && !s->getBoundaryCondition() && !s->getConstant())
         {
-          if (!mEquations.contains(s->getId()))
+          if (speciesAdded.insert(s->getId()).second)
             mEquations.append(s->getId());
         }
       }
@@ -216,9 +208,9 @@ EquationMatching::writeEquationVertexes(const Model& m)
       for (sr = 0; sr < r->getNumProducts(); sr++)
       {
         s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        if (!s->getBoundaryCondition() && !s->getConstant())
+        if (s != NULL && !s->getBoundaryCondition() && !s->getConstant())
         {
-          if (!mEquations.contains(s->getId()))
+          if (speciesAdded.insert(s->getId()).second)
             mEquations.append(s->getId());
         }
       }
@@ -319,6 +311,13 @@ EquationMatching::writeVariableVertexes(const Model& m)
       }
     }
   }
+
+  /* index the variables, so edges can be looked up quickly; if an id 
+   * appears twice the first vertex is used */
+  for (n = 0; n < mVariables.size(); n++)
+  {
+    mVariableIndex.insert(make_pair(mVariables.at((int)n), n));
+  }
 }
 
 unsigned int 
@@ -331,27 +330,37 @@ EquationMatching::getNumVariables()
 {
   return mVariables.size();
 }
+
+
+void
+EquationMatching::addEdge(unsigned int eqn, const std::string& var)
+{
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(var);
+  if (it != mVariableIndex.end())
+  {
+    mGraph[eqn].push_back(it->second);
+  }
+}
+
+
 /*
  * creates a bipartite graph according to the L2V2 spec 4.11.5 
  * creates edges between the equation vertexes and the variable vertexes
- * graph produced is an id representimg the equation and an IdList
- * listing the edges the equation vertex is connected to
+ * graph produced holds, for the equation with index i in mEquations,
+ * the indexes in mVariables of the variables it is connected to
  */
 void
 EquationMatching::createGraph(const Model& m)
 {
-  IdList joined;
-  IdList speciesAdded;
+  set<string> speciesAdded;
   unsigned int n, sr;
   const Reaction *r;
   const Species *s;
-  const char * sId;
   const Rule *rule;
   const ASTNode *math;
   const KineticLaw * kl;
   List * names;
   ASTNode * node;
-  string name;
 
   /* create a list of ids relating to
    * 1. species
@@ -368,6 +377,9 @@ EquationMatching::createGraph(const Model& m)
    */
   writeVariableVertexes(m);
 
+  mGraph.clear();
+  mGraph.resize(mEquations.size());
+
   /* create the edges for the graph */
 
   /*
@@ -376,51 +388,28 @@ EquationMatching::createGraph(const Model& m)
    * or product lists of a Reaction structure containing a KineticLaw structure. 
    * The edge connects the vertex representing the species 
    *    to the vertex representing the species' equation
+   *
+   * the species equations were written in the same order, so the
+   * equation vertex of each newly seen species is the next one
    */
-
-  speciesAdded.clear();
   unsigned int eqnCount = 0;
   for (n = 0; n < m.getNumReactions(); n++)
   {
     if (m.getReaction(n)->isSetKineticLaw())
     {
       r = m.getReaction(n);
-      for (sr = 0; sr < r->getNumReactants(); sr++)
-      {
-        s = m.getSpecies(r->getReactant(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
-        {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
-          eqnCount++;
-        }
-      }
-
-      for (sr = 0; sr < r->getNumProducts(); sr++)
+      for (sr = 0; sr < r->getNumReactants() + r->getNumProducts(); sr++)
       {
-        s = m.getSpecies(r->getProduct(sr)->getSpecies());
-        sId = s->getId().c_str();
-
-        if (mEquations.contains(sId) 
-          && mVariables.contains(sId)
-          && !speciesAdded.contains(sId))
-        {
-          joined.append(sId);
-          speciesAdded.append(sId);
-        }
-        if (joined.size() > 0)
+        s = (sr < r->getNumReactants()) 
+          ? m.getSpecies(r->getReactant(sr)->getSpecies())
+          : m.getSpecies(r->getProduct(sr - r->getNumReactants())->getSpecies());
+        if (s == NULL || s->getBoundaryCondition() || s->getConstant())
+          continue;
+
+        if (mVariableIndex.find(s->getId()) != mVariableIndex.end()
+          && speciesAdded.insert(s->getId()).second)
         {
-          mGraph[mEquations.at((int)eqnCount)] = joined;
-          joined.clear();
+          addEdge(eqnCount, s->getId());
           eqnCount++;
         }
       }
@@ -439,10 +428,7 @@ EquationMatching::createGraph(const Model& m)
      */
     if (rule->isAssignment() || rule->isRate())
     {
-      if (mVariables.contains(rule->getVariable()))
-      {
-        joined.append(rule->getVariable());
-      }
+      addEdge(eqnCount, rule->getVariable());
     }
 
     /*
@@ -462,19 +448,13 @@ EquationMatching::createGraph(const Model& m)
       for (sr = 0; sr < names->getSize(); sr++)
       {
         node = static_cast<ASTNode*>( names->get(sr) );
-        name = node->getName() ? node->getName() : "";
-        if (mVariables.contains(name))
-        {
-          joined.append(name);
-        }
+        addEdge(eqnCount, node->getName() ? node->getName() : "");
       }
 
       delete names;
 
     }
 
-    mGraph[mEquations.at((int)eqnCount)] = joined;
-    joined.clear();
     eqnCount++;
   }
 
@@ -489,10 +469,7 @@ EquationMatching::createGraph(const Model& m)
        * to the variable vertex representing the Reaction containing the 
        * KineticLaw.
        */
-      if (mVariables.contains(m.getReaction(n)->getId()))
-      {
-        joined.append(m.getReaction(n)->getId());
-      }
+      addEdge(eqnCount, m.getReaction(n)->getId());
 
       /*
        * the occurrence of a MathML ci symbol referencing a variable within 
@@ -513,28 +490,19 @@ EquationMatching::createGraph(const Model& m)
         for (sr = 0; sr < names->getSize(); sr++)
         {
           node = static_cast<ASTNode*>( names->get(sr) );
-          name = node->getName() ? node->getName() : "";
-          if (mVariables.contains(name))
-          {
-            joined.append(name);
-          }
+          addEdge(eqnCount, node->getName() ? node->getName() : "");
         }
 
-  delete names;
-  
+        delete names;
       }
-      mGraph[mEquations.at((int)eqnCount)] = joined;
-      joined.clear();
       eqnCount++;
     }
   }
 }
 
 /*
- * finds a maximal matching of the bipartite graph
- * adapted from the only implementation I could find:
- * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
- * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+ * finds a maximal matching of the bipartite graph using the
+ * Hopcroft-Karp algorithm, starting from a greedy matching
  *
  * returns an IdList of any equation vertexes that are unconnected 
  * in the maximal matching
@@ -543,237 +511,135 @@ IdList
 EquationMatching::findMatching()
 {
   IdList unmatchedEquations;
+  unsigned int n, p;
 
+  mEqnMatch.assign(mEquations.size(), NOT_MATCHED);
+  mVarMatch.assign(mVariables.size(), NOT_MATCHED);
 
-  unsigned int n, p;
-  IdList temp;
-  IdList tempVarsInMatching;
-  IdList unmatch;
-  IdList layer;
-  IdList unmatchFlag;
-  unmatchFlag.append("unmatched");
-  graph newLayer;
-
-  /* create greedy mMatching */
-  for (n = 0; n < mEquations.size(); n++)
+  /* create greedy matching */
+  for (n = 0; n < mGraph.size(); n++)
   {
-    for (p = 0; p < mGraph[mEquations.at((int)n)].size(); p++)
+    for (p = 0; p < mGraph[n].size(); p++)
     {
-      if (mMatching.count(mGraph[mEquations.at((int)n)].at((int)p)) == 0)
+      if (mVarMatch[mGraph[n][p]] == NOT_MATCHED)
       {
-        temp.append(mEquations.at((int)n));
-        mMatching[mGraph[mEquations.at((int)n)].at((int)p)] = temp;
-        temp.clear();
+        mVarMatch[mGraph[n][p]] = n;
+        mEqnMatch[n] = mGraph[n][p];
         break;
       }
     }
   }
 
-  unsigned int maximal = 1;
-  while (maximal == 1)
+  /* each phase augments along a maximal set of shortest paths */
+  while (layerGraph())
   {
-    unmatch.clear();
-    mVarNeighInPrev.clear();
-
-    /* create mEqnNeighInPrev - graph giving neighbour in previous layer */
-
-    /* list of variables in mMatching */
-    tempVarsInMatching.clear();
-    for (graph::iterator iter = mMatching.begin(); iter != mMatching.end(); iter++)
-    {
-      tempVarsInMatching.append((*iter).second.at(0));
-    }
-
-
-    for (n = 0; n < mEquations.size(); n++)
+    mNextEdge.assign(mEquations.size(), 0);
+    for (n = 0; n < mEqnMatch.size(); n++)
     {
-      if (!tempVarsInMatching.contains(mEquations.at((int)n)))
+      if (mEqnMatch[n] == NOT_MATCHED)
       {
-        mEqnNeighInPrev[mEquations.at((int)n)] = unmatchFlag;
-        layer.append(mEquations.at((int)n));
+        augment(n);
       }
     }
+  }
 
-    /* extend layering structure */
-    while (layer.size() > 0 && unmatch.size() == 0)
+  /* list any equations that are not matched */
+  for (n = 0; n < mEqnMatch.size(); n++)
+  {
+    if (mEqnMatch[n] == NOT_MATCHED)
     {
-      graph::iterator iter;
+      unmatchedEquations.append(mEquations.at((int)n));
+    }
+  }
 
-      newLayer.clear();
+  return unmatchedEquations;
+}
 
-      temp.clear();
-      for (iter = mVarNeighInPrev.begin(); 
-                        iter != mVarNeighInPrev.end(); iter++)
-      {
-        temp.append((*iter).first); 
-      }
-      for (n = 0; n < layer.size(); n++)
-      {
-        for (p = 0; p < mGraph[layer.at((int)n)].size(); p++)
-        {
-          if (!temp.contains(mGraph[layer.at((int)n)].at((int)p)))
-          {
-            newLayer[mGraph[layer.at((int)n)].at((int)p)].append(layer.at((int)n));
-          }
-        }
-      }
 
-      layer.clear();
-      temp.clear();
-      for (iter = newLayer.begin(); 
-                        iter != newLayer.end(); iter++)
-      {
-        mVarNeighInPrev[(*iter).first] = (*iter).second;
-        if (tempVarsInMatching.contains((*iter).first))
-        {
-          layer.append(mMatching[(*iter).first].at(0));
-          temp.append((*iter).first);
-          mEqnNeighInPrev[mMatching[(*iter).first].at(0)] = temp;
-        }
-        else
-        {
-          unmatch.append((*iter).first);
-        }
-      }
-    } // end of extending layers while statement
+bool
+EquationMatching::layerGraph()
+{
+  vector<unsigned int> queue;
+  bool found = false;
+  unsigned int n, p;
 
-    /* finished without needing alternative paths */
-    if (unmatch.size() == 0)
+  mLayer.assign(mEquations.size(), NOT_MATCHED);
+  for (n = 0; n < mEqnMatch.size(); n++)
+  {
+    if (mEqnMatch[n] == NOT_MATCHED)
     {
-      /* list any equations that are not matched */
-      temp.clear();
-      for (graph::iterator iter = mMatching.begin(); 
-                        iter != mMatching.end(); iter++)
-      {
-        temp.append(mMatching[(*iter).first].at(0));
-      }
+      mLayer[n] = 0;
+      queue.push_back(n);
+    }
+  }
 
-      for (n = 0; n < mEquations.size(); n++)
+  for (n = 0; n < queue.size(); n++)
+  {
+    unsigned int eqn = queue[n];
+    for (p = 0; p < mGraph[eqn].size(); p++)
+    {
+      unsigned int next = mVarMatch[mGraph[eqn][p]];
+      if (next == NOT_MATCHED)
       {
-        if (!temp.contains(mEquations.at((int)n)))
-        {
-          unmatchedEquations.append(mEquations.at((int)n));
-        }
+        found = true;
       }
-      maximal = 0;
-    }
-    else
-    {
-      for (n = 0; n < unmatch.size(); n++)
+      else if (mLayer[next] == NOT_MATCHED)
       {
-        maximal = Recurse(unmatch.at((int)n));
-        if (maximal == 2) break;
+        mLayer[next] = mLayer[eqn] + 1;
+        queue.push_back(next);
       }
     }
   }
 
-  if (maximal == 2)
-  {
-    // we have a flip flopping set of matches
-    unmatchedEquations.append(mMatching[unmatch.at((int)n)].at(0));
-  }
-  return unmatchedEquations;
-
+  return found;
 }
 
 
 /*
- * function that looks for alternative paths and adds these to the matching
- * where necessary
+ * depth first search along the layers, kept on an explicit stack as the
+ * paths can be as long as the model is large
  */
-unsigned int
-EquationMatching::Recurse(std::string v)
+bool
+EquationMatching::augment(unsigned int root)
 {
-  //static graph revisited;
-  //static IdList visited;
-  unsigned int rec = 0;
-  unsigned int n;
-  IdList tempVarNeigh;
-  IdList tempEqnNeigh;
-  IdList L;
-  IdList pu;
-  IdList prev;
-
-  graph::iterator iter;
+  vector<unsigned int> path;
+  path.push_back(root);
 
-  tempVarNeigh.clear();
-  for (iter = mVarNeighInPrev.begin(); 
-                    iter != mVarNeighInPrev.end(); iter++)
+  while (!path.empty())
   {
-    tempVarNeigh.append((*iter).first);
-  }
-
-  tempEqnNeigh.clear();
-  for (iter = mEqnNeighInPrev.begin(); 
-                    iter != mEqnNeighInPrev.end(); iter++)
-  {
-    tempEqnNeigh.append((*iter).first);
-  }
-
-  if (tempVarNeigh.contains(v))
-  {
-    L = mVarNeighInPrev[v];
-    mVarNeighInPrev.erase(v);
+    unsigned int eqn = path.back();
+    if (mNextEdge[eqn] == mGraph[eqn].size())
+    {
+      /* dead end; do not come back here during this phase */
+      mLayer[eqn] = NOT_MATCHED;
+      path.pop_back();
+      continue;
+    }
 
-    for (n = 0; n < L.size(); n++)
+    unsigned int var = mGraph[eqn][mNextEdge[eqn]++];
+    unsigned int next = mVarMatch[var];
+    if (next == NOT_MATCHED)
     {
-      if (tempEqnNeigh.contains(L.at((int)n)))
+      /* flip the path: each equation takes the variable it reached next */
+      while (!path.empty())
       {
-        pu = mEqnNeighInPrev[L.at((int)n)];
-        mEqnNeighInPrev.erase(L.at((int)n));
-
-        if (pu.size() == 0)
-          break;
-
-        if (pu.size() == 1 && !strcmp(pu.at(0).c_str(), "unmatched"))
-        {
-          /* look to see if variable has been here before
-           * in order t catch variables that are flip flopping
-           * between equations
-           */
-          bool repeat = false;
-          if (!visited.contains(v))
-          {
-            visited.append(v);
-            revisited[v] = L;
-          }
-          else
-          {
-            prev = revisited[v];
-            unsigned int i;
-            for (i = 0; i < L.size(); i++)
-            {
-              if (prev.contains(L.at((int)i)))
-              {
-                repeat = true;
-              }
-              else
-              {
-                prev.append(L.at((int)i));
-              }
-              if (repeat) break;
-            }
-          }
-          if (!repeat)
-          {
-            mMatching[v] = L;
-            rec = 1;
-          }
-          else
-          {
-            rec = 2;
-            return rec;
-          }
-        }
-        else if (Recurse(pu.at(0)))
-        {
-          mMatching[v] = L;
-          rec = 1;
-        }
+        eqn = path.back();
+        path.pop_back();
+        unsigned int previous = mEqnMatch[eqn];
+        mEqnMatch[eqn] = var;
+        mVarMatch[var] = eqn;
+        var = previous;
       }
+      return true;
+    }
+
+    if (mLayer[next] != NOT_MATCHED && mLayer[next] == mLayer[eqn] + 1)
+    {
+      path.push_back(next);
     }
   }
-  return rec;
+
+  return false;
 }
 
 
@@ -782,14 +648,12 @@ EquationMatching::Recurse(std::string v)
 bool
 EquationMatching::match_dependency(const std::string& var, const std::string& eq)
 {
-  bool match = false;
-  IdList matches = mMatching[var];
-
-  if (matches.size() == 1 && matches.at(0) == eq)
-    match = true;
+  map<string, unsigned int>::const_iterator it = mVariableIndex.find(var);
+  if (it == mVariableIndex.end() || it->second >= mVarMatch.size())
+    return false;
 
-  
-  return match;
+  unsigned int eqn = mVarMatch[it->second];
+  return eqn != NOT_MATCHED && mEquations.at((int)eqn) == eq;
 }
 LIBSBML_CPP_NAMESPACE_END
 /** @endcond */
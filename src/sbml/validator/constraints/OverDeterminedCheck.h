@@ -62,8 +62,6 @@
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
-typedef std::map< std::string, IdList> graph;
-
 class Model;
 class Validator;
 
@@ -99,42 +97,62 @@ public:
   /**
    * creates a bipartite graph according to the L2V2 spec 4.11.5 
    * creates edges between the equation vertexes and the variable vertexes
-   * graph produced is an id representimg the equation and an IdList
-   * listing the edges the equation vertex is connected to
+   * graph produced holds, for the equation with index i in mEquations,
+   * the indexes in mVariables of the variables it is connected to
    */
   void createGraph(const Model &);
 
   /**
-   * finds a maximal matching of the bipartite graph
-   * adapted from the only implementation I could find:
-   * # Hopcroft-Karp bipartite max-cardinality mMatching and max independent set
-   * # David Eppstein, UC Irvine, 27 Apr 2002 - Python Cookbook
+   * finds a maximal matching of the bipartite graph using the
+   * Hopcroft-Karp algorithm, starting from a greedy matching
    *
    * returns an IdList of any equation vertexes that are unconnected 
    * in the maximal matching
    */
   IdList findMatching();
 
-  /**
-  * function that looks for alternative paths and adds these to the matching
-  * where necessary
-  */
-  unsigned int Recurse(std::string);
-
   bool match_dependency(const std::string& var, const std::string& eq); 
 
 
   IdList mEquations; // list of equation vertexes
   IdList mVariables; // list of variable vertexes
-  graph mGraph;
 
-  /* these are to enable the bipartite matching without passing variables */
-  graph mMatching;
-  graph mVarNeighInPrev;
-  graph mEqnNeighInPrev;
+private:
+
+  /**
+   * adds the edge from the equation with index eqn to the variable with
+   * the given id, if that is a variable vertex
+   */
+  void addEdge(unsigned int eqn, const std::string& var);
+
+  /**
+   * layers the graph from the unmatched equations; returns true if an
+   * unmatched variable can be reached
+   */
+  bool layerGraph();
+
+  /**
+   * looks for an augmenting path from the unmatched equation eqn along
+   * the layers and flips it into the matching; returns true if found
+   */
+  bool augment(unsigned int eqn);
+
+  std::map<std::string, unsigned int> mVariableIndex;
+
+  /* adjacency of each equation vertex, as variable indexes */
+  std::vector< std::vector<unsigned int> > mGraph;
+
+  /* matched variable of each equation and equation of each variable,
+   * or NOT_MATCHED */
+  std::vector<unsigned int> mEqnMatch;
+  std::vector<unsigned int> mVarMatch;
+
+  /* layer of each equation, and the next edge to try from it, during a
+   * phase of the algorithm */
+  std::vector<unsigned int> mLayer;
+  std::vector<unsigned int> mNextEdge;
 
-  graph revisited;
-  IdList visited;
+  static const unsigned int NOT_MATCHED;
 };
 
 class OverDeterminedCheck: public TConstraint<Model>
@@ -42,6 +42,7 @@
  * ---------------------------------------------------------------------- -->*/
 
 #include <sbml/SBase.h>
+#include <sbml/Model.h>
 
 #include "UniqueIdBase.h"
 
@@ -106,6 +107,35 @@ UniqueIdBase::doCheckId (const SBase& object)
 }
 
 
+/*
+ * Logs a conflict for every element of the given namespace whose id was
+ * already used by an earlier element.
+ */
+void
+UniqueIdBase::checkCensus (IdCensus::IdNamespace ns, const Model& m)
+{
+  const IdCensus* census = IdCensus::getShared(m);
+  IdCensus        local(&m);
+
+  if (census == NULL)
+  {
+    census = &local;
+  }
+
+  unsigned int size = census->getNumEntries(ns);
+  for (unsigned int n = 0; n < size; ++n)
+  {
+    const SBase* previous = census->getPreviousOwner(ns, n);
+    if (previous == NULL) continue;
+
+    const string& id = census->getId(ns, n);
+
+    // getMessage() looks the previous definition up in the map
+    mIdObjectMap[id] = previous;
+    logIdConflict(id, *census->getObject(ns, n));
+  }
+}
+
 
 /*
  * @return the error message to use when logging constraint violations.
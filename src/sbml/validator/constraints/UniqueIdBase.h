@@ -53,6 +53,7 @@
 #include <map>
 
 #include "IdBase.h"
+#include <sbml/validator/IdCensus.h>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
@@ -103,6 +104,15 @@ protected:
   void doCheckId (const SBase& object);
 
 
+  /**
+   * Logs a conflict for every element of the given namespace of the
+   * census of the model whose id was already used by an earlier element.
+   * The census is the one shared by the validators of the document of
+   * @p m if there is one.
+   */
+  void checkCensus (IdCensus::IdNamespace ns, const Model& m);
+
+
   /**
    * Returns the error message to use when logging constraint violations.
    * This method is called by logFailure.
@@ -92,11 +92,8 @@ UniqueIdsForUnitDefinitions::getPreamble ()
 void
 UniqueIdsForUnitDefinitions::doCheck (const Model& m)
 {
-  unsigned int n, size;
-
-
-  size = m.getNumUnitDefinitions();
-  for (n = 0; n < size; ++n) checkId( *m.getUnitDefinition(n) );
+  checkCensus(IdCensus::UNIT_IDS, m);
+  reset();
 }
 
 LIBSBML_CPP_NAMESPACE_END
@@ -94,18 +94,9 @@ UniqueIdsInKineticLaw::getPreamble ()
 void
 UniqueIdsInKineticLaw::doCheck (const Model& m)
 {
-  for (unsigned int r = 0; r < m.getNumReactions(); ++r)
-  {
-    const KineticLaw* kl = m.getReaction(r)->getKineticLaw();
-    if (kl == NULL) continue;
-
-    for (unsigned int p = 0; p < kl->getNumParameters(); ++p)
-    {
-      checkId( *kl->getParameter(p) );
-    }
-
-    reset();
-  }
+  // the census keeps every kinetic law in a scope of its own
+  checkCensus(IdCensus::LOCAL_IDS, m);
+  reset();
 }
 
 LIBSBML_CPP_NAMESPACE_END
@@ -80,12 +80,11 @@ protected:
   /**
    * Checks that all ids on the following Model objects are unique:
    * FunctionDefinitions, Species, Compartments, global Parameters,
-   * Reactions, and Events.
+   * Reactions, and Events (from L3V2, all ids bar those of
+   * UnitDefinitions and local Parameters).
    */
   virtual void doCheck (const Model& m);
 
-  void doAllIdCheck (const Model& m);
-
 };
 
 LIBSBML_CPP_NAMESPACE_END
@@ -43,8 +43,7 @@
 
 #include "UniqueMetaId.h"
 #include <sbml/SBMLDocument.h>
-#include <sbml/ModifierSpeciesReference.h>
-#include <sbml/util/MetaIdFilter.h>
+#include <sbml/validator/IdCensus.h>
 
 /** @cond doxygenIgnored */
 using namespace std;
@@ -208,26 +207,31 @@ UniqueMetaId::getMessage (const string& id, const SBase& object)
   return oss_msg.str();
 }
 /*
- * Checks that all ids on the following Model objects are unique:
- * FunctionDefinitions, Species, Compartments, global Parameters,
- * Reactions, and Events.
+ * Checks that all metaids of the document are unique.
  */
 void
 UniqueMetaId::doCheck (const Model& m)
 {
-  /* check any metaid on the sbml container */
-  doCheckMetaId(*m.getSBMLDocument());
+  const IdCensus* census = IdCensus::getShared(m);
+  IdCensus        local(&m);
 
-  MetaIdFilter * midFilter = new MetaIdFilter();
-  SBMLDocument * d = const_cast <SBMLDocument*>(&(*m.getSBMLDocument()));
-  List * allElements = d->getAllElements(midFilter);
+  if (census == NULL)
+  {
+    census = &local;
+  }
 
-  for (ListIterator iter = allElements->begin(); iter != allElements->end(); ++iter)
+  /* the census lists the metaid on the sbml container first */
+  unsigned int size = census->getNumEntries(IdCensus::META_IDS);
+  for (unsigned int n = 0; n < size; ++n)
   {
-    doCheckMetaId(*(static_cast<SBase*>(*iter)));
+    const SBase* previous = census->getPreviousOwner(IdCensus::META_IDS, n);
+    if (previous == NULL) continue;
+
+    const string& id = census->getId(IdCensus::META_IDS, n);
+
+    mMetaIdObjectMap[id] = previous;
+    logIdConflict(id, *census->getObject(IdCensus::META_IDS, n));
   }
-  delete midFilter;
-  delete allElements;
   reset();
 }
 
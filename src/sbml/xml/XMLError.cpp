@@ -47,6 +47,7 @@
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLAttributes.h>
 #include <sbml/xml/XMLConstructorException.h>
+#include <sbml/util/ErrorTableIndex.h>
 #include <sbml/SBMLError.h>
 
 /** @cond doxygenIgnored */
@@ -337,6 +338,7 @@ XMLError::XMLError (  const int errorId
   , mValidError ( true )
   , mPackage ("")
   , mErrorIdOffset (0)
+  , mMessagePending (false)
 {
   // Check if the given id is one we have in our table of error codes.  If
   // it is, fill in the fields of the error object with the appropriate
@@ -344,30 +346,29 @@ XMLError::XMLError (  const int errorId
 
   if ( errorId >= 0 && errorId < XMLErrorCodesUpperBound )
   {
-    unsigned int tableSize = sizeof(errorTable)/sizeof(errorTable[0]);    
+    static const ErrorTableIndex index(errorTable);
+    unsigned int tableSize = sizeof(errorTable)/sizeof(errorTable[0]);
+    unsigned int i = index.find((unsigned int)errorId, tableSize);
 
-    for ( unsigned int i = 0; i < tableSize; i++ )
+    if ( i < tableSize )
     {
-      if ( errorTable[i].code == errorId )
+      mMessage      = errorTable[i].message;
+      mShortMessage = errorTable[i].shortMessage;
+
+      if ( !details.empty() )
       {
-        mMessage      = errorTable[i].message;
-        mShortMessage = errorTable[i].shortMessage;
-
-        if ( !details.empty() )
-        {
-          mMessage.append(" ");
-          mMessage.append(details);
-        }
-        mMessage += "\n";
-
-        mSeverity = errorTable[i].severity;
-        mCategory = errorTable[i].category;
-        
-        mSeverityString = stringForSeverity(mSeverity);
-        mCategoryString = stringForCategory(mCategory);
-
-        return;
+        mMessage.append(" ");
+        mMessage.append(details);
       }
+      mMessage += "\n";
+
+      mSeverity = errorTable[i].severity;
+      mCategory = errorTable[i].category;
+      
+      mSeverityString = stringForSeverity(mSeverity);
+      mCategoryString = stringForCategory(mCategory);
+
+      return;
     }
 
     // The id is in the range of error numbers that are supposed to be in
@@ -436,6 +437,28 @@ XMLError::XMLError (  const int errorId
  * Copy Constructor
  */
 XMLError::XMLError(const XMLError& orig)
+  : mErrorId        ( orig.mErrorId )
+  , mMessage        ( orig.getMessage() )
+  , mShortMessage   ( orig.mShortMessage )
+  , mSeverity       ( orig.mSeverity )
+  , mCategory       ( orig.mCategory )
+  , mLine           ( orig.mLine )
+  , mColumn         ( orig.mColumn )
+  , mSeverityString ( orig.mSeverityString )
+  , mCategoryString ( orig.mCategoryString )
+  , mValidError     ( orig.mValidError )
+  , mPackage        ( orig.mPackage )
+  , mErrorIdOffset  ( orig.mErrorIdOffset )
+  , mMessagePending ( false )
+{
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+/*
+ * Copy constructor for subclasses that format their messages on demand.
+ */
+XMLError::XMLError(const XMLError& orig, KeepPendingMessage)
   : mErrorId        ( orig.mErrorId )
   , mMessage        ( orig.mMessage )
   , mShortMessage   ( orig.mShortMessage )
@@ -448,8 +471,10 @@ XMLError::XMLError(const XMLError& orig)
   , mValidError     ( orig.mValidError )
   , mPackage        ( orig.mPackage )
   , mErrorIdOffset  ( orig.mErrorIdOffset )
+  , mMessagePending ( orig.mMessagePending )
 {
 }
+/** @endcond */
 
 
 /*
@@ -461,7 +486,7 @@ XMLError::operator=(const XMLError& rhs)
   if(&rhs!=this)
   {
     mErrorId        = rhs.mErrorId;
-    mMessage        = rhs.mMessage;
+    mMessage        = rhs.getMessage();
     mShortMessage   = rhs.mShortMessage;
     mSeverity       = rhs.mSeverity;
     mCategory       = rhs.mCategory;
@@ -471,6 +496,7 @@ XMLError::operator=(const XMLError& rhs)
     mCategoryString = rhs.mCategoryString;
     mPackage        = rhs.mPackage;
     mErrorIdOffset  = rhs.mErrorIdOffset;
+    mMessagePending = false;
   }
 
   return *this;
@@ -513,10 +539,27 @@ XMLError::getErrorId () const
 const string&
 XMLError::getMessage () const
 {
+  if (mMessagePending)
+  {
+    formatMessage();
+    mMessagePending = false;
+  }
+
   return mMessage;
 }
 
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The messages of XMLError itself are complete when it is constructed.
+ */
+void
+XMLError::formatMessage () const
+{
+}
+/** @endcond */
+
+
 /*
  * @return the short message text of this XMLError.
  */
@@ -1144,7 +1144,7 @@ protected:
   /** @cond doxygenLibsbmlInternal */
   unsigned int mErrorId;
 
-  std::string  mMessage;
+  mutable std::string  mMessage;
   std::string  mShortMessage;
 
   unsigned int mSeverity;
@@ -1161,9 +1161,30 @@ protected:
   std::string mPackage;
   unsigned int mErrorIdOffset;
 
+  /* true while mMessage still has to be filled in by formatMessage() */
+  mutable bool mMessagePending;
+
   virtual std::string stringForSeverity(unsigned int code) const;
   virtual std::string stringForCategory(unsigned int code) const;
 
+  /**
+   * Fills in mMessage; called by getMessage() the first time the message
+   * is needed, if mMessagePending was set.  Subclasses use this to avoid
+   * assembling messages that are never read.
+   */
+  virtual void formatMessage() const;
+
+  struct KeepPendingMessage {};
+
+  /**
+   * Copies @p orig, leaving its message to be formatted later if it has
+   * not been yet.  Only for subclasses whose copy constructor also copies
+   * what their formatMessage() needs; the public copy constructor formats
+   * a pending message first, so that a copy sliced to an XMLError keeps
+   * it.
+   */
+  XMLError(const XMLError& orig, KeepPendingMessage);
+
   friend class XMLErrorLog;
 
   /** @endcond */
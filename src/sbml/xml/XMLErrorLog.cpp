@@ -42,6 +42,7 @@
 #include <algorithm>
 #include <functional>
 #include <sstream>
+#include <map>
 
 #include <sbml/xml/XMLError.h>
 #include <sbml/xml/XMLParser.h>
@@ -62,6 +63,10 @@ LIBSBML_CPP_NAMESPACE_BEGIN
 XMLErrorLog::XMLErrorLog ()
   : mParser(NULL)
   , mOverriddenSeverity(LIBSBML_OVERRIDE_DISABLED)
+  , mMaxStoredErrors(0)
+  , mNumLoggedErrors(0)
+  , mCallback(NULL)
+  , mCallbackData(NULL)
 {
 }
 /** @endcond */
@@ -73,8 +78,14 @@ XMLErrorLog::XMLErrorLog ()
 XMLErrorLog::XMLErrorLog (const XMLErrorLog& other)
   : mParser(NULL)
   , mOverriddenSeverity(other.mOverriddenSeverity)
-{
-  add(other.mErrors);
+  , mMaxStoredErrors(other.mMaxStoredErrors)
+  , mNumLoggedErrors(other.mNumLoggedErrors)
+  , mSeverityCounts(other.mSeverityCounts)
+  , mCategoryCounts(other.mCategoryCounts)
+  , mCallback(NULL)
+  , mCallbackData(NULL)
+{
+  copyErrors(other.mErrors);
 }
 /** @endcond */
 
@@ -88,9 +99,14 @@ XMLErrorLog& XMLErrorLog::operator=(const XMLErrorLog& other)
   {
     mOverriddenSeverity = other.mOverriddenSeverity;
     mParser = NULL;
-    
-    mErrors.clear();
-    add(other.mErrors);
+    mMaxStoredErrors = other.mMaxStoredErrors;
+
+    clearLog();
+    copyErrors(other.mErrors);
+
+    mNumLoggedErrors = other.mNumLoggedErrors;
+    mSeverityCounts = other.mSeverityCounts;
+    mCategoryCounts = other.mCategoryCounts;
   }
   return *this;
 }
@@ -126,6 +142,28 @@ XMLErrorLog::add (const XMLError& error)
 {
   if (mOverriddenSeverity == LIBSBML_OVERRIDE_DONT_LOG) return;
 
+  unsigned int severity = error.getSeverity();
+
+  if (mOverriddenSeverity == LIBSBML_OVERRIDE_WARNING && 
+    severity > LIBSBML_SEV_WARNING)
+  {
+    severity = LIBSBML_SEV_WARNING;
+  }
+  else if (mOverriddenSeverity == LIBSBML_OVERRIDE_ERROR &&
+    severity == LIBSBML_SEV_WARNING)
+  {
+    severity = LIBSBML_SEV_ERROR;
+  }
+
+  if (mCallback == NULL && mMaxStoredErrors > 0 &&
+      mErrors.size() >= mMaxStoredErrors)
+  {
+    // the log is full; the error is counted but not kept, so there is
+    // no need to copy it
+    countError(severity, error.getCategory());
+    return;
+  }
+
   XMLError* cerror;
 
   try
@@ -139,20 +177,11 @@ XMLErrorLog::add (const XMLError& error)
     return;
   }
 
-  if (mOverriddenSeverity == LIBSBML_OVERRIDE_WARNING && 
-    cerror->getSeverity() > LIBSBML_SEV_WARNING)
+  if (severity != cerror->getSeverity())
   {
-    cerror->mSeverity = LIBSBML_SEV_WARNING;
-    cerror->mSeverityString = "Warning";
+    cerror->mSeverity = severity;
+    cerror->mSeverityString = cerror->stringForSeverity(severity);
   }
-  else if (mOverriddenSeverity == LIBSBML_OVERRIDE_ERROR &&
-    cerror->getSeverity() == LIBSBML_SEV_WARNING)
-  {
-    cerror->mSeverity = LIBSBML_SEV_ERROR;
-    cerror->mSeverityString = "Error";
-  }
-
-  mErrors.push_back(cerror);
 
   if (cerror->getLine() == 0 && cerror->getColumn() == 0)
   {
@@ -179,6 +208,18 @@ XMLErrorLog::add (const XMLError& error)
     cerror->setLine(line);
     cerror->setColumn(column);
   }
+
+  countError(severity, cerror->getCategory());
+
+  if (mCallback != NULL)
+  {
+    mCallback(cerror, mCallbackData);
+    delete cerror;
+  }
+  else
+  {
+    mErrors.push_back(cerror);
+  }
 }
 /** @endcond */
 
@@ -284,8 +325,95 @@ XMLErrorLog::clearLog()
 {
   for_each( mErrors.begin(), mErrors.end(), Delete() );
   mErrors.clear();
+
+  mNumLoggedErrors = 0;
+  mSeverityCounts.clear();
+  mCategoryCounts.clear();
+}
+
+
+/*
+ * @return the number of errors that have been logged, including those
+ * that were not stored.
+ */
+unsigned int
+XMLErrorLog::getNumLoggedErrors () const
+{
+  return mNumLoggedErrors;
+}
+
+
+/*
+ * Limits the number of errors kept in this log (0 for no limit).
+ */
+void
+XMLErrorLog::setMaxStoredErrors (unsigned int maxErrors)
+{
+  mMaxStoredErrors = maxErrors;
 }
 
+
+/*
+ * @return the maximum number of errors kept in this log.
+ */
+unsigned int
+XMLErrorLog::getMaxStoredErrors () const
+{
+  return mMaxStoredErrors;
+}
+
+
+/*
+ * Passes logged errors to the given function instead of storing them.
+ */
+void
+XMLErrorLog::setErrorCallback (XMLErrorCallback callback, void* userdata)
+{
+  mCallback = callback;
+  mCallbackData = userdata;
+}
+
+
+/** @cond doxygenLibsbmlInternal */
+void
+XMLErrorLog::copyErrors (const std::vector<XMLError*>& errors)
+{
+  vector<XMLError*>::const_iterator iter;
+
+  for (iter = errors.begin(); iter != errors.end(); ++iter)
+  {
+    mErrors.push_back((*iter)->clone());
+  }
+}
+
+
+void
+XMLErrorLog::countError (unsigned int severity, unsigned int category)
+{
+  ++mNumLoggedErrors;
+  ++mSeverityCounts[severity];
+  ++mCategoryCounts[category];
+}
+
+
+void
+XMLErrorLog::uncountError (const XMLError* error)
+{
+  --mNumLoggedErrors;
+  --mSeverityCounts[error->getSeverity()];
+  --mCategoryCounts[error->getCategory()];
+}
+
+
+unsigned int
+XMLErrorLog::getCount (const std::map<unsigned int, unsigned int>& counts,
+                       unsigned int key)
+{
+  map<unsigned int, unsigned int>::const_iterator it = counts.find(key);
+  return (it != counts.end()) ? it->second : 0;
+}
+/** @endcond */
+
 /** @cond doxygenLibsbmlInternal */
 /*
  * Sets the XMLParser for this XMLErrorLog.
@@ -348,6 +476,8 @@ XMLErrorLog::changeErrorSeverity(XMLErrorSeverity_t originalSeverity,
     {
       if (package == "all" || (*iter)->getPackage() == package)
       {
+        --mSeverityCounts[(*iter)->getSeverity()];
+        ++mSeverityCounts[targetSeverity];
         (*iter)->mSeverity = targetSeverity;
         (*iter)->mSeverityString = (*iter)->stringForSeverity(targetSeverity);
       }
@@ -451,6 +581,33 @@ XMLErrorLog_clearLog (XMLErrorLog_t *log)
 }
 
 
+LIBLAX_EXTERN
+unsigned int
+XMLErrorLog_getNumLoggedErrors (const XMLErrorLog_t *log)
+{
+  if (log == NULL) return 0;
+  return log->getNumLoggedErrors();
+}
+
+
+LIBLAX_EXTERN
+void
+XMLErrorLog_setMaxStoredErrors (XMLErrorLog_t *log, unsigned int maxErrors)
+{
+  if (log == NULL) return;
+  log->setMaxStoredErrors(maxErrors);
+}
+
+
+LIBLAX_EXTERN
+unsigned int
+XMLErrorLog_getMaxStoredErrors (const XMLErrorLog_t *log)
+{
+  if (log == NULL) return 0;
+  return log->getMaxStoredErrors();
+}
+
+
 LIBLAX_EXTERN
 char*
 XMLErrorLog_toString (XMLErrorLog_t *log)
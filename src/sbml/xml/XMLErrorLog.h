@@ -98,11 +98,25 @@
 #include <string>
 #include <vector>
 #include <list>
+#include <map>
 
 LIBSBML_CPP_NAMESPACE_BEGIN
 
 class XMLParser;
 
+#ifndef SWIG
+/**
+ * Signature of a function that receives the errors logged to an
+ * XMLErrorLog instead of the log storing them.
+ *
+ * @param error the error being logged; it is only valid during the call.
+ * @param userdata the pointer given to XMLErrorLog::setErrorCallback().
+ *
+ * @see XMLErrorLog::setErrorCallback()
+ */
+typedef void (*XMLErrorCallback)(const XMLError* error, void* userdata);
+#endif
+
 
 class LIBLAX_EXTERN XMLErrorLog
 {
@@ -142,10 +156,74 @@ public:
 
   /**
    * Deletes all errors from this log.
+   *
+   * This also resets the counts returned by getNumLoggedErrors().
    */
   void clearLog();
 
 
+  /**
+   * Returns the number of errors that have been logged.
+   *
+   * Unlike getNumErrors(), this includes the errors that were not stored
+   * because the limit set with setMaxStoredErrors() had been reached or
+   * because they were passed to an error callback.
+   *
+   * @return the number of errors that have been logged.
+   *
+   * @see getNumErrors()
+   * @see setMaxStoredErrors(unsigned int maxErrors)
+   */
+  unsigned int getNumLoggedErrors () const;
+
+
+  /**
+   * Limits the number of errors stored in this log.
+   *
+   * Once @p maxErrors errors are stored, further errors are still counted
+   * (see getNumLoggedErrors()) but are no longer kept.  This bounds the
+   * memory used when processing content with a very large number of
+   * problems.  Errors that are already stored are not removed.
+   *
+   * @param maxErrors the maximum number of errors to store, or @c 0 (the
+   * default) to store all of them.
+   *
+   * @see getMaxStoredErrors()
+   */
+  void setMaxStoredErrors (unsigned int maxErrors);
+
+
+  /**
+   * Returns the maximum number of errors stored in this log.
+   *
+   * @return the limit set with setMaxStoredErrors(), or @c 0 if the number
+   * of stored errors is not limited.
+   */
+  unsigned int getMaxStoredErrors () const;
+
+
+#ifndef SWIG
+  /** @cond doxygenCppOnly */
+  /**
+   * Passes the errors logged from now on to a function instead of storing
+   * them.
+   *
+   * Each error is passed to @p callback once it has been fully set up
+   * (severity overrides applied, line and column filled in) and is
+   * counted as usual, but it is not added to the list returned by
+   * getError().  The callback is not copied along with the log.
+   *
+   * @param callback the function to call, or @c NULL to store the errors
+   * again.
+   * @param userdata a pointer that is passed on to @p callback.
+   *
+   * @ifnot hasDefaultArgs @htmlinclude warn-default-args-in-docs.html @endif@~
+   */
+  void setErrorCallback (XMLErrorCallback callback, void* userdata = NULL);
+  /** @endcond */
+#endif
+
+
   /** @cond doxygenLibsbmlInternal */
   /**
    * Creates a new empty XMLErrorLog.
@@ -408,6 +486,43 @@ protected:
   const XMLParser*       mParser;
   XMLErrorSeverityOverride_t    mOverriddenSeverity;
 
+  unsigned int mMaxStoredErrors;
+  unsigned int mNumLoggedErrors;
+
+  // number of logged errors (stored or not) per severity and per category
+  std::map<unsigned int, unsigned int> mSeverityCounts;
+  std::map<unsigned int, unsigned int> mCategoryCounts;
+
+#ifndef SWIG
+  XMLErrorCallback mCallback;
+  void*            mCallbackData;
+#endif
+
+
+  /**
+   * Appends copies of the given errors to mErrors, as they are.
+   */
+  void copyErrors (const std::vector<XMLError*>& errors);
+
+
+  /**
+   * Adds the given severity and category to the counts of logged errors.
+   */
+  void countError (unsigned int severity, unsigned int category);
+
+
+  /**
+   * Removes a stored error from the counts of logged errors.
+   */
+  void uncountError (const XMLError* error);
+
+
+  /**
+   * Returns the number of logged errors with the given key in @p counts.
+   */
+  static unsigned int getCount (const std::map<unsigned int, unsigned int>& counts,
+                                unsigned int key);
+
   /** @endcond */
 };
 
@@ -499,6 +614,50 @@ LIBLAX_EXTERN
 void
 XMLErrorLog_clearLog (XMLErrorLog_t *log);
 
+
+/**
+ * Returns the number of errors that have been logged, including those
+ * that were not stored.
+ *
+ * @param log XMLErrorLog_t, the error log to be queried.
+ *
+ * @return the number of errors that have been logged.
+ *
+ * @memberof XMLErrorLog_t
+ */
+LIBLAX_EXTERN
+unsigned int
+XMLErrorLog_getNumLoggedErrors (const XMLErrorLog_t *log);
+
+
+/**
+ * Limits the number of errors stored in this log.
+ *
+ * @param log XMLErrorLog_t, the error log to be modified.
+ * @param maxErrors the maximum number of errors to store, or @c 0 to
+ * store all of them.
+ *
+ * @memberof XMLErrorLog_t
+ */
+LIBLAX_EXTERN
+void
+XMLErrorLog_setMaxStoredErrors (XMLErrorLog_t *log, unsigned int maxErrors);
+
+
+/**
+ * Returns the maximum number of errors stored in this log.
+ *
+ * @param log XMLErrorLog_t, the error log to be queried.
+ *
+ * @return the maximum number of errors stored, or @c 0 if it is not
+ * limited.
+ *
+ * @memberof XMLErrorLog_t
+ */
+LIBLAX_EXTERN
+unsigned int
+XMLErrorLog_getMaxStoredErrors (const XMLErrorLog_t *log);
+
 /**
  * Writes all errors contained in this log to a string and returns it. 
  *
@@ -77,7 +77,8 @@ trim (const string& s)
 /*
  * Creates a new empty XMLNode with no children.
  */
-XMLNode::XMLNode ()
+XMLNode::XMLNode () :
+    mShareCount ( 0 )
 {
 }
 
@@ -94,7 +95,9 @@ XMLNode::~XMLNode ()
 /*
  * Creates a new XMLNode by copying token.
  */
-XMLNode::XMLNode (const XMLToken& token) : XMLToken(token)
+XMLNode::XMLNode (const XMLToken& token) : 
+    XMLToken(token)
+  , mShareCount ( 0 )
 {
 }
 
@@ -109,6 +112,7 @@ XMLNode::XMLNode (  const XMLTriple&     triple
                   , const unsigned int   line
                   , const unsigned int   column) 
                   : XMLToken(triple, attributes, namespaces, line, column)
+                  , mShareCount ( 0 )
 {
 }
 
@@ -121,6 +125,7 @@ XMLNode::XMLNode (  const XMLTriple&      triple
                   , const unsigned int    line
                   , const unsigned int    column )
                   : XMLToken(triple, attributes, line, column)
+                  , mShareCount ( 0 )
 {
 }  
 
@@ -132,6 +137,7 @@ XMLNode::XMLNode (  const XMLTriple&   triple
                   , const unsigned int line
                   , const unsigned int column )
                   : XMLToken(triple, line, column)
+                  , mShareCount ( 0 )
 {
 }
 
@@ -143,6 +149,7 @@ XMLNode::XMLNode (  const std::string& chars
                   , const unsigned int line
                   , const unsigned int column )
                   : XMLToken(chars, line, column)
+                  , mShareCount ( 0 )
 {
 }
 
@@ -153,7 +160,9 @@ XMLNode::XMLNode (  const std::string& chars
  * be positioned on a start element (stream.peek().isStart() == true) and
  * will be read until the matching end element is found.
  */
-XMLNode::XMLNode (XMLInputStream& stream) : XMLToken( stream.next() )
+XMLNode::XMLNode (XMLInputStream& stream) : 
+    XMLToken( stream.next() )
+  , mShareCount ( 0 )
 {
   if ( isEnd() ) return;
 
@@ -187,16 +196,18 @@ XMLNode::XMLNode (XMLInputStream& stream) : XMLToken( stream.next() )
 
 
 /*
- * Copy constructor; creates a copy of this XMLNode.
+ * Copy constructor; creates a copy of this XMLNode.  The children are
+ * shared with orig until one of the two nodes modifies them.
  */
 XMLNode::XMLNode(const XMLNode& orig):
       XMLToken (orig)
+    , mShareCount ( 0 )
 {
+  mChildren.reserve(orig.mChildren.size());
   std::vector<XMLNode*>::const_iterator it = orig.mChildren.begin();
   while(it != orig.mChildren.end())
   {
-    const XMLNode* node = *it;    
-    addChild(*node);
+    mChildren.push_back(shareNode(*it));
     ++it;
   }
 }
@@ -208,25 +219,29 @@ XMLNode::operator=(const XMLNode& rhs)
   if(&rhs!=this)
   {
     this->XMLToken::operator=(rhs);
-    removeChildren();
 
+    // share the new children before releasing the old ones, as rhs
+    // may be a descendant of this node
+    std::vector<XMLNode*> children;
+    children.reserve(rhs.mChildren.size());
     std::vector<XMLNode*>::const_iterator it = rhs.mChildren.begin();
     while(it != rhs.mChildren.end())
     {
-      const XMLNode* node = *it;
-      addChild(*node);
+      children.push_back(shareNode(*it));
       ++it;
     }
 
+    removeChildren();
+    mChildren.swap(children);
   }
 
   return *this;
 }
 
 /*
- * Creates and returns a deep copy of this XMLNode.
+ * Creates and returns a copy of this XMLNode.
  * 
- * @return a (deep) copy of this XMLNode.
+ * @return a copy of this XMLNode.
  */
 XMLNode* 
 XMLNode::clone () const
@@ -276,11 +291,15 @@ XMLNode::insertChild (unsigned int n, const XMLNode& node)
 
   if ( (n >= size) || (size == 0) )
   {
+    n = size;
     mChildren.push_back(node.clone());
-    return *mChildren.back();
+  }
+  else
+  {
+    mChildren.insert(mChildren.begin() + n, node.clone());
   }
 
-  return **(mChildren.insert(mChildren.begin() + n, node.clone()));
+  return *detachChild(n);
 }
 
 
@@ -297,7 +316,7 @@ XMLNode::removeChild(unsigned int n)
 
   if ( n < getNumChildren() )
   {
-    rval = mChildren[n];
+    rval = unshareChild(n);
     mChildren.erase(mChildren.begin() + n);
   }
   
@@ -313,7 +332,7 @@ XMLNode::removeChildren()
   std::vector<XMLNode*>::iterator curIt = mChildren.begin();
     while(curIt != mChildren.end())
     {
-      delete *curIt;    
+      releaseNode(*curIt);
       ++curIt;
       }
   mChildren.clear(); 
@@ -327,6 +346,13 @@ XMLNode::removeChildren()
 XMLNode&
 XMLNode::getChild (unsigned int n)
 {
+  // the caller may modify the child through the reference, so it must
+  // not be shared now or later
+  if (n < getNumChildren())
+  {
+    return *detachChild(n);
+  }
+
    return const_cast<XMLNode&>( 
             static_cast<const XMLNode&>(*this).getChild(n)
           );
@@ -371,6 +397,12 @@ XMLNode::getChild (unsigned int n) const
 XMLNode&
 XMLNode::getChild (const std::string&  name)
 {
+  int index = getIndex(name);
+  if (index != -1)
+  {
+    return getChild((unsigned int)index);
+  }
+
   return const_cast<XMLNode&>( 
                 static_cast<const XMLNode&>(*this).getChild(name)
                 );
@@ -407,6 +439,75 @@ XMLNode::getChild (const std::string&  name) const
 
 }
 
+/** @cond doxygenLibsbmlInternal */
+/*
+ * The share count of a node may be changed by several threads at once when
+ * copies of the same tree are made in parallel.
+ */
+#if defined(_MSC_VER)
+#  include <intrin.h>
+#  define XMLNODE_FETCH_ADD(x, v) _InterlockedExchangeAdd(&(x), (v))
+#elif defined(__GNUC__)
+#  define XMLNODE_FETCH_ADD(x, v) __atomic_fetch_add(&(x), (v), __ATOMIC_ACQ_REL)
+#else
+#  define XMLNODE_FETCH_ADD(x, v) (((x) += (v)) - (v))
+#endif
+
+/*
+ * The share count of a node that was handed out for writing; it has a
+ * single parent and is copied rather than shared.
+ */
+static const long XMLNODE_DETACHED = -1;
+
+
+XMLNode*
+XMLNode::shareNode (XMLNode* node)
+{
+  // the node may still be changed through a reference handed out earlier
+  if (XMLNODE_FETCH_ADD(node->mShareCount, 0) == XMLNODE_DETACHED)
+  {
+    return new XMLNode(*node);
+  }
+
+  XMLNODE_FETCH_ADD(node->mShareCount, 1);
+  return node;
+}
+
+
+void
+XMLNode::releaseNode (XMLNode* node)
+{
+  if (XMLNODE_FETCH_ADD(node->mShareCount, 0) == XMLNODE_DETACHED ||
+      XMLNODE_FETCH_ADD(node->mShareCount, -1) == 0)
+  {
+    delete node;
+  }
+}
+
+
+XMLNode*
+XMLNode::unshareChild (unsigned int n)
+{
+  XMLNode* child = mChildren[n];
+  if (XMLNODE_FETCH_ADD(child->mShareCount, 0) > 0)
+  {
+    mChildren[n] = new XMLNode(*child);
+    releaseNode(child);
+  }
+  return mChildren[n];
+}
+
+
+XMLNode*
+XMLNode::detachChild (unsigned int n)
+{
+  XMLNode* child = unshareChild(n);
+  child->mShareCount = XMLNODE_DETACHED;
+  return child;
+}
+/** @endcond */
+
+
 /**
  * Return the index of the first child of this XMLNode with the given name.
  *
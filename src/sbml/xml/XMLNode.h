@@ -52,6 +52,14 @@
  * and XMLNode::getChild(@if java long@endif) can be used to access the tree
  * structure starting from a given node.
  *
+ * Copying an XMLNode is cheap: the copy shares the children of the
+ * original, and a child is only duplicated when one of the trees asks for
+ * write access to it (through the non-const XMLNode::getChild(@if java
+ * long@endif), XMLNode::insertChild(@if java long, XMLNode@endif) or
+ * XMLNode::removeChild(@if java long@endif)).  A child handed out for
+ * writing is never shared again, so that a reference to it kept across a
+ * copy of its parent only ever changes its own tree.
+ *
  * Each XMLNode is subclassed from XMLToken, and thus has the same methods
  * available as XMLToken.  These methods include XMLToken::getNamespaces(),
  * XMLToken::getPrefix(), XMLToken::getName(), XMLToken::getURI(), and
@@ -550,8 +558,40 @@ public:
 
 protected:
   /** @cond doxygenLibsbmlInternal */
+
+  /**
+   * Makes the nth child private to this node, copying it if it is shared
+   * with other nodes, and returns it.
+   */
+  XMLNode* unshareChild (unsigned int n);
+
+
+  /**
+   * Makes the nth child private to this node for good, before a reference
+   * to it that allows modification is handed out: later copies of this
+   * node copy the child instead of sharing it.
+   */
+  XMLNode* detachChild (unsigned int n);
+
+
+  /**
+   * Records that one more parent refers to @p node and returns it.
+   */
+  static XMLNode* shareNode (XMLNode* node);
+
+
+  /**
+   * Drops one reference to @p node, deleting it if it was the last one.
+   */
+  static void releaseNode (XMLNode* node);
+
+
   std::vector<XMLNode*> mChildren;
 
+  /* number of parents sharing this node besides the first one, or -1 if
+   * the node was handed out for writing and is never shared */
+  mutable long mShareCount;
+
   /** @endcond */
 };
 
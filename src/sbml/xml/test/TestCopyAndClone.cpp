@@ -383,6 +383,78 @@ START_TEST (test_Node_clone)
 END_TEST
 
 
+START_TEST (test_Node_copyShared)
+{
+  XMLNode *node = XMLNode::convertStringToXMLNode(
+    "<a><b><c>text</c></b><d/></a>");
+  fail_unless(node != NULL);
+
+  XMLNode *node2 = new XMLNode(*node);
+  XMLNode *node3 = node2->clone();
+
+  // modifying a child of one copy leaves the others alone
+  node2->getChild(0).getChild(0).removeChildren();
+  node2->getChild(0).addChild(XMLNode(XMLTriple("e", "", ""), XMLAttributes()));
+
+  fail_unless(node->getChild(0).getNumChildren() == 1);
+  fail_unless(node->getChild(0).getChild(0).getNumChildren() == 1);
+  fail_unless(node3->getChild(0).getChild(0).getNumChildren() == 1);
+  fail_unless(node2->getChild(0).getNumChildren() == 2);
+  fail_unless(node2->getChild(0).getChild(0).getNumChildren() == 0);
+
+  // a removed child belongs to the caller only
+  XMLNode *removed = node3->removeChild(1);
+  fail_unless(removed->getName() == "d");
+  delete removed;
+  fail_unless(node3->getNumChildren() == 1);
+  fail_unless(node->getNumChildren() == 2);
+  fail_unless(node->getChild(1).getName() == "d");
+
+  delete node;
+  fail_unless(node3->toXMLString() == "<a>\n  <b>\n    <c>text</c>\n  </b>\n</a>");
+
+  // assigning a descendant of the node itself
+  *node3 = node3->getChild(0);
+  fail_unless(node3->getName() == "b");
+  fail_unless(node3->getChild(0).getName() == "c");
+
+  delete node2;
+  delete node3;
+}
+END_TEST
+
+
+START_TEST (test_Node_copyKeptReference)
+{
+  XMLNode *node = XMLNode::convertStringToXMLNode("<a><b><c/></b></a>");
+  fail_unless(node != NULL);
+
+  // references handed out for writing before the copy is made
+  XMLNode& b = node->getChild(0);
+  XMLNode& c = b.getChild(0);
+  XMLNode& d = node->insertChild(1, XMLNode(XMLTriple("d", "", ""), XMLAttributes()));
+
+  XMLNode *node2 = new XMLNode(*node);
+
+  b.addChild(XMLNode(XMLTriple("e", "", ""), XMLAttributes()));
+  c.addChild(XMLNode("text"));
+  d.addChild(XMLNode("text"));
+
+  fail_unless(node->getChild(0).getNumChildren() == 2);
+  fail_unless(node->getChild(0).getChild(0).getNumChildren() == 1);
+  fail_unless(node->getChild(1).getNumChildren() == 1);
+
+  const XMLNode* copy = node2;
+  fail_unless(copy->getChild(0).getNumChildren() == 1);
+  fail_unless(copy->getChild(0).getChild(0).getNumChildren() == 0);
+  fail_unless(copy->getChild(1).getNumChildren() == 0);
+
+  delete node;
+  delete node2;
+}
+END_TEST
+
+
 Suite *
 create_suite_CopyAndClone (void)
 {
@@ -401,6 +473,8 @@ create_suite_CopyAndClone (void)
   tcase_add_test( tcase, test_Node_copyConstructor );
   tcase_add_test( tcase, test_Node_assignmentOperator );
   tcase_add_test( tcase, test_Node_clone );
+  tcase_add_test( tcase, test_Node_copyShared );
+  tcase_add_test( tcase, test_Node_copyKeptReference );
   suite_add_tcase(suite, tcase);
 
   return suite;
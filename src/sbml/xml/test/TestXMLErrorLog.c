@@ -191,6 +191,36 @@ START_TEST(test_XMLErrorLog_override)
 }
 END_TEST
 
+START_TEST (test_XMLErrorLog_maxStoredErrors)
+{
+  XMLErrorLog_t *log = XMLErrorLog_create();
+  XMLError_t* error = XMLError_create();
+
+  fail_unless( XMLErrorLog_getMaxStoredErrors(log) == 0 );
+
+  XMLErrorLog_setMaxStoredErrors(log, 1);
+  fail_unless( XMLErrorLog_getMaxStoredErrors(log) == 1 );
+
+  XMLErrorLog_add( log, error );
+  XMLErrorLog_add( log, error );
+  XMLErrorLog_add( log, error );
+
+  fail_unless( XMLErrorLog_getNumErrors(log) == 1 );
+  fail_unless( XMLErrorLog_getNumLoggedErrors(log) == 3 );
+
+  XMLErrorLog_clearLog(log);
+  fail_unless( XMLErrorLog_getNumErrors(log) == 0 );
+  fail_unless( XMLErrorLog_getNumLoggedErrors(log) == 0 );
+
+  fail_unless( XMLErrorLog_getNumLoggedErrors(NULL) == 0 );
+  fail_unless( XMLErrorLog_getMaxStoredErrors(NULL) == 0 );
+  XMLErrorLog_setMaxStoredErrors(NULL, 1);
+
+  XMLError_free(error);
+  XMLErrorLog_free(log);
+}
+END_TEST
+
 Suite *
 create_suite_XMLErrorLog (void)
 {
@@ -202,6 +232,7 @@ create_suite_XMLErrorLog (void)
   tcase_add_test( tcase, test_XMLErrorLog_clear    );
   tcase_add_test( tcase, test_XMLErrorLog_toString );
   tcase_add_test( tcase, test_XMLErrorLog_override );
+  tcase_add_test( tcase, test_XMLErrorLog_maxStoredErrors );
   tcase_add_test( tcase, test_XMLErrorLog_accessWithNULL   );
   
   suite_add_tcase(suite, tcase);